@@ -0,0 +1,164 @@
+/*****************************************************************************/
+/**
+ *  @file   Benchmark.cpp
+ */
+/*****************************************************************************/
+#include "Benchmark.h"
+#include <kvs/Platform>
+#include <kvs/Timer>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#if defined ( KVS_PLATFORM_WINDOWS )
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Result class.
+ */
+/*===========================================================================*/
+Result::Result():
+    size( 0 ),
+    repetitions( 0 ),
+    min_msec( 0.0 ),
+    median_msec( 0.0 ),
+    mean_msec( 0.0 ),
+    stddev_msec( 0.0 ),
+    work( 0.0 ),
+    throughput( 0.0 ),
+    memory_increase( 0.0 )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the peak resident memory of the process.
+ *  @return peak memory usage [MB] (0 if not available)
+ */
+/*===========================================================================*/
+double Benchmark::PeakMemoryUsage()
+{
+#if defined ( KVS_PLATFORM_WINDOWS )
+    PROCESS_MEMORY_COUNTERS counters;
+    if ( !GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) ) { return 0.0; }
+    return static_cast<double>( counters.PeakWorkingSetSize ) / ( 1024.0 * 1024.0 );
+#else
+    struct rusage usage;
+    if ( getrusage( RUSAGE_SELF, &usage ) != 0 ) { return 0.0; }
+#if defined ( KVS_PLATFORM_MACOSX )
+    // ru_maxrss is given in bytes on Mac OS X.
+    return static_cast<double>( usage.ru_maxrss ) / ( 1024.0 * 1024.0 );
+#else
+    // ru_maxrss is given in kilobytes on Linux.
+    return static_cast<double>( usage.ru_maxrss ) / 1024.0;
+#endif
+#endif
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Benchmark class.
+ *  @param  warmups [in] number of warm-up runs
+ *  @param  repetitions [in] number of timed repetitions
+ */
+/*===========================================================================*/
+Benchmark::Benchmark( const size_t warmups, const size_t repetitions ):
+    m_warmups( warmups ),
+    m_repetitions( repetitions )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the case is selected by the filter.
+ *  @param  name [in] case name
+ *  @return true if the case is selected
+ */
+/*===========================================================================*/
+bool Benchmark::isSelected( const std::string& name ) const
+{
+    return m_filter.empty() || name.find( m_filter ) != std::string::npos;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Runs the benchmark case.
+ *  @param  name [in] case name
+ *  @param  size [in] input size
+ *  @param  unit [in] unit of the work returned by the function
+ *  @param  function [in] function which executes the case once and returns the work
+ *  @param  setup [in] function called before each run (not timed)
+ *  @return true if the case is executed
+ */
+/*===========================================================================*/
+bool Benchmark::run( const std::string& name, const size_t size, const std::string& unit, Function function, Setup setup )
+{
+    if ( !this->isSelected( name ) ) { return false; }
+
+    const double memory_before = PeakMemoryUsage();
+    for ( size_t i = 0; i < m_warmups; i++ )
+    {
+        if ( setup ) { setup(); }
+        function();
+    }
+
+    const size_t repetitions = std::max( m_repetitions, size_t( 1 ) );
+    std::vector<double> times( repetitions );
+    double work = 0.0;
+    for ( size_t i = 0; i < repetitions; i++ )
+    {
+        if ( setup ) { setup(); }
+        kvs::Timer timer( kvs::Timer::Start );
+        work = function();
+        timer.stop();
+        times[i] = timer.msec();
+    }
+
+    std::vector<double> sorted( times );
+    std::sort( sorted.begin(), sorted.end() );
+    const size_t half = repetitions / 2;
+    const double median = ( repetitions % 2 == 1 ) ? sorted[ half ] : 0.5 * ( sorted[ half - 1 ] + sorted[ half ] );
+
+    double sum = 0.0;
+    for ( size_t i = 0; i < repetitions; i++ ) { sum += times[i]; }
+    const double mean = sum / repetitions;
+
+    double variance = 0.0;
+    for ( size_t i = 0; i < repetitions; i++ ) { variance += ( times[i] - mean ) * ( times[i] - mean ); }
+    variance /= repetitions;
+
+    kvsbench::Result result;
+    result.name = name;
+    result.size = size;
+    result.repetitions = repetitions;
+    result.min_msec = sorted.front();
+    result.median_msec = median;
+    result.mean_msec = mean;
+    result.stddev_msec = std::sqrt( variance );
+    result.work = work;
+    result.unit = unit;
+    result.throughput = median > 0.0 ? work / ( median * 1.0e-3 ) : 0.0;
+    result.memory_increase = std::max( PeakMemoryUsage() - memory_before, 0.0 );
+    m_results.push_back( result );
+
+    std::cerr << std::left << std::setw( 32 ) << name
+              << std::right << std::setw( 6 ) << size
+              << std::setw( 12 ) << std::fixed << std::setprecision( 3 ) << median << " msec"
+              << std::setw( 16 ) << std::scientific << std::setprecision( 3 ) << result.throughput << " " << unit << "/s"
+              << std::setw( 10 ) << std::fixed << std::setprecision( 1 );
+    if ( result.memory_increase > 0.0 ) { std::cerr << result.memory_increase << " MB"; }
+    else { std::cerr << "n/a   "; }
+    std::cerr << std::endl;
+    return true;
+}
+
+} // end of namespace kvsbench
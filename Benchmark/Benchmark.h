@@ -0,0 +1,85 @@
+/*****************************************************************************/
+/**
+ *  @file   Benchmark.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Result of a benchmark case.
+ */
+/*===========================================================================*/
+struct Result
+{
+    std::string name; ///< case name
+    size_t size; ///< input size (resolution per axis)
+    size_t repetitions; ///< number of timed repetitions
+    double min_msec; ///< minimum time [msec]
+    double median_msec; ///< median time [msec]
+    double mean_msec; ///< mean time [msec]
+    double stddev_msec; ///< standard deviation of the time [msec]
+    double work; ///< amount of work per repetition (in units)
+    std::string unit; ///< unit of the work (e.g. cells, particles, MB)
+    double throughput; ///< work per second (based on the median time)
+    double memory_increase; ///< increase of the peak resident memory during the case [MB] (0 if not increased)
+
+    Result();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Micro-benchmark runner.
+ *
+ *  A benchmark case is given as a function which executes the measured
+ *  process once and returns the amount of work done. The function is called
+ *  the specified number of times for warm-up, and then is timed for the
+ *  specified number of repetitions. The throughput is calculated with the
+ *  median time, which is robust against outliers. The optional setup function
+ *  is called before each run without being timed.
+ *
+ *  Since the peak resident memory is process-wide and never decreases, the
+ *  memory used by a case is measured as the increase of the peak over the
+ *  value before the case. The case which does not raise the peak (e.g. it
+ *  uses less memory than a preceding case) is reported as n/a.
+ */
+/*===========================================================================*/
+class Benchmark
+{
+public:
+    typedef std::function<double()> Function;
+    typedef std::function<void()> Setup;
+
+private:
+    size_t m_warmups; ///< number of warm-up runs
+    size_t m_repetitions; ///< number of timed repetitions
+    std::string m_filter; ///< case name filter (substring)
+    std::vector<kvsbench::Result> m_results; ///< results
+
+public:
+    static double PeakMemoryUsage();
+
+public:
+    Benchmark( const size_t warmups = 1, const size_t repetitions = 5 );
+
+    size_t numberOfWarmups() const { return m_warmups; }
+    size_t numberOfRepetitions() const { return m_repetitions; }
+    const std::string& filter() const { return m_filter; }
+    const std::vector<kvsbench::Result>& results() const { return m_results; }
+
+    void setNumberOfWarmups( const size_t warmups ) { m_warmups = warmups; }
+    void setNumberOfRepetitions( const size_t repetitions ) { m_repetitions = repetitions; }
+    void setFilter( const std::string& filter ) { m_filter = filter; }
+
+    bool isSelected( const std::string& name ) const;
+    bool run( const std::string& name, const size_t size, const std::string& unit, Function function, Setup setup = Setup() );
+};
+
+} // end of namespace kvsbench
@@ -0,0 +1,223 @@
+/*****************************************************************************/
+/**
+ *  @file   Report.cpp
+ */
+/*****************************************************************************/
+#include "Report.h"
+#include <kvs/Version>
+#include <kvs/Platform>
+#include <kvs/Compiler>
+#include <kvs/Message>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the string value of the key in the JSON object line.
+ *  @param  line [in] line of the JSON object
+ *  @param  key [in] key
+ *  @param  value [out] string value
+ *  @return true if the key is found
+ */
+/*===========================================================================*/
+bool FindValue( const std::string& line, const std::string& key, std::string* value )
+{
+    const std::string tag = "\"" + key + "\":";
+    std::string::size_type p = line.find( tag );
+    if ( p == std::string::npos ) { return false; }
+
+    p = line.find_first_not_of( " ", p + tag.size() );
+    if ( p == std::string::npos ) { return false; }
+
+    if ( line[p] == '"' )
+    {
+        const std::string::size_type q = line.find( '"', p + 1 );
+        if ( q == std::string::npos ) { return false; }
+        *value = line.substr( p + 1, q - p - 1 );
+    }
+    else
+    {
+        const std::string::size_type q = line.find_first_of( ",}", p );
+        *value = line.substr( p, q == std::string::npos ? std::string::npos : q - p );
+    }
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the quoted string escaped for JSON.
+ *  @param  s [in] string
+ *  @return quoted string
+ */
+/*===========================================================================*/
+std::string Quote( const std::string& s )
+{
+    std::string result = "\"";
+    for ( size_t i = 0; i < s.size(); i++ )
+    {
+        if ( s[i] == '"' || s[i] == '\\' ) { result += '\\'; }
+        result += s[i];
+    }
+    return result + "\"";
+}
+
+} // end of namespace
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the results from the JSON file written by Report::write.
+ *  @param  filename [in] filename
+ *  @return true if the file is read successfully
+ */
+/*===========================================================================*/
+bool Report::read( const std::string& filename )
+{
+    std::ifstream ifs( filename.c_str() );
+    if ( !ifs.is_open() )
+    {
+        kvsMessageError( "Cannot open %s.", filename.c_str() );
+        return false;
+    }
+
+    m_results.clear();
+    std::string line;
+    while ( std::getline( ifs, line ) )
+    {
+        std::string name, size, median;
+        if ( !::FindValue( line, "name", &name ) ) { continue; }
+        if ( !::FindValue( line, "size", &size ) ) { continue; }
+        if ( !::FindValue( line, "median_msec", &median ) ) { continue; }
+
+        kvsbench::Result result;
+        result.name = name;
+        result.size = static_cast<size_t>( std::atol( size.c_str() ) );
+        result.median_msec = std::atof( median.c_str() );
+
+        std::string value;
+        if ( ::FindValue( line, "repetitions", &value ) ) { result.repetitions = static_cast<size_t>( std::atol( value.c_str() ) ); }
+        if ( ::FindValue( line, "min_msec", &value ) ) { result.min_msec = std::atof( value.c_str() ); }
+        if ( ::FindValue( line, "mean_msec", &value ) ) { result.mean_msec = std::atof( value.c_str() ); }
+        if ( ::FindValue( line, "stddev_msec", &value ) ) { result.stddev_msec = std::atof( value.c_str() ); }
+        if ( ::FindValue( line, "work", &value ) ) { result.work = std::atof( value.c_str() ); }
+        if ( ::FindValue( line, "unit", &value ) ) { result.unit = value; }
+        if ( ::FindValue( line, "throughput", &value ) ) { result.throughput = std::atof( value.c_str() ); }
+        if ( ::FindValue( line, "memory_increase_mb", &value ) ) { result.memory_increase = std::atof( value.c_str() ); }
+        m_results.push_back( result );
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the results to the JSON file.
+ *  @param  filename [in] filename
+ *  @return true if the file is written successfully
+ */
+/*===========================================================================*/
+bool Report::write( const std::string& filename ) const
+{
+    std::ofstream ofs( filename.c_str() );
+    if ( !ofs.is_open() )
+    {
+        kvsMessageError( "Cannot open %s.", filename.c_str() );
+        return false;
+    }
+
+    this->print( ofs );
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the results in JSON.
+ *  @param  os [in] output stream
+ */
+/*===========================================================================*/
+void Report::print( std::ostream& os ) const
+{
+    std::ostringstream compiler;
+    compiler << KVS_COMPILER_NAME << " " << KVS_COMPILER_VERSION;
+
+    os << "{" << std::endl;
+    os << "  \"version\": " << ::Quote( KVS_VERSION ) << "," << std::endl;
+    os << "  \"platform\": " << ::Quote( KVS_PLATFORM_NAME ) << "," << std::endl;
+    os << "  \"cpu\": " << ::Quote( KVS_PLATFORM_CPU_NAME ) << "," << std::endl;
+    os << "  \"compiler\": " << ::Quote( compiler.str() ) << "," << std::endl;
+    os << "  \"results\": [" << std::endl;
+    for ( size_t i = 0; i < m_results.size(); i++ )
+    {
+        const kvsbench::Result& r = m_results[i];
+        os << std::setprecision( 6 );
+        os << "    {"
+           << "\"name\": " << ::Quote( r.name ) << ", "
+           << "\"size\": " << r.size << ", "
+           << "\"repetitions\": " << r.repetitions << ", "
+           << "\"min_msec\": " << r.min_msec << ", "
+           << "\"median_msec\": " << r.median_msec << ", "
+           << "\"mean_msec\": " << r.mean_msec << ", "
+           << "\"stddev_msec\": " << r.stddev_msec << ", "
+           << "\"work\": " << r.work << ", "
+           << "\"unit\": " << ::Quote( r.unit ) << ", "
+           << "\"throughput\": " << r.throughput << ", "
+           << "\"memory_increase_mb\": ";
+        if ( r.memory_increase > 0.0 ) { os << r.memory_increase; } else { os << "null"; }
+        os << "}" << ( i + 1 < m_results.size() ? "," : "" ) << std::endl;
+    }
+    os << "  ]" << std::endl;
+    os << "}" << std::endl;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Compares the results with the baseline.
+ *  @param  baseline [in] baseline report
+ *  @param  tolerance [in] allowed relative slowdown of the median time
+ *  @param  os [in] output stream for the comparison table
+ *  @return number of the regressed cases
+ */
+/*===========================================================================*/
+size_t Report::compare( const kvsbench::Report& baseline, const double tolerance, std::ostream& os ) const
+{
+    size_t nregressions = 0;
+    for ( size_t i = 0; i < m_results.size(); i++ )
+    {
+        const kvsbench::Result& current = m_results[i];
+        const kvsbench::Result* base = NULL;
+        for ( size_t j = 0; j < baseline.results().size(); j++ )
+        {
+            const kvsbench::Result& r = baseline.results()[j];
+            if ( r.name == current.name && r.size == current.size ) { base = &r; break; }
+        }
+
+        os << std::left << std::setw( 32 ) << current.name
+           << std::right << std::setw( 6 ) << current.size;
+        if ( !base || base->median_msec <= 0.0 )
+        {
+            os << "  (no baseline)" << std::endl;
+            continue;
+        }
+
+        const double ratio = current.median_msec / base->median_msec;
+        const bool regressed = ratio > 1.0 + tolerance;
+        if ( regressed ) { nregressions++; }
+
+        os << std::setw( 12 ) << std::fixed << std::setprecision( 3 ) << base->median_msec << " ->"
+           << std::setw( 12 ) << current.median_msec << " msec"
+           << std::setw( 10 ) << std::showpos << ( ratio - 1.0 ) * 100.0 << std::noshowpos << " %"
+           << ( regressed ? "  REGRESSION" : "" ) << std::endl;
+    }
+    return nregressions;
+}
+
+} // end of namespace kvsbench
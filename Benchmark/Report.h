@@ -0,0 +1,42 @@
+/*****************************************************************************/
+/**
+ *  @file   Report.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <iostream>
+#include "Benchmark.h"
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Report of the benchmark results in JSON.
+ *
+ *  The results are written as a JSON document with one result object per
+ *  line, so that a stored baseline can be read back without a general JSON
+ *  parser and can be compared with the results of the current build.
+ */
+/*===========================================================================*/
+class Report
+{
+private:
+    std::vector<kvsbench::Result> m_results; ///< results
+
+public:
+    Report() {}
+    Report( const std::vector<kvsbench::Result>& results ): m_results( results ) {}
+
+    const std::vector<kvsbench::Result>& results() const { return m_results; }
+
+    bool read( const std::string& filename );
+    bool write( const std::string& filename ) const;
+    void print( std::ostream& os ) const;
+    size_t compare( const kvsbench::Report& baseline, const double tolerance, std::ostream& os ) const;
+};
+
+} // end of namespace kvsbench
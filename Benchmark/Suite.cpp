@@ -0,0 +1,343 @@
+/*****************************************************************************/
+/**
+ *  @file   Suite.cpp
+ */
+/*****************************************************************************/
+#include "Suite.h"
+#include <kvs/HydrogenVolumeData>
+#include <kvs/TornadoVolumeData>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/PointObject>
+#include <kvs/TransferFunction>
+#include <kvs/MarchingCubes>
+#include <kvs/ExternalFaces>
+#include <kvs/CellByCellUniformSampling>
+#include <kvs/Streamline>
+#include <kvs/LineIntegralConvolution>
+#include <kvs/ValueArray>
+#include <kvs/ObjectImporter>
+#include <kvs/File>
+#include <cstdio>
+#include <sstream>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of cells of the structured volume object.
+ *  @param  volume [in] structured volume object
+ *  @return number of cells
+ */
+/*===========================================================================*/
+double NumberOfCells( const kvs::StructuredVolumeObject& volume )
+{
+    const kvs::Vec3u r = volume.resolution();
+    return double( r.x() - 1 ) * double( r.y() - 1 ) * double( r.z() - 1 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the seed points placed on the regular grid.
+ *  @param  volume [in] structured volume object
+ *  @param  nseeds [in] number of seed points per axis
+ *  @return seed points
+ */
+/*===========================================================================*/
+kvs::PointObject* SeedPoints( const kvs::StructuredVolumeObject& volume, const size_t nseeds )
+{
+    const kvs::Vec3 min_coord = volume.minObjectCoord();
+    const kvs::Vec3 max_coord = volume.maxObjectCoord();
+    const kvs::Vec3 step = ( max_coord - min_coord ) / static_cast<float>( nseeds + 1 );
+
+    kvs::ValueArray<kvs::Real32> coords( 3 * nseeds * nseeds * nseeds );
+    kvs::Real32* pcoords = coords.data();
+    for ( size_t k = 1; k <= nseeds; k++ )
+    {
+        for ( size_t j = 1; j <= nseeds; j++ )
+        {
+            for ( size_t i = 1; i <= nseeds; i++ )
+            {
+                *(pcoords++) = min_coord.x() + step.x() * i;
+                *(pcoords++) = min_coord.y() + step.y() * j;
+                *(pcoords++) = min_coord.z() + step.z() * k;
+            }
+        }
+    }
+
+    kvs::PointObject* point = new kvs::PointObject();
+    point->setCoords( coords );
+    return point;
+}
+
+} // end of namespace
+
+
+namespace kvsbench
+{
+
+namespace Suite
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Isosurface extraction (cells/s).
+ *  @param  benchmark [in] benchmark runner
+ *  @param  size [in] volume resolution per axis
+ */
+/*===========================================================================*/
+void MarchingCubes( kvsbench::Benchmark& benchmark, const size_t size )
+{
+    if ( !benchmark.isSelected( "MarchingCubes" ) ) { return; }
+
+    const kvs::HydrogenVolumeData volume( kvs::Vec3u::Constant( size ) );
+    const kvs::TransferFunction tfunc( 256 );
+    const double isolevel = 0.5 * ( volume.minValue() + volume.maxValue() );
+    const double ncells = ::NumberOfCells( volume );
+    const kvs::PolygonObject::NormalType normal = kvs::PolygonObject::PolygonNormal;
+
+    benchmark.run( "MarchingCubes", size, "cells", [&] ()
+    {
+        kvs::MarchingCubes mapper( &volume, isolevel, normal, true, tfunc );
+        return ncells;
+    } );
+
+    benchmark.run( "MarchingCubes(VertexNormal)", size, "cells", [&] ()
+    {
+        kvs::MarchingCubes mapper( &volume, isolevel, kvs::PolygonObject::VertexNormal, false, tfunc );
+        return ncells;
+    } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  External faces extraction (cells/s).
+ *  @param  benchmark [in] benchmark runner
+ *  @param  size [in] volume resolution per axis
+ */
+/*===========================================================================*/
+void ExternalFaces( kvsbench::Benchmark& benchmark, const size_t size )
+{
+    if ( !benchmark.isSelected( "ExternalFaces" ) ) { return; }
+
+    const kvs::HydrogenVolumeData volume( kvs::Vec3u::Constant( size ) );
+    const kvs::TransferFunction tfunc( 256 );
+    const double ncells = ::NumberOfCells( volume );
+
+    benchmark.run( "ExternalFaces", size, "cells", [&] ()
+    {
+        kvs::ExternalFaces mapper( &volume, tfunc );
+        return ncells;
+    } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Particle generation (particles/s).
+ *  @param  benchmark [in] benchmark runner
+ *  @param  size [in] volume resolution per axis
+ */
+/*===========================================================================*/
+void CellByCellUniformSampling( kvsbench::Benchmark& benchmark, const size_t size )
+{
+    if ( !benchmark.isSelected( "CellByCellUniformSampling" ) ) { return; }
+
+    const kvs::HydrogenVolumeData volume( kvs::Vec3u::Constant( size ) );
+    const kvs::TransferFunction tfunc( 256 );
+    const size_t repetition_level = 1;
+    const float sampling_step = 0.5f;
+
+    benchmark.run( "CellByCellUniformSampling", size, "particles", [&] ()
+    {
+        kvs::CellByCellUniformSampling mapper( &volume, repetition_level, sampling_step, tfunc );
+        return double( mapper.numberOfVertices() );
+    } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Streamline integration (line vertices/s).
+ *  @param  benchmark [in] benchmark runner
+ *  @param  size [in] volume resolution per axis
+ */
+/*===========================================================================*/
+void Streamline( kvsbench::Benchmark& benchmark, const size_t size )
+{
+    if ( !benchmark.isSelected( "Streamline" ) ) { return; }
+
+    const kvs::TornadoVolumeData volume( kvs::Vec3u::Constant( size ) );
+    const kvs::PointObject* seeds = ::SeedPoints( volume, 8 );
+    const kvs::TransferFunction tfunc( 256 );
+
+    benchmark.run( "Streamline", size, "vertices", [&] ()
+    {
+        kvs::Streamline mapper( &volume, seeds, tfunc );
+        return double( mapper.numberOfVertices() );
+    } );
+
+    delete seeds;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Line integral convolution (cells/s).
+ *  @param  benchmark [in] benchmark runner
+ *  @param  size [in] volume resolution per axis
+ */
+/*===========================================================================*/
+void LineIntegralConvolution( kvsbench::Benchmark& benchmark, const size_t size )
+{
+    if ( !benchmark.isSelected( "LineIntegralConvolution" ) ) { return; }
+
+    const kvs::TornadoVolumeData volume( kvs::Vec3u::Constant( size ) );
+    const double ncells = ::NumberOfCells( volume );
+
+    benchmark.run( "LineIntegralConvolution", size, "cells", [&] ()
+    {
+        kvs::LineIntegralConvolution filter( &volume );
+        return ncells;
+    } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  KVSML reader for the structured volume object (MB/s).
+ *  @param  benchmark [in] benchmark runner
+ *  @param  size [in] volume resolution per axis
+ */
+/*===========================================================================*/
+void KVSMLReader( kvsbench::Benchmark& benchmark, const size_t size )
+{
+    if ( !benchmark.isSelected( "KVSMLReader" ) ) { return; }
+
+    const size_t nnodes = size * size * size;
+    kvs::StructuredVolumeObject volume;
+    volume.setGridTypeToUniform();
+    volume.setVeclen( 1 );
+    volume.setResolution( kvs::Vec3u::Constant( size ) );
+    volume.setValues( kvs::ValueArray<kvs::Real32>::Random( nnodes, 1 ) );
+    volume.updateMinMaxCoords();
+    volume.updateMinMaxValues();
+
+    const double mbytes = double( nnodes * sizeof( kvs::Real32 ) ) / ( 1024.0 * 1024.0 );
+    const struct { const char* name; bool ascii; bool external; } formats[] = {
+        { "KVSMLReader(ascii)", true, false },
+        { "KVSMLReader(external-ascii)", true, true },
+        { "KVSMLReader(external-binary)", false, true }
+    };
+
+    for ( size_t i = 0; i < sizeof( formats ) / sizeof( formats[0] ); i++ )
+    {
+        if ( !benchmark.isSelected( formats[i].name ) ) { continue; }
+
+        std::ostringstream filename;
+        filename << "kvsbench_" << size << "_" << i << ".kvsml";
+        const std::string data_filename = kvs::File( filename.str() ).baseName() + "_value.dat";
+        volume.write( filename.str(), formats[i].ascii, formats[i].external );
+
+        benchmark.run( formats[i].name, size, "MB", [&] ()
+        {
+            kvs::StructuredVolumeObject object;
+            return object.read( filename.str() ) ? mbytes : 0.0;
+        } );
+
+        std::remove( filename.str().c_str() );
+        std::remove( data_filename.c_str() );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  KVSML writer for the structured volume object (MB/s).
+ *  @param  benchmark [in] benchmark runner
+ *  @param  size [in] volume resolution per axis
+ */
+/*===========================================================================*/
+void KVSMLWriter( kvsbench::Benchmark& benchmark, const size_t size )
+{
+    if ( !benchmark.isSelected( "KVSMLWriter" ) ) { return; }
+
+    const size_t nnodes = size * size * size;
+    kvs::StructuredVolumeObject volume;
+    volume.setGridTypeToUniform();
+    volume.setVeclen( 1 );
+    volume.setResolution( kvs::Vec3u::Constant( size ) );
+    volume.setValues( kvs::ValueArray<kvs::Real32>::Random( nnodes, 1 ) );
+    volume.updateMinMaxCoords();
+    volume.updateMinMaxValues();
+
+    const double mbytes = double( nnodes * sizeof( kvs::Real32 ) ) / ( 1024.0 * 1024.0 );
+    const struct { const char* name; bool ascii; bool external; } formats[] = {
+        { "KVSMLWriter(ascii)", true, false },
+        { "KVSMLWriter(external-ascii)", true, true },
+        { "KVSMLWriter(external-binary)", false, true }
+    };
+
+    for ( size_t i = 0; i < sizeof( formats ) / sizeof( formats[0] ); i++ )
+    {
+        if ( !benchmark.isSelected( formats[i].name ) ) { continue; }
+
+        std::ostringstream filename;
+        filename << "kvsbench_" << size << "_writer" << i << ".kvsml";
+        const std::string data_filename = kvs::File( filename.str() ).baseName() + "_value.dat";
+
+        // The files are removed before each run, so that the time does not
+        // include the truncation of the existing files.
+        benchmark.run( formats[i].name, size, "MB", [&] ()
+        {
+            return volume.write( filename.str(), formats[i].ascii, formats[i].external ) ? mbytes : 0.0;
+        },
+        [&] ()
+        {
+            std::remove( filename.str().c_str() );
+            std::remove( data_filename.c_str() );
+        } );
+
+        std::remove( filename.str().c_str() );
+        std::remove( data_filename.c_str() );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Object importer for the KVSML structured volume object (MB/s).
+ *  @param  benchmark [in] benchmark runner
+ *  @param  size [in] volume resolution per axis
+ *
+ *  The time includes the estimation of the object type of the KVSML file.
+ */
+/*===========================================================================*/
+void ObjectImporter( kvsbench::Benchmark& benchmark, const size_t size )
+{
+    if ( !benchmark.isSelected( "ObjectImporter(ascii)" ) ) { return; }
+
+    const size_t nnodes = size * size * size;
+    kvs::StructuredVolumeObject volume;
+    volume.setGridTypeToUniform();
+    volume.setVeclen( 1 );
+    volume.setResolution( kvs::Vec3u::Constant( size ) );
+    volume.setValues( kvs::ValueArray<kvs::Real32>::Random( nnodes, 1 ) );
+    volume.updateMinMaxCoords();
+    volume.updateMinMaxValues();
+
+    std::ostringstream filename;
+    filename << "kvsbench_" << size << "_importer.kvsml";
+    volume.write( filename.str(), true, false );
+
+    const double mbytes = double( nnodes * sizeof( kvs::Real32 ) ) / ( 1024.0 * 1024.0 );
+    benchmark.run( "ObjectImporter(ascii)", size, "MB", [&] ()
+    {
+        kvs::ObjectImporter importer( filename.str() );
+        kvs::ObjectBase* object = importer.import();
+        const bool success = object != NULL;
+        delete object;
+        return success ? mbytes : 0.0;
+    } );
+
+    std::remove( filename.str().c_str() );
+}
+
+} // end of namespace Suite
+
+} // end of namespace kvsbench
@@ -0,0 +1,37 @@
+/*****************************************************************************/
+/**
+ *  @file   Suite.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <cstddef>
+#include "Benchmark.h"
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Benchmark cases of the subsystems.
+ *
+ *  Each function creates the synthetic input of the given size (resolution
+ *  per axis) outside of the timed region, and runs the cases with the
+ *  benchmark runner.
+ */
+/*===========================================================================*/
+namespace Suite
+{
+
+void MarchingCubes( kvsbench::Benchmark& benchmark, const size_t size );
+void ExternalFaces( kvsbench::Benchmark& benchmark, const size_t size );
+void CellByCellUniformSampling( kvsbench::Benchmark& benchmark, const size_t size );
+void Streamline( kvsbench::Benchmark& benchmark, const size_t size );
+void LineIntegralConvolution( kvsbench::Benchmark& benchmark, const size_t size );
+void KVSMLReader( kvsbench::Benchmark& benchmark, const size_t size );
+void KVSMLWriter( kvsbench::Benchmark& benchmark, const size_t size );
+void ObjectImporter( kvsbench::Benchmark& benchmark, const size_t size );
+
+} // end of namespace Suite
+
+} // end of namespace kvsbench
@@ -0,0 +1,110 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Micro-benchmark suite for the mappers, filters and readers
+ */
+/*****************************************************************************/
+#include <kvs/CommandLine>
+#include <kvs/Message>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include "Benchmark.h"
+#include "Report.h"
+#include "Suite.h"
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the list of the sizes given as the comma-separated string.
+ *  @param  list [in] comma-separated string (e.g. "32,64,128")
+ *  @return list of the sizes
+ */
+/*===========================================================================*/
+std::vector<size_t> SizeList( const std::string& list )
+{
+    std::vector<size_t> sizes;
+    std::istringstream is( list );
+    std::string token;
+    while ( std::getline( is, token, ',' ) )
+    {
+        const long size = std::atol( token.c_str() );
+        if ( size > 1 ) { sizes.push_back( static_cast<size_t>( size ) ); }
+    }
+    return sizes;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [in] argument count
+ *  @param  argv [in] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    kvs::CommandLine cl( argc, argv );
+    cl.addHelpOption();
+    cl.addOption( "s", "Comma-separated volume resolutions. (default: 32,64,128)", 1, false );
+    cl.addOption( "w", "Number of warm-up runs. (default: 1)", 1, false );
+    cl.addOption( "r", "Number of timed repetitions. (default: 5)", 1, false );
+    cl.addOption( "f", "Run the cases whose names contain the string. (optional)", 1, false );
+    cl.addOption( "o", "Output JSON filename. (default: standard output)", 1, false );
+    cl.addOption( "b", "Baseline JSON filename to be compared with. (optional)", 1, false );
+    cl.addOption( "t", "Tolerance of the slowdown against the baseline. (default: 0.1)", 1, false );
+    if ( !cl.parse() ) { return 1; }
+
+    const std::string sizes_string = cl.hasOption( "s" ) ? cl.optionValue<std::string>( "s" ) : "32,64,128";
+    const std::vector<size_t> sizes = SizeList( sizes_string );
+    if ( sizes.empty() )
+    {
+        kvsMessageError( "Invalid sizes: %s.", sizes_string.c_str() );
+        return 1;
+    }
+
+    kvsbench::Benchmark benchmark;
+    if ( cl.hasOption( "w" ) ) { benchmark.setNumberOfWarmups( cl.optionValue<size_t>( "w" ) ); }
+    if ( cl.hasOption( "r" ) ) { benchmark.setNumberOfRepetitions( cl.optionValue<size_t>( "r" ) ); }
+    if ( cl.hasOption( "f" ) ) { benchmark.setFilter( cl.optionValue<std::string>( "f" ) ); }
+
+    for ( size_t i = 0; i < sizes.size(); i++ )
+    {
+        const size_t size = sizes[i];
+        kvsbench::Suite::MarchingCubes( benchmark, size );
+        kvsbench::Suite::ExternalFaces( benchmark, size );
+        kvsbench::Suite::CellByCellUniformSampling( benchmark, size );
+        kvsbench::Suite::Streamline( benchmark, size );
+        kvsbench::Suite::LineIntegralConvolution( benchmark, size );
+        kvsbench::Suite::KVSMLReader( benchmark, size );
+        kvsbench::Suite::KVSMLWriter( benchmark, size );
+        kvsbench::Suite::ObjectImporter( benchmark, size );
+    }
+
+    const kvsbench::Report report( benchmark.results() );
+    if ( cl.hasOption( "o" ) )
+    {
+        if ( !report.write( cl.optionValue<std::string>( "o" ) ) ) { return 1; }
+    }
+    else
+    {
+        report.print( std::cout );
+    }
+
+    if ( cl.hasOption( "b" ) )
+    {
+        kvsbench::Report baseline;
+        if ( !baseline.read( cl.optionValue<std::string>( "b" ) ) ) { return 1; }
+
+        const double tolerance = cl.hasOption( "t" ) ? cl.optionValue<double>( "t" ) : 0.1;
+        const size_t nregressions = report.compare( baseline, tolerance, std::cerr );
+        if ( nregressions > 0 )
+        {
+            std::cerr << nregressions << " case(s) regressed more than " << tolerance * 100.0 << " %." << std::endl;
+            return 2;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program of the stream server and client (loopback).
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <atomic>
+#include <kvs/CommandLine>
+#include <kvs/StreamServer>
+#include <kvs/StreamClient>
+#include <kvs/StreamFrame>
+#include <kvs/ColorImage>
+#include <kvs/IPAddress>
+#include <kvs/Thread>
+#include <kvs/Message>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Argument class.
+ */
+/*===========================================================================*/
+class Argument : public kvs::CommandLine
+{
+public:
+
+    Argument( int argc, char** argv ):
+        kvs::CommandLine( argc, argv )
+    {
+        addHelpOption();
+        addOption( "n", "Number of the frames. (default: 21)", 1, false );
+        addOption( "width", "Image width. (default: 1024)", 1, false );
+        addOption( "height", "Image height. (default: 1024)", 1, false );
+        addOption( "slow", "The client does not read until all of the frames are sent.", 0, false );
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the value of the pixels in the frame of the sequence number.
+ *  @param  sequence [in] sequence number
+ *  @param  index [in] byte index of the pixel
+ *  @return pixel value
+ */
+/*===========================================================================*/
+inline kvs::UInt8 PixelValue( const kvs::UInt64 sequence, const size_t index )
+{
+    return static_cast<kvs::UInt8>( ( sequence * 31 + index ) & 0xff );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Client thread which receives the frames until the end frame.
+ */
+/*===========================================================================*/
+class Client : public kvs::Thread
+{
+private:
+    int m_port; ///< port number of the server
+    const std::atomic<bool>* m_sent; ///< true if the server has sent all of the frames
+    bool m_slow; ///< if true, the client waits until all of the frames are sent
+    size_t m_nreceived; ///< number of the received image frames
+    size_t m_nbroken; ///< number of the received frames which are not identical
+    size_t m_nmissed; ///< number of the frames dropped by the server
+
+public:
+
+    Client( const int port, const std::atomic<bool>* sent, const bool slow ):
+        m_port( port ),
+        m_sent( sent ),
+        m_slow( slow ),
+        m_nreceived( 0 ),
+        m_nbroken( 0 ),
+        m_nmissed( 0 ) {}
+
+    size_t numberOfReceivedFrames() const { return m_nreceived; }
+    size_t numberOfBrokenFrames() const { return m_nbroken; }
+    size_t numberOfMissedFrames() const { return m_nmissed; }
+
+    void run()
+    {
+        kvs::StreamClient client;
+        if ( !client.connect( kvs::IPAddress( "127.0.0.1" ), m_port ) )
+        {
+            kvsMessageError( "Cannot connect to the port %d.", m_port );
+            return;
+        }
+
+        // The slow client does not read anything while the frames are sent,
+        // so that the frames which are not sent yet are dropped by the server.
+        while ( m_slow && !m_sent->load() ) { kvs::Thread::MilliSleep( 10 ); }
+
+        kvs::StreamFrame frame;
+        while ( client.receive( &frame ) )
+        {
+            if ( frame.type() != kvs::StreamFrame::ImageFrame ) { break; }
+
+            // The received pixels should be identical to the sent ones.
+            const kvs::ColorImage image = frame.toColorImage();
+            const kvs::ValueArray<kvs::UInt8>& pixels = image.pixels();
+            for ( size_t i = 0; i < pixels.size(); i++ )
+            {
+                if ( pixels[i] != ::PixelValue( frame.sequence(), i ) ) { m_nbroken++; break; }
+            }
+            m_nreceived++;
+        }
+
+        m_nmissed = client.numberOfMissedFrames();
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [in] argument count
+ *  @param  argv [in] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    Argument argument( argc, argv );
+    if ( !argument.parse() ) { return 1; }
+
+    const size_t nframes = argument.hasOption("n") ? argument.optionValue<size_t>("n") : 21;
+    const size_t width = argument.hasOption("width") ? argument.optionValue<size_t>("width") : 1024;
+    const size_t height = argument.hasOption("height") ? argument.optionValue<size_t>("height") : 1024;
+    const bool slow = argument.hasOption("slow");
+
+    // The server is opened on a port assigned by the system.
+    kvs::StreamServer server;
+    if ( !server.open( 0 ) ) { return 1; }
+
+    std::atomic<bool> sent( false );
+    Client client( server.port(), &sent, slow );
+    client.start();
+    while ( server.numberOfClients() == 0 ) { server.poll( 10 ); }
+
+    for ( size_t f = 0; f < nframes; f++ )
+    {
+        // The sequence number of the next frame is assigned by the server.
+        const kvs::UInt64 sequence = server.sequence() + 1;
+        kvs::ValueArray<kvs::UInt8> pixels( width * height * 3 );
+        for ( size_t i = 0; i < pixels.size(); i++ ) { pixels[i] = ::PixelValue( sequence, i ); }
+        server.send( kvs::ColorImage( width, height, pixels ) );
+        server.poll( 0 );
+    }
+    sent = true;
+
+    // The end frame is queued after the image frames and is never dropped,
+    // since the newest frames are kept.
+    server.send( kvs::StreamFrame( kvs::StreamFrame::DataFrame, "end" ) );
+    while ( server.numberOfQueuedFrames() > 0 ) { server.poll( 10 ); }
+    client.wait();
+
+    const size_t nreceived = client.numberOfReceivedFrames();
+    const size_t nmissed = client.numberOfMissedFrames();
+    std::cout << "Sent frames: " << nframes << std::endl;
+    std::cout << "Received frames: " << nreceived << " (not identical: " << client.numberOfBrokenFrames() << ")" << std::endl;
+    std::cout << "Missed frames: " << nmissed << " (dropped by the server: " << server.numberOfDroppedFrames() << ")" << std::endl;
+
+    const bool success = client.numberOfBrokenFrames() == 0 && nreceived + nmissed == nframes;
+    std::cout << ( success ? "OK" : "FAILED" ) << std::endl;
+    return success ? 0 : 1;
+}
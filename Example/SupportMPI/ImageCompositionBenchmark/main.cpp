@@ -0,0 +1,163 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Benchmark program of the image composition
+ */
+/*****************************************************************************/
+#include <kvs/mpi/Environment>
+#include <kvs/mpi/Communicator>
+#include <kvs/mpi/ImageCompositor>
+#include <kvs/mpi/LogStream>
+#include <kvs/ValueArray>
+#include <kvs/Timer>
+#include <kvs/Math>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Fills the rectangle assigned to the rank with semi-transparent pixels.
+ *  @param  rank [in] my rank
+ *  @param  size [in] number of ranks
+ *  @param  width [in] image width
+ *  @param  height [in] image height
+ *  @param  coverage [in] ratio of the rectangle to the image size
+ *  @param  color_buffer [out] color buffer
+ *  @param  depth_buffer [out] depth buffer
+ */
+/*===========================================================================*/
+void Draw(
+    const int rank,
+    const int size,
+    const size_t width,
+    const size_t height,
+    const float coverage,
+    kvs::ValueArray<kvs::UInt8>& color_buffer,
+    kvs::ValueArray<kvs::Real32>& depth_buffer )
+{
+    color_buffer.allocate( width * height * 4 );
+    depth_buffer.allocate( width * height );
+    color_buffer.fill( 0 );
+    depth_buffer.fill( 1.0f );
+
+    const size_t w = kvs::Math::Max( size_t(1), static_cast<size_t>( width * coverage ) );
+    const size_t h = kvs::Math::Max( size_t(1), static_cast<size_t>( height * coverage ) );
+    const float t = size > 1 ? float( rank ) / ( size - 1 ) : 0.0f;
+    const size_t x0 = static_cast<size_t>( ( width - w ) * t );
+    const size_t y0 = static_cast<size_t>( ( height - h ) * ( 1.0f - t ) );
+    for ( size_t y = y0; y < y0 + h; y++ )
+    {
+        for ( size_t x = x0; x < x0 + w; x++ )
+        {
+            const size_t index = y * width + x;
+            color_buffer[ index * 4 + 0 ] = static_cast<kvs::UInt8>( 128 * t );
+            color_buffer[ index * 4 + 1 ] = 64;
+            color_buffer[ index * 4 + 2 ] = static_cast<kvs::UInt8>( 128 * ( 1.0f - t ) );
+            color_buffer[ index * 4 + 3 ] = 128;
+            depth_buffer[ index ] = 0.5f * ( 1.0f + t );
+        }
+    }
+}
+
+} // end of namespace
+
+
+int main( int argc, char** argv )
+{
+    kvs::mpi::Environment env( argc, argv );
+    kvs::mpi::Communicator world( MPI_COMM_WORLD );
+    kvs::mpi::LogStream log( world );
+
+    const int root = world.root();
+    const int size = world.size();
+    const int rank = world.rank();
+
+    // Input parameters.
+    const int image_size = argc > 1 ? atoi( argv[1] ) : 1024;
+    const float coverage = argc > 2 ? static_cast<float>( atof( argv[2] ) ) : 0.1f;
+    const int nrepeats = argc > 3 ? atoi( argv[3] ) : 10;
+    const int ntiles = argc > 4 ? atoi( argv[4] ) : 4;
+    const bool depth_testing = argc > 5 ? atoi( argv[5] ) == 1 : false;
+
+    const size_t width = image_size;
+    const size_t height = image_size;
+
+    log( root ) << "Number of ranks: " << size << std::endl;
+    log( root ) << "Image size: " << width << " x " << height << std::endl;
+    log( root ) << "Coverage: " << coverage << std::endl;
+    log( root ) << "Depth testing: " << ( depth_testing ? "on" : "off" ) << std::endl;
+
+    for ( int sparse = 0; sparse < 2; sparse++ )
+    {
+        kvs::mpi::ImageCompositor compositor( world );
+        compositor.setEnabledSparseComposition( sparse == 1 );
+        compositor.setNumberOfTiles( ntiles );
+        compositor.initialize( width, height, depth_testing );
+
+        // Accumulated time of each stage (name, time), and whole time.
+        std::vector<std::string> names;
+        std::map<std::string,double> stage_times;
+        std::map<std::string,double> stage_bytes;
+        double total_time = 0.0;
+        for ( int i = 0; i < nrepeats + 1; i++ )
+        {
+            kvs::ValueArray<kvs::UInt8> color_buffer;
+            kvs::ValueArray<kvs::Real32> depth_buffer;
+            ::Draw( rank, size, width, height, coverage, color_buffer, depth_buffer );
+
+            world.barrier();
+            kvs::Timer timer( kvs::Timer::Start );
+            if ( depth_testing ) { compositor.run( color_buffer, depth_buffer ); }
+            else { compositor.run( color_buffer ); }
+            timer.stop();
+
+            // The first run is a warm-up.
+            if ( i == 0 ) { continue; }
+
+            total_time += timer.sec();
+            if ( sparse == 0 ) { continue; }
+            for ( size_t j = 0; j < compositor.stages().size(); j++ )
+            {
+                const auto& stage = compositor.stages()[j];
+                if ( stage_times.find( stage.name ) == stage_times.end() ) { names.push_back( stage.name ); }
+                stage_times[ stage.name ] += stage.time;
+                stage_bytes[ stage.name ] += stage.send_bytes;
+            }
+        }
+        compositor.destroy();
+
+        // The stages differ between the ranks (e.g. folded ranks skip the
+        // binary-swap), so every rank reports the stages in the order of root.
+        double max_total = 0.0;
+        world.reduce( root, total_time / nrepeats, max_total, MPI_MAX );
+        log( root ) << ( sparse ? "Sparse compositor:" : "234Compositor:" ) << std::endl;
+        log( root ) << "    Total: " << max_total * 1000.0 << " [msec]" << std::endl;
+
+        int nstages = static_cast<int>( names.size() );
+        world.broadcast( root, nstages );
+        for ( int j = 0; j < nstages; j++ )
+        {
+            kvs::ValueArray<char> name( 32 );
+            name.fill( 0 );
+            if ( rank == root ) { std::copy( names[j].begin(), names[j].end(), name.begin() ); }
+            world.broadcast( root, name.data(), name.size() );
+            const std::string stage_name( name.data() );
+
+            double max_time = 0.0;
+            double sum_bytes = 0.0;
+            const double time = stage_times.count( stage_name ) ? stage_times[ stage_name ] / nrepeats : 0.0;
+            const double bytes = stage_bytes.count( stage_name ) ? stage_bytes[ stage_name ] / nrepeats : 0.0;
+            world.reduce( root, time, max_time, MPI_MAX );
+            world.reduce( root, bytes, sum_bytes, MPI_SUM );
+            log( root ) << "    " << stage_name << ": " << max_time * 1000.0 << " [msec], "
+                        << sum_bytes / 1024.0 << " [KB sent]" << std::endl;
+        }
+    }
+
+    return 0;
+}
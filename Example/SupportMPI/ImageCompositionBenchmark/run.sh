@@ -0,0 +1,11 @@
+#!/bin/sh
+IMAGE_SIZE=1024
+COVERAGE=0.1
+NREPEATS=10
+NTILES=4
+DEPTH_TESTING=0
+
+for NNODES in 2 4 8 16 32
+do
+    mpirun --oversubscribe -n $NNODES ./ImageCompositionBenchmark $IMAGE_SIZE $COVERAGE $NREPEATS $NTILES $DEPTH_TESTING
+done
@@ -0,0 +1,63 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program of domain-decomposed isosurface extraction
+ */
+/*****************************************************************************/
+#include <kvs/mpi/Environment>
+#include <kvs/mpi/Communicator>
+#include <kvs/mpi/LogStream>
+#include <kvs/mpi/VolumePartitioner>
+#include <kvs/mpi/MarchingCubes>
+#include <kvs/mpi/ObjectGatherer>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/HydrogenVolumeData>
+#include <kvs/TransferFunction>
+#include <kvs/Timer>
+#include <cstdlib>
+
+
+int main( int argc, char** argv )
+{
+    kvs::mpi::Environment env( argc, argv );
+    kvs::mpi::Communicator world( MPI_COMM_WORLD );
+    kvs::mpi::LogStream log( world );
+
+    // Input parameters.
+    const int volume_size = argc > 1 ? atoi( argv[1] ) : 128;
+    const double isolevel = argc > 2 ? atof( argv[2] ) : 40.0;
+    const size_t nghosts = argc > 3 ? atoi( argv[3] ) : 1;
+
+    // Every rank has the whole volume and extracts its own partition with the
+    // ghost layers.
+    kvs::HydrogenVolumeData volume( kvs::Vec3u::Constant( volume_size ) );
+    kvs::mpi::VolumePartitioner partitioner( world, nghosts );
+    kvs::StructuredVolumeObject* partition = partitioner.partition( &volume );
+    if ( !partition ) { world.abort(); }
+
+    // The triangles in the ghost region are culled on each rank.
+    kvs::Timer timer( kvs::Timer::Start );
+    kvs::mpi::MarchingCubes mapper( world );
+    mapper.setIsolevel( isolevel );
+    mapper.setNormalType( kvs::PolygonObject::PolygonNormal );
+    mapper.setTransferFunction( kvs::TransferFunction( 256 ) );
+    mapper.setOwnedRegion( partitioner.ownedRegion() );
+    mapper.exec( partition );
+    delete partition;
+    log() << "Rank " << world.rank() << ": " << mapper.numberOfVertices() << " vertices" << std::endl;
+
+    // The polygon objects are merged on the root rank, where the duplicated
+    // vertices on the seams are removed.
+    kvs::mpi::ObjectGatherer gatherer( world );
+    gatherer.gather( &mapper );
+    timer.stop();
+
+    log( world.root() ) << "Merged: " << mapper.numberOfVertices() << " vertices, " << mapper.numberOfConnections() << " triangles" << std::endl;
+    log( world.root() ) << "Time: " << timer.msec() << " [msec]" << std::endl;
+    if ( world.rank() == world.root() )
+    {
+        mapper.write( "isosurface.kvsml" );
+    }
+
+    return 0;
+}
@@ -0,0 +1,7 @@
+#!/bin/sh
+VOLUME_SIZE=128
+ISOLEVEL=40
+NGHOSTS=1
+NNODES=4
+
+mpirun --oversubscribe -n $NNODES ./ParallelIsosurface $VOLUME_SIZE $ISOLEVEL $NGHOSTS
@@ -0,0 +1,77 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program of sort-last distributed rendering
+ */
+/*****************************************************************************/
+#include <kvs/mpi/Environment>
+#include <kvs/mpi/Communicator>
+#include <kvs/mpi/LogStream>
+#include <kvs/mpi/VolumePartitioner>
+#include <kvs/mpi/SortLastScreen>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/HydrogenVolumeData>
+#include <kvs/Isosurface>
+#include <kvs/RayCastingRenderer>
+#include <kvs/PolygonRenderer>
+#include <kvs/TransferFunction>
+#include <kvs/ObjectManager>
+#include <kvs/Timer>
+#include <kvs/ColorImage>
+#include <cstdlib>
+
+
+int main( int argc, char** argv )
+{
+    kvs::mpi::Environment env( argc, argv );
+    kvs::mpi::Communicator world( MPI_COMM_WORLD );
+    kvs::mpi::LogStream log( world );
+
+    const int root = world.root();
+
+    // Input parameters.
+    const int volume_size = argc > 1 ? atoi( argv[1] ) : 128;
+    const int image_size = argc > 2 ? atoi( argv[2] ) : 512;
+    const bool volume_rendering = argc > 3 ? atoi( argv[3] ) == 1 : false;
+    const bool sparse_composition = argc > 4 ? atoi( argv[4] ) == 1 : false;
+
+    // Every rank has the whole volume and extracts its own partition.
+    kvs::HydrogenVolumeData volume( kvs::Vec3u::Constant( volume_size ) );
+    kvs::mpi::VolumePartitioner partitioner( world );
+    kvs::StructuredVolumeObject* partition = partitioner.partition( &volume );
+    if ( !partition ) { world.abort(); }
+
+    kvs::mpi::SortLastScreen<> screen( world );
+    screen.setSize( image_size, image_size );
+    screen.setBackgroundColor( volume_rendering ? kvs::RGBColor::Black() : kvs::RGBColor::White() );
+    screen.setEnabledSparseComposition( sparse_composition );
+    if ( volume_rendering )
+    {
+        // Semi-transparent images are alpha-blended in the visibility order.
+        auto* renderer = new kvs::glsl::RayCastingRenderer();
+        renderer->setTransferFunction( kvs::TransferFunction( 256 ) );
+        screen.disableDepthTesting();
+        screen.registerObject( partition, renderer );
+    }
+    else
+    {
+        // Opaque images are merged with the depth buffers.
+        auto* object = new kvs::Isosurface( partition, 40 );
+        delete partition;
+        screen.enableDepthTesting();
+        screen.registerObject( object, new kvs::glsl::PolygonRenderer() );
+    }
+
+    screen.scene()->objectManager()->rotate( kvs::Mat3::RotationY( 70 ) );
+
+    kvs::Timer timer( kvs::Timer::Start );
+    screen.draw();
+    timer.stop();
+
+    double max_sec = 0.0; world.reduce( root, timer.sec(), max_sec, MPI_MAX );
+    log( root ) << "Rendering and composition time: " << max_sec << " [sec]" << std::endl;
+
+    if ( screen.isRoot() ) { screen.capture().write( "output.bmp" ); }
+
+    return 0;
+}
@@ -0,0 +1,8 @@
+#!/bin/sh
+VOLUME_SIZE=128
+IMAGE_SIZE=512
+VOLUME_RENDERING=0
+SPARSE_COMPOSITION=0
+NNODES=4
+
+mpirun --oversubscribe -n $NNODES ./SortLastRendering $VOLUME_SIZE $IMAGE_SIZE $VOLUME_RENDERING $SPARSE_COMPOSITION
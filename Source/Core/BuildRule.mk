@@ -64,6 +64,9 @@ $(OUTDIR)/./FileFormat/IPLab/IPLabList.o \
 $(OUTDIR)/./FileFormat/JSON/Array.o \
 $(OUTDIR)/./FileFormat/JSON/Json.o \
 $(OUTDIR)/./FileFormat/JSON/Object.o \
+$(OUTDIR)/./FileFormat/KVSB/Codec.o \
+$(OUTDIR)/./FileFormat/KVSB/Container.o \
+$(OUTDIR)/./FileFormat/KVSB/KVSBObject.o \
 $(OUTDIR)/./FileFormat/KVSML/CellTag.o \
 $(OUTDIR)/./FileFormat/KVSML/ColorMapTag.o \
 $(OUTDIR)/./FileFormat/KVSML/ColorTag.o \
@@ -71,9 +74,12 @@ $(OUTDIR)/./FileFormat/KVSML/ColumnTag.o \
 $(OUTDIR)/./FileFormat/KVSML/ConnectionTag.o \
 $(OUTDIR)/./FileFormat/KVSML/CoordTag.o \
 $(OUTDIR)/./FileFormat/KVSML/DataArrayTag.o \
+$(OUTDIR)/./FileFormat/KVSML/DataArrayWriter.o \
 $(OUTDIR)/./FileFormat/KVSML/DataReader.o \
 $(OUTDIR)/./FileFormat/KVSML/DataValueTag.o \
 $(OUTDIR)/./FileFormat/KVSML/DataWriter.o \
+$(OUTDIR)/./FileFormat/KVSML/Document.o \
+$(OUTDIR)/./FileFormat/KVSML/FormatChecker.o \
 $(OUTDIR)/./FileFormat/KVSML/ImageObjectTag.o \
 $(OUTDIR)/./FileFormat/KVSML/KVSMLImageObject.o \
 $(OUTDIR)/./FileFormat/KVSML/KVSMLLineObject.o \
@@ -96,6 +102,7 @@ $(OUTDIR)/./FileFormat/KVSML/PointObjectTag.o \
 $(OUTDIR)/./FileFormat/KVSML/PolygonObjectTag.o \
 $(OUTDIR)/./FileFormat/KVSML/PolygonTag.o \
 $(OUTDIR)/./FileFormat/KVSML/SizeTag.o \
+$(OUTDIR)/./FileFormat/KVSML/StreamReader.o \
 $(OUTDIR)/./FileFormat/KVSML/StructuredVolumeObjectTag.o \
 $(OUTDIR)/./FileFormat/KVSML/TableObjectTag.o \
 $(OUTDIR)/./FileFormat/KVSML/TagBase.o \
@@ -164,6 +171,9 @@ $(OUTDIR)/./Network/Socket.o \
 $(OUTDIR)/./Network/SocketAddress.o \
 $(OUTDIR)/./Network/SocketSelector.o \
 $(OUTDIR)/./Network/SocketTimer.o \
+$(OUTDIR)/./Network/StreamClient.o \
+$(OUTDIR)/./Network/StreamFrame.o \
+$(OUTDIR)/./Network/StreamServer.o \
 $(OUTDIR)/./Network/TCPBarrier.o \
 $(OUTDIR)/./Network/TCPBarrierServer.o \
 $(OUTDIR)/./Network/TCPServer.o \
@@ -223,7 +233,9 @@ $(OUTDIR)/./Thread/MutexLocker.o \
 $(OUTDIR)/./Thread/ReadLocker.o \
 $(OUTDIR)/./Thread/ReadWriteLock.o \
 $(OUTDIR)/./Thread/Semaphore.o \
+$(OUTDIR)/./Thread/TaskGroup.o \
 $(OUTDIR)/./Thread/Thread.o \
+$(OUTDIR)/./Thread/ThreadPool.o \
 $(OUTDIR)/./Thread/WriteLocker.o \
 $(OUTDIR)/./Utility/AnyValueArray.o \
 $(OUTDIR)/./Utility/AnyValueTable.o \
@@ -243,6 +255,7 @@ $(OUTDIR)/./Utility/String.o \
 $(OUTDIR)/./Utility/SystemInformation.o \
 $(OUTDIR)/./Utility/Time.o \
 $(OUTDIR)/./Utility/Tokenizer.o \
+$(OUTDIR)/./Utility/Trace.o \
 $(OUTDIR)/./Utility/Type.o \
 $(OUTDIR)/./Utility/Value.o \
 $(OUTDIR)/./Utility/ValueArray.o \
@@ -394,6 +407,7 @@ $(OUTDIR)/./Visualization/Viewer/Background.o \
 $(OUTDIR)/./Visualization/Viewer/Camera.o \
 $(OUTDIR)/./Visualization/Viewer/CameraCoordinate.o \
 $(OUTDIR)/./Visualization/Viewer/FontMetrics.o \
+$(OUTDIR)/./Visualization/Viewer/FrameCapture.o \
 $(OUTDIR)/./Visualization/Viewer/IDManager.o \
 $(OUTDIR)/./Visualization/Viewer/Light.o \
 $(OUTDIR)/./Visualization/Viewer/Mouse.o \
@@ -543,6 +557,10 @@ $(OUTDIR)/./FileFormat/KVSML/%.o: ./FileFormat/KVSML/%.cpp ./FileFormat/KVSML/%.
 	$(MKDIR) $(OUTDIR)/./FileFormat/KVSML
 	$(CPP) -c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) -o $@ $<
 
+$(OUTDIR)/./FileFormat/KVSB/%.o: ./FileFormat/KVSB/%.cpp ./FileFormat/KVSB/%.h
+	$(MKDIR) $(OUTDIR)/./FileFormat/KVSB
+	$(CPP) -c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) -o $@ $<
+
 $(OUTDIR)/./FileFormat/JSON/%.o: ./FileFormat/JSON/%.cpp ./FileFormat/JSON/%.h
 	$(MKDIR) $(OUTDIR)/./FileFormat/JSON
 	$(CPP) -c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) -o $@ $<
@@ -625,6 +643,8 @@ install::
 	$(INSTALL) ./FileFormat/IPLab/*.h $(INSTALL_DIR)/include/Core/./FileFormat/IPLab
 	$(MKDIR) $(INSTALL_DIR)/include/Core/./FileFormat/JSON
 	$(INSTALL) ./FileFormat/JSON/*.h $(INSTALL_DIR)/include/Core/./FileFormat/JSON
+	$(MKDIR) $(INSTALL_DIR)/include/Core/./FileFormat/KVSB
+	$(INSTALL) ./FileFormat/KVSB/*.h $(INSTALL_DIR)/include/Core/./FileFormat/KVSB
 	$(MKDIR) $(INSTALL_DIR)/include/Core/./FileFormat/KVSML
 	$(INSTALL) ./FileFormat/KVSML/*.h $(INSTALL_DIR)/include/Core/./FileFormat/KVSML
 	$(MKDIR) $(INSTALL_DIR)/include/Core/./FileFormat/PLY
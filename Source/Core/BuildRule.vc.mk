@@ -64,6 +64,9 @@ $(OUTDIR)\.\FileFormat\IPLab\IPLabList.obj \
 $(OUTDIR)\.\FileFormat\JSON\Array.obj \
 $(OUTDIR)\.\FileFormat\JSON\Json.obj \
 $(OUTDIR)\.\FileFormat\JSON\Object.obj \
+$(OUTDIR)\.\FileFormat\KVSB\Codec.obj \
+$(OUTDIR)\.\FileFormat\KVSB\Container.obj \
+$(OUTDIR)\.\FileFormat\KVSB\KVSBObject.obj \
 $(OUTDIR)\.\FileFormat\KVSML\CellTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\ColorMapTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\ColorTag.obj \
@@ -71,9 +74,12 @@ $(OUTDIR)\.\FileFormat\KVSML\ColumnTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\ConnectionTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\CoordTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\DataArrayTag.obj \
+$(OUTDIR)\.\FileFormat\KVSML\DataArrayWriter.obj \
 $(OUTDIR)\.\FileFormat\KVSML\DataReader.obj \
 $(OUTDIR)\.\FileFormat\KVSML\DataValueTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\DataWriter.obj \
+$(OUTDIR)\.\FileFormat\KVSML\Document.obj \
+$(OUTDIR)\.\FileFormat\KVSML\FormatChecker.obj \
 $(OUTDIR)\.\FileFormat\KVSML\ImageObjectTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\KVSMLImageObject.obj \
 $(OUTDIR)\.\FileFormat\KVSML\KVSMLLineObject.obj \
@@ -96,6 +102,7 @@ $(OUTDIR)\.\FileFormat\KVSML\PointObjectTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\PolygonObjectTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\PolygonTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\SizeTag.obj \
+$(OUTDIR)\.\FileFormat\KVSML\StreamReader.obj \
 $(OUTDIR)\.\FileFormat\KVSML\StructuredVolumeObjectTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\TableObjectTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\TagBase.obj \
@@ -164,6 +171,9 @@ $(OUTDIR)\.\Network\Socket.obj \
 $(OUTDIR)\.\Network\SocketAddress.obj \
 $(OUTDIR)\.\Network\SocketSelector.obj \
 $(OUTDIR)\.\Network\SocketTimer.obj \
+$(OUTDIR)\.\Network\StreamClient.obj \
+$(OUTDIR)\.\Network\StreamFrame.obj \
+$(OUTDIR)\.\Network\StreamServer.obj \
 $(OUTDIR)\.\Network\TCPBarrier.obj \
 $(OUTDIR)\.\Network\TCPBarrierServer.obj \
 $(OUTDIR)\.\Network\TCPServer.obj \
@@ -223,7 +233,9 @@ $(OUTDIR)\.\Thread\MutexLocker.obj \
 $(OUTDIR)\.\Thread\ReadLocker.obj \
 $(OUTDIR)\.\Thread\ReadWriteLock.obj \
 $(OUTDIR)\.\Thread\Semaphore.obj \
+$(OUTDIR)\.\Thread\TaskGroup.obj \
 $(OUTDIR)\.\Thread\Thread.obj \
+$(OUTDIR)\.\Thread\ThreadPool.obj \
 $(OUTDIR)\.\Thread\WriteLocker.obj \
 $(OUTDIR)\.\Utility\AnyValueArray.obj \
 $(OUTDIR)\.\Utility\AnyValueTable.obj \
@@ -243,6 +255,7 @@ $(OUTDIR)\.\Utility\String.obj \
 $(OUTDIR)\.\Utility\SystemInformation.obj \
 $(OUTDIR)\.\Utility\Time.obj \
 $(OUTDIR)\.\Utility\Tokenizer.obj \
+$(OUTDIR)\.\Utility\Trace.obj \
 $(OUTDIR)\.\Utility\Type.obj \
 $(OUTDIR)\.\Utility\Value.obj \
 $(OUTDIR)\.\Utility\ValueArray.obj \
@@ -394,6 +407,7 @@ $(OUTDIR)\.\Visualization\Viewer\Background.obj \
 $(OUTDIR)\.\Visualization\Viewer\Camera.obj \
 $(OUTDIR)\.\Visualization\Viewer\CameraCoordinate.obj \
 $(OUTDIR)\.\Visualization\Viewer\FontMetrics.obj \
+$(OUTDIR)\.\Visualization\Viewer\FrameCapture.obj \
 $(OUTDIR)\.\Visualization\Viewer\IDManager.obj \
 $(OUTDIR)\.\Visualization\Viewer\Light.obj \
 $(OUTDIR)\.\Visualization\Viewer\Mouse.obj \
@@ -599,6 +613,12 @@ $<
 $<
 <<
 
+{.\FileFormat\KVSB\}.cpp{$(OUTDIR)\.\FileFormat\KVSB\}.obj::
+	IF NOT EXIST $(OUTDIR)\.\FileFormat\KVSB $(MKDIR) $(OUTDIR)\.\FileFormat\KVSB
+	$(CPP) /c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) /Fo$(OUTDIR)\.\FileFormat\KVSB\ @<<
+$<
+<<
+
 {.\FileFormat\JSON\}.cpp{$(OUTDIR)\.\FileFormat\JSON\}.obj::
 	IF NOT EXIST $(OUTDIR)\.\FileFormat\JSON $(MKDIR) $(OUTDIR)\.\FileFormat\JSON
 	$(CPP) /c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) /Fo$(OUTDIR)\.\FileFormat\JSON\ @<<
@@ -707,6 +727,8 @@ install::
 	$(INSTALL) .\FileFormat\IPLab\*.h $(INSTALL_DIR)\include\Core\.\FileFormat\IPLab
 	IF NOT EXIST $(INSTALL_DIR)\include\Core\.\FileFormat\JSON $(MKDIR) $(INSTALL_DIR)\include\Core\.\FileFormat\JSON
 	$(INSTALL) .\FileFormat\JSON\*.h $(INSTALL_DIR)\include\Core\.\FileFormat\JSON
+	IF NOT EXIST $(INSTALL_DIR)\include\Core\.\FileFormat\KVSB $(MKDIR) $(INSTALL_DIR)\include\Core\.\FileFormat\KVSB
+	$(INSTALL) .\FileFormat\KVSB\*.h $(INSTALL_DIR)\include\Core\.\FileFormat\KVSB
 	IF NOT EXIST $(INSTALL_DIR)\include\Core\.\FileFormat\KVSML $(MKDIR) $(INSTALL_DIR)\include\Core\.\FileFormat\KVSML
 	$(INSTALL) .\FileFormat\KVSML\*.h $(INSTALL_DIR)\include\Core\.\FileFormat\KVSML
 	IF NOT EXIST $(INSTALL_DIR)\include\Core\.\FileFormat\PLY $(MKDIR) $(INSTALL_DIR)\include\Core\.\FileFormat\PLY
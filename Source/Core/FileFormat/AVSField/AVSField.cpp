@@ -14,6 +14,7 @@
 #include <kvs/Platform>
 #include <kvs/Version>
 #include <kvs/Endian>
+#include <kvs/Trace>
 
 
 namespace
@@ -512,6 +513,7 @@ void AVSField::print( std::ostream& os, const kvs::Indent& indent ) const
 /*==========================================================================*/
 bool AVSField::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::AVSField::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
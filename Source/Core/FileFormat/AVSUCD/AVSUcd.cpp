@@ -19,6 +19,7 @@
 #include <kvs/IgnoreUnusedVariable>
 #include <cstdlib>
 #include <cstring>
+#include <kvs/Trace>
 
 
 namespace
@@ -439,6 +440,7 @@ void AVSUcd::print( std::ostream& os, const kvs::Indent& indent ) const
 /*==========================================================================*/
 bool AVSUcd::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::AVSUcd::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
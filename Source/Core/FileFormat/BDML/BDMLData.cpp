@@ -8,6 +8,7 @@
 #include "XML.h"
 #include <kvs/IgnoreUnusedVariable>
 #include <kvs/File>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -42,6 +43,7 @@ void BDMLData::print( std::ostream& os, const kvs::Indent& indent ) const
 
 bool BDMLData::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::BDMLData::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
@@ -12,6 +12,7 @@
 #include <kvs/Message>
 #include <kvs/File>
 #include <kvs/Math>
+#include <kvs/Trace>
 
 
 namespace
@@ -110,6 +111,7 @@ void Bmp::print( std::ostream& os, const kvs::Indent& indent ) const
 /*==========================================================================*/
 bool Bmp::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Bmp::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
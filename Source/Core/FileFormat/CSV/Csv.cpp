@@ -9,6 +9,7 @@
 #include <sstream>
 #include <kvs/Message>
 #include <kvs/File>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -150,6 +151,7 @@ void Csv::print( std::ostream& os, const kvs::Indent& indent ) const
 /*===========================================================================*/
 bool Csv::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Csv::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
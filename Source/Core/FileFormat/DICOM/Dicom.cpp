@@ -23,6 +23,7 @@
 #include "VRType.h"
 #include "Element.h"
 #include "Value.h"
+#include <kvs/Trace>
 
 
 namespace
@@ -650,55 +651,101 @@ void Dicom::print( std::ostream& os, const kvs::Indent& indent ) const
 
 /*===========================================================================*/
 /**
- *  @brief  Read the given file as DICOM format.
- *  @param  filename [i] filename
- *  @return true, if the reading process is done successfully
+ *  @brief  Calculates the min/max values of the given raw data.
+ *  @param  raw_data [in] raw data of the image
+ *  @param  min_value [out] min. raw value
+ *  @param  max_value [out] max. raw value
  */
 /*===========================================================================*/
-bool Dicom::read( const std::string& filename )
+void Dicom::calculateMinMaxRawValue(
+    const kvs::ValueArray<char>& raw_data,
+    int* min_value,
+    int* max_value ) const
 {
-    BaseClass::setFilename( filename );
-    BaseClass::setSuccess( true );
-
-    // Open the file.
-    std::ifstream ifs( filename.c_str(), std::ios_base::binary );
-    if( ifs.fail() )
+    *min_value = 0;
+    *max_value = 0;
+    if( m_bits_allocated == 8 )
     {
-        kvsMessageError( "Cannot open %s.", filename.c_str() );
-        BaseClass::setSuccess( false );
-        return false;
+        if( m_pixel_representation )
+        {
+            this->calculate_min_max_raw_value<kvs::UInt8>( raw_data, min_value, max_value );
+        }
+        else
+        {
+            this->calculate_min_max_raw_value<kvs::Int8>( raw_data, min_value, max_value );
+        }
     }
-
-    // Check attribute.
-    if( !m_attribute.check( ifs ) )
+    else if( m_bits_allocated == 16 )
     {
-        kvsMessageError("Fail the attribute check of the DICOM file.");
-        ifs.close();
-        BaseClass::setSuccess( false );
-        return false;
+        if( m_pixel_representation )
+        {
+            this->calculate_min_max_raw_value<kvs::UInt16>( raw_data, min_value, max_value );
+        }
+        else
+        {
+            this->calculate_min_max_raw_value<kvs::Int16>( raw_data, min_value, max_value );
+        }
     }
+}
 
-    // Read the header information.
-    if( !this->read_header( ifs ) )
+/*===========================================================================*/
+/**
+ *  @brief  Reads the raw data of the image from the file.
+ *  @return raw data (empty if the reading process failed)
+ *
+ *  The raw data is read from the file given by read() or readHeader()
+ *  without being stored in this class.
+ */
+/*===========================================================================*/
+kvs::ValueArray<char> Dicom::readRawData() const
+{
+    const std::string& filename = BaseClass::filename();
+    std::ifstream ifs( filename.c_str(), std::ios_base::binary );
+    if( ifs.fail() )
     {
-        kvsMessageError("Cannot read the header of the DICOM file.");
-        ifs.close();
-        BaseClass::setSuccess( false );
-        return false;
+        kvsMessageError( "Cannot open %s.", filename.c_str() );
+        return kvs::ValueArray<char>();
     }
 
-    // Read the pixel data.
-    if( !this->read_data( ifs ) )
+    const size_t raw_data_size = m_row * m_column * ( m_bits_allocated >> 3 );
+    kvs::ValueArray<char> raw_data( raw_data_size );
+    ifs.seekg( m_position, std::ios::beg );
+    ifs.read( raw_data.data(), raw_data_size );
+    if( ifs.fail() )
     {
-        kvsMessageError("Cannot read the pixel data of the DICOM file.");
-        ifs.close();
-        BaseClass::setSuccess( false );
-        return false;
+        kvsMessageError( "Cannot read the raw data of %s.", filename.c_str() );
+        return kvs::ValueArray<char>();
     }
 
-    ifs.close();
+    return raw_data;
+}
 
-    return true;
+/*===========================================================================*/
+/**
+ *  @brief  Reads the header of the given file without the pixel data.
+ *  @param  filename [i] filename
+ *  @return true, if the reading process is done successfully
+ *
+ *  The raw data is not read, and min/max raw values are not calculated. The
+ *  raw data can be read by readRawData() afterwards.
+ */
+/*===========================================================================*/
+bool Dicom::readHeader( const std::string& filename )
+{
+    return this->read_file( filename, true );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Read the given file as DICOM format.
+ *  @param  filename [i] filename
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool Dicom::read( const std::string& filename )
+{
+    KVS_TRACE_SCOPE( "kvs::Dicom::read" );
+    return this->read_file( filename, false );
 }
 
 /*===========================================================================*/
@@ -741,6 +788,67 @@ bool Dicom::write( const std::string& filename )
     return true;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Read the given file as DICOM format.
+ *  @param  filename [i] filename
+ *  @param  header_only [i] if true, the pixel data is not read
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool Dicom::read_file( const std::string& filename, const bool header_only )
+{
+    BaseClass::setFilename( filename );
+    BaseClass::setSuccess( true );
+
+    // Open the file.
+    std::ifstream ifs( filename.c_str(), std::ios_base::binary );
+    if( ifs.fail() )
+    {
+        kvsMessageError( "Cannot open %s.", filename.c_str() );
+        BaseClass::setSuccess( false );
+        return false;
+    }
+
+    // Check attribute.
+    if( !m_attribute.check( ifs ) )
+    {
+        kvsMessageError("Fail the attribute check of the DICOM file.");
+        ifs.close();
+        BaseClass::setSuccess( false );
+        return false;
+    }
+
+    // Read the header information.
+    if( !this->read_header( ifs ) )
+    {
+        kvsMessageError("Cannot read the header of the DICOM file.");
+        ifs.close();
+        BaseClass::setSuccess( false );
+        return false;
+    }
+
+    if( header_only )
+    {
+        this->set_min_max_window_value();
+        ifs.close();
+        return true;
+    }
+
+    // Read the pixel data.
+    if( !this->read_data( ifs ) )
+    {
+        kvsMessageError("Cannot read the pixel data of the DICOM file.");
+        ifs.close();
+        BaseClass::setSuccess( false );
+        return false;
+    }
+
+    ifs.close();
+
+    return true;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Read the header information of the DICOM file.
@@ -923,29 +1031,31 @@ void Dicom::set_min_max_window_value()
  */
 /*===========================================================================*/
 template <typename T>
-void Dicom::calculate_min_max_raw_value()
-{
-    const T* raw_data = reinterpret_cast<const T*>( m_raw_data.data() );
-
-    double min_raw_value = raw_data[0];
-    double max_raw_value = raw_data[0];
-
-    int npixels = m_column * m_row;
-    for( int index = 1; index < npixels; index++ )
+void Dicom::calculate_min_max_raw_value(
+    const kvs::ValueArray<char>& raw_data,
+    int* min_value,
+    int* max_value ) const
+{
+    const size_t npixels = kvs::Math::Min( size_t( m_column ) * m_row, raw_data.size() / sizeof(T) );
+    if ( npixels == 0 ) { *min_value = 0; *max_value = 0; return; }
+
+    const T* data = reinterpret_cast<const T*>( raw_data.data() );
+    T min_raw_value = data[0];
+    T max_raw_value = data[0];
+    for( size_t index = 1; index < npixels; index++ )
     {
-        double raw_value  = raw_data[index];
-        min_raw_value = kvs::Math::Min( min_raw_value, raw_value );
-        max_raw_value = kvs::Math::Max( max_raw_value, raw_value );
+        min_raw_value = kvs::Math::Min( min_raw_value, data[index] );
+        max_raw_value = kvs::Math::Max( max_raw_value, data[index] );
     }
 
-    m_min_raw_value = kvs::Math::Round( min_raw_value );
-    m_max_raw_value = kvs::Math::Round( max_raw_value );
+    *min_value = static_cast<int>( min_raw_value );
+    *max_value = static_cast<int>( max_raw_value );
 }
 
-template void Dicom::calculate_min_max_raw_value<kvs::Int8>();
-template void Dicom::calculate_min_max_raw_value<kvs::UInt8>();
-template void Dicom::calculate_min_max_raw_value<kvs::Int16>();
-template void Dicom::calculate_min_max_raw_value<kvs::UInt16>();
+template void Dicom::calculate_min_max_raw_value<kvs::Int8>( const kvs::ValueArray<char>&, int*, int* ) const;
+template void Dicom::calculate_min_max_raw_value<kvs::UInt8>( const kvs::ValueArray<char>&, int*, int* ) const;
+template void Dicom::calculate_min_max_raw_value<kvs::Int16>( const kvs::ValueArray<char>&, int*, int* ) const;
+template void Dicom::calculate_min_max_raw_value<kvs::UInt16>( const kvs::ValueArray<char>&, int*, int* ) const;
 
 /*===========================================================================*/
 /**
@@ -954,28 +1064,7 @@ template void Dicom::calculate_min_max_raw_value<kvs::UInt16>();
 /*===========================================================================*/
 void Dicom::set_min_max_raw_value()
 {
-    if( m_bits_allocated == 8 )
-    {
-        if( m_pixel_representation )
-        {
-            this->calculate_min_max_raw_value<kvs::UInt8>();
-        }
-        else
-        {
-            this->calculate_min_max_raw_value<kvs::Int8>();
-        }
-    }
-    else if( m_bits_allocated == 16 )
-    {
-        if( m_pixel_representation )
-        {
-            this->calculate_min_max_raw_value<kvs::UInt16>();
-        }
-        else
-        {
-            this->calculate_min_max_raw_value<kvs::Int16>();
-        }
-    }
+    this->calculateMinMaxRawValue( m_raw_data, &m_min_raw_value, &m_max_raw_value );
 }
 
 /*===========================================================================*/
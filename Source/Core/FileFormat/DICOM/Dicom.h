@@ -117,15 +117,19 @@ public:
     int value( const size_t x, const size_t y ) const;
 
     void setRawData( const kvs::ValueArray<char>& raw_data );
+    kvs::ValueArray<char> readRawData() const;
+    void calculateMinMaxRawValue( const kvs::ValueArray<char>& raw_data, int* min_value, int* max_value ) const;
     void changeWindow( const int level, const int width );
     void resetWindow();
     std::list<dcm::Element>::iterator findElement( const dcm::Tag tag );
     void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
     bool read( const std::string& filename );
+    bool readHeader( const std::string& filename );
     bool write( const std::string& filename );
 
 private:
 
+    bool read_file( const std::string& filename, const bool header_only );
     bool read_header( std::ifstream& ifs );
     bool read_data( std::ifstream& ifs );
     bool write_header( std::ofstream& ofs );
@@ -134,7 +138,7 @@ private:
     void set_windowing_parameter();
     void set_min_max_window_value();
     template <typename T>
-    void calculate_min_max_raw_value();
+    void calculate_min_max_raw_value( const kvs::ValueArray<char>& raw_data, int* min_value, int* max_value ) const;
     void set_min_max_raw_value();
     template <typename T>
     kvs::ValueArray<kvs::UInt8> rescale_pixel_data( const int level, const int width ) const;
@@ -12,6 +12,10 @@
 #include <kvs/Message>
 #include <kvs/Math>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Parallel>
+#include <kvs/Trace>
+#include <vector>
+#include <string>
 
 
 namespace kvs
@@ -112,7 +116,8 @@ DicomList::DicomList():
     m_slice_thickness( 0.0 ),
     m_min_raw_value( 0 ),
     m_max_raw_value( 0 ),
-    m_extension_check( true )
+    m_extension_check( true ),
+    m_enable_header_only( false )
 {
 }
 
@@ -129,10 +134,10 @@ DicomList::DicomList( const std::string& dirname, const bool extension_check ):
     m_slice_thickness( 0.0 ),
     m_min_raw_value( 0 ),
     m_max_raw_value( 0 ),
-    m_extension_check( extension_check )
+    m_extension_check( extension_check ),
+    m_enable_header_only( false )
 {
-    this->read( dirname );
-    this->sort(); // Sorting by slice location. (default sorting method)
+    this->read( dirname ); // Sorted by slice location. (default sorting method)
 }
 
 /*===========================================================================*/
@@ -377,6 +382,11 @@ void DicomList::print( std::ostream& os, const kvs::Indent& indent )
 /**
  *  @brief  Read DICOM set from directory.
  *  @param  dirname [in] directory name
+ *
+ *  The files are read in parallel and sorted by slice location. If the
+ *  header-only mode is enabled, the raw data of each slice is not kept in
+ *  memory and should be read by kvs::Dicom::readRawData() when needed, and
+ *  the min/max raw values of the list are not calculated.
  */
 /*===========================================================================*/
 bool DicomList::read( const std::string& dirname )
@@ -406,8 +416,8 @@ bool DicomList::read( const std::string& dirname )
         return false;
     }
 
-    // Read DICOM data file. (".dcm" only, if extension_check is true)
-    bool flag = false;
+    // List DICOM data files. (".dcm" only, if extension_check is true)
+    std::vector<std::string> filenames;
     for ( const auto& file : dir.fileList() )
     {
         if ( m_extension_check )
@@ -415,7 +425,28 @@ bool DicomList::read( const std::string& dirname )
             if ( file.extension() != "dcm" ) continue;
         }
 
-        kvs::Dicom* dicom = new kvs::Dicom( file.filePath( true ) );
+        filenames.push_back( file.filePath( true ) );
+    }
+
+    // Read the files in parallel. The raw data is not read if the header-only
+    // mode is enabled.
+    const long nfiles = static_cast<long>( filenames.size() );
+    std::vector<kvs::Dicom*> dicoms( nfiles, NULL );
+    {
+        KVS_TRACE_SCOPE( "kvs::DicomList::read::files" );
+        kvs::ParallelFor( 0L, nfiles, [&]( const long i )
+        {
+            kvs::Dicom* dicom = new kvs::Dicom();
+            if ( m_enable_header_only ) { dicom->readHeader( filenames[i] ); }
+            else { dicom->read( filenames[i] ); }
+            dicoms[i] = dicom;
+        } );
+    }
+
+    bool flag = false;
+    for ( long i = 0; i < nfiles; i++ )
+    {
+        kvs::Dicom* dicom = dicoms[i];
         if ( !flag )
         {
             m_row = dicom->row();
@@ -431,7 +462,8 @@ bool DicomList::read( const std::string& dirname )
         {
             if ( m_row != dicom->row() || m_column != dicom->column() )
             {
-                kvsMessageError( "Not correspond image size (%s).", file.filePath().c_str() );
+                kvsMessageError( "Not correspond image size (%s).", filenames[i].c_str() );
+                delete dicom;
                 continue;
             }
 
@@ -442,6 +474,9 @@ bool DicomList::read( const std::string& dirname )
         m_list.push_back( dicom );
     }
 
+    // Sorting by slice location. (default sorting method)
+    std::stable_sort( m_list.begin(), m_list.end(), SortingBySliceLocation() );
+
     return true;
 }
 
@@ -58,6 +58,7 @@ protected:
     int m_min_raw_value; ///< min. value of the raw data
     int m_max_raw_value; ///< max. value of the raw data
     bool m_extension_check; ///< check the file extension
+    bool m_enable_header_only; ///< read the headers only (without the raw data)
 
 public:
 
@@ -89,6 +90,10 @@ public:
     int maxRawValue() const;
     void enableExtensionCheck();
     void disableExtensionCheck();
+    void setEnabledHeaderOnly( const bool enable ) { m_enable_header_only = enable; }
+    void enableHeaderOnly() { this->setEnabledHeaderOnly( true ); }
+    void disableHeaderOnly() { this->setEnabledHeaderOnly( false ); }
+    bool isEnabledHeaderOnly() const { return m_enable_header_only; }
 
     void sort()
     {
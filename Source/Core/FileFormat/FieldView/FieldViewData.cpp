@@ -12,6 +12,7 @@
 #include <kvs/Endian>
 #include <kvs/ValueArray>
 #include <kvs/File>
+#include <kvs/Trace>
 
 
 namespace
@@ -295,6 +296,7 @@ void FieldViewData::print( std::ostream& os, const kvs::Indent& indent ) const
 /*===========================================================================*/
 bool FieldViewData::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::FieldViewData::read" );
     setFilename( filename );
     setSuccess( false );
 
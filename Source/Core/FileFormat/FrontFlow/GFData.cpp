@@ -7,6 +7,7 @@
 #include "GFData.h"
 #include <kvs/IgnoreUnusedVariable>
 #include <kvs/Tokenizer>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -104,6 +105,7 @@ void GFData::print( std::ostream& os, const kvs::Indent& indent ) const
 /*===========================================================================*/
 bool GFData::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::GFData::read" );
     kvs::Tokenizer t( filename, ";" );
     const std::string mesh_file = t.isLast() ? "" : t.token();
     const std::string flow_file = t.isLast() ? "" : t.token();
@@ -12,6 +12,9 @@
 #include <kvs/Directory>
 #include <kvs/String>
 #include <kvs/File>
+#include <kvs/Trace>
+#include <kvs/Math>
+#include <kvs/Message>
 
 
 namespace
@@ -197,6 +200,71 @@ const GrADS::GriddedBinaryDataFile& GrADS::data( const size_t index ) const
     return m_data_list[index];
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Reads the values of the variable at the time step from the data file.
+ *  @param  varname [in] variable name in VARS
+ *  @param  tindex [in] index of the gridded binary data file (time step)
+ *  @param  level [in] index of the first vertical level in ZDEF
+ *  @param  nlevels [in] number of the levels (0: all the levels from 'level')
+ *  @return values (XDEF x YDEF x nlevels; empty if the reading process failed)
+ *
+ *  Only the selected variable, levels and time step are read from the file
+ *  without loading the whole data.
+ */
+/*===========================================================================*/
+const kvs::ValueArray<kvs::Real32> GrADS::readValues(
+    const std::string& varname,
+    const size_t tindex,
+    const size_t level,
+    const size_t nlevels ) const
+{
+    if ( tindex >= m_data_list.size() )
+    {
+        kvsMessageError( "Time step %lu is out of range.", static_cast<unsigned long>( tindex ) );
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    // Offset of the variable in the time step. The variables are stored in
+    // the order of VARS, and each of them has XDEF x YDEF x levels values.
+    const size_t nxy = m_data_descriptor.xdef().num * m_data_descriptor.ydef().num;
+    size_t offset = 0;
+    size_t nvalues_per_time = 0;
+    size_t levels = 0;
+    bool found = false;
+    for ( const auto& var : m_data_descriptor.vars().values )
+    {
+        const size_t n = static_cast<size_t>( kvs::Math::Max( var.levs, 1 ) ) * nxy;
+        if ( !found && var.varname == varname ) { offset = nvalues_per_time; levels = n / nxy; found = true; }
+        nvalues_per_time += n;
+    }
+
+    if ( !found )
+    {
+        kvsMessageError( "Variable %s is not found.", varname.c_str() );
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    const size_t nselected = nlevels == 0 ? ( level < levels ? levels - level : 0 ) : nlevels;
+    if ( nselected == 0 || level + nselected > levels )
+    {
+        kvsMessageError( "Levels of %s are out of range.", varname.c_str() );
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    // The time steps which share the data file (no templates in DSET) are
+    // stored in the order of TDEF.
+    const GriddedBinaryDataFile& data = m_data_list[ tindex ];
+    size_t time_offset = 0;
+    for ( size_t i = 0; i < tindex; i++ )
+    {
+        if ( m_data_list[i].filename() == data.filename() ) { time_offset++; }
+    }
+
+    offset += time_offset * nvalues_per_time + level * nxy;
+    return data.read( offset, nselected * nxy );
+}
+
 void GrADS::print( std::ostream& os, const kvs::Indent& indent ) const
 {
     m_data_descriptor.print( os, indent );
@@ -221,6 +289,7 @@ void GrADS::print( std::ostream& os, const kvs::Indent& indent ) const
 /*===========================================================================*/
  bool GrADS::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::GrADS::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
@@ -49,6 +49,11 @@ public:
     const DataDescriptorFile& dataDescriptor() const;
     const GriddedBinaryDataFileList& dataList() const;
     const GriddedBinaryDataFile& data( const size_t index ) const;
+    const kvs::ValueArray<kvs::Real32> readValues(
+        const std::string& varname,
+        const size_t tindex,
+        const size_t level = 0,
+        const size_t nlevels = 0 ) const;
 
     void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
     bool read( const std::string& filename );
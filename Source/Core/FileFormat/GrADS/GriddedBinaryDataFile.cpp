@@ -6,7 +6,21 @@
 /*****************************************************************************/
 #include "GriddedBinaryDataFile.h"
 #include <fstream>
+#include <vector>
+#include <cstring>
 #include <kvs/Endian>
+#include <kvs/Math>
+#include <kvs/Message>
+#include <kvs/Trace>
+
+
+namespace
+{
+
+/// Number of bytes read from the file at once for the sequential data.
+const size_t ChunkSize = 16 * 1024 * 1024;
+
+} // end of namespace
 
 
 namespace kvs
@@ -156,6 +170,58 @@ const kvs::ValueArray<kvs::Real32> GriddedBinaryDataFile::values(
     return dst;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of data values in the data file.
+ *  @return number of values (0 if the file cannot be opened)
+ */
+/*===========================================================================*/
+size_t GriddedBinaryDataFile::numberOfValues() const
+{
+    std::ifstream ifs;
+    size_t record_size = 0;
+    size_t nvalues = 0;
+    if ( !this->open( ifs, &record_size, &nvalues ) ) { return 0; }
+    return nvalues;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the data values in the specified range from the data file.
+ *  @param  offset [in] index of the first value
+ *  @param  nvalues [in] number of values
+ *  @return data values (empty if the reading process failed)
+ *
+ *  Only the specified range is read from the file without loading the whole
+ *  data, and the loaded values are not changed.
+ */
+/*===========================================================================*/
+const kvs::ValueArray<kvs::Real32> GriddedBinaryDataFile::read(
+    const size_t offset,
+    const size_t nvalues ) const
+{
+    KVS_TRACE_SCOPE( "kvs::grads::GriddedBinaryDataFile::read" );
+
+    std::ifstream ifs;
+    size_t record_size = 0;
+    size_t total = 0;
+    if ( !this->open( ifs, &record_size, &total ) ) { return kvs::ValueArray<kvs::Real32>(); }
+
+    if ( offset + nvalues > total )
+    {
+        kvsMessageError( "Out of range of the data values in %s.", m_filename.c_str() );
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    kvs::ValueArray<kvs::Real32> values( nvalues );
+    if ( !this->read_values( ifs, record_size, offset, nvalues, values.data() ) )
+    {
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    return values;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Loads data values from the specified data file.
@@ -163,6 +229,49 @@ const kvs::ValueArray<kvs::Real32> GriddedBinaryDataFile::values(
  */
 /*===========================================================================*/
 bool GriddedBinaryDataFile::load() const
+{
+    KVS_TRACE_SCOPE( "kvs::grads::GriddedBinaryDataFile::load" );
+
+    std::ifstream ifs;
+    size_t record_size = 0;
+    size_t nvalues = 0;
+    if ( !this->open( ifs, &record_size, &nvalues ) ) { return false; }
+
+    m_values.allocate( nvalues );
+    if ( !this->read_values( ifs, record_size, 0, nvalues, m_values.data() ) )
+    {
+        m_values.release();
+        return false;
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Free loaded data values.
+ */
+/*===========================================================================*/
+void GriddedBinaryDataFile::free() const
+{
+    m_values.release();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Opens the data file and checks the record structure.
+ *  @param  ifs [out] input file stream
+ *  @param  record_size [out] number of bytes of a record (0 for the direct access data)
+ *  @param  nvalues [out] number of data values in the file
+ *  @return true, if the file is opened successfully
+ *
+ *  The sequential data is a sequence of the Fortran records, each of which
+ *  is enclosed by the 4-byte markers of the record size. All the records
+ *  are assumed to have the same size as the first one, e.g. a value or an
+ *  X-Y plane per record.
+ */
+/*===========================================================================*/
+bool GriddedBinaryDataFile::open( std::ifstream& ifs, size_t* record_size, size_t* nvalues ) const
 {
     if ( m_filename.length() == 0 )
     {
@@ -170,7 +279,7 @@ bool GriddedBinaryDataFile::load() const
         return false;
     }
 
-    std::ifstream ifs( m_filename.c_str(), std::ios::binary | std::ios::in );
+    ifs.open( m_filename.c_str(), std::ios::binary | std::ios::in );
     if( !ifs.is_open() )
     {
         kvsMessageError( "Cannot open %s.", m_filename.c_str() );
@@ -178,57 +287,102 @@ bool GriddedBinaryDataFile::load() const
     }
 
     ifs.seekg( 0, std::ios::end );
-    const std::streamoff end = ifs.tellg();
-
+    const size_t file_size = static_cast<size_t>( ifs.tellg() ); // [byte]
     ifs.seekg( 0, std::ios::beg );
-    const std::streamoff begin = ifs.tellg();
-    const std::streamoff file_size = end - begin; // [byte]
 
-    if ( m_sequential )
+    if ( !m_sequential )
     {
-        const size_t element_size = sizeof( kvs::Real32 ) + 4 * sizeof( kvs::Int16 );
-        const size_t nelements = static_cast<size_t>( file_size / element_size );
-        m_values.allocate( nelements );
-
-        for ( size_t i = 0; i < nelements; i++ )
-        {
-            kvs::Int16 padding[4];
-            kvs::Real32 value;
-            ifs.read( (char*)( padding + 0 ), sizeof( kvs::Int16 ) );
-            ifs.read( (char*)( padding + 1 ), sizeof( kvs::Int16 ) );
-            ifs.read( (char*)( &value ), sizeof( kvs::Real32 ) );
-            ifs.read( (char*)( padding + 2 ), sizeof( kvs::Int16 ) );
-            ifs.read( (char*)( padding + 3 ), sizeof( kvs::Int16 ) );
-            m_values[i] = value;
-        }
-    }
-    else
-    {
-        const size_t element_size = sizeof( kvs::Real32 );
-        const size_t nelements = static_cast<size_t>( file_size / element_size );
-        m_values.allocate( nelements );
-
-        ifs.read( (char*)( m_values.data() ), file_size );
+        *record_size = 0;
+        *nvalues = file_size / sizeof( kvs::Real32 );
+        return true;
     }
 
-    if ( m_big_endian != kvs::Endian::IsBig() )
+    kvs::UInt32 marker = 0;
+    ifs.read( (char*)( &marker ), sizeof( kvs::UInt32 ) );
+    if ( m_big_endian != kvs::Endian::IsBig() ) { kvs::Endian::Swap( &marker ); }
+    if ( !ifs || marker == 0 || marker % sizeof( kvs::Real32 ) != 0 || marker + 8 > file_size )
     {
-        kvs::Endian::Swap( m_values.data(), m_values.size() );
+        kvsMessageError( "Invalid record marker in %s.", m_filename.c_str() );
+        return false;
     }
 
-    ifs.close();
-
+    const size_t nrecords = file_size / ( marker + 8 );
+    *record_size = marker;
+    *nvalues = nrecords * ( marker / sizeof( kvs::Real32 ) );
     return true;
 }
 
 /*===========================================================================*/
 /**
- *  @brief  Free loaded data values.
+ *  @brief  Reads the data values in the specified range with bulk reading.
+ *  @param  ifs [in] input file stream
+ *  @param  record_size [in] number of bytes of a record (0 for the direct access data)
+ *  @param  offset [in] index of the first value
+ *  @param  nvalues [in] number of values
+ *  @param  values [out] pointer to the values
+ *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
-void GriddedBinaryDataFile::free() const
+bool GriddedBinaryDataFile::read_values(
+    std::ifstream& ifs,
+    const size_t record_size,
+    const size_t offset,
+    const size_t nvalues,
+    kvs::Real32* values ) const
 {
-    m_values.release();
+    if ( nvalues == 0 ) { return true; }
+
+    if ( !m_sequential )
+    {
+        ifs.seekg( offset * sizeof( kvs::Real32 ), std::ios::beg );
+        ifs.read( (char*)( values ), nvalues * sizeof( kvs::Real32 ) );
+    }
+    else
+    {
+        // The records are read by the chunk and the markers are stripped.
+        const size_t values_per_record = record_size / sizeof( kvs::Real32 );
+        const size_t stride = record_size + 8;
+        const size_t records_per_chunk = kvs::Math::Max( ::ChunkSize / stride, size_t( 1 ) );
+        std::vector<char> buffer;
+
+        kvs::Real32* dst = values;
+        size_t index = offset;
+        size_t remaining = nvalues;
+        while ( remaining > 0 && ifs )
+        {
+            const size_t first = index / values_per_record;
+            const size_t last = ( index + remaining - 1 ) / values_per_record;
+            const size_t nrecords = kvs::Math::Min( last - first + 1, records_per_chunk );
+            buffer.resize( nrecords * stride );
+            ifs.seekg( first * stride, std::ios::beg );
+            ifs.read( buffer.data(), buffer.size() );
+
+            size_t begin = index % values_per_record;
+            for ( size_t i = 0; i < nrecords; i++ )
+            {
+                const char* payload = buffer.data() + i * stride + sizeof( kvs::UInt32 );
+                const size_t n = kvs::Math::Min( values_per_record - begin, remaining );
+                std::memcpy( dst, payload + begin * sizeof( kvs::Real32 ), n * sizeof( kvs::Real32 ) );
+                dst += n;
+                index += n;
+                remaining -= n;
+                begin = 0;
+            }
+        }
+    }
+
+    if ( !ifs )
+    {
+        kvsMessageError( "Cannot read the data values from %s.", m_filename.c_str() );
+        return false;
+    }
+
+    if ( m_big_endian != kvs::Endian::IsBig() )
+    {
+        kvs::Endian::Swap( values, nvalues );
+    }
+
+    return true;
 }
 
 } // end of namespace grads
@@ -8,6 +8,7 @@
 #define KVS__GRADS__GRIDDED_BINARY_DATA_FILE_H_INCLUDE
 
 #include <string>
+#include <fstream>
 #include <kvs/ValueArray>
 #include <kvs/Type>
 #include <kvs/Vector3>
@@ -59,8 +60,14 @@ public:
     const std::string& filename() const;
     const kvs::ValueArray<kvs::Real32>& values() const;
     const kvs::ValueArray<kvs::Real32> values( const size_t vindex, const kvs::Vec3ui& dim ) const;
+    size_t numberOfValues() const;
+    const kvs::ValueArray<kvs::Real32> read( const size_t offset, const size_t nvalues ) const;
     bool load() const;
     void free() const;
+
+private:
+    bool open( std::ifstream& ifs, size_t* record_size, size_t* nvalues ) const;
+    bool read_values( std::ifstream& ifs, const size_t record_size, const size_t offset, const size_t nvalues, kvs::Real32* values ) const;
 };
 
 } // end of namespace grads
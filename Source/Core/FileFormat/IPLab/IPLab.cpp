@@ -10,6 +10,7 @@
 #include <kvs/Endian>
 #include <kvs/File>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -53,6 +54,7 @@ IPLab::IPLab( const std::string& filename ):
 
 bool IPLab::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::IPLab::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
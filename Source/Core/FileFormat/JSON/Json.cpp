@@ -9,6 +9,7 @@
 #include <fstream>
 #include <sstream>
 #include <kvs/Message>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -16,6 +17,7 @@ namespace kvs
 
 bool Json::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Json::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
@@ -0,0 +1,267 @@
+/*****************************************************************************/
+/**
+ *  @file   Codec.cpp
+ */
+/*****************************************************************************/
+#include "Codec.h"
+#include <kvs/Type>
+#include <vector>
+#include <cstring>
+
+
+namespace
+{
+
+const size_t HashBits = 14; ///< number of bits of the hash table
+const size_t MinMatch = 4; ///< minimum length of the match
+const size_t MaxOffset = 65535; ///< maximum offset of the match
+const size_t LastLiterals = 5; ///< number of bytes always stored as literals at the end
+const size_t MatchLimit = 12; ///< no match starts in the last bytes
+
+inline kvs::UInt32 Read32( const kvs::UInt8* p )
+{
+    kvs::UInt32 value;
+    std::memcpy( &value, p, sizeof( value ) );
+    return value;
+}
+
+inline size_t Hash( const kvs::UInt32 value )
+{
+    return ( value * 2654435761U ) >> ( 32 - ::HashBits );
+}
+
+inline kvs::UInt8* WriteLength( size_t length, kvs::UInt8* p )
+{
+    for ( ; length >= 255; length -= 255 ) { *p++ = 255; }
+    *p++ = static_cast<kvs::UInt8>( length );
+    return p;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Compresses the bytes with LZ77.
+ *  @param  src [in] pointer to the bytes
+ *  @param  size [in] number of bytes
+ *  @param  dst [out] pointer to the compressed bytes (CompressBound(size) bytes)
+ *  @return number of the compressed bytes
+ *
+ *  The sequences of the literals and the match (offset and length) are
+ *  stored in the same layout as the LZ4 block format.
+ */
+/*===========================================================================*/
+size_t CompressLZ( const kvs::UInt8* src, const size_t size, kvs::UInt8* dst )
+{
+    std::vector<kvs::UInt32> table( size_t( 1 ) << ::HashBits, 0 ); // position + 1
+    kvs::UInt8* op = dst;
+    size_t anchor = 0;
+    size_t ip = 0;
+
+    const size_t match_limit = size > ::MatchLimit ? size - ::MatchLimit : 0;
+    while ( ip < match_limit )
+    {
+        const kvs::UInt32 sequence = ::Read32( src + ip );
+        const size_t hash = ::Hash( sequence );
+        const size_t candidate = table[ hash ];
+        table[ hash ] = static_cast<kvs::UInt32>( ip + 1 );
+        if ( candidate == 0 ||
+             ip + 1 - candidate > ::MaxOffset ||
+             ::Read32( src + candidate - 1 ) != sequence )
+        {
+            ip++;
+            continue;
+        }
+
+        const size_t reference = candidate - 1;
+        size_t length = ::MinMatch;
+        const size_t end = size - ::LastLiterals;
+        while ( ip + length < end && src[ reference + length ] == src[ ip + length ] ) { length++; }
+
+        // Token, literals, offset and match length.
+        const size_t literals = ip - anchor;
+        kvs::UInt8* token = op++;
+        *token = static_cast<kvs::UInt8>( ( literals < 15 ? literals : 15 ) << 4 );
+        if ( literals >= 15 ) { op = ::WriteLength( literals - 15, op ); }
+        std::memcpy( op, src + anchor, literals );
+        op += literals;
+
+        const size_t offset = ip - reference;
+        *op++ = static_cast<kvs::UInt8>( offset & 0xff );
+        *op++ = static_cast<kvs::UInt8>( offset >> 8 );
+
+        const size_t match = length - ::MinMatch;
+        *token |= static_cast<kvs::UInt8>( match < 15 ? match : 15 );
+        if ( match >= 15 ) { op = ::WriteLength( match - 15, op ); }
+
+        ip += length;
+        anchor = ip;
+    }
+
+    // Last literals.
+    const size_t literals = size - anchor;
+    *op++ = static_cast<kvs::UInt8>( ( literals < 15 ? literals : 15 ) << 4 );
+    if ( literals >= 15 ) { op = ::WriteLength( literals - 15, op ); }
+    std::memcpy( op, src + anchor, literals );
+    op += literals;
+
+    return op - dst;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Decompresses the bytes compressed with CompressLZ.
+ *  @param  src [in] pointer to the compressed bytes
+ *  @param  src_size [in] number of the compressed bytes
+ *  @param  dst [out] pointer to the decompressed bytes
+ *  @param  dst_size [in] number of the decompressed bytes
+ *  @return true, if the bytes are decompressed successfully
+ */
+/*===========================================================================*/
+bool DecompressLZ( const kvs::UInt8* src, const size_t src_size, kvs::UInt8* dst, const size_t dst_size )
+{
+    const kvs::UInt8* ip = src;
+    const kvs::UInt8* const ip_end = src + src_size;
+    kvs::UInt8* op = dst;
+    kvs::UInt8* const op_end = dst + dst_size;
+
+    while ( ip < ip_end )
+    {
+        const kvs::UInt8 token = *ip++;
+
+        size_t literals = token >> 4;
+        if ( literals == 15 )
+        {
+            kvs::UInt8 c;
+            do { if ( ip == ip_end ) { return false; } c = *ip++; literals += c; } while ( c == 255 );
+        }
+        if ( size_t( ip_end - ip ) < literals || size_t( op_end - op ) < literals ) { return false; }
+        std::memcpy( op, ip, literals );
+        ip += literals;
+        op += literals;
+        if ( ip == ip_end ) { break; }
+
+        if ( ip_end - ip < 2 ) { return false; }
+        const size_t offset = ip[0] | ( size_t( ip[1] ) << 8 );
+        ip += 2;
+        if ( offset == 0 || offset > size_t( op - dst ) ) { return false; }
+
+        size_t length = token & 15;
+        if ( length == 15 )
+        {
+            kvs::UInt8 c;
+            do { if ( ip == ip_end ) { return false; } c = *ip++; length += c; } while ( c == 255 );
+        }
+        length += ::MinMatch;
+        if ( size_t( op_end - op ) < length ) { return false; }
+
+        // The match can overlap the output.
+        const kvs::UInt8* match = op - offset;
+        for ( size_t i = 0; i < length; i++ ) { op[i] = match[i]; }
+        op += length;
+    }
+
+    return op == op_end;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace kvsb
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the maximum size of the compressed bytes.
+ *  @param  size [in] number of bytes
+ *  @return maximum number of the compressed bytes
+ */
+/*===========================================================================*/
+size_t CompressBound( const size_t size )
+{
+    return size + size / 255 + 16;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Compresses the array.
+ *  @param  src [in] pointer to the array
+ *  @param  size [in] byte size of the array
+ *  @param  element_size [in] byte size of the element
+ *  @param  dst [out] pointer to the compressed bytes (CompressBound(size) bytes)
+ *  @return number of the compressed bytes
+ *
+ *  The bytes of the elements are shuffled so that the same bytes of the
+ *  elements (ex. the exponents of the real values) are continuous before
+ *  compressing them.
+ */
+/*===========================================================================*/
+size_t Compress(
+    const void* src,
+    const size_t size,
+    const size_t element_size,
+    void* dst )
+{
+    const kvs::UInt8* bytes = static_cast<const kvs::UInt8*>( src );
+    if ( element_size <= 1 || size % element_size != 0 )
+    {
+        return ::CompressLZ( bytes, size, static_cast<kvs::UInt8*>( dst ) );
+    }
+
+    const size_t nelements = size / element_size;
+    std::vector<kvs::UInt8> shuffled( size );
+    for ( size_t i = 0; i < nelements; i++ )
+    {
+        for ( size_t j = 0; j < element_size; j++ )
+        {
+            shuffled[ j * nelements + i ] = bytes[ i * element_size + j ];
+        }
+    }
+
+    return ::CompressLZ( shuffled.data(), size, static_cast<kvs::UInt8*>( dst ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Decompresses the array.
+ *  @param  src [in] pointer to the compressed bytes
+ *  @param  src_size [in] number of the compressed bytes
+ *  @param  element_size [in] byte size of the element
+ *  @param  dst [out] pointer to the array
+ *  @param  dst_size [in] byte size of the array
+ *  @return true, if the array is decompressed successfully
+ */
+/*===========================================================================*/
+bool Decompress(
+    const void* src,
+    const size_t src_size,
+    const size_t element_size,
+    void* dst,
+    const size_t dst_size )
+{
+    const kvs::UInt8* bytes = static_cast<const kvs::UInt8*>( src );
+    if ( element_size <= 1 || dst_size % element_size != 0 )
+    {
+        return ::DecompressLZ( bytes, src_size, static_cast<kvs::UInt8*>( dst ), dst_size );
+    }
+
+    std::vector<kvs::UInt8> shuffled( dst_size );
+    if ( !::DecompressLZ( bytes, src_size, shuffled.data(), dst_size ) ) { return false; }
+
+    const size_t nelements = dst_size / element_size;
+    kvs::UInt8* values = static_cast<kvs::UInt8*>( dst );
+    for ( size_t i = 0; i < nelements; i++ )
+    {
+        for ( size_t j = 0; j < element_size; j++ )
+        {
+            values[ i * element_size + j ] = shuffled[ j * nelements + i ];
+        }
+    }
+
+    return true;
+}
+
+} // end of namespace kvsb
+
+} // end of namespace kvs
@@ -0,0 +1,39 @@
+/*****************************************************************************/
+/**
+ *  @file   Codec.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <cstddef>
+
+
+namespace kvs
+{
+
+namespace kvsb
+{
+
+enum Compression
+{
+    NoCompression = 0, ///< stored as it is
+    LZCompression = 1  ///< byte shuffle and LZ77 compression
+};
+
+size_t CompressBound( const size_t size );
+
+size_t Compress(
+    const void* src,
+    const size_t size,
+    const size_t element_size,
+    void* dst );
+
+bool Decompress(
+    const void* src,
+    const size_t src_size,
+    const size_t element_size,
+    void* dst,
+    const size_t dst_size );
+
+} // end of namespace kvsb
+
+} // end of namespace kvs
@@ -0,0 +1,877 @@
+/*****************************************************************************/
+/**
+ *  @file   Container.cpp
+ */
+/*****************************************************************************/
+#include "Container.h"
+#include <kvs/Platform>
+#include <kvs/Endian>
+#include <kvs/Message>
+#include <kvs/Parallel>
+#include <kvs/Trace>
+#include <kvs/IgnoreUnusedVariable>
+#include <algorithm>
+#include <cstring>
+#if !defined( KVS_PLATFORM_WINDOWS )
+#include <sys/mman.h>
+#include <sys/types.h>
+#endif
+
+
+namespace
+{
+
+const char Magic[8] = { 'K', 'V', 'S', 'B', '\r', '\n', '\x1a', '\n' };
+const kvs::UInt32 Version = 1;
+const size_t HeaderSize = 64; ///< byte size of the file header
+const size_t Alignment = 64; ///< alignment of the chunks
+const size_t DefaultChunkSize = 1 << 20; ///< default byte size of the chunk
+const size_t MaxNameLength = 1 << 16; ///< maximum length of the names and attributes
+
+/*===========================================================================*/
+/**
+ *  @brief  Type codes stored in the file (the index + 1 is the code).
+ */
+/*===========================================================================*/
+const kvs::Type::TypeID TypeCodes[] = {
+    kvs::Type::TypeInt8,
+    kvs::Type::TypeInt16,
+    kvs::Type::TypeInt32,
+    kvs::Type::TypeInt64,
+    kvs::Type::TypeUInt8,
+    kvs::Type::TypeUInt16,
+    kvs::Type::TypeUInt32,
+    kvs::Type::TypeUInt64,
+    kvs::Type::TypeReal32,
+    kvs::Type::TypeReal64
+};
+const size_t NumberOfTypeCodes = sizeof( TypeCodes ) / sizeof( TypeCodes[0] );
+
+kvs::UInt8 TypeCode( const kvs::Type::TypeID type )
+{
+    for ( size_t i = 0; i < ::NumberOfTypeCodes; i++ )
+    {
+        if ( ::TypeCodes[i] == type ) { return static_cast<kvs::UInt8>( i + 1 ); }
+    }
+    return 0;
+}
+
+size_t ElementSize( const kvs::Type::TypeID type )
+{
+    switch ( type )
+    {
+    case kvs::Type::TypeInt8:
+    case kvs::Type::TypeUInt8: return 1;
+    case kvs::Type::TypeInt16:
+    case kvs::Type::TypeUInt16: return 2;
+    case kvs::Type::TypeInt32:
+    case kvs::Type::TypeUInt32:
+    case kvs::Type::TypeReal32: return 4;
+    case kvs::Type::TypeInt64:
+    case kvs::Type::TypeUInt64:
+    case kvs::Type::TypeReal64: return 8;
+    default: return 0;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Swaps the byte order of the elements.
+ *  @param  data [in/out] pointer to the elements
+ *  @param  size [in] byte size of the elements
+ *  @param  element_size [in] byte size of an element
+ */
+/*===========================================================================*/
+void SwapBytes( void* data, const size_t size, const size_t element_size )
+{
+    if ( element_size <= 1 ) { return; }
+    kvs::UInt8* p = static_cast<kvs::UInt8*>( data );
+    for ( size_t i = 0; i + element_size <= size; i += element_size )
+    {
+        std::reverse( p + i, p + i + element_size );
+    }
+}
+
+bool Seek( FILE* fp, const kvs::UInt64 offset, const int origin = SEEK_SET )
+{
+#if defined( KVS_PLATFORM_WINDOWS )
+    return _fseeki64( fp, static_cast<__int64>( offset ), origin ) == 0;
+#else
+    return fseeko( fp, static_cast<off_t>( offset ), origin ) == 0;
+#endif
+}
+
+kvs::UInt64 Tell( FILE* fp )
+{
+#if defined( KVS_PLATFORM_WINDOWS )
+    return static_cast<kvs::UInt64>( _ftelli64( fp ) );
+#else
+    return static_cast<kvs::UInt64>( ftello( fp ) );
+#endif
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Little-endian byte stream for the header and the index.
+ */
+/*===========================================================================*/
+class ByteWriter
+{
+    std::vector<kvs::UInt8> m_bytes;
+
+public:
+    const std::vector<kvs::UInt8>& bytes() const { return m_bytes; }
+
+    void putU8( const kvs::UInt8 value ) { m_bytes.push_back( value ); }
+    void putU32( const kvs::UInt32 value ) { for ( int i = 0; i < 4; i++ ) { m_bytes.push_back( kvs::UInt8( value >> ( 8 * i ) ) ); } }
+    void putU64( const kvs::UInt64 value ) { for ( int i = 0; i < 8; i++ ) { m_bytes.push_back( kvs::UInt8( value >> ( 8 * i ) ) ); } }
+    void putString( const std::string& value )
+    {
+        this->putU32( static_cast<kvs::UInt32>( value.size() ) );
+        m_bytes.insert( m_bytes.end(), value.begin(), value.end() );
+    }
+};
+
+class ByteReader
+{
+    const kvs::UInt8* m_bytes;
+    size_t m_size;
+    size_t m_position;
+    bool m_failed;
+
+public:
+    ByteReader( const kvs::UInt8* bytes, const size_t size ):
+        m_bytes( bytes ), m_size( size ), m_position( 0 ), m_failed( false ) {}
+
+    bool isFailed() const { return m_failed; }
+
+    bool check( const size_t size )
+    {
+        if ( m_failed || m_size - m_position < size ) { m_failed = true; }
+        return !m_failed;
+    }
+    kvs::UInt8 getU8()
+    {
+        return this->check( 1 ) ? m_bytes[ m_position++ ] : 0;
+    }
+    kvs::UInt32 getU32()
+    {
+        kvs::UInt32 value = 0;
+        if ( !this->check( 4 ) ) { return 0; }
+        for ( int i = 0; i < 4; i++ ) { value |= kvs::UInt32( m_bytes[ m_position++ ] ) << ( 8 * i ); }
+        return value;
+    }
+    kvs::UInt64 getU64()
+    {
+        kvs::UInt64 value = 0;
+        if ( !this->check( 8 ) ) { return 0; }
+        for ( int i = 0; i < 8; i++ ) { value |= kvs::UInt64( m_bytes[ m_position++ ] ) << ( 8 * i ); }
+        return value;
+    }
+    std::string getString()
+    {
+        const size_t length = this->getU32();
+        if ( length > ::MaxNameLength || !this->check( length ) ) { m_failed = true; return ""; }
+        const char* p = reinterpret_cast<const char*>( m_bytes + m_position );
+        m_position += length;
+        return std::string( p, length );
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Unmaps the file mapped by Reader.
+ */
+/*===========================================================================*/
+struct Unmapper
+{
+    size_t size;
+    void operator ()( void* address )
+    {
+#if !defined( KVS_PLATFORM_WINDOWS )
+        if ( address ) { munmap( address, size ); }
+#endif
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the any-value array that shares the given memory.
+ *  @param  owner [in] shared pointer that owns the memory
+ *  @param  data [in] pointer to the values
+ *  @param  type [in] value type
+ *  @param  nelements [in] number of elements
+ *  @return any-value array
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::AnyValueArray ShareArray( const kvs::SharedPointer<void>& owner, void* data, const size_t nelements )
+{
+    const kvs::SharedPointer<T> values( owner, static_cast<T*>( data ) );
+    return kvs::AnyValueArray( kvs::ValueArray<T>( values, nelements ) );
+}
+
+kvs::AnyValueArray ShareArray(
+    const kvs::SharedPointer<void>& owner,
+    void* data,
+    const kvs::Type::TypeID type,
+    const size_t nelements )
+{
+    switch ( type )
+    {
+    case kvs::Type::TypeInt8: return ::ShareArray<kvs::Int8>( owner, data, nelements );
+    case kvs::Type::TypeInt16: return ::ShareArray<kvs::Int16>( owner, data, nelements );
+    case kvs::Type::TypeInt32: return ::ShareArray<kvs::Int32>( owner, data, nelements );
+    case kvs::Type::TypeInt64: return ::ShareArray<kvs::Int64>( owner, data, nelements );
+    case kvs::Type::TypeUInt8: return ::ShareArray<kvs::UInt8>( owner, data, nelements );
+    case kvs::Type::TypeUInt16: return ::ShareArray<kvs::UInt16>( owner, data, nelements );
+    case kvs::Type::TypeUInt32: return ::ShareArray<kvs::UInt32>( owner, data, nelements );
+    case kvs::Type::TypeUInt64: return ::ShareArray<kvs::UInt64>( owner, data, nelements );
+    case kvs::Type::TypeReal32: return ::ShareArray<kvs::Real32>( owner, data, nelements );
+    case kvs::Type::TypeReal64: return ::ShareArray<kvs::Real64>( owner, data, nelements );
+    default: return kvs::AnyValueArray();
+    }
+}
+
+void Allocate( kvs::AnyValueArray* array, const kvs::Type::TypeID type, const size_t nelements )
+{
+    switch ( type )
+    {
+    case kvs::Type::TypeInt8: array->allocate<kvs::Int8>( nelements ); break;
+    case kvs::Type::TypeInt16: array->allocate<kvs::Int16>( nelements ); break;
+    case kvs::Type::TypeInt32: array->allocate<kvs::Int32>( nelements ); break;
+    case kvs::Type::TypeInt64: array->allocate<kvs::Int64>( nelements ); break;
+    case kvs::Type::TypeUInt8: array->allocate<kvs::UInt8>( nelements ); break;
+    case kvs::Type::TypeUInt16: array->allocate<kvs::UInt16>( nelements ); break;
+    case kvs::Type::TypeUInt32: array->allocate<kvs::UInt32>( nelements ); break;
+    case kvs::Type::TypeUInt64: array->allocate<kvs::UInt64>( nelements ); break;
+    case kvs::Type::TypeReal32: array->allocate<kvs::Real32>( nelements ); break;
+    case kvs::Type::TypeReal64: array->allocate<kvs::Real64>( nelements ); break;
+    default: *array = kvs::AnyValueArray(); break;
+    }
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace kvsb
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Writer class.
+ */
+/*===========================================================================*/
+Writer::Writer():
+    m_file( NULL ),
+    m_offset( 0 ),
+    m_compression( kvs::kvsb::NoCompression ),
+    m_chunk_size( ::DefaultChunkSize )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the Writer class.
+ */
+/*===========================================================================*/
+Writer::~Writer()
+{
+    if ( m_file ) { fclose( m_file ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the byte size of the chunk.
+ *  @param  chunk_size [in] byte size (rounded up to a multiple of 64 bytes)
+ */
+/*===========================================================================*/
+void Writer::setChunkSize( const size_t chunk_size )
+{
+    const size_t size = chunk_size < ::Alignment ? ::Alignment : chunk_size;
+    m_chunk_size = ( size + ::Alignment - 1 ) / ::Alignment * ::Alignment;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Opens the file and writes a temporary header.
+ *  @param  filename [in] filename
+ *  @return true, if the file is opened successfully
+ */
+/*===========================================================================*/
+bool Writer::open( const std::string& filename )
+{
+    if ( m_file ) { fclose( m_file ); }
+    m_entries.clear();
+    m_offset = 0;
+
+    m_file = fopen( filename.c_str(), "wb" );
+    if ( !m_file )
+    {
+        kvsMessageError() << "Cannot open " << filename << "." << std::endl;
+        return false;
+    }
+
+    const std::vector<kvs::UInt8> header( ::HeaderSize, 0 );
+    return this->write_bytes( header.data(), header.size() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the array as the chunks.
+ *  @param  name [in] array name
+ *  @param  array [in] array
+ *  @return true, if the array is written successfully
+ */
+/*===========================================================================*/
+bool Writer::writeArray( const std::string& name, const kvs::AnyValueArray& array )
+{
+    KVS_TRACE_SCOPE( "kvs::kvsb::Writer::writeArray" );
+    if ( !m_file ) { return false; }
+
+    Entry entry;
+    entry.name = name;
+    entry.type = array.typeID();
+    entry.nelements = array.size();
+
+    const size_t element_size = ::ElementSize( entry.type );
+    if ( element_size == 0 )
+    {
+        kvsMessageError() << "Unsupported type of the array " << name << "." << std::endl;
+        return false;
+    }
+
+    const size_t chunk_elements = std::max<size_t>( m_chunk_size / element_size, 1 );
+    const size_t nelements = array.size();
+    const size_t nchunks = ( nelements + chunk_elements - 1 ) / chunk_elements;
+    entry.chunk_elements = chunk_elements;
+    entry.chunks.resize( nchunks );
+
+    const kvs::UInt8* values = static_cast<const kvs::UInt8*>( array.data() );
+    const bool swap = kvs::Endian::IsBig();
+    const bool compress = m_compression != kvs::kvsb::NoCompression;
+
+    // The chunks are compressed in parallel by the batch and written in order.
+    const size_t batch_size = compress || swap ? 16 : 1;
+    std::vector<std::vector<kvs::UInt8> > buffers( batch_size );
+    std::vector<size_t> sizes( batch_size );
+    for ( size_t batch = 0; batch < nchunks; batch += batch_size )
+    {
+        const long count = static_cast<long>( std::min( batch_size, nchunks - batch ) );
+        if ( compress || swap )
+        {
+            kvs::ParallelFor( 0L, count, [&]( const long i )
+            {
+                const size_t index = batch + i;
+                const size_t first = index * chunk_elements;
+                const size_t raw_size = ( std::min( first + chunk_elements, nelements ) - first ) * element_size;
+                const kvs::UInt8* src = values + first * element_size;
+
+                std::vector<kvs::UInt8> swapped;
+                if ( swap )
+                {
+                    swapped.assign( src, src + raw_size );
+                    ::SwapBytes( swapped.data(), raw_size, element_size );
+                    src = swapped.data();
+                }
+
+                std::vector<kvs::UInt8>& buffer = buffers[i];
+                if ( compress )
+                {
+                    buffer.resize( kvs::kvsb::CompressBound( raw_size ) );
+                    sizes[i] = kvs::kvsb::Compress( src, raw_size, element_size, buffer.data() );
+                }
+                else { sizes[i] = raw_size; }
+
+                // The chunk is stored as it is unless the compression reduces the size.
+                if ( !compress || sizes[i] >= raw_size )
+                {
+                    buffer.assign( src, src + raw_size );
+                    sizes[i] = 0;
+                }
+            } );
+        }
+
+        for ( long i = 0; i < count; i++ )
+        {
+            const size_t index = batch + i;
+            const size_t first = index * chunk_elements;
+            const size_t raw_size = ( std::min( first + chunk_elements, nelements ) - first ) * element_size;
+
+            if ( !this->write_padding() ) { return false; }
+
+            Chunk& chunk = entry.chunks[ index ];
+            chunk.offset = m_offset;
+            chunk.raw_size = raw_size;
+            if ( ( compress || swap ) && sizes[i] > 0 )
+            {
+                chunk.stored_size = sizes[i];
+                chunk.compression = static_cast<kvs::UInt8>( m_compression );
+                if ( !this->write_bytes( buffers[i].data(), sizes[i] ) ) { return false; }
+            }
+            else
+            {
+                const kvs::UInt8* src = compress || swap ? buffers[i].data() : values + first * element_size;
+                chunk.stored_size = raw_size;
+                chunk.compression = kvs::kvsb::NoCompression;
+                if ( !this->write_bytes( src, raw_size ) ) { return false; }
+            }
+        }
+    }
+
+    m_entries.push_back( entry );
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the index and the header, and closes the file.
+ *  @return true, if the file is written successfully
+ */
+/*===========================================================================*/
+bool Writer::close()
+{
+    if ( !m_file ) { return false; }
+
+    ::ByteWriter index;
+    index.putU32( static_cast<kvs::UInt32>( m_attributes.size() ) );
+    Attributes::const_iterator attribute = m_attributes.begin();
+    while ( attribute != m_attributes.end() )
+    {
+        index.putString( attribute->first );
+        index.putString( attribute->second );
+        ++attribute;
+    }
+
+    index.putU32( static_cast<kvs::UInt32>( m_entries.size() ) );
+    for ( size_t i = 0; i < m_entries.size(); i++ )
+    {
+        const Entry& entry = m_entries[i];
+        index.putString( entry.name );
+        index.putU8( ::TypeCode( entry.type ) );
+        index.putU64( entry.nelements );
+        index.putU64( entry.chunk_elements );
+        index.putU32( static_cast<kvs::UInt32>( entry.chunks.size() ) );
+        for ( size_t j = 0; j < entry.chunks.size(); j++ )
+        {
+            const Chunk& chunk = entry.chunks[j];
+            index.putU64( chunk.offset );
+            index.putU64( chunk.stored_size );
+            index.putU64( chunk.raw_size );
+            index.putU8( chunk.compression );
+        }
+    }
+
+    bool success = this->write_padding();
+    const kvs::UInt64 index_offset = m_offset;
+    success = success && this->write_bytes( index.bytes().data(), index.bytes().size() );
+
+    ::ByteWriter header;
+    for ( size_t i = 0; i < sizeof( ::Magic ); i++ ) { header.putU8( kvs::UInt8( ::Magic[i] ) ); }
+    header.putU32( ::Version );
+    header.putU32( 0 );
+    header.putU64( index_offset );
+    header.putU64( index.bytes().size() );
+    std::vector<kvs::UInt8> bytes( header.bytes() );
+    bytes.resize( ::HeaderSize, 0 );
+
+    success = success && ::Seek( m_file, 0 );
+    success = success && fwrite( bytes.data(), 1, bytes.size(), m_file ) == bytes.size();
+    success = ( fclose( m_file ) == 0 ) && success;
+    m_file = NULL;
+
+    if ( !success ) { kvsMessageError() << "Cannot write the KVSB file." << std::endl; }
+    return success;
+}
+
+bool Writer::write_bytes( const void* data, const size_t size )
+{
+    if ( size == 0 ) { return true; }
+    if ( fwrite( data, 1, size, m_file ) != size )
+    {
+        kvsMessageError() << "Cannot write the KVSB file." << std::endl;
+        return false;
+    }
+    m_offset += size;
+    return true;
+}
+
+bool Writer::write_padding()
+{
+    const size_t padding = static_cast<size_t>( ( ::Alignment - m_offset % ::Alignment ) % ::Alignment );
+    const kvs::UInt8 zeros[ ::Alignment ] = { 0 };
+    return this->write_bytes( zeros, padding );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Checks whether the file starts with the KVSB signature.
+ *  @param  filename [in] filename
+ *  @return true, if the file is the KVSB container
+ */
+/*===========================================================================*/
+bool Reader::CheckSignature( const std::string& filename )
+{
+    FILE* fp = fopen( filename.c_str(), "rb" );
+    if ( !fp ) { return false; }
+
+    char magic[ sizeof( ::Magic ) ];
+    const bool success = fread( magic, 1, sizeof( magic ), fp ) == sizeof( magic );
+    fclose( fp );
+    return success && std::memcmp( magic, ::Magic, sizeof( magic ) ) == 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Reader class.
+ */
+/*===========================================================================*/
+Reader::Reader():
+    m_file( NULL ),
+    m_file_size( 0 ),
+    m_enable_mapping( true )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the Reader class.
+ */
+/*===========================================================================*/
+Reader::~Reader()
+{
+    this->close();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the attribute value.
+ *  @param  name [in] attribute name
+ *  @return attribute value (empty if not found)
+ */
+/*===========================================================================*/
+std::string Reader::attribute( const std::string& name ) const
+{
+    Attributes::const_iterator attribute = m_attributes.find( name );
+    return attribute != m_attributes.end() ? attribute->second : std::string();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of chunks of the array.
+ *  @param  name [in] array name
+ *  @return number of chunks (0 if not found)
+ */
+/*===========================================================================*/
+size_t Reader::numberOfChunks( const std::string& name ) const
+{
+    const Entry* entry = this->find( name );
+    return entry ? entry->chunks.size() : 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Opens the file and reads the header and the index.
+ *  @param  filename [in] filename
+ *  @return true, if the file is opened successfully
+ */
+/*===========================================================================*/
+bool Reader::open( const std::string& filename )
+{
+    KVS_TRACE_SCOPE( "kvs::kvsb::Reader::open" );
+    this->close();
+
+    m_file = fopen( filename.c_str(), "rb" );
+    if ( !m_file )
+    {
+        kvsMessageError() << "Cannot open " << filename << "." << std::endl;
+        return false;
+    }
+    m_filename = filename;
+
+    kvs::UInt8 header[ ::HeaderSize ];
+    if ( fread( header, 1, sizeof( header ), m_file ) != sizeof( header ) ||
+         std::memcmp( header, ::Magic, sizeof( ::Magic ) ) != 0 )
+    {
+        kvsMessageError() << filename << " is not a KVSB file." << std::endl;
+        this->close();
+        return false;
+    }
+
+    ::ByteReader reader( header + sizeof( ::Magic ), sizeof( header ) - sizeof( ::Magic ) );
+    const kvs::UInt32 version = reader.getU32();
+    reader.getU32();
+    const kvs::UInt64 index_offset = reader.getU64();
+    const kvs::UInt64 index_size = reader.getU64();
+    if ( version != ::Version )
+    {
+        kvsMessageError() << "Unsupported KVSB version " << version << "." << std::endl;
+        this->close();
+        return false;
+    }
+
+    if ( !::Seek( m_file, 0, SEEK_END ) ) { this->close(); return false; }
+    m_file_size = ::Tell( m_file );
+
+    if ( !this->read_index( index_offset, index_size ) )
+    {
+        kvsMessageError() << "Broken index in " << filename << "." << std::endl;
+        this->close();
+        return false;
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Closes the file.
+ *
+ *  The arrays read without copying keep the mapping of the file alive.
+ */
+/*===========================================================================*/
+void Reader::close()
+{
+    if ( m_file ) { fclose( m_file ); }
+    m_file = NULL;
+    m_filename.clear();
+    m_attributes.clear();
+    m_entries.clear();
+    m_mapping = kvs::SharedPointer<void>();
+    m_file_size = 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads all of the chunks of the array.
+ *  @param  name [in] array name
+ *  @param  array [out] pointer to the array
+ *  @return true, if the array is read successfully
+ */
+/*===========================================================================*/
+bool Reader::readArray( const std::string& name, kvs::AnyValueArray* array )
+{
+    const Entry* entry = this->find( name );
+    if ( !entry )
+    {
+        kvsMessageError() << "Cannot find the array " << name << "." << std::endl;
+        return false;
+    }
+
+    if ( entry->chunks.empty() )
+    {
+        ::Allocate( array, entry->type, 0 );
+        return true;
+    }
+
+    return this->readChunks( name, 0, entry->chunks.size(), array );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the chunks of the array.
+ *  @param  name [in] array name
+ *  @param  first [in] index of the first chunk
+ *  @param  count [in] number of chunks
+ *  @param  array [out] pointer to the array of the elements in the chunks
+ *  @return true, if the chunks are read successfully
+ */
+/*===========================================================================*/
+bool Reader::readChunks(
+    const std::string& name,
+    const size_t first,
+    const size_t count,
+    kvs::AnyValueArray* array )
+{
+    KVS_TRACE_SCOPE( "kvs::kvsb::Reader::readChunks" );
+
+    const Entry* entry = this->find( name );
+    if ( !entry || first > entry->chunks.size() || count > entry->chunks.size() - first || count == 0 )
+    {
+        kvsMessageError() << "Cannot find the chunks of the array " << name << "." << std::endl;
+        return false;
+    }
+
+    const size_t element_size = ::ElementSize( entry->type );
+    size_t nelements = 0;
+    for ( size_t i = first; i < first + count; i++ ) { nelements += entry->chunks[i].raw_size / element_size; }
+
+    // The uncompressed and continuous chunks are shared with the mapped file.
+    void* mapped = this->map_chunks( *entry, first, count );
+    if ( mapped )
+    {
+        *array = ::ShareArray( m_mapping, mapped, entry->type, nelements );
+        return true;
+    }
+
+    ::Allocate( array, entry->type, nelements );
+    kvs::UInt8* values = static_cast<kvs::UInt8*>( array->data() );
+    std::vector<size_t> positions( count + 1, 0 );
+    for ( size_t i = 0; i < count; i++ ) { positions[ i + 1 ] = positions[i] + entry->chunks[ first + i ].raw_size; }
+
+    const kvs::UInt8* source = static_cast<const kvs::UInt8*>( m_mapping.get() );
+    bool success = true;
+    if ( source )
+    {
+        // The chunks are decompressed from the mapped file in parallel.
+        success = kvs::ParallelReduce( 0L, static_cast<long>( count ), true, [&]( const long i )
+        {
+            const Chunk& chunk = entry->chunks[ first + i ];
+            kvs::UInt8* dst = values + positions[i];
+            if ( chunk.compression == kvs::kvsb::NoCompression )
+            {
+                std::memcpy( dst, source + chunk.offset, chunk.raw_size );
+                return true;
+            }
+            return kvs::kvsb::Decompress( source + chunk.offset, chunk.stored_size, element_size, dst, chunk.raw_size );
+        },
+        []( const bool a, const bool b ) { return a && b; } );
+    }
+    else
+    {
+        std::vector<kvs::UInt8> buffer;
+        for ( size_t i = 0; i < count && success; i++ )
+        {
+            const Chunk& chunk = entry->chunks[ first + i ];
+            kvs::UInt8* dst = values + positions[i];
+            if ( !::Seek( m_file, chunk.offset ) ) { success = false; break; }
+            if ( chunk.compression == kvs::kvsb::NoCompression )
+            {
+                success = fread( dst, 1, chunk.raw_size, m_file ) == chunk.raw_size;
+            }
+            else
+            {
+                buffer.resize( chunk.stored_size );
+                success = fread( buffer.data(), 1, buffer.size(), m_file ) == buffer.size();
+                success = success && kvs::kvsb::Decompress( buffer.data(), buffer.size(), element_size, dst, chunk.raw_size );
+            }
+        }
+    }
+
+    if ( !success )
+    {
+        kvsMessageError() << "Cannot read the array " << name << "." << std::endl;
+        return false;
+    }
+
+    if ( kvs::Endian::IsBig() ) { ::SwapBytes( values, positions.back(), element_size ); }
+    return true;
+}
+
+const Entry* Reader::find( const std::string& name ) const
+{
+    for ( size_t i = 0; i < m_entries.size(); i++ )
+    {
+        if ( m_entries[i].name == name ) { return &m_entries[i]; }
+    }
+    return NULL;
+}
+
+bool Reader::read_index( const kvs::UInt64 offset, const kvs::UInt64 size )
+{
+    if ( offset < ::HeaderSize || offset > m_file_size || size > m_file_size - offset ) { return false; }
+
+    std::vector<kvs::UInt8> bytes( static_cast<size_t>( size ) );
+    if ( !::Seek( m_file, offset ) ) { return false; }
+    if ( fread( bytes.data(), 1, bytes.size(), m_file ) != bytes.size() ) { return false; }
+
+    ::ByteReader reader( bytes.data(), bytes.size() );
+    const size_t nattributes = reader.getU32();
+    for ( size_t i = 0; i < nattributes && !reader.isFailed(); i++ )
+    {
+        const std::string name = reader.getString();
+        m_attributes[ name ] = reader.getString();
+    }
+
+    const size_t nentries = reader.getU32();
+    for ( size_t i = 0; i < nentries && !reader.isFailed(); i++ )
+    {
+        Entry entry;
+        entry.name = reader.getString();
+        const size_t code = reader.getU8();
+        entry.type = code >= 1 && code <= ::NumberOfTypeCodes ? ::TypeCodes[ code - 1 ] : kvs::Type::UnknownType;
+        entry.nelements = reader.getU64();
+        entry.chunk_elements = reader.getU64();
+        const size_t nchunks = reader.getU32();
+        if ( entry.type == kvs::Type::UnknownType || entry.chunk_elements == 0 ) { return false; }
+        if ( !reader.check( nchunks * 25 ) ) { return false; }
+
+        // The chunks should cover all of the elements in the file.
+        const size_t element_size = ::ElementSize( entry.type );
+        kvs::UInt64 total = 0;
+        entry.chunks.resize( nchunks );
+        for ( size_t j = 0; j < nchunks; j++ )
+        {
+            Chunk& chunk = entry.chunks[j];
+            chunk.offset = reader.getU64();
+            chunk.stored_size = reader.getU64();
+            chunk.raw_size = reader.getU64();
+            chunk.compression = reader.getU8();
+            if ( chunk.offset > m_file_size || chunk.stored_size > m_file_size - chunk.offset ) { return false; }
+            if ( chunk.raw_size % element_size != 0 ) { return false; }
+            if ( chunk.compression == kvs::kvsb::NoCompression && chunk.stored_size != chunk.raw_size ) { return false; }
+            if ( chunk.compression > kvs::kvsb::LZCompression ) { return false; }
+            total += chunk.raw_size;
+        }
+        if ( total != entry.nelements * element_size ) { return false; }
+
+        m_entries.push_back( entry );
+    }
+
+    return !reader.isFailed();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Maps the file and returns the pointer to the chunks.
+ *  @param  entry [in] index entry of the array
+ *  @param  first [in] index of the first chunk
+ *  @param  count [in] number of chunks
+ *  @return pointer to the chunks (NULL if the chunks cannot be shared)
+ *
+ *  The file is mapped privately, so that the values can be modified without
+ *  changing the file. Even if the chunks cannot be shared, the mapping is
+ *  used as the source of the decompression.
+ */
+/*===========================================================================*/
+void* Reader::map_chunks( const Entry& entry, const size_t first, const size_t count )
+{
+#if defined( KVS_PLATFORM_WINDOWS )
+    kvs::IgnoreUnusedVariable( entry );
+    kvs::IgnoreUnusedVariable( first );
+    kvs::IgnoreUnusedVariable( count );
+    return NULL;
+#else
+    if ( !m_enable_mapping || m_file_size == 0 ) { return NULL; }
+
+    if ( !m_mapping )
+    {
+        const size_t size = static_cast<size_t>( m_file_size );
+        void* address = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno( m_file ), 0 );
+        if ( address == MAP_FAILED ) { return NULL; }
+        ::Unmapper unmapper = { size };
+        m_mapping = kvs::SharedPointer<void>( address, unmapper );
+    }
+
+    if ( kvs::Endian::IsBig() ) { return NULL; }
+    for ( size_t i = first; i < first + count; i++ )
+    {
+        const Chunk& chunk = entry.chunks[i];
+        if ( chunk.compression != kvs::kvsb::NoCompression ) { return NULL; }
+        if ( i > first )
+        {
+            const Chunk& previous = entry.chunks[ i - 1 ];
+            if ( previous.offset + previous.raw_size != chunk.offset ) { return NULL; }
+        }
+    }
+
+    return static_cast<kvs::UInt8*>( m_mapping.get() ) + entry.chunks[ first ].offset;
+#endif
+}
+
+} // end of namespace kvsb
+
+} // end of namespace kvs
@@ -0,0 +1,138 @@
+/*****************************************************************************/
+/**
+ *  @file   Container.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include <kvs/Type>
+#include <kvs/AnyValueArray>
+#include <kvs/SharedPointer>
+#include "Codec.h"
+
+
+namespace kvs
+{
+
+namespace kvsb
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Chunk of the array stored in the container.
+ */
+/*===========================================================================*/
+struct Chunk
+{
+    kvs::UInt64 offset; ///< offset from the head of the file
+    kvs::UInt64 stored_size; ///< byte size stored in the file
+    kvs::UInt64 raw_size; ///< byte size of the decompressed chunk
+    kvs::UInt8 compression; ///< compression method
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Index entry of the array stored in the container.
+ */
+/*===========================================================================*/
+struct Entry
+{
+    std::string name; ///< array name
+    kvs::Type::TypeID type; ///< value type
+    kvs::UInt64 nelements; ///< number of elements
+    kvs::UInt64 chunk_elements; ///< number of elements in a chunk
+    std::vector<Chunk> chunks; ///< chunks
+};
+
+typedef std::map<std::string,std::string> Attributes;
+
+/*===========================================================================*/
+/**
+ *  @brief  Writer of the KVSB container.
+ *
+ *  The file consists of a 64-byte header, the chunks of the arrays aligned
+ *  to 64 bytes, and the index of the attributes and arrays at the end of the
+ *  file. The header is rewritten with the position of the index when the
+ *  writer is closed.
+ */
+/*===========================================================================*/
+class Writer
+{
+private:
+    FILE* m_file; ///< file pointer
+    kvs::UInt64 m_offset; ///< current offset
+    Compression m_compression; ///< compression method
+    size_t m_chunk_size; ///< byte size of the chunk
+    Attributes m_attributes; ///< attributes
+    std::vector<Entry> m_entries; ///< index entries
+
+public:
+    Writer();
+    ~Writer();
+
+    void setCompression( const Compression compression ) { m_compression = compression; }
+    void setChunkSize( const size_t chunk_size );
+    void setAttribute( const std::string& name, const std::string& value ) { m_attributes[ name ] = value; }
+
+    bool open( const std::string& filename );
+    bool writeArray( const std::string& name, const kvs::AnyValueArray& array );
+    bool close();
+
+private:
+    bool write_bytes( const void* data, const size_t size );
+    bool write_padding();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Reader of the KVSB container.
+ *
+ *  Only the header and the index are read when the file is opened. The
+ *  arrays are read on demand; the uncompressed arrays are mapped from the
+ *  file without copying where the platform supports it.
+ */
+/*===========================================================================*/
+class Reader
+{
+private:
+    std::string m_filename; ///< filename
+    FILE* m_file; ///< file pointer
+    Attributes m_attributes; ///< attributes
+    std::vector<Entry> m_entries; ///< index entries
+    kvs::SharedPointer<void> m_mapping; ///< mapped file (shared with the arrays)
+    kvs::UInt64 m_file_size; ///< file size
+    bool m_enable_mapping; ///< true, if the file mapping is enabled
+
+public:
+    static bool CheckSignature( const std::string& filename );
+
+public:
+    Reader();
+    ~Reader();
+
+    const Attributes& attributes() const { return m_attributes; }
+    const std::vector<Entry>& entries() const { return m_entries; }
+    std::string attribute( const std::string& name ) const;
+    bool hasArray( const std::string& name ) const { return this->find( name ) != NULL; }
+    size_t numberOfChunks( const std::string& name ) const;
+    void setEnabledMapping( const bool enable ) { m_enable_mapping = enable; }
+    void enableMapping() { this->setEnabledMapping( true ); }
+    void disableMapping() { this->setEnabledMapping( false ); }
+
+    bool open( const std::string& filename );
+    void close();
+    bool readArray( const std::string& name, kvs::AnyValueArray* array );
+    bool readChunks( const std::string& name, const size_t first, const size_t count, kvs::AnyValueArray* array );
+
+private:
+    const Entry* find( const std::string& name ) const;
+    bool read_index( const kvs::UInt64 offset, const kvs::UInt64 size );
+    void* map_chunks( const Entry& entry, const size_t first, const size_t count );
+};
+
+} // end of namespace kvsb
+
+} // end of namespace kvs
@@ -0,0 +1,358 @@
+/*****************************************************************************/
+/**
+ *  @file   KVSBObject.cpp
+ */
+/*****************************************************************************/
+#include "KVSBObject.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <kvs/File>
+#include <kvs/Message>
+#include <kvs/Trace>
+
+
+namespace
+{
+const std::string ObjectTypeAttribute = "object_type";
+const kvs::AnyValueArray EmptyArray;
+}
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Checks the file extension.
+ *  @param  filename [in] filename
+ *  @return true, if the given filename has the KVSB extension
+ */
+/*===========================================================================*/
+bool KVSBObject::CheckExtension( const std::string& filename )
+{
+    const kvs::File file( filename );
+    if ( file.extension() == "kvsb" || file.extension() == "KVSB" )
+    {
+        return true;
+    }
+
+    return false;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the object type from the index of the file.
+ *  @param  filename [in] filename
+ *  @return object type (empty if the file is not the KVSB file)
+ */
+/*===========================================================================*/
+std::string KVSBObject::ReadObjectType( const std::string& filename )
+{
+    if ( !kvs::kvsb::Reader::CheckSignature( filename ) ) { return ""; }
+
+    kvs::kvsb::Reader reader;
+    if ( !reader.open( filename ) ) { return ""; }
+    return reader.attribute( ::ObjectTypeAttribute );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new KVSBObject class.
+ */
+/*===========================================================================*/
+KVSBObject::KVSBObject():
+    m_enable_header_only( false ),
+    m_enable_mapping( true ),
+    m_compression( KVSBObject::NoCompression ),
+    m_chunk_size( 1 << 20 )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new KVSBObject class and reads the file.
+ *  @param  filename [in] filename
+ */
+/*===========================================================================*/
+KVSBObject::KVSBObject( const std::string& filename ):
+    m_enable_header_only( false ),
+    m_enable_mapping( true ),
+    m_compression( KVSBObject::NoCompression ),
+    m_chunk_size( 1 << 20 )
+{
+    this->read( filename );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the attribute value.
+ *  @param  name [in] attribute name
+ *  @return attribute value (empty if not found)
+ */
+/*===========================================================================*/
+std::string KVSBObject::attribute( const std::string& name ) const
+{
+    Attributes::const_iterator attribute = m_attributes.find( name );
+    return attribute != m_attributes.end() ? attribute->second : std::string();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the array.
+ *  @param  name [in] array name
+ *  @return array (empty if not found or not read)
+ */
+/*===========================================================================*/
+const kvs::AnyValueArray& KVSBObject::array( const std::string& name ) const
+{
+    Arrays::const_iterator array = m_arrays.find( name );
+    return array != m_arrays.end() ? array->second : ::EmptyArray;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the array to be written.
+ *  @param  name [in] array name
+ *  @param  values [in] array (shared without copying)
+ *
+ *  The empty array is not stored.
+ */
+/*===========================================================================*/
+void KVSBObject::setArray( const std::string& name, const kvs::AnyValueArray& values )
+{
+    if ( values.size() == 0 ) { return; }
+    if ( !this->hasArray( name ) ) { m_array_names.push_back( name ); }
+    m_arrays[ name ] = values;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the min/max object coordinates.
+ *  @param  min_coord [in] min. coordinate
+ *  @param  max_coord [in] max. coordinate
+ */
+/*===========================================================================*/
+void KVSBObject::setMinMaxObjectCoords( const kvs::Vec3& min_coord, const kvs::Vec3& max_coord )
+{
+    this->set_vec3_attribute( "min_object_coord", min_coord );
+    this->set_vec3_attribute( "max_object_coord", max_coord );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the min/max external coordinates.
+ *  @param  min_coord [in] min. coordinate
+ *  @param  max_coord [in] max. coordinate
+ */
+/*===========================================================================*/
+void KVSBObject::setMinMaxExternalCoords( const kvs::Vec3& min_coord, const kvs::Vec3& max_coord )
+{
+    this->set_vec3_attribute( "min_external_coord", min_coord );
+    this->set_vec3_attribute( "max_external_coord", max_coord );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the min/max values.
+ *  @param  min_value [in] min. value
+ *  @param  max_value [in] max. value
+ */
+/*===========================================================================*/
+void KVSBObject::setMinMaxValues( const kvs::Real64 min_value, const kvs::Real64 max_value )
+{
+    this->set_real_attribute( "min_value", min_value );
+    this->set_real_attribute( "max_value", max_value );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of chunks of the array in the file.
+ *  @param  name [in] array name
+ *  @return number of chunks
+ */
+/*===========================================================================*/
+size_t KVSBObject::numberOfChunks( const std::string& name ) const
+{
+    kvs::kvsb::Reader reader;
+    if ( !reader.open( BaseClass::filename() ) ) { return 0; }
+    return reader.numberOfChunks( name );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the chunks of the array from the file.
+ *  @param  name [in] array name
+ *  @param  first [in] index of the first chunk
+ *  @param  count [in] number of chunks
+ *  @param  values [out] pointer to the elements in the chunks
+ *  @return true, if the chunks are read successfully
+ */
+/*===========================================================================*/
+bool KVSBObject::readChunks(
+    const std::string& name,
+    const size_t first,
+    const size_t count,
+    kvs::AnyValueArray* values ) const
+{
+    kvs::kvsb::Reader reader;
+    reader.setEnabledMapping( m_enable_mapping );
+    if ( !reader.open( BaseClass::filename() ) ) { return false; }
+    return reader.readChunks( name, first, count, values );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the file information.
+ *  @param  os [in] output stream
+ *  @param  indent [in] indent
+ */
+/*===========================================================================*/
+void KVSBObject::print( std::ostream& os, const kvs::Indent& indent ) const
+{
+    os << indent << "Filename : " << BaseClass::filename() << std::endl;
+    os << indent << "Object type : " << m_object_type << std::endl;
+
+    Attributes::const_iterator attribute = m_attributes.begin();
+    while ( attribute != m_attributes.end() )
+    {
+        if ( attribute->first != ::ObjectTypeAttribute )
+        {
+            os << indent << "Attribute '" << attribute->first << "' : " << attribute->second << std::endl;
+        }
+        ++attribute;
+    }
+
+    for ( size_t i = 0; i < m_array_names.size(); i++ )
+    {
+        const kvs::AnyValueArray& values = this->array( m_array_names[i] );
+        os << indent << "Array '" << m_array_names[i] << "' : ";
+        if ( this->hasArray( m_array_names[i] ) )
+        {
+            os << values.size() << " (" << values.typeInfo()->typeName() << ")" << std::endl;
+        }
+        else
+        {
+            os << "not read" << std::endl;
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the KVSB file.
+ *  @param  filename [in] filename
+ *  @return true, if the reading process is done successfully
+ *
+ *  The uncompressed arrays are shared with the mapped file without copying.
+ *  Only the selected arrays are read if any array is selected, and no array
+ *  is read if the header-only mode is enabled.
+ */
+/*===========================================================================*/
+bool KVSBObject::read( const std::string& filename )
+{
+    KVS_TRACE_SCOPE( "kvs::KVSBObject::read" );
+    BaseClass::setFilename( filename );
+    BaseClass::setSuccess( false );
+    m_object_type.clear();
+    m_attributes.clear();
+    m_arrays.clear();
+    m_array_names.clear();
+
+    kvs::kvsb::Reader reader;
+    reader.setEnabledMapping( m_enable_mapping );
+    if ( !reader.open( filename ) ) { return false; }
+
+    m_attributes = reader.attributes();
+    m_object_type = reader.attribute( ::ObjectTypeAttribute );
+    m_attributes.erase( ::ObjectTypeAttribute );
+
+    const std::vector<kvs::kvsb::Entry>& entries = reader.entries();
+    for ( size_t i = 0; i < entries.size(); i++ )
+    {
+        const std::string& name = entries[i].name;
+        m_array_names.push_back( name );
+        if ( m_enable_header_only || !this->is_selected( name ) ) { continue; }
+
+        kvs::AnyValueArray values;
+        if ( !reader.readArray( name, &values ) ) { return false; }
+        m_arrays[ name ] = values;
+    }
+
+    BaseClass::setSuccess( true );
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the KVSB file.
+ *  @param  filename [in] filename
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+bool KVSBObject::write( const std::string& filename )
+{
+    KVS_TRACE_SCOPE( "kvs::KVSBObject::write" );
+    BaseClass::setFilename( filename );
+    BaseClass::setSuccess( false );
+
+    kvs::kvsb::Writer writer;
+    writer.setCompression( static_cast<kvs::kvsb::Compression>( m_compression ) );
+    writer.setChunkSize( m_chunk_size );
+    writer.setAttribute( ::ObjectTypeAttribute, m_object_type );
+
+    Attributes::const_iterator attribute = m_attributes.begin();
+    while ( attribute != m_attributes.end() )
+    {
+        writer.setAttribute( attribute->first, attribute->second );
+        ++attribute;
+    }
+
+    if ( !writer.open( filename ) ) { return false; }
+
+    for ( size_t i = 0; i < m_array_names.size(); i++ )
+    {
+        const std::string& name = m_array_names[i];
+        if ( !writer.writeArray( name, this->array( name ) ) ) { return false; }
+    }
+
+    if ( !writer.close() ) { return false; }
+
+    BaseClass::setSuccess( true );
+    return true;
+}
+
+kvs::Vec3 KVSBObject::vec3_attribute( const std::string& name ) const
+{
+    kvs::Real32 x = 0.0f, y = 0.0f, z = 0.0f;
+    std::sscanf( this->attribute( name ).c_str(), "%f %f %f", &x, &y, &z );
+    return kvs::Vec3( x, y, z );
+}
+
+kvs::Real64 KVSBObject::real_attribute( const std::string& name ) const
+{
+    return std::strtod( this->attribute( name ).c_str(), NULL );
+}
+
+void KVSBObject::set_vec3_attribute( const std::string& name, const kvs::Vec3& value )
+{
+    // The values are written with the digits enough to be restored exactly.
+    char buffer[64];
+    std::snprintf( buffer, sizeof( buffer ), "%.9g %.9g %.9g", value.x(), value.y(), value.z() );
+    this->setAttribute( name, std::string( buffer ) );
+}
+
+void KVSBObject::set_real_attribute( const std::string& name, const kvs::Real64 value )
+{
+    char buffer[32];
+    std::snprintf( buffer, sizeof( buffer ), "%.17g", value );
+    this->setAttribute( name, std::string( buffer ) );
+}
+
+bool KVSBObject::is_selected( const std::string& name ) const
+{
+    if ( m_selected_arrays.empty() ) { return true; }
+    return std::find( m_selected_arrays.begin(), m_selected_arrays.end(), name ) != m_selected_arrays.end();
+}
+
+} // end of namespace kvs
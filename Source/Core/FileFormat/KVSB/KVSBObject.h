@@ -0,0 +1,136 @@
+/*****************************************************************************/
+/**
+ *  @file   KVSBObject.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+#include <kvs/FileFormatBase>
+#include <kvs/AnyValueArray>
+#include <kvs/ValueArray>
+#include <kvs/String>
+#include <kvs/Indent>
+#include <kvs/Vector3>
+#include "Container.h"
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  KVSB (binary container of the KVS object) file format class.
+ *
+ *  The object is stored as the named attributes and the named arrays. The
+ *  arrays are split into the chunks, which can be compressed and read
+ *  partially (see kvs::kvsb::Reader for the file layout).
+ */
+/*===========================================================================*/
+class KVSBObject : public kvs::FileFormatBase
+{
+public:
+    typedef kvs::FileFormatBase BaseClass;
+    typedef kvs::kvsb::Attributes Attributes;
+    typedef std::map<std::string,kvs::AnyValueArray> Arrays;
+
+    enum Compression
+    {
+        NoCompression = kvs::kvsb::NoCompression, ///< arrays are stored as they are
+        LZCompression = kvs::kvsb::LZCompression ///< arrays are compressed by the chunk
+    };
+
+private:
+    std::string m_object_type; ///< object type (ex. "PointObject")
+    Attributes m_attributes; ///< attributes
+    Arrays m_arrays; ///< arrays
+    std::vector<std::string> m_array_names; ///< names of the arrays in the file
+    std::vector<std::string> m_selected_arrays; ///< arrays to be read (all if empty)
+    bool m_enable_header_only; ///< true, if only the attributes and the index are read
+    bool m_enable_mapping; ///< true, if the arrays can be mapped from the file
+    Compression m_compression; ///< compression method for writing
+    size_t m_chunk_size; ///< byte size of the chunk for writing
+
+public:
+    static bool CheckExtension( const std::string& filename );
+    static std::string ReadObjectType( const std::string& filename );
+
+public:
+    KVSBObject();
+    KVSBObject( const std::string& filename );
+    virtual ~KVSBObject() {}
+
+    const std::string& objectType() const { return m_object_type; }
+    const Attributes& attributes() const { return m_attributes; }
+    const std::vector<std::string>& arrayNames() const { return m_array_names; }
+    bool hasAttribute( const std::string& name ) const { return m_attributes.find( name ) != m_attributes.end(); }
+    bool hasArray( const std::string& name ) const { return m_arrays.find( name ) != m_arrays.end(); }
+    std::string attribute( const std::string& name ) const;
+    const kvs::AnyValueArray& array( const std::string& name ) const;
+
+    bool hasMinMaxObjectCoords() const { return this->hasAttribute( "min_object_coord" ); }
+    bool hasMinMaxExternalCoords() const { return this->hasAttribute( "min_external_coord" ); }
+    bool hasMinMaxValues() const { return this->hasAttribute( "min_value" ); }
+    kvs::Vec3 minObjectCoord() const { return this->vec3_attribute( "min_object_coord" ); }
+    kvs::Vec3 maxObjectCoord() const { return this->vec3_attribute( "max_object_coord" ); }
+    kvs::Vec3 minExternalCoord() const { return this->vec3_attribute( "min_external_coord" ); }
+    kvs::Vec3 maxExternalCoord() const { return this->vec3_attribute( "max_external_coord" ); }
+    kvs::Real64 minValue() const { return this->real_attribute( "min_value" ); }
+    kvs::Real64 maxValue() const { return this->real_attribute( "max_value" ); }
+
+    template <typename T>
+    T attributeAs( const std::string& name, const T& value = T() ) const
+    {
+        return this->hasAttribute( name ) ? kvs::String::To<T>( this->attribute( name ) ) : value;
+    }
+
+    template <typename T>
+    kvs::ValueArray<T> valueArray( const std::string& name ) const
+    {
+        const kvs::AnyValueArray& values = this->array( name );
+        if ( values.size() == 0 || values.typeID() != kvs::Type::GetID<T>() ) { return kvs::ValueArray<T>(); }
+        return values.asValueArray<T>();
+    }
+
+    void setObjectType( const std::string& object_type ) { m_object_type = object_type; }
+    void setAttribute( const std::string& name, const std::string& value ) { m_attributes[ name ] = value; }
+    void setArray( const std::string& name, const kvs::AnyValueArray& values );
+    void selectArray( const std::string& name ) { m_selected_arrays.push_back( name ); }
+    void setEnabledHeaderOnly( const bool enable ) { m_enable_header_only = enable; }
+    void enableHeaderOnly() { this->setEnabledHeaderOnly( true ); }
+    void disableHeaderOnly() { this->setEnabledHeaderOnly( false ); }
+    bool isEnabledHeaderOnly() const { return m_enable_header_only; }
+    void setMinMaxObjectCoords( const kvs::Vec3& min_coord, const kvs::Vec3& max_coord );
+    void setMinMaxExternalCoords( const kvs::Vec3& min_coord, const kvs::Vec3& max_coord );
+    void setMinMaxValues( const kvs::Real64 min_value, const kvs::Real64 max_value );
+    void setEnabledMapping( const bool enable ) { m_enable_mapping = enable; }
+    void enableMapping() { this->setEnabledMapping( true ); }
+    void disableMapping() { this->setEnabledMapping( false ); }
+    bool isEnabledMapping() const { return m_enable_mapping; }
+    void setCompression( const Compression compression ) { m_compression = compression; }
+    void setChunkSize( const size_t chunk_size ) { m_chunk_size = chunk_size; }
+
+    template <typename T>
+    void setAttribute( const std::string& name, const T& value )
+    {
+        this->setAttribute( name, kvs::String::From( value ) );
+    }
+
+    size_t numberOfChunks( const std::string& name ) const;
+    bool readChunks( const std::string& name, const size_t first, const size_t count, kvs::AnyValueArray* values ) const;
+
+    void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
+    bool read( const std::string& filename );
+    bool write( const std::string& filename );
+
+private:
+    kvs::Vec3 vec3_attribute( const std::string& name ) const;
+    kvs::Real64 real_attribute( const std::string& name ) const;
+    void set_vec3_attribute( const std::string& name, const kvs::Vec3& value );
+    void set_real_attribute( const std::string& name, const kvs::Real64 value );
+    bool is_selected( const std::string& name ) const;
+};
+
+} // end of namespace kvs
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include "DataArrayWriter.h"
 
 
 namespace kvs
@@ -25,21 +26,27 @@ namespace temporal
 {
 
 template <typename T>
-inline T To( const std::string& value )
+inline T To( const char* value )
 {
-    return static_cast<T>( atof( value.c_str() ) );
+    return static_cast<T>( atof( value ) );
 }
 
 template <>
-inline kvs::Int8 To( const std::string& value )
+inline kvs::Int8 To( const char* value )
 {
-    return static_cast<kvs::Int8>( atoi( value.c_str() ) );
+    return static_cast<kvs::Int8>( atoi( value ) );
 }
 
 template <>
-inline kvs::UInt8 To( const std::string& value )
+inline kvs::UInt8 To( const char* value )
 {
-    return static_cast<kvs::UInt8>( atoi( value.c_str() ) );
+    return static_cast<kvs::UInt8>( atoi( value ) );
+}
+
+template <typename T>
+inline T To( const std::string& value )
+{
+    return To<T>( value.c_str() );
 }
 
 inline std::string TypeName( const std::type_info& type )
@@ -369,79 +376,17 @@ inline bool WriteExternalData(
 {
     if ( format == "ascii" )
     {
-        std::ofstream ofs( filename.c_str() );
-        if ( ofs.fail() )
-        {
-            kvsMessageError("Cannot open file '%s'.", filename.c_str() );
-            return false;
-        }
-
-        const std::string delim(", ");
-        const std::type_info& data_type = data_array.typeInfo()->type();
-        const size_t data_size = data_array.size();
-        if ( data_type == typeid(kvs::Int8) )
-        {
-            const kvs::Int8* values = static_cast<const kvs::Int8*>( data_array.data() );
-            for ( size_t i = 0; i < data_size; i++ ) ofs << kvs::Int16(values[i]) << delim;
-        }
-        else if ( data_type == typeid(kvs::UInt8) )
-        {
-            const kvs::UInt8* values = static_cast<const kvs::UInt8*>( data_array.data() );
-            for ( size_t i = 0; i < data_size; i++ ) ofs << kvs::UInt16(values[i]) << delim;
-        }
-        else if ( data_type == typeid(kvs::Int16) )
-        {
-            const kvs::Int16* values = static_cast<const kvs::Int16*>( data_array.data() );
-            for ( size_t i = 0; i < data_size; i++ ) ofs << values[i] << delim;
-        }
-        else if ( data_type == typeid(kvs::UInt16) )
-        {
-            const kvs::UInt16* values = static_cast<const kvs::UInt16*>( data_array.data() );
-            for ( size_t i = 0; i < data_size; i++ ) ofs << values[i] << delim;
-        }
-        else if ( data_type == typeid(kvs::Int32) )
-        {
-            const kvs::Int32* values = static_cast<const kvs::Int32*>( data_array.data() );
-            for ( size_t i = 0; i < data_size; i++ ) ofs << values[i] << delim;
-        }
-        else if ( data_type == typeid(kvs::UInt32) )
-        {
-            const kvs::UInt32* values = static_cast<const kvs::UInt32*>( data_array.data() );
-            for ( size_t i = 0; i < data_size; i++ ) ofs << values[i] << delim;
-        }
-        else if ( data_type == typeid(kvs::Real32) )
-        {
-            const kvs::Real32* values = static_cast<const kvs::Real32*>( data_array.data() );
-            for ( size_t i = 0; i < data_size; i++ ) ofs << values[i] << delim;
-        }
-        else if ( data_type == typeid(kvs::Real64) )
-        {
-            const kvs::Real64* values = static_cast<const kvs::Real64*>( data_array.data() );
-            for ( size_t i = 0; i < data_size; i++ ) ofs << values[i] << delim;
-        }
-
-        ofs.close();
+        return kvs::kvsml::DataArray::WriteTextFile( data_array, filename, ", " );
     }
     else if ( format == "binary" )
     {
-        std::ofstream ofs( filename.c_str(), std::ios::out | std::ios::binary );
-        if ( ofs.fail() )
-        {
-            kvsMessageError("Cannot open file '%s'.", filename.c_str() );
-            return false;
-        }
-        const void* data_pointer = data_array.data();
-        const size_t data_byte_size = data_array.byteSize();
-        ofs.write( static_cast<const char*>(data_pointer), data_byte_size );
-        ofs.close();
+        return kvs::kvsml::DataArray::WriteBinaryFile( data_array, filename );
     }
     else
     {
         kvsMessageError("Unknown format '%s'.",format.c_str());
         return false;
     }
-
-    return true;
 }
 
 /*===========================================================================*/
@@ -459,43 +404,7 @@ inline bool WriteExternalData(
     const std::string& filename,
     const std::string& format )
 {
-    if ( format == "ascii" )
-    {
-        std::ofstream ofs( filename.c_str() );
-        if ( ofs.fail() )
-        {
-            kvsMessageError("Cannot open file '%s'.", filename.c_str() );
-            return false;
-        }
-
-        const std::string delim(", ");
-        const size_t data_size = data_array.size();
-        if ( typeid(T) == typeid(kvs::Int8) || typeid(T) == typeid(kvs::UInt8) )
-        {
-            for ( size_t i = 0; i < data_size; i++ ) ofs << int( data_array[i] ) << delim;
-        }
-        else
-        {
-            for ( size_t i = 0; i < data_size; i++ ) ofs << data_array[i] << delim;
-        }
-
-        ofs.close();
-    }
-    else if ( format == "binary" )
-    {
-        std::ofstream ofs( filename.c_str(), std::ios::out | std::ios::binary );
-        if ( ofs.fail() )
-        {
-            kvsMessageError("Cannot open file '%s'.", filename.c_str() );
-            return false;
-        }
-        const char* data_pointer = reinterpret_cast<const char*>( data_array.data() );
-        const size_t data_byte_size = data_array.byteSize();
-        ofs.write( data_pointer, data_byte_size );
-        ofs.close();
-    }
-
-    return true;
+    return kvs::kvsml::DataArray::WriteExternalData( kvs::AnyValueArray( data_array ), filename, format );
 }
 
 } // end of namespace DataArray
@@ -6,6 +6,7 @@
 /*****************************************************************************/
 #include "DataArrayTag.h"
 #include "DataArray.h"
+#include "Document.h"
 #include <kvs/XMLNode>
 #include <kvs/XMLElement>
 #include <kvs/XMLDocument>
@@ -85,54 +86,15 @@ bool DataArrayTag::write(
     // Internal data: <DataArray type="xxx">xxx</DataArray>
     if ( !m_has_file )
     {
-        // Write the data array to string-stream.
-        std::ostringstream oss( std::ostringstream::out );
-        const std::type_info& data_type = data.typeInfo()->type();
-        const size_t data_size = data.size();
-        if ( data_type == typeid(kvs::Int8) )
-        {
-            const kvs::Int8* values = static_cast<const kvs::Int8*>( data.data() );
-            for ( size_t i = 0; i < data_size; i++ ) oss << kvs::Int16(values[i]) << " ";
-        }
-        else if ( data_type == typeid(kvs::UInt8) )
-        {
-            const kvs::UInt8* values = static_cast<const kvs::UInt8*>( data.data() );
-            for ( size_t i = 0; i < data_size; i++ ) oss << kvs::UInt16(values[i]) << " ";
-        }
-        else if ( data_type == typeid(kvs::Int16) )
-        {
-            const kvs::Int16* values = static_cast<const kvs::Int16*>( data.data() );
-            for ( size_t i = 0; i < data_size; i++ ) oss << values[i] << " ";
-        }
-        else if ( data_type == typeid(kvs::UInt16) )
-        {
-            const kvs::UInt16* values = static_cast<const kvs::UInt16*>( data.data() );
-            for ( size_t i = 0; i < data_size; i++ ) oss << values[i] << " ";
-        }
-        else if ( data_type == typeid(kvs::Int32) )
-        {
-            const kvs::Int32* values = static_cast<const kvs::Int32*>( data.data() );
-            for ( size_t i = 0; i < data_size; i++ ) oss << values[i] << " ";
-        }
-        else if ( data_type == typeid(kvs::UInt32) )
-        {
-            const kvs::UInt32* values = static_cast<const kvs::UInt32*>( data.data() );
-            for ( size_t i = 0; i < data_size; i++ ) oss << values[i] << " ";
-        }
-        else if ( data_type == typeid(kvs::Real32) )
-        {
-            const kvs::Real32* values = static_cast<const kvs::Real32*>( data.data() );
-            for ( size_t i = 0; i < data_size; i++ ) oss << values[i] << " ";
-        }
-        else if ( data_type == typeid(kvs::Real64) )
+        // Format the data array as text.
+        TiXmlText text;
+        std::string value;
+        if ( !kvs::kvsml::DataArray::FormatText( data, " ", &value ) )
         {
-            const kvs::Real64* values = static_cast<const kvs::Real64*>( data.data() );
-            for ( size_t i = 0; i < data_size; i++ ) oss << values[i] << " ";
+            kvsMessageError( "Cannot format the data in <%s>.", tag_name.c_str() );
+            return false;
         }
-
-        // Insert the data array as string-stream to the parent node.
-        TiXmlText text;
-        text.SetValue( oss.str() );
+        text.SetValue( value );
 
         kvs::XMLNode::SuperClass* node = parent->InsertEndChild( element );
         if( !node )
@@ -229,6 +191,18 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::AnyValueArray* data )
     // Internal data.
     if ( m_file == "" )
     {
+        // Internal data recorded by kvs::kvsml::Document without the text node.
+        const kvs::kvsml::Document* document = kvs::kvsml::Document::DownCast( m_node );
+        if ( document && document->hasData( m_node ) )
+        {
+            if ( !document->readData( m_node, m_type, nelements, data ) )
+            {
+                kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
+                return false;
+            }
+            return true;
+        }
+
         const TiXmlText* array_text = kvs::XMLNode::ToText( m_node );
         if ( !array_text )
         {
@@ -15,6 +15,7 @@
 #include <kvs/XMLElement>
 #include <kvs/XMLDocument>
 #include "DataArray.h"
+#include "Document.h"
 #include "TagBase.h"
 
 
@@ -121,21 +122,15 @@ inline bool DataArrayTag::write(
     // Internal data: <DataArray type="xxx">xxx</DataArray>
     if ( !m_has_file )
     {
-        // Write the data array to string-stream.
-        std::ostringstream oss( std::ostringstream::out );
-        const size_t data_size = data.size();
-        if ( typeid(T) == typeid(kvs::Int8) || typeid(T) == typeid(kvs::UInt8) )
-        {
-            for ( size_t i = 0; i < data_size; i++ ) oss << int(data[i]) << " ";
-        }
-        else
+        // Format the data array as text.
+        TiXmlText text;
+        std::string value;
+        if ( !kvs::kvsml::DataArray::FormatText( kvs::AnyValueArray( data ), " ", &value ) )
         {
-            for ( size_t i = 0; i < data_size; i++ ) oss << data[i] << " ";
+            kvsMessageError( "Cannot format the data in <%s>.", tag_name.c_str() );
+            return false;
         }
-
-        // Insert the data array as string-stream to the parent node.
-        TiXmlText text;
-        text.SetValue( oss.str() );
+        text.SetValue( value );
 
         kvs::XMLNode::SuperClass* node = parent->InsertEndChild( element );
         return node->InsertEndChild( text ) != NULL;
@@ -184,6 +179,18 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::ValueArray<T>* data )
     // Internal data.
     if ( m_file == "" )
     {
+        // Internal data recorded by kvs::kvsml::Document without the text node.
+        const kvs::kvsml::Document* document = kvs::kvsml::Document::DownCast( m_node );
+        if ( document && document->hasData( m_node ) )
+        {
+            if ( !document->readData( m_node, nelements, data ) )
+            {
+                kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
+                return false;
+            }
+            return true;
+        }
+
         const TiXmlText* array_text = kvs::XMLNode::ToText( m_node );
         if ( !array_text )
         {
@@ -0,0 +1,546 @@
+/*****************************************************************************/
+/**
+ *  @file   DataArrayWriter.cpp
+ */
+/*****************************************************************************/
+#include "DataArrayWriter.h"
+#include <kvs/Type>
+#include <kvs/Message>
+#include <kvs/Timer>
+#include <kvs/Trace>
+#include <kvs/Parallel>
+#include <kvs/IgnoreUnusedVariable>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+
+namespace
+{
+
+const size_t BlockSize = 65536; ///< number of elements formatted by a thread at once
+const size_t ChunkSize = BlockSize * 16; ///< number of elements written at once
+thread_local double Bandwidth = 0.0; ///< bandwidth of the last file written by the calling thread (MB/s)
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the maximum number of characters of the formatted value.
+ */
+/*===========================================================================*/
+template <typename T> inline size_t MaxWidth() { return 11; } // -2147483648
+template <> inline size_t MaxWidth<kvs::Real32>() { return 16; } // -1.17549435e-38
+template <> inline size_t MaxWidth<kvs::Real64>() { return 24; } // -2.2250738585072014e-308
+
+/*===========================================================================*/
+/**
+ *  @brief  Formats the integer value.
+ *  @param  value [in] value
+ *  @param  p [in] pointer to the output buffer
+ *  @return pointer to the end of the formatted value
+ */
+/*===========================================================================*/
+inline char* FormatInteger( const kvs::Int64 value, char* p )
+{
+    kvs::UInt64 u = static_cast<kvs::UInt64>( value );
+    if ( value < 0 ) { *p++ = '-'; u = kvs::UInt64( 0 ) - u; }
+
+    char digits[20];
+    size_t n = 0;
+    do { digits[ n++ ] = static_cast<char>( '0' + u % 10 ); u /= 10; } while ( u );
+    while ( n ) { *p++ = digits[ --n ]; }
+    return p;
+}
+
+const double Powers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+}; ///< powers of ten exactly represented as double
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the value multiplied by the power of ten.
+ *  @param  value [in] value
+ *  @param  n [in] exponent
+ *  @return value * 10^n (correctly rounded if |n| <= 22)
+ */
+/*===========================================================================*/
+inline double Scale( double value, int n )
+{
+    if ( n >= 0 )
+    {
+        for ( ; n > 22; n -= 22 ) { value *= 1e22; }
+        return value * ::Powers[n];
+    }
+
+    for ( ; n < -22; n += 22 ) { value /= 1e22; }
+    return value / ::Powers[-n];
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Checks whether the formatted text is read as the same value.
+ *  @param  text [in] formatted text
+ *  @param  value [in] value
+ *  @return true, if the value is restored by kvs::kvsml::DataArrayTag
+ */
+/*===========================================================================*/
+template <typename T>
+inline bool IsRoundTrip( const char* text, const T value )
+{
+    // The same conversion as kvs::kvsml::temporal::To<T>.
+    return static_cast<T>( std::atof( text ) ) == value;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the decimal digits in the same notation as "%g".
+ *  @param  negative [in] true if the value is negative
+ *  @param  mantissa [in] decimal digits
+ *  @param  exponent [in] decimal exponent of the first digit
+ *  @param  precision [in] number of significant digits
+ *  @param  p [in] pointer to the output buffer
+ *  @return pointer to the end of the formatted value
+ */
+/*===========================================================================*/
+inline char* WriteDecimal( const bool negative, kvs::UInt64 mantissa, const int exponent, const int precision, char* p )
+{
+    char digits[20];
+    int ndigits = 0;
+    do { digits[ ndigits++ ] = static_cast<char>( '0' + mantissa % 10 ); mantissa /= 10; } while ( mantissa );
+    std::reverse( digits, digits + ndigits );
+    while ( ndigits > 1 && digits[ ndigits - 1 ] == '0' ) { ndigits--; }
+
+    if ( negative ) { *p++ = '-'; }
+    if ( exponent < -4 || exponent >= precision )
+    {
+        // d.ddde+xx
+        *p++ = digits[0];
+        if ( ndigits > 1 )
+        {
+            *p++ = '.';
+            for ( int i = 1; i < ndigits; i++ ) { *p++ = digits[i]; }
+        }
+        *p++ = 'e';
+        *p++ = exponent < 0 ? '-' : '+';
+        const int e = exponent < 0 ? -exponent : exponent;
+        if ( e >= 100 ) { *p++ = static_cast<char>( '0' + e / 100 ); }
+        *p++ = static_cast<char>( '0' + e / 10 % 10 );
+        *p++ = static_cast<char>( '0' + e % 10 );
+    }
+    else if ( exponent >= 0 )
+    {
+        // ddd.ddd
+        for ( int i = 0; i <= exponent; i++ ) { *p++ = i < ndigits ? digits[i] : '0'; }
+        if ( ndigits > exponent + 1 )
+        {
+            *p++ = '.';
+            for ( int i = exponent + 1; i < ndigits; i++ ) { *p++ = digits[i]; }
+        }
+    }
+    else
+    {
+        // 0.000ddd
+        *p++ = '0';
+        *p++ = '.';
+        for ( int i = exponent + 1; i < 0; i++ ) { *p++ = '0'; }
+        for ( int i = 0; i < ndigits; i++ ) { *p++ = digits[i]; }
+    }
+
+    return p;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Formats the real value by searching the number of digits with snprintf.
+ *  @param  value [in] value
+ *  @param  lower [in] number of digits known not to restore the value
+ *  @param  upper [in] number of digits always restoring the value
+ *  @param  p [in] pointer to the output buffer
+ *  @return pointer to the end of the formatted value
+ */
+/*===========================================================================*/
+template <typename T>
+inline char* FormatRealBySearch( const T value, int lower, int upper, char* p )
+{
+    // The number of digits is bounded by 17 (max. digits of double), so that
+    // the text is not longer than 24 characters (ex. -2.2250738585072014e-308).
+    char text[32];
+    while ( upper - lower > 1 )
+    {
+        const int digits = std::max( 1, std::min( ( lower + upper ) / 2, 17 ) );
+        std::snprintf( text, sizeof( text ), "%.*g", digits, double( value ) );
+        if ( ::IsRoundTrip( text, value ) ) { upper = digits; }
+        else { lower = digits; }
+    }
+
+    const int digits = std::max( 1, std::min( upper, 17 ) );
+    const int length = std::snprintf( text, sizeof( text ), "%.*g", digits, double( value ) );
+    std::memcpy( p, text, length );
+    return p + length;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Formats the real value with the shortest digits for the round trip.
+ *  @param  value [in] value
+ *  @param  p [in] pointer to the output buffer
+ *  @return pointer to the end of the formatted value
+ *
+ *  The value is rounded to 6 significant digits as well as std::ostream, and
+ *  the number of digits is increased until the decimal is read as the same
+ *  value. The decimal digits are computed in double precision, which is exact
+ *  up to 15 digits, and snprintf is used only for the rest of the cases.
+ */
+/*===========================================================================*/
+template <typename T>
+inline char* FormatReal( const T value, char* p )
+{
+    const int min_digits = 6;
+    const int max_digits = sizeof( T ) == 4 ? 9 : 17;
+    const int max_fast_digits = sizeof( T ) == 4 ? 9 : 15;
+
+    if ( !std::isfinite( value ) )
+    {
+        return p + std::sprintf( p, "%g", double( value ) );
+    }
+
+    const bool negative = std::signbit( value );
+    if ( value == T( 0 ) )
+    {
+        if ( negative ) { *p++ = '-'; }
+        *p++ = '0';
+        return p;
+    }
+
+    const double a = std::fabs( double( value ) );
+    int e = static_cast<int>( std::floor( std::log10( a ) ) );
+    const double normalized = ::Scale( a, -e );
+    if ( normalized < 1.0 ) { e--; }
+    else if ( normalized >= 10.0 ) { e++; }
+
+    int lower = min_digits - 1;
+    for ( int digits = min_digits; digits <= max_fast_digits; digits++ )
+    {
+        // a ~ m * 10^(exponent - digits + 1)
+        int exponent = e;
+        double m = std::floor( ::Scale( a, digits - 1 - exponent ) + 0.5 );
+        if ( m >= ::Powers[ digits ] ) { m = ::Powers[ digits - 1 ]; exponent++; }
+
+        // The scaling is correctly rounded as well as atof if |n| <= 22.
+        const int n = exponent - digits + 1;
+        if ( n < -22 || 22 < n ) { break; }
+        if ( static_cast<T>( ::Scale( m, n ) ) == std::fabs( value ) )
+        {
+            return ::WriteDecimal( negative, static_cast<kvs::UInt64>( m ), exponent, digits, p );
+        }
+
+        lower = digits;
+    }
+
+    return ::FormatRealBySearch( value, lower, max_digits, p );
+}
+
+inline char* Format( const kvs::Int8 value, char* p ) { return ::FormatInteger( value, p ); }
+inline char* Format( const kvs::UInt8 value, char* p ) { return ::FormatInteger( value, p ); }
+inline char* Format( const kvs::Int16 value, char* p ) { return ::FormatInteger( value, p ); }
+inline char* Format( const kvs::UInt16 value, char* p ) { return ::FormatInteger( value, p ); }
+inline char* Format( const kvs::Int32 value, char* p ) { return ::FormatInteger( value, p ); }
+inline char* Format( const kvs::UInt32 value, char* p ) { return ::FormatInteger( value, p ); }
+inline char* Format( const kvs::Real32 value, char* p ) { return ::FormatReal( value, p ); }
+inline char* Format( const kvs::Real64 value, char* p ) { return ::FormatReal( value, p ); }
+
+/*===========================================================================*/
+/**
+ *  @brief  Output to the file.
+ */
+/*===========================================================================*/
+class FileOutput
+{
+    FILE* m_file;
+    size_t m_nbytes; ///< number of the written bytes
+public:
+    FileOutput( FILE* file ): m_file( file ), m_nbytes( 0 ) {}
+    size_t numberOfBytes() const { return m_nbytes; }
+    bool operator ()( const char* text, const size_t length )
+    {
+        const size_t nbytes = std::fwrite( text, 1, length, m_file );
+        m_nbytes += nbytes;
+        return nbytes == length;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Output to the string.
+ */
+/*===========================================================================*/
+class StringOutput
+{
+    std::string* m_text;
+public:
+    StringOutput( std::string* text ): m_text( text ) {}
+    bool operator ()( const char* text, const size_t length )
+    {
+        m_text->append( text, length );
+        return true;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Formats the values and writes them to the output.
+ *  @param  values [in] pointer to the values
+ *  @param  nvalues [in] number of values
+ *  @param  delim [in] delimiter appended to each value
+ *  @param  output [in] output
+ *  @return true, if the writing process is done successfully
+ *
+ *  The values are formatted by chunks, and the blocks of each chunk are
+ *  formatted in parallel into the buffer and written to the output in order.
+ */
+/*===========================================================================*/
+template <typename T, typename Output>
+bool WriteText( const T* values, const size_t nvalues, const std::string& delim, Output& output )
+{
+    const size_t width = ::MaxWidth<T>() + delim.size();
+    const size_t nblocks = ( std::min( nvalues, ::ChunkSize ) + ::BlockSize - 1 ) / ::BlockSize;
+    std::vector<char> buffer( std::min( nvalues, ::ChunkSize ) * width + 1 );
+    std::vector<size_t> lengths( nblocks );
+
+    for ( size_t offset = 0; offset < nvalues; offset += ::ChunkSize )
+    {
+        const size_t size = std::min( ::ChunkSize, nvalues - offset );
+        const size_t chunk_blocks = ( size + ::BlockSize - 1 ) / ::BlockSize;
+
+        kvs::ParallelFor( 0L, static_cast<long>( chunk_blocks ), [&]( const long block )
+        {
+            const size_t begin = offset + block * ::BlockSize;
+            const size_t end = std::min( begin + ::BlockSize, offset + size );
+            char* const first = buffer.data() + block * ::BlockSize * width;
+            char* p = first;
+            for ( size_t i = begin; i < end; i++ )
+            {
+                p = ::Format( values[i], p );
+                std::memcpy( p, delim.data(), delim.size() );
+                p += delim.size();
+            }
+            lengths[ block ] = p - first;
+        } );
+
+        for ( size_t block = 0; block < chunk_blocks; block++ )
+        {
+            const char* text = buffer.data() + block * ::BlockSize * width;
+            if ( !output( text, lengths[ block ] ) ) { return false; }
+        }
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Formats the any-value array and writes it to the output.
+ *  @param  data_array [in] data array
+ *  @param  delim [in] delimiter appended to each value
+ *  @param  output [in] output
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+template <typename Output>
+bool WriteText( const kvs::AnyValueArray& data_array, const std::string& delim, Output& output )
+{
+    const std::type_info& data_type = data_array.typeInfo()->type();
+    const size_t data_size = data_array.size();
+    if ( data_type == typeid(kvs::Int8) )
+    {
+        return ::WriteText( static_cast<const kvs::Int8*>( data_array.data() ), data_size, delim, output );
+    }
+    else if ( data_type == typeid(kvs::UInt8) )
+    {
+        return ::WriteText( static_cast<const kvs::UInt8*>( data_array.data() ), data_size, delim, output );
+    }
+    else if ( data_type == typeid(kvs::Int16) )
+    {
+        return ::WriteText( static_cast<const kvs::Int16*>( data_array.data() ), data_size, delim, output );
+    }
+    else if ( data_type == typeid(kvs::UInt16) )
+    {
+        return ::WriteText( static_cast<const kvs::UInt16*>( data_array.data() ), data_size, delim, output );
+    }
+    else if ( data_type == typeid(kvs::Int32) )
+    {
+        return ::WriteText( static_cast<const kvs::Int32*>( data_array.data() ), data_size, delim, output );
+    }
+    else if ( data_type == typeid(kvs::UInt32) )
+    {
+        return ::WriteText( static_cast<const kvs::UInt32*>( data_array.data() ), data_size, delim, output );
+    }
+    else if ( data_type == typeid(kvs::Real32) )
+    {
+        return ::WriteText( static_cast<const kvs::Real32*>( data_array.data() ), data_size, delim, output );
+    }
+    else if ( data_type == typeid(kvs::Real64) )
+    {
+        return ::WriteText( static_cast<const kvs::Real64*>( data_array.data() ), data_size, delim, output );
+    }
+
+    return false;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Records the write bandwidth, which is also output to the trace.
+ *  @param  name [in] counter name
+ *  @param  nbytes [in] number of written bytes
+ *  @param  msec [in] elapsed time in msec
+ */
+/*===========================================================================*/
+inline void RecordBandwidth( const char* name, const size_t nbytes, const double msec )
+{
+    const double mbytes = double( nbytes ) / ( 1024.0 * 1024.0 );
+    ::Bandwidth = msec > 0.0 ? mbytes / ( msec * 0.001 ) : 0.0;
+    KVS_TRACE_COUNTER( name, ::Bandwidth );
+    kvs::IgnoreUnusedVariable( name );
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+namespace DataArray
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Formats the data array as text.
+ *  @param  data_array [in] data array
+ *  @param  delim [in] delimiter appended to each value
+ *  @param  text [out] pointer to the formatted text
+ *  @return true, if the formatting process is done successfully
+ *
+ *  The real values are formatted with the shortest digits that restore the
+ *  same values, and the values are formatted in parallel.
+ */
+/*===========================================================================*/
+bool FormatText(
+    const kvs::AnyValueArray& data_array,
+    const std::string& delim,
+    std::string* text )
+{
+    KVS_TRACE_SCOPE( "kvs::kvsml::DataArray::FormatText" );
+    text->clear();
+    ::StringOutput output( text );
+    if ( !::WriteText( data_array, delim, output ) )
+    {
+        text->clear();
+        kvsMessageError( "Cannot format the data array as text." );
+        return false;
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the data array to the file as text.
+ *  @param  data_array [in] data array
+ *  @param  filename [in] output file name
+ *  @param  delim [in] delimiter appended to each value
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+bool WriteTextFile(
+    const kvs::AnyValueArray& data_array,
+    const std::string& filename,
+    const std::string& delim )
+{
+    KVS_TRACE_SCOPE( "kvs::kvsml::DataArray::WriteTextFile" );
+    kvs::Timer timer( kvs::Timer::Start );
+
+    ::Bandwidth = 0.0;
+    FILE* file = std::fopen( filename.c_str(), "wb" );
+    if ( !file )
+    {
+        kvsMessageError( "Cannot open file '%s'.", filename.c_str() );
+        return false;
+    }
+
+    ::FileOutput output( file );
+    const bool success = ::WriteText( data_array, delim, output );
+    const size_t nbytes = output.numberOfBytes();
+    if ( std::fclose( file ) != 0 || !success )
+    {
+        kvsMessageError( "Cannot write the data to '%s'.", filename.c_str() );
+        return false;
+    }
+
+    timer.stop();
+    ::RecordBandwidth( "kvs::kvsml::DataArray::WriteTextFile::Bandwidth(MB/s)", nbytes, timer.msec() );
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the data array to the file as binary.
+ *  @param  data_array [in] data array
+ *  @param  filename [in] output file name
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+bool WriteBinaryFile(
+    const kvs::AnyValueArray& data_array,
+    const std::string& filename )
+{
+    KVS_TRACE_SCOPE( "kvs::kvsml::DataArray::WriteBinaryFile" );
+    kvs::Timer timer( kvs::Timer::Start );
+
+    ::Bandwidth = 0.0;
+    FILE* file = std::fopen( filename.c_str(), "wb" );
+    if ( !file )
+    {
+        kvsMessageError( "Cannot open file '%s'.", filename.c_str() );
+        return false;
+    }
+
+    // The whole array is written at once without the stream buffer.
+    std::setvbuf( file, NULL, _IONBF, 0 );
+    const size_t nbytes = data_array.byteSize();
+    const bool success = std::fwrite( data_array.data(), 1, nbytes, file ) == nbytes;
+    if ( std::fclose( file ) != 0 || !success )
+    {
+        kvsMessageError( "Cannot write the data to '%s'.", filename.c_str() );
+        return false;
+    }
+
+    timer.stop();
+    ::RecordBandwidth( "kvs::kvsml::DataArray::WriteBinaryFile::Bandwidth(MB/s)", nbytes, timer.msec() );
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the write bandwidth of the last file written by the calling thread.
+ *  @return bandwidth in MB/s (0 if the last writing process failed)
+ *
+ *  The bandwidth is measured by WriteTextFile and WriteBinaryFile, which are
+ *  called when the KVSML object is written with the external data files.
+ */
+/*===========================================================================*/
+double WriteBandwidth()
+{
+    return ::Bandwidth;
+}
+
+} // end of namespace DataArray
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
@@ -0,0 +1,40 @@
+/*****************************************************************************/
+/**
+ *  @file   DataArrayWriter.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <kvs/AnyValueArray>
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+namespace DataArray
+{
+
+bool FormatText(
+    const kvs::AnyValueArray& data_array,
+    const std::string& delim,
+    std::string* text );
+
+bool WriteTextFile(
+    const kvs::AnyValueArray& data_array,
+    const std::string& filename,
+    const std::string& delim );
+
+bool WriteBinaryFile(
+    const kvs::AnyValueArray& data_array,
+    const std::string& filename );
+
+double WriteBandwidth();
+
+} // end of namespace DataArray
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
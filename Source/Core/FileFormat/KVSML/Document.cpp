@@ -0,0 +1,335 @@
+/*****************************************************************************/
+/**
+ *  @file   Document.cpp
+ */
+/*****************************************************************************/
+#include "Document.h"
+#include "StreamReader.h"
+#include <kvs/Message>
+#include <kvs/Type>
+#include <kvs/Trace>
+#include <kvs/Platform>
+#include <cstdio>
+#include <cstring>
+#if !defined( KVS_PLATFORM_WINDOWS )
+#include <sys/types.h>
+#endif
+
+
+namespace
+{
+
+const size_t ChunkSize = 65536; ///< size of the chunk read at once
+
+bool IsSeparator( const char c )
+{
+    return c == ' ' || c == ',' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool Seek( FILE* fp, const size_t offset )
+{
+    // The offset can exceed the range of long (32 bits on Windows).
+#if defined( KVS_PLATFORM_WINDOWS )
+    return _fseeki64( fp, static_cast<__int64>( offset ), SEEK_SET ) == 0;
+#else
+    return fseeko( fp, static_cast<off_t>( offset ), SEEK_SET ) == 0;
+#endif
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new TokenReader class.
+ *  @param  filename [in] filename
+ *  @param  ranges [in] text ranges in the file
+ */
+/*===========================================================================*/
+Document::TokenReader::TokenReader( const std::string& filename, const Ranges& ranges ):
+    m_file( fopen( filename.c_str(), "rb" ) ),
+    m_ranges( ranges ),
+    m_range( 0 ),
+    m_remaining( 0 ),
+    m_buffer( ::ChunkSize + 1 ),
+    m_size( 0 ),
+    m_position( 0 )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the TokenReader class.
+ */
+/*===========================================================================*/
+Document::TokenReader::~TokenReader()
+{
+    if ( m_file ) { fclose( m_file ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the next token.
+ *  @return pointer to the null-terminated token (NULL if no more token)
+ *
+ *  The tokens are separated by white spaces and commas. The returned pointer
+ *  is valid until the next call.
+ */
+/*===========================================================================*/
+const char* Document::TokenReader::next()
+{
+    // Skip the separators.
+    for ( ;; )
+    {
+        if ( m_position == m_size && !this->fill() ) { return NULL; }
+        if ( !::IsSeparator( m_buffer[ m_position ] ) ) { break; }
+        m_position++;
+    }
+
+    // The token in the buffer is terminated in place.
+    char* begin = m_buffer.data() + m_position;
+    char* last = m_buffer.data() + m_size;
+    char* end = begin;
+    while ( end != last && !::IsSeparator( *end ) ) { ++end; }
+    if ( end != last )
+    {
+        *end = '\0';
+        m_position = end - m_buffer.data() + 1;
+        return begin;
+    }
+
+    // The token across the chunks is copied.
+    m_token.assign( begin, end );
+    m_position = m_size;
+    while ( this->fill() )
+    {
+        begin = m_buffer.data();
+        last = begin + m_size;
+        end = begin;
+        while ( end != last && !::IsSeparator( *end ) ) { ++end; }
+        m_token.append( begin, end );
+        m_position = end - begin;
+        if ( end != last ) { break; }
+    }
+
+    return m_token.c_str();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the next chunk of the text.
+ *  @return false, if all of the text is read
+ */
+/*===========================================================================*/
+bool Document::TokenReader::fill()
+{
+    if ( !m_file ) { return false; }
+
+    while ( m_remaining == 0 )
+    {
+        if ( m_range >= m_ranges.size() ) { return false; }
+        const Range& range = m_ranges[ m_range++ ];
+        if ( !::Seek( m_file, range.offset ) ) { return false; }
+        m_remaining = range.size;
+    }
+
+    const size_t size = m_remaining < ::ChunkSize ? m_remaining : ::ChunkSize;
+    m_size = fread( m_buffer.data(), 1, size, m_file );
+    m_buffer[ m_size ] = '\0';
+    m_position = 0;
+    m_remaining = m_size == size ? m_remaining - size : 0;
+    return m_size > 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the KVSML document of the node.
+ *  @param  node [in] pointer to the node
+ *  @return pointer to the document (NULL if the node is not in the KVSML document)
+ */
+/*===========================================================================*/
+const Document* Document::DownCast( const TiXmlNode* node )
+{
+    return node ? dynamic_cast<const Document*>( node->GetDocument() ) : NULL;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Document class.
+ */
+/*===========================================================================*/
+Document::Document()
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the KVSML file.
+ *  @param  filename [in] filename
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool Document::read( const std::string& filename )
+{
+    KVS_TRACE_SCOPE( "kvs::kvsml::Document::read" );
+    m_filename = filename;
+    m_data.clear();
+    this->Clear();
+
+    kvs::kvsml::StreamReader reader;
+    if ( !reader.open( filename ) )
+    {
+        this->SetError( TIXML_ERROR_OPENING_FILE );
+        return false;
+    }
+
+    TiXmlNode* parent = this;
+    const TiXmlNode* data_node = NULL; // <DataArray> with the internal data
+    for ( ;; )
+    {
+        switch ( reader.next( data_node == NULL ) )
+        {
+        case kvs::kvsml::StreamReader::StartElement:
+        {
+            TiXmlElement element( reader.name() );
+            const kvs::kvsml::StreamReader::Attributes& attributes = reader.attributes();
+            for ( size_t i = 0; i < attributes.size(); i++ )
+            {
+                element.SetAttribute( attributes[i].first, attributes[i].second );
+            }
+
+            parent = parent->InsertEndChild( element );
+
+            if ( reader.name() == "DataArray" && reader.attribute( "file" ).empty() )
+            {
+                data_node = parent;
+                m_data[ data_node ] = Ranges();
+            }
+            break;
+        }
+        case kvs::kvsml::StreamReader::EndElement:
+        {
+            if ( parent == this || parent->Value() != reader.name() )
+            {
+                this->SetError( TIXML_ERROR_READING_END_TAG );
+                return false;
+            }
+
+            if ( parent == data_node ) { data_node = NULL; }
+            parent = parent->Parent();
+            break;
+        }
+        case kvs::kvsml::StreamReader::Text:
+        {
+            if ( data_node )
+            {
+                const Range range = { reader.textOffset(), reader.textSize() };
+                m_data[ data_node ].push_back( range );
+            }
+            else if ( parent != this && !reader.isBlankText() )
+            {
+                TiXmlText text;
+                text.SetValue( reader.text() );
+                parent->InsertEndChild( text );
+            }
+            break;
+        }
+        case kvs::kvsml::StreamReader::EndOfDocument:
+        {
+            if ( parent != this )
+            {
+                this->SetError( TIXML_ERROR_READING_END_TAG );
+                return false;
+            }
+            return true;
+        }
+        default:
+        {
+            this->SetError( TIXML_ERROR_PARSING_ELEMENT );
+            return false;
+        }
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Checks whether the node has the internal data recorded in the document.
+ *  @param  node [in] pointer to the <DataArray> node
+ *  @return true, if the internal data is recorded
+ */
+/*===========================================================================*/
+bool Document::hasData( const TiXmlNode* node ) const
+{
+    return m_data.find( node ) != m_data.end();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the internal data of the <DataArray> as the specified type.
+ *  @param  node [in] pointer to the <DataArray> node
+ *  @param  type [in] data type given by 'type' attribute
+ *  @param  nelements [in] number of elements
+ *  @param  data [out] pointer to the any-value array
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool Document::readData(
+    const TiXmlNode* node,
+    const std::string& type,
+    const size_t nelements,
+    kvs::AnyValueArray* data ) const
+{
+    if ( type == "char" )
+    {
+        data->allocate<kvs::Int8>( nelements );
+        return this->read_data( node, nelements, static_cast<kvs::Int8*>( data->data() ) );
+    }
+    else if ( type == "unsigned char" || type == "uchar" )
+    {
+        data->allocate<kvs::UInt8>( nelements );
+        return this->read_data( node, nelements, static_cast<kvs::UInt8*>( data->data() ) );
+    }
+    else if ( type == "short" )
+    {
+        data->allocate<kvs::Int16>( nelements );
+        return this->read_data( node, nelements, static_cast<kvs::Int16*>( data->data() ) );
+    }
+    else if ( type == "unsigned short" || type == "ushort" )
+    {
+        data->allocate<kvs::UInt16>( nelements );
+        return this->read_data( node, nelements, static_cast<kvs::UInt16*>( data->data() ) );
+    }
+    else if ( type == "int" )
+    {
+        data->allocate<kvs::Int32>( nelements );
+        return this->read_data( node, nelements, static_cast<kvs::Int32*>( data->data() ) );
+    }
+    else if ( type == "unsigned int" || type == "uint" )
+    {
+        data->allocate<kvs::UInt32>( nelements );
+        return this->read_data( node, nelements, static_cast<kvs::UInt32*>( data->data() ) );
+    }
+    else if ( type == "float" )
+    {
+        data->allocate<kvs::Real32>( nelements );
+        return this->read_data( node, nelements, static_cast<kvs::Real32*>( data->data() ) );
+    }
+    else if ( type == "double" )
+    {
+        data->allocate<kvs::Real64>( nelements );
+        return this->read_data( node, nelements, static_cast<kvs::Real64*>( data->data() ) );
+    }
+
+    return false;
+}
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
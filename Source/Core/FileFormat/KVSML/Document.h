@@ -0,0 +1,157 @@
+/*****************************************************************************/
+/**
+ *  @file   Document.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <kvs/XMLDocument>
+#include <kvs/ValueArray>
+#include <kvs/AnyValueArray>
+#include "DataArray.h"
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  XML document for reading the KVSML file.
+ *
+ *  The document is built by the streaming reader (kvs::kvsml::StreamReader)
+ *  with the elements, attributes and texts except the internal data of
+ *  <DataArray>, whose position in the file is recorded instead of the text.
+ *  The internal data is decoded directly from the file into the value array
+ *  allocated with the number of elements by readData(), which is called by
+ *  kvs::kvsml::DataArrayTag, so that the tag classes can read the document
+ *  as well as kvs::XMLDocument.
+ */
+/*===========================================================================*/
+class Document : public kvs::XMLDocument
+{
+public:
+
+    typedef kvs::XMLDocument BaseClass;
+
+    struct Range
+    {
+        size_t offset; ///< offset of the text in the file
+        size_t size; ///< byte size of the text
+    };
+
+    typedef std::vector<Range> Ranges;
+
+    /*=======================================================================*/
+    /**
+     *  @brief  Token reader for the text in the file.
+     */
+    /*=======================================================================*/
+    class TokenReader
+    {
+    private:
+        FILE* m_file; ///< file pointer
+        const Ranges& m_ranges; ///< text ranges
+        size_t m_range; ///< index of the current range
+        size_t m_remaining; ///< number of remaining bytes in the current range
+        std::vector<char> m_buffer; ///< chunk buffer (null-terminated)
+        size_t m_size; ///< number of bytes in the buffer
+        size_t m_position; ///< read position in the buffer
+        std::string m_token; ///< token across the chunks
+
+    public:
+        TokenReader( const std::string& filename, const Ranges& ranges );
+        ~TokenReader();
+
+        bool isOpen() const { return m_file != NULL; }
+        const char* next();
+
+    private:
+        bool fill();
+    };
+
+private:
+
+    std::map<const TiXmlNode*,Ranges> m_data; ///< text ranges of the internal data arrays
+
+public:
+
+    static const Document* DownCast( const TiXmlNode* node );
+
+public:
+
+    Document();
+
+    bool read( const std::string& filename );
+
+    bool hasData( const TiXmlNode* node ) const;
+    bool readData( const TiXmlNode* node, const std::string& type, const size_t nelements, kvs::AnyValueArray* data ) const;
+    template <typename T>
+    bool readData( const TiXmlNode* node, const size_t nelements, kvs::ValueArray<T>* data ) const;
+
+private:
+
+    template <typename T>
+    bool read_data( const TiXmlNode* node, const size_t nelements, T* data ) const;
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the internal data of the <DataArray>.
+ *  @param  node [in] pointer to the <DataArray> node
+ *  @param  nelements [in] number of elements
+ *  @param  data [out] pointer to the value array
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+template <typename T>
+inline bool Document::readData(
+    const TiXmlNode* node,
+    const size_t nelements,
+    kvs::ValueArray<T>* data ) const
+{
+    data->allocate( nelements );
+    return this->read_data( node, nelements, data->data() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Decodes the internal data into the allocated array.
+ *  @param  node [in] pointer to the <DataArray> node
+ *  @param  nelements [in] number of elements
+ *  @param  data [out] pointer to the allocated array
+ *  @return true, if the reading process is done successfully
+ *
+ *  The values are converted as well as kvs::kvsml::DataArray::ReadInternalData,
+ *  and the missing values are filled with zero.
+ */
+/*===========================================================================*/
+template <typename T>
+inline bool Document::read_data( const TiXmlNode* node, const size_t nelements, T* data ) const
+{
+    std::map<const TiXmlNode*,Ranges>::const_iterator i = m_data.find( node );
+    if ( i == m_data.end() ) { return false; }
+
+    TokenReader reader( m_filename, i->second );
+    if ( !reader.isOpen() ) { return false; }
+
+    size_t index = 0;
+    for ( ; index < nelements; index++ )
+    {
+        const char* token = reader.next();
+        if ( !token ) { break; }
+        data[ index ] = kvs::kvsml::temporal::To<T>( token );
+    }
+
+    for ( ; index < nelements; index++ ) { data[ index ] = T( 0 ); }
+    return true;
+}
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
@@ -0,0 +1,205 @@
+/*****************************************************************************/
+/**
+ *  @file   FormatChecker.cpp
+ */
+/*****************************************************************************/
+#include "FormatChecker.h"
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+
+namespace
+{
+
+const size_t ChunkSize = 4096; ///< size of the chunk read at once
+const size_t MaxHeadSize = 65536; ///< maximum size of the head of the file to be scanned
+
+/*===========================================================================*/
+/**
+ *  @brief  Reader class for the head of the file.
+ *
+ *  The file is read by chunks, and at most MaxHeadSize bytes are read.
+ */
+/*===========================================================================*/
+class HeadReader
+{
+private:
+
+    std::ifstream m_stream; ///< input file stream
+    char m_buffer[ ::ChunkSize ]; ///< chunk buffer
+    size_t m_size; ///< number of bytes in the buffer
+    size_t m_position; ///< position in the buffer
+    size_t m_total; ///< total number of the read bytes
+
+public:
+
+    HeadReader( const std::string& filename ):
+        m_stream( filename.c_str(), std::ios::in | std::ios::binary ),
+        m_size( 0 ),
+        m_position( 0 ),
+        m_total( 0 ) {}
+
+    bool isOpen() const { return m_stream.is_open(); }
+
+    bool get( char& c )
+    {
+        if ( m_position == m_size )
+        {
+            if ( m_total >= ::MaxHeadSize || !m_stream ) { return false; }
+            m_stream.read( m_buffer, ::ChunkSize );
+            m_size = static_cast<size_t>( m_stream.gcount() );
+            m_position = 0;
+            m_total += m_size;
+            if ( m_size == 0 ) { return false; }
+        }
+
+        c = m_buffer[ m_position++ ];
+        return true;
+    }
+
+    bool skip( const char* terminator )
+    {
+        // Skips the characters until the terminator is found.
+        const size_t length = std::strlen( terminator );
+        std::string tail;
+        char c;
+        while ( this->get( c ) )
+        {
+            tail += c;
+            if ( tail.size() > length ) { tail.erase( 0, 1 ); }
+            if ( tail == terminator ) { return true; }
+        }
+        return false;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Splits the tag path into the tag names.
+ *  @param  path [in] tag path separated by '/' (ex. "KVSML/Object")
+ *  @return tag names
+ */
+/*===========================================================================*/
+std::vector<std::string> SplitPath( const std::string& path )
+{
+    std::vector<std::string> names;
+    std::string::size_type begin = 0;
+    while ( begin <= path.size() )
+    {
+        std::string::size_type end = path.find( '/', begin );
+        if ( end == std::string::npos ) { end = path.size(); }
+        if ( end > begin ) { names.push_back( path.substr( begin, end - begin ) ); }
+        begin = end + 1;
+    }
+    return names;
+}
+
+bool IsNameTerminator( const char c )
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '/' || c == '>';
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the name of the first child tag of the specified tag.
+ *  @param  filename [in] filename
+ *  @param  path [in] path of the parent tag (ex. "KVSML/Object")
+ *  @return name of the child tag (empty if not found)
+ *
+ *  Only the start and end tags at the head of the file are scanned without
+ *  building the XML document, so that the type of the KVSML file can be
+ *  checked without parsing the data. The declaration, comments and CDATA
+ *  sections are skipped.
+ */
+/*===========================================================================*/
+std::string ChildTagName( const std::string& filename, const std::string& path )
+{
+    const std::vector<std::string> names = ::SplitPath( path );
+    if ( names.empty() ) { return ""; }
+
+    ::HeadReader reader( filename );
+    if ( !reader.isOpen() ) { return ""; }
+
+    std::vector<std::string> stack;
+    char c;
+    while ( reader.get( c ) )
+    {
+        if ( c != '<' ) { continue; }
+        if ( !reader.get( c ) ) { break; }
+
+        if ( c == '?' )
+        {
+            // <?xml ... ?>
+            if ( !reader.skip( "?>" ) ) { break; }
+        }
+        else if ( c == '!' )
+        {
+            // <!-- ... -->, <![CDATA[ ... ]]> or <!DOCTYPE ... >
+            if ( !reader.get( c ) ) { break; }
+            if ( c == '-' ) { if ( !reader.skip( "-->" ) ) { break; } }
+            else if ( c == '[' ) { if ( !reader.skip( "]]>" ) ) { break; } }
+            else if ( c != '>' ) { if ( !reader.skip( ">" ) ) { break; } }
+        }
+        else if ( c == '/' )
+        {
+            // End tag.
+            if ( !reader.skip( ">" ) || stack.empty() ) { break; }
+            stack.pop_back();
+        }
+        else
+        {
+            // Start tag.
+            std::string name( 1, c );
+            while ( reader.get( c ) && !::IsNameTerminator( c ) ) { name += c; }
+
+            if ( stack == names ) { return name; }
+            if ( stack.empty() && name != names[0] ) { break; }
+
+            // Skip the attributes (the quoted values can include '>').
+            bool empty = false;
+            char quote = 0;
+            while ( c != '>' )
+            {
+                if ( quote ) { if ( c == quote ) { quote = 0; } }
+                else if ( c == '"' || c == '\'' ) { quote = c; }
+                empty = ( !quote && c == '/' );
+                if ( !reader.get( c ) ) { return ""; }
+            }
+
+            if ( !empty ) { stack.push_back( name ); }
+        }
+    }
+
+    return "";
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Checks whether the first child tag of the specified tag is the given tag.
+ *  @param  filename [in] filename
+ *  @param  path [in] path of the parent tag (ex. "KVSML/Object")
+ *  @param  tag [in] name of the child tag
+ *  @return true, if the first child tag is the given tag
+ */
+/*===========================================================================*/
+bool CheckChildTag(
+    const std::string& filename,
+    const std::string& path,
+    const std::string& tag )
+{
+    return kvs::kvsml::ChildTagName( filename, path ) == tag;
+}
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
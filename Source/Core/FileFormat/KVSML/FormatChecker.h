@@ -0,0 +1,25 @@
+/*****************************************************************************/
+/**
+ *  @file   FormatChecker.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+std::string ChildTagName( const std::string& filename, const std::string& path );
+
+bool CheckChildTag(
+    const std::string& filename,
+    const std::string& path,
+    const std::string& tag );
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
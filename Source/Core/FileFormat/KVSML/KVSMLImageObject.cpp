@@ -5,6 +5,8 @@
  */
 /****************************************************************************/
 #include "KVSMLImageObject.h"
+#include "FormatChecker.h"
+#include "Document.h"
 #include "ImageObjectTag.h"
 #include "PixelTag.h"
 #include "DataArrayTag.h"
@@ -20,6 +22,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -53,25 +56,10 @@ bool KVSMLImageObject::CheckExtension( const std::string& filename )
 /*===========================================================================*/
 bool KVSMLImageObject::CheckFormat( const std::string& filename )
 {
-    kvs::XMLDocument document;
-    if ( !document.read( filename ) ) return false;
-
     // <KVSML>
-    const std::string kvsml_tag("KVSML");
-    const kvs::XMLNode::SuperClass* kvsml_node = kvs::XMLDocument::FindNode( &document, kvsml_tag );
-    if ( !kvsml_node ) return false;
-
-    // <Object>
-    const std::string object_tag("Object");
-    const kvs::XMLNode::SuperClass* object_node = kvs::XMLNode::FindChildNode( kvsml_node, object_tag );
-    if ( !object_node ) return false;
-
-    // <ImageObject>
-    const std::string image_tag("ImageObject");
-    const kvs::XMLNode::SuperClass* image_node = kvs::XMLNode::FindChildNode( object_node, image_tag );
-    if ( !image_node ) return false;
-
-    return true;
+    //   <Object>
+    //     <ImageObject>
+    return kvs::kvsml::CheckChildTag( filename, "KVSML/Object", "ImageObject" );
 }
 
 /*===========================================================================*/
@@ -126,11 +114,12 @@ void KVSMLImageObject::print( std::ostream& os, const kvs::Indent& indent ) cons
 /*===========================================================================*/
 bool KVSMLImageObject::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::KVSMLImageObject::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( false );
 
     // XML document.
-    kvs::XMLDocument document;
+    kvs::kvsml::Document document;
     if ( !document.read( filename ) )
     {
         kvsMessageError( "%s", document.ErrorDesc().c_str() );
@@ -5,6 +5,8 @@
  */
 /****************************************************************************/
 #include "KVSMLLineObject.h"
+#include "FormatChecker.h"
+#include "Document.h"
 #include "LineObjectTag.h"
 #include "LineTag.h"
 #include "VertexTag.h"
@@ -22,6 +24,7 @@
 #include <kvs/XMLElement>
 #include <kvs/XMLComment>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -55,25 +58,10 @@ bool KVSMLLineObject::CheckExtension( const std::string& filename )
 /*===========================================================================*/
 bool KVSMLLineObject::CheckFormat( const std::string& filename )
 {
-    kvs::XMLDocument document;
-    if ( !document.read( filename ) ) return false;
-
     // <KVSML>
-    const std::string kvsml_tag("KVSML");
-    const kvs::XMLNode::SuperClass* kvsml_node = kvs::XMLDocument::FindNode( &document, kvsml_tag );
-    if ( !kvsml_node ) return false;
-
-    // <Object>
-    const std::string object_tag("Object");
-    const kvs::XMLNode::SuperClass* object_node = kvs::XMLNode::FindChildNode( kvsml_node, object_tag );
-    if ( !object_node ) return false;
-
-    // <LineObject>
-    const std::string line_tag("LineObject");
-    const kvs::XMLNode::SuperClass* line_node = kvs::XMLNode::FindChildNode( object_node, line_tag );
-    if ( !line_node ) return false;
-
-    return true;
+    //   <Object>
+    //     <LineObject>
+    return kvs::kvsml::CheckChildTag( filename, "KVSML/Object", "LineObject" );
 }
 
 /*===========================================================================*/
@@ -132,11 +120,12 @@ void KVSMLLineObject::print( std::ostream& os, const kvs::Indent& indent ) const
 /*===========================================================================*/
 bool KVSMLLineObject::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::KVSMLLineObject::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( false );
 
     // XML document.
-    kvs::XMLDocument document;
+    kvs::kvsml::Document document;
     if ( !document.read( filename ) )
     {
         kvsMessageError( "%s", document.ErrorDesc().c_str() );
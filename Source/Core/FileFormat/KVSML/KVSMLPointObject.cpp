@@ -5,6 +5,8 @@
  */
 /****************************************************************************/
 #include "KVSMLPointObject.h"
+#include "FormatChecker.h"
+#include "Document.h"
 #include "PointObjectTag.h"
 #include "VertexTag.h"
 #include "CoordTag.h"
@@ -27,6 +29,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -60,25 +63,10 @@ bool KVSMLPointObject::CheckExtension( const std::string& filename )
 /*===========================================================================*/
 bool KVSMLPointObject::CheckFormat( const std::string& filename )
 {
-    kvs::XMLDocument document;
-    if ( !document.read( filename ) ) return false;
-
     // <KVSML>
-    const std::string kvsml_tag("KVSML");
-    const kvs::XMLNode::SuperClass* kvsml_node = kvs::XMLDocument::FindNode( &document, kvsml_tag );
-    if ( !kvsml_node ) return false;
-
-    // <Object>
-    const std::string object_tag("Object");
-    const kvs::XMLNode::SuperClass* object_node = kvs::XMLNode::FindChildNode( kvsml_node, object_tag );
-    if ( !object_node ) return false;
-
-    // <PointObject>
-    const std::string point_tag("PointObject");
-    const kvs::XMLNode::SuperClass* point_node = kvs::XMLNode::FindChildNode( object_node, point_tag );
-    if ( !point_node ) return false;
-
-    return true;
+    //   <Object>
+    //     <PointObject>
+    return kvs::kvsml::CheckChildTag( filename, "KVSML/Object", "PointObject" );
 }
 
 /*===========================================================================*/
@@ -135,11 +123,12 @@ void KVSMLPointObject::print( std::ostream& os, const kvs::Indent& indent ) cons
 /*===========================================================================*/
 bool KVSMLPointObject::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::KVSMLPointObject::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( false );
 
     // XML document.
-    kvs::XMLDocument document;
+    kvs::kvsml::Document document;
     if ( !document.read( filename ) )
     {
         kvsMessageError( "%s", document.ErrorDesc().c_str() );
@@ -5,6 +5,8 @@
  */
 /****************************************************************************/
 #include "KVSMLPolygonObject.h"
+#include "FormatChecker.h"
+#include "Document.h"
 #include "PolygonObjectTag.h"
 #include "PolygonTag.h"
 #include "VertexTag.h"
@@ -25,6 +27,7 @@
 #include <kvs/ValueArray>
 #include <kvs/Type>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -58,25 +61,10 @@ bool KVSMLPolygonObject::CheckExtension( const std::string& filename )
 /*===========================================================================*/
 bool KVSMLPolygonObject::CheckFormat( const std::string& filename )
 {
-    kvs::XMLDocument document;
-    if ( !document.read( filename ) ) return false;
-
     // <KVSML>
-    const std::string kvsml_tag("KVSML");
-    const kvs::XMLNode::SuperClass* kvsml_node = kvs::XMLDocument::FindNode( &document, kvsml_tag );
-    if ( !kvsml_node ) return false;
-
-    // <Object>
-    const std::string object_tag("Object");
-    const kvs::XMLNode::SuperClass* object_node = kvs::XMLNode::FindChildNode( kvsml_node, object_tag );
-    if ( !object_node ) return false;
-
-    // <PolygonObject>
-    const std::string polygon_tag("PolygonObject");
-    const kvs::XMLNode::SuperClass* polygon_node = kvs::XMLNode::FindChildNode( object_node, polygon_tag );
-    if ( !polygon_node ) return false;
-
-    return true;
+    //   <Object>
+    //     <PolygonObject>
+    return kvs::kvsml::CheckChildTag( filename, "KVSML/Object", "PolygonObject" );
 }
 
 /*===========================================================================*/
@@ -136,11 +124,12 @@ void KVSMLPolygonObject::print( std::ostream& os, const kvs::Indent& indent ) co
 /*===========================================================================*/
 bool KVSMLPolygonObject::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::KVSMLPolygonObject::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( false );
 
     // XML document.
-    kvs::XMLDocument document;
+    kvs::kvsml::Document document;
     if ( !document.read( filename ) )
     {
         kvsMessageError( "%s", document.ErrorDesc().c_str() );
@@ -5,6 +5,8 @@
  */
 /****************************************************************************/
 #include "KVSMLStructuredVolumeObject.h"
+#include "FormatChecker.h"
+#include "Document.h"
 #include "StructuredVolumeObjectTag.h"
 #include "NodeTag.h"
 #include "ValueTag.h"
@@ -19,6 +21,7 @@
 #include <kvs/Type>
 #include <kvs/String>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -54,25 +57,10 @@ bool KVSMLStructuredVolumeObject::CheckExtension( const std::string& filename )
 /*===========================================================================*/
 bool KVSMLStructuredVolumeObject::CheckFormat( const std::string& filename )
 {
-    kvs::XMLDocument document;
-    if ( !document.read( filename ) ) return false;
-
     // <KVSML>
-    const std::string kvsml_tag("KVSML");
-    const kvs::XMLNode::SuperClass* kvsml_node = kvs::XMLDocument::FindNode( &document, kvsml_tag );
-    if ( !kvsml_node ) return false;
-
-    // <Object>
-    const std::string object_tag("Object");
-    const kvs::XMLNode::SuperClass* object_node = kvs::XMLNode::FindChildNode( kvsml_node, object_tag );
-    if ( !object_node ) return false;
-
-    // <StructuredVolumeObject>
-    const std::string volume_tag("StructuredVolumeObject");
-    const kvs::XMLNode::SuperClass* volume_node = kvs::XMLNode::FindChildNode( object_node, volume_tag );
-    if ( !volume_node ) return false;
-
-    return true;
+    //   <Object>
+    //     <StructuredVolumeObject>
+    return kvs::kvsml::CheckChildTag( filename, "KVSML/Object", "StructuredVolumeObject" );
 }
 
 /*===========================================================================*/
@@ -158,11 +146,12 @@ void KVSMLStructuredVolumeObject::print( std::ostream& os, const kvs::Indent& in
 /*===========================================================================*/
 bool KVSMLStructuredVolumeObject::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::KVSMLStructuredVolumeObject::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( false );
 
     // XML document
-    kvs::XMLDocument document;
+    kvs::kvsml::Document document;
     if ( !document.read( filename ) )
     {
         kvsMessageError( "%s", document.ErrorDesc().c_str() );
@@ -5,6 +5,8 @@
  */
 /*****************************************************************************/
 #include "KVSMLTableObject.h"
+#include "FormatChecker.h"
+#include "Document.h"
 #include "TableObjectTag.h"
 #include "ColumnTag.h"
 #include "DataArrayTag.h"
@@ -13,6 +15,7 @@
 #include <kvs/XMLDeclaration>
 #include <kvs/XMLElement>
 #include <kvs/XMLComment>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -46,25 +49,10 @@ bool KVSMLTableObject::CheckExtension( const std::string& filename )
 /*===========================================================================*/
 bool KVSMLTableObject::CheckFormat( const std::string& filename )
 {
-    kvs::XMLDocument document;
-    if ( !document.read( filename ) ) return false;
-
     // <KVSML>
-    const std::string kvsml_tag("KVSML");
-    const kvs::XMLNode::SuperClass* kvsml_node = kvs::XMLDocument::FindNode( &document, kvsml_tag );
-    if ( !kvsml_node ) return false;
-
-    // <Object>
-    const std::string object_tag("Object");
-    const kvs::XMLNode::SuperClass* object_node = kvs::XMLNode::FindChildNode( kvsml_node, object_tag );
-    if ( !object_node ) return false;
-
-    // <TableObject>
-    const std::string table_tag("TableObject");
-    const kvs::XMLNode::SuperClass* table_node = kvs::XMLNode::FindChildNode( object_node, table_tag );
-    if ( !table_node ) return false;
-
-    return true;
+    //   <Object>
+    //     <TableObject>
+    return kvs::kvsml::CheckChildTag( filename, "KVSML/Object", "TableObject" );
 }
 
 /*===========================================================================*/
@@ -187,11 +175,12 @@ void KVSMLTableObject::print( std::ostream& os, const kvs::Indent& indent ) cons
 /*===========================================================================*/
 bool KVSMLTableObject::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::KVSMLTableObject::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( false );
 
     // XML document
-    kvs::XMLDocument document;
+    kvs::kvsml::Document document;
     if ( !document.read( filename ) )
     {
         kvsMessageError( "%s", document.ErrorDesc().c_str() );
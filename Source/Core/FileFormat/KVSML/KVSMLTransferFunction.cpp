@@ -5,6 +5,8 @@
  */
 /****************************************************************************/
 #include "KVSMLTransferFunction.h"
+#include "FormatChecker.h"
+#include "Document.h"
 #include <kvs/File>
 #include <kvs/XMLDocument>
 #include <kvs/XMLDeclaration>
@@ -16,6 +18,7 @@
 #include "ColorMapTag.h"
 #include "OpacityMapTag.h"
 #include "DataArrayTag.h"
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -49,20 +52,9 @@ bool KVSMLTransferFunction::CheckExtension( const std::string& filename )
 /*===========================================================================*/
 bool KVSMLTransferFunction::CheckFormat( const std::string& filename )
 {
-    kvs::XMLDocument document;
-    if ( !document.read( filename ) ) return false;
-
     // <KVSML>
-    const std::string kvsml_tag("KVSML");
-    const kvs::XMLNode::SuperClass* kvsml_node = kvs::XMLDocument::FindNode( &document, kvsml_tag );
-    if ( !kvsml_node ) return false;
-
-    // <TransferFunction>
-    const std::string tfunc_tag("TransferFunction");
-    const kvs::XMLNode::SuperClass* tfunc_node = kvs::XMLNode::FindChildNode( kvsml_node, tfunc_tag );
-    if ( !tfunc_node ) return false;
-
-    return true;
+    //   <TransferFunction>
+    return kvs::kvsml::CheckChildTag( filename, "KVSML", "TransferFunction" );
 }
 
 /*===========================================================================*/
@@ -149,11 +141,12 @@ void KVSMLTransferFunction::print( std::ostream& os, const kvs::Indent& indent )
 /*===========================================================================*/
 bool KVSMLTransferFunction::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::KVSMLTransferFunction::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
     // XML document
-    kvs::XMLDocument document;
+    kvs::kvsml::Document document;
     if ( !document.read( filename ) )
     {
         kvsMessageError( "%s", document.ErrorDesc().c_str() );
@@ -5,6 +5,8 @@
  */
 /****************************************************************************/
 #include "KVSMLUnstructuredVolumeObject.h"
+#include "FormatChecker.h"
+#include "Document.h"
 #include "UnstructuredVolumeObjectTag.h"
 #include "NodeTag.h"
 #include "CellTag.h"
@@ -20,6 +22,7 @@
 #include <kvs/AnyValueArray>
 #include <kvs/Type>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Trace>
 
 
 namespace
@@ -80,25 +83,10 @@ bool KVSMLUnstructuredVolumeObject::CheckExtension( const std::string& filename
 /*===========================================================================*/
 bool KVSMLUnstructuredVolumeObject::CheckFormat( const std::string& filename )
 {
-    kvs::XMLDocument document;
-    if ( !document.read( filename ) ) return false;
-
     // <KVSML>
-    const std::string kvsml_tag("KVSML");
-    const kvs::XMLNode::SuperClass* kvsml_node = kvs::XMLDocument::FindNode( &document, kvsml_tag );
-    if ( !kvsml_node ) return false;
-
-    // <Object>
-    const std::string object_tag("Object");
-    const kvs::XMLNode::SuperClass* object_node = kvs::XMLNode::FindChildNode( kvsml_node, object_tag );
-    if ( !object_node ) return false;
-
-    // <UnstructuredVolumeObject>
-    const std::string volume_tag("UnstructuredVolumeObject");
-    const kvs::XMLNode::SuperClass* volume_node = kvs::XMLNode::FindChildNode( object_node, volume_tag );
-    if ( !volume_node ) return false;
-
-    return true;
+    //   <Object>
+    //     <UnstructuredVolumeObject>
+    return kvs::kvsml::CheckChildTag( filename, "KVSML/Object", "UnstructuredVolumeObject" );
 }
 
 /*===========================================================================*/
@@ -163,11 +151,12 @@ void KVSMLUnstructuredVolumeObject::print( std::ostream& os, const kvs::Indent&
 /*===========================================================================*/
 bool KVSMLUnstructuredVolumeObject::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::KVSMLUnstructuredVolumeObject::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( false );
 
     // XML document
-    kvs::XMLDocument document;
+    kvs::kvsml::Document document;
     if ( !document.read( filename ) )
     {
         kvsMessageError( "%s", document.ErrorDesc().c_str() );
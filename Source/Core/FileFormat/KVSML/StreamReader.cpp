@@ -0,0 +1,403 @@
+/*****************************************************************************/
+/**
+ *  @file   StreamReader.cpp
+ */
+/*****************************************************************************/
+#include "StreamReader.h"
+#include <cstring>
+
+
+namespace
+{
+
+const size_t ChunkSize = 65536; ///< size of the chunk read at once
+
+bool IsSpace( const char c )
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool IsNameTerminator( const char c )
+{
+    return ::IsSpace( c ) || c == '/' || c == '>';
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Replaces the predefined entities with the characters.
+ *  @param  text [in] text
+ *  @return replaced text
+ */
+/*===========================================================================*/
+std::string Unescape( const std::string& text )
+{
+    if ( text.find( '&' ) == std::string::npos ) { return text; }
+
+    const struct { const char* entity; char c; } entities[] = {
+        { "&lt;", '<' }, { "&gt;", '>' }, { "&amp;", '&' }, { "&quot;", '"' }, { "&apos;", '\'' }
+    };
+
+    std::string result;
+    result.reserve( text.size() );
+    for ( size_t i = 0; i < text.size(); i++ )
+    {
+        bool replaced = false;
+        if ( text[i] == '&' )
+        {
+            for ( size_t j = 0; j < sizeof( entities ) / sizeof( entities[0] ); j++ )
+            {
+                const size_t length = std::strlen( entities[j].entity );
+                if ( text.compare( i, length, entities[j].entity ) == 0 )
+                {
+                    result += entities[j].c;
+                    i += length - 1;
+                    replaced = true;
+                    break;
+                }
+            }
+        }
+        if ( !replaced ) { result += text[i]; }
+    }
+
+    return result;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new StreamReader class.
+ */
+/*===========================================================================*/
+StreamReader::StreamReader():
+    m_file( NULL ),
+    m_size( 0 ),
+    m_position( 0 ),
+    m_offset( 0 ),
+    m_pending_end( false ),
+    m_text_offset( 0 ),
+    m_text_size( 0 ),
+    m_blank( true )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the StreamReader class.
+ */
+/*===========================================================================*/
+StreamReader::~StreamReader()
+{
+    this->close();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Opens the file.
+ *  @param  filename [in] filename
+ *  @return true, if the file is opened successfully
+ */
+/*===========================================================================*/
+bool StreamReader::open( const std::string& filename )
+{
+    this->close();
+
+    m_file = fopen( filename.c_str(), "rb" );
+    if ( !m_file ) { return false; }
+
+    m_buffer.resize( ::ChunkSize );
+    m_size = 0;
+    m_position = 0;
+    m_offset = 0;
+    m_pending_end = false;
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Closes the file.
+ */
+/*===========================================================================*/
+void StreamReader::close()
+{
+    if ( m_file ) { fclose( m_file ); m_file = NULL; }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the next event.
+ *  @param  keep_text [in] if false, only the position of the text is recorded
+ *  @return event
+ */
+/*===========================================================================*/
+StreamReader::Event StreamReader::next( const bool keep_text )
+{
+    if ( !m_file ) { return Error; }
+
+    // End event of the empty element <name/>.
+    if ( m_pending_end )
+    {
+        m_pending_end = false;
+        m_attributes.clear();
+        return EndElement;
+    }
+
+    for ( ;; )
+    {
+        char c;
+        if ( !this->peek( c ) ) { return EndOfDocument; }
+        if ( c != '<' ) { return this->read_text( keep_text ); }
+
+        this->get( c );
+        if ( !this->get( c ) ) { return Error; }
+
+        if ( c == '?' )
+        {
+            // <?xml ... ?>
+            if ( !this->skip( "?>" ) ) { return Error; }
+        }
+        else if ( c == '!' )
+        {
+            if ( !this->get( c ) ) { return Error; }
+            if ( c == '-' )
+            {
+                // <!-- ... -->
+                if ( !this->skip( "-->" ) ) { return Error; }
+            }
+            else if ( c == '[' )
+            {
+                // <![CDATA[ ... ]]>
+                if ( !this->skip( "CDATA[" ) ) { return Error; }
+                m_text_offset = m_offset + m_position;
+                if ( !this->skip( "]]>", &m_text ) ) { return Error; }
+                m_text.erase( m_text.size() - 3 );
+                m_text_size = m_text.size();
+                m_blank = false;
+                return Text;
+            }
+            else if ( c != '>' )
+            {
+                // <!DOCTYPE ... >
+                if ( !this->skip( ">" ) ) { return Error; }
+            }
+        }
+        else if ( c == '/' )
+        {
+            return this->read_end_tag();
+        }
+        else
+        {
+            return this->read_start_tag( c );
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the attribute value.
+ *  @param  name [in] attribute name
+ *  @return attribute value (empty if not specified)
+ */
+/*===========================================================================*/
+std::string StreamReader::attribute( const std::string& name ) const
+{
+    for ( size_t i = 0; i < m_attributes.size(); i++ )
+    {
+        if ( m_attributes[i].first == name ) { return m_attributes[i].second; }
+    }
+    return "";
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads a character.
+ *  @param  c [out] read character
+ *  @return false, if the end of the file is reached
+ */
+/*===========================================================================*/
+bool StreamReader::get( char& c )
+{
+    if ( !this->peek( c ) ) { return false; }
+    m_position++;
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the next character without reading it.
+ *  @param  c [out] next character
+ *  @return false, if the end of the file is reached
+ */
+/*===========================================================================*/
+bool StreamReader::peek( char& c )
+{
+    if ( m_position == m_size && !this->fill() ) { return false; }
+    c = m_buffer[ m_position ];
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the next chunk.
+ *  @return false, if the end of the file is reached
+ */
+/*===========================================================================*/
+bool StreamReader::fill()
+{
+    m_offset += m_size;
+    m_size = fread( m_buffer.data(), 1, m_buffer.size(), m_file );
+    m_position = 0;
+    return m_size > 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Skips the characters until the terminator.
+ *  @param  terminator [in] terminator
+ *  @param  skipped [out] skipped characters including the terminator (optional)
+ *  @return false, if the terminator is not found
+ */
+/*===========================================================================*/
+bool StreamReader::skip( const char* terminator, std::string* skipped )
+{
+    const size_t length = std::strlen( terminator );
+    std::string tail;
+    if ( skipped ) { skipped->clear(); }
+
+    char c;
+    while ( this->get( c ) )
+    {
+        if ( skipped ) { *skipped += c; }
+        tail += c;
+        if ( tail.size() > length ) { tail.erase( 0, 1 ); }
+        if ( tail == terminator ) { return true; }
+    }
+
+    return false;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the start tag.
+ *  @param  c [in] first character of the element name
+ *  @return event
+ */
+/*===========================================================================*/
+StreamReader::Event StreamReader::read_start_tag( char c )
+{
+    m_name.assign( 1, c );
+    m_attributes.clear();
+    for ( ;; )
+    {
+        if ( !this->get( c ) ) { return Error; }
+        if ( ::IsNameTerminator( c ) ) { break; }
+        m_name += c;
+    }
+
+    for ( ;; )
+    {
+        while ( ::IsSpace( c ) ) { if ( !this->get( c ) ) { return Error; } }
+        if ( c == '>' ) { return StartElement; }
+        if ( c == '/' )
+        {
+            if ( !this->get( c ) || c != '>' ) { return Error; }
+            m_pending_end = true;
+            return StartElement;
+        }
+
+        // name="value"
+        std::string name;
+        while ( c != '=' && !::IsNameTerminator( c ) )
+        {
+            name += c;
+            if ( !this->get( c ) ) { return Error; }
+        }
+        while ( ::IsSpace( c ) ) { if ( !this->get( c ) ) { return Error; } }
+        if ( c != '=' ) { return Error; }
+        if ( !this->get( c ) ) { return Error; }
+        while ( ::IsSpace( c ) ) { if ( !this->get( c ) ) { return Error; } }
+        if ( c != '"' && c != '\'' ) { return Error; }
+
+        const char quote = c;
+        std::string value;
+        for ( ;; )
+        {
+            if ( !this->get( c ) ) { return Error; }
+            if ( c == quote ) { break; }
+            value += c;
+        }
+        m_attributes.push_back( Attribute( name, ::Unescape( value ) ) );
+
+        if ( !this->get( c ) ) { return Error; }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the end tag.
+ *  @return event
+ */
+/*===========================================================================*/
+StreamReader::Event StreamReader::read_end_tag()
+{
+    m_name.clear();
+    m_attributes.clear();
+
+    char c;
+    for ( ;; )
+    {
+        if ( !this->get( c ) ) { return Error; }
+        if ( c == '>' ) { break; }
+        if ( !::IsSpace( c ) ) { m_name += c; }
+    }
+
+    return EndElement;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the text until the next tag.
+ *  @param  keep_text [in] if false, the text is not stored
+ *  @return event
+ */
+/*===========================================================================*/
+StreamReader::Event StreamReader::read_text( const bool keep_text )
+{
+    m_text.clear();
+    m_text_offset = m_offset + m_position;
+    m_text_size = 0;
+    m_blank = keep_text;
+
+    for ( ;; )
+    {
+        if ( m_position == m_size && !this->fill() ) { break; }
+
+        const char* begin = m_buffer.data() + m_position;
+        const size_t size = m_size - m_position;
+        const char* end = static_cast<const char*>( std::memchr( begin, '<', size ) );
+        const size_t length = end ? static_cast<size_t>( end - begin ) : size;
+        if ( keep_text )
+        {
+            for ( size_t i = 0; i < length && m_blank; i++ ) { m_blank = ::IsSpace( begin[i] ); }
+            m_text.append( begin, length );
+        }
+
+        m_position += length;
+        m_text_size += length;
+        if ( end ) { break; }
+    }
+
+    if ( keep_text ) { m_text = ::Unescape( m_text ); }
+    return Text;
+}
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
@@ -0,0 +1,104 @@
+/*****************************************************************************/
+/**
+ *  @file   StreamReader.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdio>
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Streaming (pull) reader for the XML file.
+ *
+ *  The file is read by chunks, and the start tags, end tags and texts are
+ *  returned as events by next() without building the XML document. The
+ *  declaration, comments and DOCTYPE are skipped. The content of the text
+ *  can be skipped with only its position in the file recorded, which can be
+ *  used for reading the large data later.
+ *
+ *  kvs::kvsml::StreamReader reader;
+ *  reader.open( filename );
+ *  for ( ;; )
+ *  {
+ *      switch ( reader.next() )
+ *      {
+ *      case kvs::kvsml::StreamReader::StartElement: ... // reader.name(), reader.attributes()
+ *      case kvs::kvsml::StreamReader::EndElement: ... // reader.name()
+ *      case kvs::kvsml::StreamReader::Text: ... // reader.text()
+ *      ...
+ *      }
+ *  }
+ */
+/*===========================================================================*/
+class StreamReader
+{
+public:
+
+    enum Event
+    {
+        StartElement, ///< start tag (<name attribute="value"> or <name/>)
+        EndElement, ///< end tag (</name> or following <name/>)
+        Text, ///< text or CDATA section
+        EndOfDocument, ///< end of the file
+        Error ///< parse error
+    };
+
+    typedef std::pair<std::string,std::string> Attribute;
+    typedef std::vector<Attribute> Attributes;
+
+private:
+
+    FILE* m_file; ///< file pointer
+    std::vector<char> m_buffer; ///< chunk buffer
+    size_t m_size; ///< number of bytes in the buffer
+    size_t m_position; ///< read position in the buffer
+    size_t m_offset; ///< offset of the buffer in the file
+    bool m_pending_end; ///< true if the end event of the empty element is pending
+    std::string m_name; ///< element name
+    Attributes m_attributes; ///< attributes of the element
+    std::string m_text; ///< text (if kept)
+    size_t m_text_offset; ///< offset of the text in the file
+    size_t m_text_size; ///< byte size of the text in the file
+    bool m_blank; ///< true if the text consists of white spaces only
+
+public:
+
+    StreamReader();
+    ~StreamReader();
+
+    bool open( const std::string& filename );
+    void close();
+    Event next( const bool keep_text = true );
+
+    const std::string& name() const { return m_name; }
+    const Attributes& attributes() const { return m_attributes; }
+    std::string attribute( const std::string& name ) const;
+    const std::string& text() const { return m_text; }
+    size_t textOffset() const { return m_text_offset; }
+    size_t textSize() const { return m_text_size; }
+    bool isBlankText() const { return m_blank; }
+
+private:
+
+    bool get( char& c );
+    bool peek( char& c );
+    bool fill();
+    bool skip( const char* terminator, std::string* skipped = NULL );
+    Event read_start_tag( char c );
+    Event read_end_tag();
+    Event read_text( const bool keep_text );
+};
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
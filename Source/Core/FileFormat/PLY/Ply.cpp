@@ -17,6 +17,7 @@
 #include <kvs/Assert>
 #include "Ply.h"
 #include "PlyFile.h"
+#include <kvs/Trace>
 
 
 namespace
@@ -219,6 +220,7 @@ void Ply::print( std::ostream& os, const kvs::Indent& indent ) const
 
 bool Ply::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Ply::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
@@ -12,6 +12,7 @@
 #include <kvs/ValueArray>
 #include "../../NanoVG/stb_image.h"
 #include "../../NanoVG/stb_image_write.h"
+#include <kvs/Trace>
 
 
 namespace
@@ -111,6 +112,7 @@ void Png::print( std::ostream& os, const kvs::Indent& indent ) const
 /*===========================================================================*/
 bool Png::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Png::read" );
     KVS_ASSERT( ( 0 <= m_bpp ) && ( m_bpp <= 4 ) );
 
     BaseClass::setFilename( filename );
@@ -10,6 +10,7 @@
 #include <fstream>
 #include <kvs/Message>
 #include <kvs/File>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -135,6 +136,7 @@ void Pbm::print( std::ostream& os, const kvs::Indent& indent ) const
 /*==========================================================================*/
 bool Pbm::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Pbm::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
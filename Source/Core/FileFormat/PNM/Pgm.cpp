@@ -9,6 +9,7 @@
 #include <iostream>
 #include <fstream>
 #include <kvs/File>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -134,6 +135,7 @@ void Pgm::print( std::ostream& os, const kvs::Indent& indent ) const
 /*==========================================================================*/
 bool Pgm::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Pgm::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
@@ -9,6 +9,7 @@
 #include <iostream>
 #include <fstream>
 #include <kvs/File>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -134,6 +135,7 @@ void Ppm::print( std::ostream& os, const kvs::Indent& indent ) const
 /*==========================================================================*/
 bool Ppm::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Ppm::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <kvs/File>
 #include <kvs/Assert>
+#include <kvs/Trace>
 
 
 namespace
@@ -131,6 +132,7 @@ void Stl::print( std::ostream& os, const kvs::Indent& indent ) const
 /*===========================================================================*/
 bool Stl::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Stl::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
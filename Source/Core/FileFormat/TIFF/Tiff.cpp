@@ -9,6 +9,7 @@
 #include <kvs/IgnoreUnusedVariable>
 #include <kvs/File>
 #include <algorithm>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -70,6 +71,7 @@ void Tiff::print( std::ostream& os, const kvs::Indent& indent ) const
 
 bool Tiff::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::Tiff::read" );
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
@@ -6,6 +6,7 @@
 /****************************************************************************/
 #include "XMLDocument.h"
 #include <string>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -84,6 +85,7 @@ TiXmlNode* XMLDocument::insert( const TiXmlNode& node )
 /*==========================================================================*/
 bool XMLDocument::read( const std::string& filename )
 {
+    KVS_TRACE_SCOPE( "kvs::XMLDocument::read" );
     m_filename = filename;
 
     return SuperClass::LoadFile( filename );
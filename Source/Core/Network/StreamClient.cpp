@@ -0,0 +1,148 @@
+/****************************************************************************/
+/**
+ *  @file   StreamClient.cpp
+ */
+/****************************************************************************/
+#include "StreamClient.h"
+#include <vector>
+#include <algorithm>
+#include <kvs/Message>
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new StreamClient class.
+ */
+/*==========================================================================*/
+StreamClient::StreamClient():
+    m_sequence( 0 ),
+    m_nmissed_frames( 0 )
+{
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new StreamClient class and connects to the server.
+ *  @param  ip [in] IP address of the server
+ *  @param  port [in] port number
+ *  @param  timeout [in] timeout
+ */
+/*==========================================================================*/
+StreamClient::StreamClient( const kvs::IPAddress& ip, const int port, const kvs::SocketTimer* timeout ):
+    m_sequence( 0 ),
+    m_nmissed_frames( 0 )
+{
+    this->connect( ip, port, timeout );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Destroys the StreamClient class.
+ */
+/*==========================================================================*/
+StreamClient::~StreamClient()
+{
+    this->close();
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Connects to the server.
+ *  @param  ip [in] IP address of the server
+ *  @param  port [in] port number
+ *  @param  timeout [in] timeout
+ *  @return true, if the connection is established
+ */
+/*==========================================================================*/
+bool StreamClient::connect( const kvs::IPAddress& ip, const int port, const kvs::SocketTimer* timeout )
+{
+    this->close();
+    m_socket.open();
+    if ( !m_socket.connect( ip, port, timeout ) )
+    {
+        kvsMessageError( "Cannot connect to the server (port %d).", port );
+        m_socket.close();
+        return false;
+    }
+
+    m_sequence = 0;
+    m_nmissed_frames = 0;
+    return true;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Closes the connection.
+ */
+/*==========================================================================*/
+void StreamClient::close()
+{
+    if ( m_socket.isOpen() ) { m_socket.close(); }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Receives a frame (blocks until the whole frame is received).
+ *  @param  frame [out] pointer to the frame
+ *  @return false, if the connection is closed or the frame is invalid
+ */
+/*==========================================================================*/
+bool StreamClient::receive( kvs::StreamFrame* frame )
+{
+    std::vector<kvs::UInt8> header( kvs::StreamFrame::FixedHeaderSize );
+    if ( !this->receive_exact( header.data(), header.size() ) ) { return false; }
+
+    const size_t metadata_size = kvs::StreamFrame::MetadataSize( header.data() );
+    if ( metadata_size == 0 )
+    {
+        kvsMessageError( "Invalid frame header." );
+        return false;
+    }
+
+    header.resize( header.size() + metadata_size );
+    if ( !this->receive_exact( header.data() + kvs::StreamFrame::FixedHeaderSize, metadata_size ) ) { return false; }
+    if ( !frame->readHeader( header.data(), header.size() ) ) { return false; }
+
+    for ( size_t i = 0; i < frame->numberOfArrays(); i++ )
+    {
+        // The array shares the memory with the one in the frame.
+        kvs::AnyValueArray array = frame->array(i);
+        if ( !this->receive_exact( array.data(), array.byteSize() ) ) { return false; }
+    }
+
+    if ( m_sequence > 0 && frame->sequence() > m_sequence + 1 )
+    {
+        m_nmissed_frames += static_cast<size_t>( frame->sequence() - m_sequence - 1 );
+    }
+    m_sequence = frame->sequence();
+
+    return true;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Receives the data of the given size.
+ *  @param  data [out] pointer to the data
+ *  @param  size [in] byte size of the data
+ *  @return false, if the connection is closed
+ */
+/*==========================================================================*/
+bool StreamClient::receive_exact( void* data, const size_t size )
+{
+    kvs::UInt8* p = static_cast<kvs::UInt8*>( data );
+    size_t received = 0;
+    while ( received < size )
+    {
+        const int length = static_cast<int>( std::min( size - received, size_t( 1 ) << 30 ) );
+        const int n = m_socket.receive( p + received, length );
+        if ( n <= 0 ) { return false; }
+        received += static_cast<size_t>( n );
+        if ( n < length ) { return false; }
+    }
+    return true;
+}
+
+} // end of namespace kvs
@@ -0,0 +1,60 @@
+/****************************************************************************/
+/**
+ *  @file   StreamClient.h
+ */
+/****************************************************************************/
+#ifndef KVS__STREAM_CLIENT_H_INCLUDE
+#define KVS__STREAM_CLIENT_H_INCLUDE
+
+#include "TCPSocket.h"
+#include "IPAddress.h"
+#include "SocketTimer.h"
+#include "StreamFrame.h"
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Client which receives the frames from kvs::StreamServer.
+ *
+ *  The arrays of the received frame are allocated from the header and the
+ *  payload is received into them directly. A gap in the sequence numbers
+ *  indicates the frames dropped by the server.
+ */
+/*==========================================================================*/
+class StreamClient
+{
+protected:
+
+    kvs::TCPSocket m_socket; ///< socket
+    kvs::UInt64 m_sequence; ///< sequence number of the last received frame
+    size_t m_nmissed_frames; ///< number of the frames dropped by the server
+
+public:
+
+    StreamClient();
+    StreamClient( const kvs::IPAddress& ip, const int port, const kvs::SocketTimer* timeout = 0 );
+    virtual ~StreamClient();
+
+    bool connect( const kvs::IPAddress& ip, const int port, const kvs::SocketTimer* timeout = 0 );
+    void close();
+
+    bool isConnected() { return m_socket.isConnected(); }
+    kvs::UInt64 sequence() const { return m_sequence; }
+    size_t numberOfMissedFrames() const { return m_nmissed_frames; }
+
+    bool receive( kvs::StreamFrame* frame );
+
+private:
+
+    StreamClient( const StreamClient& );
+    StreamClient& operator =( const StreamClient& );
+
+    bool receive_exact( void* data, const size_t size );
+};
+
+} // end of namespace kvs
+
+#endif // KVS__STREAM_CLIENT_H_INCLUDE
@@ -0,0 +1,424 @@
+/****************************************************************************/
+/**
+ *  @file   StreamFrame.cpp
+ */
+/****************************************************************************/
+#include "StreamFrame.h"
+#include <cstring>
+#include <kvs/Message>
+
+
+namespace
+{
+
+const kvs::AnyValueArray EmptyArray;
+
+/*==========================================================================*/
+/**
+ *  @brief  Writer of the values to the byte buffer.
+ */
+/*==========================================================================*/
+class Writer
+{
+private:
+    std::vector<kvs::UInt8>& m_buffer; ///< byte buffer
+
+public:
+    Writer( std::vector<kvs::UInt8>& buffer ): m_buffer( buffer ) {}
+
+    template <typename T>
+    void write( const T value )
+    {
+        const kvs::UInt8* p = reinterpret_cast<const kvs::UInt8*>( &value );
+        m_buffer.insert( m_buffer.end(), p, p + sizeof( T ) );
+    }
+
+    void write( const std::string& value )
+    {
+        this->write( kvs::UInt32( value.size() ) );
+        m_buffer.insert( m_buffer.end(), value.begin(), value.end() );
+    }
+};
+
+/*==========================================================================*/
+/**
+ *  @brief  Reader of the values from the byte buffer.
+ */
+/*==========================================================================*/
+class Reader
+{
+private:
+    const kvs::UInt8* m_data; ///< pointer to the current position
+    const kvs::UInt8* m_end; ///< pointer to the end of the buffer
+
+public:
+    Reader( const void* data, const size_t size ):
+        m_data( static_cast<const kvs::UInt8*>( data ) ),
+        m_end( static_cast<const kvs::UInt8*>( data ) + size ) {}
+
+    template <typename T>
+    bool read( T* value )
+    {
+        if ( size_t( m_end - m_data ) < sizeof( T ) ) { return false; }
+        std::memcpy( value, m_data, sizeof( T ) );
+        m_data += sizeof( T );
+        return true;
+    }
+
+    bool read( std::string* value )
+    {
+        kvs::UInt32 length = 0;
+        if ( !this->read( &length ) ) { return false; }
+        if ( size_t( m_end - m_data ) < length ) { return false; }
+        value->assign( reinterpret_cast<const char*>( m_data ), length );
+        m_data += length;
+        return true;
+    }
+};
+
+/*==========================================================================*/
+/**
+ *  @brief  Allocates the array of the given type.
+ *  @param  array [out] pointer to the array
+ *  @param  type [in] type ID
+ *  @param  nbytes [in] byte size of the array
+ *  @return true, if the array is allocated
+ */
+/*==========================================================================*/
+bool Allocate( kvs::AnyValueArray* array, const kvs::UInt32 type, const kvs::UInt64 nbytes )
+{
+    switch ( type )
+    {
+    case kvs::Type::TypeInt8: array->allocate<kvs::Int8>( nbytes / sizeof( kvs::Int8 ) ); break;
+    case kvs::Type::TypeInt16: array->allocate<kvs::Int16>( nbytes / sizeof( kvs::Int16 ) ); break;
+    case kvs::Type::TypeInt32: array->allocate<kvs::Int32>( nbytes / sizeof( kvs::Int32 ) ); break;
+    case kvs::Type::TypeInt64: array->allocate<kvs::Int64>( nbytes / sizeof( kvs::Int64 ) ); break;
+    case kvs::Type::TypeUInt8: array->allocate<kvs::UInt8>( nbytes / sizeof( kvs::UInt8 ) ); break;
+    case kvs::Type::TypeUInt16: array->allocate<kvs::UInt16>( nbytes / sizeof( kvs::UInt16 ) ); break;
+    case kvs::Type::TypeUInt32: array->allocate<kvs::UInt32>( nbytes / sizeof( kvs::UInt32 ) ); break;
+    case kvs::Type::TypeUInt64: array->allocate<kvs::UInt64>( nbytes / sizeof( kvs::UInt64 ) ); break;
+    case kvs::Type::TypeReal32: array->allocate<kvs::Real32>( nbytes / sizeof( kvs::Real32 ) ); break;
+    case kvs::Type::TypeReal64: array->allocate<kvs::Real64>( nbytes / sizeof( kvs::Real64 ) ); break;
+    default: return false;
+    }
+
+    return array->byteSize() == nbytes;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+const kvs::UInt32 StreamFrame::Magic = 0x5353564B; // "KVSS"
+const size_t StreamFrame::FixedHeaderSize = 40;
+const size_t StreamFrame::MaxMetadataSize = 1 << 24;
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the byte size of the metadata following the fixed header.
+ *  @param  header [in] pointer to the fixed header (FixedHeaderSize bytes)
+ *  @return byte size of the metadata, or 0 if the header is invalid
+ */
+/*==========================================================================*/
+size_t StreamFrame::MetadataSize( const void* header )
+{
+    // The magic number is at the offset 0 and the metadata size is at 28.
+    kvs::UInt32 magic = 0;
+    kvs::UInt32 metadata_size = 0;
+    std::memcpy( &magic, header, sizeof( kvs::UInt32 ) );
+    std::memcpy( &metadata_size, static_cast<const kvs::UInt8*>( header ) + 28, sizeof( kvs::UInt32 ) );
+    if ( magic != Magic ) { return 0; }
+    return metadata_size <= MaxMetadataSize ? metadata_size : 0;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new frame.
+ *  @param  type [in] frame type
+ *  @param  name [in] name of the frame
+ */
+/*==========================================================================*/
+StreamFrame::StreamFrame( const FrameType type, const std::string& name ):
+    m_type( type ),
+    m_sequence( 0 ),
+    m_width( 0 ),
+    m_height( 0 ),
+    m_name( name )
+{
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new image frame which refers to the pixels of the image.
+ *  @param  image [in] color image
+ */
+/*==========================================================================*/
+StreamFrame::StreamFrame( const kvs::ColorImage& image ):
+    m_type( ImageFrame ),
+    m_sequence( 0 ),
+    m_width( image.width() ),
+    m_height( image.height() ),
+    m_name( "ColorImage" )
+{
+    this->addArray( "pixels", image.pixels() );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new image frame which refers to the pixels.
+ *  @param  width [in] image width
+ *  @param  height [in] image height
+ *  @param  pixels [in] pixels (ex. RGBA pixels read from the frame buffer)
+ */
+/*==========================================================================*/
+StreamFrame::StreamFrame(
+    const size_t width,
+    const size_t height,
+    const kvs::ValueArray<kvs::UInt8>& pixels ):
+    m_type( ImageFrame ),
+    m_sequence( 0 ),
+    m_width( width ),
+    m_height( height ),
+    m_name( "Image" )
+{
+    this->addArray( "pixels", pixels );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new object frame which refers to the arrays of the object.
+ *  @param  object [in] KVSB object (ex. exported by kvs::PointExporter<kvs::KVSBObject>)
+ */
+/*==========================================================================*/
+StreamFrame::StreamFrame( const kvs::KVSBObject& object ):
+    m_type( ObjectFrame ),
+    m_sequence( 0 ),
+    m_width( 0 ),
+    m_height( 0 ),
+    m_name( object.objectType() ),
+    m_attributes( object.attributes().begin(), object.attributes().end() )
+{
+    const std::vector<std::string>& names = object.arrayNames();
+    for ( size_t i = 0; i < names.size(); i++ )
+    {
+        this->addArray( names[i], object.array( names[i] ) );
+    }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the array specified by the name.
+ *  @param  name [in] array name
+ *  @return array (empty if not found)
+ */
+/*==========================================================================*/
+const kvs::AnyValueArray& StreamFrame::array( const std::string& name ) const
+{
+    for ( size_t i = 0; i < m_array_names.size(); i++ )
+    {
+        if ( m_array_names[i] == name ) { return m_arrays[i]; }
+    }
+    return ::EmptyArray;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the byte size of the arrays.
+ *  @return byte size of the payload
+ */
+/*==========================================================================*/
+size_t StreamFrame::payloadSize() const
+{
+    size_t size = 0;
+    for ( size_t i = 0; i < m_arrays.size(); i++ ) { size += m_arrays[i].byteSize(); }
+    return size;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Adds the array to the frame without copying.
+ *  @param  name [in] array name
+ *  @param  array [in] array
+ */
+/*==========================================================================*/
+void StreamFrame::addArray( const std::string& name, const kvs::AnyValueArray& array )
+{
+    m_array_names.push_back( name );
+    m_arrays.push_back( array );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the color image which refers to the pixels of the frame.
+ *  @return color image (empty if the frame does not have the RGB pixels)
+ */
+/*==========================================================================*/
+kvs::ColorImage StreamFrame::toColorImage() const
+{
+    const kvs::AnyValueArray& pixels = this->array( "pixels" );
+    if ( m_type != ImageFrame ||
+         pixels.typeID() != kvs::Type::TypeUInt8 ||
+         pixels.size() != m_width * m_height * 3 )
+    {
+        kvsMessageError( "The frame does not have the RGB pixels." );
+        return kvs::ColorImage();
+    }
+
+    return kvs::ColorImage( m_width, m_height, pixels.asValueArray<kvs::UInt8>() );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Sets the attributes and the arrays of the frame to the KVSB object.
+ *  @param  object [out] pointer to the KVSB object
+ *  @return true, if the frame is an object frame
+ */
+/*==========================================================================*/
+bool StreamFrame::toObject( kvs::KVSBObject* object ) const
+{
+    if ( m_type != ObjectFrame )
+    {
+        kvsMessageError( "The frame is not an object frame." );
+        return false;
+    }
+
+    object->setObjectType( m_name );
+    Attributes::const_iterator attribute = m_attributes.begin();
+    while ( attribute != m_attributes.end() )
+    {
+        object->setAttribute( attribute->first, attribute->second );
+        ++attribute;
+    }
+
+    for ( size_t i = 0; i < m_arrays.size(); i++ )
+    {
+        object->setArray( m_array_names[i], m_arrays[i] );
+    }
+
+    return true;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the header of the frame.
+ *  @return header (fixed header and metadata)
+ */
+/*==========================================================================*/
+kvs::ValueArray<kvs::UInt8> StreamFrame::header() const
+{
+    std::vector<kvs::UInt8> metadata;
+    ::Writer writer( metadata );
+    writer.write( m_name );
+    writer.write( kvs::UInt32( m_attributes.size() ) );
+    Attributes::const_iterator attribute = m_attributes.begin();
+    while ( attribute != m_attributes.end() )
+    {
+        writer.write( attribute->first );
+        writer.write( attribute->second );
+        ++attribute;
+    }
+
+    for ( size_t i = 0; i < m_arrays.size(); i++ )
+    {
+        writer.write( m_array_names[i] );
+        writer.write( kvs::UInt32( m_arrays[i].typeID() ) );
+        writer.write( kvs::UInt64( m_arrays[i].byteSize() ) );
+    }
+
+    std::vector<kvs::UInt8> header;
+    header.reserve( FixedHeaderSize + metadata.size() );
+    ::Writer fixed( header );
+    fixed.write( Magic );
+    fixed.write( kvs::UInt32( m_type ) );
+    fixed.write( kvs::UInt64( m_sequence ) );
+    fixed.write( kvs::UInt32( m_width ) );
+    fixed.write( kvs::UInt32( m_height ) );
+    fixed.write( kvs::UInt32( m_arrays.size() ) );
+    fixed.write( kvs::UInt32( metadata.size() ) );
+    fixed.write( kvs::UInt64( this->payloadSize() ) );
+    header.insert( header.end(), metadata.begin(), metadata.end() );
+
+    return kvs::ValueArray<kvs::UInt8>( header );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Reads the header and allocates the arrays to be received.
+ *  @param  header [in] pointer to the header (fixed header and metadata)
+ *  @param  size [in] byte size of the header
+ *  @return true, if the header is valid
+ */
+/*==========================================================================*/
+bool StreamFrame::readHeader( const void* header, const size_t size )
+{
+    ::Reader reader( header, size );
+    kvs::UInt32 magic = 0;
+    kvs::UInt32 type = 0;
+    kvs::UInt32 width = 0;
+    kvs::UInt32 height = 0;
+    kvs::UInt32 narrays = 0;
+    kvs::UInt32 metadata_size = 0;
+    kvs::UInt64 payload_size = 0;
+    if ( !reader.read( &magic ) || magic != Magic ||
+         !reader.read( &type ) ||
+         !reader.read( &m_sequence ) ||
+         !reader.read( &width ) ||
+         !reader.read( &height ) ||
+         !reader.read( &narrays ) ||
+         !reader.read( &metadata_size ) ||
+         !reader.read( &payload_size ) ||
+         FixedHeaderSize + metadata_size != size )
+    {
+        kvsMessageError( "Invalid frame header." );
+        return false;
+    }
+
+    m_type = FrameType( type );
+    m_width = width;
+    m_height = height;
+    m_attributes.clear();
+    m_array_names.clear();
+    m_arrays.clear();
+
+    kvs::UInt32 nattributes = 0;
+    bool valid = reader.read( &m_name ) && reader.read( &nattributes );
+    for ( kvs::UInt32 i = 0; valid && i < nattributes; i++ )
+    {
+        std::string name;
+        std::string value;
+        valid = reader.read( &name ) && reader.read( &value );
+        if ( valid ) { m_attributes[ name ] = value; }
+    }
+
+    kvs::UInt64 total_size = 0;
+    for ( kvs::UInt32 i = 0; valid && i < narrays; i++ )
+    {
+        std::string name;
+        kvs::UInt32 array_type = 0;
+        kvs::UInt64 nbytes = 0;
+        valid = reader.read( &name ) && reader.read( &array_type ) && reader.read( &nbytes );
+        if ( !valid ) { break; }
+
+        kvs::AnyValueArray array;
+        if ( nbytes > payload_size - total_size || !::Allocate( &array, array_type, nbytes ) )
+        {
+            valid = false;
+            break;
+        }
+
+        total_size += nbytes;
+        this->addArray( name, array );
+    }
+
+    if ( !valid || total_size != payload_size )
+    {
+        kvsMessageError( "Invalid frame metadata." );
+        return false;
+    }
+
+    return true;
+}
+
+} // end of namespace kvs
@@ -0,0 +1,107 @@
+/****************************************************************************/
+/**
+ *  @file   StreamFrame.h
+ */
+/****************************************************************************/
+#ifndef KVS__STREAM_FRAME_H_INCLUDE
+#define KVS__STREAM_FRAME_H_INCLUDE
+
+#include <string>
+#include <vector>
+#include <map>
+#include <kvs/Type>
+#include <kvs/ValueArray>
+#include <kvs/AnyValueArray>
+#include <kvs/ColorImage>
+#include <kvs/KVSBObject>
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Frame of the stream sent by kvs::StreamServer.
+ *
+ *  A frame consists of a header and the named arrays. On the wire, the header
+ *  is followed by the bytes of the arrays as they are stored in the memory,
+ *  so that the arrays are sent without copying. The header has the following
+ *  layout (in the native byte order):
+ *
+ *      magic (4), type (4), sequence (8), width (4), height (4),
+ *      number of arrays (4), metadata size (4), payload size (8),
+ *      metadata: name, attributes and the descriptors (name, type, bytes)
+ *      of the arrays, where a string is stored as the length (4) and the
+ *      characters.
+ *
+ *  An image frame has the pixels as the array "pixels", and an object frame
+ *  has the attributes and the arrays of kvs::KVSBObject.
+ */
+/*==========================================================================*/
+class StreamFrame
+{
+public:
+
+    typedef std::map<std::string,std::string> Attributes;
+
+    enum FrameType
+    {
+        UnknownFrame = 0, ///< unknown frame
+        ImageFrame = 1, ///< image (pixels)
+        ObjectFrame = 2, ///< object (attributes and arrays of the KVSB object)
+        DataFrame = 3 ///< user-defined data
+    };
+
+    static const kvs::UInt32 Magic; ///< magic number of the frame
+    static const size_t FixedHeaderSize; ///< byte size of the fixed part of the header
+    static const size_t MaxMetadataSize; ///< max. byte size of the metadata
+
+    static size_t MetadataSize( const void* header );
+
+protected:
+
+    FrameType m_type; ///< frame type
+    kvs::UInt64 m_sequence; ///< sequence number assigned by the server
+    size_t m_width; ///< image width
+    size_t m_height; ///< image height
+    std::string m_name; ///< name (ex. object type)
+    Attributes m_attributes; ///< attributes
+    std::vector<std::string> m_array_names; ///< array names
+    std::vector<kvs::AnyValueArray> m_arrays; ///< arrays
+
+public:
+
+    StreamFrame( const FrameType type = DataFrame, const std::string& name = "" );
+    StreamFrame( const kvs::ColorImage& image );
+    StreamFrame( const size_t width, const size_t height, const kvs::ValueArray<kvs::UInt8>& pixels );
+    StreamFrame( const kvs::KVSBObject& object );
+
+    FrameType type() const { return m_type; }
+    kvs::UInt64 sequence() const { return m_sequence; }
+    size_t width() const { return m_width; }
+    size_t height() const { return m_height; }
+    const std::string& name() const { return m_name; }
+    const Attributes& attributes() const { return m_attributes; }
+    size_t numberOfArrays() const { return m_arrays.size(); }
+    const std::string& arrayName( const size_t index ) const { return m_array_names[ index ]; }
+    const kvs::AnyValueArray& array( const size_t index ) const { return m_arrays[ index ]; }
+    const kvs::AnyValueArray& array( const std::string& name ) const;
+    size_t payloadSize() const;
+
+    void setType( const FrameType type ) { m_type = type; }
+    void setSequence( const kvs::UInt64 sequence ) { m_sequence = sequence; }
+    void setSize( const size_t width, const size_t height ) { m_width = width; m_height = height; }
+    void setName( const std::string& name ) { m_name = name; }
+    void setAttribute( const std::string& name, const std::string& value ) { m_attributes[ name ] = value; }
+    void addArray( const std::string& name, const kvs::AnyValueArray& array );
+
+    kvs::ColorImage toColorImage() const;
+    bool toObject( kvs::KVSBObject* object ) const;
+
+    kvs::ValueArray<kvs::UInt8> header() const;
+    bool readHeader( const void* header, const size_t size );
+};
+
+} // end of namespace kvs
+
+#endif // KVS__STREAM_FRAME_H_INCLUDE
@@ -0,0 +1,749 @@
+/****************************************************************************/
+/**
+ *  @file   StreamServer.cpp
+ */
+/****************************************************************************/
+#include "StreamServer.h"
+#include <deque>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstring>
+#include <kvs/Message>
+#include <kvs/Platform>
+#include "IPAddress.h"
+#include "SocketAddress.h"
+#if defined( KVS_PLATFORM_LINUX )
+#include <sys/epoll.h>
+#endif
+#if !defined( KVS_PLATFORM_WINDOWS )
+#include <sys/uio.h>
+#include <sys/select.h>
+#endif
+
+
+namespace
+{
+
+const size_t MaxBuffers = 64; // max. number of the buffers written at once
+const size_t MaxEvents = 256; // max. number of the events received at once
+
+/*==========================================================================*/
+/**
+ *  @brief  Memory region to be sent.
+ */
+/*==========================================================================*/
+struct Buffer
+{
+    const void* data; ///< pointer to the data
+    size_t size; ///< byte size of the data
+};
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns true if the last socket call would block.
+ */
+/*==========================================================================*/
+bool WouldBlock()
+{
+#if defined( KVS_PLATFORM_WINDOWS )
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns true if the last socket call was interrupted by a signal.
+ */
+/*==========================================================================*/
+bool Interrupted()
+{
+#if defined( KVS_PLATFORM_WINDOWS )
+    return false;
+#else
+    return errno == EINTR;
+#endif
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Sets the socket options for streaming to the accepted socket.
+ *  @param  id [in] socket ID
+ *  @return true, if the socket is set to non-blocking mode
+ */
+/*==========================================================================*/
+bool SetupSocket( const kvs::Socket::id_type id )
+{
+    typedef kvs::Socket::option_type option_type;
+
+    // The frames are written at once, so that the Nagle's algorithm only
+    // delays the end of the frames.
+    int nodelay = 1;
+    ::setsockopt( id, IPPROTO_TCP, TCP_NODELAY, (const option_type*)&nodelay, sizeof( nodelay ) );
+
+    // Closing the socket of a slow client must not wait for the queued data.
+    struct linger linger_opt;
+    linger_opt.l_onoff = 0;
+    linger_opt.l_linger = 0;
+    ::setsockopt( id, SOL_SOCKET, SO_LINGER, (const option_type*)&linger_opt, sizeof( linger_opt ) );
+
+#if defined( SO_NOSIGPIPE )
+    int nosigpipe = 1;
+    ::setsockopt( id, SOL_SOCKET, SO_NOSIGPIPE, (const option_type*)&nosigpipe, sizeof( nosigpipe ) );
+#endif
+
+#if defined( KVS_PLATFORM_WINDOWS )
+    u_long flag = 1;
+    return ::ioctlsocket( id, FIONBIO, &flag ) != kvs::Socket::ErrorValue;
+#else
+    const int flags = ::fcntl( id, F_GETFL, 0 );
+    return flags != -1 && ::fcntl( id, F_SETFL, flags | O_NONBLOCK ) != -1;
+#endif
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Closes the socket.
+ *  @param  id [in] socket ID
+ */
+/*==========================================================================*/
+void CloseSocket( const kvs::Socket::id_type id )
+{
+#if defined( KVS_PLATFORM_WINDOWS )
+    ::closesocket( id );
+#else
+    ::close( id );
+#endif
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Writes the buffers to the non-blocking socket.
+ *  @param  id [in] socket ID
+ *  @param  buffers [in] buffers
+ *  @param  nbuffers [in] number of the buffers
+ *  @return number of the bytes written (0 if the socket is full), or -1 on error
+ */
+/*==========================================================================*/
+kvs::Int64 SendBuffers( const kvs::Socket::id_type id, const ::Buffer* buffers, const size_t nbuffers )
+{
+#if defined( KVS_PLATFORM_WINDOWS )
+    // Windows Sockets 1.1 has no gather write; the buffers are sent in turn.
+    kvs::Int64 total = 0;
+    for ( size_t i = 0; i < nbuffers; i++ )
+    {
+        const int size = static_cast<int>( std::min( buffers[i].size, size_t( 1 ) << 30 ) );
+        const int sent = ::send( id, static_cast<const char*>( buffers[i].data ), size, 0 );
+        if ( sent == kvs::Socket::ErrorValue )
+        {
+            if ( ::WouldBlock() ) { break; }
+            return total > 0 ? total : -1;
+        }
+        total += sent;
+        if ( sent < size ) { break; }
+    }
+    return total;
+#else
+    struct iovec vectors[ ::MaxBuffers ];
+    for ( size_t i = 0; i < nbuffers; i++ )
+    {
+        vectors[i].iov_base = const_cast<void*>( buffers[i].data );
+        vectors[i].iov_len = buffers[i].size;
+    }
+
+    // sendmsg is used instead of writev to suppress SIGPIPE on the closed socket.
+    struct msghdr message;
+    std::memset( &message, 0, sizeof( message ) );
+    message.msg_iov = vectors;
+    message.msg_iovlen = nbuffers;
+#if defined( MSG_NOSIGNAL )
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+
+    for ( ;; )
+    {
+        const ssize_t sent = ::sendmsg( id, &message, flags );
+        if ( sent >= 0 ) { return sent; }
+        if ( ::Interrupted() ) { continue; }
+        return ::WouldBlock() ? 0 : -1;
+    }
+#endif
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Encoded frame shared by the send queues of the clients.
+ */
+/*==========================================================================*/
+struct StreamServer::Packet
+{
+    kvs::ValueArray<kvs::UInt8> header; ///< header of the frame
+    std::vector<kvs::AnyValueArray> arrays; ///< arrays of the frame (not copied)
+    size_t size; ///< total byte size
+
+    /*======================================================================*/
+    /**
+     *  @brief  Returns the regions of the packet following the offset.
+     *  @param  offset [in] number of the bytes already sent
+     *  @param  buffers [out] pointer to the buffers
+     *  @param  max_nbuffers [in] max. number of the buffers
+     *  @return number of the buffers
+     */
+    /*======================================================================*/
+    size_t regions( size_t offset, ::Buffer* buffers, const size_t max_nbuffers ) const
+    {
+        size_t nbuffers = 0;
+        for ( size_t i = 0; i <= arrays.size() && nbuffers < max_nbuffers; i++ )
+        {
+            const void* data = i == 0 ? header.data() : arrays[ i - 1 ].data();
+            const size_t size = i == 0 ? header.byteSize() : arrays[ i - 1 ].byteSize();
+            if ( offset >= size ) { offset -= size; continue; }
+
+            buffers[ nbuffers ].data = static_cast<const kvs::UInt8*>( data ) + offset;
+            buffers[ nbuffers ].size = size - offset;
+            nbuffers++;
+            offset = 0;
+        }
+        return nbuffers;
+    }
+};
+
+/*==========================================================================*/
+/**
+ *  @brief  Connected client.
+ */
+/*==========================================================================*/
+struct StreamServer::Client
+{
+    kvs::Socket::id_type id; ///< socket ID
+    std::deque<PacketPointer> packets; ///< queued packets
+    size_t offset; ///< number of the bytes of the first packet already sent
+    size_t nbytes; ///< total byte size of the queued packets
+    bool waiting; ///< true, if the socket is watched for writing
+};
+
+/*==========================================================================*/
+/**
+ *  @brief  Event poller (epoll on Linux, select on the other platforms).
+ */
+/*==========================================================================*/
+class StreamServer::Poller
+{
+public:
+
+    struct Event
+    {
+        kvs::Socket::id_type id; ///< socket ID
+        bool readable; ///< true, if the socket is readable
+        bool writable; ///< true, if the socket is writable
+        bool error; ///< true, if the socket is hung up or has an error
+    };
+
+private:
+
+#if defined( KVS_PLATFORM_LINUX )
+    int m_epoll; ///< epoll instance
+#else
+    std::map<kvs::Socket::id_type,bool> m_ids; ///< watched sockets and write interests
+#endif
+
+public:
+
+#if defined( KVS_PLATFORM_LINUX )
+    Poller(): m_epoll( ::epoll_create1( EPOLL_CLOEXEC ) ) {}
+    ~Poller() { if ( m_epoll != -1 ) { ::close( m_epoll ); } }
+    bool isValid() const { return m_epoll != -1; }
+
+    bool add( const kvs::Socket::id_type id, const bool writable )
+    {
+        return this->control( EPOLL_CTL_ADD, id, writable );
+    }
+
+    bool modify( const kvs::Socket::id_type id, const bool writable )
+    {
+        return this->control( EPOLL_CTL_MOD, id, writable );
+    }
+
+    void remove( const kvs::Socket::id_type id )
+    {
+        struct epoll_event event;
+        std::memset( &event, 0, sizeof( event ) );
+        ::epoll_ctl( m_epoll, EPOLL_CTL_DEL, id, &event );
+    }
+
+    int wait( const int timeout_msec, std::vector<Event>* events )
+    {
+        struct epoll_event received[ ::MaxEvents ];
+        int nevents = 0;
+        do { nevents = ::epoll_wait( m_epoll, received, ::MaxEvents, timeout_msec ); }
+        while ( nevents == -1 && ::Interrupted() );
+
+        for ( int i = 0; i < nevents; i++ )
+        {
+            Event event;
+            event.id = received[i].data.fd;
+            event.readable = ( received[i].events & EPOLLIN ) != 0;
+            event.writable = ( received[i].events & EPOLLOUT ) != 0;
+            event.error = ( received[i].events & ( EPOLLERR | EPOLLHUP ) ) != 0;
+            events->push_back( event );
+        }
+        return nevents;
+    }
+
+private:
+
+    bool control( const int operation, const kvs::Socket::id_type id, const bool writable )
+    {
+        // The sockets are level-triggered; EPOLLOUT is watched only while the
+        // client has the queued data.
+        struct epoll_event event;
+        std::memset( &event, 0, sizeof( event ) );
+        event.events = EPOLLIN | ( writable ? EPOLLOUT : 0 );
+        event.data.fd = id;
+        return ::epoll_ctl( m_epoll, operation, id, &event ) != -1;
+    }
+#else
+    bool isValid() const { return true; }
+
+    bool add( const kvs::Socket::id_type id, const bool writable )
+    {
+        if ( m_ids.size() >= FD_SETSIZE ) { return false; }
+        m_ids[ id ] = writable;
+        return true;
+    }
+
+    bool modify( const kvs::Socket::id_type id, const bool writable )
+    {
+        m_ids[ id ] = writable;
+        return true;
+    }
+
+    void remove( const kvs::Socket::id_type id )
+    {
+        m_ids.erase( id );
+    }
+
+    int wait( const int timeout_msec, std::vector<Event>* events )
+    {
+        fd_set readable;
+        fd_set writable;
+        FD_ZERO( &readable );
+        FD_ZERO( &writable );
+        kvs::Socket::id_type max_id = 0;
+        std::map<kvs::Socket::id_type,bool>::const_iterator id = m_ids.begin();
+        while ( id != m_ids.end() )
+        {
+            FD_SET( id->first, &readable );
+            if ( id->second ) { FD_SET( id->first, &writable ); }
+            max_id = std::max( max_id, id->first );
+            ++id;
+        }
+
+        struct timeval timeout;
+        timeout.tv_sec = timeout_msec / 1000;
+        timeout.tv_usec = ( timeout_msec % 1000 ) * 1000;
+        const int nevents = ::select( int( max_id + 1 ), &readable, &writable, NULL, timeout_msec < 0 ? NULL : &timeout );
+        if ( nevents <= 0 ) { return nevents; }
+
+        for ( id = m_ids.begin(); id != m_ids.end(); ++id )
+        {
+            Event event;
+            event.id = id->first;
+            event.readable = FD_ISSET( id->first, &readable ) != 0;
+            event.writable = FD_ISSET( id->first, &writable ) != 0;
+            event.error = false;
+            if ( event.readable || event.writable ) { events->push_back( event ); }
+        }
+        return static_cast<int>( events->size() );
+    }
+#endif
+};
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new StreamServer class.
+ */
+/*==========================================================================*/
+StreamServer::StreamServer():
+    m_poller( 0 ),
+    m_max_queued_frames( 4 ),
+    m_max_queued_bytes( 64 * 1024 * 1024 ),
+    m_sequence( 0 ),
+    m_ndropped_frames( 0 )
+{
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new StreamServer class and opens the port.
+ *  @param  port [in] port number
+ *  @param  backlog [in] max. number of the pending connections
+ */
+/*==========================================================================*/
+StreamServer::StreamServer( const int port, const int backlog ):
+    m_poller( 0 ),
+    m_max_queued_frames( 4 ),
+    m_max_queued_bytes( 64 * 1024 * 1024 ),
+    m_sequence( 0 ),
+    m_ndropped_frames( 0 )
+{
+    this->open( port, backlog );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Destroys the StreamServer class.
+ */
+/*==========================================================================*/
+StreamServer::~StreamServer()
+{
+    this->close();
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Opens the port and starts listening.
+ *  @param  port [in] port number (0 for an ephemeral port)
+ *  @param  backlog [in] max. number of the pending connections
+ *  @return true, if the server is opened
+ */
+/*==========================================================================*/
+bool StreamServer::open( const int port, const int backlog )
+{
+    this->close();
+
+    m_server.setMaxConnections( backlog );
+    m_server.open();
+    if ( !m_server.isOpen() ||
+         m_server.bind( port ) == kvs::Socket::ErrorValue ||
+         !m_server.listen() )
+    {
+        kvsMessageError( "Cannot open the port %d.", port );
+        m_server.close();
+        return false;
+    }
+
+    m_server.disableBlocking();
+    m_poller = new Poller();
+    if ( !m_poller->isValid() || !m_poller->add( m_server.id(), false ) )
+    {
+        kvsMessageError( "Cannot create the event poller." );
+        this->close();
+        return false;
+    }
+
+    return true;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Disconnects all the clients and closes the port.
+ */
+/*==========================================================================*/
+void StreamServer::close()
+{
+    while ( !m_clients.empty() ) { this->disconnect( m_clients.begin()->second ); }
+
+    if ( m_poller )
+    {
+        delete m_poller;
+        m_poller = 0;
+    }
+
+    if ( m_server.isOpen() ) { m_server.close(); }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the port number which the server is listening on.
+ *  @return port number (-1 if the server is not opened)
+ */
+/*==========================================================================*/
+int StreamServer::port() const
+{
+    if ( !this->isOpen() ) { return -1; }
+
+    kvs::SocketAddress::address_type address;
+    kvs::SocketAddress::initialize( &address );
+    kvs::Socket::length_type length = sizeof( address );
+    if ( ::getsockname( m_server.id(), reinterpret_cast<sockaddr*>( &address ), &length ) != 0 ) { return -1; }
+
+    return ntohs( address.sin_port );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the number of the frames queued for all the clients.
+ *  @return number of the queued frames
+ */
+/*==========================================================================*/
+size_t StreamServer::numberOfQueuedFrames() const
+{
+    size_t nframes = 0;
+    Clients::const_iterator client = m_clients.begin();
+    while ( client != m_clients.end() )
+    {
+        nframes += client->second->packets.size();
+        ++client;
+    }
+    return nframes;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Sends the frame to all the clients.
+ *  @param  frame [in] frame
+ *  @return number of the clients which the frame is queued for
+ *
+ *  The arrays of the frame are referred by the send queues until they are
+ *  written to the sockets, so that they must not be modified in the
+ *  meantime (assign new arrays to the object or image instead).
+ */
+/*==========================================================================*/
+size_t StreamServer::send( const kvs::StreamFrame& frame )
+{
+    if ( !this->isOpen() ) { return 0; }
+
+    kvs::StreamFrame sequenced( frame );
+    sequenced.setSequence( ++m_sequence );
+    if ( m_clients.empty() ) { return 0; }
+
+    PacketPointer packet( new Packet() );
+    packet->header = sequenced.header();
+    packet->size = packet->header.byteSize();
+    for ( size_t i = 0; i < frame.numberOfArrays(); i++ )
+    {
+        packet->arrays.push_back( frame.array(i) );
+        packet->size += frame.array(i).byteSize();
+    }
+
+    std::vector<Client*> failed;
+    Clients::iterator client = m_clients.begin();
+    while ( client != m_clients.end() )
+    {
+        this->enqueue( client->second, packet );
+        if ( !this->flush( client->second ) ) { failed.push_back( client->second ); }
+        ++client;
+    }
+
+    for ( size_t i = 0; i < failed.size(); i++ ) { this->disconnect( failed[i] ); }
+
+    return m_clients.size();
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Sends the image to all the clients.
+ *  @param  image [in] color image
+ *  @return number of the clients which the image is queued for
+ */
+/*==========================================================================*/
+size_t StreamServer::send( const kvs::ColorImage& image )
+{
+    return this->send( kvs::StreamFrame( image ) );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Sends the object to all the clients.
+ *  @param  object [in] KVSB object
+ *  @return number of the clients which the object is queued for
+ */
+/*==========================================================================*/
+size_t StreamServer::send( const kvs::KVSBObject& object )
+{
+    return this->send( kvs::StreamFrame( object ) );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Waits for the events and handles them.
+ *  @param  timeout_msec [in] timeout in milliseconds (-1 for infinite)
+ *  @return number of the events, or -1 on error
+ *
+ *  The new clients are accepted, the queued frames are written to the
+ *  writable sockets, and the disconnected clients are removed.
+ */
+/*==========================================================================*/
+int StreamServer::poll( const int timeout_msec )
+{
+    if ( !this->isOpen() ) { return -1; }
+
+    std::vector<Poller::Event> events;
+    const int nevents = m_poller->wait( timeout_msec, &events );
+    for ( size_t i = 0; i < events.size(); i++ )
+    {
+        const Poller::Event& event = events[i];
+        if ( event.id == m_server.id() )
+        {
+            this->accept_clients();
+            continue;
+        }
+
+        Clients::iterator client = m_clients.find( event.id );
+        if ( client == m_clients.end() ) { continue; }
+
+        bool alive = !event.error;
+        if ( alive && event.readable ) { alive = this->discard_input( client->second ); }
+        if ( alive && event.writable ) { alive = this->flush( client->second ); }
+        if ( !alive ) { this->disconnect( client->second ); }
+    }
+
+    return nevents;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Accepts all the pending connections.
+ */
+/*==========================================================================*/
+void StreamServer::accept_clients()
+{
+    for ( ;; )
+    {
+        const kvs::Socket::id_type id = m_server.accept();
+        if ( id == kvs::Socket::InvalidID )
+        {
+            if ( ::Interrupted() ) { continue; }
+            break;
+        }
+
+        if ( !::SetupSocket( id ) || !m_poller->add( id, false ) )
+        {
+            ::CloseSocket( id );
+            continue;
+        }
+
+        Client* client = new Client();
+        client->id = id;
+        client->offset = 0;
+        client->nbytes = 0;
+        client->waiting = false;
+        m_clients[ id ] = client;
+    }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Puts the packet into the send queue of the client.
+ *  @param  client [in] client
+ *  @param  packet [in] packet
+ *
+ *  If the queue is full, the oldest packets are dropped except the packet
+ *  being sent, which cannot be dropped without breaking the stream.
+ */
+/*==========================================================================*/
+void StreamServer::enqueue( Client* client, const PacketPointer& packet )
+{
+    const size_t first = client->offset > 0 ? 1 : 0;
+    while ( client->packets.size() > first &&
+            ( client->packets.size() >= m_max_queued_frames ||
+              client->nbytes + packet->size > m_max_queued_bytes ) )
+    {
+        client->nbytes -= client->packets[ first ]->size;
+        client->packets.erase( client->packets.begin() + first );
+        m_ndropped_frames++;
+    }
+
+    client->packets.push_back( packet );
+    client->nbytes += packet->size;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Writes the queued packets to the socket until it is full.
+ *  @param  client [in] client
+ *  @return false, if the socket has an error
+ */
+/*==========================================================================*/
+bool StreamServer::flush( Client* client )
+{
+    while ( !client->packets.empty() )
+    {
+        ::Buffer buffers[ ::MaxBuffers ];
+        size_t nbuffers = 0;
+        size_t offset = client->offset;
+        for ( size_t i = 0; i < client->packets.size() && nbuffers < ::MaxBuffers; i++ )
+        {
+            nbuffers += client->packets[i]->regions( offset, buffers + nbuffers, ::MaxBuffers - nbuffers );
+            offset = 0;
+        }
+
+        const kvs::Int64 sent = ::SendBuffers( client->id, buffers, nbuffers );
+        if ( sent < 0 ) { return false; }
+        if ( sent == 0 ) { break; }
+
+        size_t remaining = static_cast<size_t>( sent );
+        while ( remaining > 0 )
+        {
+            const size_t size = client->packets.front()->size;
+            const size_t rest = size - client->offset;
+            if ( remaining < rest )
+            {
+                client->offset += remaining;
+                break;
+            }
+
+            remaining -= rest;
+            client->nbytes -= size;
+            client->offset = 0;
+            client->packets.pop_front();
+        }
+    }
+
+    // The socket is watched for writing only while the packets are left.
+    const bool waiting = !client->packets.empty();
+    if ( waiting != client->waiting )
+    {
+        if ( !m_poller->modify( client->id, waiting ) ) { return false; }
+        client->waiting = waiting;
+    }
+
+    return true;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Reads and discards the data sent from the client.
+ *  @param  client [in] client
+ *  @return false, if the client is disconnected
+ */
+/*==========================================================================*/
+bool StreamServer::discard_input( Client* client )
+{
+    char buffer[ 4096 ];
+    for ( ;; )
+    {
+        const int received = ::recv( client->id, buffer, sizeof( buffer ), 0 );
+        if ( received > 0 ) { continue; }
+        if ( received == 0 ) { return false; }
+        if ( ::Interrupted() ) { continue; }
+        return ::WouldBlock();
+    }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Closes the connection to the client.
+ *  @param  client [in] client
+ */
+/*==========================================================================*/
+void StreamServer::disconnect( Client* client )
+{
+    m_poller->remove( client->id );
+    ::CloseSocket( client->id );
+    m_clients.erase( client->id );
+    delete client;
+}
+
+} // end of namespace kvs
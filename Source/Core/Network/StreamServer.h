@@ -0,0 +1,95 @@
+/****************************************************************************/
+/**
+ *  @file   StreamServer.h
+ */
+/****************************************************************************/
+#ifndef KVS__STREAM_SERVER_H_INCLUDE
+#define KVS__STREAM_SERVER_H_INCLUDE
+
+#include <map>
+#include <kvs/SharedPointer>
+#include <kvs/ColorImage>
+#include <kvs/KVSBObject>
+#include "Socket.h"
+#include "TCPServer.h"
+#include "StreamFrame.h"
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Event-driven TCP server which streams the frames to the clients.
+ *
+ *  The sockets are non-blocking and multiplexed by epoll on Linux (select on
+ *  the other platforms). A frame is encoded once and shared by the send
+ *  queues of all the clients, and the header and the arrays are written by a
+ *  single scatter/gather call without copying. When a client cannot keep up,
+ *  the oldest frames in its queue which have not been started to send are
+ *  dropped, so that the slow client does not block the server or the others.
+ *
+ *  The server does not have its own thread; send() writes as much as the
+ *  socket buffers accept immediately, and poll() accepts the new clients
+ *  and writes the rest. Both should be called from the same thread.
+ */
+/*==========================================================================*/
+class StreamServer
+{
+protected:
+
+    class Poller;
+    struct Packet;
+    struct Client;
+    typedef kvs::SharedPointer<Packet> PacketPointer;
+    typedef std::map<kvs::Socket::id_type,Client*> Clients;
+
+    kvs::TCPServer m_server; ///< listening socket
+    Poller* m_poller; ///< event poller
+    Clients m_clients; ///< connected clients
+    size_t m_max_queued_frames; ///< max. number of the frames queued for a client
+    size_t m_max_queued_bytes; ///< max. byte size of the frames queued for a client
+    kvs::UInt64 m_sequence; ///< sequence number of the last frame
+    size_t m_ndropped_frames; ///< total number of the dropped frames
+
+public:
+
+    StreamServer();
+    StreamServer( const int port, const int backlog = 64 );
+    virtual ~StreamServer();
+
+    bool open( const int port, const int backlog = 64 );
+    void close();
+
+    bool isOpen() const { return m_poller != 0; }
+    int port() const;
+    size_t numberOfClients() const { return m_clients.size(); }
+    size_t maxQueuedFrames() const { return m_max_queued_frames; }
+    size_t maxQueuedBytes() const { return m_max_queued_bytes; }
+    kvs::UInt64 sequence() const { return m_sequence; }
+    size_t numberOfDroppedFrames() const { return m_ndropped_frames; }
+    size_t numberOfQueuedFrames() const;
+
+    void setMaxQueuedFrames( const size_t nframes ) { m_max_queued_frames = nframes; }
+    void setMaxQueuedBytes( const size_t nbytes ) { m_max_queued_bytes = nbytes; }
+
+    size_t send( const kvs::StreamFrame& frame );
+    size_t send( const kvs::ColorImage& image );
+    size_t send( const kvs::KVSBObject& object );
+    int poll( const int timeout_msec = 0 );
+
+private:
+
+    StreamServer( const StreamServer& );
+    StreamServer& operator =( const StreamServer& );
+
+    void accept_clients();
+    void enqueue( Client* client, const PacketPointer& packet );
+    bool flush( Client* client );
+    bool discard_input( Client* client );
+    void disconnect( Client* client );
+};
+
+} // end of namespace kvs
+
+#endif // KVS__STREAM_SERVER_H_INCLUDE
@@ -1775,6 +1775,15 @@ void VertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean norma
     KVS_GL_CALL( glVertexAttribPointer( index, size, type, normalized, stride, pointer ) );
 }
 
+void VertexAttribDivisor( GLuint index, GLuint divisor )
+{
+#if defined( KVS_PLATFORM_MACOSX ) && !defined( KVS_SUPPORT_OSMESA )
+    KVS_GL_CALL( glVertexAttribDivisorARB( index, divisor ) );
+#else
+    KVS_GL_CALL( glVertexAttribDivisor( index, divisor ) );
+#endif
+}
+
 void DrawArrays( GLenum mode, GLint first, GLsizei count )
 {
     KVS_GL_CALL( glDrawArrays( mode, first, count ) );
@@ -1796,6 +1805,15 @@ void MultiDrawArrays( GLenum mode, const kvs::ValueArray<GLint>& first, const kv
     kvs::OpenGL::MultiDrawArrays( mode, first.data(), count.data(), first.size() );
 }
 
+void DrawArraysInstanced( GLenum mode, GLint first, GLsizei count, GLsizei instancecount )
+{
+#if defined( KVS_PLATFORM_MACOSX ) && !defined( KVS_SUPPORT_OSMESA )
+    KVS_GL_CALL( glDrawArraysInstancedARB( mode, first, count, instancecount ) );
+#else
+    KVS_GL_CALL( glDrawArraysInstanced( mode, first, count, instancecount ) );
+#endif
+}
+
 void DrawElements( GLenum mode, GLsizei count, GLenum type, const GLvoid* indices )
 {
     KVS_GL_CALL( glDrawElements( mode, count, type, indices ) );
@@ -1817,6 +1835,15 @@ void MultiDrawElements( GLenum mode, const kvs::ValueArray<GLsizei>& count, GLen
     kvs::OpenGL::MultiDrawElements( mode, count.data(), type, indices, count.size() );
 }
 
+void DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instancecount )
+{
+#if defined( KVS_PLATFORM_MACOSX ) && !defined( KVS_SUPPORT_OSMESA )
+    KVS_GL_CALL( glDrawElementsInstancedARB( mode, count, type, indices, instancecount ) );
+#else
+    KVS_GL_CALL( glDrawElementsInstanced( mode, count, type, indices, instancecount ) );
+#endif
+}
+
 GLint Project(
     GLdouble objx,
     GLdouble objy,
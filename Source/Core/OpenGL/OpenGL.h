@@ -318,14 +318,17 @@ void ColorPointer( GLint size, GLenum type, GLsizei stride, const GLvoid* pointe
 void NormalPointer( GLenum type, GLsizei stride, const GLvoid* pointer );
 void TexCoordPointer( GLint size, GLenum type, GLsizei stride, const GLvoid* pointer );
 void VertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer );
+void VertexAttribDivisor( GLuint index, GLuint divisor );
 
 void DrawArrays( GLenum mode, GLint first, GLsizei count );
 void MultiDrawArrays( GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawcount );
 void MultiDrawArrays( GLenum mode, const kvs::ValueArray<GLint>& first, const kvs::ValueArray<GLsizei>& count );
+void DrawArraysInstanced( GLenum mode, GLint first, GLsizei count, GLsizei instancecount );
 
 void DrawElements( GLenum mode, GLsizei count, GLenum type, const GLvoid* indices );
 void MultiDrawElements( GLenum mode, const GLsizei* count, GLenum type, const GLvoid* const* indices, GLsizei drawcount );
 void MultiDrawElements( GLenum mode, const kvs::ValueArray<GLsizei>& count, GLenum type, const GLvoid* const* indices );
+void DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instancecount );
 
 GLint Project(
     GLdouble objx, GLdouble objy, GLdouble objz,
@@ -0,0 +1,307 @@
+/****************************************************************************/
+/**
+ *  @file   Parallel.h
+ */
+/****************************************************************************/
+#ifndef KVS__PARALLEL_H_INCLUDE
+#define KVS__PARALLEL_H_INCLUDE
+
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include "ThreadPool.h"
+#include "TaskGroup.h"
+
+
+namespace kvs
+{
+
+namespace detail
+{
+
+namespace parallel_impl
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the number of elements in a chunk.
+ *  @param  size [in] number of elements
+ *  @param  grain [in] minimum number of elements in a chunk
+ *  @param  nthreads [in] number of threads
+ *  @return number of elements in a chunk
+ */
+/*==========================================================================*/
+inline size_t ChunkSize( const size_t size, const size_t grain, const size_t nthreads )
+{
+    // A few chunks per thread balance the load between the threads.
+    const size_t nchunks = nthreads > 1 ? nthreads * 4 : 1;
+    const size_t chunk_size = ( size + nchunks - 1 ) / nchunks;
+    return std::max( chunk_size, std::max( grain, size_t( 1 ) ) );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Executes the function for each chunk by the threads in the pool.
+ *  @param  pool [in] thread pool
+ *  @param  nchunks [in] number of chunks
+ *  @param  function [in] function called with the chunk index
+ *
+ *  The chunks are distributed dynamically, and the calling thread executes
+ *  the chunks as well.
+ */
+/*==========================================================================*/
+template <typename Function>
+void ForEachChunk( kvs::ThreadPool& pool, const size_t nchunks, Function& function )
+{
+    const size_t ntasks = std::min( nchunks, pool.numberOfThreads() );
+    if ( ntasks <= 1 )
+    {
+        for ( size_t chunk = 0; chunk < nchunks; chunk++ ) { function( chunk ); }
+        return;
+    }
+
+    std::atomic<size_t> next( 0 );
+    auto body = [&]()
+    {
+        for ( size_t chunk = next++; chunk < nchunks; chunk = next++ ) { function( chunk ); }
+    };
+
+    kvs::TaskGroup group( pool );
+    for ( size_t i = 1; i < ntasks; i++ ) { group.run( body ); }
+    body();
+    group.wait();
+}
+
+} // end of namespace parallel_impl
+
+} // end of namespace detail
+
+/*==========================================================================*/
+/**
+ *  @brief  Executes the function for each index in parallel.
+ *  @param  pool [in] thread pool
+ *  @param  begin [in] first index
+ *  @param  end [in] last index (not included)
+ *  @param  function [in] function called with the index
+ *  @param  grain [in] minimum number of indices executed by a task
+ */
+/*==========================================================================*/
+template <typename Index, typename Function>
+void ParallelFor(
+    kvs::ThreadPool& pool,
+    const Index begin,
+    const Index end,
+    Function function,
+    const size_t grain = 1 )
+{
+    if ( !( begin < end ) ) { return; }
+
+    const size_t size = static_cast<size_t>( end - begin );
+    const size_t chunk_size = detail::parallel_impl::ChunkSize( size, grain, pool.numberOfThreads() );
+    const size_t nchunks = ( size + chunk_size - 1 ) / chunk_size;
+
+    auto chunk_function = [&]( const size_t chunk )
+    {
+        const Index first = begin + static_cast<Index>( chunk * chunk_size );
+        const Index last = begin + static_cast<Index>( std::min( ( chunk + 1 ) * chunk_size, size ) );
+        for ( Index i = first; i < last; ++i ) { function( i ); }
+    };
+
+    detail::parallel_impl::ForEachChunk( pool, nchunks, chunk_function );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Executes the function for each index in parallel by the default pool.
+ *  @param  begin [in] first index
+ *  @param  end [in] last index (not included)
+ *  @param  function [in] function called with the index
+ *  @param  grain [in] minimum number of indices executed by a task
+ */
+/*==========================================================================*/
+template <typename Index, typename Function>
+void ParallelFor(
+    const Index begin,
+    const Index end,
+    Function function,
+    const size_t grain = 1 )
+{
+    kvs::ParallelFor( kvs::ThreadPool::Default(), begin, end, function, grain );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Reduces the values given for each index in parallel.
+ *  @param  pool [in] thread pool
+ *  @param  begin [in] first index
+ *  @param  end [in] last index (not included)
+ *  @param  identity [in] identity value of the reduction
+ *  @param  function [in] function which returns the value for the index
+ *  @param  reduction [in] associative function which combines two values
+ *  @param  grain [in] minimum number of indices executed by a task
+ *  @return reduced value
+ *
+ *  The partial results of the chunks are combined in the order of the
+ *  indices, so that the result does not depend on the thread scheduling.
+ */
+/*==========================================================================*/
+template <typename Index, typename T, typename Function, typename Reduction>
+T ParallelReduce(
+    kvs::ThreadPool& pool,
+    const Index begin,
+    const Index end,
+    const T& identity,
+    Function function,
+    Reduction reduction,
+    const size_t grain = 1 )
+{
+    if ( !( begin < end ) ) { return identity; }
+
+    const size_t size = static_cast<size_t>( end - begin );
+    const size_t chunk_size = detail::parallel_impl::ChunkSize( size, grain, pool.numberOfThreads() );
+    const size_t nchunks = ( size + chunk_size - 1 ) / chunk_size;
+
+    std::vector<T> partials( nchunks, identity );
+    auto chunk_function = [&]( const size_t chunk )
+    {
+        const Index first = begin + static_cast<Index>( chunk * chunk_size );
+        const Index last = begin + static_cast<Index>( std::min( ( chunk + 1 ) * chunk_size, size ) );
+        T value = identity;
+        for ( Index i = first; i < last; ++i ) { value = reduction( value, function( i ) ); }
+        partials[ chunk ] = value;
+    };
+
+    detail::parallel_impl::ForEachChunk( pool, nchunks, chunk_function );
+
+    T value = identity;
+    for ( size_t chunk = 0; chunk < nchunks; chunk++ ) { value = reduction( value, partials[ chunk ] ); }
+    return value;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Reduces the values given for each index in parallel by the default pool.
+ *  @param  begin [in] first index
+ *  @param  end [in] last index (not included)
+ *  @param  identity [in] identity value of the reduction
+ *  @param  function [in] function which returns the value for the index
+ *  @param  reduction [in] associative function which combines two values
+ *  @param  grain [in] minimum number of indices executed by a task
+ *  @return reduced value
+ */
+/*==========================================================================*/
+template <typename Index, typename T, typename Function, typename Reduction>
+T ParallelReduce(
+    const Index begin,
+    const Index end,
+    const T& identity,
+    Function function,
+    Reduction reduction,
+    const size_t grain = 1 )
+{
+    return kvs::ParallelReduce( kvs::ThreadPool::Default(), begin, end, identity, function, reduction, grain );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Computes the prefix sums (scan) of the values in parallel.
+ *  @param  pool [in] thread pool
+ *  @param  input [in] pointer to the values
+ *  @param  output [out] pointer to the prefix sums (can be the same as input)
+ *  @param  size [in] number of values
+ *  @param  identity [in] identity value of the reduction
+ *  @param  reduction [in] associative function which combines two values
+ *  @param  inclusive [in] if true, output[i] includes input[i]
+ *  @return reduction of all the values
+ *
+ *  The values are scanned in two passes: the partial sums of the chunks are
+ *  computed in parallel, and then each chunk is scanned in parallel from the
+ *  prefix sum of the preceding chunks. The input values are converted to the
+ *  type of the output values.
+ */
+/*==========================================================================*/
+template <typename Input, typename T, typename Reduction>
+T ParallelScan(
+    kvs::ThreadPool& pool,
+    const Input* input,
+    T* output,
+    const size_t size,
+    const T& identity,
+    Reduction reduction,
+    const bool inclusive = false )
+{
+    if ( size == 0 ) { return identity; }
+
+    const size_t grain = 1024;
+    const size_t chunk_size = detail::parallel_impl::ChunkSize( size, grain, pool.numberOfThreads() );
+    const size_t nchunks = ( size + chunk_size - 1 ) / chunk_size;
+
+    std::vector<T> offsets( nchunks, identity );
+    if ( nchunks > 1 )
+    {
+        auto sum_function = [&]( const size_t chunk )
+        {
+            const size_t first = chunk * chunk_size;
+            const size_t last = std::min( first + chunk_size, size );
+            T value = identity;
+            for ( size_t i = first; i < last; i++ ) { value = reduction( value, static_cast<T>( input[i] ) ); }
+            offsets[ chunk ] = value;
+        };
+        detail::parallel_impl::ForEachChunk( pool, nchunks, sum_function );
+
+        T value = identity;
+        for ( size_t chunk = 0; chunk < nchunks; chunk++ )
+        {
+            const T sum = offsets[ chunk ];
+            offsets[ chunk ] = value;
+            value = reduction( value, sum );
+        }
+    }
+
+    std::vector<T> totals( nchunks, identity );
+    auto scan_function = [&]( const size_t chunk )
+    {
+        const size_t first = chunk * chunk_size;
+        const size_t last = std::min( first + chunk_size, size );
+        T value = offsets[ chunk ];
+        for ( size_t i = first; i < last; i++ )
+        {
+            const T next = reduction( value, static_cast<T>( input[i] ) );
+            output[i] = inclusive ? next : value;
+            value = next;
+        }
+        totals[ chunk ] = value;
+    };
+    detail::parallel_impl::ForEachChunk( pool, nchunks, scan_function );
+
+    return totals[ nchunks - 1 ];
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Computes the prefix sums (scan) of the values in parallel by the default pool.
+ *  @param  input [in] pointer to the values
+ *  @param  output [out] pointer to the prefix sums (can be the same as input)
+ *  @param  size [in] number of values
+ *  @param  identity [in] identity value of the reduction
+ *  @param  reduction [in] associative function which combines two values
+ *  @param  inclusive [in] if true, output[i] includes input[i]
+ *  @return reduction of all the values
+ */
+/*==========================================================================*/
+template <typename Input, typename T, typename Reduction>
+T ParallelScan(
+    const Input* input,
+    T* output,
+    const size_t size,
+    const T& identity,
+    Reduction reduction,
+    const bool inclusive = false )
+{
+    return kvs::ParallelScan( kvs::ThreadPool::Default(), input, output, size, identity, reduction, inclusive );
+}
+
+} // end of namespace kvs
+
+#endif // KVS__PARALLEL_H_INCLUDE
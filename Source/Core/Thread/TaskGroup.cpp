@@ -0,0 +1,100 @@
+/****************************************************************************/
+/**
+ *  @file   TaskGroup.cpp
+ */
+/****************************************************************************/
+#include "TaskGroup.h"
+#include <kvs/MutexLocker>
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new TaskGroup class executed by the default pool.
+ */
+/*==========================================================================*/
+TaskGroup::TaskGroup():
+    m_pool( &kvs::ThreadPool::Default() ),
+    m_ntasks( 0 )
+{
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new TaskGroup class.
+ *  @param  pool [in] thread pool
+ */
+/*==========================================================================*/
+TaskGroup::TaskGroup( kvs::ThreadPool& pool ):
+    m_pool( &pool ),
+    m_ntasks( 0 )
+{
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Destroys the TaskGroup class after all the tasks are completed.
+ */
+/*==========================================================================*/
+TaskGroup::~TaskGroup()
+{
+    try
+    {
+        this->wait();
+    }
+    catch ( ... )
+    {
+        // The exception thrown by the task is discarded here.
+    }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Adds a task to the group.
+ *  @param  task [in] task
+ */
+/*==========================================================================*/
+void TaskGroup::run( const Task& task )
+{
+    m_ntasks++;
+    m_pool->submit( task, this );
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Waits for all the tasks in the group while executing the tasks.
+ */
+/*==========================================================================*/
+void TaskGroup::wait()
+{
+    while ( m_ntasks.load() > 0 )
+    {
+        if ( m_pool->execute_one() ) { continue; }
+
+        // The remaining tasks are being executed by the other threads. The
+        // timeout allows to execute the tasks spawned by them in the meantime.
+        kvs::MutexLocker locker( &m_mutex );
+        if ( m_ntasks.load() > 0 ) { m_condition.wait( &m_mutex, 1 ); }
+    }
+
+    // The lock synchronizes with the last finish(), after which the group can
+    // be destroyed safely.
+    kvs::MutexLocker locker( &m_mutex );
+    if ( m_exception )
+    {
+        std::exception_ptr exception = m_exception;
+        m_exception = std::exception_ptr();
+        std::rethrow_exception( exception );
+    }
+}
+
+void TaskGroup::finish( std::exception_ptr exception )
+{
+    kvs::MutexLocker locker( &m_mutex );
+    if ( exception && !m_exception ) { m_exception = exception; }
+    if ( --m_ntasks == 0 ) { m_condition.wakeUpAll(); }
+}
+
+} // end of namespace kvs
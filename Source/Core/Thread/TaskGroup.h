@@ -0,0 +1,62 @@
+/****************************************************************************/
+/**
+ *  @file   TaskGroup.h
+ */
+/****************************************************************************/
+#ifndef KVS__TASK_GROUP_H_INCLUDE
+#define KVS__TASK_GROUP_H_INCLUDE
+
+#include <atomic>
+#include <exception>
+#include <kvs/Mutex>
+#include <kvs/Condition>
+#include "ThreadPool.h"
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Group of the tasks executed by the thread pool.
+ *
+ *  The tasks can be added from any thread, including the tasks in the same
+ *  group. wait() executes the queued tasks until all the tasks in the group
+ *  are completed, and rethrows the first exception thrown by the tasks.
+ */
+/*==========================================================================*/
+class TaskGroup
+{
+    friend class kvs::ThreadPool;
+
+public:
+    using Task = kvs::ThreadPool::Task;
+
+private:
+    kvs::ThreadPool* m_pool; ///< thread pool
+    std::atomic<size_t> m_ntasks; ///< number of the incomplete tasks
+    std::exception_ptr m_exception; ///< first exception thrown by the tasks
+    kvs::Mutex m_mutex; ///< mutex for the completion
+    kvs::Condition m_condition; ///< condition for the completion
+
+public:
+    TaskGroup();
+    TaskGroup( kvs::ThreadPool& pool );
+    ~TaskGroup();
+
+    kvs::ThreadPool& pool() { return *m_pool; }
+    bool isDone() const { return m_ntasks.load() == 0; }
+
+    void run( const Task& task );
+    void wait();
+
+private:
+    TaskGroup( const TaskGroup& );
+    TaskGroup& operator =( const TaskGroup& );
+
+    void finish( std::exception_ptr exception );
+};
+
+} // end of namespace kvs
+
+#endif // KVS__TASK_GROUP_H_INCLUDE
@@ -0,0 +1,297 @@
+/****************************************************************************/
+/**
+ *  @file   ThreadPool.cpp
+ */
+/****************************************************************************/
+#include "ThreadPool.h"
+#include "TaskGroup.h"
+#include <cstdlib>
+#include <memory>
+#include <exception>
+#include <kvs/Thread>
+#include <kvs/MutexLocker>
+#include <kvs/SystemInformation>
+#if defined ( KVS_PLATFORM_WINDOWS )
+#include <windows.h>
+#elif defined ( KVS_PLATFORM_LINUX )
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace
+{
+
+thread_local const kvs::ThreadPool* CurrentPool = NULL; ///< pool of the calling worker
+thread_local size_t CurrentIndex = 0; ///< queue index of the calling worker
+
+kvs::Mutex DefaultMutex; ///< mutex for the default pool
+size_t DefaultNumberOfThreads = 0; ///< number of threads of the default pool (0: auto)
+std::unique_ptr<kvs::ThreadPool> DefaultPool; ///< default pool
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Worker thread of the thread pool.
+ */
+/*==========================================================================*/
+class ThreadPool::Worker : public kvs::Thread
+{
+private:
+    kvs::ThreadPool* m_pool; ///< thread pool
+    size_t m_index; ///< index of the own queue
+
+public:
+    Worker( kvs::ThreadPool* pool, const size_t index ): m_pool( pool ), m_index( index ) {}
+
+    void run()
+    {
+        ::CurrentPool = m_pool;
+        ::CurrentIndex = m_index;
+        while ( !m_pool->m_exit.load() )
+        {
+            if ( !m_pool->execute_one() ) { m_pool->sleep(); }
+        }
+    }
+};
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the default thread pool.
+ *  @return default thread pool
+ */
+/*==========================================================================*/
+ThreadPool& ThreadPool::Default()
+{
+    kvs::MutexLocker locker( &::DefaultMutex );
+    if ( !::DefaultPool ) { ::DefaultPool.reset( new ThreadPool( ::DefaultNumberOfThreads ) ); }
+    return *::DefaultPool;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Sets the number of threads of the default thread pool.
+ *  @param  nthreads [in] number of threads (0: auto)
+ *
+ *  The default thread pool is re-created on the next use, so that this
+ *  method must not be called while the default pool is executing tasks.
+ */
+/*==========================================================================*/
+void ThreadPool::SetDefaultNumberOfThreads( const size_t nthreads )
+{
+    kvs::MutexLocker locker( &::DefaultMutex );
+    ::DefaultNumberOfThreads = nthreads;
+    ::DefaultPool.reset();
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the number of threads used for the pool by default.
+ *  @return number of threads
+ *
+ *  The number is given by SetDefaultNumberOfThreads, the environment
+ *  parameter KVS_NUM_THREADS, or the number of processors in this order.
+ */
+/*==========================================================================*/
+size_t ThreadPool::DefaultNumberOfThreads()
+{
+    if ( ::DefaultNumberOfThreads > 0 ) { return ::DefaultNumberOfThreads; }
+
+    const char* nthreads = std::getenv( "KVS_NUM_THREADS" );
+    if ( nthreads && std::atoi( nthreads ) > 0 ) { return size_t( std::atoi( nthreads ) ); }
+
+    const size_t nprocessors = kvs::SystemInformation::NumberOfProcessors();
+    return nprocessors > 0 ? nprocessors : 1;
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Constructs a new ThreadPool class.
+ *  @param  nthreads [in] number of threads including the waiting thread (0: default)
+ *  @param  affinity [in] affinity hint for the worker threads
+ */
+/*==========================================================================*/
+ThreadPool::ThreadPool( const size_t nthreads, const Affinity affinity ):
+    m_nthreads( nthreads > 0 ? nthreads : ThreadPool::DefaultNumberOfThreads() ),
+    m_affinity( affinity ),
+    m_ntasks( 0 ),
+    m_nsleepers( 0 ),
+    m_exit( false )
+{
+    const size_t nworkers = m_nthreads - 1;
+    for ( size_t i = 0; i < nworkers + 1; i++ ) { m_queues.push_back( new Queue() ); }
+    for ( size_t i = 0; i < nworkers; i++ )
+    {
+        Worker* worker = new Worker( this, i );
+        worker->start();
+        this->bind( worker, i );
+        m_workers.push_back( worker );
+    }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Destroys the ThreadPool class.
+ */
+/*==========================================================================*/
+ThreadPool::~ThreadPool()
+{
+    m_exit.store( true );
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        m_condition.wakeUpAll();
+    }
+
+    for ( size_t i = 0; i < m_workers.size(); i++ )
+    {
+        m_workers[i]->wait();
+        delete m_workers[i];
+    }
+
+    for ( size_t i = 0; i < m_queues.size(); i++ ) { delete m_queues[i]; }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Returns the index of the calling worker thread.
+ *  @return index of the worker thread (-1 if called outside of the pool)
+ */
+/*==========================================================================*/
+int ThreadPool::threadIndex() const
+{
+    return ::CurrentPool == this ? int( ::CurrentIndex ) : -1;
+}
+
+size_t ThreadPool::queue_index() const
+{
+    // The tasks from the outside of the pool are put into the shared queue.
+    return ::CurrentPool == this ? ::CurrentIndex : m_queues.size() - 1;
+}
+
+void ThreadPool::submit( const Task& task, kvs::TaskGroup* group )
+{
+    Queue* queue = m_queues[ this->queue_index() ];
+    {
+        kvs::MutexLocker locker( &queue->mutex );
+        Entry entry = { task, group };
+        queue->entries.push_back( entry );
+        m_ntasks++;
+    }
+
+    // The sleeping worker checks the number of the tasks after incrementing
+    // the number of the sleepers, so that the wake-up call is not lost.
+    if ( m_nsleepers.load() > 0 )
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        m_condition.wakeUpOne();
+    }
+}
+
+bool ThreadPool::execute_one()
+{
+    const size_t index = this->queue_index();
+
+    Entry entry;
+    if ( this->pop( index, &entry ) || this->steal( index, &entry ) )
+    {
+        this->execute( entry );
+        return true;
+    }
+
+    return false;
+}
+
+bool ThreadPool::pop( const size_t index, Entry* entry )
+{
+    Queue* queue = m_queues[ index ];
+    kvs::MutexLocker locker( &queue->mutex );
+    if ( queue->entries.empty() ) { return false; }
+
+    // The task spawned most recently is taken from the back.
+    *entry = queue->entries.back();
+    queue->entries.pop_back();
+    m_ntasks--;
+    return true;
+}
+
+bool ThreadPool::steal( const size_t index, Entry* entry )
+{
+    const size_t nqueues = m_queues.size();
+    for ( size_t i = 1; i < nqueues; i++ )
+    {
+        Queue* queue = m_queues[ ( index + i ) % nqueues ];
+        kvs::MutexLocker locker( &queue->mutex );
+        if ( queue->entries.empty() ) { continue; }
+
+        // The oldest task, which tends to be the largest, is stolen from the front.
+        *entry = queue->entries.front();
+        queue->entries.pop_front();
+        m_ntasks--;
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::execute( Entry& entry )
+{
+    std::exception_ptr exception;
+    try
+    {
+        entry.task();
+    }
+    catch ( ... )
+    {
+        exception = std::current_exception();
+    }
+
+    entry.group->finish( exception );
+}
+
+void ThreadPool::sleep()
+{
+    kvs::MutexLocker locker( &m_mutex );
+    m_nsleepers++;
+    if ( m_ntasks.load() == 0 && !m_exit.load() )
+    {
+        m_condition.wait( &m_mutex );
+    }
+    m_nsleepers--;
+}
+
+void ThreadPool::bind( Worker* worker, const size_t index )
+{
+    if ( m_affinity == NoAffinity ) { return; }
+
+    // The waiting thread, which is not bound, is regarded as the first thread.
+    // The scattered workers are spread evenly over the processor numbers, so
+    // that they are placed on the different sockets (NUMA nodes) as long as
+    // the processors are numbered contiguously on each socket.
+    const size_t nprocessors = kvs::SystemInformation::NumberOfProcessors();
+    if ( nprocessors == 0 ) { return; }
+
+    const size_t thread = index + 1;
+    const size_t processor = m_affinity == ScatterAffinity ?
+        ( thread * nprocessors / m_nthreads ) % nprocessors :
+        thread % nprocessors;
+
+#if defined ( KVS_PLATFORM_WINDOWS )
+    SetThreadAffinityMask( worker->handler(), DWORD_PTR( 1 ) << processor );
+#elif defined ( KVS_PLATFORM_LINUX )
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    CPU_SET( processor, &set );
+    pthread_setaffinity_np( worker->handler(), sizeof( set ), &set );
+#else
+    // Affinity is not supported on this platform.
+    (void)worker;
+    (void)processor;
+#endif
+}
+
+} // end of namespace kvs
@@ -0,0 +1,103 @@
+/****************************************************************************/
+/**
+ *  @file   ThreadPool.h
+ */
+/****************************************************************************/
+#ifndef KVS__THREAD_POOL_H_INCLUDE
+#define KVS__THREAD_POOL_H_INCLUDE
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <kvs/Mutex>
+#include <kvs/Condition>
+
+
+namespace kvs
+{
+
+class TaskGroup;
+
+/*==========================================================================*/
+/**
+ *  @brief  Work-stealing thread pool.
+ *
+ *  Each worker thread has its own task queue. A worker takes the tasks from
+ *  the back of its own queue (the tasks spawned most recently) and steals the
+ *  tasks from the front of the other queues when its own queue is empty. The
+ *  tasks submitted from the threads outside of the pool are put into a shared
+ *  queue. The thread waiting for a task group executes the tasks as well, so
+ *  that a pool of N threads has N-1 worker threads.
+ */
+/*==========================================================================*/
+class ThreadPool
+{
+    friend class kvs::TaskGroup;
+
+public:
+    using Task = std::function<void()>;
+
+    enum Affinity
+    {
+        NoAffinity = 0, ///< threads are scheduled by the OS
+        CompactAffinity, ///< i-th worker is bound to i-th processor
+        ScatterAffinity ///< workers are bound to processors spread over the machine
+    };
+
+private:
+    class Worker;
+
+    struct Entry
+    {
+        Task task; ///< task
+        kvs::TaskGroup* group; ///< task group to be notified on completion
+    };
+
+    struct Queue
+    {
+        kvs::Mutex mutex; ///< mutex for the entries
+        std::deque<Entry> entries; ///< task entries
+    };
+
+    size_t m_nthreads; ///< number of threads (including the waiting thread)
+    Affinity m_affinity; ///< affinity hint
+    std::vector<Queue*> m_queues; ///< queues of the workers and the shared queue (last)
+    std::vector<Worker*> m_workers; ///< worker threads
+    std::atomic<size_t> m_ntasks; ///< number of the queued tasks
+    std::atomic<size_t> m_nsleepers; ///< number of the sleeping workers
+    std::atomic<bool> m_exit; ///< exit flag for the workers
+    kvs::Mutex m_mutex; ///< mutex for sleeping
+    kvs::Condition m_condition; ///< condition for sleeping
+
+public:
+    static ThreadPool& Default();
+    static void SetDefaultNumberOfThreads( const size_t nthreads );
+    static size_t DefaultNumberOfThreads();
+
+public:
+    ThreadPool( const size_t nthreads = 0, const Affinity affinity = NoAffinity );
+    ~ThreadPool();
+
+    size_t numberOfThreads() const { return m_nthreads; }
+    Affinity affinity() const { return m_affinity; }
+    int threadIndex() const;
+
+private:
+    ThreadPool( const ThreadPool& );
+    ThreadPool& operator =( const ThreadPool& );
+
+    size_t queue_index() const;
+    void submit( const Task& task, kvs::TaskGroup* group );
+    bool execute_one();
+    bool pop( const size_t index, Entry* entry );
+    bool steal( const size_t index, Entry* entry );
+    void execute( Entry& entry );
+    void sleep();
+    void bind( Worker* worker, const size_t index );
+};
+
+} // end of namespace kvs
+
+#endif // KVS__THREAD_POOL_H_INCLUDE
@@ -8,6 +8,7 @@
 #include <kvs/Type>
 #include <string>
 #include <utility>
+#include <cstring>
 
 
 namespace kvs
@@ -102,12 +103,14 @@ inline void Endian::Swap8Bytes( void* value )
 /*===========================================================================*/
 inline void Endian::Swap2Bytes( void* values, size_t n )
 {
+    // NOTE: The bytes are swapped with shifts so that the loop is vectorized
+    // by the compiler.
     unsigned char* v = static_cast<unsigned char*>( values );
-    unsigned char* vend = v + n * 2;
-    while ( v != vend )
+    for ( size_t i = 0; i < n; i++, v += 2 )
     {
-        Swap2Bytes( v );
-        v += 2;
+        kvs::UInt16 x; std::memcpy( &x, v, 2 );
+        x = static_cast<kvs::UInt16>( ( x >> 8 ) | ( x << 8 ) );
+        std::memcpy( v, &x, 2 );
     }
 }
 
@@ -121,11 +124,11 @@ inline void Endian::Swap2Bytes( void* values, size_t n )
 inline void Endian::Swap4Bytes( void* values, size_t n )
 {
     unsigned char* v = static_cast<unsigned char*>( values );
-    unsigned char* vend = v + n * 4;
-    while ( v != vend )
+    for ( size_t i = 0; i < n; i++, v += 4 )
     {
-        Swap4Bytes( v );
-        v += 4;
+        kvs::UInt32 x; std::memcpy( &x, v, 4 );
+        x = ( x >> 24 ) | ( ( x >> 8 ) & 0x0000ff00u ) | ( ( x << 8 ) & 0x00ff0000u ) | ( x << 24 );
+        std::memcpy( v, &x, 4 );
     }
 }
 
@@ -139,11 +142,18 @@ inline void Endian::Swap4Bytes( void* values, size_t n )
 inline void Endian::Swap8Bytes( void* values, size_t n )
 {
     unsigned char* v = static_cast<unsigned char*>( values );
-    unsigned char* vend = v + n * 8;
-    while ( v != vend )
+    for ( size_t i = 0; i < n; i++, v += 8 )
     {
-        Swap8Bytes( v );
-        v += 8;
+        kvs::UInt64 x; std::memcpy( &x, v, 8 );
+        x = ( ( x >> 56 ) & 0x00000000000000ffull ) |
+            ( ( x >> 40 ) & 0x000000000000ff00ull ) |
+            ( ( x >> 24 ) & 0x0000000000ff0000ull ) |
+            ( ( x >>  8 ) & 0x00000000ff000000ull ) |
+            ( ( x <<  8 ) & 0x000000ff00000000ull ) |
+            ( ( x << 24 ) & 0x0000ff0000000000ull ) |
+            ( ( x << 40 ) & 0x00ff000000000000ull ) |
+            ( ( x << 56 ) & 0xff00000000000000ull );
+        std::memcpy( v, &x, 8 );
     }
 }
 
@@ -0,0 +1,463 @@
+/*****************************************************************************/
+/**
+ *  @file   Trace.cpp
+ */
+/*****************************************************************************/
+#include "Trace.h"
+#include <vector>
+#include <set>
+#include <fstream>
+#include <cstring>
+#include <chrono>
+#include <atomic>
+#include <kvs/Mutex>
+#include <kvs/MutexLocker>
+#include <kvs/Message>
+#include <kvs/Math>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Ring buffer of the events recorded by a thread.
+ */
+/*===========================================================================*/
+class Trace::Buffer
+{
+public:
+    int tid; ///< thread ID
+    size_t head; ///< index of the next event
+    size_t count; ///< number of recorded events
+    std::vector<Trace::Event> events; ///< events
+
+public:
+    Buffer( const int id, const size_t nevents ): tid( id ), head( 0 ), count( 0 ), events( nevents ) {}
+
+    Trace::Event& next()
+    {
+        Trace::Event& event = events[ head ];
+        event.tid = tid;
+        head = ( head + 1 ) % events.size();
+        if ( count < events.size() ) { count++; }
+        return event;
+    }
+
+    const Trace::Event& at( const size_t index ) const
+    {
+        const size_t first = ( head + events.size() - count ) % events.size();
+        return events[ ( first + index ) % events.size() ];
+    }
+
+    void clear() { head = 0; count = 0; }
+};
+
+} // end of namespace kvs
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Registry of the ring buffers of all the threads.
+ */
+/*===========================================================================*/
+struct Registry
+{
+    kvs::Mutex mutex; ///< mutex for the buffer list
+    std::vector<kvs::Trace::Buffer*> buffers; ///< buffers
+    std::vector<kvs::Trace::Buffer*> free_buffers; ///< buffers of the exited threads
+    size_t nevents; ///< number of events per buffer
+    int ntids; ///< number of the thread IDs given so far
+    int pid; ///< process ID written in the trace
+    std::atomic<bool> enabled; ///< recording flag
+
+    Registry(): nevents( 65536 ), ntids( 0 ), pid( 1 ), enabled( true ) {}
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the registry.
+ *  @return registry
+ *
+ *  The registry is never destroyed, since the thread-local buffer holders can
+ *  be destroyed after the static objects at the process exit.
+ */
+/*===========================================================================*/
+Registry& GetRegistry()
+{
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Holder of the buffer of a thread, which releases it when the thread exits.
+ */
+/*===========================================================================*/
+struct BufferHolder
+{
+    kvs::Trace::Buffer* buffer; ///< buffer of the thread
+
+    BufferHolder(): buffer( NULL ) {}
+    ~BufferHolder()
+    {
+        if ( buffer )
+        {
+            Registry& registry = GetRegistry();
+            kvs::MutexLocker locker( &registry.mutex );
+            registry.free_buffers.push_back( buffer );
+        }
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Copies the event name to the fixed-length buffer.
+ *  @param  dst [out] destination buffer
+ *  @param  src [in] event name
+ */
+/*===========================================================================*/
+void CopyName( char* dst, const char* src )
+{
+    const size_t n = kvs::Trace::MaxNameLength - 1;
+    std::strncpy( dst, src, n );
+    dst[n] = '\0';
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the string escaped for JSON.
+ *  @param  os [in] output stream
+ *  @param  str [in] string
+ */
+/*===========================================================================*/
+void WriteEscaped( std::ostream& os, const char* str )
+{
+    for ( const char* c = str; *c != '\0'; c++ )
+    {
+        switch ( *c )
+        {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if ( static_cast<unsigned char>( *c ) >= 0x20 ) { os << *c; }
+            break;
+        }
+    }
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Scope class and starts the span.
+ *  @param  name [in] span name (string literal or string alive until the scope ends)
+ */
+/*===========================================================================*/
+Trace::Scope::Scope( const char* name ):
+    m_name( Trace::IsEnabled() ? name : NULL ),
+    m_time( m_name ? Trace::Now() : 0 )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Scope class and starts the span.
+ *  @param  name [in] span name
+ */
+/*===========================================================================*/
+Trace::Scope::Scope( const std::string& name ):
+    m_name( NULL ),
+    m_time( 0 )
+{
+    if ( Trace::IsEnabled() )
+    {
+        m_buffer = name;
+        m_name = m_buffer.c_str();
+        m_time = Trace::Now();
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the Scope class and records the span.
+ */
+/*===========================================================================*/
+Trace::Scope::~Scope()
+{
+    if ( m_name )
+    {
+        Trace::AddSpan( m_name, m_time, Trace::Now() - m_time );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Enables or disables the recording at runtime.
+ *  @param  enable [in] if true, the events are recorded
+ */
+/*===========================================================================*/
+void Trace::SetEnabled( const bool enable )
+{
+    ::GetRegistry().enabled = enable;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the recording is enabled.
+ *  @return true if enabled
+ */
+/*===========================================================================*/
+bool Trace::IsEnabled()
+{
+    return ::GetRegistry().enabled;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the number of events kept per thread.
+ *  @param  nevents [in] number of events
+ *
+ *  The events recorded so far are discarded.
+ */
+/*===========================================================================*/
+void Trace::SetBufferSize( const size_t nevents )
+{
+    ::Registry& registry = ::GetRegistry();
+    kvs::MutexLocker locker( &registry.mutex );
+    registry.nevents = kvs::Math::Max( nevents, size_t( 1 ) );
+    for ( size_t i = 0; i < registry.buffers.size(); i++ )
+    {
+        registry.buffers[i]->events.resize( registry.nevents );
+        registry.buffers[i]->clear();
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of events kept per thread.
+ *  @return number of events
+ */
+/*===========================================================================*/
+size_t Trace::BufferSize()
+{
+    return ::GetRegistry().nevents;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the process ID written in the trace (e.g. MPI rank).
+ *  @param  pid [in] process ID
+ */
+/*===========================================================================*/
+void Trace::SetProcessID( const int pid )
+{
+    ::GetRegistry().pid = pid;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the process ID written in the trace.
+ *  @return process ID
+ */
+/*===========================================================================*/
+int Trace::ProcessID()
+{
+    return ::GetRegistry().pid;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the current time.
+ *  @return time in microseconds from the first call
+ */
+/*===========================================================================*/
+kvs::UInt64 Trace::Now()
+{
+    typedef std::chrono::steady_clock Clock;
+    static const Clock::time_point start = Clock::now();
+    return static_cast<kvs::UInt64>(
+        std::chrono::duration_cast<std::chrono::microseconds>( Clock::now() - start ).count() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Records a span.
+ *  @param  name [in] span name
+ *  @param  time [in] start time in microseconds
+ *  @param  duration [in] duration in microseconds
+ */
+/*===========================================================================*/
+void Trace::AddSpan( const char* name, const kvs::UInt64 time, const kvs::UInt64 duration )
+{
+    if ( !Trace::IsEnabled() ) { return; }
+
+    Trace::Event& event = Trace::ThreadBuffer()->next();
+    event.type = 'X';
+    ::CopyName( event.name, name );
+    event.time = time;
+    event.duration = duration;
+    event.value = 0.0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Records a counter value.
+ *  @param  name [in] counter name
+ *  @param  value [in] counter value
+ */
+/*===========================================================================*/
+void Trace::AddCounter( const char* name, const double value )
+{
+    if ( !Trace::IsEnabled() ) { return; }
+
+    Trace::Event& event = Trace::ThreadBuffer()->next();
+    event.type = 'C';
+    ::CopyName( event.name, name );
+    event.time = Trace::Now();
+    event.duration = 0;
+    event.value = value;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of events recorded by all the threads.
+ *  @return number of events
+ */
+/*===========================================================================*/
+size_t Trace::NumberOfEvents()
+{
+    ::Registry& registry = ::GetRegistry();
+    kvs::MutexLocker locker( &registry.mutex );
+    size_t nevents = 0;
+    for ( size_t i = 0; i < registry.buffers.size(); i++ )
+    {
+        nevents += registry.buffers[i]->count;
+    }
+    return nevents;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Discards the recorded events.
+ */
+/*===========================================================================*/
+void Trace::Clear()
+{
+    ::Registry& registry = ::GetRegistry();
+    kvs::MutexLocker locker( &registry.mutex );
+    for ( size_t i = 0; i < registry.buffers.size(); i++ )
+    {
+        registry.buffers[i]->clear();
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the recorded events to the file in the Chrome trace format.
+ *  @param  filename [in] output filename
+ *  @return true if the file is written successfully
+ */
+/*===========================================================================*/
+bool Trace::Write( const std::string& filename )
+{
+    std::ofstream ofs( filename.c_str() );
+    if ( !ofs.is_open() )
+    {
+        kvsMessageError( "Cannot open %s.", filename.c_str() );
+        return false;
+    }
+
+    Trace::Write( ofs );
+    return ofs.good();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the recorded events in the Chrome trace format.
+ *  @param  os [in] output stream
+ */
+/*===========================================================================*/
+void Trace::Write( std::ostream& os )
+{
+    ::Registry& registry = ::GetRegistry();
+    kvs::MutexLocker locker( &registry.mutex );
+
+    const int pid = registry.pid;
+    const char* delimiter = "\n";
+    os << "{\"traceEvents\":[";
+    for ( size_t i = 0; i < registry.buffers.size(); i++ )
+    {
+        // The reused buffer can have the events of the previous threads.
+        const Trace::Buffer* buffer = registry.buffers[i];
+        std::set<int> tids;
+        tids.insert( buffer->tid );
+        for ( size_t j = 0; j < buffer->count; j++ ) { tids.insert( buffer->at( j ).tid ); }
+        for ( std::set<int>::const_iterator tid = tids.begin(); tid != tids.end(); ++tid )
+        {
+            os << delimiter << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+               << ",\"tid\":" << *tid
+               << ",\"args\":{\"name\":\"Thread " << *tid << "\"}}";
+            delimiter = ",\n";
+        }
+
+        for ( size_t j = 0; j < buffer->count; j++ )
+        {
+            const Trace::Event& event = buffer->at( j );
+            os << delimiter << "{\"name\":\"";
+            ::WriteEscaped( os, event.name );
+            os << "\",\"cat\":\"kvs\",\"ph\":\"" << event.type << "\""
+               << ",\"ts\":" << event.time
+               << ",\"pid\":" << pid
+               << ",\"tid\":" << event.tid;
+            if ( event.type == 'X' ) { os << ",\"dur\":" << event.duration; }
+            if ( event.type == 'C' ) { os << ",\"args\":{\"value\":" << event.value << "}"; }
+            os << "}";
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the ring buffer of the calling thread.
+ *  @return pointer to the buffer (assigned at the first call)
+ *
+ *  The buffer released by an exited thread is reused if any, so that the
+ *  memory is bounded by the number of the threads recording at the same time.
+ *  The calling thread is given a new thread ID even if the buffer is reused,
+ *  and the events recorded by the exited thread are kept with its own ID.
+ */
+/*===========================================================================*/
+Trace::Buffer* Trace::ThreadBuffer()
+{
+    static thread_local ::BufferHolder holder;
+    if ( !holder.buffer )
+    {
+        ::Registry& registry = ::GetRegistry();
+        kvs::MutexLocker locker( &registry.mutex );
+        if ( !registry.free_buffers.empty() )
+        {
+            holder.buffer = registry.free_buffers.back();
+            holder.buffer->tid = registry.ntids++;
+            registry.free_buffers.pop_back();
+        }
+        else
+        {
+            holder.buffer = new Trace::Buffer( registry.ntids++, registry.nevents );
+            registry.buffers.push_back( holder.buffer );
+        }
+    }
+    return holder.buffer;
+}
+
+} // end of namespace kvs
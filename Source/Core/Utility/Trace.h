@@ -0,0 +1,124 @@
+/*****************************************************************************/
+/**
+ *  @file   Trace.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <ostream>
+#include <kvs/Type>
+#include <kvs/Macro>
+
+
+/* Scoped tracing macros. The spans and counters are recorded only when KVS is
+ * built with 'KVS_ENABLE_TRACE' (KVS_ENABLE_TRACE = 1 in kvs.conf), otherwise
+ * the macros are expanded to nothing.
+ *
+ * void Foo()
+ * {
+ *     KVS_TRACE_FUNCTION();
+ *     {
+ *         KVS_TRACE_SCOPE( "Foo::Loop" );
+ *         ...
+ *         KVS_TRACE_COUNTER( "Foo::NumberOfTriangles", ntriangles );
+ *     }
+ * }
+ */
+#define KVS_TRACE_CONCAT_( a, b ) a ## b
+#define KVS_TRACE_CONCAT( a, b ) KVS_TRACE_CONCAT_( a, b )
+
+#if defined ( KVS_ENABLE_TRACE )
+#define KVS_TRACE_SCOPE( name ) kvs::Trace::Scope KVS_TRACE_CONCAT( kvs_trace_scope_, __LINE__ )( name )
+#define KVS_TRACE_FUNCTION() KVS_TRACE_SCOPE( KVS_MACRO_FUNC )
+#define KVS_TRACE_COUNTER( name, value ) kvs::Trace::AddCounter( name, static_cast<double>( value ) )
+#else
+#define KVS_TRACE_SCOPE( name )
+#define KVS_TRACE_FUNCTION()
+#define KVS_TRACE_COUNTER( name, value )
+#endif
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Trace class.
+ *
+ *  The spans and the counters are recorded to the ring buffer of the calling
+ *  thread without any locks, and the oldest events are overwritten when the
+ *  buffer is full. The span is recorded as a complete event when the scope is
+ *  closed, so that the nested spans are kept consistent after overwriting.
+ *  The buffer of an exited thread is reused by the thread created later, and
+ *  the events of the later thread are written with a new thread ID.
+ *  The recorded events can be written in the Chrome trace event format
+ *  (JSON), which can be loaded by chrome://tracing or Perfetto UI.
+ *
+ *  Write() and Clear() should be called while the other threads are not
+ *  recording the events.
+ */
+/*===========================================================================*/
+class Trace
+{
+public:
+    class Buffer;
+
+    enum { MaxNameLength = 64 };
+
+    struct Event
+    {
+        char type; ///< event type ('X': span, 'C': counter)
+        int tid; ///< ID of the thread which recorded the event
+        char name[ MaxNameLength ]; ///< event name
+        kvs::UInt64 time; ///< start time in microseconds
+        kvs::UInt64 duration; ///< duration in microseconds (span)
+        double value; ///< value (counter)
+    };
+
+    /*=======================================================================*/
+    /**
+     *  @brief  Scope class that records a span from construction to destruction.
+     */
+    /*=======================================================================*/
+    class Scope
+    {
+    private:
+        const char* m_name; ///< span name (NULL if not recorded)
+        std::string m_buffer; ///< copy of the span name given as a string
+        kvs::UInt64 m_time; ///< start time in microseconds
+
+    public:
+        Scope( const char* name );
+        Scope( const std::string& name );
+        ~Scope();
+
+    private:
+        Scope( const Scope& );
+        Scope& operator = ( const Scope& );
+    };
+
+public:
+    static void SetEnabled( const bool enable );
+    static void Enable() { SetEnabled( true ); }
+    static void Disable() { SetEnabled( false ); }
+    static bool IsEnabled();
+
+    static void SetBufferSize( const size_t nevents );
+    static size_t BufferSize();
+    static void SetProcessID( const int pid );
+    static int ProcessID();
+
+    static kvs::UInt64 Now();
+    static void AddSpan( const char* name, const kvs::UInt64 time, const kvs::UInt64 duration );
+    static void AddCounter( const char* name, const double value );
+
+    static size_t NumberOfEvents();
+    static void Clear();
+    static bool Write( const std::string& filename );
+    static void Write( std::ostream& os );
+
+private:
+    static Buffer* ThreadBuffer();
+};
+
+} // end of namespace kvs
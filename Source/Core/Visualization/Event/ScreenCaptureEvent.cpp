@@ -26,7 +26,8 @@ ScreenCaptureEvent::ScreenCaptureEvent( const int key ):
     m_key( key ),
     m_filename( "" ),
     m_basename( "screenshot" ),
-    m_capture_func( nullptr )
+    m_capture_func( nullptr ),
+    m_enable_asynchronous( false )
 {
 }
 
@@ -41,7 +42,9 @@ ScreenCaptureEvent::ScreenCaptureEvent( CaptureFunc func, const int key ):
     m_key( key ),
     m_filename( "" ),
     m_basename( "screenshot" ),
-    m_capture_func( func )
+    m_capture_func( func ),
+    m_enable_asynchronous( false ),
+    m_frame_capture( func )
 {
 }
 
@@ -58,6 +61,14 @@ void ScreenCaptureEvent::update( kvs::KeyEvent* event )
     if ( event->key() == m_key )
     {
         auto image = scene()->camera()->snapshot();
+        if ( m_enable_asynchronous )
+        {
+            // The image is written and passed to the capture function in the
+            // encoder threads of the frame capture.
+            m_frame_capture.push( image, m_capture_func ? "" : this->output_filename() );
+            return;
+        }
+
         if ( m_capture_func ) { m_capture_func( image ); }
         else { image.write( this->output_filename() ); }
     }
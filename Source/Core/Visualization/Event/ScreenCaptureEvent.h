@@ -9,6 +9,7 @@
 #include <string>
 #include <functional>
 #include <kvs/ColorImage>
+#include <kvs/FrameCapture>
 
 
 namespace kvs
@@ -29,6 +30,8 @@ private:
     std::string m_filename; ///< filename of captured image
     std::string m_basename; ///< basename of captured image
     CaptureFunc m_capture_func;
+    bool m_enable_asynchronous; ///< if true, images are written by the encoder threads
+    kvs::FrameCapture m_frame_capture; ///< frame capture for asynchronous writing
 
 public:
     ScreenCaptureEvent( const int key = kvs::Key::s );
@@ -37,7 +40,13 @@ public:
     void setKey( const int key ) { m_key = key; }
     void setFilename( const std::string& filename ) { m_filename = filename; }
     void setBasename( const std::string& basename ) { m_basename = basename; }
-    void update( CaptureFunc func ) { m_capture_func = func; }
+    void setEnabledAsynchronous( const bool enable ) { m_enable_asynchronous = enable; }
+    void enableAsynchronous() { this->setEnabledAsynchronous( true ); }
+    void disableAsynchronous() { this->setEnabledAsynchronous( false ); }
+    bool isEnabledAsynchronous() const { return m_enable_asynchronous; }
+    kvs::FrameCapture& frameCapture() { return m_frame_capture; }
+    const kvs::FrameCapture& frameCapture() const { return m_frame_capture; }
+    void update( CaptureFunc func ) { m_capture_func = func; m_frame_capture.update( func ); }
     void update( kvs::KeyEvent* event );
 
 private:
@@ -72,4 +72,64 @@ kvs::KVSMLLineObject* LineExporter<kvs::KVSMLLineObject>::exec( const kvs::Objec
     return this;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new LineExporter class for KVSBObject format.
+ *  @param  object [in] pointer to the input line object
+ */
+/*===========================================================================*/
+LineExporter<kvs::KVSBObject>::LineExporter( const kvs::LineObject* object )
+{
+    this->exec( object );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the export process.
+ *  @param  object [in] pointer to the input object
+ *  @return pointer to the KVSBObject format
+ *
+ *  The arrays of the object are shared with the KVSBObject without copying.
+ */
+/*===========================================================================*/
+kvs::KVSBObject* LineExporter<kvs::KVSBObject>::exec( const kvs::ObjectBase* object )
+{
+    BaseClass::setSuccess( true );
+
+    if ( !object )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is NULL.");
+        return NULL;
+    }
+
+    const kvs::LineObject* line = kvs::LineObject::DownCast( object );
+    if ( !line )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is not line object.");
+        return NULL;
+    }
+
+    this->setObjectType( "LineObject" );
+    if ( line->name() != "" ) { this->setAttribute( "name", line->name() ); }
+    if ( line->hasMinMaxObjectCoords() )
+    {
+        this->setMinMaxObjectCoords( line->minObjectCoord(), line->maxObjectCoord() );
+    }
+    if ( line->hasMinMaxExternalCoords() )
+    {
+        this->setMinMaxExternalCoords( line->minExternalCoord(), line->maxExternalCoord() );
+    }
+
+    this->setAttribute( "line_type", int( line->lineType() ) );
+    this->setAttribute( "color_type", int( line->colorType() ) );
+    this->setArray( "coords", line->coords() );
+    this->setArray( "colors", line->colors() );
+    this->setArray( "connections", line->connections() );
+    this->setArray( "sizes", line->sizes() );
+
+    return this;
+}
+
 } // end of namespace kvs
@@ -7,6 +7,7 @@
 #pragma once
 #include <kvs/LineObject>
 #include <kvs/KVSMLLineObject>
+#include <kvs/KVSBObject>
 #include "ExporterBase.h"
 
 
@@ -43,4 +44,19 @@ public:
     kvs::KVSMLLineObject* exec( const kvs::ObjectBase* object );
 };
 
+/*===========================================================================*/
+/**
+ *  @brief  Line exporter class as KVSBObject format.
+ */
+/*===========================================================================*/
+template <>
+class LineExporter<kvs::KVSBObject> :
+        public kvs::ExporterBase,
+        public kvs::KVSBObject
+{
+public:
+    LineExporter( const kvs::LineObject* object );
+    kvs::KVSBObject* exec( const kvs::ObjectBase* object );
+};
+
 } // end of namespace kvs
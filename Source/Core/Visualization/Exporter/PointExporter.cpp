@@ -56,4 +56,62 @@ kvs::KVSMLPointObject* PointExporter<kvs::KVSMLPointObject>::exec( const kvs::Ob
     return this;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new PointExporter class for KVSBObject format.
+ *  @param  object [in] pointer to the input point object
+ */
+/*===========================================================================*/
+PointExporter<kvs::KVSBObject>::PointExporter( const kvs::PointObject* object )
+{
+    this->exec( object );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the export process.
+ *  @param  object [in] pointer to the input object
+ *  @return pointer to the KVSBObject format
+ *
+ *  The arrays of the object are shared with the KVSBObject without copying.
+ */
+/*===========================================================================*/
+kvs::KVSBObject* PointExporter<kvs::KVSBObject>::exec( const kvs::ObjectBase* object )
+{
+    BaseClass::setSuccess( true );
+
+    if ( !object )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is NULL.");
+        return NULL;
+    }
+
+    const kvs::PointObject* point = kvs::PointObject::DownCast( object );
+    if ( !point )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is not point object.");
+        return NULL;
+    }
+
+    this->setObjectType( "PointObject" );
+    if ( point->name() != "" ) { this->setAttribute( "name", point->name() ); }
+    if ( point->hasMinMaxObjectCoords() )
+    {
+        this->setMinMaxObjectCoords( point->minObjectCoord(), point->maxObjectCoord() );
+    }
+    if ( point->hasMinMaxExternalCoords() )
+    {
+        this->setMinMaxExternalCoords( point->minExternalCoord(), point->maxExternalCoord() );
+    }
+
+    this->setArray( "coords", point->coords() );
+    this->setArray( "colors", point->colors() );
+    this->setArray( "normals", point->normals() );
+    this->setArray( "sizes", point->sizes() );
+
+    return this;
+}
+
 } // end of namespace kvs
@@ -7,6 +7,7 @@
 #pragma once
 #include <kvs/PointObject>
 #include <kvs/KVSMLPointObject>
+#include <kvs/KVSBObject>
 #include "ExporterBase.h"
 
 
@@ -43,4 +44,19 @@ public:
     kvs::KVSMLPointObject* exec( const kvs::ObjectBase* object );
 };
 
+/*===========================================================================*/
+/**
+ *  @brief  Point exporter class as KVSBObject format.
+ */
+/*===========================================================================*/
+template <>
+class PointExporter<kvs::KVSBObject> :
+        public kvs::ExporterBase,
+        public kvs::KVSBObject
+{
+public:
+    PointExporter( const kvs::PointObject* object );
+    kvs::KVSBObject* exec( const kvs::ObjectBase* object );
+};
+
 } // end of namespace kvs
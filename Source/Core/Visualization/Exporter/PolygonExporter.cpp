@@ -394,4 +394,66 @@ kvs::Ply* PolygonExporter<kvs::Ply>::exec( const kvs::ObjectBase* object )
     return this;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new PolygonExporter class for KVSBObject format.
+ *  @param  object [in] pointer to the input polygon object
+ */
+/*===========================================================================*/
+PolygonExporter<kvs::KVSBObject>::PolygonExporter( const kvs::PolygonObject* object )
+{
+    this->exec( object );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the export process.
+ *  @param  object [in] pointer to the input object
+ *  @return pointer to the KVSBObject format
+ *
+ *  The arrays of the object are shared with the KVSBObject without copying.
+ */
+/*===========================================================================*/
+kvs::KVSBObject* PolygonExporter<kvs::KVSBObject>::exec( const kvs::ObjectBase* object )
+{
+    BaseClass::setSuccess( true );
+
+    if ( !object )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is NULL.");
+        return NULL;
+    }
+
+    const kvs::PolygonObject* polygon = kvs::PolygonObject::DownCast( object );
+    if ( !polygon )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is not polygon object.");
+        return NULL;
+    }
+
+    this->setObjectType( "PolygonObject" );
+    if ( polygon->name() != "" ) { this->setAttribute( "name", polygon->name() ); }
+    if ( polygon->hasMinMaxObjectCoords() )
+    {
+        this->setMinMaxObjectCoords( polygon->minObjectCoord(), polygon->maxObjectCoord() );
+    }
+    if ( polygon->hasMinMaxExternalCoords() )
+    {
+        this->setMinMaxExternalCoords( polygon->minExternalCoord(), polygon->maxExternalCoord() );
+    }
+
+    this->setAttribute( "polygon_type", int( polygon->polygonType() ) );
+    this->setAttribute( "color_type", int( polygon->colorType() ) );
+    this->setAttribute( "normal_type", int( polygon->normalType() ) );
+    this->setArray( "coords", polygon->coords() );
+    this->setArray( "colors", polygon->colors() );
+    this->setArray( "normals", polygon->normals() );
+    this->setArray( "connections", polygon->connections() );
+    this->setArray( "opacities", polygon->opacities() );
+
+    return this;
+}
+
 } // end of namespace kvs
@@ -7,6 +7,7 @@
 #pragma once
 #include <kvs/PolygonObject>
 #include <kvs/KVSMLPolygonObject>
+#include <kvs/KVSBObject>
 #include <kvs/Stl>
 #include <kvs/Ply>
 #include "ExporterBase.h"
@@ -75,4 +76,19 @@ public:
     kvs::Ply* exec( const kvs::ObjectBase* object );
 };
 
+/*===========================================================================*/
+/**
+ *  @brief  Polygon exporter class as KVSBObject format.
+ */
+/*===========================================================================*/
+template <>
+class PolygonExporter<kvs::KVSBObject> :
+        public kvs::ExporterBase,
+        public kvs::KVSBObject
+{
+public:
+    PolygonExporter( const kvs::PolygonObject* object );
+    kvs::KVSBObject* exec( const kvs::ObjectBase* object );
+};
+
 } // end of namespace kvs
@@ -228,4 +228,74 @@ kvs::AVSField* StructuredVolumeExporter<kvs::AVSField>::exec(
     return this;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new StructuredVolumeExporter class for KVSBObject format.
+ *  @param  object [in] pointer to the input structured volume object
+ */
+/*===========================================================================*/
+StructuredVolumeExporter<kvs::KVSBObject>::StructuredVolumeExporter( const kvs::StructuredVolumeObject* object )
+{
+    this->exec( object );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the export process.
+ *  @param  object [in] pointer to the input object
+ *  @return pointer to the KVSBObject format
+ *
+ *  The arrays of the object are shared with the KVSBObject without copying.
+ */
+/*===========================================================================*/
+kvs::KVSBObject* StructuredVolumeExporter<kvs::KVSBObject>::exec( const kvs::ObjectBase* object )
+{
+    BaseClass::setSuccess( true );
+
+    if ( !object )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is NULL.");
+        return NULL;
+    }
+
+    const kvs::StructuredVolumeObject* volume = kvs::StructuredVolumeObject::DownCast( object );
+    if ( !volume )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is not structured volume object.");
+        return NULL;
+    }
+
+    this->setObjectType( "StructuredVolumeObject" );
+    if ( volume->name() != "" ) { this->setAttribute( "name", volume->name() ); }
+    if ( volume->hasMinMaxObjectCoords() )
+    {
+        this->setMinMaxObjectCoords( volume->minObjectCoord(), volume->maxObjectCoord() );
+    }
+    if ( volume->hasMinMaxExternalCoords() )
+    {
+        this->setMinMaxExternalCoords( volume->minExternalCoord(), volume->maxExternalCoord() );
+    }
+
+    const kvs::Vec3ui& resolution = volume->resolution();
+    if ( volume->label() != "" ) { this->setAttribute( "label", volume->label() ); }
+    if ( volume->unit() != "" ) { this->setAttribute( "unit", volume->unit() ); }
+    this->setAttribute( "grid_type", int( volume->gridType() ) );
+    this->setAttribute( "resolution",
+        kvs::String::From( resolution.x() ) + " " +
+        kvs::String::From( resolution.y() ) + " " +
+        kvs::String::From( resolution.z() ) );
+    this->setAttribute( "veclen", volume->veclen() );
+    this->setArray( "values", volume->values() );
+    this->setArray( "coords", volume->coords() );
+
+    if ( volume->hasMinMaxValues() )
+    {
+        this->setMinMaxValues( volume->minValue(), volume->maxValue() );
+    }
+
+    return this;
+}
+
 } // end of namespace kvs
@@ -8,6 +8,7 @@
 #include <kvs/ObjectBase>
 #include <kvs/StructuredVolumeObject>
 #include <kvs/KVSMLStructuredVolumeObject>
+#include <kvs/KVSBObject>
 #include <kvs/AVSField>
 #include <kvs/ExporterBase>
 
@@ -60,4 +61,19 @@ public:
     kvs::AVSField* exec( const kvs::ObjectBase* object );
 };
 
+/*===========================================================================*/
+/**
+ *  @brief  Structured volume exporter class as KVSBObject format.
+ */
+/*===========================================================================*/
+template <>
+class StructuredVolumeExporter<kvs::KVSBObject> :
+        public kvs::ExporterBase,
+        public kvs::KVSBObject
+{
+public:
+    StructuredVolumeExporter( const kvs::StructuredVolumeObject* object );
+    kvs::KVSBObject* exec( const kvs::ObjectBase* object );
+};
+
 } // end of namespace kvs
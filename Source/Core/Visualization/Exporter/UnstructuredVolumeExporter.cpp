@@ -218,4 +218,72 @@ kvs::AVSUcd* UnstructuredVolumeExporter<kvs::AVSUcd>::exec(
     return this;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new UnstructuredVolumeExporter class for KVSBObject format.
+ *  @param  object [in] pointer to the input unstructured volume object
+ */
+/*===========================================================================*/
+UnstructuredVolumeExporter<kvs::KVSBObject>::UnstructuredVolumeExporter( const kvs::UnstructuredVolumeObject* object )
+{
+    this->exec( object );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the export process.
+ *  @param  object [in] pointer to the input object
+ *  @return pointer to the KVSBObject format
+ *
+ *  The arrays of the object are shared with the KVSBObject without copying.
+ */
+/*===========================================================================*/
+kvs::KVSBObject* UnstructuredVolumeExporter<kvs::KVSBObject>::exec( const kvs::ObjectBase* object )
+{
+    BaseClass::setSuccess( true );
+
+    if ( !object )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is NULL.");
+        return NULL;
+    }
+
+    const kvs::UnstructuredVolumeObject* volume = kvs::UnstructuredVolumeObject::DownCast( object );
+    if ( !volume )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object is not unstructured volume object.");
+        return NULL;
+    }
+
+    this->setObjectType( "UnstructuredVolumeObject" );
+    if ( volume->name() != "" ) { this->setAttribute( "name", volume->name() ); }
+    if ( volume->hasMinMaxObjectCoords() )
+    {
+        this->setMinMaxObjectCoords( volume->minObjectCoord(), volume->maxObjectCoord() );
+    }
+    if ( volume->hasMinMaxExternalCoords() )
+    {
+        this->setMinMaxExternalCoords( volume->minExternalCoord(), volume->maxExternalCoord() );
+    }
+
+    if ( volume->label() != "" ) { this->setAttribute( "label", volume->label() ); }
+    if ( volume->unit() != "" ) { this->setAttribute( "unit", volume->unit() ); }
+    this->setAttribute( "cell_type", int( volume->cellType() ) );
+    this->setAttribute( "veclen", volume->veclen() );
+    this->setAttribute( "nnodes", volume->numberOfNodes() );
+    this->setAttribute( "ncells", volume->numberOfCells() );
+    this->setArray( "values", volume->values() );
+    this->setArray( "coords", volume->coords() );
+    this->setArray( "connections", volume->connections() );
+
+    if ( volume->hasMinMaxValues() )
+    {
+        this->setMinMaxValues( volume->minValue(), volume->maxValue() );
+    }
+
+    return this;
+}
+
 } // end of namespace kvs
@@ -8,6 +8,7 @@
 #include <kvs/ObjectBase>
 #include <kvs/UnstructuredVolumeObject>
 #include <kvs/KVSMLUnstructuredVolumeObject>
+#include <kvs/KVSBObject>
 #include <kvs/AVSUcd>
 #include <kvs/ExporterBase>
 
@@ -60,4 +61,19 @@ public:
     kvs::AVSUcd* exec( const kvs::ObjectBase* object );
 };
 
+/*===========================================================================*/
+/**
+ *  @brief  Unstructured volume exporter class as KVSBObject format.
+ */
+/*===========================================================================*/
+template <>
+class UnstructuredVolumeExporter<kvs::KVSBObject> :
+        public kvs::ExporterBase,
+        public kvs::KVSBObject
+{
+public:
+    UnstructuredVolumeExporter( const kvs::UnstructuredVolumeObject* object );
+    kvs::KVSBObject* exec( const kvs::ObjectBase* object );
+};
+
 } // end of namespace kvs
@@ -43,6 +43,43 @@ public:
         m_bucket[ index ].push_back( std::make_pair( value, distance ) );
     }
 
+    /*=======================================================================*/
+    /**
+     *  @brief  Returns the value interpolated from the values of the cells sharing the node.
+     *  @param  coord [in] node coordinate
+     *  @param  cells [in] IDs of the cells sharing the node
+     *  @param  ncells [in] number of the cells sharing the node
+     *  @param  values [in] values of all the cells
+     *  @param  centers [in] centers of all the cells
+     *  @return interpolated value, which is the same as the serialized value
+     *          when the cell values are inserted in the order of the cell IDs
+     */
+    /*=======================================================================*/
+    static Value Interpolate(
+        const kvs::Vec3& coord,
+        const kvs::UInt32* cells,
+        const size_t ncells,
+        const Value* values,
+        const kvs::Vec3* centers )
+    {
+        float w = 0.0f;
+        for ( size_t j = 0; j < ncells; j++ )
+        {
+            const float d = ( coord - centers[ cells[j] ] ).length();
+            w += 1.0f / d;
+        }
+
+        Value value = Value();
+        for ( size_t j = 0; j < ncells; j++ )
+        {
+            const kvs::Real32 d = ( coord - centers[ cells[j] ] ).length();
+            value += ( ( 1.0f / d ) / w ) * values[ cells[j] ];
+        }
+        if ( ncells != 0 ) value /= static_cast<kvs::Real32>( ncells );
+
+        return value;
+    }
+
     kvs::ValueArray<kvs::Real32> serialize() const
     {
         // Specialized for
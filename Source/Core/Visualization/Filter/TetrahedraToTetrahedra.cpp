@@ -5,9 +5,10 @@
  */
 /*****************************************************************************/
 #include "TetrahedraToTetrahedra.h"
-#include <algorithm>
-#include <map>
 #include <kvs/AnyValueArray>
+#include <kvs/Parallel>
+#include <vector>
+#include <atomic>
 
 
 namespace
@@ -15,69 +16,24 @@ namespace
 
 /*===========================================================================*/
 /**
- *  @brief  ID map class for removing the duplicated nodes.
+ *  @brief  Assigns the new IDs to the marked nodes by the prefix sum.
+ *  @param  marks [in] marks of the nodes (1: used, 0: unused)
+ *  @param  ids [out] new IDs of the nodes (valid for the marked nodes)
+ *  @return number of the marked nodes
+ *
+ *  The new IDs are assigned in the order of the original node IDs, so that
+ *  the result does not depend on the number of threads.
  */
 /*===========================================================================*/
-class IDMap
+size_t CompactIDs( const std::vector< std::atomic<kvs::UInt8> >& marks, kvs::ValueArray<kvs::UInt32>& ids )
 {
-public:
+    const size_t nids = marks.size();
+    ids.allocate( nids );
 
-    typedef kvs::UInt32 Key;
-    typedef kvs::UInt32 Value;
-    typedef std::map<Key,Value> Bucket;
-
-private:
-
-    size_t m_index; ///< index of the connection ID
-    Bucket m_bucket; ///< bucket for the IDs
-
-public:
-
-    IDMap();
-
-    const Bucket& bucket() const;
-    void insert( const kvs::UInt32 id );
-};
-
-/*===========================================================================*/
-/**
- *  @brief  Constructs a new IDMap class.
- */
-/*===========================================================================*/
-IDMap::IDMap():
-    m_index( 0 )
-{
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns the ID bucket.
- *  @return ID bucket
- */
-/*===========================================================================*/
-const IDMap::Bucket& IDMap::bucket() const
-{
-    return m_bucket;
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Inserts a ID.
- *  @param  id [in] ID
- */
-/*===========================================================================*/
-void IDMap::insert( const kvs::UInt32 id )
-{
-    const Key key = id;
-    const Value value = m_index;
-
-    Bucket::iterator i = m_bucket.find( key );
-    Bucket::const_iterator last = m_bucket.end();
-    if ( i == last )
-    {
-        m_bucket.insert( Bucket::value_type( key, value ) );
-        m_index++;
-    }
+    // Exclusive prefix sum of the marks.
+    const kvs::UInt32 zero = 0;
+    return kvs::ParallelScan( marks.data(), ids.data(), nids, zero,
+        []( const kvs::UInt32 a, const kvs::UInt32 b ) { return a + b; } );
 }
 
 } // end of namespace
@@ -225,19 +181,22 @@ void TetrahedraToTetrahedra::subdivide_8_tetrahedra( const kvs::UnstructuredVolu
     const size_t ndivisions = 8;
     const size_t tet_ncells = tet2_ncells * ndivisions;
     kvs::ValueArray<kvs::UInt32> tet_connections( tet_ncells * 4 );
-    kvs::UInt32* tet_pconnections = tet_connections.data();
-    for ( size_t i = 0; i < tet2_ncells; i++ )
+    kvs::UInt32* ptet_connections = tet_connections.data();
+    kvs::ParallelFor( 0L, static_cast<long>( tet2_ncells ), [&]( const long i )
     {
-        const kvs::UInt32 id0 = *(tet2_pconnections++);
-        const kvs::UInt32 id1 = *(tet2_pconnections++);
-        const kvs::UInt32 id2 = *(tet2_pconnections++);
-        const kvs::UInt32 id3 = *(tet2_pconnections++);
-        const kvs::UInt32 id4 = *(tet2_pconnections++);
-        const kvs::UInt32 id5 = *(tet2_pconnections++);
-        const kvs::UInt32 id6 = *(tet2_pconnections++);
-        const kvs::UInt32 id7 = *(tet2_pconnections++);
-        const kvs::UInt32 id8 = *(tet2_pconnections++);
-        const kvs::UInt32 id9 = *(tet2_pconnections++);
+        // Each quadratic cell is written at the known offset.
+        const kvs::UInt32* tet2_pconnection = tet2_pconnections + 10 * i;
+        kvs::UInt32* tet_pconnections = ptet_connections + ndivisions * 4 * i;
+        const kvs::UInt32 id0 = *(tet2_pconnection++);
+        const kvs::UInt32 id1 = *(tet2_pconnection++);
+        const kvs::UInt32 id2 = *(tet2_pconnection++);
+        const kvs::UInt32 id3 = *(tet2_pconnection++);
+        const kvs::UInt32 id4 = *(tet2_pconnection++);
+        const kvs::UInt32 id5 = *(tet2_pconnection++);
+        const kvs::UInt32 id6 = *(tet2_pconnection++);
+        const kvs::UInt32 id7 = *(tet2_pconnection++);
+        const kvs::UInt32 id8 = *(tet2_pconnection++);
+        const kvs::UInt32 id9 = *(tet2_pconnection++);
 
         *(tet_pconnections++) = id0;
         *(tet_pconnections++) = id4;
@@ -278,7 +237,7 @@ void TetrahedraToTetrahedra::subdivide_8_tetrahedra( const kvs::UnstructuredVolu
         *(tet_pconnections++) = id6;
         *(tet_pconnections++) = id9;
         *(tet_pconnections++) = id8;
-    }
+    } );
 
     if ( volume->hasMinMaxExternalCoords() )
     {
@@ -324,58 +283,59 @@ void TetrahedraToTetrahedra::remove_quadratic_nodes( const kvs::UnstructuredVolu
     const T* tet2_pvalues = static_cast<const T*>( volume->values().data() );
     const kvs::Real32* tet2_pcoords = volume->coords().data();
 
-    ::IDMap id_map;
-    for ( size_t i = 0; i < tet2_ncells; i++ )
+    const size_t tet2_nnodes = volume->numberOfNodes();
+
+    // Mark the vertex nodes of the cells, and assign the new IDs to the marked
+    // nodes by the prefix sum. The node shared by the cells is marked by the
+    // several threads, so that the marks are stored atomically. Since all the
+    // threads write the same mark, the result does not depend on the number
+    // of threads.
+    std::vector< std::atomic<kvs::UInt8> > marks( tet2_nnodes ); // zero-initialized
+    std::atomic<kvs::UInt8>* pmarks = marks.data();
+    kvs::ParallelFor( 0L, static_cast<long>( tet2_ncells ), [&]( const long i )
     {
-        const kvs::UInt32 id0 = tet2_pconnections[ 10 * i + 0 ];
-        const kvs::UInt32 id1 = tet2_pconnections[ 10 * i + 1 ];
-        const kvs::UInt32 id2 = tet2_pconnections[ 10 * i + 2 ];
-        const kvs::UInt32 id3 = tet2_pconnections[ 10 * i + 3 ];
-
-        id_map.insert( id0 );
-        id_map.insert( id1 );
-        id_map.insert( id2 );
-        id_map.insert( id3 );
-    }
+        pmarks[ tet2_pconnections[ 10 * i + 0 ] ].store( 1, std::memory_order_relaxed );
+        pmarks[ tet2_pconnections[ 10 * i + 1 ] ].store( 1, std::memory_order_relaxed );
+        pmarks[ tet2_pconnections[ 10 * i + 2 ] ].store( 1, std::memory_order_relaxed );
+        pmarks[ tet2_pconnections[ 10 * i + 3 ] ].store( 1, std::memory_order_relaxed );
+    } );
+
+    kvs::ValueArray<kvs::UInt32> id_map;
+    const size_t tet_nnodes = ::CompactIDs( marks, id_map );
+    const kvs::UInt32* pid_map = id_map.data();
 
     const size_t tet_ncells = tet2_ncells;
     kvs::ValueArray<kvs::UInt32> tet_connections( tet_ncells * 4 );
     kvs::UInt32* tet_pconnections = tet_connections.data();
-    for ( size_t i = 0; i < tet2_ncells; i++ )
+    kvs::ParallelFor( 0L, static_cast<long>( tet2_ncells ), [&]( const long i )
     {
-        const kvs::UInt32 id0 = tet2_pconnections[ 10 * i + 0 ];
-        const kvs::UInt32 id1 = tet2_pconnections[ 10 * i + 1 ];
-        const kvs::UInt32 id2 = tet2_pconnections[ 10 * i + 2 ];
-        const kvs::UInt32 id3 = tet2_pconnections[ 10 * i + 3 ];
-
-        *(tet_pconnections++) = id_map.bucket().find( id0 )->second;
-        *(tet_pconnections++) = id_map.bucket().find( id1 )->second;
-        *(tet_pconnections++) = id_map.bucket().find( id2 )->second;
-        *(tet_pconnections++) = id_map.bucket().find( id3 )->second;
-    }
+        tet_pconnections[ 4 * i + 0 ] = pid_map[ tet2_pconnections[ 10 * i + 0 ] ];
+        tet_pconnections[ 4 * i + 1 ] = pid_map[ tet2_pconnections[ 10 * i + 1 ] ];
+        tet_pconnections[ 4 * i + 2 ] = pid_map[ tet2_pconnections[ 10 * i + 2 ] ];
+        tet_pconnections[ 4 * i + 3 ] = pid_map[ tet2_pconnections[ 10 * i + 3 ] ];
+    } );
 
     const size_t tet_veclen = volume->veclen();
-    const size_t tet_nnodes = id_map.bucket().size();
     kvs::ValueArray<T> tet_values( tet_nnodes * tet_veclen );
     kvs::ValueArray<kvs::Real32> tet_coords( tet_nnodes * 3 );
     T* tet_pvalues = tet_values.data();
     kvs::Real32* tet_pcoords = tet_coords.data();
-    ::IDMap::Bucket::const_iterator id = id_map.bucket().begin();
-    while ( id != id_map.bucket().end() )
+    kvs::ParallelFor( 0L, static_cast<long>( tet2_nnodes ), [&]( const long id )
     {
+        if ( !pmarks[ id ].load( std::memory_order_relaxed ) ) { return; }
+        const size_t new_id = pid_map[ id ];
+
         // Value array.
         for ( size_t i = 0; i < tet_veclen; i++ )
         {
-            tet_pvalues[ id->second * tet_veclen + i ] = tet2_pvalues[ id->first * tet_veclen + i ];
+            tet_pvalues[ new_id * tet_veclen + i ] = tet2_pvalues[ id * tet_veclen + i ];
         }
 
         // Coordinate data array.
-        tet_pcoords[ id->second * 3 + 0 ] = tet2_pcoords[ id->first * 3 + 0 ];
-        tet_pcoords[ id->second * 3 + 1 ] = tet2_pcoords[ id->first * 3 + 1 ];
-        tet_pcoords[ id->second * 3 + 2 ] = tet2_pcoords[ id->first * 3 + 2 ];
-
-        ++id;
-    }
+        tet_pcoords[ new_id * 3 + 0 ] = tet2_pcoords[ id * 3 + 0 ];
+        tet_pcoords[ new_id * 3 + 1 ] = tet2_pcoords[ id * 3 + 1 ];
+        tet_pcoords[ new_id * 3 + 2 ] = tet2_pcoords[ id * 3 + 2 ];
+    } );
 
     if ( volume->hasMinMaxExternalCoords() )
     {
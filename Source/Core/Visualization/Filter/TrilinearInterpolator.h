@@ -11,6 +11,7 @@
 #include <kvs/Vector3>
 #include <kvs/Assert>
 #include <cstring>
+#include <algorithm>
 
 
 namespace kvs
@@ -19,15 +20,40 @@ namespace kvs
 /*==========================================================================*/
 /**
  *  Trilinear interpolation class.
+ *
+ *  The points are processed by the blocks of the points, whose neighbouring
+ *  grid indices and weights are stored in the arrays for each corner of the
+ *  grid (structure of arrays). The loops over the points in a block have no
+ *  dependency and no branch, so that they are vectorized by the compiler
+ *  (the neighbouring values are loaded by the gather instructions when the
+ *  target supports them, for example, AVX2 or AVX-512). The interpolation
+ *  for a single point (attachPoint, scalar and gradient) uses the same
+ *  kernels with a block of one point.
  */
 /*==========================================================================*/
 class TrilinearInterpolator
 {
+public:
+
+    static const size_t BlockSize = 8; ///< number of points in a block of the batch interpolation
+
 private:
 
-    kvs::Vector3ui m_grid_index; ///< grid index
+    template <size_t N>
+    struct Block
+    {
+        kvs::UInt32 line_size; ///< number of grid points per line
+        kvs::UInt32 slice_size; ///< number of grid points per slice
+        kvs::UInt32 last[3]; ///< last grid index of the cells along each axis
+        kvs::UInt32 base[N]; ///< index of the base grid point
+        kvs::UInt32 i[N]; ///< grid index along x axis
+        kvs::UInt32 j[N]; ///< grid index along y axis
+        kvs::UInt32 k[N]; ///< grid index along z axis
+        kvs::Real32 weight[8][N]; ///< weights for the neighbouring grid points
+    };
+
+    Block<1> m_block; ///< block for the attached point
     kvs::UInt32 m_index[8]; ///< neighbouring grid index
-    kvs::Real32 m_weight[8]; ///< weight for the neighbouring grid index
 
     const kvs::StructuredVolumeObject* m_reference_volume; ///< reference irregular volume data
 
@@ -41,6 +67,20 @@ public:
     kvs::Real32 scalar( void ) const;
     template <typename T>
     kvs::Vec3 gradient( void ) const;
+
+    template <typename T>
+    void scalars( const kvs::Vec3* points, const size_t npoints, kvs::Real32* scalars ) const;
+    template <typename T>
+    void gradients( const kvs::Vec3* points, const size_t npoints, kvs::Vec3* gradients ) const;
+
+private:
+
+    template <size_t N>
+    void locate( const kvs::Vec3* points, Block<N>* block ) const;
+    template <typename T, size_t N>
+    void interpolate_scalar( const Block<N>& block, kvs::Real32* scalars ) const;
+    template <typename T, size_t N>
+    void interpolate_gradient( const Block<N>& block, kvs::Vec3* gradients ) const;
 };
 
 /*===========================================================================*/
@@ -50,11 +90,10 @@ public:
  */
 /*===========================================================================*/
 inline TrilinearInterpolator::TrilinearInterpolator( const kvs::StructuredVolumeObject* volume ):
-    m_grid_index( 0, 0, 0 ),
     m_reference_volume( volume )
 {
+    std::memset( &m_block, 0x00, sizeof( m_block ) );
     std::memset( m_index, 0x00, sizeof( kvs::UInt32 ) * 8 );
-    std::memset( m_weight, 0x00, sizeof( kvs::Real32 ) * 8 );
 }
 
 /*===========================================================================*/
@@ -65,28 +104,12 @@ inline TrilinearInterpolator::TrilinearInterpolator( const kvs::StructuredVolume
 /*===========================================================================*/
 inline void TrilinearInterpolator::attachPoint( const kvs::Vector3f& point )
 {
-    const kvs::Vector3ui resolution = m_reference_volume->resolution();
-    KVS_ASSERT( 0.0f <= point.x() && point.x() <= resolution.x() - 1.0f );
-    KVS_ASSERT( 0.0f <= point.y() && point.y() <= resolution.y() - 1.0f );
-    KVS_ASSERT( 0.0f <= point.z() && point.z() <= resolution.z() - 1.0f );
-
-    // Temporary index.
-    const size_t ti = static_cast<size_t>( point.x() );
-    const size_t tj = static_cast<size_t>( point.y() );
-    const size_t tk = static_cast<size_t>( point.z() );
-
-    // Addjustment index for boundary.
-    const size_t i = ( ti >= resolution.x() - 1 ) ? resolution.x() - 2 : ti;
-    const size_t j = ( tj >= resolution.y() - 1 ) ? resolution.y() - 2 : tj;
-    const size_t k = ( tk >= resolution.z() - 1 ) ? resolution.z() - 2 : tk;
-
-    const size_t line_size  = m_reference_volume->numberOfNodesPerLine();
-    const size_t slice_size = m_reference_volume->numberOfNodesPerSlice();
+    this->locate<1>( &point, &m_block );
 
-    // Calculate index.
-    m_grid_index.set( i, j, k );
+    const kvs::UInt32 line_size = m_block.line_size;
+    const kvs::UInt32 slice_size = m_block.slice_size;
 
-    m_index[0] = i + j * line_size + k * slice_size;
+    m_index[0] = m_block.base[0];
     m_index[1] = m_index[0] + 1;
     m_index[2] = m_index[1] + line_size;
     m_index[3] = m_index[0] + line_size;
@@ -94,26 +117,6 @@ inline void TrilinearInterpolator::attachPoint( const kvs::Vector3f& point )
     m_index[5] = m_index[1] + slice_size;
     m_index[6] = m_index[2] + slice_size;
     m_index[7] = m_index[3] + slice_size;
-
-    // Calculate local coordinate.
-    const float x = point.x() - i;
-    const float y = point.y() - j;
-    const float z = point.z() - k;
-
-    const float xy = x * y;
-    const float yz = y * z;
-    const float zx = z * x;
-
-    const float xyz = xy * z;
-
-    m_weight[0] = 1.0f - x - y - z + xy + yz + zx - xyz;
-    m_weight[1] = x - xy - zx + xyz;
-    m_weight[2] = xy - xyz;
-    m_weight[3] = y - xy - yz + xyz;
-    m_weight[4] = z - zx - yz + xyz;
-    m_weight[5] = zx - xyz;
-    m_weight[6] = xyz;
-    m_weight[7] = yz - xyz;
 }
 
 /*===========================================================================*/
@@ -136,18 +139,9 @@ inline const kvs::UInt32* TrilinearInterpolator::indices( void ) const
 template <typename T>
 inline float TrilinearInterpolator::scalar( void ) const
 {
-    const T* const data = reinterpret_cast<const T*>( m_reference_volume->values().data() );
-
-    return(
-        static_cast<float>(
-            data[ m_index[0] ] * m_weight[0] +
-            data[ m_index[1] ] * m_weight[1] +
-            data[ m_index[2] ] * m_weight[2] +
-            data[ m_index[3] ] * m_weight[3] +
-            data[ m_index[4] ] * m_weight[4] +
-            data[ m_index[5] ] * m_weight[5] +
-            data[ m_index[6] ] * m_weight[6] +
-            data[ m_index[7] ] * m_weight[7] ) );
+    kvs::Real32 scalar = 0.0f;
+    this->interpolate_scalar<T,1>( m_block, &scalar );
+    return scalar;
 }
 
 /*===========================================================================*/
@@ -159,153 +153,299 @@ inline float TrilinearInterpolator::scalar( void ) const
 template <typename T>
 inline kvs::Vec3 TrilinearInterpolator::gradient( void ) const
 {
-    // Calculate the point's gradient.
-    float dx[8], dy[8], dz[8];
-
-    const T* const data = reinterpret_cast<const T*>( m_reference_volume->values().data() );
-
-    const kvs::Vector3ui resolution = m_reference_volume->resolution();
-    const size_t line_size  = m_reference_volume->numberOfNodesPerLine();
-    const size_t slice_size = m_reference_volume->numberOfNodesPerSlice();
-
-    const size_t i = m_grid_index.x();
-    const size_t j = m_grid_index.y();
-    const size_t k = m_grid_index.z();
+    kvs::Vec3 gradient;
+    this->interpolate_gradient<T,1>( m_block, &gradient );
+    return gradient;
+}
 
-    if ( i == 0 )
-    {
-        dx[0] = static_cast<float>( data[ m_index[1]     ] );
-        dx[1] = static_cast<float>( data[ m_index[1] + 1 ] ) - static_cast<float>( data[ m_index[0]     ] );
-        dx[2] = static_cast<float>( data[ m_index[2] + 1 ] ) - static_cast<float>( data[ m_index[3]     ] );
-        dx[3] = static_cast<float>( data[ m_index[2]     ] );
-        dx[4] = static_cast<float>( data[ m_index[5]     ] );
-        dx[5] = static_cast<float>( data[ m_index[5] + 1 ] ) - static_cast<float>( data[ m_index[4]     ] );
-        dx[6] = static_cast<float>( data[ m_index[6] + 1 ] ) - static_cast<float>( data[ m_index[7]     ] );
-        dx[7] = static_cast<float>( data[ m_index[6]     ] );
-    }
-    else if ( i == resolution.x() - 2 )
-    {
-        dx[0] = static_cast<float>( data[ m_index[1]     ] ) - static_cast<float>( data[ m_index[0] - 1 ] );
-        dx[1] =                                              - static_cast<float>( data[ m_index[0]     ] );
-        dx[2] =                                              - static_cast<float>( data[ m_index[3]     ] );
-        dx[3] = static_cast<float>( data[ m_index[2]     ] ) - static_cast<float>( data[ m_index[3] - 1 ] );
-        dx[4] = static_cast<float>( data[ m_index[5]     ] ) - static_cast<float>( data[ m_index[4] - 1 ] );
-        dx[5] =                                              - static_cast<float>( data[ m_index[4]     ] );
-        dx[6] =                                              - static_cast<float>( data[ m_index[7]     ] );
-        dx[7] = static_cast<float>( data[ m_index[6]     ] ) - static_cast<float>( data[ m_index[7] - 1 ] );
-    }
-    else
+/*===========================================================================*/
+/**
+ *  @brief  Interpolates the scalars at the points.
+ *  @param  points [in] pointer to the points
+ *  @param  npoints [in] number of the points
+ *  @param  scalars [out] pointer to the interpolated scalars
+ *
+ *  The results are the same as the ones of scalar() for each point. This
+ *  method does not change the attached point, and can be called from the
+ *  multiple threads.
+ */
+/*===========================================================================*/
+template <typename T>
+inline void TrilinearInterpolator::scalars(
+    const kvs::Vec3* points,
+    const size_t npoints,
+    kvs::Real32* scalars ) const
+{
+    Block<BlockSize> block;
+    kvs::Vec3 tail[ BlockSize ];
+    kvs::Real32 results[ BlockSize ];
+    for ( size_t offset = 0; offset < npoints; offset += BlockSize )
     {
-        dx[0] = static_cast<float>( data[ m_index[1]     ] ) - static_cast<float>( data[ m_index[0] - 1 ] );
-        dx[1] = static_cast<float>( data[ m_index[1] + 1 ] ) - static_cast<float>( data[ m_index[0]     ] );
-        dx[2] = static_cast<float>( data[ m_index[2] + 1 ] ) - static_cast<float>( data[ m_index[3]     ] );
-        dx[3] = static_cast<float>( data[ m_index[2]     ] ) - static_cast<float>( data[ m_index[3] - 1 ] );
-        dx[4] = static_cast<float>( data[ m_index[5]     ] ) - static_cast<float>( data[ m_index[4] - 1 ] );
-        dx[5] = static_cast<float>( data[ m_index[5] + 1 ] ) - static_cast<float>( data[ m_index[4]     ] );
-        dx[6] = static_cast<float>( data[ m_index[6] + 1 ] ) - static_cast<float>( data[ m_index[7]     ] );
-        dx[7] = static_cast<float>( data[ m_index[6]     ] ) - static_cast<float>( data[ m_index[7] - 1 ] );
+        const size_t n = npoints - offset < BlockSize ? npoints - offset : BlockSize;
+        if ( n == BlockSize )
+        {
+            this->locate<BlockSize>( points + offset, &block );
+            this->interpolate_scalar<T,BlockSize>( block, scalars + offset );
+        }
+        else
+        {
+            // The last block is filled with the last point.
+            std::fill( std::copy( points + offset, points + npoints, tail ), tail + BlockSize, points[ npoints - 1 ] );
+            this->locate<BlockSize>( tail, &block );
+            this->interpolate_scalar<T,BlockSize>( block, results );
+            std::copy( results, results + n, scalars + offset );
+        }
     }
+}
 
-    if ( j == 0 )
+/*===========================================================================*/
+/**
+ *  @brief  Interpolates the gradient vectors at the points.
+ *  @param  points [in] pointer to the points
+ *  @param  npoints [in] number of the points
+ *  @param  gradients [out] pointer to the interpolated gradient vectors
+ *
+ *  The results are the same as the ones of gradient() for each point. This
+ *  method does not change the attached point, and can be called from the
+ *  multiple threads.
+ */
+/*===========================================================================*/
+template <typename T>
+inline void TrilinearInterpolator::gradients(
+    const kvs::Vec3* points,
+    const size_t npoints,
+    kvs::Vec3* gradients ) const
+{
+    Block<BlockSize> block;
+    kvs::Vec3 tail[ BlockSize ];
+    kvs::Vec3 results[ BlockSize ];
+    for ( size_t offset = 0; offset < npoints; offset += BlockSize )
     {
-        dy[0] = static_cast<float>( data[ m_index[3]             ] );
-        dy[1] = static_cast<float>( data[ m_index[2]             ] );
-        dy[2] = static_cast<float>( data[ m_index[2] + line_size ] ) - static_cast<float>( data[ m_index[1]             ] );
-        dy[3] = static_cast<float>( data[ m_index[3] + line_size ] ) - static_cast<float>( data[ m_index[0]             ] );
-        dy[4] = static_cast<float>( data[ m_index[7]             ] );
-        dy[5] = static_cast<float>( data[ m_index[6]             ] );
-        dy[6] = static_cast<float>( data[ m_index[6] + line_size ] ) - static_cast<float>( data[ m_index[5]             ] );
-        dy[7] = static_cast<float>( data[ m_index[7] + line_size ] ) - static_cast<float>( data[ m_index[4]             ] );
+        const size_t n = npoints - offset < BlockSize ? npoints - offset : BlockSize;
+        if ( n == BlockSize )
+        {
+            this->locate<BlockSize>( points + offset, &block );
+            this->interpolate_gradient<T,BlockSize>( block, gradients + offset );
+        }
+        else
+        {
+            // The last block is filled with the last point.
+            std::fill( std::copy( points + offset, points + npoints, tail ), tail + BlockSize, points[ npoints - 1 ] );
+            this->locate<BlockSize>( tail, &block );
+            this->interpolate_gradient<T,BlockSize>( block, results );
+            std::copy( results, results + n, gradients + offset );
+        }
     }
-    else if ( j == resolution.y() - 2 )
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Calculates the neighbouring grid points and the weights.
+ *  @param  points [in] pointer to the N points
+ *  @param  block [out] pointer to the block
+ */
+/*===========================================================================*/
+template <size_t N>
+inline void TrilinearInterpolator::locate( const kvs::Vec3* points, Block<N>* block ) const
+{
+    const kvs::Vector3ui resolution = m_reference_volume->resolution();
+    const kvs::UInt32 line_size  = static_cast<kvs::UInt32>( m_reference_volume->numberOfNodesPerLine() );
+    const kvs::UInt32 slice_size = static_cast<kvs::UInt32>( m_reference_volume->numberOfNodesPerSlice() );
+    block->line_size = line_size;
+    block->slice_size = slice_size;
+    block->last[0] = resolution.x() - 2;
+    block->last[1] = resolution.y() - 2;
+    block->last[2] = resolution.z() - 2;
+
+    for ( size_t l = 0; l < N; l++ )
     {
-        dy[0] = static_cast<float>( data[ m_index[3]             ] ) - static_cast<float>( data[ m_index[0] - line_size ] );
-        dy[1] = static_cast<float>( data[ m_index[2]             ] ) - static_cast<float>( data[ m_index[1] - line_size ] );
-        dy[2] =                                                      - static_cast<float>( data[ m_index[1]             ] );
-        dy[3] =                                                      - static_cast<float>( data[ m_index[0]             ] );
-        dy[4] = static_cast<float>( data[ m_index[7]             ] ) - static_cast<float>( data[ m_index[4] - line_size ] );
-        dy[5] = static_cast<float>( data[ m_index[6]             ] ) - static_cast<float>( data[ m_index[5] - line_size ] );
-        dy[6] =                                                      - static_cast<float>( data[ m_index[5]             ] );
-        dy[7] =                                                      - static_cast<float>( data[ m_index[4]             ] );
+        const kvs::Vec3& point = points[l];
+        KVS_ASSERT( 0.0f <= point.x() && point.x() <= resolution.x() - 1.0f );
+        KVS_ASSERT( 0.0f <= point.y() && point.y() <= resolution.y() - 1.0f );
+        KVS_ASSERT( 0.0f <= point.z() && point.z() <= resolution.z() - 1.0f );
+
+        // Temporary index.
+        const kvs::UInt32 ti = static_cast<kvs::UInt32>( point.x() );
+        const kvs::UInt32 tj = static_cast<kvs::UInt32>( point.y() );
+        const kvs::UInt32 tk = static_cast<kvs::UInt32>( point.z() );
+
+        // Addjustment index for boundary.
+        const kvs::UInt32 i = ( ti >= resolution.x() - 1 ) ? resolution.x() - 2 : ti;
+        const kvs::UInt32 j = ( tj >= resolution.y() - 1 ) ? resolution.y() - 2 : tj;
+        const kvs::UInt32 k = ( tk >= resolution.z() - 1 ) ? resolution.z() - 2 : tk;
+
+        block->base[l] = i + j * line_size + k * slice_size;
+        block->i[l] = i;
+        block->j[l] = j;
+        block->k[l] = k;
+
+        // Calculate local coordinate.
+        const float x = point.x() - i;
+        const float y = point.y() - j;
+        const float z = point.z() - k;
+
+        const float xy = x * y;
+        const float yz = y * z;
+        const float zx = z * x;
+
+        const float xyz = xy * z;
+
+        block->weight[0][l] = 1.0f - x - y - z + xy + yz + zx - xyz;
+        block->weight[1][l] = x - xy - zx + xyz;
+        block->weight[2][l] = xy - xyz;
+        block->weight[3][l] = y - xy - yz + xyz;
+        block->weight[4][l] = z - zx - yz + xyz;
+        block->weight[5][l] = zx - xyz;
+        block->weight[6][l] = xyz;
+        block->weight[7][l] = yz - xyz;
     }
-    else
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Interpolates the scalars for the points in the block.
+ *  @param  block [in] block
+ *  @param  scalars [out] pointer to the N scalars
+ */
+/*===========================================================================*/
+template <typename T, size_t N>
+inline void TrilinearInterpolator::interpolate_scalar( const Block<N>& block, kvs::Real32* scalars ) const
+{
+    const T* const data = reinterpret_cast<const T*>( m_reference_volume->values().data() );
+    const kvs::UInt32 line_size = block.line_size;
+    const kvs::UInt32 slice_size = block.slice_size;
+
+    for ( size_t l = 0; l < N; l++ )
     {
-        dy[0] = static_cast<float>( data[ m_index[3]             ] ) - static_cast<float>( data[ m_index[0] - line_size ] );
-        dy[1] = static_cast<float>( data[ m_index[2]             ] ) - static_cast<float>( data[ m_index[1] - line_size ] );
-        dy[2] = static_cast<float>( data[ m_index[2] + line_size ] ) - static_cast<float>( data[ m_index[1]             ] );
-        dy[3] = static_cast<float>( data[ m_index[3] + line_size ] ) - static_cast<float>( data[ m_index[0]             ] );
-        dy[4] = static_cast<float>( data[ m_index[7]             ] ) - static_cast<float>( data[ m_index[4] - line_size ] );
-        dy[5] = static_cast<float>( data[ m_index[6]             ] ) - static_cast<float>( data[ m_index[5] - line_size ] );
-        dy[6] = static_cast<float>( data[ m_index[6] + line_size ] ) - static_cast<float>( data[ m_index[5]             ] );
-        dy[7] = static_cast<float>( data[ m_index[7] + line_size ] ) - static_cast<float>( data[ m_index[4]             ] );
+        const kvs::UInt32 index0 = block.base[l];
+        const kvs::UInt32 index1 = index0 + 1;
+        const kvs::UInt32 index2 = index1 + line_size;
+        const kvs::UInt32 index3 = index0 + line_size;
+        const kvs::UInt32 index4 = index0 + slice_size;
+        const kvs::UInt32 index5 = index1 + slice_size;
+        const kvs::UInt32 index6 = index2 + slice_size;
+        const kvs::UInt32 index7 = index3 + slice_size;
+
+        // The values are accumulated in the type of T * float (double for Real64).
+        scalars[l] = static_cast<kvs::Real32>(
+            data[ index0 ] * block.weight[0][l] +
+            data[ index1 ] * block.weight[1][l] +
+            data[ index2 ] * block.weight[2][l] +
+            data[ index3 ] * block.weight[3][l] +
+            data[ index4 ] * block.weight[4][l] +
+            data[ index5 ] * block.weight[5][l] +
+            data[ index6 ] * block.weight[6][l] +
+            data[ index7 ] * block.weight[7][l] );
     }
+}
 
-    if ( k == 0 )
+/*===========================================================================*/
+/**
+ *  @brief  Interpolates the gradient vectors for the points in the block.
+ *  @param  block [in] block
+ *  @param  gradients [out] pointer to the N gradient vectors
+ *
+ *  The derivatives at the neighbouring grid points are calculated by the
+ *  central difference, where the values outside the volume are regarded as
+ *  0. The values at the neighbouring grid points are loaded once and shared
+ *  by the derivatives, and the values outside the grid are loaded from the
+ *  clamped indices and masked, so that the loop has no branch.
+ */
+/*===========================================================================*/
+template <typename T, size_t N>
+inline void TrilinearInterpolator::interpolate_gradient( const Block<N>& block, kvs::Vec3* gradients ) const
+{
+    const T* const data = reinterpret_cast<const T*>( m_reference_volume->values().data() );
+    const kvs::UInt32 line_size = block.line_size;
+    const kvs::UInt32 slice_size = block.slice_size;
+
+    // Values at the lower and the upper grid points, or 0 outside the volume.
+    auto lower = [data]( const kvs::UInt32 index, const kvs::UInt32 step, const bool inside )
     {
-        dz[0] = static_cast<float>( data[ m_index[4]              ] );
-        dz[1] = static_cast<float>( data[ m_index[5]              ] );
-        dz[2] = static_cast<float>( data[ m_index[6]              ] );
-        dz[3] = static_cast<float>( data[ m_index[7]              ] );
-        dz[4] = static_cast<float>( data[ m_index[4] + slice_size ] ) - static_cast<float>( data[ m_index[0]              ] );
-        dz[5] = static_cast<float>( data[ m_index[5] + slice_size ] ) - static_cast<float>( data[ m_index[1]              ] );
-        dz[6] = static_cast<float>( data[ m_index[6] + slice_size ] ) - static_cast<float>( data[ m_index[2]              ] );
-        dz[7] = static_cast<float>( data[ m_index[7] + slice_size ] ) - static_cast<float>( data[ m_index[3]              ] );
-    }
-    else if ( k == resolution.z() - 2 )
+        return inside ? static_cast<float>( data[ index - step ] ) : 0.0f;
+    };
+    auto upper = [data]( const kvs::UInt32 index, const kvs::UInt32 step, const bool inside )
     {
-        dz[0] = static_cast<float>( data[ m_index[4]              ] ) - static_cast<float>( data[ m_index[0] - slice_size ] );
-        dz[1] = static_cast<float>( data[ m_index[5]              ] ) - static_cast<float>( data[ m_index[1] - slice_size ] );
-        dz[2] = static_cast<float>( data[ m_index[6]              ] ) - static_cast<float>( data[ m_index[2] - slice_size ] );
-        dz[3] = static_cast<float>( data[ m_index[7]              ] ) - static_cast<float>( data[ m_index[3] - slice_size ] );
-        dz[4] =                                                       - static_cast<float>( data[ m_index[0]              ] );
-        dz[5] =                                                       - static_cast<float>( data[ m_index[1]              ] );
-        dz[6] =                                                       - static_cast<float>( data[ m_index[2]              ] );
-        dz[7] =                                                       - static_cast<float>( data[ m_index[3]              ] );
-    }
-    else
+        return inside ? static_cast<float>( data[ index + step ] ) : 0.0f;
+    };
+
+    for ( size_t l = 0; l < N; l++ )
     {
-        dz[0] = static_cast<float>( data[ m_index[4]              ] ) - static_cast<float>( data[ m_index[0] - slice_size ] );
-        dz[1] = static_cast<float>( data[ m_index[5]              ] ) - static_cast<float>( data[ m_index[1] - slice_size ] );
-        dz[2] = static_cast<float>( data[ m_index[6]              ] ) - static_cast<float>( data[ m_index[2] - slice_size ] );
-        dz[3] = static_cast<float>( data[ m_index[7]              ] ) - static_cast<float>( data[ m_index[3] - slice_size ] );
-        dz[4] = static_cast<float>( data[ m_index[4] + slice_size ] ) - static_cast<float>( data[ m_index[0]              ] );
-        dz[5] = static_cast<float>( data[ m_index[5] + slice_size ] ) - static_cast<float>( data[ m_index[1]              ] );
-        dz[6] = static_cast<float>( data[ m_index[6] + slice_size ] ) - static_cast<float>( data[ m_index[2]              ] );
-        dz[7] = static_cast<float>( data[ m_index[7] + slice_size ] ) - static_cast<float>( data[ m_index[3]              ] );
+        const kvs::UInt32 index0 = block.base[l];
+        const kvs::UInt32 index1 = index0 + 1;
+        const kvs::UInt32 index2 = index1 + line_size;
+        const kvs::UInt32 index3 = index0 + line_size;
+        const kvs::UInt32 index4 = index0 + slice_size;
+        const kvs::UInt32 index5 = index1 + slice_size;
+        const kvs::UInt32 index6 = index2 + slice_size;
+        const kvs::UInt32 index7 = index3 + slice_size;
+
+        const float v0 = static_cast<float>( data[ index0 ] );
+        const float v1 = static_cast<float>( data[ index1 ] );
+        const float v2 = static_cast<float>( data[ index2 ] );
+        const float v3 = static_cast<float>( data[ index3 ] );
+        const float v4 = static_cast<float>( data[ index4 ] );
+        const float v5 = static_cast<float>( data[ index5 ] );
+        const float v6 = static_cast<float>( data[ index6 ] );
+        const float v7 = static_cast<float>( data[ index7 ] );
+
+        // Steps are 0 outside the volume, so that the indices are always valid.
+        const bool has_lower_x = block.i[l] > 0;
+        const bool has_lower_y = block.j[l] > 0;
+        const bool has_lower_z = block.k[l] > 0;
+        const bool has_upper_x = block.i[l] < block.last[0];
+        const bool has_upper_y = block.j[l] < block.last[1];
+        const bool has_upper_z = block.k[l] < block.last[2];
+        const kvs::UInt32 lower_x = has_lower_x ? 1 : 0;
+        const kvs::UInt32 lower_y = has_lower_y ? line_size : 0;
+        const kvs::UInt32 lower_z = has_lower_z ? slice_size : 0;
+        const kvs::UInt32 upper_x = has_upper_x ? 1 : 0;
+        const kvs::UInt32 upper_y = has_upper_y ? line_size : 0;
+        const kvs::UInt32 upper_z = has_upper_z ? slice_size : 0;
+
+        const float dx0 = v1 - lower( index0, lower_x, has_lower_x );
+        const float dx1 = upper( index1, upper_x, has_upper_x ) - v0;
+        const float dx2 = upper( index2, upper_x, has_upper_x ) - v3;
+        const float dx3 = v2 - lower( index3, lower_x, has_lower_x );
+        const float dx4 = v5 - lower( index4, lower_x, has_lower_x );
+        const float dx5 = upper( index5, upper_x, has_upper_x ) - v4;
+        const float dx6 = upper( index6, upper_x, has_upper_x ) - v7;
+        const float dx7 = v6 - lower( index7, lower_x, has_lower_x );
+
+        const float dy0 = v3 - lower( index0, lower_y, has_lower_y );
+        const float dy1 = v2 - lower( index1, lower_y, has_lower_y );
+        const float dy2 = upper( index2, upper_y, has_upper_y ) - v1;
+        const float dy3 = upper( index3, upper_y, has_upper_y ) - v0;
+        const float dy4 = v7 - lower( index4, lower_y, has_lower_y );
+        const float dy5 = v6 - lower( index5, lower_y, has_lower_y );
+        const float dy6 = upper( index6, upper_y, has_upper_y ) - v5;
+        const float dy7 = upper( index7, upper_y, has_upper_y ) - v4;
+
+        const float dz0 = v4 - lower( index0, lower_z, has_lower_z );
+        const float dz1 = v5 - lower( index1, lower_z, has_lower_z );
+        const float dz2 = v6 - lower( index2, lower_z, has_lower_z );
+        const float dz3 = v7 - lower( index3, lower_z, has_lower_z );
+        const float dz4 = upper( index4, upper_z, has_upper_z ) - v0;
+        const float dz5 = upper( index5, upper_z, has_upper_z ) - v1;
+        const float dz6 = upper( index6, upper_z, has_upper_z ) - v2;
+        const float dz7 = upper( index7, upper_z, has_upper_z ) - v3;
+
+        const float* const w[8] = {
+            block.weight[0] + l, block.weight[1] + l, block.weight[2] + l, block.weight[3] + l,
+            block.weight[4] + l, block.weight[5] + l, block.weight[6] + l, block.weight[7] + l };
+
+        const float x =
+            dx0 * *w[0] + dx1 * *w[1] + dx2 * *w[2] + dx3 * *w[3] +
+            dx4 * *w[4] + dx5 * *w[5] + dx6 * *w[6] + dx7 * *w[7];
+        const float y =
+            dy0 * *w[0] + dy1 * *w[1] + dy2 * *w[2] + dy3 * *w[3] +
+            dy4 * *w[4] + dy5 * *w[5] + dy6 * *w[6] + dy7 * *w[7];
+        const float z =
+            dz0 * *w[0] + dz1 * *w[1] + dz2 * *w[2] + dz3 * *w[3] +
+            dz4 * *w[4] + dz5 * *w[5] + dz6 * *w[6] + dz7 * *w[7];
+
+        gradients[l].set( -x, -y, -z );
     }
-
-    const float x =
-        dx[0] * m_weight[0] +
-        dx[1] * m_weight[1] +
-        dx[2] * m_weight[2] +
-        dx[3] * m_weight[3] +
-        dx[4] * m_weight[4] +
-        dx[5] * m_weight[5] +
-        dx[6] * m_weight[6] +
-        dx[7] * m_weight[7];
-
-    const float y =
-        dy[0] * m_weight[0] +
-        dy[1] * m_weight[1] +
-        dy[2] * m_weight[2] +
-        dy[3] * m_weight[3] +
-        dy[4] * m_weight[4] +
-        dy[5] * m_weight[5] +
-        dy[6] * m_weight[6] +
-        dy[7] * m_weight[7];
-
-    const float z =
-        dz[0] * m_weight[0] +
-        dz[1] * m_weight[1] +
-        dz[2] * m_weight[2] +
-        dz[3] * m_weight[3] +
-        dz[4] * m_weight[4] +
-        dz[5] * m_weight[5] +
-        dz[6] * m_weight[6] +
-        dz[7] * m_weight[7];
-
-//    return( kvs::Vector3f( x, y, z ) );
-    return( kvs::Vector3f( -x, -y, -z ) );
 }
 
 } // end of namespace kvs
@@ -7,6 +7,9 @@
 #include "Tubeline.h"
 #include <kvs/Quaternion>
 #include <kvs/Math>
+#include <kvs/Parallel>
+#include <vector>
+#include <algorithm>
 
 
 namespace
@@ -148,7 +151,7 @@ const kvs::ValueArray<kvs::UInt8> GetColorArray( const kvs::LineObject* line )
  *  @param  line [in] pointer to the line object
  *  @param  id1 [in] ID of the start vertex
  *  @param  id2 [in] ID of the end vertex
- *  @param  con_id [in]
+ *  @param  offset [in] number of the line segments before the polyline
  *  @return color array
  */
 /*===========================================================================*/
@@ -156,7 +159,7 @@ const kvs::ValueArray<kvs::UInt8> GetColorArray(
     const kvs::LineObject* line,
     const size_t id1,
     const size_t id2,
-    const size_t con_id )
+    const size_t offset )
 {
     // Ponter to the color array of the line object.
     const kvs::UInt8* c = line->colors().data();
@@ -182,25 +185,15 @@ const kvs::ValueArray<kvs::UInt8> GetColorArray(
         if ( line->colorType() == kvs::LineObject::LineColor )
         {
             kvs::ValueArray<kvs::UInt8> colors( ncomponents * ncolors );
-
-            const kvs::UInt32* n = line->connections().data();
-
-            size_t counter = 0;
-            for ( size_t i = 0, index = 0; i < con_id; i++, index += 2 )
-            {
-                const size_t index_0 = n[ index + 0 ];
-                const size_t index_1 = n[ index + 1 ];
-                counter += index_1 - index_0;
-            }
             for ( size_t i = 0, index = 0; i < ncolors - 1; i++ , index += ncomponents )
             {
-                const size_t j = ( i + counter ) * ncomponents;
+                const size_t j = ( i + offset ) * ncomponents;
                 colors[ index + 0 ] = c[ j + 0 ];
                 colors[ index + 1 ] = c[ j + 1 ];
                 colors[ index + 2 ] = c[ j + 2 ];
             }
             const size_t i1 = ( ncolors - 1 ) * ncomponents;
-            const size_t i2 = ( ncolors - 2 + counter ) * ncomponents;
+            const size_t i2 = ( ncolors - 2 + offset ) * ncomponents;
             colors[ i1 + 0 ] = c[ i2 + 0 ];
             colors[ i1 + 1 ] = c[ i2 + 1 ];
             colors[ i1 + 2 ] = c[ i2 + 2 ];
@@ -267,7 +260,7 @@ const kvs::ValueArray<kvs::Real32> GetSizeArray( const kvs::LineObject* line )
  *  @param  line [in] pointer to the line object
  *  @param  id1 [in] ID of the start vertex
  *  @param  id2 [in] ID of the end vertex
- *  @param  con_id [in]
+ *  @param  offset [in] number of the line segments before the polyline
  *  @return size array
  */
 /*===========================================================================*/
@@ -275,7 +268,7 @@ const kvs::ValueArray<kvs::Real32> GetSizeArray(
     const kvs::LineObject* line,
     const size_t id1,
     const size_t id2,
-    const size_t con_id )
+    const size_t offset )
 {
     // Ponter to the size array of the line object.
     const kvs::Real32* s = line->sizes().data();
@@ -296,19 +289,9 @@ const kvs::ValueArray<kvs::Real32> GetSizeArray(
     else if ( line->numberOfSizes() > 1 )
     {
         kvs::ValueArray<kvs::Real32> sizes( nsizes );
-
-        const kvs::UInt32* n = line->connections().data();
-
-        size_t counter = 0;
-        for ( size_t i = 0, index = 0; i < con_id; i++, index += 2 )
-        {
-            const size_t index_0 = n[ index + 0 ];
-            const size_t index_1 = n[ index + 1 ];
-            counter += index_1 - index_0;
-        }
         for ( size_t i = 0; i < nsizes; i++ )
         {
-            sizes[i] = s[ i + counter ];
+            sizes[i] = s[ i + offset ];
         }
 
         return sizes;
@@ -370,6 +353,45 @@ size_t GetNumberOfVertices( const kvs::LineObject* line )
     return nvertices;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns a number of the tubes (including the joints) of the line.
+ *  @param  nvertices [in] number of the vertices of the line
+ *  @return number of the tubes
+ */
+/*===========================================================================*/
+size_t GetNumberOfTubes( const size_t nvertices )
+{
+    // A tube for the first segment, and a tube and a joint for the others.
+    return ( nvertices < 2 ) ? 0 : nvertices * 2 - 3;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a number of the color components per division of the tube.
+ *  @param  color_type [in] polygon color type
+ *  @return number of the color components
+ */
+/*===========================================================================*/
+size_t GetNumberOfColorComponents( const kvs::PolygonObject::ColorType color_type )
+{
+    return ( color_type == kvs::PolygonObject::VertexColor ) ? 6 : 3;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a color in the color array.
+ *  @param  colors [in] color array
+ *  @param  index [in] color index
+ *  @return color
+ */
+/*===========================================================================*/
+kvs::RGBColor GetColor( const kvs::ValueArray<kvs::UInt8>& colors, const size_t index )
+{
+    const kvs::UInt8* c = colors.data() + index * 3;
+    return kvs::RGBColor( c[0], c[1], c[2] );
+}
+
 } // end of namespace
 
 
@@ -491,25 +513,37 @@ void Tubeline::filtering_strip( const kvs::LineObject* line )
     const size_t nvertices = ::GetNumberOfVertices( line );
     const kvs::PolygonObject::ColorType color_type = ::GetColorType( line );
 
-    std::vector<kvs::Real32> vertices;
-    std::vector<kvs::UInt8> colors;
-    std::vector<kvs::UInt32> connections;
-    std::vector<kvs::Real32> normals;
-    this->calculate_tubes(
-        &vertices,
-        &colors,
-        &connections,
-        &normals,
-        line_vertices,
-        line_sizes,
-        line_colors,
-        nvertices,
-        color_type );
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( vertices ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
+    const size_t ntubes = ::GetNumberOfTubes( nvertices );
+    kvs::ValueArray<kvs::Real32> vertices( ntubes * m_ndivisions * 6 );
+    kvs::ValueArray<kvs::UInt8> colors( ntubes * m_ndivisions * ::GetNumberOfColorComponents( color_type ) );
+    kvs::ValueArray<kvs::UInt32> connections( ntubes * m_ndivisions * 4 );
+    kvs::ValueArray<kvs::Real32> normals( ntubes * m_ndivisions * 3 );
+
+    kvs::Real32* pvertices = vertices.data();
+    kvs::UInt8* pcolors = colors.data();
+    kvs::UInt32* pconnections = connections.data();
+    kvs::Real32* pnormals = normals.data();
+    const long nsegments = static_cast<long>( ntubes > 0 ? nvertices - 1 : 0 );
+    kvs::ParallelFor( 0L, nsegments, [&]( const long i )
+    {
+        this->calculate_tube(
+            pvertices,
+            pcolors,
+            pconnections,
+            pnormals,
+            0,
+            line_vertices,
+            line_sizes,
+            line_colors,
+            nvertices,
+            color_type,
+            static_cast<size_t>( i ) );
+    } );
+
+    SuperClass::setCoords( vertices );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( normals );
+    SuperClass::setConnections( connections );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Quadrangle );
     SuperClass::setColorType( color_type );
@@ -530,25 +564,37 @@ void Tubeline::filtering_uniline( const kvs::LineObject* line )
     const size_t nvertices = ::GetNumberOfVertices( line );
     const kvs::PolygonObject::ColorType color_type = ::GetColorType( line );
 
-    std::vector<kvs::Real32> vertices;
-    std::vector<kvs::UInt8> colors;
-    std::vector<kvs::UInt32> connections;
-    std::vector<kvs::Real32> normals;
-    this->calculate_tubes(
-        &vertices,
-        &colors,
-        &connections,
-        &normals,
-        line_vertices,
-        line_sizes,
-        line_colors,
-        nvertices,
-        color_type );
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( vertices ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
+    const size_t ntubes = ::GetNumberOfTubes( nvertices );
+    kvs::ValueArray<kvs::Real32> vertices( ntubes * m_ndivisions * 6 );
+    kvs::ValueArray<kvs::UInt8> colors( ntubes * m_ndivisions * ::GetNumberOfColorComponents( color_type ) );
+    kvs::ValueArray<kvs::UInt32> connections( ntubes * m_ndivisions * 4 );
+    kvs::ValueArray<kvs::Real32> normals( ntubes * m_ndivisions * 3 );
+
+    kvs::Real32* pvertices = vertices.data();
+    kvs::UInt8* pcolors = colors.data();
+    kvs::UInt32* pconnections = connections.data();
+    kvs::Real32* pnormals = normals.data();
+    const long nsegments = static_cast<long>( ntubes > 0 ? nvertices - 1 : 0 );
+    kvs::ParallelFor( 0L, nsegments, [&]( const long i )
+    {
+        this->calculate_tube(
+            pvertices,
+            pcolors,
+            pconnections,
+            pnormals,
+            0,
+            line_vertices,
+            line_sizes,
+            line_colors,
+            nvertices,
+            color_type,
+            static_cast<size_t>( i ) );
+    } );
+
+    SuperClass::setCoords( vertices );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( normals );
+    SuperClass::setConnections( connections );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Quadrangle );
     SuperClass::setColorType( color_type );
@@ -563,67 +609,66 @@ void Tubeline::filtering_uniline( const kvs::LineObject* line )
 /*===========================================================================*/
 void Tubeline::filtering_polyline( const kvs::LineObject* line )
 {
-    std::vector<kvs::Real32> vertices;
-    std::vector<kvs::UInt8> colors;
-    std::vector<kvs::UInt32> connections;
-    std::vector<kvs::Real32> normals;
-
     const kvs::PolygonObject::ColorType color_type = ::GetColorType( line );
+    const bool has_attributes = line->numberOfSizes() > 0 && line->numberOfColors() > 0;
 
+    // Count the tubes of each polyline, and calculate the offsets of the tubes
+    // and the line segments (used for the line sizes and colors) by the prefix
+    // sums of the counts.
     const kvs::UInt32* line_connections = line->connections().data();
     const size_t line_nconnections = line->numberOfConnections();
-    for( size_t i = 0, index = 0; i < line_nconnections; i++, index += 2 )
+    std::vector<size_t> tube_offsets( line_nconnections + 1, 0 );
+    std::vector<size_t> segment_offsets( line_nconnections + 1, 0 );
+    for ( size_t i = 0, index = 0; i < line_nconnections; i++, index += 2 )
     {
         const size_t id1 = line_connections[ index + 0 ];
         const size_t id2 = line_connections[ index + 1 ];
+        const size_t nvertices = has_attributes ? id2 - id1 + 1 : 0;
+        tube_offsets[ i + 1 ] = tube_offsets[i] + ::GetNumberOfTubes( nvertices );
+        segment_offsets[ i + 1 ] = segment_offsets[i] + ( id2 - id1 );
+    }
+
+    const size_t ntubes = tube_offsets.back();
+    const size_t ncolor_components = ::GetNumberOfColorComponents( color_type );
+    kvs::ValueArray<kvs::Real32> vertices( ntubes * m_ndivisions * 6 );
+    kvs::ValueArray<kvs::UInt8> colors( ntubes * m_ndivisions * ncolor_components );
+    kvs::ValueArray<kvs::UInt32> connections( ntubes * m_ndivisions * 4 );
+    kvs::ValueArray<kvs::Real32> normals( ntubes * m_ndivisions * 3 );
+
+    kvs::Real32* pvertices = vertices.data();
+    kvs::UInt8* pcolors = colors.data();
+    kvs::UInt32* pconnections = connections.data();
+    kvs::Real32* pnormals = normals.data();
+    const long nlines = static_cast<long>( line_nconnections );
+    kvs::ParallelFor( 0L, nlines, [&]( const long i )
+    {
+        const size_t offset = tube_offsets[i];
+        if ( offset == tube_offsets[ i + 1 ] ) { return; }
 
+        const size_t id1 = line_connections[ 2 * i + 0 ];
+        const size_t id2 = line_connections[ 2 * i + 1 ];
         const kvs::ValueArray<kvs::Real32> line_vertices = ::GetVertexArray( line, id1, id2 );
-        const kvs::ValueArray<kvs::Real32> line_sizes = ::GetSizeArray( line, id1, id2, i );
-        const kvs::ValueArray<kvs::UInt8> line_colors = ::GetColorArray( line, id1, id2, i );
+        const kvs::ValueArray<kvs::Real32> line_sizes = ::GetSizeArray( line, id1, id2, segment_offsets[i] );
+        const kvs::ValueArray<kvs::UInt8> line_colors = ::GetColorArray( line, id1, id2, segment_offsets[i] );
         const size_t nvertices = id2 - id1 + 1;
 
-        if ( line_sizes.size() < 2 ) continue;
-        if ( line_colors.size() < 2 ) continue;
-
-        std::vector<kvs::Real32> tmp_vertices;
-        std::vector<kvs::UInt8> tmp_colors;
-        std::vector<kvs::UInt32> tmp_connections;
-        std::vector<kvs::Real32> tmp_normals;
         this->calculate_tubes(
-            &tmp_vertices,
-            &tmp_colors,
-            &tmp_connections,
-            &tmp_normals,
+            pvertices + offset * m_ndivisions * 6,
+            pcolors + offset * m_ndivisions * ncolor_components,
+            pconnections + offset * m_ndivisions * 4,
+            pnormals + offset * m_ndivisions * 3,
+            offset * m_ndivisions * 2,
             line_vertices,
             line_sizes,
             line_colors,
             nvertices,
             color_type );
+    } );
 
-        const kvs::UInt32 nv = static_cast<kvs::UInt32>( vertices.size() / 3 );
-
-        vertices.insert( vertices.end(), tmp_vertices.begin(), tmp_vertices.end() );
-        normals.insert( normals.end(), tmp_normals.begin(), tmp_normals.end() );
-
-        const size_t tmp_ncolors = ( color_type == kvs::PolygonObject::VertexColor ) ?
-            tmp_colors.size() :
-            tmp_colors.size() - m_ndivisions * 3;
-        for( size_t j = 0; j < tmp_ncolors; j++ )
-        {
-            colors.push_back( tmp_colors[j] );
-        }
-
-        const size_t tmp_connections_size = tmp_connections.size();
-        for ( size_t j = 0; j < tmp_connections_size; j++ )
-        {
-            connections.push_back( tmp_connections[j] + nv );
-        }
-    }
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( vertices ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
+    SuperClass::setCoords( vertices );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( normals );
+    SuperClass::setConnections( connections );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Quadrangle );
     SuperClass::setColorType( color_type );
@@ -638,23 +683,29 @@ void Tubeline::filtering_polyline( const kvs::LineObject* line )
 /*===========================================================================*/
 void Tubeline::filtering_segment( const kvs::LineObject* line )
 {
-    std::vector<kvs::Real32> vertices;
-    std::vector<kvs::UInt8> colors;
-    std::vector<kvs::UInt32> connections;
-    std::vector<kvs::Real32> normals;
-
     const kvs::PolygonObject::ColorType color_type = ::GetColorType( line );
 
+    // Each of the segments is converted to a single tube.
     const kvs::UInt32* line_connections = line->connections().data();
     const size_t line_nconnections = line->numberOfConnections();
-    for( size_t i = 0, index = 0; i < line_nconnections; i++, index += 2 )
+    const size_t ncolor_components = ::GetNumberOfColorComponents( color_type );
+    kvs::ValueArray<kvs::Real32> vertices( line_nconnections * m_ndivisions * 6 );
+    kvs::ValueArray<kvs::UInt8> colors( line_nconnections * m_ndivisions * ncolor_components );
+    kvs::ValueArray<kvs::UInt32> connections( line_nconnections * m_ndivisions * 4 );
+    kvs::ValueArray<kvs::Real32> normals( line_nconnections * m_ndivisions * 3 );
+
+    kvs::Real32* pvertices = vertices.data();
+    kvs::UInt8* pcolors = colors.data();
+    kvs::UInt32* pconnections = connections.data();
+    kvs::Real32* pnormals = normals.data();
+    const long nlines = static_cast<long>( line_nconnections );
+    kvs::ParallelFor( 0L, nlines, [&]( const long i )
     {
-        const size_t id1 = line_connections[ index + 0 ];
-        const size_t id2 = line_connections[ index + 1 ];
+        const size_t id1 = line_connections[ 2 * i + 0 ];
+        const size_t id2 = line_connections[ 2 * i + 1 ];
 
         const size_t nvertices = 2;
         const kvs::ValueArray<kvs::Real32> line_vertices = ::GetVertexArray( line, id1, id2 );
-//        const kvs::Real32 line_size = ( line->nsizes() == 1 ) ? line->size(0) : line->size(i);
         kvs::ValueArray<kvs::Real32> line_sizes(1);
         if ( line->numberOfSizes() == 1 ) line_sizes[0] = line->size(0);
         else line_sizes[0] = line->size(i);
@@ -691,50 +742,38 @@ void Tubeline::filtering_segment( const kvs::LineObject* line )
             }
         }
 
-        std::vector<kvs::Real32> tmp_vertices;
-        std::vector<kvs::UInt8> tmp_colors;
-        std::vector<kvs::UInt32> tmp_connections;
-        std::vector<kvs::Real32> tmp_normals;
+        const size_t offset = static_cast<size_t>( i );
         this->calculate_tubes(
-            &tmp_vertices,
-            &tmp_colors,
-            &tmp_connections,
-            &tmp_normals,
+            pvertices + offset * m_ndivisions * 6,
+            pcolors + offset * m_ndivisions * ncolor_components,
+            pconnections + offset * m_ndivisions * 4,
+            pnormals + offset * m_ndivisions * 3,
+            offset * m_ndivisions * 2,
             line_vertices,
             line_sizes,
             line_colors,
             nvertices,
             color_type );
+    } );
 
-        vertices.insert( vertices.end(), tmp_vertices.begin(), tmp_vertices.end() );
-        normals.insert( normals.end(), tmp_normals.begin(), tmp_normals.end() );
-        colors.insert( colors.end(), tmp_colors.begin(), tmp_colors.end() );
-
-        const kvs::UInt32 nv = static_cast<kvs::UInt32>( vertices.size() / 3 );
-        const size_t tmp_connections_size = tmp_connections.size();
-        for ( size_t j = 0; j < tmp_connections_size; j++ )
-        {
-            connections.push_back( tmp_connections[j] + nv );
-        }
-    }
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( vertices ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
+    SuperClass::setCoords( vertices );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( normals );
+    SuperClass::setConnections( connections );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Quadrangle );
-    SuperClass::setColorType( ::GetColorType( line ) );
+    SuperClass::setColorType( color_type );
     SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
 }
 
 /*===========================================================================*/
 /**
- *  @brief  Calculates tubeline polygon.
- *  @param  vertices [out] pointer to the vertex array of the polygon object
- *  @param  colors [out] pointer to the color array of the polygon object
- *  @param  connections [out] pointer to the connection array of the polygon object
- *  @param  normals [out] pointer to the normal array of the polygon object
+ *  @brief  Calculates tubeline polygon of a line.
+ *  @param  vertices [out] pointer to the vertex array of the tubes of the line
+ *  @param  colors [out] pointer to the color array of the tubes of the line
+ *  @param  connections [out] pointer to the connection array of the tubes of the line
+ *  @param  normals [out] pointer to the normal array of the tubes of the line
+ *  @param  vertex_offset [in] index of the first vertex of the line
  *  @param  line_vertices [in] vertex array of the line object
  *  @param  line_sizes [in] size array of the line object
  *  @param  line_colors [in] color array of the line object
@@ -743,132 +782,164 @@ void Tubeline::filtering_segment( const kvs::LineObject* line )
  */
 /*===========================================================================*/
 void Tubeline::calculate_tubes(
-    std::vector<kvs::Real32>* vertices,
-    std::vector<kvs::UInt8>* colors,
-    std::vector<kvs::UInt32>* connections,
-    std::vector<kvs::Real32>* normals,
-    const kvs::ValueArray<kvs::Real32> line_vertices,
-    const kvs::ValueArray<kvs::Real32> line_sizes,
-    const kvs::ValueArray<kvs::UInt8> line_colors,
+    kvs::Real32* vertices,
+    kvs::UInt8* colors,
+    kvs::UInt32* connections,
+    kvs::Real32* normals,
+    const size_t vertex_offset,
+    const kvs::ValueArray<kvs::Real32>& line_vertices,
+    const kvs::ValueArray<kvs::Real32>& line_sizes,
+    const kvs::ValueArray<kvs::UInt8>& line_colors,
+    const size_t nvertices,
+    const kvs::PolygonObject::ColorType color_type ) const
+{
+    const size_t nsegments = ( nvertices < 2 ) ? 0 : nvertices - 1;
+    for ( size_t i = 0; i < nsegments; i++ )
+    {
+        this->calculate_tube(
+            vertices,
+            colors,
+            connections,
+            normals,
+            vertex_offset,
+            line_vertices,
+            line_sizes,
+            line_colors,
+            nvertices,
+            color_type,
+            i );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Calculates tubeline polygon of a line segment.
+ *  @param  vertices [out] pointer to the vertex array of the tubes of the line
+ *  @param  colors [out] pointer to the color array of the tubes of the line
+ *  @param  connections [out] pointer to the connection array of the tubes of the line
+ *  @param  normals [out] pointer to the normal array of the tubes of the line
+ *  @param  vertex_offset [in] index of the first vertex of the line
+ *  @param  line_vertices [in] vertex array of the line object
+ *  @param  line_sizes [in] size array of the line object
+ *  @param  line_colors [in] color array of the line object
+ *  @param  nvertices [in] number of vertices
+ *  @param  color_type [in] color type
+ *  @param  segment [in] index of the line segment
+ *
+ *  The first segment is converted to a tube and the other segments are
+ *  converted to a tube and a joint tube, which connects the end circle of the
+ *  previous tube and the start circle of the tube. Since the output position
+ *  of the tubes is determined by the segment index, the segments can be
+ *  calculated independently.
+ */
+/*===========================================================================*/
+void Tubeline::calculate_tube(
+    kvs::Real32* vertices,
+    kvs::UInt8* colors,
+    kvs::UInt32* connections,
+    kvs::Real32* normals,
+    const size_t vertex_offset,
+    const kvs::ValueArray<kvs::Real32>& line_vertices,
+    const kvs::ValueArray<kvs::Real32>& line_sizes,
+    const kvs::ValueArray<kvs::UInt8>& line_colors,
     const size_t nvertices,
-    const kvs::PolygonObject::ColorType color_type )
+    const kvs::PolygonObject::ColorType color_type,
+    const size_t segment ) const
 {
-    // First tube position.
-    kvs::Vector3f start_position( line_vertices[0], line_vertices[1], line_vertices[2] );
-    kvs::Vector3f end_position( line_vertices[3], line_vertices[4], line_vertices[5] );
+    const size_t nvertices_per_tube = m_ndivisions * 2;
+    const size_t ncolors_per_tube = m_ndivisions * ::GetNumberOfColorComponents( color_type );
+    const size_t nconnections_per_tube = m_ndivisions * 4;
+    const size_t nnormals_per_tube = m_ndivisions * 3;
 
-    // Initiali raduis parameters.
-    kvs::Real32 pre_radius  = 0.0f;
-    kvs::Real32 radius = line_sizes[0];
-    kvs::Real32 post_radius = line_sizes[1];
+    // Index of the tube of the segment in the line.
+    const size_t tube = ( segment == 0 ) ? 0 : segment * 2 - 1;
 
     // Calculate vertices that are composed of the circles (cross-sections).
-    std::vector<kvs::Vector3f> start_circle;
-    std::vector<kvs::Vector3f> end_circle;
+    kvs::Vector3f* circles = reinterpret_cast<kvs::Vector3f*>( vertices ) + nvertices_per_tube * tube;
     this->calculate_circles(
-        &start_circle,
-        &end_circle,
-        start_position,
-        end_position,
-        radius,
-        pre_radius,
-        post_radius );
+        circles,
+        circles + m_ndivisions,
+        line_vertices,
+        line_sizes,
+        nvertices,
+        segment );
 
     // Calculate colors at the cross-sections.
-    kvs::RGBColor start_color( line_colors[0], line_colors[1], line_colors[2] );
-    kvs::RGBColor end_color( line_colors[3], line_colors[4], line_colors[5] );
-
-    size_t vertex_number = 0;
-
-    this->set_vertices( vertices, start_circle, end_circle );
-    this->set_colors( colors, start_color, end_color, color_type );
-    this->set_connections_and_normals( connections, normals, start_circle, end_circle, vertex_number );
-
-    const size_t nloops = nvertices - 1;
-    for ( size_t i = 1, index = 3; i < nloops; i++, index += 3 )
-    {
-        // Update the tube position.
-        const kvs::Real32 v0_x = line_vertices[ index + 0 ];
-        const kvs::Real32 v0_y = line_vertices[ index + 1 ];
-        const kvs::Real32 v0_z = line_vertices[ index + 2 ];
-        const kvs::Real32 v1_x = line_vertices[ index + 3 ];
-        const kvs::Real32 v1_y = line_vertices[ index + 4 ];
-        const kvs::Real32 v1_z = line_vertices[ index + 5 ];
-        start_position = kvs::Vector3f( v0_x, v0_y, v0_z );
-        end_position = kvs::Vector3f( v1_x, v1_y, v1_z );
-
-        // Update the reduis parameters.
-        pre_radius = line_sizes[i-1];
-        radius = line_sizes[i];
-        post_radius = ( i == nvertices - 2 ) ? 0.0f : line_sizes[i+1];
-
-        // Save parameters for the pre-tube.
-        const std::vector<kvs::Vector3f> pre_end_circle = end_circle;
-        const kvs::RGBColor pre_end_color = end_color;
-
-        // Update the vertices of the tube's circles.
-        start_circle.clear();
-        end_circle.clear();
-        this->calculate_circles(
-            &start_circle,
-            &end_circle,
-            start_position,
-            end_position,
-            radius,
-            pre_radius,
-            post_radius );
-
-        // tube + joint
-        vertex_number = m_ndivisions * 2 * i + m_ndivisions * 2 * ( i - 1 );
-
-        // Update the colors of the circles.
-        const kvs::UInt8 c0_r = line_colors[ index + 0 ];
-        const kvs::UInt8 c0_g = line_colors[ index + 1 ];
-        const kvs::UInt8 c0_b = line_colors[ index + 2 ];
-        const kvs::UInt8 c1_r = line_colors[ index + 3 ];
-        const kvs::UInt8 c1_g = line_colors[ index + 4 ];
-        const kvs::UInt8 c1_b = line_colors[ index + 5 ];
-        start_color = kvs::RGBColor( c0_r, c0_g, c0_b );
-        end_color = ( i == nvertices-1 ) ? start_color : kvs::RGBColor( c1_r, c1_g, c1_b );
-
-        // Set the data of the polygon object.
-        this->set_vertices( vertices, start_circle, end_circle );
-        this->set_colors( colors, start_color, end_color, color_type );
-        this->set_connections_and_normals( connections, normals, start_circle, end_circle, vertex_number );
-
-        // Calculate joint tube.
-        vertex_number += m_ndivisions * 2;
-        this->set_vertices( vertices, pre_end_circle, start_circle );
-        this->set_colors( colors, pre_end_color, start_color, color_type );
-        this->set_connections_and_normals( connections, normals, pre_end_circle, start_circle, vertex_number );
-    }
+    const kvs::RGBColor start_color = ::GetColor( line_colors, segment );
+    const kvs::RGBColor end_color = ( color_type == kvs::PolygonObject::VertexColor ) ?
+        ::GetColor( line_colors, segment + 1 ) : start_color;
+
+    size_t vertex_number = vertex_offset + nvertices_per_tube * tube;
+    this->set_colors( colors + ncolors_per_tube * tube, start_color, end_color, color_type );
+    this->set_connections_and_normals(
+        connections + nconnections_per_tube * tube,
+        normals + nnormals_per_tube * tube,
+        circles,
+        vertex_number );
+    if ( segment == 0 ) { return; }
+
+    // Calculate joint tube. The end circle of the previous tube is calculated
+    // again instead of referring to the output of the other segment.
+    kvs::Vector3f* joint_circles = circles + nvertices_per_tube;
+    this->calculate_circles(
+        NULL,
+        joint_circles,
+        line_vertices,
+        line_sizes,
+        nvertices,
+        segment - 1 );
+    std::copy( circles, circles + m_ndivisions, joint_circles + m_ndivisions );
+
+    vertex_number += nvertices_per_tube;
+    this->set_colors( colors + ncolors_per_tube * ( tube + 1 ), start_color, start_color, color_type );
+    this->set_connections_and_normals(
+        connections + nconnections_per_tube * ( tube + 1 ),
+        normals + nnormals_per_tube * ( tube + 1 ),
+        joint_circles,
+        vertex_number );
 }
 
 /*===========================================================================*/
 /**
- *  @brief  Calculates vertices on the circles.
- *  @param  start_circle [out] pointer to the vertex array of the start circle
+ *  @brief  Calculates vertices on the circles of the line segment.
+ *  @param  start_circle [out] pointer to the vertex array of the start circle (can be NULL)
  *  @param  end_circle [out] pointer to the vertex array of the end circle
- *  @param  start_position [in] position of the start vertex
- *  @param  end_position [in] position of the end vertex
- *  @param  radius [in] radius
- *  @param  pre_radius [in] pre-radius
- *  @param  post_radius [in] post-radius
+ *  @param  line_vertices [in] vertex array of the line object
+ *  @param  line_sizes [in] size array of the line object
+ *  @param  nvertices [in] number of vertices
+ *  @param  segment [in] index of the line segment
  */
 /*===========================================================================*/
 void Tubeline::calculate_circles(
-    std::vector<kvs::Vector3f>* start_circle,
-    std::vector<kvs::Vector3f>* end_circle,
-    const kvs::Vector3f& start_position,
-    const kvs::Vector3f& end_position,
-    const float radius,
-    const float pre_radius,
-    const float post_radius )
+    kvs::Vector3f* start_circle,
+    kvs::Vector3f* end_circle,
+    const kvs::ValueArray<kvs::Real32>& line_vertices,
+    const kvs::ValueArray<kvs::Real32>& line_sizes,
+    const size_t nvertices,
+    const size_t segment ) const
 {
+    // Tube position.
+    const kvs::Real32* v = line_vertices.data() + segment * 3;
+    const kvs::Vector3f start_position( v[0], v[1], v[2] );
+    const kvs::Vector3f end_position( v[3], v[4], v[5] );
+
+    // Radius parameters.
+    const float radius = line_sizes[ segment ];
+    float pre_radius = 0.0f;
+    float post_radius = 0.0f;
+    if ( segment == 0 )
+    {
+        post_radius = ( line_sizes.size() > 1 ) ? line_sizes[1] : 0.0f;
+    }
+    else
+    {
+        pre_radius = line_sizes[ segment - 1 ];
+        post_radius = ( segment == nvertices - 2 ) ? 0.0f : line_sizes[ segment + 1 ];
+    }
+
     const kvs::Vector3f vec1 = end_position - start_position;
     const float length = static_cast<float>( vec1.length() );
 
-    //static kvs::Vector3f base( 0.0f, 0.0f, 1.0f ); ???
     const kvs::Vector3f base( 0.0f, 0.0f, 1.0f );
     const kvs::Vector3f axis = base.cross( vec1 );
     const float radian = static_cast<float>( std::acos( base.dot( vec1 ) / ( base.length() * vec1.length() ) ) );
@@ -891,39 +962,8 @@ void Tubeline::calculate_circles(
         const float x = radius * std::cos( rad );
         const float y = radius * std::sin( rad );
 
-        const kvs::Vector3f s_pos = mat * kvs::Vector3f( x, y, min_z ) + pos;
-        start_circle->push_back( s_pos );
-
-        const kvs::Vector3f e_pos = mat * kvs::Vector3f( x, y, max_z ) + pos;
-        end_circle->push_back( e_pos );
-    }
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Sets a vertex array.
- *  @param  vertices [out] pointer to the vertex array
- *  @param  start_circle [in] vertex array of the start circle
- *  @param  end_circle [in] vertex array of the end circle
- */
-/*===========================================================================*/
-void Tubeline::set_vertices(
-    std::vector<kvs::Real32>* vertices,
-    const std::vector<kvs::Vector3f>& start_circle,
-    const std::vector<kvs::Vector3f>& end_circle )
-{
-    for ( size_t i = 0; i < m_ndivisions; i++ )
-    {
-        vertices->push_back( start_circle[i].x() );
-        vertices->push_back( start_circle[i].y() );
-        vertices->push_back( start_circle[i].z() );
-    }
-
-    for ( size_t i = 0; i < m_ndivisions; i++ )
-    {
-        vertices->push_back( end_circle[i].x() );
-        vertices->push_back( end_circle[i].y() );
-        vertices->push_back( end_circle[i].z() );
+        if ( start_circle ) { start_circle[i] = mat * kvs::Vector3f( x, y, min_z ) + pos; }
+        end_circle[i] = mat * kvs::Vector3f( x, y, max_z ) + pos;
     }
 }
 
@@ -937,25 +977,25 @@ void Tubeline::set_vertices(
  */
 /*===========================================================================*/
 void Tubeline::set_colors(
-    std::vector<kvs::UInt8>* colors,
+    kvs::UInt8* colors,
     const kvs::RGBColor& start_color,
     const kvs::RGBColor& end_color,
-    const kvs::PolygonObject::ColorType color_type )
+    const kvs::PolygonObject::ColorType color_type ) const
 {
     for ( size_t i = 0; i < m_ndivisions; i++ )
     {
-        colors->push_back( start_color.r() );
-        colors->push_back( start_color.g() );
-        colors->push_back( start_color.b() );
+        *(colors++) = start_color.r();
+        *(colors++) = start_color.g();
+        *(colors++) = start_color.b();
     }
 
     if( color_type == kvs::PolygonObject::VertexColor )
     {
         for ( size_t i = 0; i < m_ndivisions; i++ )
         {
-            colors->push_back( end_color.r() );
-            colors->push_back( end_color.g() );
-            colors->push_back( end_color.b() );
+            *(colors++) = end_color.r();
+            *(colors++) = end_color.g();
+            *(colors++) = end_color.b();
         }
     }
 }
@@ -965,30 +1005,18 @@ void Tubeline::set_colors(
  *  @brief  Sets a connection array and a normal array.
  *  @param  connections [out] pointer to the connection array
  *  @param  normals [out] pointer to the normal array
- *  @param  start_circle [in] vertex array of the start circle
- *  @param  end_circle [in] vertex array of the end circle
+ *  @param  circles [in] vertex array of the start circle and the end circle
  *  @param  vertex_number [in] vertex number
  */
 /*===========================================================================*/
 void Tubeline::set_connections_and_normals(
-    std::vector<kvs::UInt32>* connections,
-    std::vector<kvs::Real32>* normals,
-    const std::vector<kvs::Vector3f>& start_circle,
-    const std::vector<kvs::Vector3f>& end_circle,
-    const size_t vertex_number )
+    kvs::UInt32* connections,
+    kvs::Real32* normals,
+    const kvs::Vector3f* circles,
+    const size_t vertex_number ) const
 {
-    // create vertex index list
-    std::vector<kvs::UInt32> v_ids;
-    std::vector<kvs::UInt32> n_ids;
-
-    for ( size_t i = 0; i < m_ndivisions; i++ )
-    {
-        const kvs::UInt32 index = static_cast<kvs::UInt32>( i );
-        v_ids.push_back( vertex_number + index );
-        n_ids.push_back( index );
-    }
-    v_ids.push_back( vertex_number );
-    n_ids.push_back( 0 );
+    const kvs::Vector3f* start_circle = circles;
+    const kvs::Vector3f* end_circle = circles + m_ndivisions;
 
    /*  Simple example. Triangle pole.
     *
@@ -1003,17 +1031,22 @@ void Tubeline::set_connections_and_normals(
     */
     for ( size_t i = 0; i < m_ndivisions; i++ )
     {
-        connections->push_back( v_ids[i] + m_ndivisions );
-        connections->push_back( v_ids[i+1] + m_ndivisions );
-        connections->push_back( v_ids[i+1] );
-        connections->push_back( v_ids[i]   );
-
-        const kvs::Vector3f v1 = start_circle[n_ids[i+1]] - start_circle[n_ids[i]];
-        const kvs::Vector3f v2 = end_circle[n_ids[i+1]] - start_circle[n_ids[i]];
+        const size_t i0 = i;
+        const size_t i1 = ( i + 1 == m_ndivisions ) ? 0 : i + 1;
+        const kvs::UInt32 id0 = static_cast<kvs::UInt32>( vertex_number + i0 );
+        const kvs::UInt32 id1 = static_cast<kvs::UInt32>( vertex_number + i1 );
+        const kvs::UInt32 n = static_cast<kvs::UInt32>( m_ndivisions );
+        *(connections++) = id0 + n;
+        *(connections++) = id1 + n;
+        *(connections++) = id1;
+        *(connections++) = id0;
+
+        const kvs::Vector3f v1 = start_circle[i1] - start_circle[i0];
+        const kvs::Vector3f v2 = end_circle[i1] - start_circle[i0];
         const kvs::Vector3f norm = -v1.cross( v2 );
-        normals->push_back( norm.x() );
-        normals->push_back( norm.y() );
-        normals->push_back( norm.z() );
+        *(normals++) = norm.x();
+        *(normals++) = norm.y();
+        *(normals++) = norm.z();
     }
 }
 
@@ -19,6 +19,10 @@ namespace kvs
 /*===========================================================================*/
 /**
  *  @brief  Create tubeline from line object.
+ *
+ *  The number of the tubes (including the joints) of each line is counted
+ *  first, and the tubes are generated in parallel into the preallocated
+ *  arrays at the offsets given by the prefix sum of the counts.
  */
 /*===========================================================================*/
 class Tubeline : public kvs::FilterBase, public kvs::PolygonObject
@@ -51,42 +55,49 @@ protected:
 protected:
 
     void calculate_tubes(
-        std::vector<kvs::Real32>* vertices,
-        std::vector<kvs::UInt8>* colors,
-        std::vector<kvs::UInt32>* connections,
-        std::vector<kvs::Real32>* normals,
-        const kvs::ValueArray<kvs::Real32> line_vertices,
-        const kvs::ValueArray<kvs::Real32> line_sizes,
-        const kvs::ValueArray<kvs::UInt8> line_colors,
+        kvs::Real32* vertices,
+        kvs::UInt8* colors,
+        kvs::UInt32* connections,
+        kvs::Real32* normals,
+        const size_t vertex_offset,
+        const kvs::ValueArray<kvs::Real32>& line_vertices,
+        const kvs::ValueArray<kvs::Real32>& line_sizes,
+        const kvs::ValueArray<kvs::UInt8>& line_colors,
         const size_t nvertices,
-        const kvs::PolygonObject::ColorType color_type );
+        const kvs::PolygonObject::ColorType color_type ) const;
+
+    void calculate_tube(
+        kvs::Real32* vertices,
+        kvs::UInt8* colors,
+        kvs::UInt32* connections,
+        kvs::Real32* normals,
+        const size_t vertex_offset,
+        const kvs::ValueArray<kvs::Real32>& line_vertices,
+        const kvs::ValueArray<kvs::Real32>& line_sizes,
+        const kvs::ValueArray<kvs::UInt8>& line_colors,
+        const size_t nvertices,
+        const kvs::PolygonObject::ColorType color_type,
+        const size_t segment ) const;
 
     void calculate_circles(
-        std::vector<kvs::Vector3f>* start_circle,
-        std::vector<kvs::Vector3f>* end_circle,
-        const kvs::Vector3f& start_postion,
-        const kvs::Vector3f& end_position,
-        const float radius,
-        const float pre_radius,
-        const float post_radius );
-
-    void set_vertices(
-        std::vector<kvs::Real32>* vertices,
-        const std::vector<kvs::Vector3f>& start_circle,
-        const std::vector<kvs::Vector3f>& end_circle );
+        kvs::Vector3f* start_circle,
+        kvs::Vector3f* end_circle,
+        const kvs::ValueArray<kvs::Real32>& line_vertices,
+        const kvs::ValueArray<kvs::Real32>& line_sizes,
+        const size_t nvertices,
+        const size_t segment ) const;
 
     void set_colors(
-        std::vector<kvs::UInt8>* colors,
+        kvs::UInt8* colors,
         const kvs::RGBColor& start_color,
         const kvs::RGBColor& end_color,
-        const kvs::PolygonObject::ColorType color_type );
+        const kvs::PolygonObject::ColorType color_type ) const;
 
     void set_connections_and_normals(
-        std::vector<kvs::UInt32>* connections,
-        std::vector<kvs::Real32>* normals,
-        const std::vector<kvs::Vector3f>& start_circle,
-        const std::vector<kvs::Vector3f>& end_circle,
-        const size_t vertex_number );
+        kvs::UInt32* connections,
+        kvs::Real32* normals,
+        const kvs::Vector3f* circles,
+        const size_t vertex_number ) const;
 
 #if 1 // KVS_ENABLE_DEPRECATED
 public:
@@ -8,6 +8,10 @@
 #include "InverseDistanceWeighting.h"
 #include <kvs/UnstructuredVolumeObject>
 #include <kvs/PrismaticCell>
+#include <kvs/Parallel>
+#include <vector>
+#include <cmath>
+#include <algorithm>
 
 
 namespace
@@ -44,12 +48,74 @@ const kvs::UnstructuredVolumeObject* Cast( const kvs::ObjectBase* object )
     return kvs::UnstructuredVolumeObject::DownCast( volume );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns a q-value calculated from the input tensor value.
+ *  @param  T [in] tensor value
+ *  @return q-value
+ */
+/*===========================================================================*/
+kvs::Real32 Q( const kvs::Mat3& T )
+{
+    const kvs::Real32 t00 = T[0][0];
+    const kvs::Real32 t11 = T[1][1];
+    const kvs::Real32 t22 = T[2][2];
+    const kvs::Real32 t01 = T[0][1];
+    const kvs::Real32 t10 = T[1][0];
+    const kvs::Real32 t12 = T[1][2];
+    const kvs::Real32 t21 = T[2][1];
+    const kvs::Real32 t02 = T[0][2];
+    const kvs::Real32 t20 = T[2][0];
+    return t00 * t11 + t11 * t22 + t22 * t00 - t01 * t10 - t12 * t21 - t02 * t20;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Stores the vector value to the array.
+ *  @param  v [in] vector value
+ *  @param  values [out] pointer to the array
+ */
+/*===========================================================================*/
+inline void Store( const kvs::Vec3& v, kvs::Real32* values )
+{
+    values[0] = v[0];
+    values[1] = v[1];
+    values[2] = v[2];
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Stores the tensor value to the array.
+ *  @param  t [in] tensor value
+ *  @param  values [out] pointer to the array
+ */
+/*===========================================================================*/
+inline void Store( const kvs::Mat3& t, kvs::Real32* values )
+{
+    values[0] = t[0][0]; values[1] = t[0][1]; values[2] = t[0][2];
+    values[3] = t[1][0]; values[4] = t[1][1]; values[5] = t[1][2];
+    values[6] = t[2][0]; values[7] = t[2][1]; values[8] = t[2][2];
+}
+
 } // end of namespace
 
 
 namespace kvs
 {
 
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new UnstructuredGradient class.
+ */
+/*===========================================================================*/
+UnstructuredGradient::UnstructuredGradient():
+    kvs::FilterBase(),
+    kvs::UnstructuredVolumeObject(),
+    m_enable_magnitude( false ),
+    m_enable_qcriterion( false )
+{
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Constructs an UnstructuredGradient class.
@@ -58,7 +124,9 @@ namespace kvs
 /*===========================================================================*/
 UnstructuredGradient::UnstructuredGradient( const kvs::UnstructuredVolumeObject* volume ):
     kvs::FilterBase(),
-    kvs::UnstructuredVolumeObject()
+    kvs::UnstructuredVolumeObject(),
+    m_enable_magnitude( false ),
+    m_enable_qcriterion( false )
 {
     this->exec( volume );
 }
@@ -68,6 +136,10 @@ UnstructuredGradient::UnstructuredGradient( const kvs::UnstructuredVolumeObject*
  *  @brief  Executes gradient calculation.
  *  @param  object [in] pointer to the input volume object
  *  @return Calculated gradient volume object
+ *
+ *  If enabled, the gradient magnitudes (Frobenius norms for the tensors) and
+ *  the q-values are calculated in the same pass, which can be obtained with
+ *  magnitudes() and qvalues().
  */
 /*===========================================================================*/
 UnstructuredGradient::SuperClass* UnstructuredGradient::exec( const kvs::ObjectBase* object )
@@ -75,6 +147,10 @@ UnstructuredGradient::SuperClass* UnstructuredGradient::exec( const kvs::ObjectB
     const kvs::UnstructuredVolumeObject* volume = ::Cast( object );
     if ( !volume ) { return NULL; }
 
+    m_magnitudes.release();
+    m_qvalues.release();
+    if ( !volume->hasNodeToCellMap() ) { volume->updateNodeToCellMap(); }
+
     if ( volume->veclen() == 1 )
     {
         this->scalar_gradient( volume );
@@ -91,35 +167,57 @@ UnstructuredGradient::SuperClass* UnstructuredGradient::exec( const kvs::ObjectB
 /**
  *  @brief  Calculates gradient vectors from scalar values.
  *  @param  volume [in] pointer to the input volume object
+ *
+ *  The gradient vectors of the cells are calculated at the cell centers, and
+ *  then the gradient vector of each node is gathered from the cells sharing
+ *  the node with the inverse distance weighting.
  */
 /*===========================================================================*/
 void UnstructuredGradient::scalar_gradient( const kvs::UnstructuredVolumeObject* volume )
 {
-    const size_t ncells = volume->numberOfCells();
-    const size_t nnodes = volume->numberOfNodes();
-    const kvs::UInt32* connections = volume->connections().data();
-
-    kvs::InverseDistanceWeighting<kvs::Vec3> idw( nnodes );
-    kvs::PrismaticCell cell( volume );
-    const kvs::Vec3 center = cell.localCenter();
-    for ( size_t i = 0; i < ncells; i++ )
-    {
-        cell.bindCell( i );
-        cell.setLocalPoint( center );
-        const kvs::Vec3 V = cell.gradientVector();
+    const long ncells = static_cast<long>( volume->numberOfCells() );
+    const long nnodes = static_cast<long>( volume->numberOfNodes() );
+
+    std::vector<kvs::Vec3> gradients( ncells );
+    std::vector<kvs::Vec3> centers( ncells );
 
-        const kvs::Vec3 c = cell.center();
-        for ( size_t j = 0; j < cell.numberOfCellNodes(); j++ )
+    // The cells are processed by blocks, so that the cell interpolator is
+    // created for each block rather than for each cell.
+    const long block_size = 1024;
+    const long nblocks = ( ncells + block_size - 1 ) / block_size;
+    kvs::ParallelFor( 0L, nblocks, [&]( const long block )
+    {
+        kvs::PrismaticCell cell( volume );
+        const kvs::Vec3 center = cell.localCenter();
+        const long end = std::min( ncells, ( block + 1 ) * block_size );
+        for ( long i = block * block_size; i < end; i++ )
         {
-            const kvs::UInt32 id = *( connections++ );
-            const kvs::Real32 d = ( cell.coord(j) - c ).length();
-            idw.insert( id, V, d );
+            cell.bindCell( kvs::UInt32( i ) );
+            cell.setLocalPoint( center );
+            gradients[i] = cell.gradientVector();
+            centers[i] = cell.center();
         }
-    }
+    } );
+
+    const kvs::Vec3* coords = reinterpret_cast<const kvs::Vec3*>( volume->coords().data() );
+    const kvs::UInt64* offsets = volume->nodeCellOffsets().data();
+    const kvs::UInt32* indices = volume->nodeCellIndices().data();
+    kvs::ValueArray<kvs::Real32> values( nnodes * 3 );
+    if ( m_enable_magnitude ) { m_magnitudes.allocate( nnodes ); }
+
+    kvs::ParallelFor( 0L, nnodes, [&]( const long i )
+    {
+        const kvs::UInt32* cells = indices + offsets[i];
+        const size_t n = static_cast<size_t>( offsets[ i + 1 ] - offsets[i] );
+        const kvs::Vec3 V = kvs::InverseDistanceWeighting<kvs::Vec3>::Interpolate(
+            coords[i], cells, n, gradients.data(), centers.data() );
+        ::Store( V, values.data() + i * 3 );
+        if ( m_enable_magnitude ) { m_magnitudes[i] = static_cast<kvs::Real32>( V.length() ); }
+    } );
 
     SuperClass::shallowCopy( *volume );
     SuperClass::setVeclen( 3 );
-    SuperClass::setValues( kvs::AnyValueArray( idw.serialize() ) );
+    SuperClass::setValues( kvs::AnyValueArray( values ) );
     SuperClass::updateMinMaxValues();
 }
 
@@ -127,35 +225,68 @@ void UnstructuredGradient::scalar_gradient( const kvs::UnstructuredVolumeObject*
 /**
  *  @brief  Calculates gradient tensors from vector values.
  *  @param  volume [in] pointer to the input volume object
+ *
+ *  If the Q-criterion output is enabled, the q-values of the cells are also
+ *  gathered to the nodes in the same pass as done in UnstructuredQCriterion.
  */
 /*===========================================================================*/
 void UnstructuredGradient::vector_gradient( const kvs::UnstructuredVolumeObject* volume )
 {
-    const size_t ncells = volume->numberOfCells();
-    const size_t nnodes = volume->numberOfNodes();
-    const kvs::UInt32* connections = volume->connections().data();
-
-    kvs::InverseDistanceWeighting<kvs::Mat3> idw( nnodes );
-    kvs::PrismaticCell cell( volume );
-    const kvs::Vec3 center = cell.localCenter();
-    for ( size_t i = 0; i < ncells; i++ )
+    const long ncells = static_cast<long>( volume->numberOfCells() );
+    const long nnodes = static_cast<long>( volume->numberOfNodes() );
+
+    std::vector<kvs::Mat3> gradients( ncells );
+    std::vector<kvs::Vec3> centers( ncells );
+    std::vector<kvs::Real32> qvalues( m_enable_qcriterion ? ncells : 0 );
+
+    // The cells are processed by blocks, so that the cell interpolator is
+    // created for each block rather than for each cell.
+    const long block_size = 1024;
+    const long nblocks = ( ncells + block_size - 1 ) / block_size;
+    kvs::ParallelFor( 0L, nblocks, [&]( const long block )
     {
-        cell.bindCell( i );
-        cell.setLocalPoint( center );
-        const kvs::Mat3 T = cell.gradientTensor();
+        kvs::PrismaticCell cell( volume );
+        const kvs::Vec3 center = cell.localCenter();
+        const long end = std::min( ncells, ( block + 1 ) * block_size );
+        for ( long i = block * block_size; i < end; i++ )
+        {
+            cell.bindCell( kvs::UInt32( i ) );
+            cell.setLocalPoint( center );
+            gradients[i] = cell.gradientTensor();
+            centers[i] = cell.center();
+            if ( m_enable_qcriterion ) { qvalues[i] = ::Q( gradients[i] ); }
+        }
+    } );
 
-        const kvs::Vec3 c = cell.center();
-        for ( size_t j = 0; j < cell.numberOfCellNodes(); j++ )
+    const kvs::Vec3* coords = reinterpret_cast<const kvs::Vec3*>( volume->coords().data() );
+    const kvs::UInt64* offsets = volume->nodeCellOffsets().data();
+    const kvs::UInt32* indices = volume->nodeCellIndices().data();
+    kvs::ValueArray<kvs::Real32> values( nnodes * 9 );
+    if ( m_enable_magnitude ) { m_magnitudes.allocate( nnodes ); }
+    if ( m_enable_qcriterion ) { m_qvalues.allocate( nnodes ); }
+
+    kvs::ParallelFor( 0L, nnodes, [&]( const long i )
+    {
+        const kvs::UInt32* cells = indices + offsets[i];
+        const size_t n = static_cast<size_t>( offsets[ i + 1 ] - offsets[i] );
+        const kvs::Mat3 T = kvs::InverseDistanceWeighting<kvs::Mat3>::Interpolate(
+            coords[i], cells, n, gradients.data(), centers.data() );
+        ::Store( T, values.data() + i * 9 );
+        if ( m_enable_magnitude )
         {
-            const kvs::UInt32 id = *( connections++ );
-            const kvs::Real32 d = ( cell.coord(j) - c ).length();
-            idw.insert( id, T, d );
+            const double t2 = T[0].squaredLength() + T[1].squaredLength() + T[2].squaredLength();
+            m_magnitudes[i] = static_cast<kvs::Real32>( std::sqrt( t2 ) );
         }
-    }
+        if ( m_enable_qcriterion )
+        {
+            m_qvalues[i] = kvs::InverseDistanceWeighting<kvs::Real32>::Interpolate(
+                coords[i], cells, n, qvalues.data(), centers.data() );
+        }
+    } );
 
     SuperClass::shallowCopy( *volume );
     SuperClass::setVeclen( 9 );
-    SuperClass::setValues( kvs::AnyValueArray( idw.serialize() ) );
+    SuperClass::setValues( kvs::AnyValueArray( values ) );
     SuperClass::updateMinMaxValues();
 }
 
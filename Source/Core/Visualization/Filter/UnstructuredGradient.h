@@ -8,6 +8,7 @@
 #include <kvs/Module>
 #include <kvs/FilterBase>
 #include <kvs/UnstructuredVolumeObject>
+#include <kvs/ValueArray>
 
 
 namespace kvs
@@ -24,9 +25,30 @@ class UnstructuredGradient : public kvs::FilterBase, public kvs::UnstructuredVol
     kvsModuleBaseClass( kvs::FilterBase );
     kvsModuleSuperClass( kvs::UnstructuredVolumeObject );
 
+private:
+
+    bool m_enable_magnitude; ///< flag for calculating the gradient magnitudes
+    bool m_enable_qcriterion; ///< flag for calculating the q-values (vector input only)
+    kvs::ValueArray<kvs::Real32> m_magnitudes; ///< gradient magnitude of each node
+    kvs::ValueArray<kvs::Real32> m_qvalues; ///< q-value of each node
+
 public:
 
+    UnstructuredGradient();
     UnstructuredGradient( const kvs::UnstructuredVolumeObject* volume );
+
+    void setEnabledMagnitude( const bool enable ) { m_enable_magnitude = enable; }
+    void enableMagnitude() { this->setEnabledMagnitude( true ); }
+    void disableMagnitude() { this->setEnabledMagnitude( false ); }
+    bool isEnabledMagnitude() const { return m_enable_magnitude; }
+    void setEnabledQCriterion( const bool enable ) { m_enable_qcriterion = enable; }
+    void enableQCriterion() { this->setEnabledQCriterion( true ); }
+    void disableQCriterion() { this->setEnabledQCriterion( false ); }
+    bool isEnabledQCriterion() const { return m_enable_qcriterion; }
+
+    const kvs::ValueArray<kvs::Real32>& magnitudes() const { return m_magnitudes; }
+    const kvs::ValueArray<kvs::Real32>& qvalues() const { return m_qvalues; }
+
     SuperClass* exec( const kvs::ObjectBase* object );
 
 private:
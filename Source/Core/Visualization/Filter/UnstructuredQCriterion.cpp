@@ -10,6 +10,9 @@
 #include <map>
 #include <kvs/Type>
 #include <kvs/UnstructuredVolumeObject>
+#include <kvs/Parallel>
+#include <vector>
+#include <algorithm>
 
 
 namespace
@@ -187,32 +190,47 @@ UnstructuredQCriterion::SuperClass* UnstructuredQCriterion::exec( const kvs::Obj
 /*===========================================================================*/
 void UnstructuredQCriterion::qvalues_from_vectors( const kvs::UnstructuredVolumeObject* volume )
 {
-    const kvs::UInt32* connections = volume->connections().data();
-    const size_t ncells = volume->numberOfCells();
-    const size_t nnodes = volume->numberOfNodes();
-
-    kvs::InverseDistanceWeighting<kvs::Real32> idw( nnodes );
-    kvs::PrismaticCell cell( volume );
-    const kvs::Vec3 center = cell.localCenter();
-    for ( size_t i = 0; i < ncells; i++ )
-    {
-        cell.bindCell( i );
-        cell.setLocalPoint( center );
-        const kvs::Mat3 T = cell.gradientTensor();
-        const kvs::Real32 Q = ::Q( T );
-
-        const kvs::Vec3 c = cell.center();
-        for ( size_t j = 0; j < cell.numberOfCellNodes(); j++ )
+    if ( !volume->hasNodeToCellMap() ) { volume->updateNodeToCellMap(); }
+
+    const long ncells = static_cast<long>( volume->numberOfCells() );
+    const long nnodes = static_cast<long>( volume->numberOfNodes() );
+
+    std::vector<kvs::Real32> qvalues( ncells );
+    std::vector<kvs::Vec3> centers( ncells );
+
+    // The cells are processed by blocks, so that the cell interpolator is
+    // created for each block rather than for each cell.
+    const long block_size = 1024;
+    const long nblocks = ( ncells + block_size - 1 ) / block_size;
+    kvs::ParallelFor( 0L, nblocks, [&]( const long block )
+    {
+        kvs::PrismaticCell cell( volume );
+        const kvs::Vec3 center = cell.localCenter();
+        const long end = std::min( ncells, ( block + 1 ) * block_size );
+        for ( long i = block * block_size; i < end; i++ )
         {
-            const kvs::UInt32 id = *( connections++ );
-            const kvs::Real32 d = ( cell.coord(j) - c ).length();
-            idw.insert( id, Q, d );
+            cell.bindCell( kvs::UInt32( i ) );
+            cell.setLocalPoint( center );
+            qvalues[i] = ::Q( cell.gradientTensor() );
+            centers[i] = cell.center();
         }
-    }
+    } );
+
+    // Gather the q-values of the cells sharing each node.
+    const kvs::Vec3* coords = reinterpret_cast<const kvs::Vec3*>( volume->coords().data() );
+    const kvs::UInt64* offsets = volume->nodeCellOffsets().data();
+    const kvs::UInt32* indices = volume->nodeCellIndices().data();
+    kvs::ValueArray<kvs::Real32> values( nnodes );
+    kvs::ParallelFor( 0L, nnodes, [&]( const long i )
+    {
+        const size_t n = static_cast<size_t>( offsets[ i + 1 ] - offsets[i] );
+        values[i] = kvs::InverseDistanceWeighting<kvs::Real32>::Interpolate(
+            coords[i], indices + offsets[i], n, qvalues.data(), centers.data() );
+    } );
 
     SuperClass::shallowCopy( *volume );
     SuperClass::setVeclen( 1 );
-    SuperClass::setValues( kvs::AnyValueArray( idw.serialize() ) );
+    SuperClass::setValues( kvs::AnyValueArray( values ) );
     SuperClass::updateMinMaxValues();
 }
 
@@ -224,14 +242,14 @@ void UnstructuredQCriterion::qvalues_from_vectors( const kvs::UnstructuredVolume
 /*===========================================================================*/
 void UnstructuredQCriterion::qvalues_from_tensors( const kvs::UnstructuredVolumeObject* volume )
 {
-    const size_t nnodes = volume->numberOfNodes();
+    const long nnodes = static_cast<long>( volume->numberOfNodes() );
 
     kvs::ValueArray<kvs::Real32> values( nnodes );
-    for ( size_t i = 0; i < nnodes; i++ )
+    kvs::ParallelFor( 0L, nnodes, [&]( const long i )
     {
         const kvs::Mat3 T = ::Tensor( volume, i );
         values[i] = ::Q( T );
-    }
+    } );
 
     SuperClass::shallowCopy( *volume );
     SuperClass::setVeclen( 1 );
@@ -32,7 +32,8 @@ ImageImporter::ImageImporter()
 /*===========================================================================*/
 ImageImporter::ImageImporter( const std::string& filename )
 {
-    if ( kvs::KVSMLImageObject::CheckExtension( filename ) )
+    if ( kvs::KVSMLImageObject::CheckExtension( filename ) ||
+         kvs::KVSBObject::CheckExtension( filename ) )
     {
         BaseClass::setSuccess( SuperClass::read( filename ) );
     }
@@ -228,7 +229,8 @@ ImageImporter::SuperClass* ImageImporter::exec( const kvs::FileFormatBase* file_
         return NULL;
     }
 
-    if ( dynamic_cast<const kvs::KVSMLImageObject*>( file_format ) )
+    if ( dynamic_cast<const kvs::KVSMLImageObject*>( file_format ) ||
+         dynamic_cast<const kvs::KVSBObject*>( file_format ) )
     {
         BaseClass::setSuccess( SuperClass::read( file_format->filename() ) );
     }
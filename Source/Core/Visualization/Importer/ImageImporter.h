@@ -10,6 +10,7 @@
 #include <kvs/Module>
 #include <kvs/ImageObject>
 #include <kvs/KVSMLImageObject>
+#include <kvs/KVSBObject>
 #include <kvs/Bmp>
 #include <kvs/Tiff>
 #include <kvs/Ppm>
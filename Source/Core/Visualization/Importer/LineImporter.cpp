@@ -32,7 +32,8 @@ LineImporter::LineImporter()
 /*===========================================================================*/
 LineImporter::LineImporter( const std::string& filename )
 {
-    if ( kvs::KVSMLLineObject::CheckExtension( filename ) )
+    if ( kvs::KVSMLLineObject::CheckExtension( filename ) ||
+         kvs::KVSBObject::CheckExtension( filename ) )
     {
         BaseClass::setSuccess( SuperClass::read( filename ) );
     }
@@ -80,7 +81,8 @@ LineImporter::SuperClass* LineImporter::exec( const kvs::FileFormatBase* file_fo
         return NULL;
     }
 
-    if ( dynamic_cast<const kvs::KVSMLLineObject*>( file_format ) )
+    if ( dynamic_cast<const kvs::KVSMLLineObject*>( file_format ) ||
+         dynamic_cast<const kvs::KVSBObject*>( file_format ) )
     {
         BaseClass::setSuccess( SuperClass::read( file_format->filename() ) );
     }
@@ -11,6 +11,7 @@
 #include <kvs/Module>
 #include <kvs/LineObject>
 #include <kvs/KVSMLLineObject>
+#include <kvs/KVSBObject>
 
 
 namespace kvs
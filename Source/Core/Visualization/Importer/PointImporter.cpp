@@ -32,7 +32,8 @@ PointImporter::PointImporter()
 /*===========================================================================*/
 PointImporter::PointImporter( const std::string& filename )
 {
-    if ( kvs::KVSMLPointObject::CheckExtension( filename ) )
+    if ( kvs::KVSMLPointObject::CheckExtension( filename ) ||
+         kvs::KVSBObject::CheckExtension( filename ) )
     {
         BaseClass::setSuccess( SuperClass::read( filename ) );
     }
@@ -80,7 +81,8 @@ PointImporter::SuperClass* PointImporter::exec( const kvs::FileFormatBase* file_
         return NULL;
     }
 
-    if ( dynamic_cast<const kvs::KVSMLPointObject*>( file_format ) )
+    if ( dynamic_cast<const kvs::KVSMLPointObject*>( file_format ) ||
+         dynamic_cast<const kvs::KVSBObject*>( file_format ) )
     {
         BaseClass::setSuccess( SuperClass::read( file_format->filename() ) );
     }
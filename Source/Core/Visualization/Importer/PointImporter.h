@@ -9,6 +9,7 @@
 #include <kvs/Module>
 #include <kvs/PointObject>
 #include <kvs/KVSMLPointObject>
+#include <kvs/KVSBObject>
 
 
 namespace kvs
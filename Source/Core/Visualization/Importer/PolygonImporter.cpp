@@ -31,7 +31,8 @@ PolygonImporter::PolygonImporter()
 /*===========================================================================*/
 PolygonImporter::PolygonImporter( const std::string& filename )
 {
-    if ( kvs::KVSMLPolygonObject::CheckExtension( filename ) )
+    if ( kvs::KVSMLPolygonObject::CheckExtension( filename ) ||
+         kvs::KVSBObject::CheckExtension( filename ) )
     {
         BaseClass::setSuccess( SuperClass::read( filename ) );
     }
@@ -121,7 +122,8 @@ PolygonImporter::SuperClass* PolygonImporter::exec( const kvs::FileFormatBase* f
         return NULL;
     }
 
-    if ( dynamic_cast<const kvs::KVSMLPolygonObject*>( file_format ) )
+    if ( dynamic_cast<const kvs::KVSMLPolygonObject*>( file_format ) ||
+         dynamic_cast<const kvs::KVSBObject*>( file_format ) )
     {
         BaseClass::setSuccess( SuperClass::read( file_format->filename() ) );
     }
@@ -9,6 +9,7 @@
 #include <kvs/Module>
 #include <kvs/PolygonObject>
 #include <kvs/KVSMLPolygonObject>
+#include <kvs/KVSBObject>
 #include <kvs/Stl>
 #include <kvs/Ply>
 
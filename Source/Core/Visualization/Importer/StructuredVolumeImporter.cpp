@@ -12,6 +12,11 @@
 #include <kvs/Vector3>
 #include <kvs/Directory>
 #include <kvs/Value>
+#include <kvs/Math>
+#include <kvs/Parallel>
+#include <kvs/Trace>
+#include <cstring>
+#include <algorithm>
 
 
 namespace kvs
@@ -34,7 +39,8 @@ StructuredVolumeImporter::StructuredVolumeImporter()
 /*===========================================================================*/
 StructuredVolumeImporter::StructuredVolumeImporter( const std::string& filename )
 {
-    if ( kvs::KVSMLStructuredVolumeObject::CheckExtension( filename ) )
+    if ( kvs::KVSMLStructuredVolumeObject::CheckExtension( filename ) ||
+         kvs::KVSBObject::CheckExtension( filename ) )
     {
         BaseClass::setSuccess( SuperClass::read( filename ) );
     }
@@ -61,7 +67,11 @@ StructuredVolumeImporter::StructuredVolumeImporter( const std::string& filename
     }
     else if ( kvs::DicomList::CheckDirectory( filename ) )
     {
-        kvs::DicomList* file_format = new kvs::DicomList( filename );
+        // The raw data of the slices are read in the import process directly
+        // into the value array of the volume.
+        kvs::DicomList* file_format = new kvs::DicomList();
+        file_format->enableHeaderOnly();
+        file_format->read( filename );
         if( !file_format )
         {
             BaseClass::setSuccess( false );
@@ -124,7 +134,8 @@ StructuredVolumeImporter::SuperClass* StructuredVolumeImporter::exec( const kvs:
         return NULL;
     }
 
-    if ( dynamic_cast<const kvs::KVSMLStructuredVolumeObject*>( file_format ) )
+    if ( dynamic_cast<const kvs::KVSMLStructuredVolumeObject*>( file_format ) ||
+         dynamic_cast<const kvs::KVSBObject*>( file_format ) )
     {
         BaseClass::setSuccess( SuperClass::read( file_format->filename() ) );
     }
@@ -274,36 +285,70 @@ const kvs::AnyValueArray StructuredVolumeImporter::get_dicom_data(
     const kvs::DicomList* dicom_list,
     const bool shift )
 {
+    KVS_TRACE_SCOPE( "kvs::StructuredVolumeImporter::get_dicom_data" );
+
     const size_t width = dicom_list->width();
     const size_t height = dicom_list->height();
     const size_t nslices = dicom_list->nslices();
-    const size_t nnodes = width * height * nslices;
-
-    const double min_range = static_cast<double>( kvs::Value<T>::Min() );
-    const double max_range = static_cast<double>( kvs::Value<T>::Max() );
-
+    const size_t npixels = width * height;
+    const int min_range = static_cast<int>( kvs::Value<T>::Min() );
+    const int max_range = static_cast<int>( kvs::Value<T>::Max() );
     kvs::AnyValueArray values;
-    values.template allocate<T>( nnodes );
-
-    T* pvalues = static_cast<T*>( values.data() );
-    for ( size_t k = 0; k < nslices; k++ )
+    values.template allocate<T>( npixels * nslices );
+    T* const pvalues = static_cast<T*>( values.data() );
+
+    // Each slice is decoded into its slab of the value array with the value
+    // shift, clamping and vertical flip. The raw data which is not kept in
+    // the list (header-only mode) is read here and released per slice.
+    const long nslices_long = static_cast<long>( nslices );
+    const long nfailures = kvs::ParallelReduce( 0L, nslices_long, 0L, [&]( const long k ) -> long
     {
         const kvs::Dicom* dicom = (*dicom_list)[k];
-        const T* const raw_data = reinterpret_cast<const T*>( dicom->rawData().data() );
-        const int shift_value = shift ? dicom->minRawValue() : 0;
+        T* const slab = pvalues + k * npixels;
+
+        kvs::ValueArray<char> raw = dicom->rawData();
+        int min_raw_value = dicom->minRawValue();
+        if ( raw.empty() )
+        {
+            int max_raw_value = 0;
+            raw = dicom->readRawData();
+            dicom->calculateMinMaxRawValue( raw, &min_raw_value, &max_raw_value );
+        }
+
+        if ( raw.size() < npixels * sizeof(T) )
+        {
+            std::fill( slab, slab + npixels, T(0) );
+            return 1;
+        }
 
+        const T* const raw_data = reinterpret_cast<const T*>( raw.data() );
+        const int shift_value = shift ? min_raw_value : 0;
         for ( size_t j = 0; j < height; j++ )
         {
-            for ( size_t i = 0; i < width; i++ )
+            const T* const src = raw_data + ( height - j - 1 ) * width;
+            T* const dst = slab + j * width;
+            if ( shift_value == 0 )
             {
-                const size_t pixel_index = ( height - j - 1 ) * width + i;
-                double value = static_cast<double>( raw_data[ pixel_index ] );
-                value = value - shift_value;
-                value = kvs::Math::Clamp( value, min_range, max_range );
+                // The raw values are in the range of T.
+                std::memcpy( dst, src, width * sizeof(T) );
+                continue;
+            }
 
-                *(pvalues++) = static_cast<T>( value );
+            for ( size_t i = 0; i < width; i++ )
+            {
+                const int value = static_cast<int>( src[i] ) - shift_value;
+                dst[i] = static_cast<T>( kvs::Math::Clamp( value, min_range, max_range ) );
             }
         }
+
+        return 0;
+    },
+    []( const long a, const long b ) { return a + b; } );
+
+    if ( nfailures > 0 )
+    {
+        kvsMessageError( "Cannot read the raw data of %ld slices.", nfailures );
+        BaseClass::setSuccess( false );
     }
 
     return values;
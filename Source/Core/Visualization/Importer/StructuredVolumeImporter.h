@@ -9,6 +9,7 @@
 #include <kvs/Module>
 #include <kvs/StructuredVolumeObject>
 #include <kvs/KVSMLStructuredVolumeObject>
+#include <kvs/KVSBObject>
 #include <kvs/AVSField>
 #include <kvs/DicomList>
 
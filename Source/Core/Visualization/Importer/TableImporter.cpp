@@ -30,7 +30,8 @@ TableImporter::TableImporter()
 /*===========================================================================*/
 TableImporter::TableImporter( const std::string& filename )
 {
-    if ( kvs::KVSMLTableObject::CheckExtension( filename ) )
+    if ( kvs::KVSMLTableObject::CheckExtension( filename ) ||
+         kvs::KVSBObject::CheckExtension( filename ) )
     {
         BaseClass::setSuccess( SuperClass::read( filename ) );
     }
@@ -69,7 +70,8 @@ TableImporter::SuperClass* TableImporter::exec( const kvs::FileFormatBase* file_
         return NULL;
     }
 
-    if ( dynamic_cast<const kvs::KVSMLTableObject*>( file_format ) )
+    if ( dynamic_cast<const kvs::KVSMLTableObject*>( file_format ) ||
+         dynamic_cast<const kvs::KVSBObject*>( file_format ) )
     {
         BaseClass::setSuccess( SuperClass::read( file_format->filename() ) );
     }
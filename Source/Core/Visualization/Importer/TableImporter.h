@@ -9,6 +9,7 @@
 #include <kvs/Module>
 #include <kvs/TableObject>
 #include <kvs/KVSMLTableObject>
+#include <kvs/KVSBObject>
 
 
 namespace kvs
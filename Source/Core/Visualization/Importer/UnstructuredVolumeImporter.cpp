@@ -82,7 +82,8 @@ UnstructuredVolumeImporter::UnstructuredVolumeImporter()
 /*===========================================================================*/
 UnstructuredVolumeImporter::UnstructuredVolumeImporter( const std::string& filename )
 {
-    if ( kvs::KVSMLUnstructuredVolumeObject::CheckExtension( filename ) )
+    if ( kvs::KVSMLUnstructuredVolumeObject::CheckExtension( filename ) ||
+         kvs::KVSBObject::CheckExtension( filename ) )
     {
         BaseClass::setSuccess( SuperClass::read( filename ) );
     }
@@ -193,7 +194,8 @@ UnstructuredVolumeImporter::SuperClass* UnstructuredVolumeImporter::exec( const
         return NULL;
     }
 
-    if ( dynamic_cast<const kvs::KVSMLUnstructuredVolumeObject*>( file_format ) )
+    if ( dynamic_cast<const kvs::KVSMLUnstructuredVolumeObject*>( file_format ) ||
+         dynamic_cast<const kvs::KVSBObject*>( file_format ) )
     {
         BaseClass::setSuccess( SuperClass::read( file_format->filename() ) );
     }
@@ -9,6 +9,7 @@
 #include <kvs/Module>
 #include <kvs/UnstructuredVolumeObject>
 #include <kvs/KVSMLUnstructuredVolumeObject>
+#include <kvs/KVSBObject>
 #include <kvs/AVSUcd>
 #include <kvs/AVSField>
 #include <kvs/FieldViewData>
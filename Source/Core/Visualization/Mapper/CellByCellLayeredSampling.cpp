@@ -14,6 +14,7 @@
 #include <kvs/TetrahedralCell>
 #include <kvs/MersenneTwister>
 #include "CellByCellSampling.h"
+#include <kvs/Trace>
 
 
 namespace
@@ -498,6 +499,7 @@ CellByCellLayeredSampling::CellByCellLayeredSampling(
 /*===========================================================================*/
 CellByCellLayeredSampling::SuperClass* CellByCellLayeredSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::CellByCellLayeredSampling::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
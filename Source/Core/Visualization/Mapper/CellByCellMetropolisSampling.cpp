@@ -13,6 +13,7 @@
 #include <kvs/Value>
 #include <kvs/CellBase>
 #include "CellByCellSampling.h"
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -93,6 +94,7 @@ CellByCellMetropolisSampling::CellByCellMetropolisSampling(
 /*===========================================================================*/
 CellByCellMetropolisSampling::SuperClass* CellByCellMetropolisSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::CellByCellMetropolisSampling::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
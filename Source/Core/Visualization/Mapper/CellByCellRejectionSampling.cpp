@@ -14,6 +14,7 @@
 #include <kvs/CellBase>
 #include <kvs/Math>
 #include "CellByCellSampling.h"
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -94,6 +95,7 @@ CellByCellRejectionSampling::CellByCellRejectionSampling(
 /*===========================================================================*/
 CellByCellRejectionSampling::SuperClass* CellByCellRejectionSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::CellByCellRejectionSampling::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
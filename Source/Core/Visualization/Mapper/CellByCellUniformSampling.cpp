@@ -14,6 +14,7 @@
 #include <kvs/CellBase>
 #include <kvs/CellByCellSampling>
 #include "CellByCellSampling.h"
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -94,6 +95,7 @@ CellByCellUniformSampling::CellByCellUniformSampling(
 /*===========================================================================*/
 CellByCellUniformSampling::SuperClass* CellByCellUniformSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::CellByCellUniformSampling::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
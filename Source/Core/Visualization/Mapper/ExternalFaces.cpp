@@ -13,6 +13,7 @@
 #include <kvs/Timer>
 #include <map>
 #include <cstring>
+#include <kvs/Trace>
 
 
 namespace
@@ -709,6 +710,7 @@ ExternalFaces::~ExternalFaces()
 /*===========================================================================*/
 ExternalFaces::SuperClass* ExternalFaces::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::ExternalFaces::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -12,6 +12,7 @@
 #include <kvs/IgnoreUnusedVariable>
 #include <kvs/Timer>
 #include <map>
+#include <kvs/Trace>
 
 
 namespace
@@ -175,6 +176,7 @@ ExtractEdges::~ExtractEdges()
 /*===========================================================================*/
 ExtractEdges::SuperClass* ExtractEdges::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::ExtractEdges::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
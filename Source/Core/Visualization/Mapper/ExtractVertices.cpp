@@ -7,6 +7,7 @@
 #include "ExtractVertices.h"
 #include <kvs/VolumeObjectBase>
 #include <kvs/StructuredVolumeObject>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -71,6 +72,7 @@ ExtractVertices::~ExtractVertices()
 /*===========================================================================*/
 ExtractVertices::SuperClass* ExtractVertices::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::ExtractVertices::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -8,6 +8,7 @@
 #include <kvs/MersenneTwister>
 #include <kvs/IgnoreUnusedVariable>
 #include <vector>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -71,6 +72,7 @@ HitAndMissSampling::~HitAndMissSampling()
 /*===========================================================================*/
 HitAndMissSampling::SuperClass* HitAndMissSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::HitAndMissSampling::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
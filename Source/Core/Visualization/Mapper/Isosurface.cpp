@@ -11,6 +11,7 @@
 #include <kvs/MarchingHexahedra>
 #include <kvs/MarchingPyramid>
 #include <kvs/MarchingPrism>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -138,6 +139,7 @@ Isosurface::~Isosurface()
 /*===========================================================================*/
 Isosurface::SuperClass* Isosurface::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::Isosurface::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -7,6 +7,7 @@
 #include "MarchingCubes.h"
 #include "MarchingCubesTable.h"
 #include <cstring>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -68,6 +69,7 @@ MarchingCubes::~MarchingCubes()
 /*===========================================================================*/
 MarchingCubes::SuperClass* MarchingCubes::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::MarchingCubes::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -40,6 +40,7 @@ public:
     virtual ~MarchingCubes();
 
     void setIsolevel( const double isolevel ) { m_isolevel = isolevel; }
+    void setDuplication( const bool duplication ) { m_duplication = duplication; }
 
     SuperClass* exec( const kvs::ObjectBase* object );
 
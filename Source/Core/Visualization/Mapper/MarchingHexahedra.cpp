@@ -6,6 +6,7 @@
 /****************************************************************************/
 #include "MarchingHexahedra.h"
 #include "MarchingHexahedraTable.h"
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -70,6 +71,7 @@ MarchingHexahedra::~MarchingHexahedra()
 /*===========================================================================*/
 kvs::ObjectBase* MarchingHexahedra::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::MarchingHexahedra::exec" );
     const kvs::ObjectBase::ObjectType object_type = object->objectType();
     if ( object_type == kvs::ObjectBase::Geometry )
     {
@@ -6,6 +6,7 @@
 /****************************************************************************/
 #include "MarchingPrism.h"
 #include "MarchingPrismTable.h"
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -70,6 +71,7 @@ MarchingPrism::~MarchingPrism()
 /*===========================================================================*/
 kvs::ObjectBase* MarchingPrism::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::MarchingPrism::exec" );
     const kvs::ObjectBase::ObjectType object_type = object->objectType();
     if ( object_type == kvs::ObjectBase::Geometry )
     {
@@ -6,6 +6,7 @@
 /****************************************************************************/
 #include "MarchingPyramid.h"
 #include "MarchingPyramidTable.h"
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -70,6 +71,7 @@ MarchingPyramid::~MarchingPyramid()
 /*===========================================================================*/
 kvs::ObjectBase* MarchingPyramid::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::MarchingPyramid::exec" );
     const kvs::ObjectBase::ObjectType object_type = object->objectType();
     if ( object_type == kvs::ObjectBase::Geometry )
     {
@@ -7,6 +7,7 @@
 #include "MarchingTetrahedra.h"
 #include "MarchingTetrahedraTable.h"
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -76,6 +77,7 @@ MarchingTetrahedra::~MarchingTetrahedra()
 /*===========================================================================*/
 MarchingTetrahedra::SuperClass* MarchingTetrahedra::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::MarchingTetrahedra::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
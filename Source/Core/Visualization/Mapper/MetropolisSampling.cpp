@@ -9,6 +9,7 @@
 #include <kvs/TrilinearInterpolator>
 #include <kvs/IgnoreUnusedVariable>
 #include <vector>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -100,6 +101,7 @@ void MetropolisSampling::setNParticles( const size_t nparticles )
 /*===========================================================================*/
 MetropolisSampling::SuperClass* MetropolisSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::MetropolisSampling::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
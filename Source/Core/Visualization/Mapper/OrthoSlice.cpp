@@ -6,6 +6,9 @@
 /****************************************************************************/
 #include "OrthoSlice.h"
 #include <kvs/Matrix33>
+#include <kvs/Parallel>
+#include <kvs/Math>
+#include <kvs/Trace>
 
 
 namespace
@@ -27,7 +30,9 @@ namespace kvs
  */
 /*==========================================================================*/
 OrthoSlice::OrthoSlice():
-    m_aligned_axis( OrthoSlice::XAxis )
+    m_aligned_axis( OrthoSlice::XAxis ),
+    m_position( 0.0f ),
+    m_enable_image_output( false )
 {
 }
 
@@ -49,7 +54,10 @@ OrthoSlice::OrthoSlice(
         volume,
         ::Normal[axis] * position,
         ::Normal[axis],
-        transfer_function )
+        transfer_function ),
+    m_aligned_axis( axis ),
+    m_position( position ),
+    m_enable_image_output( false )
 {
 }
 
@@ -62,7 +70,119 @@ OrthoSlice::OrthoSlice(
 /*===========================================================================*/
 void OrthoSlice::setPlane( const float position, const kvs::OrthoSlice::AlignedAxis axis )
 {
+    m_aligned_axis = axis;
+    m_position = position;
     SuperClass::setPlane( ::Normal[axis] * position, ::Normal[axis] );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Executes the slice plane.
+ *  @param  object [in] pointer to the object (volume object)
+ *  @return pointer to the sliced plane (polygon object)
+ *
+ *  If the image output is enabled and the volume is a structured volume,
+ *  the slice is sampled to the image which can be obtained by image().
+ */
+/*===========================================================================*/
+kvs::PolygonObject* OrthoSlice::exec( const kvs::ObjectBase* object )
+{
+    m_image = kvs::ColorImage();
+
+    const auto* volume = kvs::StructuredVolumeObject::DownCast( object );
+    if ( !m_enable_image_output || !volume )
+    {
+        return SuperClass::exec( object );
+    }
+
+    KVS_TRACE_SCOPE( "kvs::OrthoSlice::exec" );
+    if ( volume->veclen() != 1 )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input volume is not a sclar field data.");
+        return NULL;
+    }
+
+    BaseClass::attachVolume( volume );
+    BaseClass::setRange( volume );
+    kvs::PolygonObject::clear();
+    BaseClass::setMinMaxCoords( volume, this );
+
+    const auto& type = volume->values().typeInfo()->type();
+    if (      type == typeid( kvs::Int8   ) ) this->extract_image<kvs::Int8>( volume );
+    else if ( type == typeid( kvs::Int16  ) ) this->extract_image<kvs::Int16>( volume );
+    else if ( type == typeid( kvs::Int32  ) ) this->extract_image<kvs::Int32>( volume );
+    else if ( type == typeid( kvs::Int64  ) ) this->extract_image<kvs::Int64>( volume );
+    else if ( type == typeid( kvs::UInt8  ) ) this->extract_image<kvs::UInt8>( volume );
+    else if ( type == typeid( kvs::UInt16 ) ) this->extract_image<kvs::UInt16>( volume );
+    else if ( type == typeid( kvs::UInt32 ) ) this->extract_image<kvs::UInt32>( volume );
+    else if ( type == typeid( kvs::UInt64 ) ) this->extract_image<kvs::UInt64>( volume );
+    else if ( type == typeid( kvs::Real32 ) ) this->extract_image<kvs::Real32>( volume );
+    else if ( type == typeid( kvs::Real64 ) ) this->extract_image<kvs::Real64>( volume );
+    else
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Unsupported data type '%s'.", volume->values().typeInfo()->typeName() );
+        return NULL;
+    }
+
+    return this;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Samples the slice of the structured volume to the image.
+ *  @param  volume [in] pointer to the structured volume object
+ *
+ *  The values are linearly interpolated between the two node layers on both
+ *  sides of the slice position, which is given in the index space of the
+ *  nodes as the slice plane. The image is left empty if the position is out
+ *  of the volume.
+ */
+/*===========================================================================*/
+template <typename T>
+void OrthoSlice::extract_image( const kvs::StructuredVolumeObject* volume )
+{
+    const size_t axis = static_cast<size_t>( m_aligned_axis );
+    const size_t u_axis = ( axis == 0 ) ? 1 : 0;
+    const size_t v_axis = ( axis == 2 ) ? 1 : 2;
+
+    const kvs::Vec3u resolution = volume->resolution();
+    const size_t nslices = resolution[ axis ];
+    if ( m_position < 0.0f || m_position > static_cast<float>( nslices - 1 ) ) { return; }
+
+    const size_t stride[3] = {
+        1,
+        volume->numberOfNodesPerLine(),
+        volume->numberOfNodesPerSlice() };
+
+    const size_t k0 = kvs::Math::Min( static_cast<size_t>( m_position ), nslices - 1 );
+    const size_t k1 = kvs::Math::Min( k0 + 1, nslices - 1 );
+    const double t = m_position - static_cast<float>( k0 );
+
+    const T* values = static_cast<const T*>( volume->values().data() );
+    const kvs::ColorMap& color_map( BaseClass::transferFunction().colorMap() );
+    const size_t width = resolution[ u_axis ];
+    const size_t height = resolution[ v_axis ];
+    kvs::ValueArray<kvs::UInt8> pixels( width * height * 3 );
+    kvs::UInt8* ppixels = pixels.data();
+    kvs::ParallelFor( 0L, static_cast<long>( height ), [&]( const long j )
+    {
+        kvs::UInt8* pixel = ppixels + j * width * 3;
+        const size_t offset = j * stride[ v_axis ];
+        for ( size_t i = 0; i < width; i++, pixel += 3 )
+        {
+            const size_t index = offset + i * stride[ u_axis ];
+            const double value0 = static_cast<double>( values[ index + k0 * stride[ axis ] ] );
+            const double value1 = static_cast<double>( values[ index + k1 * stride[ axis ] ] );
+            const kvs::RGBColor color = color_map.at( static_cast<float>( value0 + t * ( value1 - value0 ) ) );
+            pixel[0] = color.r();
+            pixel[1] = color.g();
+            pixel[2] = color.b();
+        }
+    } );
+
+    m_image = kvs::ColorImage( width, height, pixels );
+}
+
 } // end of namespace kvs
@@ -7,6 +7,8 @@
 #pragma once
 #include <kvs/SlicePlane>
 #include <kvs/VolumeObjectBase>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/ColorImage>
 #include <kvs/Module>
 
 
@@ -16,6 +18,12 @@ namespace kvs
 /*==========================================================================*/
 /**
  *  Axis aligned slice plane class.
+ *
+ *  If the image output is enabled, the slice of the structured volume is
+ *  sampled directly on the nodes of the other two axes into a color image
+ *  without polygonization, and the polygon object is left empty. The pixel
+ *  (i,j) corresponds to the i-th node along the first and the j-th node along
+ *  the second of the other axes in the order of x, y and z.
  */
 /*==========================================================================*/
 class OrthoSlice : public kvs::SlicePlane
@@ -33,6 +41,9 @@ public:
 
 protected:
     AlignedAxis m_aligned_axis; ///< aligned axis
+    float m_position; ///< position on the aligned axis
+    bool m_enable_image_output; ///< if true, the slice is sampled to the image
+    kvs::ColorImage m_image; ///< sliced image
 
 public:
     OrthoSlice();
@@ -43,6 +54,16 @@ public:
         const kvs::TransferFunction& transfer_function );
 
     void setPlane( const float position, const kvs::OrthoSlice::AlignedAxis axis );
+    void setEnabledImageOutput( const bool enable ) { m_enable_image_output = enable; }
+    void enableImageOutput() { this->setEnabledImageOutput( true ); }
+    void disableImageOutput() { this->setEnabledImageOutput( false ); }
+    bool isEnabledImageOutput() const { return m_enable_image_output; }
+    const kvs::ColorImage& image() const { return m_image; }
+
+    kvs::PolygonObject* exec( const kvs::ObjectBase* object );
+
+protected:
+    template <typename T> void extract_image( const kvs::StructuredVolumeObject* volume );
 };
 
 } // end of namespace kvs
@@ -10,6 +10,272 @@
 #include <kvs/MarchingHexahedraTable>
 #include <kvs/MarchingPyramidTable>
 #include <kvs/MarchingPrismTable>
+#include <kvs/Trace>
+#include <kvs/Parallel>
+#include <kvs/Math>
+#include <vector>
+
+
+namespace
+{
+
+const size_t BlockSize = 4096; ///< number of the cells in a block of the unstructured volume
+
+/*===========================================================================*/
+/**
+ *  @brief  Tetrahedral cell for the slicing kernel.
+ */
+/*===========================================================================*/
+struct Tetrahedra
+{
+    enum { NumberOfNodes = 4 };
+    static const int* Triangles( const size_t t ) { return kvs::MarchingTetrahedraTable::TriangleID[t]; }
+    static const int* Edge( const int e ) { return kvs::MarchingTetrahedraTable::VertexID[e]; }
+    static void Nodes( const kvs::UInt32* c, size_t* n ) { for ( size_t i = 0; i < 4; i++ ) { n[i] = c[i]; } }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Hexahedral cell for the slicing kernel.
+ */
+/*===========================================================================*/
+struct Hexahedra
+{
+    enum { NumberOfNodes = 8 };
+    static const int* Triangles( const size_t t ) { return kvs::MarchingHexahedraTable::TriangleID[t]; }
+    static const int* Edge( const int e ) { return kvs::MarchingHexahedraTable::VertexID[e]; }
+    static void Nodes( const kvs::UInt32* c, size_t* n )
+    {
+        // The upper and lower faces are swapped for the table.
+        for ( size_t i = 0; i < 4; i++ ) { n[ i + 4 ] = c[i]; n[i] = c[ i + 4 ]; }
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Pyramidal cell for the slicing kernel.
+ */
+/*===========================================================================*/
+struct Pyramid
+{
+    enum { NumberOfNodes = 5 };
+    static const int* Triangles( const size_t t ) { return kvs::MarchingPyramidTable::TriangleID[t]; }
+    static const int* Edge( const int e ) { return kvs::MarchingPyramidTable::VertexID[e]; }
+    static void Nodes( const kvs::UInt32* c, size_t* n ) { for ( size_t i = 0; i < 5; i++ ) { n[i] = c[i]; } }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Prism cell for the slicing kernel.
+ */
+/*===========================================================================*/
+struct Prism
+{
+    enum { NumberOfNodes = 6 };
+    static const int* Triangles( const size_t t ) { return kvs::MarchingPrismTable::TriangleID[t]; }
+    static const int* Edge( const int e ) { return kvs::MarchingPrismTable::VertexID[e]; }
+    static void Nodes( const kvs::UInt32* c, size_t* n ) { for ( size_t i = 0; i < 6; i++ ) { n[i] = c[i]; } }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the triangles in the row of the triangle table.
+ *  @param  triangles [in] row of the triangle table (terminated by -1)
+ *  @return number of the triangles
+ */
+/*===========================================================================*/
+size_t NumberOfTriangles( const int* triangles )
+{
+    size_t n = 0;
+    while ( triangles[n] != -1 ) { n += 3; }
+    return n / 3;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Converts the counts to the offsets by the prefix sum.
+ *  @param  offsets [in/out] counts stored at [1..n], offsets on return
+ */
+/*===========================================================================*/
+void PrefixSum( std::vector<size_t>& offsets )
+{
+    for ( size_t i = 1; i < offsets.size(); i++ ) { offsets[i] += offsets[ i - 1 ]; }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Stores a triangle.
+ *  @param  vertex0 [in] coordinate of the vertex #0
+ *  @param  vertex1 [in] coordinate of the vertex #1
+ *  @param  vertex2 [in] coordinate of the vertex #2
+ *  @param  color0 [in] color of the vertex #0
+ *  @param  color1 [in] color of the vertex #1
+ *  @param  color2 [in] color of the vertex #2
+ *  @param  coords [out] pointer to the coordinate array of the triangle
+ *  @param  colors [out] pointer to the color array of the triangle
+ *  @param  normal [out] pointer to the normal vector of the triangle
+ */
+/*===========================================================================*/
+void StoreTriangle(
+    const kvs::Vec3& vertex0,
+    const kvs::Vec3& vertex1,
+    const kvs::Vec3& vertex2,
+    const kvs::RGBColor& color0,
+    const kvs::RGBColor& color1,
+    const kvs::RGBColor& color2,
+    kvs::Real32* coords,
+    kvs::UInt8* colors,
+    kvs::Real32* normal )
+{
+    coords[0] = vertex0.x(); coords[1] = vertex0.y(); coords[2] = vertex0.z();
+    coords[3] = vertex1.x(); coords[4] = vertex1.y(); coords[5] = vertex1.z();
+    coords[6] = vertex2.x(); coords[7] = vertex2.y(); coords[8] = vertex2.z();
+
+    colors[0] = color0.r(); colors[1] = color0.g(); colors[2] = color0.b();
+    colors[3] = color1.r(); colors[4] = color1.g(); colors[5] = color1.b();
+    colors[6] = color2.r(); colors[7] = color2.g(); colors[8] = color2.b();
+
+    // Calculate a normal vector for the triangle polygon.
+    const kvs::Vec3 n( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
+    normal[0] = n.x(); normal[1] = n.y(); normal[2] = n.z();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Extracts the slice plane from the unstructured volume object.
+ *  @param  volume [in] pointer to the unstructured volume object
+ *  @param  coefficients [in] coefficients of the plane equation
+ *  @param  color_map [in] color map
+ *  @param  coords [out] pointer to the coordinate array
+ *  @param  colors [out] pointer to the color array
+ *  @param  normals [out] pointer to the normal array
+ *
+ *  The plane equation is evaluated once per node. The cells are divided into
+ *  the blocks, and the triangles of each block are counted in parallel. The
+ *  prefix sum of the counts gives the output range of each block, and the
+ *  triangles are written into the preallocated arrays in parallel in the same
+ *  order as the serial extraction.
+ */
+/*===========================================================================*/
+template <typename T, typename Cell>
+void ExtractCellPlane(
+    const kvs::UnstructuredVolumeObject* volume,
+    const kvs::Vec4& coefficients,
+    const kvs::ColorMap& color_map,
+    kvs::ValueArray<kvs::Real32>* coords,
+    kvs::ValueArray<kvs::UInt8>* colors,
+    kvs::ValueArray<kvs::Real32>* normals )
+{
+    const size_t nnodes_per_cell = Cell::NumberOfNodes;
+    const size_t full_index = ( 1 << nnodes_per_cell ) - 1;
+
+    const kvs::Real32* volume_coords = volume->coords().data();
+    const kvs::UInt32* volume_connections = volume->connections().data();
+    const T* values = static_cast<const T*>( volume->values().data() );
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t ncells = volume->numberOfCells();
+
+    // Substitute the node coordinates into the plane equation.
+    std::vector<float> distances( nnodes );
+    kvs::ParallelFor( 0L, static_cast<long>( nnodes ), [&]( const long i )
+    {
+        const kvs::Real32* v = volume_coords + 3 * i;
+        distances[i] =
+            coefficients.x() * v[0] +
+            coefficients.y() * v[1] +
+            coefficients.z() * v[2] +
+            coefficients.w();
+    } );
+
+    // Returns the index of the triangle table for the cell.
+    auto table_index_of = [&] ( const size_t* local_index )
+    {
+        size_t table_index = 0;
+        for ( size_t i = 0; i < nnodes_per_cell; i++ )
+        {
+            if ( distances[ local_index[i] ] > 0.0f ) { table_index |= ( 1 << i ); }
+        }
+        return ( table_index == full_index ) ? 0 : table_index;
+    };
+
+    // Count the triangles in each block.
+    const size_t nblocks = ( ncells + ::BlockSize - 1 ) / ::BlockSize;
+    std::vector<size_t> offsets( nblocks + 1, 0 );
+    kvs::ParallelFor( 0L, static_cast<long>( nblocks ), [&]( const long b )
+    {
+        const size_t begin = b * ::BlockSize;
+        const size_t end = kvs::Math::Min( begin + ::BlockSize, ncells );
+        size_t ntriangles = 0;
+        size_t local_index[ Cell::NumberOfNodes ];
+        for ( size_t cell = begin; cell < end; cell++ )
+        {
+            Cell::Nodes( volume_connections + nnodes_per_cell * cell, local_index );
+            const size_t table_index = table_index_of( local_index );
+            if ( table_index == 0 ) continue;
+            ntriangles += ::NumberOfTriangles( Cell::Triangles( table_index ) );
+        }
+        offsets[ b + 1 ] = ntriangles;
+    } );
+    ::PrefixSum( offsets );
+
+    // Extract the triangles of each block into the preallocated arrays.
+    const size_t ntriangles = offsets.back();
+    coords->allocate( ntriangles * 9 );
+    colors->allocate( ntriangles * 9 );
+    normals->allocate( ntriangles * 3 );
+    kvs::Real32* pcoords = coords->data();
+    kvs::UInt8* pcolors = colors->data();
+    kvs::Real32* pnormals = normals->data();
+    kvs::ParallelFor( 0L, static_cast<long>( nblocks ), [&]( const long b )
+    {
+        if ( offsets[b] == offsets[ b + 1 ] ) return;
+
+        const size_t begin = b * ::BlockSize;
+        const size_t end = kvs::Math::Min( begin + ::BlockSize, ncells );
+        size_t triangle = offsets[b];
+        size_t local_index[ Cell::NumberOfNodes ];
+        for ( size_t cell = begin; cell < end; cell++ )
+        {
+            Cell::Nodes( volume_connections + nnodes_per_cell * cell, local_index );
+            const size_t table_index = table_index_of( local_index );
+            if ( table_index == 0 ) continue;
+
+            const int* triangles = Cell::Triangles( table_index );
+            for ( size_t i = 0; triangles[i] != -1; i += 3, triangle++ )
+            {
+                kvs::Vec3 vertices[3];
+                kvs::RGBColor vertex_colors[3];
+                for ( size_t j = 0; j < 3; j++ )
+                {
+                    // Refer indices of the coordinate array from the VertexTable using the edge ID.
+                    const int* edge = Cell::Edge( triangles[ i + j ] );
+                    const size_t c0 = local_index[ edge[0] ];
+                    const size_t c1 = local_index[ edge[1] ];
+
+                    const float d0 = distances[ c0 ];
+                    const float d1 = distances[ c1 ];
+                    const float ratio = kvs::Math::Abs( d0 / ( d1 - d0 ) );
+
+                    const kvs::Vec3 v0( volume_coords + 3 * c0 );
+                    const kvs::Vec3 v1( volume_coords + 3 * c1 );
+                    vertices[j] = ( 1.0f - ratio ) * v0 + ratio * v1;
+
+                    const double value = values[ c0 ] + ratio * ( values[ c1 ] - values[ c0 ] );
+                    vertex_colors[j] = color_map.at( value );
+                }
+
+                ::StoreTriangle(
+                    vertices[0], vertices[1], vertices[2],
+                    vertex_colors[0], vertex_colors[1], vertex_colors[2],
+                    pcoords + 9 * triangle,
+                    pcolors + 9 * triangle,
+                    pnormals + 3 * triangle );
+            }
+        }
+    } );
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -107,6 +373,7 @@ void SlicePlane::setPlane( const kvs::Vec3& point, const kvs::Vec3& normal )
 /*===========================================================================*/
 SlicePlane::SuperClass* SlicePlane::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::SlicePlane::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -194,124 +461,108 @@ void SlicePlane::mapping( const kvs::VolumeObjectBase* volume )
 /**
  *  @brief  Extract a slice plane for a structured volume.
  *  @param  volume [in] pointer to the structured volume object
+ *
+ *  The triangles in each row of the cells along the x-axis are counted in
+ *  parallel, and the triangles are written into the preallocated arrays at
+ *  the offsets given by the prefix sum of the counts.
  */
 /*==========================================================================*/
 template <typename T>
 void SlicePlane::extract_plane(
     const kvs::StructuredVolumeObject* volume )
 {
-    // Calculated the coordinate data array and the normal vector array.
-    std::vector<kvs::Real32> coords;
-    std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
-
     const kvs::Vec3u ncells( volume->resolution() - kvs::Vec3u::Constant(1) );
-    const kvs::UInt32 line_size( volume->numberOfNodesPerLine() );
     const kvs::ColorMap& color_map( BaseClass::transferFunction().colorMap() );
 
+    // Count the triangles in each row.
+    const size_t nrows = size_t( ncells.y() ) * ncells.z();
+    std::vector<size_t> offsets( nrows + 1, 0 );
+    kvs::ParallelFor( 0L, static_cast<long>( nrows ), [&]( const long row )
+    {
+        const kvs::UInt32 y = static_cast<kvs::UInt32>( row % ncells.y() );
+        const kvs::UInt32 z = static_cast<kvs::UInt32>( row / ncells.y() );
+
+        // Since the plane equation is monotonic along the x-axis, the row is
+        // not intersected if the nodes at both ends are on the same side.
+        const size_t first_index = this->calculate_table_index( 0, y, z );
+        const size_t last_index = this->calculate_table_index( ncells.x() - 1, y, z );
+        if ( ( first_index | last_index ) == 0 ) return;
+        if ( ( first_index & last_index ) == 255 ) return;
+
+        size_t ntriangles = 0;
+        for ( kvs::UInt32 x = 0; x < ncells.x(); ++x )
+        {
+            const size_t table_index = this->calculate_table_index( x, y, z );
+            if ( table_index == 0 ) continue;
+            if ( table_index == 255 ) continue;
+            ntriangles += ::NumberOfTriangles( MarchingCubesTable::TriangleID[ table_index ] );
+        }
+        offsets[ row + 1 ] = ntriangles;
+    } );
+    ::PrefixSum( offsets );
+
     // Extract surfaces.
-    size_t index = 0;
-    for ( kvs::UInt32 z = 0; z < ncells.z(); ++z )
+    const size_t ntriangles = offsets.back();
+    kvs::ValueArray<kvs::Real32> coords( ntriangles * 9 );
+    kvs::ValueArray<kvs::UInt8> colors( ntriangles * 9 );
+    kvs::ValueArray<kvs::Real32> normals( ntriangles * 3 );
+    kvs::Real32* pcoords = coords.data();
+    kvs::UInt8* pcolors = colors.data();
+    kvs::Real32* pnormals = normals.data();
+    kvs::ParallelFor( 0L, static_cast<long>( nrows ), [&]( const long row )
     {
-        for ( kvs::UInt32 y = 0; y < ncells.y(); ++y )
+        if ( offsets[ row ] == offsets[ row + 1 ] ) return;
+
+        const kvs::UInt32 y = static_cast<kvs::UInt32>( row % ncells.y() );
+        const kvs::UInt32 z = static_cast<kvs::UInt32>( row / ncells.y() );
+        size_t triangle = offsets[ row ];
+        for ( kvs::UInt32 x = 0; x < ncells.x(); ++x )
         {
-            for ( kvs::UInt32 x = 0; x < ncells.x(); ++x )
+            // Calculate the index of the reference table.
+            const size_t table_index = this->calculate_table_index( x, y, z );
+            if ( table_index == 0 ) continue;
+            if ( table_index == 255 ) continue;
+
+            // Calculate the triangle polygons. The second and third edges are
+            // swapped for the orientation of the triangle.
+            const int* triangles = MarchingCubesTable::TriangleID[ table_index ];
+            for ( size_t i = 0; triangles[i] != -1; i += 3, triangle++ )
             {
-                // Calculate the index of the reference table.
-                const size_t table_index = this->calculate_table_index( x, y, z );
-                if ( table_index == 0 ) continue;
-                if ( table_index == 255 ) continue;
+                const int edges[3] = { triangles[i], triangles[ i + 2 ], triangles[ i + 1 ] };
 
-                // Calculate the triangle polygons.
-                for ( size_t i = 0; MarchingCubesTable::TriangleID[ table_index ][i] != -1; i += 3 )
+                kvs::Vec3 vertices[3];
+                kvs::RGBColor vertex_colors[3];
+                for ( size_t j = 0; j < 3; j++ )
                 {
-                    // Refer the edge IDs from the TriangleTable by using the table_index.
-                    const int e0 = MarchingCubesTable::TriangleID[table_index][i];
-                    const int e1 = MarchingCubesTable::TriangleID[table_index][i+2];
-                    const int e2 = MarchingCubesTable::TriangleID[table_index][i+1];
-
                     // Determine vertices for each edge.
+                    const int e = edges[j];
                     const kvs::Vec3 v0(
-                        static_cast<float>( x + MarchingCubesTable::VertexID[e0][0][0] ),
-                        static_cast<float>( y + MarchingCubesTable::VertexID[e0][0][1] ),
-                        static_cast<float>( z + MarchingCubesTable::VertexID[e0][0][2] ) );
+                        static_cast<float>( x + MarchingCubesTable::VertexID[e][0][0] ),
+                        static_cast<float>( y + MarchingCubesTable::VertexID[e][0][1] ),
+                        static_cast<float>( z + MarchingCubesTable::VertexID[e][0][2] ) );
 
                     const kvs::Vec3 v1(
-                        static_cast<float>( x + MarchingCubesTable::VertexID[e0][1][0] ),
-                        static_cast<float>( y + MarchingCubesTable::VertexID[e0][1][1] ),
-                        static_cast<float>( z + MarchingCubesTable::VertexID[e0][1][2] ) );
-
-                    const kvs::Vec3 v2(
-                        static_cast<float>( x + MarchingCubesTable::VertexID[e1][0][0] ),
-                        static_cast<float>( y + MarchingCubesTable::VertexID[e1][0][1] ),
-                        static_cast<float>( z + MarchingCubesTable::VertexID[e1][0][2] ) );
-
-                    const kvs::Vec3 v3(
-                        static_cast<float>( x + MarchingCubesTable::VertexID[e1][1][0] ),
-                        static_cast<float>( y + MarchingCubesTable::VertexID[e1][1][1] ),
-                        static_cast<float>( z + MarchingCubesTable::VertexID[e1][1][2] ) );
-
-                    const kvs::Vec3 v4(
-                        static_cast<float>( x + MarchingCubesTable::VertexID[e2][0][0] ),
-                        static_cast<float>( y + MarchingCubesTable::VertexID[e2][0][1] ),
-                        static_cast<float>( z + MarchingCubesTable::VertexID[e2][0][2] ) );
-
-                    const kvs::Vec3 v5(
-                        static_cast<float>( x + MarchingCubesTable::VertexID[e2][1][0] ),
-                        static_cast<float>( y + MarchingCubesTable::VertexID[e2][1][1] ),
-                        static_cast<float>( z + MarchingCubesTable::VertexID[e2][1][2] ) );
-
-                    // Calculate coordinates of the vertices which are composed
-                    // of the triangle polygon.
-                    const kvs::Vec3 vertex0( this->interpolate_vertex( v0, v1 ) );
-                    coords.push_back( vertex0.x() );
-                    coords.push_back( vertex0.y() );
-                    coords.push_back( vertex0.z() );
-
-                    const kvs::Vec3 vertex1( this->interpolate_vertex( v2, v3 ) );
-                    coords.push_back( vertex1.x() );
-                    coords.push_back( vertex1.y() );
-                    coords.push_back( vertex1.z() );
-
-                    const kvs::Vec3 vertex2( this->interpolate_vertex( v4, v5 ) );
-                    coords.push_back( vertex2.x() );
-                    coords.push_back( vertex2.y() );
-                    coords.push_back( vertex2.z() );
-
-                    const double value0 = this->interpolate_value<T>( volume, v0, v1 );
-                    const double value1 = this->interpolate_value<T>( volume, v2, v3 );
-                    const double value2 = this->interpolate_value<T>( volume, v4, v5 );
-
-                    const auto color0 = color_map.at( value0 );
-                    colors.push_back( color0.r() );
-                    colors.push_back( color0.g() );
-                    colors.push_back( color0.b() );
-
-                    const auto color1 = color_map.at( value1 );
-                    colors.push_back( color1.r() );
-                    colors.push_back( color1.g() );
-                    colors.push_back( color1.b() );
-
-                    const auto color2 = color_map.at( value2 );
-                    colors.push_back( color2.r() );
-                    colors.push_back( color2.g() );
-                    colors.push_back( color2.b() );
-
-                    // Calculate a normal vector for the triangle polygon.
-                    const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
-                    normals.push_back( normal.x() );
-                    normals.push_back( normal.y() );
-                    normals.push_back( normal.z() );
-                } // end of loop-triangle
-            } // end of loop-x
-            ++index;
-        } // end of loop-y
-        index += line_size;
-    } // end of loop-z
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+                        static_cast<float>( x + MarchingCubesTable::VertexID[e][1][0] ),
+                        static_cast<float>( y + MarchingCubesTable::VertexID[e][1][1] ),
+                        static_cast<float>( z + MarchingCubesTable::VertexID[e][1][2] ) );
+
+                    vertices[j] = this->interpolate_vertex( v0, v1 );
+                    vertex_colors[j] = color_map.at( this->interpolate_value<T>( volume, v0, v1 ) );
+                }
+
+                ::StoreTriangle(
+                    vertices[0], vertices[1], vertices[2],
+                    vertex_colors[0], vertex_colors[1], vertex_colors[2],
+                    pcoords + 9 * triangle,
+                    pcolors + 9 * triangle,
+                    pnormals + 3 * triangle );
+            } // end of loop-triangle
+        } // end of loop-x
+    } ); // end of loop-row
+
+    SuperClass::setCoords( coords );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( normals );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setColorType( kvs::PolygonObject::VertexColor );
@@ -328,497 +579,39 @@ template <typename T>
 void SlicePlane::extract_plane(
     const kvs::UnstructuredVolumeObject* volume )
 {
+    const auto& color_map = BaseClass::transferFunction().colorMap();
+
+    kvs::ValueArray<kvs::Real32> coords;
+    kvs::ValueArray<kvs::UInt8> colors;
+    kvs::ValueArray<kvs::Real32> normals;
     switch ( volume->cellType() )
     {
         case kvs::UnstructuredVolumeObject::Tetrahedra:
         {
-            this->extract_tetrahedra_plane<T>( volume );
+            ::ExtractCellPlane<T,::Tetrahedra>( volume, m_coefficients, color_map, &coords, &colors, &normals );
             break;
         }
         case kvs::UnstructuredVolumeObject::Hexahedra:
         {
-            this->extract_hexahedra_plane<T>( volume );
+            ::ExtractCellPlane<T,::Hexahedra>( volume, m_coefficients, color_map, &coords, &colors, &normals );
             break;
         }
         case kvs::UnstructuredVolumeObject::Pyramid:
         {
-            this->extract_pyramid_plane<T>( volume );
+            ::ExtractCellPlane<T,::Pyramid>( volume, m_coefficients, color_map, &coords, &colors, &normals );
             break;
         }
         case kvs::UnstructuredVolumeObject::Prism:
         {
-            this->extract_prism_plane<T>( volume );
+            ::ExtractCellPlane<T,::Prism>( volume, m_coefficients, color_map, &coords, &colors, &normals );
             break;
         }
-        default: break;
+        default: return;
     }
-}
-/*==========================================================================*/
-/**
- *  @brief  Extract a slice plane for a unstructured volume.
- *  @param  volume [in] pointer to the unstructured volume object
- */
-/*==========================================================================*/
-template <typename T>
-void SlicePlane::extract_tetrahedra_plane(
-    const kvs::UnstructuredVolumeObject* volume )
-{
-    // Calculated the coordinate data array and the normal vector array.
-    std::vector<kvs::Real32> coords;
-    std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
-
-    // Refer the parameters of the unstructured volume object.
-    const kvs::Real32* volume_coords = volume->coords().data();
-    const kvs::UInt32* volume_connections = volume->connections().data();
-    const size_t ncells = volume->numberOfCells();
-    const auto& color_map = BaseClass::transferFunction().colorMap();
-
-    // Extract surfaces.
-    size_t index = 0;
-    size_t local_index[4];
-    for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 4 )
-    {
-        // Calculate the indices of the target cell.
-        local_index[0] = volume_connections[ index ];
-        local_index[1] = volume_connections[ index + 1 ];
-        local_index[2] = volume_connections[ index + 2 ];
-        local_index[3] = volume_connections[ index + 3 ];
-
-        // Calculate the index of the reference table.
-        const size_t table_index = this->calculate_tetrahedra_table_index( local_index );
-        if ( table_index == 0 ) continue;
-        if ( table_index == 15 ) continue;
-
-        // Calculate the triangle polygons.
-        for ( size_t i = 0; MarchingTetrahedraTable::TriangleID[ table_index ][i] != -1; i += 3 )
-        {
-            // Refer the edge IDs from the TriangleTable using the table_index.
-            const int e0 = MarchingTetrahedraTable::TriangleID[table_index][i];
-            const int e1 = MarchingTetrahedraTable::TriangleID[table_index][i+1];
-            const int e2 = MarchingTetrahedraTable::TriangleID[table_index][i+2];
-
-            // Refer indices of the coordinate array from the VertexTable using the edgeIDs.
-            const size_t c0 = local_index[ MarchingTetrahedraTable::VertexID[e0][0] ];
-            const size_t c1 = local_index[ MarchingTetrahedraTable::VertexID[e0][1] ];
-            const size_t c2 = local_index[ MarchingTetrahedraTable::VertexID[e1][0] ];
-            const size_t c3 = local_index[ MarchingTetrahedraTable::VertexID[e1][1] ];
-            const size_t c4 = local_index[ MarchingTetrahedraTable::VertexID[e2][0] ];
-            const size_t c5 = local_index[ MarchingTetrahedraTable::VertexID[e2][1] ];
-
-            // Determine vertices for each edge.
-            const kvs::Vec3 v0( volume_coords + 3 * c0 );
-            const kvs::Vec3 v1( volume_coords + 3 * c1 );
-
-            const kvs::Vec3 v2( volume_coords + 3 * c2 );
-            const kvs::Vec3 v3( volume_coords + 3 * c3 );
-
-            const kvs::Vec3 v4( volume_coords + 3 * c4 );
-            const kvs::Vec3 v5( volume_coords + 3 * c5 );
-
-            // Calculate coordinates of the vertices which are composed
-            // of the triangle polygon.
-            const kvs::Vec3 vertex0( this->interpolate_vertex( v0, v1 ) );
-            coords.push_back( vertex0.x() );
-            coords.push_back( vertex0.y() );
-            coords.push_back( vertex0.z() );
-
-            const kvs::Vec3 vertex1( this->interpolate_vertex( v2, v3 ) );
-            coords.push_back( vertex1.x() );
-            coords.push_back( vertex1.y() );
-            coords.push_back( vertex1.z() );
-
-            const kvs::Vec3 vertex2( this->interpolate_vertex( v4, v5 ) );
-            coords.push_back( vertex2.x() );
-            coords.push_back( vertex2.y() );
-            coords.push_back( vertex2.z() );
-
-            const double value0 = this->interpolate_value<T>( volume, c0, c1 );
-            const double value1 = this->interpolate_value<T>( volume, c2, c3 );
-            const double value2 = this->interpolate_value<T>( volume, c4, c5 );
-
-            const auto color0 = color_map.at( value0 );
-            colors.push_back( color0.r() );
-            colors.push_back( color0.g() );
-            colors.push_back( color0.b() );
-
-            const auto color1 = color_map.at( value1 );
-            colors.push_back( color1.r() );
-            colors.push_back( color1.g() );
-            colors.push_back( color1.b() );
-
-            const auto color2 = color_map.at( value2 );
-            colors.push_back( color2.r() );
-            colors.push_back( color2.g() );
-            colors.push_back( color2.b() );
-
-            // Calculate a normal vector for the triangle polygon.
-            const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
-            normals.push_back( normal.x() );
-            normals.push_back( normal.y() );
-            normals.push_back( normal.z() );
-        } // end of loop-triangle
-    } // end of loop-cell
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setOpacity( 255 );
-    SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
-    SuperClass::setColorType( kvs::PolygonObject::VertexColor );
-    SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
-}
-
-/*==========================================================================*/
-/**
- *  @brief  Extract a slice plane for a unstructured volume.
- *  @param  volume [in] pointer to the unstructured volume object
- */
-/*==========================================================================*/
-template <typename T>
-void SlicePlane::extract_hexahedra_plane(
-    const kvs::UnstructuredVolumeObject* volume )
-{
-    // Calculated the coordinate data array and the normal vector array.
-    std::vector<kvs::Real32> coords;
-    std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
-
-    // Refer the parameters of the unstructured volume object.
-    const kvs::Real32* volume_coords = volume->coords().data();
-    const kvs::UInt32* volume_connections = volume->connections().data();
-    const size_t ncells = volume->numberOfCells();
-    const auto& color_map = BaseClass::transferFunction().colorMap();
-
-    // Extract surfaces.
-    size_t index = 0;
-    size_t local_index[8];
-    for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 8 )
-    {
-        // Calculate the indices of the target cell.
-        local_index[4] = volume_connections[ index ];
-        local_index[5] = volume_connections[ index + 1 ];
-        local_index[6] = volume_connections[ index + 2 ];
-        local_index[7] = volume_connections[ index + 3 ];
-        local_index[0] = volume_connections[ index + 4 ];
-        local_index[1] = volume_connections[ index + 5 ];
-        local_index[2] = volume_connections[ index + 6 ];
-        local_index[3] = volume_connections[ index + 7 ];
-
-        // Calculate the index of the reference table.
-        const size_t table_index = this->calculate_hexahedra_table_index( local_index );
-        if ( table_index == 0 ) continue;
-        if ( table_index == 255 ) continue;
-
-        // Calculate the triangle polygons.
-        for ( size_t i = 0; MarchingHexahedraTable::TriangleID[ table_index ][i] != -1; i += 3 )
-        {
-            // Refer the edge IDs from the TriangleTable using the table_index.
-            const int e0 = MarchingHexahedraTable::TriangleID[table_index][i];
-            const int e1 = MarchingHexahedraTable::TriangleID[table_index][i+1];
-            const int e2 = MarchingHexahedraTable::TriangleID[table_index][i+2];
-
-            // Refer indices of the coordinate array from the VertexTable using the edgeIDs.
-            const size_t c0 = local_index[ MarchingHexahedraTable::VertexID[e0][0] ];
-            const size_t c1 = local_index[ MarchingHexahedraTable::VertexID[e0][1] ];
-            const size_t c2 = local_index[ MarchingHexahedraTable::VertexID[e1][0] ];
-            const size_t c3 = local_index[ MarchingHexahedraTable::VertexID[e1][1] ];
-            const size_t c4 = local_index[ MarchingHexahedraTable::VertexID[e2][0] ];
-            const size_t c5 = local_index[ MarchingHexahedraTable::VertexID[e2][1] ];
-
-            // Determine vertices for each edge.
-            const kvs::Vec3 v0( volume_coords + 3 * c0 );
-            const kvs::Vec3 v1( volume_coords + 3 * c1 );
-
-            const kvs::Vec3 v2( volume_coords + 3 * c2 );
-            const kvs::Vec3 v3( volume_coords + 3 * c3 );
-
-            const kvs::Vec3 v4( volume_coords + 3 * c4 );
-            const kvs::Vec3 v5( volume_coords + 3 * c5 );
-
-            // Calculate coordinates of the vertices which are composed
-            // of the triangle polygon.
-            const kvs::Vec3 vertex0( this->interpolate_vertex( v0, v1 ) );
-            coords.push_back( vertex0.x() );
-            coords.push_back( vertex0.y() );
-            coords.push_back( vertex0.z() );
-
-            const kvs::Vec3 vertex1( this->interpolate_vertex( v2, v3 ) );
-            coords.push_back( vertex1.x() );
-            coords.push_back( vertex1.y() );
-            coords.push_back( vertex1.z() );
-
-            const kvs::Vec3 vertex2( this->interpolate_vertex( v4, v5 ) );
-            coords.push_back( vertex2.x() );
-            coords.push_back( vertex2.y() );
-            coords.push_back( vertex2.z() );
-
-            const double value0 = this->interpolate_value<T>( volume, c0, c1 );
-            const double value1 = this->interpolate_value<T>( volume, c2, c3 );
-            const double value2 = this->interpolate_value<T>( volume, c4, c5 );
-
-            const auto color0 = color_map.at( value0 );
-            colors.push_back( color0.r() );
-            colors.push_back( color0.g() );
-            colors.push_back( color0.b() );
-
-            const auto color1 = color_map.at( value1 );
-            colors.push_back( color1.r() );
-            colors.push_back( color1.g() );
-            colors.push_back( color1.b() );
-
-            const auto color2 = color_map.at( value2 );
-            colors.push_back( color2.r() );
-            colors.push_back( color2.g() );
-            colors.push_back( color2.b() );
-
-            // Calculate a normal vector for the triangle polygon.
-            const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
-            normals.push_back( normal.x() );
-            normals.push_back( normal.y() );
-            normals.push_back( normal.z() );
-        } // end of loop-triangle
-    } // end of loop-cell
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setOpacity( 255 );
-    SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
-    SuperClass::setColorType( kvs::PolygonObject::VertexColor );
-    SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
-}
-
-/*==========================================================================*/
-/**
- *  @brief  Extract a slice plane for a unstructured volume.
- *  @param  volume [in] pointer to the unstructured volume object
- */
-/*==========================================================================*/
-template <typename T>
-void SlicePlane::extract_pyramid_plane(
-    const kvs::UnstructuredVolumeObject* volume )
-{
-    // Calculated the coordinate data array and the normal vector array.
-    std::vector<kvs::Real32> coords;
-    std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
-
-    // Refer the parameters of the unstructured volume object.
-    const kvs::Real32* volume_coords = volume->coords().data();
-    const kvs::UInt32* volume_connections = volume->connections().data();
-    const size_t ncells = volume->numberOfCells();
-    const auto& color_map = BaseClass::transferFunction().colorMap();
-
-    // Extract surfaces.
-    size_t index = 0;
-    size_t local_index[5];
-    for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 5 )
-    {
-        // Calculate the indices of the target cell.
-        local_index[0] = volume_connections[ index ];
-        local_index[1] = volume_connections[ index + 1 ];
-        local_index[2] = volume_connections[ index + 2 ];
-        local_index[3] = volume_connections[ index + 3 ];
-        local_index[4] = volume_connections[ index + 4 ];
-
-        // Calculate the index of the reference table.
-        const size_t table_index = this->calculate_pyramid_table_index( local_index );
-        if ( table_index == 0 ) continue;
-        if ( table_index == 31 ) continue;
-
-        // Calculate the triangle polygons.
-        for ( size_t i = 0; MarchingPyramidTable::TriangleID[ table_index ][i] != -1; i += 3 )
-        {
-            // Refer the edge IDs from the TriangleTable using the table_index.
-            const int e0 = MarchingPyramidTable::TriangleID[table_index][i];
-            const int e1 = MarchingPyramidTable::TriangleID[table_index][i+1];
-            const int e2 = MarchingPyramidTable::TriangleID[table_index][i+2];
-
-            // Refer indices of the coordinate array from the VertexTable using the edgeIDs.
-            const size_t c0 = local_index[ MarchingPyramidTable::VertexID[e0][0] ];
-            const size_t c1 = local_index[ MarchingPyramidTable::VertexID[e0][1] ];
-            const size_t c2 = local_index[ MarchingPyramidTable::VertexID[e1][0] ];
-            const size_t c3 = local_index[ MarchingPyramidTable::VertexID[e1][1] ];
-            const size_t c4 = local_index[ MarchingPyramidTable::VertexID[e2][0] ];
-            const size_t c5 = local_index[ MarchingPyramidTable::VertexID[e2][1] ];
-
-            // Determine vertices for each edge.
-            const kvs::Vec3 v0( volume_coords + 3 * c0 );
-            const kvs::Vec3 v1( volume_coords + 3 * c1 );
-
-            const kvs::Vec3 v2( volume_coords + 3 * c2 );
-            const kvs::Vec3 v3( volume_coords + 3 * c3 );
-
-            const kvs::Vec3 v4( volume_coords + 3 * c4 );
-            const kvs::Vec3 v5( volume_coords + 3 * c5 );
-
-            // Calculate coordinates of the vertices which are composed
-            // of the triangle polygon.
-            const kvs::Vec3 vertex0( this->interpolate_vertex( v0, v1 ) );
-            coords.push_back( vertex0.x() );
-            coords.push_back( vertex0.y() );
-            coords.push_back( vertex0.z() );
-
-            const kvs::Vec3 vertex1( this->interpolate_vertex( v2, v3 ) );
-            coords.push_back( vertex1.x() );
-            coords.push_back( vertex1.y() );
-            coords.push_back( vertex1.z() );
-
-            const kvs::Vec3 vertex2( this->interpolate_vertex( v4, v5 ) );
-            coords.push_back( vertex2.x() );
-            coords.push_back( vertex2.y() );
-            coords.push_back( vertex2.z() );
-
-            const double value0 = this->interpolate_value<T>( volume, c0, c1 );
-            const double value1 = this->interpolate_value<T>( volume, c2, c3 );
-            const double value2 = this->interpolate_value<T>( volume, c4, c5 );
-
-            const auto color0 = color_map.at( value0 );
-            colors.push_back( color0.r() );
-            colors.push_back( color0.g() );
-            colors.push_back( color0.b() );
-
-            const auto color1 = color_map.at( value1 );
-            colors.push_back( color1.r() );
-            colors.push_back( color1.g() );
-            colors.push_back( color1.b() );
-
-            const auto color2 = color_map.at( value2 );
-            colors.push_back( color2.r() );
-            colors.push_back( color2.g() );
-            colors.push_back( color2.b() );
-
-            // Calculate a normal vector for the triangle polygon.
-            const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
-            normals.push_back( normal.x() );
-            normals.push_back( normal.y() );
-            normals.push_back( normal.z() );
-        } // end of loop-triangle
-    } // end of loop-cell
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setOpacity( 255 );
-    SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
-    SuperClass::setColorType( kvs::PolygonObject::VertexColor );
-    SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
-}
-
-
-/*==========================================================================*/
-/**
- *  @brief  Extract a slice plane for a unstructured volume.
- *  @param  volume [in] pointer to the unstructured volume object
- */
-/*==========================================================================*/
-template <typename T>
-void SlicePlane::extract_prism_plane(
-    const kvs::UnstructuredVolumeObject* volume )
-{
-    // Calculated the coordinate data array and the normal vector array.
-    std::vector<kvs::Real32> coords;
-    std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
-
-    // Refer the parameters of the unstructured volume object.
-    const kvs::Real32* volume_coords = volume->coords().data();
-    const kvs::UInt32* volume_connections = volume->connections().data();
-    const size_t ncells = volume->numberOfCells();
-    const auto& color_map = BaseClass::transferFunction().colorMap();
 
-    // Extract surfaces.
-    size_t index = 0;
-    size_t local_index[6];
-    for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 6 )
-    {
-        // Calculate the indices of the target cell.
-        local_index[0] = volume_connections[ index + 0 ];
-        local_index[1] = volume_connections[ index + 1 ];
-        local_index[2] = volume_connections[ index + 2 ];
-        local_index[3] = volume_connections[ index + 3 ];
-        local_index[4] = volume_connections[ index + 4 ];
-        local_index[5] = volume_connections[ index + 5 ];
-
-        // Calculate the index of the reference table.
-        const size_t table_index = this->calculate_prism_table_index( local_index );
-        if ( table_index == 0 ) continue;
-        if ( table_index == 63 ) continue;
-
-        // Calculate the triangle polygons.
-        for ( size_t i = 0; MarchingPrismTable::TriangleID[ table_index ][i] != -1; i += 3 )
-        {
-            // Refer the edge IDs from the TriangleTable using the table_index.
-            const int e0 = MarchingPrismTable::TriangleID[table_index][i+0];
-            const int e1 = MarchingPrismTable::TriangleID[table_index][i+1];
-            const int e2 = MarchingPrismTable::TriangleID[table_index][i+2];
-
-            // Refer indices of the coordinate array from the VertexTable using the edgeIDs.
-            const size_t c0 = local_index[ MarchingPrismTable::VertexID[e0][0] ];
-            const size_t c1 = local_index[ MarchingPrismTable::VertexID[e0][1] ];
-            const size_t c2 = local_index[ MarchingPrismTable::VertexID[e1][0] ];
-            const size_t c3 = local_index[ MarchingPrismTable::VertexID[e1][1] ];
-            const size_t c4 = local_index[ MarchingPrismTable::VertexID[e2][0] ];
-            const size_t c5 = local_index[ MarchingPrismTable::VertexID[e2][1] ];
-
-            // Determine vertices for each edge.
-            const kvs::Vec3 v0( volume_coords + 3 * c0 );
-            const kvs::Vec3 v1( volume_coords + 3 * c1 );
-
-            const kvs::Vec3 v2( volume_coords + 3 * c2 );
-            const kvs::Vec3 v3( volume_coords + 3 * c3 );
-
-            const kvs::Vec3 v4( volume_coords + 3 * c4 );
-            const kvs::Vec3 v5( volume_coords + 3 * c5 );
-
-            // Calculate coordinates of the vertices which are composed
-            // of the triangle polygon.
-            const kvs::Vec3 vertex0( this->interpolate_vertex( v0, v1 ) );
-            coords.push_back( vertex0.x() );
-            coords.push_back( vertex0.y() );
-            coords.push_back( vertex0.z() );
-
-            const kvs::Vec3 vertex1( this->interpolate_vertex( v2, v3 ) );
-            coords.push_back( vertex1.x() );
-            coords.push_back( vertex1.y() );
-            coords.push_back( vertex1.z() );
-
-            const kvs::Vec3 vertex2( this->interpolate_vertex( v4, v5 ) );
-            coords.push_back( vertex2.x() );
-            coords.push_back( vertex2.y() );
-            coords.push_back( vertex2.z() );
-
-            const double value0 = this->interpolate_value<T>( volume, c0, c1 );
-            const double value1 = this->interpolate_value<T>( volume, c2, c3 );
-            const double value2 = this->interpolate_value<T>( volume, c4, c5 );
-
-            const auto color0 = color_map.at( value0 );
-            colors.push_back( color0.r() );
-            colors.push_back( color0.g() );
-            colors.push_back( color0.b() );
-
-            const auto color1 = color_map.at( value1 );
-            colors.push_back( color1.r() );
-            colors.push_back( color1.g() );
-            colors.push_back( color1.b() );
-
-            const auto color2 = color_map.at( value2 );
-            colors.push_back( color2.r() );
-            colors.push_back( color2.g() );
-            colors.push_back( color2.b() );
-
-            // Calculate a normal vector for the triangle polygon.
-            const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
-            normals.push_back( normal.x() );
-            normals.push_back( normal.y() );
-            normals.push_back( normal.z() );
-        } // end of loop-triangle
-    } // end of loop-cell
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+    SuperClass::setCoords( coords );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( normals );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setColorType( kvs::PolygonObject::VertexColor );
@@ -853,125 +646,6 @@ size_t SlicePlane::calculate_table_index(
 }
 
 
-/*==========================================================================*/
-/**
- *  @brief  Caluclate a table index.
- *  @param  local_index [in] indices of a target cell
- *  @return table index
- */
-/*==========================================================================*/
-size_t SlicePlane::calculate_tetrahedra_table_index(
-    const size_t* local_index ) const
-{
-    const kvs::Real32* const coords = BaseClass::volume()->coords().data();
-
-    const kvs::Vec3 vertex0( coords + 3 * local_index[0] );
-    const kvs::Vec3 vertex1( coords + 3 * local_index[1] );
-    const kvs::Vec3 vertex2( coords + 3 * local_index[2] );
-    const kvs::Vec3 vertex3( coords + 3 * local_index[3] );
-
-    size_t table_index = 0;
-    if ( this->substitute_plane_equation( vertex0 ) > 0.0 ) { table_index |= 1; }
-    if ( this->substitute_plane_equation( vertex1 ) > 0.0 ) { table_index |= 2; }
-    if ( this->substitute_plane_equation( vertex2 ) > 0.0 ) { table_index |= 4; }
-    if ( this->substitute_plane_equation( vertex3 ) > 0.0 ) { table_index |= 8; }
-
-    return table_index;
-}
-
-/*==========================================================================*/
-/**
- *  @brief  Caluclate a table index.
- *  @param  local_index [in] indices of a target cell
- *  @return table index
- */
-/*==========================================================================*/
-size_t SlicePlane::calculate_hexahedra_table_index(
-    const size_t* local_index ) const
-{
-    const kvs::Real32* const coords = BaseClass::volume()->coords().data();
-
-    const kvs::Vec3 vertex0( coords + 3 * local_index[0] );
-    const kvs::Vec3 vertex1( coords + 3 * local_index[1] );
-    const kvs::Vec3 vertex2( coords + 3 * local_index[2] );
-    const kvs::Vec3 vertex3( coords + 3 * local_index[3] );
-    const kvs::Vec3 vertex4( coords + 3 * local_index[4] );
-    const kvs::Vec3 vertex5( coords + 3 * local_index[5] );
-    const kvs::Vec3 vertex6( coords + 3 * local_index[6] );
-    const kvs::Vec3 vertex7( coords + 3 * local_index[7] );
-
-    size_t table_index = 0;
-    if ( this->substitute_plane_equation( vertex0 ) > 0.0 ) { table_index |=   1; }
-    if ( this->substitute_plane_equation( vertex1 ) > 0.0 ) { table_index |=   2; }
-    if ( this->substitute_plane_equation( vertex2 ) > 0.0 ) { table_index |=   4; }
-    if ( this->substitute_plane_equation( vertex3 ) > 0.0 ) { table_index |=   8; }
-    if ( this->substitute_plane_equation( vertex4 ) > 0.0 ) { table_index |=  16; }
-    if ( this->substitute_plane_equation( vertex5 ) > 0.0 ) { table_index |=  32; }
-    if ( this->substitute_plane_equation( vertex6 ) > 0.0 ) { table_index |=  64; }
-    if ( this->substitute_plane_equation( vertex7 ) > 0.0 ) { table_index |= 128; }
-
-    return table_index;
-}
-
-/*==========================================================================*/
-/**
- *  @brief  Caluclate a table index.
- *  @param  local_index [in] indices of a target cell
- *  @return table index
- */
-/*==========================================================================*/
-size_t SlicePlane::calculate_pyramid_table_index(
-    const size_t* local_index ) const
-{
-    const kvs::Real32* const coords = BaseClass::volume()->coords().data();
-
-    const kvs::Vec3 vertex0( coords + 3 * local_index[0] );
-    const kvs::Vec3 vertex1( coords + 3 * local_index[1] );
-    const kvs::Vec3 vertex2( coords + 3 * local_index[2] );
-    const kvs::Vec3 vertex3( coords + 3 * local_index[3] );
-    const kvs::Vec3 vertex4( coords + 3 * local_index[4] );
-
-    size_t table_index = 0;
-    if ( this->substitute_plane_equation( vertex0 ) > 0.0 ) { table_index |=  1; }
-    if ( this->substitute_plane_equation( vertex1 ) > 0.0 ) { table_index |=  2; }
-    if ( this->substitute_plane_equation( vertex2 ) > 0.0 ) { table_index |=  4; }
-    if ( this->substitute_plane_equation( vertex3 ) > 0.0 ) { table_index |=  8; }
-    if ( this->substitute_plane_equation( vertex4 ) > 0.0 ) { table_index |= 16; }
-
-    return table_index;
-}
-
-
-/*==========================================================================*/
-/**
- *  @brief  Caluclate a table index.
- *  @param  local_index [in] indices of a target cell
- *  @return table index
- */
-/*==========================================================================*/
-size_t SlicePlane::calculate_prism_table_index(
-    const size_t* local_index ) const
-{
-    const kvs::Real32* const coords = BaseClass::volume()->coords().data();
-
-    const kvs::Vec3 vertex0( coords + 3 * local_index[0] );
-    const kvs::Vec3 vertex1( coords + 3 * local_index[1] );
-    const kvs::Vec3 vertex2( coords + 3 * local_index[2] );
-    const kvs::Vec3 vertex3( coords + 3 * local_index[3] );
-    const kvs::Vec3 vertex4( coords + 3 * local_index[4] );
-    const kvs::Vec3 vertex5( coords + 3 * local_index[5] );
-
-    size_t table_index = 0;
-    if ( this->substitute_plane_equation( vertex0 ) > 0.0 ) { table_index |=  1; }
-    if ( this->substitute_plane_equation( vertex1 ) > 0.0 ) { table_index |=  2; }
-    if ( this->substitute_plane_equation( vertex2 ) > 0.0 ) { table_index |=  4; }
-    if ( this->substitute_plane_equation( vertex3 ) > 0.0 ) { table_index |=  8; }
-    if ( this->substitute_plane_equation( vertex4 ) > 0.0 ) { table_index |= 16; }
-    if ( this->substitute_plane_equation( vertex5 ) > 0.0 ) { table_index |= 32; }
-
-    return table_index;
-}
-
 /*==========================================================================*/
 /**
  *  @brief  Calculate a plane equation.
@@ -1065,29 +739,4 @@ double SlicePlane::interpolate_value(
     return values[ index0 ] + ratio * ( values[ index1 ] - values[ index0 ] );
 }
 
-/*==========================================================================*/
-/**
- *  @brief  Interpolate a value of a intersected vertex.
- *  @param  volume [in] pointer to a unstructured volume
- *  @param  index0 [in] index of the end point #0
- *  @param  index1 [in] index of the end point #1
- *  @return interpolated value
- */
-/*==========================================================================*/
-template <typename T>
-double SlicePlane::interpolate_value(
-    const kvs::UnstructuredVolumeObject* volume,
-    const size_t index0,
-    const size_t index1 ) const
-{
-    const T* const values = static_cast<const T*>( volume->values().data() );
-    const kvs::Real32* const coords = volume->coords().data();
-
-    const float value0 = this->substitute_plane_equation( kvs::Vec3( coords + 3 * index0 ) );
-    const float value1 = this->substitute_plane_equation( kvs::Vec3( coords + 3 * index1 ) );
-    const float ratio = kvs::Math::Abs( value0 / ( value1 - value0 ) );
-
-    return values[ index0 ] + ratio * ( values[ index1 ] - values[ index0 ] );
-}
-
 } // end of namespace kvs
@@ -20,6 +20,7 @@
 #include <kvs/PyramidalCell>
 #include <kvs/PrismaticCell>
 #include <kvs/CellTreeLocator>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -189,6 +190,7 @@ Streamline::Streamline(
 /*===========================================================================*/
 Streamline::BaseClass::SuperClass* Streamline::exec( const kvs::ObjectBase* object )
 {
+    KVS_TRACE_SCOPE( "kvs::Streamline::exec" );
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -7,6 +7,7 @@
 #include "ImageObject.h"
 #include <string>
 #include <kvs/KVSMLImageObject>
+#include <kvs/KVSBObject>
 
 
 namespace
@@ -78,6 +79,37 @@ kvs::KVSMLImageObject::WritingDataType GetWritingDataType( const bool ascii, con
 } // end of namespace
 
 
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the image object from the KVSB file.
+ *  @param  filename [in] input filename
+ *  @param  object [out] pointer to the image object
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadKVSB( const std::string& filename, kvs::ImageObject* object )
+{
+    kvs::KVSBObject kvsb;
+    if ( !kvsb.read( filename ) ) { return false; }
+    if ( kvsb.objectType() != "ImageObject" )
+    {
+        kvsMessageError() << filename << " is not a image object file in KVSB." << std::endl;
+        return false;
+    }
+
+    if ( kvsb.hasAttribute( "name" ) ) { object->setName( kvsb.attribute( "name" ) ); }
+    const kvs::ImageObject::PixelType type = kvs::ImageObject::PixelType( kvsb.attributeAs<int>( "pixel_type", 24 ) );
+    object->setSize( kvsb.attributeAs<size_t>( "width" ), kvsb.attributeAs<size_t>( "height" ) );
+    object->setPixels( kvsb.valueArray<kvs::UInt8>( "pixels" ), type );
+
+    return true;
+}
+
+} // end of namespace
+
 namespace kvs
 {
 
@@ -161,13 +193,18 @@ void ImageObject::print( std::ostream& os, const kvs::Indent& indent ) const
 
 /*===========================================================================*/
 /**
- *  @brief  Read an image object from the specified file in KVSML.
+ *  @brief  Read an image object from the specified file in KVSML or KVSB.
  *  @param  filename [in] input filename
  *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
 bool ImageObject::read( const std::string& filename )
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        return ::ReadKVSB( filename, this );
+    }
+
     if ( !kvs::KVSMLImageObject::CheckExtension( filename ) )
     {
         kvsMessageError("%s is not an image object file in KVSML.", filename.c_str());
@@ -185,15 +222,27 @@ bool ImageObject::read( const std::string& filename )
 
 /*===========================================================================*/
 /**
- *  @brief  Write the image object to the specfied file in KVSML.
+ *  @brief  Write the image object to the specfied file in KVSML or KVSB.
  *  @param  filename [in] output filename
- *  @param  ascii [in] ascii (true = default) or binary (true)
- *  @param  external [in] external (true) or internal (false = default)
+ *  @param  ascii [in] ascii (true = default) or binary (true), not used for KVSB
+ *  @param  external [in] external (true) or internal (false = default), not used for KVSB
  *  @return true, if the writing process is done successfully
  */
 /*===========================================================================*/
 bool ImageObject::write( const std::string& filename, const bool ascii, const bool external ) const
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        kvs::KVSBObject kvsb;
+        kvsb.setObjectType( "ImageObject" );
+        if ( this->name() != "" ) { kvsb.setAttribute( "name", this->name() ); }
+        kvsb.setAttribute( "width", this->width() );
+        kvsb.setAttribute( "height", this->height() );
+        kvsb.setAttribute( "pixel_type", int( this->pixelType() ) );
+        kvsb.setArray( "pixels", this->pixels() );
+        return kvsb.write( filename );
+    }
+
     kvs::KVSMLImageObject kvsml;
     kvsml.setWritingDataType( ::GetWritingDataType( ascii, external ) );
     kvsml.setWidth( this->width() );
@@ -7,6 +7,8 @@
 #include "LineObject.h"
 #include <string>
 #include <kvs/KVSMLLineObject>
+#include <kvs/KVSBObject>
+#include <kvs/LineExporter>
 #include <kvs/PolygonObject>
 #include <kvs/Assert>
 #include <kvs/Type>
@@ -249,6 +251,53 @@ kvs::ValueArray<kvs::UInt32> GetConnections( const kvs::PolygonObject& polygon )
 } // end of namespace
 
 
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the line object from the KVSB file.
+ *  @param  filename [in] input filename
+ *  @param  object [out] pointer to the line object
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadKVSB( const std::string& filename, kvs::LineObject* object )
+{
+    kvs::KVSBObject kvsb;
+    if ( !kvsb.read( filename ) ) { return false; }
+    if ( kvsb.objectType() != "LineObject" )
+    {
+        kvsMessageError() << filename << " is not a line object file in KVSB." << std::endl;
+        return false;
+    }
+
+    if ( kvsb.hasAttribute( "name" ) ) { object->setName( kvsb.attribute( "name" ) ); }
+    if ( kvsb.hasMinMaxExternalCoords() )
+    {
+        object->setMinMaxExternalCoords( kvsb.minExternalCoord(), kvsb.maxExternalCoord() );
+    }
+    object->setLineType( kvs::LineObject::LineType( kvsb.attributeAs<int>( "line_type" ) ) );
+    object->setColorType( kvs::LineObject::ColorType( kvsb.attributeAs<int>( "color_type" ) ) );
+    object->setCoords( kvsb.valueArray<kvs::Real32>( "coords" ) );
+    object->setColors( kvsb.valueArray<kvs::UInt8>( "colors" ) );
+    object->setSizes( kvsb.valueArray<kvs::Real32>( "sizes" ) );
+    object->setConnections( kvsb.valueArray<kvs::UInt32>( "connections" ) );
+
+    if ( kvsb.hasMinMaxObjectCoords() )
+    {
+        object->setMinMaxObjectCoords( kvsb.minObjectCoord(), kvsb.maxObjectCoord() );
+    }
+    else
+    {
+        object->updateMinMaxCoords();
+    }
+
+    return true;
+}
+
+} // end of namespace
+
 namespace kvs
 {
 
@@ -359,13 +408,18 @@ void LineObject::print( std::ostream& os, const kvs::Indent& indent ) const
 
 /*===========================================================================*/
 /**
- *  @brief  Read a line object from the specified file in KVSML.
+ *  @brief  Read a line object from the specified file in KVSML or KVSB.
  *  @param  filename [in] input filename
  *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
 bool LineObject::read( const std::string& filename )
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        return ::ReadKVSB( filename, this );
+    }
+
     if ( !kvs::KVSMLLineObject::CheckExtension( filename ) )
     {
         kvsMessageError("%s is not a line object file in KVSML.", filename.c_str());
@@ -405,15 +459,21 @@ bool LineObject::read( const std::string& filename )
 
 /*===========================================================================*/
 /**
- *  @brief  Write the line object to the specfied file in KVSML.
+ *  @brief  Write the line object to the specfied file in KVSML or KVSB.
  *  @param  filename [in] output filename
- *  @param  ascii [in] ascii (true = default) or binary (true)
- *  @param  external [in] external (true) or internal (false = default)
+ *  @param  ascii [in] ascii (true = default) or binary (true), not used for KVSB
+ *  @param  external [in] external (true) or internal (false = default), not used for KVSB
  *  @return true, if the writing process is done successfully
  */
 /*===========================================================================*/
 bool LineObject::write( const std::string& filename, const bool ascii, const bool external ) const
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        kvs::LineExporter<kvs::KVSBObject> kvsb( this );
+        return kvsb.write( filename );
+    }
+
     kvs::KVSMLLineObject kvsml;
     kvsml.setWritingDataType( ::GetWritingDataType( ascii, external ) );
     kvsml.setLineType( ::GetLineTypeName( this->lineType() ) );
@@ -7,6 +7,8 @@
 #include "PointObject.h"
 #include <cstring>
 #include <kvs/KVSMLPointObject>
+#include <kvs/KVSBObject>
+#include <kvs/PointExporter>
 #include <kvs/LineObject>
 #include <kvs/PolygonObject>
 #include <kvs/Assert>
@@ -38,6 +40,51 @@ kvs::KVSMLPointObject::WritingDataType GetWritingDataType( const bool ascii, con
 
 }
 
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the point object from the KVSB file.
+ *  @param  filename [in] input filename
+ *  @param  object [out] pointer to the point object
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadKVSB( const std::string& filename, kvs::PointObject* object )
+{
+    kvs::KVSBObject kvsb;
+    if ( !kvsb.read( filename ) ) { return false; }
+    if ( kvsb.objectType() != "PointObject" )
+    {
+        kvsMessageError() << filename << " is not a point object file in KVSB." << std::endl;
+        return false;
+    }
+
+    if ( kvsb.hasAttribute( "name" ) ) { object->setName( kvsb.attribute( "name" ) ); }
+    if ( kvsb.hasMinMaxExternalCoords() )
+    {
+        object->setMinMaxExternalCoords( kvsb.minExternalCoord(), kvsb.maxExternalCoord() );
+    }
+    object->setCoords( kvsb.valueArray<kvs::Real32>( "coords" ) );
+    object->setColors( kvsb.valueArray<kvs::UInt8>( "colors" ) );
+    object->setNormals( kvsb.valueArray<kvs::Real32>( "normals" ) );
+    object->setSizes( kvsb.valueArray<kvs::Real32>( "sizes" ) );
+
+    if ( kvsb.hasMinMaxObjectCoords() )
+    {
+        object->setMinMaxObjectCoords( kvsb.minObjectCoord(), kvsb.maxObjectCoord() );
+    }
+    else
+    {
+        object->updateMinMaxCoords();
+    }
+
+    return true;
+}
+
+} // end of namespace
+
 namespace kvs
 {
 
@@ -422,13 +469,18 @@ void PointObject::print( std::ostream& os, const kvs::Indent& indent ) const
 
 /*===========================================================================*/
 /**
- *  @brief  Read a point object from the specified file in KVSML.
+ *  @brief  Read a point object from the specified file in KVSML or KVSB.
  *  @param  filename [in] input filename
  *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
 bool PointObject::read( const std::string& filename )
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        return ::ReadKVSB( filename, this );
+    }
+
     if ( !kvs::KVSMLPointObject::CheckExtension( filename ) )
     {
         kvsMessageError("%s is not a point object file in KVSML.", filename.c_str());
@@ -466,15 +518,21 @@ bool PointObject::read( const std::string& filename )
 
 /*===========================================================================*/
 /**
- *  @brief  Write the point object to the specfied file in KVSML.
+ *  @brief  Write the point object to the specfied file in KVSML or KVSB.
  *  @param  filename [in] output filename
- *  @param  ascii [in] ascii (true = default) or binary (true)
- *  @param  external [in] external (true) or internal (false = default)
+ *  @param  ascii [in] ascii (true = default) or binary (true), not used for KVSB
+ *  @param  external [in] external (true) or internal (false = default), not used for KVSB
  *  @return true, if the writing process is done successfully
  */
 /*===========================================================================*/
 bool PointObject::write( const std::string& filename, const bool ascii, const bool external ) const
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        kvs::PointExporter<kvs::KVSBObject> kvsb( this );
+        return kvsb.write( filename );
+    }
+
     kvs::KVSMLPointObject kvsml;
     kvsml.setWritingDataType( ::GetWritingDataType( ascii, external ) );
     kvsml.setCoords( this->coords() );
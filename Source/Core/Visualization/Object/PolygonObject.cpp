@@ -7,6 +7,8 @@
 #include "PolygonObject.h"
 #include <string>
 #include <kvs/KVSMLPolygonObject>
+#include <kvs/KVSBObject>
+#include <kvs/PolygonExporter>
 #include <kvs/Assert>
 #include <kvs/Type>
 
@@ -143,6 +145,55 @@ kvs::KVSMLPolygonObject::WritingDataType GetWritingDataType( const bool ascii, c
 } // end of namespace
 
 
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the polygon object from the KVSB file.
+ *  @param  filename [in] input filename
+ *  @param  object [out] pointer to the polygon object
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadKVSB( const std::string& filename, kvs::PolygonObject* object )
+{
+    kvs::KVSBObject kvsb;
+    if ( !kvsb.read( filename ) ) { return false; }
+    if ( kvsb.objectType() != "PolygonObject" )
+    {
+        kvsMessageError() << filename << " is not a polygon object file in KVSB." << std::endl;
+        return false;
+    }
+
+    if ( kvsb.hasAttribute( "name" ) ) { object->setName( kvsb.attribute( "name" ) ); }
+    if ( kvsb.hasMinMaxExternalCoords() )
+    {
+        object->setMinMaxExternalCoords( kvsb.minExternalCoord(), kvsb.maxExternalCoord() );
+    }
+    object->setPolygonType( kvs::PolygonObject::PolygonType( kvsb.attributeAs<int>( "polygon_type" ) ) );
+    object->setColorType( kvs::PolygonObject::ColorType( kvsb.attributeAs<int>( "color_type" ) ) );
+    object->setNormalType( kvs::PolygonObject::NormalType( kvsb.attributeAs<int>( "normal_type" ) ) );
+    object->setCoords( kvsb.valueArray<kvs::Real32>( "coords" ) );
+    object->setColors( kvsb.valueArray<kvs::UInt8>( "colors" ) );
+    object->setNormals( kvsb.valueArray<kvs::Real32>( "normals" ) );
+    object->setConnections( kvsb.valueArray<kvs::UInt32>( "connections" ) );
+    object->setOpacities( kvsb.valueArray<kvs::UInt8>( "opacities" ) );
+
+    if ( kvsb.hasMinMaxObjectCoords() )
+    {
+        object->setMinMaxObjectCoords( kvsb.minObjectCoord(), kvsb.maxObjectCoord() );
+    }
+    else
+    {
+        object->updateMinMaxCoords();
+    }
+
+    return true;
+}
+
+} // end of namespace
+
 namespace kvs
 {
 
@@ -224,13 +275,18 @@ void PolygonObject::print( std::ostream& os, const kvs::Indent& indent ) const
 
 /*===========================================================================*/
 /**
- *  @brief  Read a polygon object from the specified file in KVSML.
+ *  @brief  Read a polygon object from the specified file in KVSML or KVSB.
  *  @param  filename [in] input filename
  *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
 bool PolygonObject::read( const std::string& filename )
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        return ::ReadKVSB( filename, this );
+    }
+
     if ( !kvs::KVSMLPolygonObject::CheckExtension( filename ) )
     {
         kvsMessageError("%s is not a polygon object file in KVSML.", filename.c_str());
@@ -272,15 +328,21 @@ bool PolygonObject::read( const std::string& filename )
 
 /*===========================================================================*/
 /**
- *  @brief  Write the polygon object to the specfied file in KVSML.
+ *  @brief  Write the polygon object to the specfied file in KVSML or KVSB.
  *  @param  filename [in] output filename
- *  @param  ascii [in] ascii (true = default) or binary (true)
- *  @param  external [in] external (true) or internal (false = default)
+ *  @param  ascii [in] ascii (true = default) or binary (true), not used for KVSB
+ *  @param  external [in] external (true) or internal (false = default), not used for KVSB
  *  @return true, if the writing process is done successfully
  */
 /*===========================================================================*/
 bool PolygonObject::write( const std::string& filename, const bool ascii, const bool external ) const
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        kvs::PolygonExporter<kvs::KVSBObject> kvsb( this );
+        return kvsb.write( filename );
+    }
+
     kvs::KVSMLPolygonObject kvsml;
     kvsml.setWritingDataType( ::GetWritingDataType( ascii, external ) );
     kvsml.setPolygonType( ::GetPolygonTypeName( this->polygonType() ) );
@@ -6,6 +6,9 @@
 /****************************************************************************/
 #include "StructuredVolumeObject.h"
 #include <kvs/KVSMLStructuredVolumeObject>
+#include <kvs/KVSBObject>
+#include <kvs/StructuredVolumeExporter>
+#include <sstream>
 #include <kvs/Range>
 
 
@@ -113,6 +116,65 @@ kvs::Range GetMinMaxValues( const kvs::VolumeObjectBase* volume )
 } // end of namespace
 
 
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the structured volume object from the KVSB file.
+ *  @param  filename [in] input filename
+ *  @param  object [out] pointer to the structured volume object
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadKVSB( const std::string& filename, kvs::StructuredVolumeObject* object )
+{
+    kvs::KVSBObject kvsb;
+    if ( !kvsb.read( filename ) ) { return false; }
+    if ( kvsb.objectType() != "StructuredVolumeObject" )
+    {
+        kvsMessageError() << filename << " is not a structured volume object file in KVSB." << std::endl;
+        return false;
+    }
+
+    if ( kvsb.hasAttribute( "name" ) ) { object->setName( kvsb.attribute( "name" ) ); }
+    if ( kvsb.hasMinMaxExternalCoords() )
+    {
+        object->setMinMaxExternalCoords( kvsb.minExternalCoord(), kvsb.maxExternalCoord() );
+    }
+    kvs::Vec3ui resolution( 0, 0, 0 );
+    std::istringstream( kvsb.attribute( "resolution" ) ) >> resolution[0] >> resolution[1] >> resolution[2];
+    object->setGridType( kvs::StructuredVolumeObject::GridType( kvsb.attributeAs<int>( "grid_type" ) ) );
+    object->setResolution( resolution );
+    object->setVeclen( kvsb.attributeAs<size_t>( "veclen", 1 ) );
+    object->setValues( kvsb.array( "values" ) );
+    object->setCoords( kvsb.valueArray<kvs::Real32>( "coords" ) );
+    if ( kvsb.hasAttribute( "label" ) ) { object->setLabel( kvsb.attribute( "label" ) ); }
+    if ( kvsb.hasAttribute( "unit" ) ) { object->setUnit( kvsb.attribute( "unit" ) ); }
+
+    if ( kvsb.hasMinMaxObjectCoords() )
+    {
+        object->setMinMaxObjectCoords( kvsb.minObjectCoord(), kvsb.maxObjectCoord() );
+    }
+    else
+    {
+        object->updateMinMaxCoords();
+    }
+
+    if ( kvsb.hasMinMaxValues() )
+    {
+        object->setMinMaxValues( kvsb.minValue(), kvsb.maxValue() );
+    }
+    else
+    {
+        object->updateMinMaxValues();
+    }
+
+    return true;
+}
+
+} // end of namespace
+
 namespace kvs
 {
 
@@ -176,13 +238,18 @@ void StructuredVolumeObject::print( std::ostream& os, const kvs::Indent& indent
 
 /*===========================================================================*/
 /**
- *  @brief  Read a structured volume object from the specified file in KVSML.
+ *  @brief  Read a structured volume object from the specified file in KVSML or KVSB.
  *  @param  filename [in] input filename
  *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
 bool StructuredVolumeObject::read( const std::string& filename )
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        return ::ReadKVSB( filename, this );
+    }
+
     if ( !kvs::KVSMLStructuredVolumeObject::CheckExtension( filename ) )
     {
         kvsMessageError("%s is not a structured volume object file in KVSML.", filename.c_str());
@@ -243,15 +310,21 @@ bool StructuredVolumeObject::read( const std::string& filename )
 
 /*===========================================================================*/
 /**
- *  @brief  Write the structured volume object to the specfied file in KVSML.
+ *  @brief  Write the structured volume object to the specfied file in KVSML or KVSB.
  *  @param  filename [in] output filename
- *  @param  ascii [in] ascii (true = default) or binary (true)
- *  @param  external [in] external (true) or internal (false = default)
+ *  @param  ascii [in] ascii (true = default) or binary (true), not used for KVSB
+ *  @param  external [in] external (true) or internal (false = default), not used for KVSB
  *  @return true, if the writing process is done successfully
  */
 /*===========================================================================*/
 bool StructuredVolumeObject::write( const std::string& filename, const bool ascii, const bool external ) const
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        kvs::StructuredVolumeExporter<kvs::KVSBObject> kvsb( this );
+        return kvsb.write( filename );
+    }
+
     kvs::KVSMLStructuredVolumeObject kvsml;
     kvsml.setWritingDataType( ::GetWritingDataType( ascii, external ) );
 
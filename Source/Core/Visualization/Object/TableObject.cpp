@@ -8,7 +8,9 @@
 #include <kvs/Value>
 #include <kvs/Math>
 #include <kvs/KVSMLTableObject>
+#include <kvs/KVSBObject>
 #include <utility>
+#include <atomic>
 
 
 namespace
@@ -145,9 +147,72 @@ void Clear( T& values )
     if ( values.size() > 0 ) { values.clear(); T().swap( values ); }
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns a new modification stamp.
+ *  @return modification stamp, which is unique among the table objects
+ */
+/*===========================================================================*/
+size_t NewModifiedStamp()
+{
+    static std::atomic<size_t> counter( 0 );
+    return ++counter;
+}
+
 } // end of namespace
 
 
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the table object from the KVSB file.
+ *  @param  filename [in] input filename
+ *  @param  object [out] pointer to the table object
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadKVSB( const std::string& filename, kvs::TableObject* object )
+{
+    kvs::KVSBObject kvsb;
+    if ( !kvsb.read( filename ) ) { return false; }
+    if ( kvsb.objectType() != "TableObject" )
+    {
+        kvsMessageError() << filename << " is not a table object file in KVSB." << std::endl;
+        return false;
+    }
+
+    if ( kvsb.hasAttribute( "name" ) ) { object->setName( kvsb.attribute( "name" ) ); }
+
+    const kvs::ValueArray<kvs::Real64> min_values = kvsb.valueArray<kvs::Real64>( "min_values" );
+    const kvs::ValueArray<kvs::Real64> max_values = kvsb.valueArray<kvs::Real64>( "max_values" );
+    const kvs::ValueArray<kvs::Real64> min_ranges = kvsb.valueArray<kvs::Real64>( "min_ranges" );
+    const kvs::ValueArray<kvs::Real64> max_ranges = kvsb.valueArray<kvs::Real64>( "max_ranges" );
+    const size_t ncolumns = kvsb.attributeAs<size_t>( "ncolumns" );
+    for ( size_t i = 0; i < ncolumns; i++ )
+    {
+        const std::string index = kvs::String::From( i );
+        const kvs::AnyValueArray& column = kvsb.array( "column_" + index );
+        const std::string label = kvsb.attribute( "label_" + index );
+        if ( i < min_values.size() && i < max_values.size() )
+        {
+            object->addColumn( column, min_values[i], max_values[i], label );
+        }
+        else
+        {
+            object->addColumn( column, label );
+        }
+
+        if ( i < min_ranges.size() ) { object->setMinRange( i, min_ranges[i] ); }
+        if ( i < max_ranges.size() ) { object->setMaxRange( i, max_ranges[i] ); }
+    }
+
+    return true;
+}
+
+} // end of namespace
+
 namespace kvs
 {
 
@@ -161,6 +226,7 @@ TableObject::TableObject()
     BaseClass::setObjectType( Table );
     m_nrows = 0;
     m_ncolumns = 0;
+    m_modified_stamp = ::NewModifiedStamp();
 }
 
 /*===========================================================================*/
@@ -181,6 +247,7 @@ void TableObject::shallowCopy( const TableObject& other )
     this->m_min_ranges = other.minRanges();
     this->m_max_ranges = other.maxRanges();
     this->m_inside_range_flags = other.insideRangeFlags();
+    this->setModified();
 }
 
 /*===========================================================================*/
@@ -209,6 +276,7 @@ void TableObject::deepCopy( const TableObject& other )
     for ( size_t i = 0; i < m_min_ranges.size(); i++ ) this->m_min_ranges.push_back( other.minRange(i) );
     for ( size_t i = 0; i < m_max_ranges.size(); i++ ) this->m_max_ranges.push_back( other.maxRange(i) );
     for ( size_t i = 0; i < m_inside_range_flags.size(); i++ ) this->m_inside_range_flags.push_back( other.insideRange(i) );
+    this->setModified();
 }
 
 /*===========================================================================*/
@@ -237,13 +305,18 @@ void TableObject::print( std::ostream& os, const kvs::Indent& indent ) const
 
 /*===========================================================================*/
 /**
- *  @brief  Read a table object from the specified file in KVSML.
+ *  @brief  Read a table object from the specified file in KVSML or KVSB.
  *  @param  filename [in] input filename
  *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
 bool TableObject::read( const std::string& filename )
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        return ::ReadKVSB( filename, this );
+    }
+
     if ( !kvs::KVSMLTableObject::CheckExtension( filename ) )
     {
         kvsMessageError("%s is not a table object file in KVSML.", filename.c_str());
@@ -271,15 +344,34 @@ bool TableObject::read( const std::string& filename )
 
 /*===========================================================================*/
 /**
- *  @brief  Write the table object to the specfied file in KVSML.
+ *  @brief  Write the table object to the specfied file in KVSML or KVSB.
  *  @param  filename [in] output filename
- *  @param  ascii [in] ascii (true = default) or binary (true)
- *  @param  external [in] external (true) or internal (false = default)
+ *  @param  ascii [in] ascii (true = default) or binary (true), not used for KVSB
+ *  @param  external [in] external (true) or internal (false = default), not used for KVSB
  *  @return true, if the writing process is done successfully
  */
 /*===========================================================================*/
 bool TableObject::write( const std::string& filename, const bool ascii, const bool external ) const
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        kvs::KVSBObject kvsb;
+        kvsb.setObjectType( "TableObject" );
+        if ( this->name() != "" ) { kvsb.setAttribute( "name", this->name() ); }
+        kvsb.setAttribute( "ncolumns", this->numberOfColumns() );
+        for ( size_t i = 0; i < this->numberOfColumns(); i++ )
+        {
+            const std::string index = kvs::String::From( i );
+            kvsb.setAttribute( "label_" + index, this->labels().at(i) );
+            kvsb.setArray( "column_" + index, this->column(i) );
+        }
+        kvsb.setArray( "min_values", kvs::ValueArray<kvs::Real64>( this->minValues() ) );
+        kvsb.setArray( "max_values", kvs::ValueArray<kvs::Real64>( this->maxValues() ) );
+        kvsb.setArray( "min_ranges", kvs::ValueArray<kvs::Real64>( this->minRanges() ) );
+        kvsb.setArray( "max_ranges", kvs::ValueArray<kvs::Real64>( this->maxRanges() ) );
+        return kvsb.write( filename );
+    }
+
     kvs::KVSMLTableObject kvsml;
     kvsml.setWritingDataType( ::GetWritingDataType( ascii, external ) );
 
@@ -333,6 +425,7 @@ void TableObject::addColumn(
     m_min_ranges.push_back( min_value );
     m_max_ranges.push_back( max_value );
     m_inside_range_flags.resize( m_nrows, 1 );
+    this->setModified();
 }
 
 /*===========================================================================*/
@@ -351,6 +444,7 @@ void TableObject::setTable( const kvs::AnyValueTable& table, const Labels& label
     ::Clear( m_min_ranges );
     ::Clear( m_max_ranges );
     ::Clear( m_inside_range_flags );
+    this->setModified();
 
     for ( size_t i = 0; i < table.columnSize(); i++ )
     {
@@ -370,6 +464,7 @@ void TableObject::setMinValue( const size_t column_index, const kvs::Real64 valu
 {
     if ( value > m_min_ranges[column_index] ) { this->setMinRange( column_index, value ); }
     m_min_values[column_index] = value;
+    this->setModified();
 }
 
 /*===========================================================================*/
@@ -383,6 +478,7 @@ void TableObject::setMaxValue( const size_t column_index, const kvs::Real64 valu
 {
     if ( value < m_max_ranges[column_index] ) { this->setMaxRange( column_index, value ); }
     m_max_values[column_index] = value;
+    this->setModified();
 }
 
 /*===========================================================================*/
@@ -633,6 +729,20 @@ void TableObject::resetRange()
     std::fill( m_inside_range_flags.begin(), m_inside_range_flags.end(), 1 );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Marks the values as modified.
+ *
+ *  The setters mark the values by themselves. Call this method after the
+ *  column values are edited in place, so that the renderers which buffer
+ *  the values rebuild the buffers.
+ */
+/*===========================================================================*/
+void TableObject::setModified()
+{
+    m_modified_stamp = ::NewModifiedStamp();
+}
+
 template<> const kvs::Int8& TableObject::at<kvs::Int8>( const size_t row, const size_t column ) const;
 template<> const kvs::UInt8& TableObject::at<kvs::UInt8>( const size_t row, const size_t column ) const;
 template<> const kvs::Int16& TableObject::at<kvs::Int16>( const size_t row, const size_t column ) const;
@@ -45,6 +45,7 @@ private:
     Values m_min_ranges; ///< min. value range
     Values m_max_ranges; ///< max. value range
     InsideRangeFlags m_inside_range_flags; ///< check flags for value range
+    size_t m_modified_stamp; ///< modification stamp of the values (unique among the objects)
 
 public:
     TableObject();
@@ -69,6 +70,7 @@ public:
     void moveRange( const size_t column_index, const kvs::Real64 drange );
     void resetRange( const size_t column_index );
     void resetRange();
+    void setModified();
 
     size_t numberOfColumns() const { return m_ncolumns; }
     size_t numberOfRows() const { return m_nrows; }
@@ -87,6 +89,7 @@ public:
     kvs::Real64 minRange( const size_t column_index ) const { return m_min_ranges[column_index]; }
     kvs::Real64 maxRange( const size_t column_index ) const { return m_max_ranges[column_index]; }
     bool insideRange( const size_t row_index ) const { return m_inside_range_flags[row_index] == 1; }
+    size_t modifiedStamp() const { return m_modified_stamp; }
     template <typename T> const T& at( const size_t row, const size_t column ) const;
 
 protected:
@@ -6,7 +6,13 @@
 /****************************************************************************/
 #include "UnstructuredVolumeObject.h"
 #include <kvs/KVSMLUnstructuredVolumeObject>
+#include <kvs/KVSBObject>
+#include <kvs/UnstructuredVolumeExporter>
 #include <kvs/Range>
+#include <kvs/Parallel>
+#include <algorithm>
+#include <vector>
+#include <atomic>
 
 
 namespace
@@ -134,6 +140,65 @@ kvs::Range GetMinMaxValues( const kvs::UnstructuredVolumeObject* volume )
 } // end of namespace
 
 
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the unstructured volume object from the KVSB file.
+ *  @param  filename [in] input filename
+ *  @param  object [out] pointer to the unstructured volume object
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadKVSB( const std::string& filename, kvs::UnstructuredVolumeObject* object )
+{
+    kvs::KVSBObject kvsb;
+    if ( !kvsb.read( filename ) ) { return false; }
+    if ( kvsb.objectType() != "UnstructuredVolumeObject" )
+    {
+        kvsMessageError() << filename << " is not a unstructured volume object file in KVSB." << std::endl;
+        return false;
+    }
+
+    if ( kvsb.hasAttribute( "name" ) ) { object->setName( kvsb.attribute( "name" ) ); }
+    if ( kvsb.hasMinMaxExternalCoords() )
+    {
+        object->setMinMaxExternalCoords( kvsb.minExternalCoord(), kvsb.maxExternalCoord() );
+    }
+    object->setCellType( kvs::UnstructuredVolumeObject::CellType( kvsb.attributeAs<int>( "cell_type" ) ) );
+    object->setVeclen( kvsb.attributeAs<size_t>( "veclen", 1 ) );
+    object->setNumberOfNodes( kvsb.attributeAs<size_t>( "nnodes" ) );
+    object->setNumberOfCells( kvsb.attributeAs<size_t>( "ncells" ) );
+    object->setCoords( kvsb.valueArray<kvs::Real32>( "coords" ) );
+    object->setConnections( kvsb.valueArray<kvs::UInt32>( "connections" ) );
+    object->setValues( kvsb.array( "values" ) );
+    if ( kvsb.hasAttribute( "label" ) ) { object->setLabel( kvsb.attribute( "label" ) ); }
+    if ( kvsb.hasAttribute( "unit" ) ) { object->setUnit( kvsb.attribute( "unit" ) ); }
+
+    if ( kvsb.hasMinMaxObjectCoords() )
+    {
+        object->setMinMaxObjectCoords( kvsb.minObjectCoord(), kvsb.maxObjectCoord() );
+    }
+    else
+    {
+        object->updateMinMaxCoords();
+    }
+
+    if ( kvsb.hasMinMaxValues() )
+    {
+        object->setMinMaxValues( kvsb.minValue(), kvsb.maxValue() );
+    }
+    else
+    {
+        object->updateMinMaxValues();
+    }
+
+    return true;
+}
+
+} // end of namespace
+
 namespace kvs
 {
 
@@ -147,7 +212,9 @@ UnstructuredVolumeObject::UnstructuredVolumeObject():
     m_cell_type( UnknownCellType ),
     m_nnodes( 0 ),
     m_ncells( 0 ),
-    m_connections()
+    m_connections(),
+    m_node_cell_offsets(),
+    m_node_cell_indices()
 {
     BaseClass::setVolumeType( Unstructured );
 }
@@ -165,6 +232,8 @@ void UnstructuredVolumeObject::shallowCopy( const UnstructuredVolumeObject& obje
     m_nnodes = object.numberOfNodes();
     m_ncells = object.numberOfCells();
     m_connections = object.connections();
+    m_node_cell_offsets = object.nodeCellOffsets();
+    m_node_cell_indices = object.nodeCellIndices();
 }
 
 /*===========================================================================*/
@@ -180,6 +249,8 @@ void UnstructuredVolumeObject::deepCopy( const UnstructuredVolumeObject& object
     m_nnodes = object.numberOfNodes();
     m_ncells = object.numberOfCells();
     m_connections = object.connections().clone();
+    m_node_cell_offsets = object.nodeCellOffsets().clone();
+    m_node_cell_indices = object.nodeCellIndices().clone();
 }
 
 /*===========================================================================*/
@@ -203,13 +274,18 @@ void UnstructuredVolumeObject::print( std::ostream& os, const kvs::Indent& inden
 
 /*===========================================================================*/
 /**
- *  @brief  Read a unstructured volume object from the specified file in KVSML.
+ *  @brief  Read a unstructured volume object from the specified file in KVSML or KVSB.
  *  @param  filename [in] input filename
  *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
 bool UnstructuredVolumeObject::read( const std::string& filename )
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        return ::ReadKVSB( filename, this );
+    }
+
     if ( !kvs::KVSMLUnstructuredVolumeObject::CheckExtension( filename ) )
     {
         kvsMessageError("%s is not an unstructured volume object file in KVSML.", filename.c_str());
@@ -267,15 +343,21 @@ bool UnstructuredVolumeObject::read( const std::string& filename )
 
 /*===========================================================================*/
 /**
- *  @brief  Write the unstructured volume object to the specfied file in KVSML.
+ *  @brief  Write the unstructured volume object to the specfied file in KVSML or KVSB.
  *  @param  filename [in] output filename
- *  @param  ascii [in] ascii (true = default) or binary (true)
- *  @param  external [in] external (true) or internal (false = default)
+ *  @param  ascii [in] ascii (true = default) or binary (true), not used for KVSB
+ *  @param  external [in] external (true) or internal (false = default), not used for KVSB
  *  @return true, if the writing process is done successfully
  */
 /*===========================================================================*/
 bool UnstructuredVolumeObject::write( const std::string& filename, const bool ascii, const bool external ) const
 {
+    if ( kvs::KVSBObject::CheckExtension( filename ) )
+    {
+        kvs::UnstructuredVolumeExporter<kvs::KVSBObject> kvsb( this );
+        return kvsb.write( filename );
+    }
+
     kvs::KVSMLUnstructuredVolumeObject kvsml;
     kvsml.setWritingDataType( ::GetWritingDataType( ascii, external ) );
 
@@ -432,6 +514,72 @@ void UnstructuredVolumeObject::updateMinMaxValues() const
     this->setMinMaxValues( range.lower(), range.upper() );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Updates the node-to-cell map in the compressed sparse row format.
+ *
+ *  The IDs of the cells sharing the i-th node are stored in ascending order in
+ *  nodeCellIndices() from nodeCellOffsets()[i] to nodeCellOffsets()[i+1]. The
+ *  map is shared by the shallow copies, and is released when the cell type,
+ *  the nodes, the coordinates, the cells or the connections are changed.
+ */
+/*===========================================================================*/
+void UnstructuredVolumeObject::updateNodeToCellMap() const
+{
+    const size_t nnodes = this->numberOfNodes();
+    const size_t ncells = this->numberOfCells();
+    const size_t cell_nnodes = this->numberOfCellNodes();
+    const kvs::UInt32* connections = this->connections().data();
+    const long nconnections = static_cast<long>( ncells * cell_nnodes );
+
+    // Count the cells sharing each node. The node shared by the cells is
+    // counted by the several threads, so that the counts are atomic.
+    std::vector< std::atomic<kvs::UInt64> > counts( nnodes ); // zero-initialized
+    kvs::ParallelFor( 0L, nconnections, [&]( const long i )
+    {
+        counts[ connections[i] ].fetch_add( 1, std::memory_order_relaxed );
+    } );
+
+    NodeCellOffsets offsets( nnodes + 1 );
+    offsets[0] = 0;
+    for ( size_t i = 0; i < nnodes; ++i ) { offsets[ i + 1 ] = offsets[i] + counts[i].load( std::memory_order_relaxed ); }
+
+    // Store the cell IDs at the position of each node. The counts are reused
+    // as the cursors of the nodes.
+    NodeCellIndices indices( nconnections );
+    std::vector< std::atomic<kvs::UInt64> >& cursors = counts;
+    for ( size_t i = 0; i < nnodes; ++i ) { cursors[i].store( offsets[i], std::memory_order_relaxed ); }
+    kvs::ParallelFor( 0L, static_cast<long>( ncells ), [&]( const long i )
+    {
+        for ( size_t j = 0; j < cell_nnodes; ++j )
+        {
+            const kvs::UInt32 id = connections[ i * cell_nnodes + j ];
+            const kvs::UInt64 position = cursors[id].fetch_add( 1, std::memory_order_relaxed );
+            indices[ position ] = static_cast<kvs::UInt32>( i );
+        }
+    } );
+
+    // The cell IDs are stored in arbitrary order by the threads.
+    kvs::ParallelFor( 0L, static_cast<long>( nnodes ), [&]( const long i )
+    {
+        std::sort( indices.data() + offsets[i], indices.data() + offsets[ i + 1 ] );
+    }, 1024 );
+
+    m_node_cell_offsets = offsets;
+    m_node_cell_indices = indices;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the node-to-cell map.
+ */
+/*===========================================================================*/
+void UnstructuredVolumeObject::releaseNodeToCellMap() const
+{
+    m_node_cell_offsets.release();
+    m_node_cell_indices.release();
+}
+
 std::ostream& operator << ( std::ostream& os, const UnstructuredVolumeObject& object )
 {
     if ( !object.hasMinMaxValues() ) object.updateMinMaxValues();
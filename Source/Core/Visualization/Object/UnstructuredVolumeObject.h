@@ -27,6 +27,8 @@ class UnstructuredVolumeObject : public kvs::VolumeObjectBase
 
 public:
     using Connections = kvs::ValueArray<kvs::UInt32>;
+    using NodeCellOffsets = kvs::ValueArray<kvs::UInt64>;
+    using NodeCellIndices = kvs::ValueArray<kvs::UInt32>;
 
     enum CellType
     {
@@ -45,6 +47,8 @@ private:
     size_t m_nnodes; ///< Number of nodes.
     size_t m_ncells; ///< Number of cells.
     Connections m_connections; ///< Connection ( Node ID ) array.
+    mutable NodeCellOffsets m_node_cell_offsets; ///< Offsets to the cells of each node (CSR).
+    mutable NodeCellIndices m_node_cell_indices; ///< Cell IDs sorted by node (CSR).
 
 public:
     UnstructuredVolumeObject();
@@ -55,7 +59,7 @@ public:
     bool read( const std::string& filename );
     bool write( const std::string& filename, const bool ascii = true, const bool external = false ) const;
 
-    void setCellType( CellType cell_type ) { m_cell_type = cell_type; }
+    void setCellType( CellType cell_type ) { m_cell_type = cell_type; this->releaseNodeToCellMap(); }
     void setCellTypeToTetrahedra() { this->setCellType( Tetrahedra ); }
     void setCellTypeToHexahedra() { this->setCellType( Hexahedra ); }
     void setCellTypeToQuadraticTetrahedra() { this->setCellType( QuadraticTetrahedra ); }
@@ -63,9 +67,10 @@ public:
     void setCellTypeToPyramid() { this->setCellType( Pyramid ); }
     void setCellTypeToPoint() { this->setCellType( Point ); }
     void setCellTypeToPrism() { this->setCellType( Prism ); }
-    void setNumberOfNodes( const size_t nnodes ) { m_nnodes = nnodes; }
-    void setNumberOfCells( const size_t ncells ) { m_ncells = ncells; }
-    void setConnections( const Connections& connections ) { m_connections = connections; }
+    void setNumberOfNodes( const size_t nnodes ) { m_nnodes = nnodes; this->releaseNodeToCellMap(); }
+    void setNumberOfCells( const size_t ncells ) { m_ncells = ncells; this->releaseNodeToCellMap(); }
+    void setConnections( const Connections& connections ) { m_connections = connections; this->releaseNodeToCellMap(); }
+    void setCoords( const Coords& coords ) { BaseClass::setCoords( coords ); this->releaseNodeToCellMap(); }
 
     CellType cellType() const { return m_cell_type; }
     size_t numberOfNodes() const { return m_nnodes; }
@@ -73,8 +78,14 @@ public:
     const Connections& connections() const { return m_connections; }
     size_t numberOfCellNodes() const;
 
+    bool hasNodeToCellMap() const { return m_node_cell_offsets.size() != 0; }
+    const NodeCellOffsets& nodeCellOffsets() const { return m_node_cell_offsets; }
+    const NodeCellIndices& nodeCellIndices() const { return m_node_cell_indices; }
+
     void updateMinMaxCoords();
     void updateMinMaxValues() const;
+    void updateNodeToCellMap() const;
+    void releaseNodeToCellMap() const;
 
 public:
     KVS_DEPRECATED( UnstructuredVolumeObject(
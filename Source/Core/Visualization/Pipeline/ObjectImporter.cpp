@@ -25,14 +25,17 @@
 #include <kvs/KVSMLPolygonObject>
 #include <kvs/KVSMLStructuredVolumeObject>
 #include <kvs/KVSMLUnstructuredVolumeObject>
-#include <kvs/XMLDocument>
+#include <kvs/KVSBObject>
 #include <kvs/DicomList>
+#include <Core/FileFormat/KVSML/FormatChecker.h>
 #include <kvs/PointImporter>
 #include <kvs/LineImporter>
 #include <kvs/PolygonImporter>
 #include <kvs/StructuredVolumeImporter>
 #include <kvs/UnstructuredVolumeImporter>
 #include <kvs/ImageImporter>
+#include <kvs/TableImporter>
+#include <kvs/Trace>
 
 
 namespace kvs
@@ -72,6 +75,7 @@ ObjectImporter::~ObjectImporter()
 /*===========================================================================*/
 kvs::ObjectBase* ObjectImporter::import()
 {
+    KVS_TRACE_SCOPE( "kvs::ObjectImporter::import" );
     if ( !this->estimate_file_format() )
     {
         kvsMessageError( "Cannot create a file format class for '%s'.", m_filename.c_str() );
@@ -90,6 +94,7 @@ kvs::ObjectBase* ObjectImporter::import()
         return NULL;
     }
 
+    KVS_TRACE_SCOPE( "kvs::ObjectImporter::exec" );
     kvs::ObjectBase* object = m_importer->exec( m_file_format );
     if ( !object )
     {
@@ -185,47 +190,75 @@ bool ObjectImporter::estimate_file_format()
               file.extension() == "xml"   ||
               file.extension() == "XML" )
     {
-        if ( kvs::KVSMLImageObject::CheckFormat( file.filePath() ) )
+        // The type of the object is checked by scanning only the head of the
+        // file, and the file is parsed once by the selected file format class.
+        const std::string object_type = kvs::kvsml::ChildTagName( file.filePath(), "KVSML/Object" );
+        if ( object_type == "ImageObject" )
         {
             m_importer_type = ObjectImporter::Image;
             m_file_format = new kvs::KVSMLImageObject;
         }
 
-        else if ( kvs::KVSMLPointObject::CheckFormat( file.filePath() ) )
+        else if ( object_type == "PointObject" )
         {
             m_importer_type = ObjectImporter::Point;
             m_file_format = new kvs::KVSMLPointObject;
         }
 
-        else if ( kvs::KVSMLLineObject::CheckFormat( file.filePath() ) )
+        else if ( object_type == "LineObject" )
         {
             m_importer_type = ObjectImporter::Line;
             m_file_format = new kvs::KVSMLLineObject;
         }
 
-        else if ( kvs::KVSMLPolygonObject::CheckFormat( file.filePath() ) )
+        else if ( object_type == "PolygonObject" )
         {
             m_importer_type = ObjectImporter::Polygon;
             m_file_format = new kvs::KVSMLPolygonObject;
         }
 
-        else if ( kvs::KVSMLStructuredVolumeObject::CheckFormat( file.filePath() ) )
+        else if ( object_type == "StructuredVolumeObject" )
         {
             m_importer_type = ObjectImporter::StructuredVolume;
             m_file_format = new kvs::KVSMLStructuredVolumeObject;
         }
 
-        else if ( kvs::KVSMLUnstructuredVolumeObject::CheckFormat( file.filePath() ) )
+        else if ( object_type == "UnstructuredVolumeObject" )
         {
             m_importer_type = ObjectImporter::UnstructuredVolume;
             m_file_format = new kvs::KVSMLUnstructuredVolumeObject;
         }
     }
 
+    else if ( kvs::KVSBObject::CheckExtension( file.filePath() ) )
+    {
+        // The type of the object is read from the index of the file, and the
+        // arrays are read by the importer.
+        const std::string object_type = kvs::KVSBObject::ReadObjectType( file.filePath() );
+        if ( object_type == "ImageObject" ) { m_importer_type = ObjectImporter::Image; }
+        else if ( object_type == "PointObject" ) { m_importer_type = ObjectImporter::Point; }
+        else if ( object_type == "LineObject" ) { m_importer_type = ObjectImporter::Line; }
+        else if ( object_type == "PolygonObject" ) { m_importer_type = ObjectImporter::Polygon; }
+        else if ( object_type == "StructuredVolumeObject" ) { m_importer_type = ObjectImporter::StructuredVolume; }
+        else if ( object_type == "UnstructuredVolumeObject" ) { m_importer_type = ObjectImporter::UnstructuredVolume; }
+        else if ( object_type == "TableObject" ) { m_importer_type = ObjectImporter::Table; }
+
+        if ( m_importer_type != ObjectImporter::Unknown )
+        {
+            kvs::KVSBObject* kvsb = new kvs::KVSBObject;
+            kvsb->enableHeaderOnly();
+            m_file_format = kvsb;
+        }
+    }
+
     else if ( kvs::DicomList::CheckDirectory( file.filePath() ) )
     {
+        // The raw data of the slices are read by the importer directly into
+        // the value array of the volume.
+        kvs::DicomList* dicom_list = new kvs::DicomList;
+        dicom_list->enableHeaderOnly();
         m_importer_type = ObjectImporter::StructuredVolume;
-        m_file_format = new kvs::DicomList;
+        m_file_format = dicom_list;
     }
 
     return m_file_format != NULL;
@@ -271,6 +304,11 @@ bool ObjectImporter::estimate_importer()
         m_importer = new kvs::ImageImporter;
         break;
     }
+    case ObjectImporter::Table:
+    {
+        m_importer = new kvs::TableImporter;
+        break;
+    }
     default: break;
     }
 
@@ -33,6 +33,7 @@ public:
         Polygon,///< polygon object importer
         StructuredVolume, ///< structured volume object importer
         UnstructuredVolume, ///< unstructured volume object importer
+        Table, ///< table object importer
         Unknown ///< unknown importer
     };
 
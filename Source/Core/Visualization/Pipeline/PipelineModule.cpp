@@ -6,6 +6,8 @@
 /****************************************************************************/
 #include "PipelineModule.h"
 #include <cstring>
+#include <kvs/Trace>
+#include <kvs/Timer>
 
 
 namespace kvs
@@ -19,7 +21,11 @@ namespace kvs
 PipelineModule::PipelineModule():
     m_auto_delete( true ),
     m_counter( 0 ),
-    m_category( Empty )
+    m_category( Empty ),
+    m_modified( true ),
+    m_input( NULL ),
+    m_output( NULL ),
+    m_elapsed_time( 0.0 )
 {
     memset( &m_module, 0, sizeof( Module ) );
 }
@@ -33,7 +39,11 @@ PipelineModule::PipelineModule():
 PipelineModule::PipelineModule( const PipelineModule& module ):
     m_auto_delete( true ),
     m_counter( 0 ),
-    m_category( Empty )
+    m_category( Empty ),
+    m_modified( true ),
+    m_input( NULL ),
+    m_output( NULL ),
+    m_elapsed_time( 0.0 )
 {
     memset( &m_module, 0, sizeof( Module ) );
     this->shallow_copy( module );
@@ -54,20 +64,27 @@ PipelineModule::~PipelineModule()
  *  @brief  Executes the pipeline module.
  *  @param  object [in] pointer to the object base
  *  @return pointer to the executed object
+ *
+ *  The elapsed time of the execution can be obtained by elapsedTime().
  */
 /*===========================================================================*/
 kvs::ObjectBase* PipelineModule::exec( const kvs::ObjectBase* object )
 {
     if ( !object ) return NULL;
 
+    KVS_TRACE_SCOPE( this->name() );
+    kvs::ObjectBase* output = NULL;
+    kvs::Timer timer( kvs::Timer::Start );
     switch ( m_category )
     {
-    case PipelineModule::Filter: return m_module.filter->exec( object );
-    case PipelineModule::Mapper: return m_module.mapper->exec( object );
+    case PipelineModule::Filter: output = m_module.filter->exec( object ); break;
+    case PipelineModule::Mapper: output = m_module.mapper->exec( object ); break;
     default: break;
     }
+    timer.stop();
+    m_elapsed_time = timer.msec();
 
-    return NULL;
+    return output;
 }
 
 /*===========================================================================*/
@@ -133,6 +150,19 @@ void PipelineModule::disable_auto_delete()
     m_auto_delete = false;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Clears the cached execution state of the module.
+ */
+/*===========================================================================*/
+void PipelineModule::clear_cache()
+{
+    m_modified = true;
+    m_input = NULL;
+    m_output = NULL;
+    m_elapsed_time = 0.0;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Deletes the pipeline module.
@@ -169,6 +199,7 @@ void PipelineModule::shallow_copy( const PipelineModule& module )
     m_counter = module.m_counter;
     m_category = module.m_category;
     m_module = module.m_module;
+    this->clear_cache();
     this->ref();
 }
 
@@ -184,6 +215,7 @@ void PipelineModule::deep_copy( const PipelineModule& module )
     this->create_counter();
     m_category = module.m_category;
     m_module = module.m_module;
+    this->clear_cache();
 }
 
 /*===========================================================================*/
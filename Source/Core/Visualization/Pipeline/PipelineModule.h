@@ -54,6 +54,10 @@ protected:
     kvs::ReferenceCounter* m_counter;  ///< Reference counter.
     Category m_category; ///< module category
     Module m_module; ///< pointer to the module (SHARED)
+    bool m_modified; ///< flag whether the module should be re-executed or not
+    const kvs::ObjectBase* m_input; ///< pointer to the input object of the last execution
+    kvs::ObjectBase* m_output; ///< pointer to the output object of the last execution (cached)
+    double m_elapsed_time; ///< elapsed time of the last execution in msec
 
 public:
 
@@ -62,7 +66,11 @@ public:
     explicit PipelineModule( T* module ):
         m_auto_delete( true ),
         m_counter( 0 ),
-        m_category( Empty )
+        m_category( Empty ),
+        m_modified( true ),
+        m_input( NULL ),
+        m_output( NULL ),
+        m_elapsed_time( 0.0 )
     {
         memset( &m_module, 0, sizeof( Module ) );
         this->create_counter( 1 );
@@ -88,6 +96,8 @@ public:
     const kvs::RendererBase* renderer() const { return m_module.renderer; }
     const char* name() const;
     bool unique() const;
+    bool isModified() const { return m_modified; }
+    double elapsedTime() const { return m_elapsed_time; }
 
 private:
 
@@ -133,6 +143,7 @@ private:
     }
 
     void disable_auto_delete();
+    void clear_cache();
     void delete_module();
     void shallow_copy( const PipelineModule& module );
     void deep_copy( const PipelineModule& module );
@@ -13,6 +13,17 @@
 #include <kvs/LineRenderer>
 #include <kvs/PolygonRenderer>
 #include <kvs/RayCastingRenderer>
+#include <kvs/Trace>
+#include <kvs/MutexLocker>
+#include <kvs/ThreadPool>
+#include <kvs/TaskGroup>
+#include <kvs/Math>
+#include <map>
+#include <atomic>
+#include <algorithm>
+#include <ctime>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 
 // Static parameters.
@@ -25,6 +36,128 @@ namespace { std::vector<kvs::VisualizationPipeline*> context; }
 namespace
 {
 
+/*===========================================================================*/
+/**
+ *  @brief  Imported object shared by the pipelines that read the same file.
+ */
+/*===========================================================================*/
+struct ImportedObject
+{
+    kvs::Mutex mutex; ///< mutex for importing the file
+    kvs::ObjectBase* object; ///< pointer to the imported object
+    size_t stamp; ///< stamp incremented when the file is re-imported
+    size_t byte_size; ///< byte size of the file when imported
+    time_t modified_time; ///< modification time of the file when imported
+};
+
+kvs::Mutex ImportMutex; ///< mutex for the import cache
+std::map<std::string,ImportedObject*> ImportCache; ///< import cache (key: file path)
+std::map<const kvs::ObjectBase*,size_t> ImportReferences; ///< number of the pipelines referring to the imported object
+std::vector<kvs::ObjectBase*> RetiredObjects; ///< objects replaced by the re-imported ones and still referred
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the imported object referred by the pipeline.
+ *  @param  object [in] pointer to the imported object
+ *
+ *  The object replaced by the re-imported one is deleted when it is no longer
+ *  referred by any pipeline. The object not imported through the import
+ *  cache is ignored.
+ */
+/*===========================================================================*/
+void ReleaseShared( const kvs::ObjectBase* object )
+{
+    if ( !object ) { return; }
+
+    kvs::MutexLocker locker( &::ImportMutex );
+    std::map<const kvs::ObjectBase*,size_t>::iterator i = ::ImportReferences.find( object );
+    if ( i == ::ImportReferences.end() ) { return; }
+    if ( --i->second > 0 ) { return; }
+    ::ImportReferences.erase( i );
+
+    std::vector<kvs::ObjectBase*>::iterator j = std::find( ::RetiredObjects.begin(), ::RetiredObjects.end(), object );
+    if ( j != ::RetiredObjects.end() )
+    {
+        delete *j;
+        ::RetiredObjects.erase( j );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Imports the file through the import cache.
+ *  @param  filename [in] filename
+ *  @param  previous [in] pointer to the object imported by the pipeline before (or NULL)
+ *  @param  stamp [out] stamp of the imported object
+ *  @return pointer to the imported object (NULL if failed)
+ *
+ *  The file is identified by the absolute path, and re-imported only if the
+ *  byte size or the modification time of the file is changed. If the returned
+ *  object differs from the previous one, the previous one is released.
+ */
+/*===========================================================================*/
+const kvs::ObjectBase* ImportShared( const std::string& filename, const kvs::ObjectBase* previous, size_t* stamp )
+{
+    struct stat status;
+    if ( stat( filename.c_str(), &status ) != 0 ) { return NULL; }
+
+    const std::string key = kvs::File( filename ).filePath( true );
+    ImportedObject* entry = NULL;
+    {
+        kvs::MutexLocker locker( &::ImportMutex );
+        std::map<std::string,ImportedObject*>::iterator i = ::ImportCache.find( key );
+        if ( i == ::ImportCache.end() )
+        {
+            entry = new ImportedObject;
+            entry->object = NULL;
+            entry->stamp = 0;
+            entry->byte_size = 0;
+            entry->modified_time = 0;
+            ::ImportCache.insert( std::make_pair( key, entry ) );
+        }
+        else { entry = i->second; }
+    }
+
+    // The other pipelines reading the same file wait until the file is imported.
+    const kvs::ObjectBase* object = NULL;
+    {
+        kvs::MutexLocker locker( &entry->mutex );
+        const size_t byte_size = static_cast<size_t>( status.st_size );
+        const time_t modified_time = status.st_mtime;
+        if ( !entry->object || entry->byte_size != byte_size || entry->modified_time != modified_time )
+        {
+            kvs::ObjectImporter importer( filename );
+            kvs::ObjectBase* imported = importer.import();
+            if ( !imported ) { return NULL; }
+
+            // The replaced object is deleted when the pipelines referring to
+            // it have been executed with the new one.
+            if ( entry->object )
+            {
+                kvs::MutexLocker retired_locker( &::ImportMutex );
+                if ( ::ImportReferences.count( entry->object ) > 0 ) { ::RetiredObjects.push_back( entry->object ); }
+                else { delete entry->object; }
+            }
+
+            entry->object = imported;
+            entry->stamp++;
+            entry->byte_size = byte_size;
+            entry->modified_time = modified_time;
+        }
+
+        object = entry->object;
+        *stamp = entry->stamp;
+        if ( object != previous )
+        {
+            kvs::MutexLocker reference_locker( &::ImportMutex );
+            ::ImportReferences[ object ]++;
+        }
+    }
+
+    if ( object != previous ) { ::ReleaseShared( previous ); }
+    return object;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Function that is called when the application is terminated.
@@ -37,6 +170,8 @@ void ExitFunction()
         if ( ::context[i] ) ::context[i]->~VisualizationPipeline();
     }
     ::context.clear();
+
+    kvs::VisualizationPipeline::ClearCache();
 }
 
 } // end of namespace
@@ -45,6 +180,79 @@ void ExitFunction()
 namespace kvs
 {
 
+/*===========================================================================*/
+/**
+ *  @brief  Executes the pipelines concurrently.
+ *  @param  pipelines [in] pointers to the pipelines
+ *  @param  nthreads [in] number of threads (kvs::ThreadPool::DefaultNumberOfThreads if 0)
+ *  @return true, if all of the pipelines are executed successfully
+ *
+ *  The pipelines are executed as the tasks of a thread pool. The upstream
+ *  pipeline shared by several pipelines is executed only once, and the other
+ *  branches wait for its output.
+ */
+/*===========================================================================*/
+bool VisualizationPipeline::Exec(
+    const std::vector<kvs::VisualizationPipeline*>& pipelines,
+    const size_t nthreads )
+{
+    KVS_TRACE_SCOPE( "kvs::VisualizationPipeline::Exec" );
+    if ( pipelines.empty() ) { return true; }
+
+    const size_t ndefaults = nthreads > 0 ? nthreads : kvs::ThreadPool::DefaultNumberOfThreads();
+    const size_t nexecutors = kvs::Math::Min( kvs::Math::Max( ndefaults, size_t(1) ), pipelines.size() );
+    if ( nexecutors == 1 )
+    {
+        bool success = true;
+        for ( size_t i = 0; i < pipelines.size(); i++ )
+        {
+            if ( !pipelines[i]->exec() ) { success = false; }
+        }
+        return success;
+    }
+
+    // The pipelines are not executed by the default pool, which is used by the
+    // modules. A thread waiting for the tasks of a module in the default pool
+    // executes only the tasks of the default pool, so that it never picks up
+    // another pipeline which waits for the upstream pipeline locked by itself.
+    kvs::ThreadPool pool( nexecutors );
+    kvs::TaskGroup group( pool );
+    std::atomic<bool> success( true );
+    for ( size_t i = 0; i < pipelines.size(); i++ )
+    {
+        kvs::VisualizationPipeline* pipeline = pipelines[i];
+        group.run( [pipeline,&success]() { if ( !pipeline->exec() ) { success = false; } } );
+    }
+    group.wait();
+
+    return success;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Deletes the objects shared by the pipelines that read the same file.
+ *
+ *  The pipelines must not be executed after the cache is cleared unless the
+ *  pipelines are invalidated.
+ */
+/*===========================================================================*/
+void VisualizationPipeline::ClearCache()
+{
+    kvs::MutexLocker locker( &::ImportMutex );
+    std::map<std::string,::ImportedObject*>::iterator i = ::ImportCache.begin();
+    while ( i != ::ImportCache.end() )
+    {
+        if ( i->second->object ) { delete i->second->object; }
+        delete i->second;
+        ++i;
+    }
+    ::ImportCache.clear();
+    ::ImportReferences.clear();
+
+    for ( size_t j = 0; j < ::RetiredObjects.size(); j++ ) { delete ::RetiredObjects[j]; }
+    ::RetiredObjects.clear();
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Constructs a new VisualizationPipeline class.
@@ -54,6 +262,12 @@ VisualizationPipeline::VisualizationPipeline():
     m_id( ::Counter++ ),
     m_filename(""),
     m_cache( true ),
+    m_upstream( NULL ),
+    m_nbranches( 0 ),
+    m_source( NULL ),
+    m_source_stamp( 0 ),
+    m_executed_source_stamp( 0 ),
+    m_stamp( 0 ),
     m_object( NULL ),
     m_renderer( NULL )
 {
@@ -71,6 +285,12 @@ VisualizationPipeline::VisualizationPipeline( const std::string& filename ):
     m_id( ::Counter++ ),
     m_filename( filename ),
     m_cache( true ),
+    m_upstream( NULL ),
+    m_nbranches( 0 ),
+    m_source( NULL ),
+    m_source_stamp( 0 ),
+    m_executed_source_stamp( 0 ),
+    m_stamp( 0 ),
     m_object( NULL ),
     m_renderer( NULL )
 {
@@ -88,6 +308,12 @@ VisualizationPipeline::VisualizationPipeline( kvs::ObjectBase* object ):
     m_id( ::Counter++ ),
     m_filename(""),
     m_cache( true ),
+    m_upstream( NULL ),
+    m_nbranches( 0 ),
+    m_source( object ),
+    m_source_stamp( 0 ),
+    m_executed_source_stamp( 0 ),
+    m_stamp( 0 ),
     m_object( object ),
     m_renderer( NULL )
 {
@@ -95,6 +321,35 @@ VisualizationPipeline::VisualizationPipeline( kvs::ObjectBase* object ):
     if ( ::Flag ) { atexit( ::ExitFunction ); ::Flag = false; }
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new visualization pipeline branched from the upstream pipeline.
+ *  @param  upstream [in] pointer to the upstream pipeline
+ *
+ *  The output object of the upstream pipeline is used as the input object of
+ *  this pipeline. If the upstream pipeline is destroyed before this one, this
+ *  pipeline is detached from it and has no input object.
+ */
+/*===========================================================================*/
+VisualizationPipeline::VisualizationPipeline( kvs::VisualizationPipeline* upstream ):
+    m_id( ::Counter++ ),
+    m_filename(""),
+    m_cache( true ),
+    m_upstream( upstream ),
+    m_nbranches( 0 ),
+    m_source( NULL ),
+    m_source_stamp( 0 ),
+    m_executed_source_stamp( 0 ),
+    m_stamp( 0 ),
+    m_object( NULL ),
+    m_renderer( NULL )
+{
+    if ( m_upstream ) { m_upstream->m_nbranches++; }
+
+    ::context.push_back( this );
+    if ( ::Flag ) { atexit( ::ExitFunction ); ::Flag = false; }
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Destroys the visualization pipeline
@@ -102,6 +357,21 @@ VisualizationPipeline::VisualizationPipeline( kvs::ObjectBase* object ):
 /*===========================================================================*/
 VisualizationPipeline::~VisualizationPipeline()
 {
+    if ( !m_filename.empty() ) { ::ReleaseShared( m_source ); }
+
+    // The branches which have not been destroyed are detached from this
+    // pipeline, and the output object of this pipeline is no longer used.
+    for ( size_t i = 0; i < ::context.size(); i++ )
+    {
+        kvs::VisualizationPipeline* branch = ::context[i];
+        if ( branch && branch->m_upstream == this )
+        {
+            branch->m_upstream = NULL;
+            branch->m_source = NULL;
+        }
+    }
+
+    if ( m_upstream ) { m_upstream->m_nbranches--; }
     m_module_list.clear();
     ::context[ m_id ] = 0;
 }
@@ -123,11 +393,48 @@ VisualizationPipeline& VisualizationPipeline::connect( kvs::PipelineModule& modu
 /**
  *  @brief  Import the data file that is specified by the filename.
  *  @return true, if the import process is done successfully
+ *
+ *  If the pipeline is branched, the upstream pipeline is executed instead, and
+ *  its output object is used as the input object.
  */
 /*===========================================================================*/
 bool VisualizationPipeline::import()
 {
-    if ( !this->hasObject() )
+    if ( m_upstream )
+    {
+        if ( !m_upstream->exec() )
+        {
+            kvsMessageError( "Cannot execute the upstream pipeline." );
+            return false;
+        }
+
+        kvs::MutexLocker locker( &m_upstream->m_mutex );
+        m_source = m_upstream->m_object;
+        m_source_stamp = m_upstream->m_stamp;
+        return true;
+    }
+
+    // The imported object is shared with the other pipelines only if it is
+    // passed to the filter or the mapper module, since the object passed to
+    // the renderer is registered and deleted in the screen class.
+    const bool shared = m_cache && !m_filename.empty() &&
+        this->count_module( kvs::PipelineModule::Filter ) + this->count_module( kvs::PipelineModule::Mapper ) > 0;
+    if ( shared )
+    {
+        size_t stamp = 0;
+        const kvs::ObjectBase* object = ::ImportShared( m_filename, m_source, &stamp );
+        if ( !object )
+        {
+            kvsMessageError( "Cannot import an object." );
+            return false;
+        }
+
+        m_source = object;
+        m_source_stamp = stamp;
+        return true;
+    }
+
+    if ( !m_source )
     {
         // Check filename.
         if ( m_filename.empty() )
@@ -146,8 +453,7 @@ bool VisualizationPipeline::import()
         }
 
         // Attache the imported object.
-        m_object = object;
-
+        m_source = object;
     }
 
     return true;
@@ -157,10 +463,21 @@ bool VisualizationPipeline::import()
 /**
  *  @brief  Execute the visualization pipeline.
  *  @return true, if the visualization pipeline is executed successfully.
+ *
+ *  If the cache is enabled, the module is re-executed only if the module is
+ *  invalidated, or its input object is changed or updated. The stamp of the
+ *  pipeline, which is referred by the branched pipelines, is incremented only
+ *  if the output object is changed or updated.
  */
 /*===========================================================================*/
 bool VisualizationPipeline::exec()
 {
+    KVS_TRACE_SCOPE( "kvs::VisualizationPipeline::exec" );
+
+    // The pipeline shared as the upstream pipeline is executed by one thread
+    // at a time, so that the other branches wait for the cached output.
+    kvs::MutexLocker locker( &m_mutex );
+
     // Setup object.
     if ( !this->import() )
     {
@@ -168,7 +485,7 @@ bool VisualizationPipeline::exec()
         return false;
     }
 
-    const kvs::ObjectBase* object = m_object;
+    const kvs::ObjectBase* object = m_source;
     ModuleList::iterator module = m_module_list.begin();
     ModuleList::iterator last   = m_module_list.end();
 
@@ -176,20 +493,38 @@ bool VisualizationPipeline::exec()
     if ( this->hasRenderer() ) --last;
 
     // Execute the filter or the mapper module.
+    bool modified = !m_cache || m_source_stamp != m_executed_source_stamp;
+    bool updated = modified;
     while ( module != last )
     {
-        object = module->exec( object );
-        if ( !object )
+        modified = modified || module->m_modified || !module->m_output || module->m_input != object;
+        if ( modified )
         {
-            kvsMessageError("Cannot execute '%s'.", module->name() );
-            return false;
+            kvs::ObjectBase* output = module->exec( object );
+            if ( !output )
+            {
+                module->clear_cache();
+                kvsMessageError("Cannot execute '%s'.", module->name() );
+                return false;
+            }
+
+            module->m_modified = false;
+            module->m_input = object;
+            module->m_output = output;
+            updated = true;
+        }
+        else
+        {
+            module->m_elapsed_time = 0.0;
         }
 
+        object = module->m_output;
         ++module;
 
         // Don't delete the last module of the pipeline since the object will be registered
-        // and managed in the screen class.
-        if ( module == last )
+        // and managed in the screen class. The output of the upstream pipeline is not
+        // registered, and deleted with the module.
+        if ( module == last && m_nbranches == 0 )
         {
             module--;
             module->disable_auto_delete();
@@ -198,7 +533,14 @@ bool VisualizationPipeline::exec()
     }
 
     // Attache the pointer to the object that is registered in the object manager.
+    if ( object != m_object ) { updated = true; }
     m_object = object;
+    m_executed_source_stamp = m_source_stamp;
+    if ( updated ) { m_stamp++; }
+
+    // The upstream pipeline is not rendered by itself unless the renderer
+    // module is connected.
+    if ( m_nbranches > 0 && !this->hasRenderer() ) { return true; }
 
     // Setup renderer.
     if ( !this->hasRenderer() )
@@ -228,7 +570,48 @@ bool VisualizationPipeline::exec()
 
 /*===========================================================================*/
 /**
- *  @brief  Check whether the cache mechanism is enable or disable. (currently N/A)
+ *  @brief  Invalidates all of the modules to re-execute them in the next execution.
+ */
+/*===========================================================================*/
+void VisualizationPipeline::invalidate()
+{
+    kvs::MutexLocker locker( &m_mutex );
+    ModuleList::iterator module = m_module_list.begin();
+    ModuleList::iterator end = m_module_list.end();
+    while ( module != end )
+    {
+        module->m_modified = true;
+        ++module;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Invalidates the module to re-execute it in the next execution.
+ *  @param  module [in] pipeline module connected to the pipeline
+ *
+ *  The downstream modules of the specified module, including the modules of
+ *  the branched pipelines, are also re-executed.
+ */
+/*===========================================================================*/
+void VisualizationPipeline::invalidate( const kvs::PipelineModule& module )
+{
+    kvs::MutexLocker locker( &m_mutex );
+    ModuleList::iterator m = m_module_list.begin();
+    ModuleList::iterator end = m_module_list.end();
+    while ( m != end )
+    {
+        if ( m->m_counter && m->m_counter == module.m_counter )
+        {
+            m->m_modified = true;
+        }
+        ++m;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Check whether the cache mechanism is enable or disable.
  *  @return true, if the cache is enable.
  */
 /*===========================================================================*/
@@ -301,6 +684,26 @@ const kvs::RendererBase* VisualizationPipeline::renderer() const
     return m_renderer;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the total elapsed time of the modules in the last execution.
+ *  @return elapsed time in msec (cached modules are not counted)
+ */
+/*===========================================================================*/
+double VisualizationPipeline::elapsedTime() const
+{
+    double elapsed_time = 0.0;
+    ModuleList::const_iterator module = m_module_list.begin();
+    ModuleList::const_iterator end = m_module_list.end();
+    while ( module != end )
+    {
+        elapsed_time += module->elapsedTime();
+        ++module;
+    }
+
+    return elapsed_time;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Prints the visualization pipeline as string.
@@ -311,6 +714,17 @@ const kvs::RendererBase* VisualizationPipeline::renderer() const
 void VisualizationPipeline::print( std::ostream& os, const kvs::Indent& indent ) const
 {
     os << indent << *this << std::endl;
+
+    ModuleList::const_iterator module = m_module_list.begin();
+    ModuleList::const_iterator end = m_module_list.end();
+    while ( module != end )
+    {
+        if ( module->category() != kvs::PipelineModule::Renderer )
+        {
+            os << indent.nextIndent() << module->name() << ": " << module->elapsedTime() << " [msec]" << std::endl;
+        }
+        ++module;
+    }
 }
 
 /*===========================================================================*/
@@ -320,9 +734,16 @@ void VisualizationPipeline::print( std::ostream& os, const kvs::Indent& indent )
 /*===========================================================================*/
 std::string& operator << ( std::string& str, const VisualizationPipeline& pipeline )
 {
-    str = kvs::File( pipeline.m_filename ).fileName();
-
     const std::string separator = " >> ";
+    if ( pipeline.m_upstream )
+    {
+        // The renderer module of the upstream pipeline is not included.
+        str << *pipeline.m_upstream;
+        const std::string::size_type p = str.rfind( separator );
+        if ( pipeline.m_upstream->hasRenderer() && p != std::string::npos ) { str.erase( p ); }
+    }
+    else { str = kvs::File( pipeline.m_filename ).fileName(); }
+
     VisualizationPipeline::ModuleList::const_iterator module = pipeline.m_module_list.begin();
     VisualizationPipeline::ModuleList::const_iterator end = pipeline.m_module_list.end();
     while( module != end )
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <vector>
 #include <kvs/Indent>
 #include <kvs/ObjectBase>
 #include <kvs/GeometryObjectBase>
@@ -17,6 +18,7 @@
 #include <kvs/RendererBase>
 #include <kvs/Module>
 #include <kvs/PipelineModule>
+#include <kvs/Mutex>
 
 
 namespace kvs
@@ -25,6 +27,24 @@ namespace kvs
 /*==========================================================================*/
 /**
  *  Visualization pipeline class.
+ *
+ *  If the cache is enabled, the output objects of the modules are reused in
+ *  the next execution, and only the modules invalidated by invalidate() and
+ *  their downstream modules are re-executed. The object imported from a file
+ *  is shared by the pipelines that read the same file. A pipeline can also be
+ *  branched from the output of another (upstream) pipeline, which is executed
+ *  only once for all the branches, and the independent pipelines can be
+ *  executed concurrently by VisualizationPipeline::Exec. No renderer is
+ *  created for the upstream pipeline unless it is connected explicitly.
+ *
+ *  kvs::VisualizationPipeline volume( "volume.kvsml" );
+ *  volume.connect( filter ); // shared by the following pipelines
+ *  kvs::VisualizationPipeline isosurface( &volume );
+ *  isosurface.connect( isosurface_mapper );
+ *  kvs::VisualizationPipeline slice( &volume );
+ *  slice.connect( slice_mapper );
+ *  std::vector<kvs::VisualizationPipeline*> pipelines = { &isosurface, &slice };
+ *  kvs::VisualizationPipeline::Exec( pipelines );
  */
 /*==========================================================================*/
 class VisualizationPipeline
@@ -37,8 +57,15 @@ private:
 
     size_t m_id; ///< pipeline ID
     std::string m_filename; ///< filename
-    bool m_cache; ///< cache mode (DISABLE NOW)
+    bool m_cache; ///< cache mode
     ModuleList m_module_list; ///< pipeline module list
+    kvs::VisualizationPipeline* m_upstream; ///< pointer to the upstream pipeline (branched if not NULL)
+    size_t m_nbranches; ///< number of the pipelines branched from this pipeline
+    const kvs::ObjectBase* m_source; ///< pointer to the input object of the modules
+    size_t m_source_stamp; ///< stamp of the input object
+    size_t m_executed_source_stamp; ///< stamp of the input object in the last execution
+    size_t m_stamp; ///< stamp incremented when the output object is updated
+    kvs::Mutex m_mutex; ///< mutex for the execution
 
     const kvs::ObjectBase* m_object; ///< pointer to the object inserted to the manager
     const kvs::RendererBase* m_renderer; ///< pointer to the renderer inserted to the manager
@@ -47,15 +74,23 @@ private:
 
     VisualizationPipeline();
 
+public:
+
+    static bool Exec( const std::vector<kvs::VisualizationPipeline*>& pipelines, const size_t nthreads = 0 );
+    static void ClearCache();
+
 public:
 
     explicit VisualizationPipeline( const std::string& filename );
     explicit VisualizationPipeline( kvs::ObjectBase* object );
+    explicit VisualizationPipeline( kvs::VisualizationPipeline* upstream );
     virtual ~VisualizationPipeline();
 
     VisualizationPipeline& connect( kvs::PipelineModule& module );
     bool import();
     bool exec();
+    void invalidate();
+    void invalidate( const kvs::PipelineModule& module );
 
     bool cache() const;
     void enableCache();
@@ -64,6 +99,8 @@ public:
     bool hasRenderer() const;
     const kvs::ObjectBase* object() const;
     const kvs::RendererBase* renderer() const;
+    const ModuleList& moduleList() const { return m_module_list; }
+    double elapsedTime() const;
     void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
 
     friend std::string& operator << ( std::string& str, const VisualizationPipeline& pipeline );
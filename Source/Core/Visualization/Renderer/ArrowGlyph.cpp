@@ -7,6 +7,8 @@
 #include "ArrowGlyph.h"
 #include <kvs/OpenGL>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Math>
+#include <vector>
 
 
 namespace
@@ -51,6 +53,59 @@ inline void DrawCylinder( const kvs::Vec3& t )
     kvs::OpenGL::DrawCylinder( base, top, height, slices, stacks );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Adds the side surface of the frustum along the y-axis to the mesh.
+ *  @param  base [in] radius at the bottom
+ *  @param  top [in] radius at the top
+ *  @param  y [in] y coordinate of the bottom
+ *  @param  height [in] height
+ *  @param  slices [in] number of subdivisions around the y-axis
+ *  @param  vertices [in/out] vertex array
+ *  @param  normals [in/out] normal array
+ *  @param  connections [in/out] connection array
+ */
+/*===========================================================================*/
+void AddFrustum(
+    const float base,
+    const float top,
+    const float y,
+    const float height,
+    const size_t slices,
+    std::vector<kvs::Real32>& vertices,
+    std::vector<kvs::Real32>& normals,
+    std::vector<kvs::UInt32>& connections )
+{
+    const kvs::UInt32 offset = static_cast<kvs::UInt32>( vertices.size() / 3 );
+    const kvs::Vec2 slope = kvs::Vec2( height, base - top ).normalized();
+    for ( size_t i = 0; i <= slices; i++ )
+    {
+        const float t = 2.0f * kvs::Math::PI() * static_cast<float>( i ) / static_cast<float>( slices );
+        const float c = std::cos( t );
+        const float s = std::sin( t );
+        const float r[2] = { base, top };
+        for ( size_t j = 0; j < 2; j++ )
+        {
+            vertices.push_back( r[j] * s );
+            vertices.push_back( y + height * static_cast<float>( j ) );
+            vertices.push_back( r[j] * c );
+            normals.push_back( slope.x() * s );
+            normals.push_back( slope.y() );
+            normals.push_back( slope.x() * c );
+        }
+    }
+
+    for ( size_t i = 0; i < slices; i++ )
+    {
+        const kvs::UInt32 b0 = offset + static_cast<kvs::UInt32>( 2 * i );
+        const kvs::UInt32 t0 = b0 + 1;
+        const kvs::UInt32 b1 = b0 + 2;
+        const kvs::UInt32 t1 = b0 + 3;
+        connections.push_back( b0 ); connections.push_back( b1 ); connections.push_back( t0 );
+        connections.push_back( b1 ); connections.push_back( t1 ); connections.push_back( t0 );
+    }
+}
+
 }; // end of namespace
 
 
@@ -219,6 +274,8 @@ void ArrowGlyph::attach_volume( const kvs::VolumeObjectBase* volume )
 /*===========================================================================*/
 void ArrowGlyph::draw()
 {
+    if ( BaseClass::isEnabledInstancing() ) { this->draw_instances(); return; }
+
     switch ( m_arrow_type )
     {
     case LineArrow: this->draw_lines(); break;
@@ -379,6 +436,51 @@ void ArrowGlyph::draw_tube_element( const kvs::RGBColor& color, const kvs::UInt8
     kvs::OpenGL::PopMatrix();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Draw the arrow glyphs with instanced rendering.
+ */
+/*===========================================================================*/
+void ArrowGlyph::draw_instances()
+{
+    // The arrows with zero direction are not drawn as well as draw_lines/tubes.
+    const bool cull_zero_direction = true;
+    if ( !BaseClass::hasGlyphMesh() ) { this->create_mesh(); }
+    BaseClass::drawInstances( cull_zero_direction );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the glyph mesh for instanced rendering.
+ */
+/*===========================================================================*/
+void ArrowGlyph::create_mesh()
+{
+    if ( m_arrow_type == LineArrow )
+    {
+        BaseClass::setGlyphMesh(
+            GL_LINES,
+            kvs::ValueArray<kvs::Real32>( ::LineVertices, 12 ),
+            kvs::ValueArray<kvs::Real32>(),
+            kvs::ValueArray<kvs::UInt32>( ::LineConnections, 6 ) );
+    }
+    else
+    {
+        // Same shapes as DrawCylinder and DrawCone rotated to the y-axis.
+        const size_t slices = 20;
+        std::vector<kvs::Real32> vertices;
+        std::vector<kvs::Real32> normals;
+        std::vector<kvs::UInt32> connections;
+        ::AddFrustum( 0.07f, 0.07f, 0.0f, 0.7f, slices, vertices, normals, connections );
+        ::AddFrustum( 0.15f, 0.0f, 0.7f, 0.3f, slices, vertices, normals, connections );
+        BaseClass::setGlyphMesh(
+            GL_TRIANGLES,
+            kvs::ValueArray<kvs::Real32>( vertices ),
+            kvs::ValueArray<kvs::Real32>( normals ),
+            kvs::ValueArray<kvs::UInt32>( connections ) );
+    }
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Initialize OpenGL properties for rendering arrow glyph.
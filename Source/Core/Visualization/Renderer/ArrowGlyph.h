@@ -47,7 +47,7 @@ public:
     ArrowGlyph( const kvs::VolumeObjectBase* volume );
     ArrowGlyph( const kvs::VolumeObjectBase* volume, const kvs::TransferFunction& transfer_function );
 
-    void setArrowType( const ArrowType type ) { m_arrow_type = type; }
+    void setArrowType( const ArrowType type ) { m_arrow_type = type; BaseClass::clearGlyphMesh(); }
     void setArrowTypeToLine() { this->setArrowType( LineArrow ); }
     void setArrowTypeToTube() { this->setArrowType( TubeArrow ); }
     ArrowType arrowType() const { return m_arrow_type; }
@@ -61,6 +61,8 @@ private:
     void draw_tubes();
     void draw_line_element( const kvs::RGBColor& color, const kvs::UInt8 opacity );
     void draw_tube_element( const kvs::RGBColor& color, const kvs::UInt8 opacity );
+    void draw_instances();
+    void create_mesh();
     void initialize();
 
 public:
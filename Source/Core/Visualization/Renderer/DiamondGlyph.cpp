@@ -207,6 +207,8 @@ void DiamondGlyph::attach_volume( const kvs::VolumeObjectBase* volume )
 /*===========================================================================*/
 void DiamondGlyph::draw()
 {
+    if ( BaseClass::isEnabledInstancing() ) { this->draw_instances(); return; }
+
     const size_t npoints = BaseClass::coords().size() / 3;
     if ( BaseClass::directions().size() == 0 )
     {
@@ -271,6 +273,46 @@ void DiamondGlyph::draw_element( const kvs::RGBColor& color, const kvs::UInt8 op
     kvs::OpenGL::End();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Draw the diamond glyphs with instanced rendering.
+ */
+/*===========================================================================*/
+void DiamondGlyph::draw_instances()
+{
+    if ( !BaseClass::hasGlyphMesh() ) { this->create_mesh(); }
+    BaseClass::drawInstances();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the diamond mesh with the face normals for instanced rendering.
+ */
+/*===========================================================================*/
+void DiamondGlyph::create_mesh()
+{
+    kvs::ValueArray<kvs::Real32> vertices( 24 * 3 );
+    kvs::ValueArray<kvs::Real32> normals( 24 * 3 );
+    for ( size_t i = 0, index = 0; i < 8; i++, index += 3 )
+    {
+        const kvs::Vec3 v0( ::Vertices + ::Connections[index] * 3 );
+        const kvs::Vec3 v1( ::Vertices + ::Connections[index+1] * 3 );
+        const kvs::Vec3 v2( ::Vertices + ::Connections[index+2] * 3 );
+        const kvs::Vec3 n = ( v2 - v1 ).cross( v0 - v1 ).normalized();
+        const kvs::Vec3 v[3] = { v0, v1, v2 };
+        for ( size_t j = 0; j < 3; j++ )
+        {
+            for ( size_t k = 0; k < 3; k++ )
+            {
+                vertices[ ( index + j ) * 3 + k ] = v[j][k];
+                normals[ ( index + j ) * 3 + k ] = n[k];
+            }
+        }
+    }
+
+    BaseClass::setGlyphMesh( GL_TRIANGLES, vertices, normals );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Initialize the modelview matrix.
@@ -50,6 +50,8 @@ protected:
     void attach_volume( const kvs::VolumeObjectBase* volume );
     void draw();
     void draw_element( const kvs::RGBColor& color, const kvs::UInt8 opacity );
+    void draw_instances();
+    void create_mesh();
     void initialize();
 };
 
@@ -31,6 +31,7 @@ private:
     kvs::ProgramObject m_drawing_shader;
 
 public:
+    size_t count() const { return m_count; }
     const kvs::Texture2D& currentColorTexture() const { return m_current_color_texture; }
     const kvs::Texture2D& currentDepthTexture() const { return m_current_depth_texture; }
     const kvs::FrameBufferObject& currentFrameBufferObject() const { return m_current_framebuffer; }
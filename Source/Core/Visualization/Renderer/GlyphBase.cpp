@@ -8,6 +8,8 @@
 #include <kvs/OpenGL>
 #include <kvs/Quaternion>
 #include <kvs/StructuredVolumeObject>
+#include <kvs/AnyValueArray>
+#include <kvs/ShaderSource>
 
 
 namespace
@@ -33,7 +35,14 @@ GlyphBase::GlyphBase():
     m_color_mode( GlyphBase::ColorByMagnitude ),
     m_opacity_mode( GlyphBase::OpacityByDefault ),
     m_scale( 1.0f, 1.0f, 1.0f ),
-    m_tfunc()
+    m_tfunc(),
+    m_enable_instancing( false ),
+    m_shading_model( new kvs::Shader::Lambert() ),
+    m_shader_shading( false ),
+    m_shader_culling( false ),
+    m_mesh_mode( GL_TRIANGLES ),
+    m_update_mesh( false ),
+    m_update_instances( true )
 {
 }
 
@@ -44,6 +53,7 @@ GlyphBase::GlyphBase():
 /*===========================================================================*/
 GlyphBase::~GlyphBase()
 {
+    if ( m_shading_model ) { delete m_shading_model; }
 }
 
 /*===========================================================================*/
@@ -451,4 +461,172 @@ template void GlyphBase::calculateOpacities<kvs::UInt64>( const kvs::VolumeObjec
 template void GlyphBase::calculateOpacities<kvs::Real32>( const kvs::VolumeObjectBase* volume );
 template void GlyphBase::calculateOpacities<kvs::Real64>( const kvs::VolumeObjectBase* volume );
 
+/*===========================================================================*/
+/**
+ *  @brief  Sets the glyph mesh used for the instanced rendering.
+ *  @param  mode [in] primitive type (GL_LINES or GL_TRIANGLES)
+ *  @param  vertices [in] vertex array in the glyph coordinate (y-axis is the default direction)
+ *  @param  normals [in] normal array (empty for no shading)
+ *  @param  connections [in] connection array (empty for non-indexed mesh)
+ */
+/*===========================================================================*/
+void GlyphBase::setGlyphMesh(
+    const GLenum mode,
+    const kvs::ValueArray<kvs::Real32>& vertices,
+    const kvs::ValueArray<kvs::Real32>& normals,
+    const kvs::ValueArray<kvs::UInt32>& connections )
+{
+    m_mesh_mode = mode;
+    m_mesh_vertices = vertices;
+    m_mesh_normals = normals;
+    m_mesh_connections = connections;
+    m_update_mesh = true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Clears the glyph mesh to be recreated by the derived class.
+ */
+/*===========================================================================*/
+void GlyphBase::clearGlyphMesh()
+{
+    m_mesh_vertices.release();
+    m_mesh_normals.release();
+    m_mesh_connections.release();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Draws all of the glyphs with a single instanced draw call.
+ *  @param  cull_zero_direction [in] if true, the glyphs with zero direction are not drawn
+ */
+/*===========================================================================*/
+void GlyphBase::drawInstances( const bool cull_zero_direction )
+{
+    const size_t ninstances = m_coords.size() / 3;
+    if ( ninstances == 0 || !this->hasGlyphMesh() ) { return; }
+
+    // The attribute locations depend on the shader program, so that the
+    // buffer object is recreated with the program.
+    const bool shading = this->isEnabledShading() && m_mesh_normals.size() > 0;
+    const bool culling = cull_zero_direction;
+    if ( !m_shader_program.isCreated() ||
+         m_shader_shading != shading || m_shader_culling != culling ||
+         m_update_mesh || m_update_instances )
+    {
+        m_shader_program.release();
+        this->create_shader_program( shading, culling );
+        this->create_buffer_object();
+    }
+
+    kvs::ProgramObject::Binder bind_program( m_shader_program );
+    {
+        const kvs::Mat4 M = kvs::OpenGL::ModelViewMatrix();
+        const kvs::Mat4 PM = kvs::OpenGL::ProjectionMatrix() * M;
+        const kvs::Mat3 N = kvs::Mat3( M[0].xyz(), M[1].xyz(), M[2].xyz() );
+        m_shader_program.setUniform( "ModelViewMatrix", M );
+        m_shader_program.setUniform( "ModelViewProjectionMatrix", PM );
+        m_shader_program.setUniform( "NormalMatrix", N );
+        m_shader_program.setUniform( "glyph_scale", m_scale );
+        m_shader_program.setUniform( "shading.Ka", m_shading_model->Ka );
+        m_shader_program.setUniform( "shading.Kd", m_shading_model->Kd );
+        m_shader_program.setUniform( "shading.Ks", m_shading_model->Ks );
+        m_shader_program.setUniform( "shading.S",  m_shading_model->S );
+    }
+
+    kvs::VertexBufferObjectManager::Binder bind_buffer( m_buffer_object );
+    const GLsizei count = static_cast<GLsizei>( ninstances );
+    if ( m_mesh_connections.size() > 0 )
+    {
+        const GLsizei nindices = static_cast<GLsizei>( m_mesh_connections.size() );
+        m_buffer_object.drawElementsInstanced( m_mesh_mode, nindices, count );
+    }
+    else
+    {
+        const GLsizei nvertices = static_cast<GLsizei>( m_mesh_vertices.size() / 3 );
+        m_buffer_object.drawArraysInstanced( m_mesh_mode, 0, nvertices, count );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the shader program for the instanced rendering.
+ *  @param  shading [in] if true, the glyphs are shaded
+ *  @param  culling [in] if true, the glyphs with zero direction are not drawn
+ */
+/*===========================================================================*/
+void GlyphBase::create_shader_program( const bool shading, const bool culling )
+{
+    kvs::ShaderSource vert( "glyph.vert" );
+    kvs::ShaderSource frag( "glyph.frag" );
+    if ( m_directions.size() > 0 ) { vert.define("ENABLE_DIRECTION"); }
+    if ( culling ) { vert.define("ENABLE_ZERO_DIRECTION_CULLING"); }
+    if ( shading )
+    {
+        switch ( m_shading_model->type() )
+        {
+        case kvs::Shader::LambertShading: frag.define("ENABLE_LAMBERT_SHADING"); break;
+        case kvs::Shader::PhongShading: frag.define("ENABLE_PHONG_SHADING"); break;
+        case kvs::Shader::BlinnPhongShading: frag.define("ENABLE_BLINN_PHONG_SHADING"); break;
+        default: break; // NO SHADING
+        }
+
+        if ( kvs::OpenGL::Boolean( GL_LIGHT_MODEL_TWO_SIDE ) == GL_TRUE )
+        {
+            frag.define("ENABLE_TWO_SIDE_LIGHTING");
+        }
+    }
+
+    m_shader_program.build( vert, frag );
+    m_shader_shading = shading;
+    m_shader_culling = culling;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the buffer object of the glyph mesh and the per-glyph arrays.
+ *
+ *  The glyph mesh is stored as the vertex and normal arrays, and each of the
+ *  per-glyph arrays is stored as the vertex attribute advanced per instance.
+ */
+/*===========================================================================*/
+void GlyphBase::create_buffer_object()
+{
+    struct Attribute
+    {
+        const char* name; ///< attribute name
+        const kvs::AnyValueArray array; ///< per-glyph array
+        size_t dim; ///< number of components
+        bool normalized; ///< true for the color and opacity values
+    };
+
+    const Attribute attributes[] =
+    {
+        { "glyph_position", kvs::AnyValueArray( m_coords ), 3, false },
+        { "glyph_direction", kvs::AnyValueArray( m_directions ), 3, false },
+        { "glyph_size", kvs::AnyValueArray( m_sizes ), 1, false },
+        { "glyph_color", kvs::AnyValueArray( m_colors ), 3, true },
+        { "glyph_opacity", kvs::AnyValueArray( m_opacities ), 1, true }
+    };
+
+    m_buffer_object.release();
+    m_buffer_object.setVertexArray( m_mesh_vertices, 3 );
+    if ( m_mesh_normals.size() > 0 ) { m_buffer_object.setNormalArray( m_mesh_normals ); }
+    if ( m_mesh_connections.size() > 0 ) { m_buffer_object.setIndexArray( m_mesh_connections ); }
+
+    for ( size_t i = 0; i < sizeof( attributes ) / sizeof( Attribute ); i++ )
+    {
+        const Attribute& attribute = attributes[i];
+        const GLint location = m_shader_program.attributeLocation( attribute.name );
+        if ( location < 0 || attribute.array.size() == 0 ) { continue; }
+
+        m_buffer_object.setVertexAttribArray( attribute.array, location, attribute.dim, attribute.normalized );
+        m_buffer_object.setVertexAttribDivisor( location, 1 );
+    }
+
+    m_buffer_object.create();
+    m_update_mesh = false;
+    m_update_instances = false;
+}
+
 } // end of namespace kvs
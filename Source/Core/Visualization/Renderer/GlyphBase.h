@@ -11,6 +11,10 @@
 #include <kvs/ValueArray>
 #include <kvs/Vector3>
 #include <kvs/TransferFunction>
+#include <kvs/Shader>
+#include <kvs/ProgramObject>
+#include <kvs/VertexBufferObjectManager>
+#include <kvs/OpenGL>
 
 
 namespace kvs
@@ -22,6 +26,11 @@ class StructuredVolumeObject;
 /*===========================================================================*/
 /**
  *  @brief  Glyph renderer base class.
+ *
+ *  If the instancing is enabled, the per-glyph arrays (coords, directions,
+ *  sizes, colors and opacities) are uploaded once into the instance buffer
+ *  and all of the glyphs are drawn with a single instanced draw call of the
+ *  glyph mesh given by the derived class (OpenGL 3.3 or later is required).
  */
 /*===========================================================================*/
 class GlyphBase : public kvs::RendererBase
@@ -68,6 +77,20 @@ private:
     kvs::Vector3f m_scale; ///< scaling vector
     kvs::TransferFunction m_tfunc; ///< transfer function
 
+    // Instanced rendering.
+    bool m_enable_instancing; ///< flag for the instanced rendering
+    kvs::Shader::ShadingModel* m_shading_model; ///< shading method
+    kvs::ProgramObject m_shader_program; ///< shader program
+    bool m_shader_shading; ///< shading flag of the shader program
+    bool m_shader_culling; ///< zero direction culling flag of the shader program
+    GLenum m_mesh_mode; ///< primitive type of the glyph mesh
+    kvs::ValueArray<kvs::Real32> m_mesh_vertices; ///< vertex array of the glyph mesh
+    kvs::ValueArray<kvs::Real32> m_mesh_normals; ///< normal array of the glyph mesh
+    kvs::ValueArray<kvs::UInt32> m_mesh_connections; ///< connection array of the glyph mesh
+    kvs::VertexBufferObjectManager m_buffer_object; ///< buffer object of the glyph mesh and the per-glyph arrays
+    bool m_update_mesh; ///< true if the glyph mesh needs to be uploaded
+    bool m_update_instances; ///< true if the per-glyph arrays need to be uploaded
+
 public:
 
     GlyphBase();
@@ -79,14 +102,25 @@ public:
     void setDirectionMode( const DirectionMode mode ) { m_direction_mode = mode; }
     void setColorMode( const ColorMode mode ) { m_color_mode = mode; }
     void setOpacityMode( const OpacityMode mode ) { m_opacity_mode = mode; }
-    void setCoords( const kvs::ValueArray<kvs::Real32>& coords ) { m_coords = coords; }
-    void setSizes( const kvs::ValueArray<kvs::Real32>& sizes ) { m_sizes = sizes; }
-    void setDirections( const kvs::ValueArray<kvs::Real32>& directions ) { m_directions = directions; }
-    void setColors( const kvs::ValueArray<kvs::UInt8>& colors ) { m_colors = colors; }
-    void setOpacities( const kvs::ValueArray<kvs::UInt8>& opacities ) { m_opacities = opacities; }
+    void setCoords( const kvs::ValueArray<kvs::Real32>& coords ) { m_coords = coords; m_update_instances = true; }
+    void setSizes( const kvs::ValueArray<kvs::Real32>& sizes ) { m_sizes = sizes; m_update_instances = true; }
+    void setDirections( const kvs::ValueArray<kvs::Real32>& directions ) { m_directions = directions; m_update_instances = true; }
+    void setColors( const kvs::ValueArray<kvs::UInt8>& colors ) { m_colors = colors; m_update_instances = true; }
+    void setOpacities( const kvs::ValueArray<kvs::UInt8>& opacities ) { m_opacities = opacities; m_update_instances = true; }
     void setScale( const kvs::Real32 scale ) { m_scale = kvs::Vec3::Constant( scale ); }
     void setScale( const kvs::Vec3& scale ) { m_scale = scale; }
     void setTransferFunction( const kvs::TransferFunction& tfunc ) { m_tfunc = tfunc; }
+    void setEnabledInstancing( const bool enable ) { m_enable_instancing = enable; }
+    void enableInstancing() { this->setEnabledInstancing( true ); }
+    void disableInstancing() { this->setEnabledInstancing( false ); }
+
+    template <typename Model>
+    void setShadingModel( const Model model )
+    {
+        if ( m_shading_model ) { delete m_shading_model; m_shading_model = NULL; }
+        m_shading_model = new Model( model );
+        m_shader_program.release();
+    }
     SizeMode sizeMode() const { return m_size_mode; }
     DirectionMode directionMode() const { return m_direction_mode; }
     ColorMode colorMode() const { return m_color_mode; }
@@ -98,6 +132,7 @@ public:
     const kvs::ValueArray<kvs::UInt8>& opacities() const { return m_opacities; }
     const kvs::Vec3& scale() const { return m_scale; }
     const kvs::TransferFunction& transferFunction() const { return m_tfunc; }
+    bool isEnabledInstancing() const { return m_enable_instancing; }
 
 protected:
 
@@ -111,6 +146,19 @@ protected:
     template <typename T> void calculateDirections( const kvs::VolumeObjectBase* volume );
     template <typename T> void calculateColors( const kvs::VolumeObjectBase* volume );
     template <typename T> void calculateOpacities( const kvs::VolumeObjectBase* volume );
+
+    bool hasGlyphMesh() const { return m_mesh_vertices.size() > 0; }
+    void setGlyphMesh(
+        const GLenum mode,
+        const kvs::ValueArray<kvs::Real32>& vertices,
+        const kvs::ValueArray<kvs::Real32>& normals,
+        const kvs::ValueArray<kvs::UInt32>& connections = kvs::ValueArray<kvs::UInt32>() );
+    void clearGlyphMesh();
+    void drawInstances( const bool cull_zero_direction = false );
+
+private:
+    void create_shader_program( const bool shading, const bool culling );
+    void create_buffer_object();
 };
 
 } // end of namespace kvs
@@ -151,6 +151,13 @@ void HAVSVolumeRenderer::exec( kvs::ObjectBase* object, kvs::Camera* camera, kvs
         this->initialize_framebuffer();
     }
 
+    // Following process is executed when the transfer function is changed.
+    // The pre-integration table is updated only for the changed scalar range.
+    if ( m_transfer_function_changed )
+    {
+        this->initialize_table();
+    }
+
     // Following processes are executed when the window size is changed.
     if ( ( BaseClass::windowWidth() != camera->windowWidth() ) ||
          ( BaseClass::windowHeight() != camera->windowHeight() ) )
@@ -180,6 +187,7 @@ void HAVSVolumeRenderer::initialize()
     m_meshes = NULL;
     m_enable_vbo = true;
     m_pindices = NULL;
+    m_transfer_function_changed = true;
 }
 
 void HAVSVolumeRenderer::attachVolumeObject( const kvs::UnstructuredVolumeObject* volume )
@@ -251,11 +259,18 @@ void HAVSVolumeRenderer::initialize_table()
     const float max_size_of_cell = m_meshes->depthScale() * 2.0f;
     const size_t dim_scalar = 128;
     const size_t dim_depth = 128;
-    kvs::PreIntegrationTable3D table;
-    table.setScalarResolution( dim_scalar );
-    table.setDepthResolution( dim_depth );
-    table.setTransferFunction( BaseClass::transferFunction(), min_value, max_value );
-    table.create( max_size_of_cell );
+    m_preintegration_table.setScalarResolution( dim_scalar );
+    m_preintegration_table.setDepthResolution( dim_depth );
+    m_preintegration_table.setTransferFunction( BaseClass::transferFunction(), min_value, max_value );
+    m_preintegration_table.create( max_size_of_cell );
+    m_transfer_function_changed = false;
+
+    if ( m_preintegration_texture.isCreated() )
+    {
+        kvs::Texture::GuardedBinder binder( m_preintegration_texture );
+        m_preintegration_texture.load( dim_scalar, dim_scalar, dim_depth, m_preintegration_table.table().data() );
+        return;
+    }
 
     m_preintegration_texture.setWrapS( GL_CLAMP_TO_EDGE );
     m_preintegration_texture.setWrapT( GL_CLAMP_TO_EDGE );
@@ -263,7 +278,7 @@ void HAVSVolumeRenderer::initialize_table()
     m_preintegration_texture.setMagFilter( GL_LINEAR );
     m_preintegration_texture.setMinFilter( GL_LINEAR );
     m_preintegration_texture.setPixelFormat( GL_RGBA8, GL_RGBA, GL_FLOAT );
-    m_preintegration_texture.create( dim_scalar, dim_scalar, dim_depth, table.table().data() );
+    m_preintegration_texture.create( dim_scalar, dim_scalar, dim_depth, m_preintegration_table.table().data() );
 }
 
 void HAVSVolumeRenderer::initialize_framebuffer()
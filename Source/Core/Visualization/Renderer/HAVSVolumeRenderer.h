@@ -31,6 +31,7 @@
 #include <kvs/IndexBufferObject>
 #include <kvs/ProgramObject>
 #include <kvs/FrameBufferObject>
+#include <kvs/PreIntegrationTable3D>
 
 
 namespace kvs
@@ -58,7 +59,9 @@ private:
     // Reference data (NOTE: not allocated in thie class).
     const kvs::UnstructuredVolumeObject* m_ref_volume; ///< pointer to the volume data
 
+    kvs::PreIntegrationTable3D m_preintegration_table; ///< pre-integration table
     kvs::Texture3D m_preintegration_texture; ///< pre-integration texture
+    bool m_transfer_function_changed; ///< flag for changing transfer function
     size_t m_k_size; ///< k-buffer size (2 or 6)
     Meshes* m_meshes; ///< tetrahedral meshes for HAVS
     bool m_enable_vbo; ///< flag for checking if VBO is enabled
@@ -79,6 +82,7 @@ public:
     HAVSVolumeRenderer( kvs::UnstructuredVolumeObject* volume, const size_t k_size = 2 );
     virtual ~HAVSVolumeRenderer();
 
+    void setTransferFunction( const kvs::TransferFunction& tfunc ) { BaseClass::setTransferFunction( tfunc ); m_transfer_function_changed = true; }
     void setKBufferSize( const size_t k_size ) { m_k_size = k_size; }
     void enableVBO() { m_enable_vbo = true; }
     void disableVBO() { m_enable_vbo = false; }
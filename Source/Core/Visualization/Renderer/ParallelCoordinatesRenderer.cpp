@@ -11,6 +11,72 @@
 #include <kvs/ObjectBase>
 #include <kvs/TableObject>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Parallel>
+#include <algorithm>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Normalizes the values by the min/max values.
+ *  @param  values [in] values
+ *  @param  min_value [in] min. value
+ *  @param  max_value [in] max. value
+ *  @param  normalized [out] pointer to the first normalized value
+ *  @param  stride [in] stride of the normalized values
+ */
+/*===========================================================================*/
+template <typename T>
+void Normalize(
+    const kvs::AnyValueArray& values,
+    const kvs::Real64 min_value,
+    const kvs::Real64 max_value,
+    kvs::Real32* normalized,
+    const size_t stride )
+{
+    const T* data = static_cast<const T*>( values.data() );
+    const size_t nvalues = values.size();
+    if ( max_value > min_value )
+    {
+        const kvs::Real64 scale = 1.0 / ( max_value - min_value );
+        kvs::ParallelFor( size_t(0), nvalues, [&]( const size_t i )
+        {
+            normalized[ i * stride ] = static_cast<kvs::Real32>( ( data[i] - min_value ) * scale );
+        }, 4096 );
+    }
+    else
+    {
+        // Constant values are placed at the middle of the axis.
+        for ( size_t i = 0; i < nvalues; i++ ) { normalized[ i * stride ] = 0.5f; }
+    }
+}
+
+void Normalize(
+    const kvs::AnyValueArray& values,
+    const kvs::Real64 min_value,
+    const kvs::Real64 max_value,
+    kvs::Real32* normalized,
+    const size_t stride )
+{
+    switch ( values.typeID() )
+    {
+    case kvs::Type::TypeInt8:   ::Normalize<kvs::Int8>( values, min_value, max_value, normalized, stride ); break;
+    case kvs::Type::TypeUInt8:  ::Normalize<kvs::UInt8>( values, min_value, max_value, normalized, stride ); break;
+    case kvs::Type::TypeInt16:  ::Normalize<kvs::Int16>( values, min_value, max_value, normalized, stride ); break;
+    case kvs::Type::TypeUInt16: ::Normalize<kvs::UInt16>( values, min_value, max_value, normalized, stride ); break;
+    case kvs::Type::TypeInt32:  ::Normalize<kvs::Int32>( values, min_value, max_value, normalized, stride ); break;
+    case kvs::Type::TypeUInt32: ::Normalize<kvs::UInt32>( values, min_value, max_value, normalized, stride ); break;
+    case kvs::Type::TypeInt64:  ::Normalize<kvs::Int64>( values, min_value, max_value, normalized, stride ); break;
+    case kvs::Type::TypeUInt64: ::Normalize<kvs::UInt64>( values, min_value, max_value, normalized, stride ); break;
+    case kvs::Type::TypeReal32: ::Normalize<kvs::Real32>( values, min_value, max_value, normalized, stride ); break;
+    case kvs::Type::TypeReal64: ::Normalize<kvs::Real64>( values, min_value, max_value, normalized, stride ); break;
+    default: break;
+    }
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -31,7 +97,11 @@ ParallelCoordinatesRenderer::ParallelCoordinatesRenderer():
     m_active_axis( 0 ),
     m_line_opacity( 255 ),
     m_line_width( 1.0f ),
-    m_color_map( 256 )
+    m_color_map( 256 ),
+    m_object( NULL ),
+    m_modified_stamp( 0 ),
+    m_color_axis( 0 ),
+    m_color_opacity( 0 )
 {
     m_color_map.create();
 }
@@ -100,50 +170,176 @@ void ParallelCoordinatesRenderer::exec( kvs::ObjectBase* object, kvs::Camera* ca
     kvs::OpenGL::Enable( GL_BLEND );
     kvs::OpenGL::SetBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
 
+    const size_t naxes = table->numberOfColumns();
+    const size_t nrows = table->numberOfRows();
+    if ( naxes < 2 || nrows == 0 ) { BaseClass::stopTimer(); return; }
+
+    if ( this->isCoordChanged( table ) ) { this->createCoordBuffer( table ); }
+    if ( this->isColorChanged( table ) ) { this->createColorBuffer( table ); }
+    if ( m_inside_range_flags != table->insideRangeFlags() ) { this->createDrawList( table ); }
+
     kvs::OpenGL::Render2D render( kvs::OpenGL::Viewport() );
     render.begin();
     {
-        const float color_axis_min_value = static_cast<float>( table->minValue( m_active_axis ) );
-        const float color_axis_max_value = static_cast<float>( table->maxValue( m_active_axis ) );
-        const kvs::AnyValueArray& color_axis_values = table->column( m_active_axis );
-        m_color_map.setRange( color_axis_min_value, color_axis_max_value );
-
         const float dpr = camera->devicePixelRatio();
         const int x0 = m_left_margin;
         const int x1 = camera->windowWidth() - m_right_margin;
         const int y0 = m_top_margin;
         const int y1 = camera->windowHeight() - m_bottom_margin;
-
-        const size_t nrows = table->column(0).size();
-        const size_t naxes = table->numberOfColumns();
         const float stride = float( x1 - x0 ) / ( naxes - 1 );
-        for ( size_t i = 0; i < nrows; i++ )
+
+        // The vertex (j,v) for the j-th axis and the normalized value v is
+        // mapped to ( x0 + stride * j, y1 - ( y1 - y0 ) * v ).
+        kvs::OpenGL::SetMatrixMode( GL_MODELVIEW );
+        kvs::OpenGL::Translate( x0 * dpr, y1 * dpr, 0.0f );
+        kvs::OpenGL::Scale( stride * dpr, -( y1 - y0 ) * dpr, 1.0f );
+        kvs::OpenGL::SetLineWidth( m_line_width * dpr );
+
+        kvs::OpenGL::EnableClientState( GL_VERTEX_ARRAY );
+        kvs::OpenGL::EnableClientState( GL_COLOR_ARRAY );
+        {
+            kvs::VertexBufferObject::Binder coord( m_coord_buffer );
+            kvs::OpenGL::VertexPointer( 2, GL_FLOAT, 0, 0 );
+        }
         {
-            if ( !table->insideRange( i ) ) continue;
-
-            kvs::OpenGL::SetLineWidth( m_line_width * dpr );
-            kvs::OpenGL::Begin( GL_LINE_STRIP );
-            {
-                const kvs::Real64 color_value = color_axis_values[i].to<kvs::Real64>();
-                const kvs::RGBColor color = m_color_map.at( static_cast<float>( color_value ) );
-                kvs::OpenGL::Color( color.r(), color.g(), color.b(), m_line_opacity );
-                for ( size_t j = 0; j < naxes; j++ )
-                {
-                    const kvs::Real64 min_value = table->minValue(j);
-                    const kvs::Real64 max_value = table->maxValue(j);
-                    const kvs::Real64 value = table->column(j)[i].to<kvs::Real64>();
-
-                    const kvs::Real64 x = m_left_margin + stride * j;
-                    const kvs::Real64 y = y1 - ( y1 - y0 ) * ( value - min_value ) / ( max_value - min_value );
-                    kvs::OpenGL::Vertex( kvs::Vec2( x, y ) * dpr );
-                }
-            }
-            kvs::OpenGL::End();
+            kvs::VertexBufferObject::Binder color( m_color_buffer );
+            kvs::OpenGL::ColorPointer( 4, GL_UNSIGNED_BYTE, 0, 0 );
         }
+        kvs::OpenGL::MultiDrawArrays( GL_LINE_STRIP, m_first, m_count );
+        kvs::OpenGL::DisableClientState( GL_COLOR_ARRAY );
+        kvs::OpenGL::DisableClientState( GL_VERTEX_ARRAY );
     }
     render.end();
 
     BaseClass::stopTimer();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the buffered coordinates need to be updated.
+ *  @param  table [in] pointer to the table object
+ *  @return true if the table, its values or the min/max values have been changed
+ */
+/*===========================================================================*/
+bool ParallelCoordinatesRenderer::isCoordChanged( const kvs::TableObject* table ) const
+{
+    return m_object != table ||
+        m_modified_stamp != table->modifiedStamp() ||
+        m_min_values != table->minValues() ||
+        m_max_values != table->maxValues();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the buffered colors need to be updated.
+ *  @param  table [in] pointer to the table object
+ *  @return true if the active axis, the opacity or the color map have been changed
+ */
+/*===========================================================================*/
+bool ParallelCoordinatesRenderer::isColorChanged( const kvs::TableObject* table ) const
+{
+    return m_object != table ||
+        m_color_axis != m_active_axis ||
+        m_color_opacity != m_line_opacity ||
+        !( m_color_table == m_color_map.table() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the vertex buffer for the normalized coordinates.
+ *  @param  table [in] pointer to the table object
+ *
+ *  The coordinates of the polyline of each row are stored as (j,v) for the
+ *  j-th axis and the value v normalized into [0,1].
+ */
+/*===========================================================================*/
+void ParallelCoordinatesRenderer::createCoordBuffer( const kvs::TableObject* table )
+{
+    const size_t naxes = table->numberOfColumns();
+    const size_t nrows = table->numberOfRows();
+
+    kvs::ValueArray<kvs::Real32> coords( nrows * naxes * 2 );
+    for ( size_t j = 0; j < naxes; j++ )
+    {
+        kvs::Real32* axis = coords.data() + j * 2;
+        for ( size_t i = 0; i < nrows; i++ ) { axis[ i * naxes * 2 ] = static_cast<kvs::Real32>( j ); }
+        ::Normalize( table->column(j), table->minValue(j), table->maxValue(j), axis + 1, naxes * 2 );
+    }
+
+    m_coord_buffer.release();
+    m_coord_buffer.create( coords.byteSize(), coords.data() );
+
+    m_object = table;
+    m_modified_stamp = table->modifiedStamp();
+    m_min_values = table->minValues();
+    m_max_values = table->maxValues();
+
+    // The colors and the draw list are created for the new table.
+    m_color_table.release();
+    m_inside_range_flags.clear();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the vertex buffer for the colors.
+ *  @param  table [in] pointer to the table object
+ */
+/*===========================================================================*/
+void ParallelCoordinatesRenderer::createColorBuffer( const kvs::TableObject* table )
+{
+    const size_t naxes = table->numberOfColumns();
+    const size_t nrows = table->numberOfRows();
+
+    const float min_value = static_cast<float>( table->minValue( m_active_axis ) );
+    const float max_value = static_cast<float>( table->maxValue( m_active_axis ) );
+    const kvs::AnyValueArray& values = table->column( m_active_axis );
+    m_color_map.setRange( min_value, max_value );
+
+    const kvs::UInt8 opacity = m_line_opacity;
+    kvs::ValueArray<kvs::UInt8> colors( nrows * naxes * 4 );
+    kvs::ParallelFor( size_t(0), nrows, [&]( const size_t i )
+    {
+        const kvs::Real64 value = values[i].to<kvs::Real64>();
+        const kvs::RGBColor color = m_color_map.at( static_cast<float>( value ) );
+        kvs::UInt8* c = colors.data() + i * naxes * 4;
+        for ( size_t j = 0; j < naxes; j++, c += 4 )
+        {
+            c[0] = color.r(); c[1] = color.g(); c[2] = color.b(); c[3] = opacity;
+        }
+    }, 1024 );
+
+    m_color_buffer.release();
+    m_color_buffer.create( colors.byteSize(), colors.data() );
+
+    m_color_axis = m_active_axis;
+    m_color_opacity = m_line_opacity;
+    m_color_table = m_color_map.table().clone();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the list of the rows inside the ranges of the axes.
+ *  @param  table [in] pointer to the table object
+ */
+/*===========================================================================*/
+void ParallelCoordinatesRenderer::createDrawList( const kvs::TableObject* table )
+{
+    const size_t naxes = table->numberOfColumns();
+    const size_t nrows = table->numberOfRows();
+    const std::vector<kvs::UInt8>& flags = table->insideRangeFlags();
+    const size_t ndraws = std::count( flags.begin(), flags.end(), kvs::UInt8(1) );
+
+    m_first.allocate( ndraws );
+    m_count.allocate( ndraws );
+    for ( size_t i = 0, k = 0; i < nrows; i++ )
+    {
+        if ( flags[i] != 1 ) continue;
+        m_first[k] = static_cast<GLint>( i * naxes );
+        m_count[k] = static_cast<GLsizei>( naxes );
+        k++;
+    }
+
+    m_inside_range_flags = flags;
+}
+
 } // end of namespace kvs
@@ -7,9 +7,12 @@
 #ifndef KVS__PARALLEL_COORDINATES_RENDERER_H_INCLUDE
 #define KVS__PARALLEL_COORDINATES_RENDERER_H_INCLUDE
 
+#include <vector>
 #include <kvs/RendererBase>
 #include <kvs/Module>
 #include <kvs/ColorMap>
+#include <kvs/ValueArray>
+#include <kvs/VertexBufferObject>
 
 
 namespace kvs
@@ -18,10 +21,18 @@ namespace kvs
 class ObjectBase;
 class Camera;
 class Light;
+class TableObject;
 
 /*===========================================================================*/
 /**
  *  @brief  Parallel coordinates renderer class.
+ *
+ *  The polylines of the rows are stored in the vertex buffers as the values
+ *  normalized by the min/max values of the axes, and drawn by a single draw
+ *  call. The coordinates are rebuilt only when the table or its modification
+ *  stamp (see kvs::TableObject::setModified) are changed, the colors only
+ *  when the color settings are changed, and the ranges of the axes
+ *  (brushing) change only the list of the drawn rows.
  */
 /*===========================================================================*/
 class ParallelCoordinatesRenderer : public kvs::RendererBase
@@ -42,6 +53,20 @@ private:
     kvs::Real32 m_line_width; ///< line width
     kvs::ColorMap m_color_map; ///< color map
 
+    // Buffers for the polylines
+    const kvs::ObjectBase* m_object; ///< pointer to the buffered object (not allocated)
+    size_t m_modified_stamp; ///< modification stamp of the buffered object
+    std::vector<kvs::Real64> m_min_values; ///< min. values of the buffered coordinates
+    std::vector<kvs::Real64> m_max_values; ///< max. values of the buffered coordinates
+    std::vector<kvs::UInt8> m_inside_range_flags; ///< range flags of the buffered rows
+    size_t m_color_axis; ///< axis of the buffered colors
+    kvs::UInt8 m_color_opacity; ///< opacity of the buffered colors
+    kvs::ValueArray<kvs::UInt8> m_color_table; ///< color map table of the buffered colors
+    kvs::VertexBufferObject m_coord_buffer; ///< VBO for the normalized coordinates
+    kvs::VertexBufferObject m_color_buffer; ///< VBO for the colors
+    kvs::ValueArray<GLint> m_first; ///< first vertex indices of the drawn rows
+    kvs::ValueArray<GLsizei> m_count; ///< number of vertices of the drawn rows
+
 public:
 
     ParallelCoordinatesRenderer();
@@ -65,6 +90,14 @@ public:
     void disableAntiAliasing() const;
 
     void exec( kvs::ObjectBase* object, kvs::Camera* camera, kvs::Light* light );
+
+private:
+
+    bool isCoordChanged( const kvs::TableObject* table ) const;
+    bool isColorChanged( const kvs::TableObject* table ) const;
+    void createCoordBuffer( const kvs::TableObject* table );
+    void createColorBuffer( const kvs::TableObject* table );
+    void createDrawList( const kvs::TableObject* table );
 };
 
 } // end of namespace kvs
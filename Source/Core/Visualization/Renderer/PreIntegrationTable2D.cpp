@@ -7,6 +7,7 @@
 #include "PreIntegrationTable2D.h"
 #include <kvs/Assert>
 #include <kvs/Math>
+#include <kvs/Parallel>
 
 
 namespace
@@ -147,19 +148,53 @@ void PreIntegrationTable2D::setTransferFunction( const kvs::TransferFunction& tr
 /*===========================================================================*/
 /**
  *  @brief  Creates pre-integration table.
+ *
+ *  Each entry is obtained from the prefix sums T of the extinction densities,
+ *  and the rows are computed in parallel. If the table has been created with
+ *  the same resolution, only the entries whose scalar range overlaps the
+ *  changed extinction densities are recomputed.
  */
 /*===========================================================================*/
 void PreIntegrationTable2D::create()
 {
-    kvs::ValueArray<kvs::Real64> T = m_T;
-    kvs::ValueArray<kvs::Real64> tau = m_tau;
-
+    const kvs::ValueArray<kvs::Real64>& T = m_T;
+    const kvs::ValueArray<kvs::Real64>& tau = m_tau;
     const size_t resolution = tau.size();
-    kvs::ValueArray<kvs::Real32> table( resolution * resolution );
-    for ( size_t i = 0, index = 0; i < resolution; i++ )
+
+    // Find the range of the scalars changed from the previous creation.
+    size_t lo = 0;
+    size_t hi = resolution - 1;
+    if ( m_table.size() == resolution * resolution && m_table_tau.size() == resolution )
     {
-        for ( size_t j = 0; j < resolution; j++, index++ )
+        lo = resolution;
+        hi = 0;
+        for ( size_t i = 0; i < resolution; i++ )
         {
+            if ( m_table_tau[i] != tau[i] )
+            {
+                lo = kvs::Math::Min( lo, i );
+                hi = i;
+            }
+        }
+        if ( lo > hi ) { return; }
+
+        // The table array might be shared with the previously returned one.
+        if ( !m_table.unique() ) { m_table = m_table.clone(); }
+    }
+    else
+    {
+        m_table.allocate( resolution * resolution );
+    }
+
+    kvs::Real32* table = m_table.data();
+    kvs::ParallelFor( 0L, static_cast<long>( resolution ), [&]( const long ii )
+    {
+        const size_t i = static_cast<size_t>( ii );
+        for ( size_t j = 0, index = i * resolution; j < resolution; j++, index++ )
+        {
+            // The entry depends on the densities between the two scalars.
+            if ( kvs::Math::Min( i, j ) > hi || kvs::Math::Max( i, j ) < lo ) { continue; }
+
             if ( i == j )
             {
                 table[index] = tau[i];
@@ -171,9 +206,9 @@ void PreIntegrationTable2D::create()
                 table[index] = ( T[i] - T[j] ) / ( sb - sf );
             }
         }
-    }
+    } );
 
-    m_table = table;
+    m_table_tau = tau.clone();
 }
 
 } // end of namespace kvs
@@ -32,6 +32,7 @@ private:
     kvs::ValueArray<kvs::Real64> m_tau; ///< extinction densities
     kvs::ValueArray<kvs::Real64> m_T; ///< integral of the tau
     kvs::ValueArray<kvs::Real32> m_table; ///< 2D pre-integration table
+    kvs::ValueArray<kvs::Real64> m_table_tau; ///< extinction densities used for the current table
 
 public:
 
@@ -14,6 +14,7 @@
 #include <vector>
 #include <kvs/Math>
 #include <kvs/ValueArray>
+#include <kvs/Parallel>
 
 
 namespace
@@ -190,6 +191,42 @@ inline kvs::Vec4 OpacityWeightedColor( const kvs::Vec4& color, const float t )
     return kvs::Vec4( color[0] * a, color[1] * a, color[2] * a, a );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the table entry is affected by the changed scalars.
+ *  @param  i [in] index of the back (or front) scalar
+ *  @param  j [in] index of the front (or back) scalar
+ *  @param  lo [in] lowest index of the changed scalars
+ *  @param  hi [in] highest index of the changed scalars
+ *  @return true if the entry needs to be recomputed
+ *
+ *  The entry depends on the transfer function between the two scalars only,
+ *  and the range is expanded by one for the interpolation in the incremental
+ *  levels.
+ */
+/*===========================================================================*/
+inline bool IsAffected( const size_t i, const size_t j, const size_t lo, const size_t hi )
+{
+    const size_t smin = kvs::Math::Min( i, j );
+    const size_t smax = kvs::Math::Max( i, j );
+    return smin <= hi + 1 && smax + 1 >= lo;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Stores the color to the table.
+ *  @param  c [in] color
+ *  @param  table [out] pointer to the table entry
+ */
+/*===========================================================================*/
+inline void Store( const kvs::Vec4& c, float* table )
+{
+    table[0] = c[0];
+    table[1] = c[1];
+    table[2] = c[2];
+    table[3] = c[3];
+}
+
 }
 
 
@@ -201,7 +238,8 @@ namespace kvs
  *  @brief  Constructs a new PreIntegrationTable3D class.
  */
 /*===========================================================================*/
-PreIntegrationTable3D::PreIntegrationTable3D()
+PreIntegrationTable3D::PreIntegrationTable3D():
+    m_table_size_of_cell( 0.0f )
 {
     this->setScalarResolution( 128 );
     this->setDepthResolution( 128 );
@@ -216,7 +254,8 @@ PreIntegrationTable3D::PreIntegrationTable3D()
 /*===========================================================================*/
 PreIntegrationTable3D::PreIntegrationTable3D( const size_t scalar_resolution, const size_t depth_resolution ):
     m_scalar_resolution( scalar_resolution ),
-    m_depth_resolution( depth_resolution )
+    m_depth_resolution( depth_resolution ),
+    m_table_size_of_cell( 0.0f )
 {
 }
 
@@ -243,18 +282,51 @@ void PreIntegrationTable3D::setTransferFunction(
 /**
  *  @brief  Creates pre-integration table by numerical integration.
  *  @param  max_size_of_cell [in] maximum size of the cell
+ *
+ *  If the table has been created with the same resolutions and cell size,
+ *  only the entries affected by the changed range of the transfer function
+ *  are recomputed.
  */
 /*===========================================================================*/
 void PreIntegrationTable3D::create( const float max_size_of_cell )
 {
-    // Compute pre-integration table.
-    const size_t slice_size = 4 * m_scalar_resolution * m_scalar_resolution;
-    m_table.allocate( slice_size * m_depth_resolution );
-    m_table.fill( 0.0f );
+    const size_t N = m_scalar_resolution;
+    const size_t slice_size = 4 * N * N;
+
+    // Find the range of the scalars changed from the previous creation.
+    size_t lo = 0;
+    size_t hi = N - 1;
+    const bool reusable =
+        m_table.size() == slice_size * m_depth_resolution &&
+        m_table_transfer_function.size() == m_transfer_function.size() &&
+        m_table_size_of_cell == max_size_of_cell;
+    if ( reusable )
+    {
+        lo = N;
+        hi = 0;
+        for ( size_t i = 0; i < 4 * N; i++ )
+        {
+            if ( m_table_transfer_function[i] != m_transfer_function[i] )
+            {
+                lo = kvs::Math::Min( lo, i / 4 );
+                hi = i / 4;
+            }
+        }
+        if ( lo > hi ) { return; }
 
+        // The table array might be shared with the previously returned one.
+        if ( !m_table.unique() ) { m_table = m_table.clone(); }
+    }
+    else
+    {
+        m_table.allocate( slice_size * m_depth_resolution );
+        m_table.fill( 0.0f );
+    }
+
+    // Compute pre-integration table.
     const float dl = max_size_of_cell / float( m_depth_resolution - 1 );
     kvs::Real32* slice0 = m_table.data();
-    this->compute_exact_level( slice0, dl );
+    this->compute_exact_level( slice0, dl, lo, hi );
 
     float l = dl;
     for ( size_t i = 1; i < m_depth_resolution; i++ )
@@ -262,8 +334,11 @@ void PreIntegrationTable3D::create( const float max_size_of_cell )
         l += dl;
         kvs::Real32* slice = slice0 + i * slice_size;
         const kvs::Real32* slicep = slice0 + ( i - 1 ) * slice_size;
-        this->compute_incremental_level( slice, slicep, slice0, l, dl );
+        this->compute_incremental_level( slice, slicep, slice0, l, dl, lo, hi );
     }
+
+    m_table_transfer_function = m_transfer_function.clone();
+    m_table_size_of_cell = max_size_of_cell;
 }
 
 /*===========================================================================*/
@@ -271,53 +346,72 @@ void PreIntegrationTable3D::create( const float max_size_of_cell )
  *  @brief  Computes 2D pre-integration table by numerical integration.
  *  @param  slice0 [in/out] pointer to the head of the first slice
  *  @param  dl [in] thickness of a slice
+ *  @param  lo [in] lowest index of the changed scalars
+ *  @param  hi [in] highest index of the changed scalars
+ *
+ *  The segments between the front and back scalars are always composited
+ *  from the smaller scalar, and the opacity correction depends only on the
+ *  distance between the scalars. Therefore, the supersampled color of each
+ *  segment is composited once for each distance, and the colors of the pairs
+ *  with the distance are obtained by compositing the segment colors (the
+ *  over operator is associative). The distances are processed in parallel.
  */
 /*===========================================================================*/
-void PreIntegrationTable3D::compute_exact_level( float* slice0, const float dl )
+void PreIntegrationTable3D::compute_exact_level( float* slice0, const float dl, const size_t lo, const size_t hi )
 {
-    const size_t N = m_scalar_resolution;
+    const long N = static_cast<long>( m_scalar_resolution );
     const kvs::ValueArray<kvs::Real32>& TF = m_transfer_function;
-    for ( size_t sb = 0, index = 0; sb < N; sb++ )
+
+    const size_t M = 32; // supersampling factor
+    const float dw = 1.0f / static_cast<float>( M - 1 );
+
+    // Diagonal entries (sb == sf).
+    for ( long s = 0; s < N; s++ )
+    {
+        if ( !::IsAffected( s, s, lo, hi ) ) { continue; }
+        const kvs::Vec4 c = ::OpacityWeightedColor( kvs::Vec4( &TF[4*s] ), dl );
+        ::Store( c, slice0 + 4 * ( s * N + s ) );
+    }
+
+    kvs::ParallelFor( 1L, N, [&]( const long d )
     {
-        for ( size_t sf = 0; sf < N; sf++, index++ )
+        std::vector<kvs::Vec4> segments( N );
+
+        // Composite the supersampled colors in each segment [k,k+1].
+        const float t = dw * dl / static_cast<float>( d );
+        for ( long k = 0; k + 1 < N; k++ )
         {
-            kvs::Vec4 c( 0.0f, 0.0f, 0.0f, 0.0f );
+            // Opacity correction.
+            const kvs::Vec4 c0 = ::OpacityWeightedColor( kvs::Vec4( &TF[4*k] ), t );
+            const kvs::Vec4 c1 = ::OpacityWeightedColor( kvs::Vec4( &TF[4*(k+1)] ), t );
 
-            if ( sb == sf )
+            // Acutual composition.
+            kvs::Vec4 c( 0.0f, 0.0f, 0.0f, 0.0f );
+            float w = 0.0f;
+            for ( size_t m = 0; m < M; m++, w += dw )
             {
-                const float t = dl;
-                c = ::OpacityWeightedColor( kvs::Vec4( &TF[4*sb] ), t );
+                const kvs::Vec4 ck = ::Interpolate( c0, c1, w );
+                c = c + ck * ( 1.0f - c[3] );
             }
-            else
+            segments[k] = c;
+        }
+
+        // Composite the segments between smin and smax.
+        for ( long smin = 0; smin + d < N; smin++ )
+        {
+            const long smax = smin + d;
+            if ( !::IsAffected( smin, smax, lo, hi ) ) { continue; }
+
+            kvs::Vec4 c( 0.0f, 0.0f, 0.0f, 0.0f );
+            for ( long k = smin; k < smax; k++ )
             {
-                const size_t smin = kvs::Math::Min( sb, sf );
-                const size_t smax = kvs::Math::Max( sb, sf );
-
-                const size_t M = 32; // supersampling factor
-                const float dw = 1.0f / static_cast<float>( M - 1 );
-                const float t = dw * dl / static_cast<float>( smax - smin );
-                for ( size_t k = smin; k < smax; k++ )
-                {
-                    // Opacity correction.
-                    const kvs::Vec4 c0 = ::OpacityWeightedColor( kvs::Vec4( &TF[4*k] ), t );
-                    const kvs::Vec4 c1 = ::OpacityWeightedColor( kvs::Vec4( &TF[4*(k+1)] ), t );
-
-                    // Acutual composition.
-                    float w = 0.0f;
-                    for ( size_t m = 0; m < M; m++, w += dw )
-                    {
-                        const kvs::Vec4 ck = ::Interpolate( c0, c1, w );
-                        c = c + ck * ( 1.0f - c[3] );
-                    }
-                }
+                c = c + segments[k] * ( 1.0f - c[3] );
             }
 
-            slice0[ 4 * index + 0 ] = c[0];
-            slice0[ 4 * index + 1 ] = c[1];
-            slice0[ 4 * index + 2 ] = c[2];
-            slice0[ 4 * index + 3 ] = c[3];
+            ::Store( c, slice0 + 4 * ( smin * N + smax ) );
+            ::Store( c, slice0 + 4 * ( smax * N + smin ) );
         }
-    }
+    } );
 }
 
 /*===========================================================================*/
@@ -328,6 +422,8 @@ void PreIntegrationTable3D::compute_exact_level( float* slice0, const float dl )
  *  @param  slice0 [in] pointer to the head of the first slice
  *  @param  l [in] thickness between the first and the current slices
  *  @param  dl [in] thickness of a slice
+ *  @param  lo [in] lowest index of the changed scalars
+ *  @param  hi [in] highest index of the changed scalars
  */
 /*===========================================================================*/
 void PreIntegrationTable3D::compute_incremental_level(
@@ -335,18 +431,22 @@ void PreIntegrationTable3D::compute_incremental_level(
     const float* slicep,
     const float* slice0,
     const float l,
-    const float dl )
+    const float dl,
+    const size_t lo,
+    const size_t hi )
 {
-    const size_t N = m_scalar_resolution;
-    for ( size_t i = 0, index = 0; i < N; i++ )
+    const long N = static_cast<long>( m_scalar_resolution );
+    kvs::ParallelFor( 0L, N, [&]( const long i )
     {
-        for ( size_t j = 0; j < N; j++, index++ )
+        for ( long j = 0; j < N; j++ )
         {
+            if ( !::IsAffected( i, j, lo, hi ) ) { continue; }
+
             const float sf = ( 2.0f * j + 1.0f ) / ( 2.0f * N );
             const float sb = ( 2.0f * i + 1.0f ) / ( 2.0f * N );
             const float sp = ( ( l - dl ) * sf + ( dl * sb ) ) / l;
 
-            const size_t k = static_cast<size_t>( sp * N - 0.5f );
+            const long k = static_cast<long>( sp * N - 0.5f );
             const float w = sp * N - ( k + 0.5f );
 
             kvs::Vec4 c; // current color
@@ -369,12 +469,9 @@ void PreIntegrationTable3D::compute_incremental_level(
 
             // Composition.
             c = c + cp * ( 1.0f - c[3] );
-            slice[ 4 * index + 0 ] = c[0];
-            slice[ 4 * index + 1 ] = c[1];
-            slice[ 4 * index + 2 ] = c[2];
-            slice[ 4 * index + 3 ] = c[3];
+            ::Store( c, slice + 4 * ( i * N + j ) );
         }
-    }
+    } );
 }
 
 } // end of namespace kvs
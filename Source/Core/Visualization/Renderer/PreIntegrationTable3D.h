@@ -34,6 +34,8 @@ private:
     kvs::ValueArray<kvs::Real32> m_table; ///< 3D pre-integration table
     size_t m_scalar_resolution; ///< resolution of the scalar axis
     size_t m_depth_resolution; ///< resolution of the depth axis
+    kvs::ValueArray<kvs::Real32> m_table_transfer_function; ///< transfer function used for the current table
+    float m_table_size_of_cell; ///< max. size of the cell used for the current table
 
 public:
 
@@ -53,8 +55,8 @@ public:
 
 private:
 
-    void compute_exact_level( float* slice0, const float dl );
-    void compute_incremental_level( float* slice, const float* slicep, const float* slice0, const float l, const float dl );
+    void compute_exact_level( float* slice0, const float dl, const size_t lo, const size_t hi );
+    void compute_incremental_level( float* slice, const float* slicep, const float* slice0, const float l, const float dl, const size_t lo, const size_t hi );
 };
 
 } // end of namespace kvs
@@ -55,13 +55,15 @@ void ScatterPlotMatrixRenderer::exec( kvs::ObjectBase* object, kvs::Camera* came
                 const size_t y_index = j;
                 // if ( x_index == y_index ) { continue; } // diagonal region
 
-                kvs::NanoVG* engine = BaseClass::painter().device()->renderEngine();
-                engine->beginFrame( screen()->width(), screen()->height(), dpr );
+                if ( BaseClass::isPolylineVisible() )
                 {
+                    kvs::NanoVG* engine = BaseClass::painter().device()->renderEngine();
+                    engine->beginFrame( screen()->width(), screen()->height(), dpr );
                     BaseClass::drawPolyline( rect, table, x_index, y_index );
-                    BaseClass::drawPoint( rect, table, x_index, y_index, false );
+                    engine->endFrame();
                 }
-                engine->endFrame();
+
+                BaseClass::drawPoint( rect, table, x_index, y_index, false );
             }
         }
     }
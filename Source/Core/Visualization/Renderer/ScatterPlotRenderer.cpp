@@ -13,6 +13,70 @@
 #include <kvs/TableObject>
 #include <kvs/IgnoreUnusedVariable>
 #include <kvs/UIColor>
+#include <kvs/Parallel>
+#include <kvs/Math>
+#include <algorithm>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Normalizes the values by the min/max values.
+ *  @param  values [in] values
+ *  @param  min_value [in] min. value
+ *  @param  max_value [in] max. value
+ *  @param  normalized [out] pointer to the normalized values
+ */
+/*===========================================================================*/
+template <typename T>
+void Normalize(
+    const kvs::AnyValueArray& values,
+    const kvs::Real64 min_value,
+    const kvs::Real64 max_value,
+    kvs::Real32* normalized )
+{
+    const T* data = static_cast<const T*>( values.data() );
+    const size_t nvalues = values.size();
+    if ( max_value > min_value )
+    {
+        const kvs::Real64 scale = 1.0 / ( max_value - min_value );
+        kvs::ParallelFor( size_t(0), nvalues, [&]( const size_t i )
+        {
+            normalized[i] = static_cast<kvs::Real32>( ( data[i] - min_value ) * scale );
+        }, 4096 );
+    }
+    else
+    {
+        // Constant values are placed at the middle of the axis.
+        std::fill( normalized, normalized + nvalues, 0.5f );
+    }
+}
+
+void Normalize(
+    const kvs::AnyValueArray& values,
+    const kvs::Real64 min_value,
+    const kvs::Real64 max_value,
+    kvs::Real32* normalized )
+{
+    switch ( values.typeID() )
+    {
+    case kvs::Type::TypeInt8:   ::Normalize<kvs::Int8>( values, min_value, max_value, normalized ); break;
+    case kvs::Type::TypeUInt8:  ::Normalize<kvs::UInt8>( values, min_value, max_value, normalized ); break;
+    case kvs::Type::TypeInt16:  ::Normalize<kvs::Int16>( values, min_value, max_value, normalized ); break;
+    case kvs::Type::TypeUInt16: ::Normalize<kvs::UInt16>( values, min_value, max_value, normalized ); break;
+    case kvs::Type::TypeInt32:  ::Normalize<kvs::Int32>( values, min_value, max_value, normalized ); break;
+    case kvs::Type::TypeUInt32: ::Normalize<kvs::UInt32>( values, min_value, max_value, normalized ); break;
+    case kvs::Type::TypeInt64:  ::Normalize<kvs::Int64>( values, min_value, max_value, normalized ); break;
+    case kvs::Type::TypeUInt64: ::Normalize<kvs::UInt64>( values, min_value, max_value, normalized ); break;
+    case kvs::Type::TypeReal32: ::Normalize<kvs::Real32>( values, min_value, max_value, normalized ); break;
+    case kvs::Type::TypeReal64: ::Normalize<kvs::Real64>( values, min_value, max_value, normalized ); break;
+    default: break;
+    }
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -37,7 +101,11 @@ ScatterPlotRenderer::ScatterPlotRenderer():
     m_polyline_visible( false ),
     m_background_color( kvs::UIColor::Gray5() ),
     m_background_visible( false ),
-    m_color_map( 256 )
+    m_color_map( 256 ),
+    m_object( NULL ),
+    m_modified_stamp( 0 ),
+    m_color_has_values( false ),
+    m_color_opacity( 0.0f )
 {
     m_color_map.create();
 }
@@ -70,13 +138,17 @@ void ScatterPlotRenderer::exec( kvs::ObjectBase* object, kvs::Camera* camera, kv
         // Draw background.
         this->drawBackground( rect, dpr );
 
-        kvs::NanoVG* engine = m_painter.device()->renderEngine();
-        engine->beginFrame( screen()->width(), screen()->height(), dpr );
+        // Draw polyline.
+        if ( m_polyline_visible )
         {
+            kvs::NanoVG* engine = m_painter.device()->renderEngine();
+            engine->beginFrame( screen()->width(), screen()->height(), dpr );
             this->drawPolyline( rect, table, 0, 1 );
-            this->drawPoint( rect, table, 0, 1, has_values );
+            engine->endFrame();
         }
-        engine->endFrame();
+
+        // Draw points.
+        this->drawPoint( rect, table, 0, 1, has_values );
     }
     m_painter.end();
 
@@ -163,6 +235,18 @@ void ScatterPlotRenderer::drawPolyline(
     engine->stroke();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Draws the points.
+ *  @param  rect [in] plot region
+ *  @param  table [in] pointer to the table object
+ *  @param  x_index [in] column index for the x axis
+ *  @param  y_index [in] column index for the y axis
+ *  @param  has_values [in] if true, the points are colored by the third column
+ *
+ *  This method should be called in the painter (not in the NanoVG frame).
+ */
+/*===========================================================================*/
 void ScatterPlotRenderer::drawPoint(
     const kvs::Rectangle& rect,
     kvs::TableObject* table,
@@ -170,70 +254,247 @@ void ScatterPlotRenderer::drawPoint(
     const size_t y_index,
     const bool has_values )
 {
-    const auto& x_values = table->column( x_index );
-    const auto& y_values = table->column( y_index );
-    const auto x_min_value = table->minValue( x_index );
-    const auto x_max_value = table->maxValue( x_index );
-    const auto y_min_value = table->minValue( y_index );
-    const auto y_max_value = table->maxValue( y_index );
+    const size_t nrows = table->numberOfRows();
+    if ( nrows == 0 ) { return; }
 
-    const auto x0 = rect.x0();
-    const auto x1 = rect.x1();
-    const auto y0 = rect.y0();
-    const auto y1 = rect.y1();
-    const auto x_ratio = ( x1 - x0 ) / ( x_max_value - x_min_value );
-    const auto y_ratio = ( y1 - y0 ) / ( y_max_value - y_min_value );
-    const auto nrows = table->numberOfRows();
+    this->updatePointBuffers( table, has_values );
 
-    auto* engine = m_painter.device()->renderEngine();
-    const auto opacity = m_point_opacity;
-    const auto size = m_point_size;
-    if( has_values )
+    kvs::OpenGL::WithPushedAttrib attrib( GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT );
+    kvs::OpenGL::Disable( GL_DEPTH_TEST );
+    kvs::OpenGL::Enable( GL_BLEND );
+    kvs::OpenGL::SetBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+    kvs::OpenGL::Enable( GL_VERTEX_PROGRAM_POINT_SIZE );
+    kvs::OpenGL::Enable( GL_POINT_SPRITE );
+
+    // The points are drawn in the pixel coordinates set by the painter.
+    const float dpr = m_painter.devicePixelRatio();
+    const kvs::Vec4 region( rect.x0() * dpr, rect.y0() * dpr, rect.x1() * dpr, rect.y1() * dpr );
+    const kvs::Vec4 edge_color( m_edge_color.toVec3(), m_edge_opacity );
+
+    kvs::ProgramObject::Binder shader( m_point_shader );
+    m_point_shader.setUniform( "region", region );
+    m_point_shader.setUniform( "radius", m_point_size * dpr );
+    m_point_shader.setUniform( "edge_width", m_edge_width * dpr );
+    m_point_shader.setUniform( "edge_color", edge_color );
+
+    const GLint x_location = m_point_shader.attributeLocation( "x_value" );
+    const GLint y_location = m_point_shader.attributeLocation( "y_value" );
+    const GLint color_location = m_point_shader.attributeLocation( "color" );
+    const GLint flag_location = m_point_shader.attributeLocation( "flag" );
+    kvs::OpenGL::EnableVertexAttribArray( x_location );
+    kvs::OpenGL::EnableVertexAttribArray( y_location );
+    kvs::OpenGL::EnableVertexAttribArray( color_location );
+    kvs::OpenGL::EnableVertexAttribArray( flag_location );
+    {
+        // The values are stored column by column.
+        const size_t column_size = nrows * sizeof( kvs::Real32 );
+        const GLubyte* x_offset = static_cast<const GLubyte*>( NULL ) + column_size * x_index;
+        const GLubyte* y_offset = static_cast<const GLubyte*>( NULL ) + column_size * y_index;
+        kvs::VertexBufferObject::Binder value( m_value_buffer );
+        kvs::OpenGL::VertexAttribPointer( x_location, 1, GL_FLOAT, GL_FALSE, 0, x_offset );
+        kvs::OpenGL::VertexAttribPointer( y_location, 1, GL_FLOAT, GL_FALSE, 0, y_offset );
+    }
+    {
+        kvs::VertexBufferObject::Binder color( m_color_buffer );
+        kvs::OpenGL::VertexAttribPointer( color_location, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, NULL );
+    }
+    {
+        kvs::VertexBufferObject::Binder flag( m_flag_buffer );
+        kvs::OpenGL::VertexAttribPointer( flag_location, 1, GL_UNSIGNED_BYTE, GL_FALSE, 0, NULL );
+    }
+    kvs::OpenGL::DrawArrays( GL_POINTS, 0, static_cast<GLsizei>( nrows ) );
+    kvs::OpenGL::DisableVertexAttribArray( flag_location );
+    kvs::OpenGL::DisableVertexAttribArray( color_location );
+    kvs::OpenGL::DisableVertexAttribArray( y_location );
+    kvs::OpenGL::DisableVertexAttribArray( x_location );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Updates the buffers for the points which have been changed.
+ *  @param  table [in] pointer to the table object
+ *  @param  has_values [in] if true, the points are colored by the third column
+ */
+/*===========================================================================*/
+void ScatterPlotRenderer::updatePointBuffers( const kvs::TableObject* table, const bool has_values )
+{
+    if ( !m_point_shader.isCreated() ) { this->createPointShader(); }
+
+    const bool table_changed =
+        m_object != table ||
+        m_modified_stamp != table->modifiedStamp() ||
+        m_min_values != table->minValues() ||
+        m_max_values != table->maxValues();
+    if ( table_changed ) { this->createValueBuffer( table ); }
+
+    const bool color_changed =
+        table_changed ||
+        m_color_has_values != has_values ||
+        m_color_opacity != m_point_opacity ||
+        ( has_values && !( m_color_table == m_color_map.table() ) ) ||
+        ( !has_values && !( m_color_point_color == m_point_color ) );
+    if ( color_changed ) { this->createColorBuffer( table, has_values ); }
+
+    const bool flag_changed =
+        table_changed ||
+        m_inside_range_flags != table->insideRangeFlags();
+    if ( flag_changed ) { this->createFlagBuffer( table ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the vertex buffer for the normalized values.
+ *  @param  table [in] pointer to the table object
+ */
+/*===========================================================================*/
+void ScatterPlotRenderer::createValueBuffer( const kvs::TableObject* table )
+{
+    const size_t ncolumns = table->numberOfColumns();
+    const size_t nrows = table->numberOfRows();
+
+    kvs::ValueArray<kvs::Real32> values( nrows * ncolumns );
+    for ( size_t j = 0; j < ncolumns; j++ )
+    {
+        ::Normalize( table->column(j), table->minValue(j), table->maxValue(j), values.data() + nrows * j );
+    }
+
+    m_value_buffer.release();
+    m_value_buffer.create( values.byteSize(), values.data() );
+
+    m_object = table;
+    m_modified_stamp = table->modifiedStamp();
+    m_min_values = table->minValues();
+    m_max_values = table->maxValues();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the vertex buffer for the point colors.
+ *  @param  table [in] pointer to the table object
+ *  @param  has_values [in] if true, the points are colored by the third column
+ */
+/*===========================================================================*/
+void ScatterPlotRenderer::createColorBuffer( const kvs::TableObject* table, const bool has_values )
+{
+    const size_t nrows = table->numberOfRows();
+    const kvs::UInt8 opacity = static_cast<kvs::UInt8>( kvs::Math::Clamp( m_point_opacity, 0.0f, 1.0f ) * 255.0f + 0.5f );
+
+    kvs::ValueArray<kvs::UInt8> colors( nrows * 4 );
+    if ( has_values )
     {
         const auto color_axis_min_value = static_cast<float>( table->minValue(2) );
         const auto color_axis_max_value = static_cast<float>( table->maxValue(2) );
         const auto& color_axis_values = table->column(2);
         m_color_map.setRange( color_axis_min_value, color_axis_max_value );
 
-        engine->setStrokeWidth( m_edge_width );
-        engine->setStrokeColor( kvs::RGBAColor( m_edge_color, m_edge_opacity ) );
-        for ( size_t i = 0; i < nrows; i++ )
+        kvs::ParallelFor( size_t(0), nrows, [&]( const size_t i )
         {
-            if ( !table->insideRange( i ) ) continue;
-
             const auto color_value = color_axis_values[i].to<kvs::Real64>();
-            const auto color = m_color_map.at( static_cast<float>( color_value) );
-            engine->setFillColor( kvs::RGBAColor( color, opacity ) );
-
-            const auto x_value = x_values[i].to<kvs::Real64>();
-            const auto y_value = y_values[i].to<kvs::Real64>();
-            const auto x = x0 + ( x_value - x_min_value ) * x_ratio;
-            const auto y = y1 - ( y_value - y_min_value ) * y_ratio;
-            engine->beginPath();
-            engine->circle( x, y, size );
-            engine->fill();
-            engine->stroke();
-        }
+            const auto color = m_color_map.at( static_cast<float>( color_value ) );
+            kvs::UInt8* c = colors.data() + i * 4;
+            c[0] = color.r(); c[1] = color.g(); c[2] = color.b(); c[3] = opacity;
+        }, 1024 );
     }
     else
     {
         const auto color = m_point_color;
-        engine->setFillColor( kvs::RGBAColor( color, opacity ) );
-        engine->setStrokeWidth( m_edge_width );
-        engine->setStrokeColor( kvs::RGBAColor( m_edge_color, m_edge_opacity ) );
         for ( size_t i = 0; i < nrows; i++ )
         {
-            if ( !table->insideRange( i ) ) continue;
-            const auto x_value = x_values[i].to<kvs::Real64>();
-            const auto y_value = y_values[i].to<kvs::Real64>();
-            const auto x = x0 + ( x_value - x_min_value ) * x_ratio;
-            const auto y = y1 - ( y_value - y_min_value ) * y_ratio;
-            engine->beginPath();
-            engine->circle( x, y, size );
-            engine->fill();
-            engine->stroke();
+            kvs::UInt8* c = colors.data() + i * 4;
+            c[0] = color.r(); c[1] = color.g(); c[2] = color.b(); c[3] = opacity;
         }
     }
+
+    m_color_buffer.release();
+    m_color_buffer.create( colors.byteSize(), colors.data() );
+
+    m_color_has_values = has_values;
+    m_color_point_color = m_point_color;
+    m_color_opacity = m_point_opacity;
+    m_color_table = m_color_map.table().clone();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the vertex buffer for the range flags.
+ *  @param  table [in] pointer to the table object
+ */
+/*===========================================================================*/
+void ScatterPlotRenderer::createFlagBuffer( const kvs::TableObject* table )
+{
+    const std::vector<kvs::UInt8>& flags = table->insideRangeFlags();
+    const size_t nrows = table->numberOfRows();
+    const size_t size = nrows * sizeof( kvs::UInt8 );
+
+    // Only the flags are updated for the changes of the ranges.
+    if ( m_flag_buffer.isCreated() && m_inside_range_flags.size() == nrows )
+    {
+        kvs::VertexBufferObject::Binder flag( m_flag_buffer );
+        m_flag_buffer.load( size, flags.data() );
+    }
+    else
+    {
+        m_flag_buffer.release();
+        m_flag_buffer.create( size, flags.data() );
+    }
+
+    m_inside_range_flags = flags;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the shader program for the points.
+ *
+ *  Each point is drawn as a point sprite with the filled circle and the edge,
+ *  which have the same appearance as the circle drawn by NanoVG. The points
+ *  outside the ranges are moved to the outside of the view volume.
+ */
+/*===========================================================================*/
+void ScatterPlotRenderer::createPointShader()
+{
+    const std::string vert(
+        "#version 120\n"
+        "uniform vec4 region;"
+        "uniform float radius;"
+        "uniform float edge_width;"
+        "attribute float x_value;"
+        "attribute float y_value;"
+        "attribute vec4 color;"
+        "attribute float flag;"
+        "varying vec4 point_color;"
+        "varying float point_size;"
+        "void main()"
+        "{"
+        "    float x = mix( region.x, region.z, x_value );"
+        "    float y = mix( region.w, region.y, y_value );"
+        "    point_color = color;"
+        "    point_size = 2.0 * ( radius + edge_width * 0.5 ) + 2.0;"
+        "    gl_PointSize = point_size;"
+        "    if ( flag < 0.5 ) { gl_Position = vec4( 2.0, 2.0, 2.0, 1.0 ); }"
+        "    else { gl_Position = gl_ModelViewProjectionMatrix * vec4( x, y, 0.0, 1.0 ); }"
+        "}"
+        );
+
+    const std::string frag(
+        "#version 120\n"
+        "uniform float radius;"
+        "uniform float edge_width;"
+        "uniform vec4 edge_color;"
+        "varying vec4 point_color;"
+        "varying float point_size;"
+        "void main()"
+        "{"
+        "    float d = length( gl_PointCoord - vec2( 0.5 ) ) * point_size;"
+        "    float fill = clamp( radius + 0.5 - d, 0.0, 1.0 ) * point_color.a;"
+        "    float edge = clamp( edge_width * 0.5 + 0.5 - abs( d - radius ), 0.0, 1.0 ) * edge_color.a;"
+        "    float alpha = edge + fill * ( 1.0 - edge );"
+        "    if ( alpha <= 0.0 ) { discard; }"
+        "    vec3 rgb = ( edge_color.rgb * edge + point_color.rgb * fill * ( 1.0 - edge ) ) / alpha;"
+        "    gl_FragColor = vec4( rgb, alpha );"
+        "}"
+        );
+
+    m_point_shader.build( vert, frag );
 }
 
 } // end of namespace kvs
@@ -5,6 +5,7 @@
  */
 /*****************************************************************************/
 #pragma once
+#include <vector>
 #include <kvs/RendererBase>
 #include <kvs/Module>
 #include <kvs/RGBColor>
@@ -13,6 +14,9 @@
 #include <kvs/Painter>
 #include <kvs/Margins>
 #include <kvs/Deprecated>
+#include <kvs/ValueArray>
+#include <kvs/VertexBufferObject>
+#include <kvs/ProgramObject>
 
 
 namespace kvs
@@ -26,6 +30,14 @@ class TableObject;
 /*===========================================================================*/
 /**
  *  @brief  Scatter plot renderer class.
+ *
+ *  The points are drawn as the point sprites from the vertex buffers of the
+ *  values normalized by the min/max values of the columns, so that all the
+ *  points are drawn by a single draw call. The values are rebuilt only when
+ *  the table or its modification stamp (see kvs::TableObject::setModified)
+ *  are changed, the colors only when the color settings are changed, and the
+ *  ranges of the columns (brushing) update only the buffer of the range
+ *  flags.
  */
 /*===========================================================================*/
 class ScatterPlotRenderer : public kvs::RendererBase
@@ -66,6 +78,21 @@ private:
     kvs::ColorMap m_color_map; ///< color map
     kvs::Painter m_painter; ///< painter
 
+    // Buffers for the points
+    const kvs::ObjectBase* m_object; ///< pointer to the buffered object (not allocated)
+    size_t m_modified_stamp; ///< modification stamp of the buffered object
+    std::vector<kvs::Real64> m_min_values; ///< min. values of the buffered values
+    std::vector<kvs::Real64> m_max_values; ///< max. values of the buffered values
+    std::vector<kvs::UInt8> m_inside_range_flags; ///< buffered range flags
+    bool m_color_has_values; ///< true if the buffered colors are mapped from the values
+    kvs::RGBColor m_color_point_color; ///< point color of the buffered colors
+    kvs::Real32 m_color_opacity; ///< opacity of the buffered colors
+    kvs::ValueArray<kvs::UInt8> m_color_table; ///< color map table of the buffered colors
+    kvs::VertexBufferObject m_value_buffer; ///< VBO for the normalized values
+    kvs::VertexBufferObject m_color_buffer; ///< VBO for the point colors
+    kvs::VertexBufferObject m_flag_buffer; ///< VBO for the range flags
+    kvs::ProgramObject m_point_shader; ///< shader program for the points
+
 public:
     ScatterPlotRenderer();
 
@@ -107,6 +134,13 @@ protected:
     void drawPolyline( const kvs::Rectangle& rect, kvs::TableObject* table, const size_t x_index, const size_t y_index );
     void drawPoint( const kvs::Rectangle& rect, kvs::TableObject* table, const size_t x_index, const size_t y_index, const bool has_values );
 
+private:
+    void updatePointBuffers( const kvs::TableObject* table, const bool has_values );
+    void createValueBuffer( const kvs::TableObject* table );
+    void createColorBuffer( const kvs::TableObject* table, const bool has_values );
+    void createFlagBuffer( const kvs::TableObject* table );
+    void createPointShader();
+
 public:
     KVS_DEPRECATED( void setTopMargin( const int margin ) ) { m_margins.setTop( margin ); }
     KVS_DEPRECATED( void setBottomMargin( const int margin ) ) { m_margins.setBottom( margin ); }
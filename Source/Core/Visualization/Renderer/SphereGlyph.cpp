@@ -7,6 +7,7 @@
 #include "SphereGlyph.h"
 #include <kvs/OpenGL>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Math>
 
 
 namespace kvs
@@ -115,6 +116,8 @@ void SphereGlyph::exec( kvs::ObjectBase* object, kvs::Camera* camera, kvs::Light
 /*===========================================================================*/
 void SphereGlyph::draw()
 {
+    if ( BaseClass::isEnabledInstancing() ) { this->draw_instances(); return; }
+
     const size_t npoints = BaseClass::coords().size() / 3;
     if ( BaseClass::directions().size() == 0 )
     {
@@ -297,6 +300,68 @@ void SphereGlyph::draw_element( const kvs::RGBColor& color, const kvs::UInt8 opa
     kvs::OpenGL::DrawSphere( radius, slices, stacks );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Draw the sphere glyphs with instanced rendering.
+ */
+/*===========================================================================*/
+void SphereGlyph::draw_instances()
+{
+    if ( !BaseClass::hasGlyphMesh() ) { this->create_mesh(); }
+    BaseClass::drawInstances();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates the sphere mesh (radius 0.5) for instanced rendering.
+ */
+/*===========================================================================*/
+void SphereGlyph::create_mesh()
+{
+    const size_t nslices = kvs::Math::Max( m_nslices, size_t( 3 ) );
+    const size_t nstacks = kvs::Math::Max( m_nstacks, size_t( 2 ) );
+    const float radius = 0.5f;
+
+    const size_t nvertices = ( nslices + 1 ) * ( nstacks + 1 );
+    kvs::ValueArray<kvs::Real32> vertices( nvertices * 3 );
+    kvs::ValueArray<kvs::Real32> normals( nvertices * 3 );
+    for ( size_t j = 0, index = 0; j <= nstacks; j++ )
+    {
+        const float phi = kvs::Math::PI() * static_cast<float>( j ) / static_cast<float>( nstacks );
+        for ( size_t i = 0; i <= nslices; i++, index += 3 )
+        {
+            const float theta = 2.0f * kvs::Math::PI() * static_cast<float>( i ) / static_cast<float>( nslices );
+            const kvs::Vec3 n( std::sin( phi ) * std::sin( theta ), std::cos( phi ), std::sin( phi ) * std::cos( theta ) );
+            vertices[ index + 0 ] = radius * n.x();
+            vertices[ index + 1 ] = radius * n.y();
+            vertices[ index + 2 ] = radius * n.z();
+            normals[ index + 0 ] = n.x();
+            normals[ index + 1 ] = n.y();
+            normals[ index + 2 ] = n.z();
+        }
+    }
+
+    kvs::ValueArray<kvs::UInt32> connections( nslices * nstacks * 6 );
+    for ( size_t j = 0, index = 0; j < nstacks; j++ )
+    {
+        for ( size_t i = 0; i < nslices; i++, index += 6 )
+        {
+            const kvs::UInt32 v0 = static_cast<kvs::UInt32>( j * ( nslices + 1 ) + i );
+            const kvs::UInt32 v1 = v0 + 1;
+            const kvs::UInt32 v2 = v0 + static_cast<kvs::UInt32>( nslices + 1 );
+            const kvs::UInt32 v3 = v2 + 1;
+            connections[ index + 0 ] = v0;
+            connections[ index + 1 ] = v2;
+            connections[ index + 2 ] = v1;
+            connections[ index + 3 ] = v1;
+            connections[ index + 4 ] = v2;
+            connections[ index + 5 ] = v3;
+        }
+    }
+
+    BaseClass::setGlyphMesh( GL_TRIANGLES, vertices, normals, connections );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Initialize the modelview matrix.
@@ -49,8 +49,8 @@ public:
     SphereGlyph( const kvs::VolumeObjectBase* volume );
     SphereGlyph( const kvs::VolumeObjectBase* volume, const kvs::TransferFunction& transfer_function );
 
-    void setNumberOfSlices( const size_t nslices ) { m_nslices = nslices; }
-    void setNumberOfStacks( const size_t nstacks ) { m_nstacks = nstacks; }
+    void setNumberOfSlices( const size_t nslices ) { m_nslices = nslices; BaseClass::clearGlyphMesh(); }
+    void setNumberOfStacks( const size_t nstacks ) { m_nstacks = nstacks; BaseClass::clearGlyphMesh(); }
 
     void exec( kvs::ObjectBase* object, kvs::Camera* camera, kvs::Light* light );
 
@@ -60,6 +60,8 @@ private:
     void attach_volume( const kvs::VolumeObjectBase* volume );
     void draw();
     void draw_element( const kvs::RGBColor& color, const kvs::UInt8 opacity );
+    void draw_instances();
+    void create_mesh();
     void initialize();
 
 public:
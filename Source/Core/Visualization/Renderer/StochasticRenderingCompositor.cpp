@@ -37,7 +37,9 @@ StochasticRenderingCompositor::StochasticRenderingCompositor( kvs::Scene* scene
     m_repetition_level( 1 ),
     m_coarse_level( 1 ),
     m_enable_lod( false ),
-    m_enable_refinement( false )
+    m_enable_refinement( false ),
+    m_enable_progressive_refinement( false ),
+    m_target_frame_time( 30.0f )
 {
 }
 
@@ -102,18 +104,41 @@ void StochasticRenderingCompositor::draw()
         m_ensemble_buffer.clear();
     }
 
-    // Setup engine.
-    this->engines_setup();
+    if ( m_enable_progressive_refinement )
+    {
+        // Progressive refinement within the target frame time. The engines
+        // restart the repetitions when the ensemble buffer has been cleared.
+        const size_t count = m_ensemble_buffer.count();
+        if ( count < m_repetition_level )
+        {
+            this->engines_setup();
 
-    // Ensemble rendering.
-    const bool reset_count = !m_enable_refinement;
-    if ( reset_count ) m_ensemble_buffer.clear();
-    for ( size_t i = 0; i < repetitions; i++ )
+            const size_t remains = m_repetition_level - count;
+            for ( size_t i = 0; i < remains; i++ )
+            {
+                this->ensemble_draw();
+
+                // Estimate whether the next repetition fits in the frame time.
+                kvs::OpenGL::Finish();
+                m_timer.stop();
+                const double elapsed_time = m_timer.msec();
+                const double repetition_time = elapsed_time / ( i + 1 );
+                if ( elapsed_time + repetition_time > m_target_frame_time ) { break; }
+            }
+        }
+    }
+    else
     {
-        m_ensemble_buffer.bind();
-        this->engines_draw();
-        m_ensemble_buffer.unbind();
-        m_ensemble_buffer.add();
+        // Setup engine.
+        this->engines_setup();
+
+        // Ensemble rendering.
+        const bool reset_count = !m_enable_refinement;
+        if ( reset_count ) m_ensemble_buffer.clear();
+        for ( size_t i = 0; i < repetitions; i++ )
+        {
+            this->ensemble_draw();
+        }
     }
 
     m_ensemble_buffer.draw();
@@ -122,6 +147,22 @@ void StochasticRenderingCompositor::draw()
     m_timer.stop();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Redraws the screen until the progressive refinement converges.
+ *  @param  e [in] time event
+ */
+/*===========================================================================*/
+void StochasticRenderingCompositor::timerEvent( kvs::TimeEvent* e )
+{
+    kvs::TrackballInteractor::timerEvent( e );
+
+    if ( m_enable_progressive_refinement && !this->isConverged() )
+    {
+        this->screen()->redraw();
+    }
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Check whether the window is created and initialize the parameters.
@@ -295,7 +336,8 @@ void StochasticRenderingCompositor::engines_setup()
 
     kvs::Camera* camera = m_scene->camera();
     kvs::Light* light = m_scene->light();
-    const bool reset_count = !m_enable_refinement;
+    const bool reset_count = m_enable_progressive_refinement ?
+        m_ensemble_buffer.count() == 0 : !m_enable_refinement;
 
     const size_t size = m_scene->IDManager()->size();
     for ( size_t i = 0; i < size; i++ )
@@ -346,4 +388,17 @@ void StochasticRenderingCompositor::engines_draw()
     }
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Renders a repetition and adds it to the ensemble buffer.
+ */
+/*===========================================================================*/
+void StochasticRenderingCompositor::ensemble_draw()
+{
+    m_ensemble_buffer.bind();
+    this->engines_draw();
+    m_ensemble_buffer.unbind();
+    m_ensemble_buffer.add();
+}
+
 } // end of namespace kvs
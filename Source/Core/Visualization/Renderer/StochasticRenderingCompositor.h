@@ -21,6 +21,13 @@ class Scene;
 /*===========================================================================*/
 /**
  *  @brief  Stochastic rendering compositor class.
+ *
+ *  In the progressive refinement mode, each paint renders the repetitions as
+ *  many as fit in the target frame time and accumulates them into the
+ *  ensemble buffer until the number of the accumulated repetitions reaches
+ *  the repetition level. The accumulation is restarted when the camera, the
+ *  light, the object xform, the window or the object is changed. While the
+ *  image has not converged, the screen is redrawn by the timer event.
  */
 /*===========================================================================*/
 class StochasticRenderingCompositor : public kvs::TrackballInteractor
@@ -34,6 +41,8 @@ private:
     size_t m_coarse_level; ///< repetition level for the coarse rendering (LOD)
     bool m_enable_lod; ///< flag for LOD rendering
     bool m_enable_refinement; ///< flag for progressive refinement rendering
+    bool m_enable_progressive_refinement; ///< flag for time-budgeted progressive refinement
+    float m_target_frame_time; ///< target frame time in msec for the progressive refinement
     kvs::Mat4 m_object_xform; ///< object xform matrix used for LOD control
     kvs::Vec3 m_light_position; ///< light position used for LOD control
     kvs::Vec3 m_camera_position; ///< camera position used for LOD control
@@ -45,13 +54,21 @@ public:
     size_t repetitionLevel() const { return m_repetition_level; }
     bool isEnabledLODControl() const { return m_enable_lod; }
     bool isEnabledRefinement() const { return m_enable_refinement; }
+    bool isEnabledProgressiveRefinement() const { return m_enable_progressive_refinement; }
+    float targetFrameTime() const { return m_target_frame_time; }
+    size_t repetitionCount() const { return m_ensemble_buffer.count(); }
+    bool isConverged() const { return m_ensemble_buffer.count() >= m_repetition_level; }
     void setRepetitionLevel( const size_t repetition_level ) { m_repetition_level = repetition_level; }
     void setEnabledLODControl( const bool enable ) { m_enable_lod = enable; }
     void setEnabledRefinement( const bool enable ) { m_enable_refinement = enable; }
+    void setEnabledProgressiveRefinement( const bool enable ) { m_enable_progressive_refinement = enable; }
+    void setTargetFrameTime( const float msec ) { m_target_frame_time = msec; }
     void enableLODControl() { this->setEnabledLODControl( true ); }
     void enableRefinement() { this->setEnabledRefinement( true ); }
+    void enableProgressiveRefinement() { this->setEnabledProgressiveRefinement( true ); }
     void disableLODControl() { this->setEnabledLODControl( false ); }
     void disableRefinement() { this->setEnabledRefinement( false ); }
+    void disableProgressiveRefinement() { this->setEnabledProgressiveRefinement( false ); }
     void update();
 
 private:
@@ -65,9 +82,11 @@ private:
     void engines_update();
     void engines_setup();
     void engines_draw();
+    void ensemble_draw();
 
 private:
     void paintEvent() { this->update(); }
+    void timerEvent( kvs::TimeEvent* e );
 
 public:
     KVS_DEPRECATED( bool isEnabledShading() const ) { return false; /* do not use */ }
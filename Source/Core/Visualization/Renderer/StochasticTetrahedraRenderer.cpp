@@ -465,9 +465,10 @@ void StochasticTetrahedraRenderer::Engine::create_buffer_object( const kvs::Unst
 /*===========================================================================*/
 void StochasticTetrahedraRenderer::Engine::create_preintegration_texture()
 {
+    // NOTE: Only the T values and the inverse of them are used for the textures,
+    // so that the 2D pre-integration table is not created here.
     kvs::PreIntegrationTable2D table;
     table.setTransferFunction( m_transfer_function );
-    table.create();
 
     int resolution_inverse_texture_size = kvs::Math::Min( 16384, kvs::OpenGL::MaxTextureSize() );
     m_shader_program.bind();
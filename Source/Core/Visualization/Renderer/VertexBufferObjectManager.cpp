@@ -117,6 +117,17 @@ void VertexBufferObjectManager::setVertexAttribArray( const kvs::AnyValueArray&
     }
 }
 
+void VertexBufferObjectManager::setVertexAttribDivisor( const size_t index, const size_t divisor )
+{
+    for ( size_t i = 0; i < m_vertex_attrib_arrays.size(); i++ )
+    {
+        if ( m_vertex_attrib_arrays[i].index == index )
+        {
+            m_vertex_attrib_arrays[i].divisor = static_cast<GLuint>( divisor );
+        }
+    }
+}
+
 void VertexBufferObjectManager::create()
 {
     const size_t vbo_size = this->vertex_buffer_object_size();
@@ -233,6 +244,17 @@ void VertexBufferObjectManager::drawElements( GLenum mode, const kvs::ValueArray
     kvs::OpenGL::MultiDrawElements( mode, count, m_index_array.type, 0 );
 }
 
+void VertexBufferObjectManager::drawArraysInstanced( GLenum mode, GLint first, GLsizei count, GLsizei ninstances )
+{
+    kvs::OpenGL::DrawArraysInstanced( mode, first, count, ninstances );
+}
+
+void VertexBufferObjectManager::drawElementsInstanced( GLenum mode, GLsizei count, GLsizei ninstances )
+{
+    kvs::IndexBufferObject::Binder bind( m_ibo );
+    kvs::OpenGL::DrawElementsInstanced( mode, count, m_index_array.type, 0, ninstances );
+}
+
 size_t VertexBufferObjectManager::vertex_buffer_object_size() const
 {
     size_t vbo_size = 0;
@@ -295,6 +317,7 @@ void VertexBufferObjectManager::enable_client_state() const
                 array.normalized,
                 array.stride,
                 offset );
+            if ( array.divisor > 0 ) { kvs::OpenGL::VertexAttribDivisor( array.index, array.divisor ); }
         }
     }
 }
@@ -326,6 +349,7 @@ void VertexBufferObjectManager::disable_client_state() const
         const VertexAttribBuffer& array = m_vertex_attrib_arrays[i];
         if ( array.size > 0 )
         {
+            if ( array.divisor > 0 ) { kvs::OpenGL::VertexAttribDivisor( array.index, 0 ); }
             kvs::OpenGL::DisableVertexAttribArray( array.index );
         }
     }
@@ -39,10 +39,12 @@ public:
     {
         GLuint index; ///< index of vertex attribute to be modified
         GLboolean normalized; ///< data values should be normalized (GL_TRUE) or not (GL_FALSE)
+        GLuint divisor; ///< number of instances per attribute (0: per-vertex attribute)
         VertexAttribBuffer():
             VertexBuffer(),
             index(0),
-            normalized(GL_FALSE) {}
+            normalized(GL_FALSE),
+            divisor(0) {}
         friend bool operator == ( const VertexAttribBuffer& left, const VertexAttribBuffer& right )
         {
             return left.index == right.index;
@@ -105,6 +107,7 @@ public:
     void setTexCoordArray( const kvs::AnyValueArray& array, const size_t dim, const size_t stride = 0 );
     void setIndexArray( const kvs::AnyValueArray& array );
     void setVertexAttribArray( const kvs::AnyValueArray& array, const size_t index, const size_t dim, const bool normalized = false, const size_t stride = 0 );
+    void setVertexAttribDivisor( const size_t index, const size_t divisor );
 
     void create();
     void bind() const;
@@ -117,6 +120,8 @@ public:
     void drawElements( GLenum mode, GLsizei count );
     void drawElements( GLenum mode, const GLsizei* count, GLsizei drawcount );
     void drawElements( GLenum mode, const kvs::ValueArray<GLsizei>& count );
+    void drawArraysInstanced( GLenum mode, GLint first, GLsizei count, GLsizei ninstances );
+    void drawElementsInstanced( GLenum mode, GLsizei count, GLsizei ninstances );
 
 private:
     size_t vertex_buffer_object_size() const;
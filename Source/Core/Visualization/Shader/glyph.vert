@@ -0,0 +1,81 @@
+/*****************************************************************************/
+/**
+ *  @file   glyph.vert
+ */
+/*****************************************************************************/
+#version 120
+#include "qualifire.h"
+
+// Input parameters (per-instance attributes).
+VertIn vec3 glyph_position; // glyph position
+VertIn vec3 glyph_direction; // glyph direction (ENABLE_DIRECTION)
+VertIn float glyph_size; // glyph size
+VertIn vec3 glyph_color; // glyph color
+VertIn float glyph_opacity; // glyph opacity
+
+// Output parameters to fragment shader.
+VertOut vec3 position;
+VertOut vec3 normal;
+
+// Uniform variables (OpenGL variables).
+uniform mat4 ModelViewMatrix; // model-view matrix
+uniform mat4 ModelViewProjectionMatrix; // model-view projection matrix
+uniform mat3 NormalMatrix; // normal matrix
+
+// Uniform variables.
+uniform vec3 glyph_scale; // scaling vector
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the rotation matrix from the default direction (y-axis).
+ *  @param  d [in] normalized direction
+ *  @return rotation matrix
+ */
+/*===========================================================================*/
+mat3 Rotation( in vec3 d )
+{
+    // Rotation of 180 degrees for the opposite direction.
+    float c = d.y;
+    if ( c < -0.999999 ) { return mat3( 1.0, 0.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0, -1.0 ); }
+
+    vec3 v = vec3( d.z, 0.0, -d.x ); // cross( vec3( 0, 1, 0 ), d )
+    float k = 1.0 / ( 1.0 + c );
+    return mat3(
+        v.x * v.x * k + c,   v.y * v.x * k + v.z, v.z * v.x * k - v.y,
+        v.x * v.y * k - v.z, v.y * v.y * k + c,   v.z * v.y * k + v.x,
+        v.x * v.z * k + v.y, v.y * v.z * k - v.x, v.z * v.z * k + c );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function of vertex shader.
+ */
+/*===========================================================================*/
+void main()
+{
+    vec3 scale = glyph_scale * glyph_size;
+    vec3 v = gl_Vertex.xyz * scale;
+    vec3 n = gl_Normal * ( scale.yzx * scale.zxy ); // inverse-transpose up to a factor
+
+#if defined( ENABLE_DIRECTION )
+    float len = length( glyph_direction );
+    if ( len > 0.0 )
+    {
+        mat3 R = Rotation( glyph_direction / len );
+        v = R * v;
+        n = R * n;
+    }
+#if defined( ENABLE_ZERO_DIRECTION_CULLING )
+    // The glyph with zero direction is moved out of the clipping volume.
+    else { gl_Position = vec4( 0.0, 0.0, 2.0, 1.0 ); return; }
+#endif
+#endif
+
+    vec4 p = vec4( glyph_position + v, 1.0 );
+    gl_Position = ModelViewProjectionMatrix * p;
+    gl_FrontColor = vec4( glyph_color, glyph_opacity );
+
+    position = ( ModelViewMatrix * p ).xyz;
+    normal = NormalMatrix * n;
+}
@@ -0,0 +1,430 @@
+/*****************************************************************************/
+/**
+ *  @file   FrameCapture.cpp
+ */
+/*****************************************************************************/
+#include "FrameCapture.h"
+#include <cstdio>
+#include <cstring>
+#include <kvs/OpenGL>
+#include <kvs/Thread>
+#include <kvs/MutexLocker>
+#include <kvs/Math>
+#include <kvs/Message>
+#include <kvs/Trace>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Encoder thread which processes the queued frames.
+ */
+/*===========================================================================*/
+class FrameCapture::Encoder : public kvs::Thread
+{
+private:
+    kvs::FrameCapture* m_capture; ///< pointer to the frame capture
+
+public:
+    Encoder( kvs::FrameCapture* capture ): m_capture( capture ) {}
+    void run() { while ( m_capture->encode() ) {} }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new FrameCapture class.
+ */
+/*===========================================================================*/
+FrameCapture::FrameCapture():
+    m_nbuffers( 2 ),
+    m_nencoders( 2 ),
+    m_max_queue_size( 8 ),
+    m_enable_frame_dropping( true ),
+    m_read_buffer( GL_FRONT ),
+    m_basename( "frame" ),
+    m_extension( "png" ),
+    m_capture_func( nullptr ),
+    m_current( 0 ),
+    m_nframes( 0 ),
+    m_nqueued( 0 ),
+    m_ndelivered( 0 ),
+    m_ndropped( 0 ),
+    m_quit( false )
+{
+    for ( size_t i = 0; i < MaxNumberOfBuffers; i++ )
+    {
+        m_slots[i].pending = false;
+        m_slots[i].width = 0;
+        m_slots[i].height = 0;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new FrameCapture class.
+ *  @param  func [in] capture function
+ */
+/*===========================================================================*/
+FrameCapture::FrameCapture( CaptureFunc func ):
+    FrameCapture()
+{
+    m_capture_func = func;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the FrameCapture class.
+ *
+ *  The queued frames are finished before the encoder threads are terminated.
+ *  The frames remaining in the pixel pack buffers are discarded unless
+ *  flush() is called beforehand.
+ */
+/*===========================================================================*/
+FrameCapture::~FrameCapture()
+{
+    this->stop_encoders();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the number of the pixel pack buffers.
+ *  @param  nbuffers [in] number of buffers (1: synchronous, 2: double, 3: triple)
+ *
+ *  The number of buffers should be set before the first capture. Otherwise,
+ *  the frames pending in the buffers are retrieved before the change, so that
+ *  this method must be called in the thread with the current OpenGL context.
+ */
+/*===========================================================================*/
+void FrameCapture::setNumberOfBuffers( const size_t nbuffers )
+{
+    const size_t n = kvs::Math::Clamp( nbuffers, size_t( 1 ), size_t( MaxNumberOfBuffers ) );
+    if ( n == m_nbuffers ) { return; }
+
+    this->retrieve_pending();
+    m_nbuffers = n;
+    m_current = 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the number of the encoder threads.
+ *  @param  nencoders [in] number of threads
+ */
+/*===========================================================================*/
+void FrameCapture::setNumberOfEncoders( const size_t nencoders )
+{
+    const size_t n = kvs::Math::Max( nencoders, size_t( 1 ) );
+    if ( n == m_nencoders ) { return; }
+
+    // The encoder threads are restarted at the next queuing.
+    this->stop_encoders();
+    m_nencoders = n;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the frames which are queued and not finished.
+ *  @return queue depth
+ */
+/*===========================================================================*/
+size_t FrameCapture::queueDepth() const
+{
+    kvs::MutexLocker locker( &m_mutex );
+    return m_nqueued - m_ndelivered;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the dropped frames.
+ *  @return number of the frames dropped since the queue was full or the pixels could not be read back
+ */
+/*===========================================================================*/
+size_t FrameCapture::numberOfDroppedFrames() const
+{
+    kvs::MutexLocker locker( &m_mutex );
+    return m_ndropped;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Captures the framebuffer with the numbered filename.
+ *
+ *  The filename is given as <basename>_<frame number>.<extension>. If the
+ *  capture function is specified, the image is not written to the file.
+ */
+/*===========================================================================*/
+void FrameCapture::capture()
+{
+    this->capture( m_capture_func ? std::string("") : this->output_filename() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Captures the framebuffer.
+ *  @param  filename [in] output filename (not written if empty)
+ */
+/*===========================================================================*/
+void FrameCapture::capture( const std::string& filename )
+{
+    KVS_TRACE_SCOPE( "kvs::FrameCapture::capture" );
+
+    const kvs::Vec4 viewport = kvs::OpenGL::Viewport();
+    const GLint x = static_cast<GLint>( viewport[0] );
+    const GLint y = static_cast<GLint>( viewport[1] );
+    const size_t width = static_cast<size_t>( viewport[2] );
+    const size_t height = static_cast<size_t>( viewport[3] );
+    const size_t size = width * height * 3;
+    m_nframes++;
+    if ( size == 0 ) { return; }
+
+    kvs::OpenGL::SetPixelStorageMode( GL_PACK_ALIGNMENT, GLint(1) );
+    kvs::OpenGL::SetReadBuffer( m_read_buffer );
+
+    // Synchronous readback.
+    if ( m_nbuffers == 1 )
+    {
+        Frame frame;
+        frame.width = width;
+        frame.height = height;
+        frame.flip = true;
+        frame.pixels.allocate( size );
+        frame.filename = filename;
+        kvs::OpenGL::ReadPixels( x, y, width, height, GL_RGB, GL_UNSIGNED_BYTE, frame.pixels.data() );
+        this->enqueue( frame );
+        return;
+    }
+
+    // The frame read into the buffer previously is retrieved before reusing it.
+    if ( m_slots[ m_current ].pending ) { this->retrieve( m_current ); }
+
+    kvs::PixelPackBufferObject& buffer = m_buffers[ m_current ];
+    if ( !buffer.isCreated() || buffer.size() != size )
+    {
+        buffer.release();
+        buffer.setUsage( GL_STREAM_READ );
+        buffer.create( size );
+    }
+
+    // Asynchronous readback into the buffer (returns without waiting for GPU).
+    kvs::PixelPackBufferObject::GuardedBinder binder( buffer );
+    kvs::OpenGL::ReadPixels( x, y, width, height, GL_RGB, GL_UNSIGNED_BYTE, NULL );
+
+    Slot& slot = m_slots[ m_current ];
+    slot.pending = true;
+    slot.width = width;
+    slot.height = height;
+    slot.filename = filename;
+    m_current = ( m_current + 1 ) % m_nbuffers;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Queues the image captured by the other way (e.g. offscreen buffer).
+ *  @param  image [in] color image
+ *  @param  filename [in] output filename (not written if empty)
+ *
+ *  The pixel array is shared with the given image, so that the image should
+ *  not be modified after pushing.
+ */
+/*===========================================================================*/
+void FrameCapture::push( const kvs::ColorImage& image, const std::string& filename )
+{
+    Frame frame;
+    frame.width = image.width();
+    frame.height = image.height();
+    frame.flip = false;
+    frame.pixels = image.pixels();
+    frame.filename = filename;
+    m_nframes++;
+    this->enqueue( frame );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Retrieves the pending frames and waits until all the frames are finished.
+ */
+/*===========================================================================*/
+void FrameCapture::flush()
+{
+    KVS_TRACE_SCOPE( "kvs::FrameCapture::flush" );
+
+    this->retrieve_pending();
+
+    kvs::MutexLocker locker( &m_mutex );
+    while ( m_ndelivered < m_nqueued ) { m_finished.wait( &m_mutex ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the numbered output filename.
+ *  @return output filename
+ */
+/*===========================================================================*/
+std::string FrameCapture::output_filename() const
+{
+    char number[32];
+    std::sprintf( number, "_%06lu.", static_cast<unsigned long>( m_nframes ) );
+    return m_basename + number + m_extension;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Maps the pixel pack buffer and queues the frame.
+ *  @param  index [in] buffer index
+ */
+/*===========================================================================*/
+void FrameCapture::retrieve( const size_t index )
+{
+    KVS_TRACE_SCOPE( "kvs::FrameCapture::retrieve" );
+
+    Slot& slot = m_slots[ index ];
+    slot.pending = false;
+
+    Frame frame;
+    frame.width = slot.width;
+    frame.height = slot.height;
+    frame.flip = true;
+    frame.pixels.allocate( slot.width * slot.height * 3 );
+    frame.filename = slot.filename;
+
+    kvs::PixelPackBufferObject& buffer = m_buffers[ index ];
+    kvs::PixelPackBufferObject::GuardedBinder binder( buffer );
+    const void* data = buffer.map( kvs::BufferObject::ReadOnly );
+    if ( !data )
+    {
+        kvsMessageError( "Cannot map the pixel pack buffer. The frame is dropped." );
+        kvs::MutexLocker locker( &m_mutex );
+        m_ndropped++;
+        return;
+    }
+    std::memcpy( frame.pixels.data(), data, frame.pixels.byteSize() );
+    buffer.unmap();
+
+    this->enqueue( frame );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Retrieves the frames pending in the buffers in the order of the readback.
+ */
+/*===========================================================================*/
+void FrameCapture::retrieve_pending()
+{
+    for ( size_t i = 0; i < m_nbuffers; i++ )
+    {
+        const size_t index = ( m_current + i ) % m_nbuffers;
+        if ( m_slots[ index ].pending ) { this->retrieve( index ); }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Queues the frame to the encoder threads.
+ *  @param  frame [in] frame
+ */
+/*===========================================================================*/
+void FrameCapture::enqueue( Frame& frame )
+{
+    if ( m_encoders.empty() ) { this->start_encoders(); }
+
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        while ( m_nqueued - m_ndelivered >= m_max_queue_size )
+        {
+            if ( m_enable_frame_dropping ) { m_ndropped++; return; }
+            m_finished.wait( &m_mutex );
+        }
+
+        frame.index = m_nqueued++;
+        m_queue.push_back( frame );
+        m_queued.wakeUpOne();
+        KVS_TRACE_COUNTER( "kvs::FrameCapture::QueueDepth", m_nqueued - m_ndelivered );
+    }
+
+    // The frame is processed in the calling thread if no threads are available.
+    if ( m_encoders.empty() ) { this->encode(); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Starts the encoder threads.
+ */
+/*===========================================================================*/
+void FrameCapture::start_encoders()
+{
+    for ( size_t i = 0; i < m_nencoders; i++ )
+    {
+        Encoder* encoder = new Encoder( this );
+        if ( !encoder->start() ) { delete encoder; break; }
+        m_encoders.push_back( encoder );
+    }
+
+    if ( m_encoders.empty() ) { kvsMessageWarning( "Cannot start encoder threads." ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Finishes the queued frames and terminates the encoder threads.
+ */
+/*===========================================================================*/
+void FrameCapture::stop_encoders()
+{
+    if ( m_encoders.empty() ) { return; }
+
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        m_quit = true;
+        m_queued.wakeUpAll();
+    }
+
+    for ( size_t i = 0; i < m_encoders.size(); i++ )
+    {
+        m_encoders[i]->wait();
+        delete m_encoders[i];
+    }
+    m_encoders.clear();
+    m_quit = false;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Encodes a queued frame and calls the capture function in order.
+ *  @return false if the thread is to be terminated
+ */
+/*===========================================================================*/
+bool FrameCapture::encode()
+{
+    Frame frame;
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        while ( m_queue.empty() && !m_quit ) { m_queued.wait( &m_mutex ); }
+        if ( m_queue.empty() ) { return false; }
+
+        frame = m_queue.front();
+        m_queue.pop_front();
+    }
+
+    kvs::ColorImage image( frame.width, frame.height, frame.pixels );
+    {
+        KVS_TRACE_SCOPE( "kvs::FrameCapture::encode" );
+        if ( frame.flip ) { image.flip(); }
+        if ( !frame.filename.empty() ) { image.write( frame.filename ); }
+    }
+
+    // The capture function is called in the order of the frames.
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        while ( m_ndelivered != frame.index ) { m_finished.wait( &m_mutex ); }
+    }
+
+    if ( m_capture_func ) { m_capture_func( image ); }
+
+    kvs::MutexLocker locker( &m_mutex );
+    m_ndelivered++;
+    m_finished.wakeUpAll();
+    return true;
+}
+
+} // end of namespace kvs
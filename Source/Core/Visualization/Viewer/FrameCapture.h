@@ -0,0 +1,138 @@
+/*****************************************************************************/
+/**
+ *  @file   FrameCapture.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <kvs/ColorImage>
+#include <kvs/ValueArray>
+#include <kvs/PixelPackBufferObject>
+#include <kvs/Mutex>
+#include <kvs/Condition>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Frame capture class with asynchronous readback and encoding.
+ *
+ *  The framebuffer is read into one of the pixel pack buffers without waiting
+ *  for the GPU, and the pixels are mapped when the buffer is reused, that is,
+ *  the frame is retrieved (number of buffers - 1) frames later. The retrieved
+ *  frames are queued to the encoder threads, which write the image files and
+ *  call the capture function in the order of the frames. If the queue is full,
+ *  the frame is dropped (frame dropping enabled) or the caller waits until
+ *  the queue has a space (frame dropping disabled).
+ *
+ *  capture() and flush() must be called in the thread with the current OpenGL
+ *  context, and flush() should be called before the context is destroyed.
+ *
+ *  kvs::FrameCapture capture;
+ *  capture.setBasename( "frame" );
+ *  capture.disableFrameDropping();
+ *  for ( size_t i = 0; i < nframes; i++ )
+ *  {
+ *      ... // draw the frame
+ *      capture.capture(); // frame_000000.png, frame_000001.png, ...
+ *  }
+ *  capture.flush();
+ */
+/*===========================================================================*/
+class FrameCapture
+{
+public:
+    using CaptureFunc = std::function<void(const kvs::ColorImage&)>;
+
+    enum { MaxNumberOfBuffers = 3 };
+
+    class Encoder;
+
+    struct Frame
+    {
+        size_t index; ///< sequence number of the queued frame
+        size_t width; ///< image width
+        size_t height; ///< image height
+        bool flip; ///< if true, the pixels are flipped vertically (OpenGL order)
+        kvs::ValueArray<kvs::UInt8> pixels; ///< RGB pixels
+        std::string filename; ///< output filename (not written if empty)
+    };
+
+private:
+    struct Slot
+    {
+        bool pending; ///< true if the readback is issued to the buffer
+        size_t width; ///< image width
+        size_t height; ///< image height
+        std::string filename; ///< output filename
+    };
+
+    size_t m_nbuffers; ///< number of pixel pack buffers (1: synchronous readback)
+    size_t m_nencoders; ///< number of encoder threads
+    size_t m_max_queue_size; ///< maximum number of frames in the queue
+    bool m_enable_frame_dropping; ///< if true, the frame is dropped when the queue is full
+    GLenum m_read_buffer; ///< read buffer (GL_BACK or GL_FRONT)
+    std::string m_basename; ///< basename of the output images
+    std::string m_extension; ///< extension of the output images
+    CaptureFunc m_capture_func; ///< capture function called in the order of the frames
+    kvs::PixelPackBufferObject m_buffers[ MaxNumberOfBuffers ]; ///< pixel pack buffers
+    Slot m_slots[ MaxNumberOfBuffers ]; ///< readback state of the buffers
+    size_t m_current; ///< index of the buffer used for the next readback
+    size_t m_nframes; ///< number of captured frames
+
+    // Encoder queue (shared with the encoder threads).
+    mutable kvs::Mutex m_mutex; ///< mutex for the queue
+    kvs::Condition m_queued; ///< condition signaled when a frame is queued
+    kvs::Condition m_finished; ///< condition signaled when a frame is finished
+    std::deque<Frame> m_queue; ///< frames waiting for encoding
+    std::vector<Encoder*> m_encoders; ///< encoder threads
+    size_t m_nqueued; ///< number of queued frames
+    size_t m_ndelivered; ///< number of finished frames
+    size_t m_ndropped; ///< number of dropped frames
+    bool m_quit; ///< flag for terminating the encoder threads
+
+public:
+    FrameCapture();
+    FrameCapture( CaptureFunc func );
+    virtual ~FrameCapture();
+
+    void setNumberOfBuffers( const size_t nbuffers );
+    void setNumberOfEncoders( const size_t nencoders );
+    void setMaxQueueSize( const size_t size ) { m_max_queue_size = size > 0 ? size : 1; }
+    void setEnabledFrameDropping( const bool enable ) { m_enable_frame_dropping = enable; }
+    void enableFrameDropping() { this->setEnabledFrameDropping( true ); }
+    void disableFrameDropping() { this->setEnabledFrameDropping( false ); }
+    void setReadBuffer( const GLenum mode ) { m_read_buffer = mode; }
+    void setBasename( const std::string& basename ) { m_basename = basename; }
+    void setExtension( const std::string& extension ) { m_extension = extension; }
+    void update( CaptureFunc func ) { m_capture_func = func; }
+
+    size_t numberOfBuffers() const { return m_nbuffers; }
+    size_t numberOfEncoders() const { return m_nencoders; }
+    size_t maxQueueSize() const { return m_max_queue_size; }
+    bool isEnabledFrameDropping() const { return m_enable_frame_dropping; }
+    size_t numberOfFrames() const { return m_nframes; }
+    size_t queueDepth() const;
+    size_t numberOfDroppedFrames() const;
+
+    void capture();
+    void capture( const std::string& filename );
+    void push( const kvs::ColorImage& image, const std::string& filename = "" );
+    void flush();
+
+private:
+    std::string output_filename() const;
+    void retrieve( const size_t index );
+    void retrieve_pending();
+    void enqueue( Frame& frame );
+    void start_encoders();
+    void stop_encoders();
+    bool encode();
+};
+
+} // end of namespace kvs
@@ -19,6 +19,7 @@
 #include <kvs/VisualizationPipeline>
 #include <kvs/Coordinate>
 #include <kvs/UIColor>
+#include <kvs/Trace>
 
 
 namespace
@@ -686,6 +687,7 @@ void Scene::initializeFunction()
 /*==========================================================================*/
 void Scene::paintFunction()
 {
+    KVS_TRACE_SCOPE( "kvs::Scene::paintFunction" );
     this->updateGLProjectionMatrix();
     this->updateGLViewingMatrix();
     this->updateGLLightParameters();
@@ -706,6 +708,7 @@ void Scene::paintFunction()
             {
                 kvs::OpenGL::PushMatrix();
                 this->updateGLModelingMatrix( object );
+                KVS_TRACE_SCOPE( renderer->moduleName() );
                 renderer->exec( object, m_camera, m_light );
                 kvs::OpenGL::PopMatrix();
             }
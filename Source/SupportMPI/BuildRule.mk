@@ -5,13 +5,21 @@
 OBJECTS := \
 $(OUTDIR)/./Communicator.o \
 $(OUTDIR)/./Environment.o \
+$(OUTDIR)/./Filter/VolumePartitioner.o \
 $(OUTDIR)/./MPICall.o \
+$(OUTDIR)/./Mapper/CellByCellUniformSampling.o \
+$(OUTDIR)/./Mapper/ExternalFaces.o \
+$(OUTDIR)/./Mapper/GhostCulling.o \
+$(OUTDIR)/./Mapper/MarchingCubes.o \
+$(OUTDIR)/./Mapper/MarchingTetrahedra.o \
+$(OUTDIR)/./Mapper/ObjectGatherer.o \
 $(OUTDIR)/./Renderer/234Compositor/234compositor.o \
 $(OUTDIR)/./Renderer/234Compositor/compress.o \
 $(OUTDIR)/./Renderer/234Compositor/exchange.o \
 $(OUTDIR)/./Renderer/234Compositor/merge.o \
 $(OUTDIR)/./Renderer/234Compositor/misc.o \
 $(OUTDIR)/./Renderer/ImageCompositor.o \
+$(OUTDIR)/./Renderer/SparseImageCompositor.o \
 $(OUTDIR)/./Request.o \
 $(OUTDIR)/./Window.o \
 
@@ -25,6 +33,14 @@ $(OUTDIR)/./Renderer/%.o: ./Renderer/%.cpp ./Renderer/%.h
 	$(MKDIR) $(OUTDIR)/./Renderer
 	$(MPICPP) -c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) -o $@ $<
 
+$(OUTDIR)/./Mapper/%.o: ./Mapper/%.cpp ./Mapper/%.h
+	$(MKDIR) $(OUTDIR)/./Mapper
+	$(MPICPP) -c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) -o $@ $<
+
+$(OUTDIR)/./Filter/%.o: ./Filter/%.cpp ./Filter/%.h
+	$(MKDIR) $(OUTDIR)/./Filter
+	$(MPICPP) -c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) -o $@ $<
+
 $(OUTDIR)/./%.o: ./%.cpp ./%.h
 	$(MKDIR) $(OUTDIR)
 	$(MPICPP) -c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) -o $@ $<
@@ -33,6 +49,10 @@ $(OUTDIR)/./%.o: ./%.cpp ./%.h
 install::
 	$(MKDIR) $(INSTALL_DIR)/include/SupportMPI/.
 	$(INSTALL) ./*.h $(INSTALL_DIR)/include/SupportMPI/.
+	$(MKDIR) $(INSTALL_DIR)/include/SupportMPI/./Filter
+	$(INSTALL) ./Filter/*.h $(INSTALL_DIR)/include/SupportMPI/./Filter
+	$(MKDIR) $(INSTALL_DIR)/include/SupportMPI/./Mapper
+	$(INSTALL) ./Mapper/*.h $(INSTALL_DIR)/include/SupportMPI/./Mapper
 	$(MKDIR) $(INSTALL_DIR)/include/SupportMPI/./Renderer
 	$(INSTALL) ./Renderer/*.h $(INSTALL_DIR)/include/SupportMPI/./Renderer
 	$(MKDIR) $(INSTALL_DIR)/include/SupportMPI/./Renderer/234Compositor
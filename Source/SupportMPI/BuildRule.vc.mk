@@ -5,13 +5,21 @@
 OBJECTS = \
 $(OUTDIR)\.\Communicator.obj \
 $(OUTDIR)\.\Environment.obj \
+$(OUTDIR)\.\Filter\VolumePartitioner.obj \
 $(OUTDIR)\.\MPICall.obj \
+$(OUTDIR)\.\Mapper\CellByCellUniformSampling.obj \
+$(OUTDIR)\.\Mapper\ExternalFaces.obj \
+$(OUTDIR)\.\Mapper\GhostCulling.obj \
+$(OUTDIR)\.\Mapper\MarchingCubes.obj \
+$(OUTDIR)\.\Mapper\MarchingTetrahedra.obj \
+$(OUTDIR)\.\Mapper\ObjectGatherer.obj \
 $(OUTDIR)\.\Renderer\234Compositor\234compositor.obj \
 $(OUTDIR)\.\Renderer\234Compositor\compress.obj \
 $(OUTDIR)\.\Renderer\234Compositor\exchange.obj \
 $(OUTDIR)\.\Renderer\234Compositor\merge.obj \
 $(OUTDIR)\.\Renderer\234Compositor\misc.obj \
 $(OUTDIR)\.\Renderer\ImageCompositor.obj \
+$(OUTDIR)\.\Renderer\SparseImageCompositor.obj \
 $(OUTDIR)\.\Request.obj \
 $(OUTDIR)\.\Window.obj \
 
@@ -29,6 +37,18 @@ $<
 $<
 <<
 
+{.\Mapper\}.cpp{$(OUTDIR)\.\Mapper\}.obj::
+	IF NOT EXIST $(OUTDIR)\.\Mapper $(MKDIR) $(OUTDIR)\.\Mapper
+	$(MPICPP) /c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) /Fo$(OUTDIR)\.\Mapper\ @<<
+$<
+<<
+
+{.\Filter\}.cpp{$(OUTDIR)\.\Filter\}.obj::
+	IF NOT EXIST $(OUTDIR)\.\Filter $(MKDIR) $(OUTDIR)\.\Filter
+	$(MPICPP) /c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) /Fo$(OUTDIR)\.\Filter\ @<<
+$<
+<<
+
 {.\}.cpp{$(OUTDIR)\.\}.obj::
 	IF NOT EXIST $(OUTDIR)\. $(MKDIR) $(OUTDIR)\.
 	$(MPICPP) /c $(CPPFLAGS) $(DEFINITIONS) $(INCLUDE_PATH) /Fo$(OUTDIR)\.\ @<<
@@ -39,6 +59,10 @@ $<
 install::
 	IF NOT EXIST $(INSTALL_DIR)\include\SupportMPI\. $(MKDIR) $(INSTALL_DIR)\include\SupportMPI\.
 	$(INSTALL) .\*.h $(INSTALL_DIR)\include\SupportMPI\.
+	IF NOT EXIST $(INSTALL_DIR)\include\SupportMPI\.\Filter $(MKDIR) $(INSTALL_DIR)\include\SupportMPI\.\Filter
+	$(INSTALL) .\Filter\*.h $(INSTALL_DIR)\include\SupportMPI\.\Filter
+	IF NOT EXIST $(INSTALL_DIR)\include\SupportMPI\.\Mapper $(MKDIR) $(INSTALL_DIR)\include\SupportMPI\.\Mapper
+	$(INSTALL) .\Mapper\*.h $(INSTALL_DIR)\include\SupportMPI\.\Mapper
 	IF NOT EXIST $(INSTALL_DIR)\include\SupportMPI\.\Renderer $(MKDIR) $(INSTALL_DIR)\include\SupportMPI\.\Renderer
 	$(INSTALL) .\Renderer\*.h $(INSTALL_DIR)\include\SupportMPI\.\Renderer
 	IF NOT EXIST $(INSTALL_DIR)\include\SupportMPI\.\Renderer\234Compositor $(MKDIR) $(INSTALL_DIR)\include\SupportMPI\.\Renderer\234Compositor
@@ -158,6 +158,9 @@ public:
     template <typename T>
     void gather( const int root, const T* send_values, const size_t send_size, T* recv_values, const size_t recv_size );
 
+    template <typename T>
+    void gather( const int root, const kvs::ValueArray<T>& send_values, kvs::ValueArray<T>& recv_values, kvs::ValueArray<int>& recv_counts );
+
     template <typename T>
     void gather( const T& send_value, kvs::ValueArray<T>& recv_values )
     {
@@ -176,6 +179,12 @@ public:
         this->gather( this->root(), send_values, send_size, recv_values, recv_size );
     }
 
+    template <typename T>
+    void gather( const kvs::ValueArray<T>& send_values, kvs::ValueArray<T>& recv_values, kvs::ValueArray<int>& recv_counts )
+    {
+        this->gather( this->root(), send_values, recv_values, recv_counts );
+    }
+
     // Reduce
 
     template <typename T, typename Op>
@@ -477,6 +486,32 @@ inline void Communicator::gather( const int root, const T* send_values, const si
     KVS_MPI_CALL( MPI_Gather( const_cast<T*>(send_values), static_cast<int>(send_size), type, recv_values, static_cast<int>(recv_size), type, root, m_handler ) );
 }
 
+template <typename T>
+inline void Communicator::gather( const int root, const kvs::ValueArray<T>& send_values, kvs::ValueArray<T>& recv_values, kvs::ValueArray<int>& recv_counts )
+{
+    // Gather the arrays which have different sizes. The number of values sent
+    // from each rank is returned in recv_counts on the root rank.
+    const int send_size = static_cast<int>( send_values.size() );
+    this->gather<int>( root, send_size, recv_counts );
+
+    const MPI_Datatype type = kvs::mpi::DataType<T>::Enum();
+    const int rank = this->rank();
+    if ( rank == root )
+    {
+        const int size = this->size();
+        kvs::ValueArray<int> displs( size );
+        int total = 0;
+        for ( int i = 0; i < size; i++ ) { displs[i] = total; total += recv_counts[i]; }
+        recv_values.allocate( total );
+
+        KVS_MPI_CALL( MPI_Gatherv( const_cast<T*>( send_values.data() ), send_size, type, recv_values.data(), recv_counts.data(), displs.data(), type, root, m_handler ) );
+    }
+    else
+    {
+        KVS_MPI_CALL( MPI_Gatherv( const_cast<T*>( send_values.data() ), send_size, type, NULL, NULL, NULL, type, root, m_handler ) );
+    }
+}
+
 template <typename T, typename Op>
 inline void Communicator::reduce( const int root, const T& send_value, T& recv_value, const Op op )
 {
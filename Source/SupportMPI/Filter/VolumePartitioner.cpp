@@ -0,0 +1,426 @@
+/*****************************************************************************/
+/**
+ *  @file   VolumePartitioner.cpp
+ */
+/*****************************************************************************/
+#include "VolumePartitioner.h"
+#include <kvs/AnyValueArray>
+#include <kvs/ValueArray>
+#include <kvs/Message>
+#include <kvs/Math>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Allocates a value array which has the same type as the given array.
+ *  @param  values [in] value array
+ *  @param  size [in] number of values
+ *  @return allocated value array
+ */
+/*===========================================================================*/
+kvs::AnyValueArray Allocate( const kvs::AnyValueArray& values, const size_t size )
+{
+    switch ( values.typeID() )
+    {
+    case kvs::Type::TypeInt8:   return kvs::AnyValueArray( kvs::ValueArray<kvs::Int8>( size ) );
+    case kvs::Type::TypeInt16:  return kvs::AnyValueArray( kvs::ValueArray<kvs::Int16>( size ) );
+    case kvs::Type::TypeInt32:  return kvs::AnyValueArray( kvs::ValueArray<kvs::Int32>( size ) );
+    case kvs::Type::TypeInt64:  return kvs::AnyValueArray( kvs::ValueArray<kvs::Int64>( size ) );
+    case kvs::Type::TypeUInt8:  return kvs::AnyValueArray( kvs::ValueArray<kvs::UInt8>( size ) );
+    case kvs::Type::TypeUInt16: return kvs::AnyValueArray( kvs::ValueArray<kvs::UInt16>( size ) );
+    case kvs::Type::TypeUInt32: return kvs::AnyValueArray( kvs::ValueArray<kvs::UInt32>( size ) );
+    case kvs::Type::TypeUInt64: return kvs::AnyValueArray( kvs::ValueArray<kvs::UInt64>( size ) );
+    case kvs::Type::TypeReal32: return kvs::AnyValueArray( kvs::ValueArray<kvs::Real32>( size ) );
+    case kvs::Type::TypeReal64: return kvs::AnyValueArray( kvs::ValueArray<kvs::Real64>( size ) );
+    default: break;
+    }
+    return kvs::AnyValueArray();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the index of the longest axis of the given extent.
+ *  @param  extent [in] extent of the region
+ *  @return axis index (0: x, 1: y, 2: z)
+ */
+/*===========================================================================*/
+int LongestAxis( const kvs::Vec3& extent )
+{
+    int axis = 0;
+    if ( extent[1] > extent[axis] ) { axis = 1; }
+    if ( extent[2] > extent[axis] ) { axis = 2; }
+    return axis;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new VolumePartitioner class.
+ *  @param  comm [in] MPI communicator
+ *  @param  nghosts [in] number of ghost layers
+ */
+/*===========================================================================*/
+VolumePartitioner::VolumePartitioner( const kvs::mpi::Communicator& comm, const size_t nghosts ):
+    m_comm( comm ),
+    m_nghosts( nghosts )
+{
+    m_owned_region.min_coord = kvs::Vec3::Zero();
+    m_owned_region.max_coord = kvs::Vec3::Zero();
+    m_owned_region.ncells = 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the partition of the given volume object for this rank.
+ *  @param  volume [in] pointer to the whole volume object
+ *  @return pointer to the partitioned volume object (NULL if failed)
+ */
+/*===========================================================================*/
+kvs::VolumeObjectBase* VolumePartitioner::partition( const kvs::VolumeObjectBase* volume )
+{
+    if ( !volume )
+    {
+        kvsMessageError("Input object is NULL.");
+        return NULL;
+    }
+
+    switch ( volume->volumeType() )
+    {
+    case kvs::VolumeObjectBase::Structured:
+        return this->partition( kvs::StructuredVolumeObject::DownCast( volume ) );
+    case kvs::VolumeObjectBase::Unstructured:
+        return this->partition( kvs::UnstructuredVolumeObject::DownCast( volume ) );
+    default: break;
+    }
+
+    kvsMessageError("Input object is not supported.");
+    return NULL;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the partition of the given structured volume object.
+ *  @param  volume [in] pointer to the whole structured volume object
+ *  @return pointer to the partitioned structured volume object (NULL if failed)
+ */
+/*===========================================================================*/
+kvs::StructuredVolumeObject* VolumePartitioner::partition( const kvs::StructuredVolumeObject* volume )
+{
+    if ( !volume )
+    {
+        kvsMessageError("Input object is NULL.");
+        return NULL;
+    }
+
+    if ( volume->gridType() != kvs::StructuredVolumeObject::Uniform )
+    {
+        kvsMessageError("Only the uniform grid is supported.");
+        return NULL;
+    }
+
+    const size_t size = static_cast<size_t>( m_comm.size() );
+    const size_t rank = static_cast<size_t>( m_comm.rank() );
+
+    // Nodes [begin, end] along the longest axis are assigned to this rank, and
+    // the neighboring partitions share the node layer at the boundary.
+    const kvs::Vec3ui resolution = volume->resolution();
+    const int axis = ::LongestAxis( kvs::Vec3( resolution ) );
+    const size_t ncells = resolution[axis] - 1;
+    if ( ncells < size )
+    {
+        kvsMessageError("Number of cells along the axis is less than the number of ranks.");
+        return NULL;
+    }
+
+    const size_t begin = rank * ncells / size;
+    const size_t end = ( rank + 1 ) * ncells / size;
+    const size_t ghost_begin = begin > m_nghosts ? begin - m_nghosts : 0;
+    const size_t ghost_end = kvs::Math::Min( end + m_nghosts, ncells );
+
+    kvs::Vec3ui offset( 0, 0, 0 );
+    kvs::Vec3ui local_resolution( resolution );
+    offset[axis] = static_cast<unsigned int>( ghost_begin );
+    local_resolution[axis] = static_cast<unsigned int>( ghost_end - ghost_begin + 1 );
+
+    m_owned_region.min_coord = kvs::Vec3::Zero();
+    m_owned_region.max_coord = kvs::Vec3( local_resolution - kvs::Vec3ui::Constant( 1 ) );
+    m_owned_region.min_coord[axis] = static_cast<float>( begin - ghost_begin );
+    m_owned_region.max_coord[axis] = static_cast<float>( end - ghost_begin );
+    m_owned_region.ncells = ( end - begin );
+    for ( int a = 0; a < 3; a++ ) { if ( a != axis ) { m_owned_region.ncells *= resolution[a] - 1; } }
+
+    // Copy the node values row by row (rows along the x-axis are contiguous).
+    const kvs::AnyValueArray& values = volume->values();
+    const size_t nnodes = local_resolution.x() * local_resolution.y() * local_resolution.z();
+    const size_t veclen = volume->veclen();
+    kvs::AnyValueArray local_values = ::Allocate( values, nnodes * veclen );
+    if ( local_values.empty() )
+    {
+        kvsMessageError("Unsupported data type '%s'.", values.typeInfo()->typeName() );
+        return NULL;
+    }
+
+    const size_t node_bytes = values.byteSize() / values.size() * veclen;
+    const size_t row_bytes = node_bytes * local_resolution.x();
+    const kvs::UInt8* src = static_cast<const kvs::UInt8*>( values.data() );
+    kvs::UInt8* dst = static_cast<kvs::UInt8*>( local_values.data() );
+    for ( size_t k = 0; k < local_resolution.z(); k++ )
+    {
+        for ( size_t j = 0; j < local_resolution.y(); j++ )
+        {
+            const size_t index =
+                offset.x() +
+                ( offset.y() + j ) * resolution.x() +
+                ( offset.z() + k ) * resolution.x() * resolution.y();
+            std::memcpy( dst, src + index * node_bytes, row_bytes );
+            dst += row_bytes;
+        }
+    }
+
+    if ( !volume->hasMinMaxValues() ) { volume->updateMinMaxValues(); }
+
+    kvs::StructuredVolumeObject* object = new kvs::StructuredVolumeObject();
+    object->setGridTypeToUniform();
+    object->setVeclen( veclen );
+    object->setResolution( local_resolution );
+    object->setValues( local_values );
+    object->setLabel( volume->label() );
+    object->setUnit( volume->unit() );
+    object->setMinMaxValues( volume->minValue(), volume->maxValue() );
+    object->updateMinMaxCoords();
+
+    const kvs::Vec3 min_coord( offset );
+    const kvs::Vec3 max_coord( offset + local_resolution - kvs::Vec3ui::Constant( 1 ) );
+    object->setMinMaxExternalCoords(
+        this->to_external( volume, min_coord ),
+        this->to_external( volume, max_coord ) );
+
+    return object;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the partition of the given unstructured volume object.
+ *  @param  volume [in] pointer to the whole unstructured volume object
+ *  @return pointer to the partitioned unstructured volume object (NULL if failed)
+ */
+/*===========================================================================*/
+kvs::UnstructuredVolumeObject* VolumePartitioner::partition( const kvs::UnstructuredVolumeObject* volume )
+{
+    if ( !volume )
+    {
+        kvsMessageError("Input object is NULL.");
+        return NULL;
+    }
+
+    const size_t size = static_cast<size_t>( m_comm.size() );
+    const size_t rank = static_cast<size_t>( m_comm.rank() );
+
+    const size_t ncells = volume->numberOfCells();
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t ncellnodes = volume->numberOfCellNodes();
+    if ( ncells < size )
+    {
+        kvsMessageError("Number of cells is less than the number of ranks.");
+        return NULL;
+    }
+
+    const kvs::ValueArray<kvs::Real32>& coords = volume->coords();
+    const kvs::ValueArray<kvs::UInt32>& connections = volume->connections();
+
+    // Bounding box of the nodes.
+    kvs::Vec3 min_coord( coords.data() );
+    kvs::Vec3 max_coord( coords.data() );
+    for ( size_t i = 1; i < nnodes; i++ )
+    {
+        const kvs::Vec3 p( coords.data() + 3 * i );
+        for ( int a = 0; a < 3; a++ )
+        {
+            min_coord[a] = kvs::Math::Min( min_coord[a], p[a] );
+            max_coord[a] = kvs::Math::Max( max_coord[a], p[a] );
+        }
+    }
+
+    // Sort the cells by the centroid along the longest axis and select the
+    // cells assigned to this rank.
+    const int axis = ::LongestAxis( max_coord - min_coord );
+    std::vector<kvs::Real32> keys( ncells, 0.0f );
+    for ( size_t i = 0; i < ncells; i++ )
+    {
+        const kvs::UInt32* id = connections.data() + ncellnodes * i;
+        for ( size_t j = 0; j < ncellnodes; j++ ) { keys[i] += coords[ 3 * id[j] + axis ]; }
+    }
+
+    std::vector<kvs::UInt32> cells( ncells );
+    for ( size_t i = 0; i < ncells; i++ ) { cells[i] = static_cast<kvs::UInt32>( i ); }
+
+    const size_t begin = rank * ncells / size;
+    const size_t end = ( rank + 1 ) * ncells / size;
+    struct Compare
+    {
+        const std::vector<kvs::Real32>& keys;
+        Compare( const std::vector<kvs::Real32>& k ): keys( k ) {}
+        bool operator () ( const kvs::UInt32 a, const kvs::UInt32 b ) const { return keys[a] < keys[b]; }
+    } compare( keys );
+    std::nth_element( cells.begin(), cells.begin() + begin, cells.end(), compare );
+    std::nth_element( cells.begin() + begin, cells.begin() + ( end - 1 ), cells.end(), compare );
+    std::sort( cells.begin() + begin, cells.begin() + end );
+
+    // Add the rings of the node-adjacent cells as the ghost cells, which are
+    // stored after the owned cells.
+    std::vector<kvs::UInt32> local_cells( cells.begin() + begin, cells.begin() + end );
+    if ( m_nghosts > 0 )
+    {
+        std::vector<bool> selected_cells( ncells, false );
+        std::vector<bool> selected_nodes( nnodes, false );
+        for ( size_t i = 0; i < local_cells.size(); i++ )
+        {
+            selected_cells[ local_cells[i] ] = true;
+            const kvs::UInt32* id = connections.data() + ncellnodes * local_cells[i];
+            for ( size_t j = 0; j < ncellnodes; j++ ) { selected_nodes[ id[j] ] = true; }
+        }
+
+        for ( size_t layer = 0; layer < m_nghosts; layer++ )
+        {
+            const size_t first = local_cells.size();
+            for ( size_t i = 0; i < ncells; i++ )
+            {
+                if ( selected_cells[i] ) { continue; }
+                const kvs::UInt32* id = connections.data() + ncellnodes * i;
+                for ( size_t j = 0; j < ncellnodes; j++ )
+                {
+                    if ( selected_nodes[ id[j] ] ) { local_cells.push_back( static_cast<kvs::UInt32>( i ) ); break; }
+                }
+            }
+
+            for ( size_t i = first; i < local_cells.size(); i++ )
+            {
+                selected_cells[ local_cells[i] ] = true;
+                const kvs::UInt32* id = connections.data() + ncellnodes * local_cells[i];
+                for ( size_t j = 0; j < ncellnodes; j++ ) { selected_nodes[ id[j] ] = true; }
+            }
+        }
+    }
+
+    // Compact the nodes referred from the selected cells.
+    const size_t local_ncells = local_cells.size();
+    const kvs::UInt32 Unused = static_cast<kvs::UInt32>( -1 );
+    std::vector<kvs::UInt32> node_map( nnodes, Unused );
+    kvs::ValueArray<kvs::UInt32> local_connections( local_ncells * ncellnodes );
+    size_t local_nnodes = 0;
+    for ( size_t i = 0; i < local_ncells; i++ )
+    {
+        const kvs::UInt32* id = connections.data() + ncellnodes * local_cells[i];
+        kvs::UInt32* local_id = local_connections.data() + ncellnodes * i;
+        for ( size_t j = 0; j < ncellnodes; j++ )
+        {
+            if ( node_map[ id[j] ] == Unused ) { node_map[ id[j] ] = static_cast<kvs::UInt32>( local_nnodes++ ); }
+            local_id[j] = node_map[ id[j] ];
+        }
+    }
+
+    const kvs::AnyValueArray& values = volume->values();
+    const size_t veclen = volume->veclen();
+    kvs::AnyValueArray local_values = ::Allocate( values, local_nnodes * veclen );
+    if ( local_values.empty() )
+    {
+        kvsMessageError("Unsupported data type '%s'.", values.typeInfo()->typeName() );
+        return NULL;
+    }
+
+    const size_t node_bytes = values.byteSize() / values.size() * veclen;
+    const kvs::UInt8* src = static_cast<const kvs::UInt8*>( values.data() );
+    kvs::UInt8* dst = static_cast<kvs::UInt8*>( local_values.data() );
+    kvs::ValueArray<kvs::Real32> local_coords( local_nnodes * 3 );
+    for ( size_t i = 0; i < nnodes; i++ )
+    {
+        const kvs::UInt32 index = node_map[i];
+        if ( index == Unused ) { continue; }
+        local_coords[ 3 * index + 0 ] = coords[ 3 * i + 0 ];
+        local_coords[ 3 * index + 1 ] = coords[ 3 * i + 1 ];
+        local_coords[ 3 * index + 2 ] = coords[ 3 * i + 2 ];
+        std::memcpy( dst + index * node_bytes, src + i * node_bytes, node_bytes );
+    }
+
+    if ( !volume->hasMinMaxValues() ) { volume->updateMinMaxValues(); }
+
+    kvs::UnstructuredVolumeObject* object = new kvs::UnstructuredVolumeObject();
+    object->setCellType( volume->cellType() );
+    object->setVeclen( veclen );
+    object->setNumberOfNodes( local_nnodes );
+    object->setNumberOfCells( local_ncells );
+    object->setCoords( local_coords );
+    object->setConnections( local_connections );
+    object->setValues( local_values );
+    object->setLabel( volume->label() );
+    object->setUnit( volume->unit() );
+    object->setMinMaxValues( volume->minValue(), volume->maxValue() );
+    object->updateMinMaxCoords();
+    object->setMinMaxExternalCoords(
+        this->to_external( volume, object->minObjectCoord() ),
+        this->to_external( volume, object->maxObjectCoord() ) );
+
+    // Bounding box of the owned cells.
+    m_owned_region.min_coord = object->maxObjectCoord();
+    m_owned_region.max_coord = object->minObjectCoord();
+    m_owned_region.ncells = end - begin;
+    for ( size_t i = 0; i < ( end - begin ) * ncellnodes; i++ )
+    {
+        const kvs::Vec3 p( local_coords.data() + 3 * local_connections[i] );
+        for ( int a = 0; a < 3; a++ )
+        {
+            m_owned_region.min_coord[a] = kvs::Math::Min( m_owned_region.min_coord[a], p[a] );
+            m_owned_region.max_coord[a] = kvs::Math::Max( m_owned_region.max_coord[a], p[a] );
+        }
+    }
+
+    return object;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Converts the object coordinate of the whole volume to the external coordinate.
+ *  @param  volume [in] pointer to the whole volume object
+ *  @param  coord [in] coordinate in the object coordinate system of the volume
+ *  @return coordinate in the external coordinate system of the volume
+ */
+/*===========================================================================*/
+kvs::Vec3 VolumePartitioner::to_external( const kvs::VolumeObjectBase* volume, const kvs::Vec3& coord ) const
+{
+    // The object and external coordinates are identical unless both of them
+    // have been specified explicitly.
+    if ( !volume->hasMinMaxObjectCoords() || !volume->hasMinMaxExternalCoords() ) { return coord; }
+
+    const kvs::Vec3& min_obj = volume->minObjectCoord();
+    const kvs::Vec3& max_obj = volume->maxObjectCoord();
+    const kvs::Vec3& min_ext = volume->minExternalCoord();
+    const kvs::Vec3& max_ext = volume->maxExternalCoord();
+
+    kvs::Vec3 result;
+    for ( int a = 0; a < 3; a++ )
+    {
+        const float diff = max_obj[a] - min_obj[a];
+        const float t = kvs::Math::IsZero( diff ) ? 0.0f : ( coord[a] - min_obj[a] ) / diff;
+        result[a] = min_ext[a] + t * ( max_ext[a] - min_ext[a] );
+    }
+
+    return result;
+}
+
+} // end of namespace mpi
+
+} // end of namespace kvs
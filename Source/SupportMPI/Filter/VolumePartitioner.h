@@ -0,0 +1,77 @@
+/*****************************************************************************/
+/**
+ *  @file   VolumePartitioner.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/mpi/Communicator>
+#include <kvs/VolumeObjectBase>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/Vector3>
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Volume partitioner for sort-last distributed rendering.
+ *
+ *  The volume object given on every rank is divided into the same number of
+ *  partitions as the ranks of the communicator, and the partition assigned to
+ *  the calling rank is returned. A structured volume is divided into slabs
+ *  along its longest axis, where the neighboring slabs share a boundary node
+ *  layer so that no gap appears between the rendered partitions. An
+ *  unstructured volume is divided into the groups of cells which have the
+ *  same number of cells sorted by the cell centroid along the longest axis.
+ *
+ *  The min/max object coordinates of the partition are given in its local
+ *  coordinate system, and the min/max external coordinates place the
+ *  partition in the coordinate system of the whole volume.
+ *
+ *  If ghost layers are specified, each partition is extended by the given
+ *  number of cell layers owned by the neighboring partitions. For the
+ *  unstructured volume, the ghost cells are the node-adjacent cells and are
+ *  stored after the owned cells. The region owned by the rank is returned by
+ *  ownedRegion() and can be passed to the MPI-aware mappers, which discard
+ *  the primitives generated in the ghost region.
+ */
+/*===========================================================================*/
+class VolumePartitioner
+{
+public:
+    struct OwnedRegion
+    {
+        kvs::Vec3 min_coord; ///< min. object coord of the owned region in the partition
+        kvs::Vec3 max_coord; ///< max. object coord of the owned region in the partition
+        size_t ncells; ///< number of owned cells (stored first in the unstructured partition)
+    };
+
+private:
+    kvs::mpi::Communicator m_comm; ///< MPI communicator
+    size_t m_nghosts; ///< number of ghost layers
+    OwnedRegion m_owned_region; ///< owned region of the last partition
+
+public:
+    VolumePartitioner( const kvs::mpi::Communicator& comm, const size_t nghosts = 0 );
+
+    size_t numberOfGhostLayers() const { return m_nghosts; }
+    const OwnedRegion& ownedRegion() const { return m_owned_region; }
+
+    void setNumberOfGhostLayers( const size_t nghosts ) { m_nghosts = nghosts; }
+
+    kvs::VolumeObjectBase* partition( const kvs::VolumeObjectBase* volume );
+    kvs::StructuredVolumeObject* partition( const kvs::StructuredVolumeObject* volume );
+    kvs::UnstructuredVolumeObject* partition( const kvs::UnstructuredVolumeObject* volume );
+
+private:
+    kvs::Vec3 to_external( const kvs::VolumeObjectBase* volume, const kvs::Vec3& coord ) const;
+};
+
+} // end of namespace mpi
+
+} // end of namespace kvs
@@ -0,0 +1,165 @@
+/*****************************************************************************/
+/**
+ *  @file   CellByCellUniformSampling.cpp
+ */
+/*****************************************************************************/
+#include "CellByCellUniformSampling.h"
+#include "GhostCulling.h"
+#include "ObjectGatherer.h"
+#include <kvs/Message>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/UnstructuredVolumeObject>
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new CellByCellUniformSampling class.
+ *  @param  comm [in] MPI communicator
+ */
+/*===========================================================================*/
+CellByCellUniformSampling::CellByCellUniformSampling( const kvs::mpi::Communicator& comm ):
+    m_comm( comm ),
+    m_has_owned_region( false ),
+    m_gathering( false )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs and creates a point object.
+ *  @param  comm [in] MPI communicator
+ *  @param  volume [in] pointer to the partition of the volume object
+ *  @param  region [in] region owned by the rank
+ *  @param  repetition_level [in] repetition level
+ *  @param  sampling_step [in] sampling step
+ *  @param  transfer_function [in] transfer function
+ *  @param  object_depth [in] depth value of the input volume at the CoG
+ */
+/*===========================================================================*/
+CellByCellUniformSampling::CellByCellUniformSampling(
+    const kvs::mpi::Communicator& comm,
+    const kvs::VolumeObjectBase* volume,
+    const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+    const size_t repetition_level,
+    const float sampling_step,
+    const kvs::TransferFunction& transfer_function,
+    const float object_depth ):
+    m_comm( comm ),
+    m_has_owned_region( false ),
+    m_gathering( false )
+{
+    BaseClass::setTransferFunction( transfer_function );
+    BaseClass::setRepetitionLevel( repetition_level );
+    BaseClass::setSamplingStep( sampling_step );
+    BaseClass::setObjectDepth( object_depth );
+    this->setOwnedRegion( region );
+    this->exec( volume );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs and creates a point object.
+ *  @param  comm [in] MPI communicator
+ *  @param  camera [in] pointer to the camera
+ *  @param  volume [in] pointer to the partition of the volume object
+ *  @param  region [in] region owned by the rank
+ *  @param  repetition_level [in] repetition level
+ *  @param  sampling_step [in] sampling step
+ *  @param  transfer_function [in] transfer function
+ *  @param  object_depth [in] depth value of the input volume at the CoG
+ */
+/*===========================================================================*/
+CellByCellUniformSampling::CellByCellUniformSampling(
+    const kvs::mpi::Communicator& comm,
+    const kvs::Camera* camera,
+    const kvs::VolumeObjectBase* volume,
+    const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+    const size_t repetition_level,
+    const float sampling_step,
+    const kvs::TransferFunction& transfer_function,
+    const float object_depth ):
+    m_comm( comm ),
+    m_has_owned_region( false ),
+    m_gathering( false )
+{
+    BaseClass::attachCamera( camera );
+    BaseClass::setTransferFunction( transfer_function );
+    BaseClass::setRepetitionLevel( repetition_level );
+    BaseClass::setSamplingStep( sampling_step );
+    BaseClass::setObjectDepth( object_depth );
+    this->setOwnedRegion( region );
+    this->exec( volume );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the region owned by the rank.
+ *  @param  region [in] owned region given by kvs::mpi::VolumePartitioner
+ */
+/*===========================================================================*/
+void CellByCellUniformSampling::setOwnedRegion( const kvs::mpi::VolumePartitioner::OwnedRegion& region )
+{
+    m_owned_region = region;
+    m_has_owned_region = true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the mapper process.
+ *  @param  object [in] pointer to the partition of the volume object
+ *  @return pointer to the point object
+ *
+ *  This method is collective if the owned region of the structured partition
+ *  is specified or the gathering is enabled.
+ */
+/*===========================================================================*/
+CellByCellUniformSampling::SuperClass* CellByCellUniformSampling::exec( const kvs::ObjectBase* object )
+{
+    // The collective processes are entered even if the extraction fails on
+    // the rank, so that the other ranks are not blocked. The failing rank
+    // contributes no points, and the error is reported after the gathering.
+    bool success = false;
+    const kvs::UnstructuredVolumeObject* unstructured = kvs::UnstructuredVolumeObject::DownCast( object );
+    if ( unstructured && m_has_owned_region )
+    {
+        kvs::UnstructuredVolumeObject owned;
+        kvs::mpi::GhostCulling::OwnedCells( unstructured, m_owned_region, &owned );
+        success = BaseClass::exec( &owned ) != NULL;
+        BaseClass::attachVolume( unstructured );
+        if ( !success ) { SuperClass::clear(); }
+    }
+    else
+    {
+        success = BaseClass::exec( object ) != NULL;
+        if ( !success ) { SuperClass::clear(); }
+        if ( m_has_owned_region )
+        {
+            const kvs::mpi::GhostCulling culling( m_comm, object, m_owned_region );
+            culling.cull( this );
+        }
+    }
+
+    if ( m_gathering )
+    {
+        kvs::mpi::ObjectGatherer gatherer( m_comm );
+        gatherer.gather( this );
+    }
+
+    if ( !success )
+    {
+        kvsMessageError( "Cannot generate the particles on rank %d.", m_comm.rank() );
+        return NULL;
+    }
+
+    return this;
+}
+
+} // end of namespace mpi
+
+} // end of namespace kvs
@@ -0,0 +1,76 @@
+/*****************************************************************************/
+/**
+ *  @file   CellByCellUniformSampling.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/CellByCellUniformSampling>
+#include <kvs/mpi/Communicator>
+#include <kvs/mpi/VolumePartitioner>
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Cell-by-cell particle generation class for the domain-decomposed volume.
+ *
+ *  The particles are generated from the partition of the calling rank with
+ *  kvs::CellByCellUniformSampling. If the owned region of the partition is
+ *  specified, the particles are generated only in the owned region; the
+ *  particles in the ghost region of the structured partition are culled, and
+ *  the owned cells of the unstructured partition are sampled. If the
+ *  gathering is enabled, the point objects of all of the ranks are gathered
+ *  on the root rank.
+ */
+/*===========================================================================*/
+class CellByCellUniformSampling : public kvs::CellByCellUniformSampling
+{
+    kvsModule( kvs::mpi::CellByCellUniformSampling, Mapper );
+    kvsModuleBaseClass( kvs::CellByCellUniformSampling );
+    kvsModuleSuperClass( kvs::PointObject );
+
+private:
+    kvs::mpi::Communicator m_comm; ///< MPI communicator
+    bool m_has_owned_region; ///< true if the owned region is specified
+    kvs::mpi::VolumePartitioner::OwnedRegion m_owned_region; ///< owned region
+    bool m_gathering; ///< if true, the objects are gathered on the root rank
+
+public:
+    CellByCellUniformSampling( const kvs::mpi::Communicator& comm );
+    CellByCellUniformSampling(
+        const kvs::mpi::Communicator& comm,
+        const kvs::VolumeObjectBase* volume,
+        const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+        const size_t repetition_level,
+        const float sampling_step,
+        const kvs::TransferFunction& transfer_function,
+        const float object_depth = 0.0f );
+    CellByCellUniformSampling(
+        const kvs::mpi::Communicator& comm,
+        const kvs::Camera* camera,
+        const kvs::VolumeObjectBase* volume,
+        const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+        const size_t repetition_level,
+        const float sampling_step,
+        const kvs::TransferFunction& transfer_function,
+        const float object_depth = 0.0f );
+
+    const kvs::mpi::VolumePartitioner::OwnedRegion& ownedRegion() const { return m_owned_region; }
+    bool isEnabledGathering() const { return m_gathering; }
+
+    void setOwnedRegion( const kvs::mpi::VolumePartitioner::OwnedRegion& region );
+    void setEnabledGathering( const bool enable ) { m_gathering = enable; }
+    void enableGathering() { this->setEnabledGathering( true ); }
+    void disableGathering() { this->setEnabledGathering( false ); }
+
+    SuperClass* exec( const kvs::ObjectBase* object );
+};
+
+} // end of namespace mpi
+
+} // end of namespace kvs
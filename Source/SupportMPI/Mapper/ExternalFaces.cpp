@@ -0,0 +1,263 @@
+/*****************************************************************************/
+/**
+ *  @file   ExternalFaces.cpp
+ */
+/*****************************************************************************/
+#include "ExternalFaces.h"
+#include "GhostCulling.h"
+#include "ObjectGatherer.h"
+#include <kvs/Message>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/ValueArray>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Face key given by the sorted vertex coordinates.
+ */
+/*===========================================================================*/
+struct FaceKey
+{
+    kvs::Real32 coords[12];
+    bool operator < ( const FaceKey& other ) const
+    {
+        return std::lexicographical_compare( coords, coords + 12, other.coords, other.coords + 12 );
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the key of the polygon.
+ *  @param  polygon [in] pointer to the (non-indexed) polygon object
+ *  @param  index [in] polygon index
+ *  @return face key
+ */
+/*===========================================================================*/
+FaceKey MakeFaceKey( const kvs::PolygonObject* polygon, const size_t index )
+{
+    const size_t nvertices = static_cast<size_t>( polygon->polygonType() );
+    const kvs::Real32* coords = polygon->coords().data() + 3 * nvertices * index;
+
+    std::vector<kvs::Vec3> vertices( nvertices );
+    for ( size_t i = 0; i < nvertices; i++ ) { vertices[i] = kvs::Vec3( coords + 3 * i ); }
+    std::sort( vertices.begin(), vertices.end(), [] ( const kvs::Vec3& a, const kvs::Vec3& b )
+    {
+        return std::lexicographical_compare( a.data(), a.data() + 3, b.data(), b.data() + 3 );
+    } );
+
+    FaceKey key;
+    std::fill( key.coords, key.coords + 12, 0.0f );
+    for ( size_t i = 0; i < nvertices; i++ )
+    {
+        for ( size_t c = 0; c < 3; c++ ) { key.coords[ 3 * i + c ] = vertices[i][c]; }
+    }
+    return key;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the array with the attributes of the selected polygons.
+ *  @param  values [in] value array (per-vertex, per-polygon or single value)
+ *  @param  mask [in] selection mask of the polygons
+ *  @param  nselected [in] number of the selected polygons
+ *  @return selected value array
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::ValueArray<T> SelectPolygons(
+    const kvs::ValueArray<T>& values,
+    const std::vector<bool>& mask,
+    const size_t nselected )
+{
+    const size_t npolygons = mask.size();
+    if ( npolygons == 0 || values.size() < npolygons || values.size() % npolygons != 0 ) { return values; }
+
+    const size_t stride = values.size() / npolygons;
+    kvs::ValueArray<T> result( stride * nselected );
+    size_t index = 0;
+    for ( size_t i = 0; i < npolygons; i++ )
+    {
+        if ( !mask[i] ) { continue; }
+        std::copy( values.data() + stride * i, values.data() + stride * ( i + 1 ), result.data() + stride * index );
+        index++;
+    }
+    return result;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new ExternalFaces class.
+ *  @param  comm [in] MPI communicator
+ */
+/*===========================================================================*/
+ExternalFaces::ExternalFaces( const kvs::mpi::Communicator& comm ):
+    m_comm( comm ),
+    m_has_owned_region( false ),
+    m_gathering( false )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs and creates a polygon object.
+ *  @param  comm [in] MPI communicator
+ *  @param  volume [in] pointer to the partition of the volume object
+ *  @param  region [in] region owned by the rank
+ */
+/*===========================================================================*/
+ExternalFaces::ExternalFaces(
+    const kvs::mpi::Communicator& comm,
+    const kvs::VolumeObjectBase* volume,
+    const kvs::mpi::VolumePartitioner::OwnedRegion& region ):
+    m_comm( comm ),
+    m_has_owned_region( false ),
+    m_gathering( false )
+{
+    this->setOwnedRegion( region );
+    this->exec( volume );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs and creates a polygon object.
+ *  @param  comm [in] MPI communicator
+ *  @param  volume [in] pointer to the partition of the volume object
+ *  @param  region [in] region owned by the rank
+ *  @param  transfer_function [in] transfer function
+ */
+/*===========================================================================*/
+ExternalFaces::ExternalFaces(
+    const kvs::mpi::Communicator& comm,
+    const kvs::VolumeObjectBase* volume,
+    const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+    const kvs::TransferFunction& transfer_function ):
+    m_comm( comm ),
+    m_has_owned_region( false ),
+    m_gathering( false )
+{
+    BaseClass::setTransferFunction( transfer_function );
+    this->setOwnedRegion( region );
+    this->exec( volume );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the region owned by the rank.
+ *  @param  region [in] owned region given by kvs::mpi::VolumePartitioner
+ */
+/*===========================================================================*/
+void ExternalFaces::setOwnedRegion( const kvs::mpi::VolumePartitioner::OwnedRegion& region )
+{
+    m_owned_region = region;
+    m_has_owned_region = true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the mapper process.
+ *  @param  object [in] pointer to the partition of the volume object
+ *  @return pointer to the polygon object
+ *
+ *  This method is collective if the owned region of the structured partition
+ *  is specified or the gathering is enabled.
+ */
+/*===========================================================================*/
+ExternalFaces::SuperClass* ExternalFaces::exec( const kvs::ObjectBase* object )
+{
+    // The collective processes are entered even if the extraction fails on
+    // the rank, so that the other ranks are not blocked. The failing rank
+    // contributes no polygons, and the error is reported after the gathering.
+    bool success = false;
+    const kvs::UnstructuredVolumeObject* unstructured = kvs::UnstructuredVolumeObject::DownCast( object );
+    if ( unstructured && m_has_owned_region )
+    {
+        success = this->remove_seam_faces( unstructured );
+        if ( !success ) { SuperClass::clear(); }
+    }
+    else
+    {
+        success = BaseClass::exec( object ) != NULL;
+        if ( !success ) { SuperClass::clear(); }
+        if ( m_has_owned_region )
+        {
+            const kvs::mpi::GhostCulling culling( m_comm, object, m_owned_region );
+            culling.cull( this, true );
+        }
+    }
+
+    if ( m_gathering )
+    {
+        kvs::mpi::ObjectGatherer gatherer( m_comm );
+        gatherer.gather( this );
+    }
+
+    if ( !success )
+    {
+        kvsMessageError( "Cannot extract the external faces on rank %d.", m_comm.rank() );
+        return NULL;
+    }
+
+    return this;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Extracts the external faces of the owned cells excluding the seams.
+ *  @param  volume [in] pointer to the unstructured partition with ghost cells
+ *  @return true if the process is done successfully
+ */
+/*===========================================================================*/
+bool ExternalFaces::remove_seam_faces( const kvs::UnstructuredVolumeObject* volume )
+{
+    // External faces of the partition including the ghost cells.
+    if ( !BaseClass::exec( volume ) ) { return false; }
+    std::set< ::FaceKey > external_faces;
+    const size_t nexternal_faces = SuperClass::numberOfVertices() / SuperClass::polygonType();
+    for ( size_t i = 0; i < nexternal_faces; i++ ) { external_faces.insert( ::MakeFaceKey( this, i ) ); }
+
+    // External faces of the owned cells. The faces shared with the ghost cells
+    // are on the seams of the partitions.
+    kvs::UnstructuredVolumeObject owned;
+    kvs::mpi::GhostCulling::OwnedCells( volume, m_owned_region, &owned );
+    const bool success = BaseClass::exec( &owned ) != NULL;
+    BaseClass::attachVolume( volume );
+    if ( !success ) { return false; }
+
+    const size_t nfaces = SuperClass::numberOfVertices() / SuperClass::polygonType();
+    std::vector<bool> mask( nfaces, false );
+    size_t nselected = 0;
+    for ( size_t i = 0; i < nfaces; i++ )
+    {
+        mask[i] = external_faces.find( ::MakeFaceKey( this, i ) ) != external_faces.end();
+        if ( mask[i] ) { nselected++; }
+    }
+
+    if ( nselected == nfaces ) { return true; }
+
+    SuperClass::setCoords( ::SelectPolygons( SuperClass::coords(), mask, nselected ) );
+    SuperClass::setColors( ::SelectPolygons( SuperClass::colors(), mask, nselected ) );
+    SuperClass::setNormals( ::SelectPolygons( SuperClass::normals(), mask, nselected ) );
+    SuperClass::setOpacities( ::SelectPolygons( SuperClass::opacities(), mask, nselected ) );
+
+    return true;
+}
+
+} // end of namespace mpi
+
+} // end of namespace kvs
@@ -0,0 +1,74 @@
+/*****************************************************************************/
+/**
+ *  @file   ExternalFaces.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/ExternalFaces>
+#include <kvs/mpi/Communicator>
+#include <kvs/mpi/VolumePartitioner>
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  External faces extraction class for the domain-decomposed volume.
+ *
+ *  The external faces are extracted from the partition of the calling rank
+ *  with kvs::ExternalFaces. If the owned region of the partition is
+ *  specified, the faces on the seams of the partitions are removed so that
+ *  only the external faces of the whole volume remain. For the structured
+ *  partition, the faces are culled with the interior of the owned region.
+ *  For the unstructured partition, the external faces of the owned cells
+ *  which are also external in the partition with the ghost cells are kept,
+ *  so that at least one ghost layer is required to remove the seam faces. If
+ *  the gathering is enabled, the polygon objects of all of the ranks are
+ *  gathered and merged on the root rank.
+ */
+/*===========================================================================*/
+class ExternalFaces : public kvs::ExternalFaces
+{
+    kvsModule( kvs::mpi::ExternalFaces, Mapper );
+    kvsModuleBaseClass( kvs::ExternalFaces );
+    kvsModuleSuperClass( kvs::PolygonObject );
+
+private:
+    kvs::mpi::Communicator m_comm; ///< MPI communicator
+    bool m_has_owned_region; ///< true if the owned region is specified
+    kvs::mpi::VolumePartitioner::OwnedRegion m_owned_region; ///< owned region
+    bool m_gathering; ///< if true, the objects are gathered on the root rank
+
+public:
+    ExternalFaces( const kvs::mpi::Communicator& comm );
+    ExternalFaces(
+        const kvs::mpi::Communicator& comm,
+        const kvs::VolumeObjectBase* volume,
+        const kvs::mpi::VolumePartitioner::OwnedRegion& region );
+    ExternalFaces(
+        const kvs::mpi::Communicator& comm,
+        const kvs::VolumeObjectBase* volume,
+        const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+        const kvs::TransferFunction& transfer_function );
+
+    const kvs::mpi::VolumePartitioner::OwnedRegion& ownedRegion() const { return m_owned_region; }
+    bool isEnabledGathering() const { return m_gathering; }
+
+    void setOwnedRegion( const kvs::mpi::VolumePartitioner::OwnedRegion& region );
+    void setEnabledGathering( const bool enable ) { m_gathering = enable; }
+    void enableGathering() { this->setEnabledGathering( true ); }
+    void disableGathering() { this->setEnabledGathering( false ); }
+
+    SuperClass* exec( const kvs::ObjectBase* object );
+
+private:
+    bool remove_seam_faces( const kvs::UnstructuredVolumeObject* volume );
+};
+
+} // end of namespace mpi
+
+} // end of namespace kvs
@@ -0,0 +1,295 @@
+/*****************************************************************************/
+/**
+ *  @file   GhostCulling.cpp
+ */
+/*****************************************************************************/
+#include "GhostCulling.h"
+#include <kvs/ValueArray>
+#include <kvs/Math>
+#include <vector>
+#include <cfloat>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the array with the elements selected by the index map.
+ *  @param  values [in] value array (ncomponents values per element)
+ *  @param  ncomponents [in] number of components per element
+ *  @param  index_map [in] new index of each element (-1 if removed)
+ *  @param  nelements [in] number of the selected elements
+ *  @return selected value array
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::ValueArray<T> Select(
+    const kvs::ValueArray<T>& values,
+    const size_t ncomponents,
+    const std::vector<int>& index_map,
+    const size_t nelements )
+{
+    kvs::ValueArray<T> result( nelements * ncomponents );
+    for ( size_t i = 0; i < index_map.size(); i++ )
+    {
+        if ( index_map[i] < 0 ) { continue; }
+        const size_t index = static_cast<size_t>( index_map[i] );
+        for ( size_t c = 0; c < ncomponents; c++ )
+        {
+            result[ ncomponents * index + c ] = values[ ncomponents * i + c ];
+        }
+    }
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the array selected per-vertex or per-polygon by its size.
+ *  @param  values [in] value array
+ *  @param  ncomponents [in] number of components per element
+ *  @param  vertex_map [in] new index of each vertex
+ *  @param  nvertices [in] number of the selected vertices
+ *  @param  polygon_map [in] new index of each polygon
+ *  @param  npolygons [in] number of the selected polygons
+ *  @return selected value array (the array is returned as is if it has a single value)
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::ValueArray<T> SelectBySize(
+    const kvs::ValueArray<T>& values,
+    const size_t ncomponents,
+    const std::vector<int>& vertex_map,
+    const size_t nvertices,
+    const std::vector<int>& polygon_map,
+    const size_t npolygons )
+{
+    const size_t nelements = values.size() / ncomponents;
+    if ( nelements == vertex_map.size() ) { return Select( values, ncomponents, vertex_map, nvertices ); }
+    if ( nelements == polygon_map.size() ) { return Select( values, ncomponents, polygon_map, npolygons ); }
+    return values;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the owned cells of the unstructured partition to the object.
+ *  @param  partition [in] pointer to the partition (with ghost cells)
+ *  @param  region [in] region owned by the rank
+ *  @param  owned [out] pointer to the object sharing the owned cells
+ */
+/*===========================================================================*/
+void GhostCulling::OwnedCells(
+    const kvs::UnstructuredVolumeObject* partition,
+    const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+    kvs::UnstructuredVolumeObject* owned )
+{
+    owned->shallowCopy( *partition );
+
+    const size_t ncells = kvs::Math::Min( region.ncells, partition->numberOfCells() );
+    if ( ncells == partition->numberOfCells() ) { return; }
+
+    const size_t nnodes_per_cell = partition->numberOfCellNodes();
+    const kvs::ValueArray<kvs::UInt32>& connections = partition->connections();
+    owned->setNumberOfCells( ncells );
+    owned->setConnections( kvs::ValueArray<kvs::UInt32>( connections.data(), ncells * nnodes_per_cell ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new GhostCulling class.
+ *  @param  comm [in] MPI communicator
+ *  @param  partition [in] pointer to the partition (with ghost layers, or NULL)
+ *  @param  region [in] region owned by the rank
+ */
+/*===========================================================================*/
+GhostCulling::GhostCulling(
+    const kvs::mpi::Communicator& comm,
+    const kvs::ObjectBase* partition,
+    const kvs::mpi::VolumePartitioner::OwnedRegion& region ):
+    m_min_coord( region.min_coord ),
+    m_max_coord( region.max_coord ),
+    m_whole( true )
+{
+    // Owned region in the external coordinate system which is common to all
+    // of the partitions. The rank without the partition (e.g. the mapper
+    // failed on the rank) takes part in the reduction with an empty region.
+    kvs::Real32 local_min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    kvs::Real32 local_max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    if ( partition )
+    {
+        const kvs::Vec3 min_obj = partition->minObjectCoord();
+        const kvs::Vec3 max_obj = partition->maxObjectCoord();
+        const kvs::Vec3 min_ext = partition->minExternalCoord();
+        const kvs::Vec3 max_ext = partition->maxExternalCoord();
+        for ( int a = 0; a < 3; a++ )
+        {
+            const float diff = max_obj[a] - min_obj[a];
+            const float scale = kvs::Math::IsZero( diff ) ? 1.0f : ( max_ext[a] - min_ext[a] ) / diff;
+            local_min[a] = min_ext[a] + ( m_min_coord[a] - min_obj[a] ) * scale;
+            local_max[a] = min_ext[a] + ( m_max_coord[a] - min_obj[a] ) * scale;
+            if ( m_min_coord[a] > min_obj[a] || m_max_coord[a] < max_obj[a] ) { m_whole = false; }
+        }
+    }
+
+    kvs::mpi::Communicator world( comm );
+    kvs::Real32 global_min[3];
+    kvs::Real32 global_max[3];
+    world.allReduce( local_min, global_min, 3, MPI_MIN );
+    world.allReduce( local_max, global_max, 3, MPI_MAX );
+
+    for ( int a = 0; a < 3; a++ )
+    {
+        const float epsilon = 1.0e-5f * kvs::Math::Max( global_max[a] - global_min[a], 1.0f );
+        m_min_boundary[a] = local_min[a] - global_min[a] <= epsilon;
+        m_max_boundary[a] = global_max[a] - local_max[a] <= epsilon;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the coordinate is in the half-open owned region.
+ *  @param  coord [in] coordinate in the object coordinate system of the partition
+ *  @return true if the coordinate is owned by the rank
+ */
+/*===========================================================================*/
+bool GhostCulling::contains( const kvs::Vec3& coord ) const
+{
+    for ( int a = 0; a < 3; a++ )
+    {
+        if ( coord[a] < m_min_coord[a] ) { return false; }
+        if ( m_max_boundary[a] ? coord[a] > m_max_coord[a] : coord[a] >= m_max_coord[a] ) { return false; }
+    }
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the coordinate is inside the owned region.
+ *  @param  coord [in] coordinate in the object coordinate system of the partition
+ *  @return true if the coordinate is in the owned region excluding the seams
+ *
+ *  The region is open on the seams between the partitions and is closed on
+ *  the boundary of the whole domain, which is used for the external faces.
+ */
+/*===========================================================================*/
+bool GhostCulling::containsInterior( const kvs::Vec3& coord ) const
+{
+    for ( int a = 0; a < 3; a++ )
+    {
+        if ( m_min_boundary[a] ? coord[a] < m_min_coord[a] : coord[a] <= m_min_coord[a] ) { return false; }
+        if ( m_max_boundary[a] ? coord[a] > m_max_coord[a] : coord[a] >= m_max_coord[a] ) { return false; }
+    }
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Removes the polygons which are not owned by the rank.
+ *  @param  polygon [in/out] pointer to the polygon object
+ *  @param  interior [in] if true, the polygons on the seams are also removed
+ */
+/*===========================================================================*/
+void GhostCulling::cull( kvs::PolygonObject* polygon, const bool interior ) const
+{
+    const size_t nvertices_per_polygon = static_cast<size_t>( polygon->polygonType() );
+    const kvs::ValueArray<kvs::Real32>& coords = polygon->coords();
+    const kvs::ValueArray<kvs::UInt32>& connections = polygon->connections();
+    const bool indexed = connections.size() > 0;
+    const size_t nvertices = coords.size() / 3;
+    if ( nvertices == 0 ) { return; }
+    if ( m_whole && !interior ) { return; }
+
+    const size_t npolygons = ( indexed ? connections.size() : nvertices ) / nvertices_per_polygon;
+
+    std::vector<int> polygon_map( npolygons, -1 );
+    std::vector<int> vertex_map( nvertices, -1 );
+    size_t nselected_polygons = 0;
+    size_t nselected_vertices = 0;
+    for ( size_t i = 0; i < npolygons; i++ )
+    {
+        kvs::Vec3 centroid = kvs::Vec3::Zero();
+        for ( size_t j = 0; j < nvertices_per_polygon; j++ )
+        {
+            const size_t id = indexed ? connections[ nvertices_per_polygon * i + j ] : nvertices_per_polygon * i + j;
+            centroid += kvs::Vec3( coords.data() + 3 * id );
+        }
+        centroid /= static_cast<float>( nvertices_per_polygon );
+
+        const bool owned = interior ? this->containsInterior( centroid ) : this->contains( centroid );
+        if ( !owned ) { continue; }
+
+        polygon_map[i] = static_cast<int>( nselected_polygons++ );
+        for ( size_t j = 0; j < nvertices_per_polygon; j++ )
+        {
+            const size_t id = indexed ? connections[ nvertices_per_polygon * i + j ] : nvertices_per_polygon * i + j;
+            if ( vertex_map[id] < 0 ) { vertex_map[id] = static_cast<int>( nselected_vertices++ ); }
+        }
+    }
+
+    if ( nselected_polygons == npolygons ) { return; }
+
+    if ( indexed )
+    {
+        kvs::ValueArray<kvs::UInt32> selected_connections( nselected_polygons * nvertices_per_polygon );
+        for ( size_t i = 0; i < npolygons; i++ )
+        {
+            if ( polygon_map[i] < 0 ) { continue; }
+            for ( size_t j = 0; j < nvertices_per_polygon; j++ )
+            {
+                const size_t id = connections[ nvertices_per_polygon * i + j ];
+                selected_connections[ nvertices_per_polygon * polygon_map[i] + j ] = static_cast<kvs::UInt32>( vertex_map[id] );
+            }
+        }
+        polygon->setConnections( selected_connections );
+    }
+
+    polygon->setCoords( ::Select( coords, 3, vertex_map, nselected_vertices ) );
+    polygon->setColors( ::SelectBySize( polygon->colors(), 3, vertex_map, nselected_vertices, polygon_map, nselected_polygons ) );
+    polygon->setNormals( ::SelectBySize( polygon->normals(), 3, vertex_map, nselected_vertices, polygon_map, nselected_polygons ) );
+    polygon->setOpacities( ::SelectBySize( polygon->opacities(), 1, vertex_map, nselected_vertices, polygon_map, nselected_polygons ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Removes the points which are not owned by the rank.
+ *  @param  point [in/out] pointer to the point object
+ */
+/*===========================================================================*/
+void GhostCulling::cull( kvs::PointObject* point ) const
+{
+    if ( m_whole ) { return; }
+
+    const kvs::ValueArray<kvs::Real32>& coords = point->coords();
+    const size_t nvertices = coords.size() / 3;
+
+    std::vector<int> vertex_map( nvertices, -1 );
+    size_t nselected_vertices = 0;
+    for ( size_t i = 0; i < nvertices; i++ )
+    {
+        if ( this->contains( kvs::Vec3( coords.data() + 3 * i ) ) )
+        {
+            vertex_map[i] = static_cast<int>( nselected_vertices++ );
+        }
+    }
+
+    if ( nselected_vertices == nvertices ) { return; }
+
+    const std::vector<int> no_polygons;
+    point->setCoords( ::Select( coords, 3, vertex_map, nselected_vertices ) );
+    point->setColors( ::SelectBySize( point->colors(), 3, vertex_map, nselected_vertices, no_polygons, 0 ) );
+    point->setNormals( ::SelectBySize( point->normals(), 3, vertex_map, nselected_vertices, no_polygons, 0 ) );
+    point->setSizes( ::SelectBySize( point->sizes(), 1, vertex_map, nselected_vertices, no_polygons, 0 ) );
+}
+
+} // end of namespace mpi
+
+} // end of namespace kvs
@@ -0,0 +1,70 @@
+/*****************************************************************************/
+/**
+ *  @file   GhostCulling.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/mpi/Communicator>
+#include <kvs/mpi/VolumePartitioner>
+#include <kvs/ObjectBase>
+#include <kvs/PolygonObject>
+#include <kvs/PointObject>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/Vector3>
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Culling of the primitives generated in the ghost region.
+ *
+ *  The primitives (polygons and points) extracted from a partition with ghost
+ *  layers are culled with the region owned by the rank. A primitive is owned
+ *  if its centroid is in the half-open owned region [min, max), where the max.
+ *  side is closed on the boundary of the whole domain, so that a primitive
+ *  generated on the seam of the partitions is kept by exactly one rank. The
+ *  construction is collective since the boundary of the whole domain is
+ *  determined with the owned regions of all of the ranks. If the partition has
+ *  no ghost layers, the primitives are not culled except for the faces on the
+ *  seams, since no primitive is generated twice.
+ *
+ *  For the unstructured partition, the owned cells are stored before the
+ *  ghost cells, and the mappers can be applied to the owned cells only.
+ */
+/*===========================================================================*/
+class GhostCulling
+{
+private:
+    kvs::Vec3 m_min_coord; ///< min. coord of the owned region (object coord)
+    kvs::Vec3 m_max_coord; ///< max. coord of the owned region (object coord)
+    bool m_min_boundary[3]; ///< true if the min. side is on the domain boundary
+    bool m_max_boundary[3]; ///< true if the max. side is on the domain boundary
+    bool m_whole; ///< true if the owned region covers the whole partition
+
+public:
+    static void OwnedCells(
+        const kvs::UnstructuredVolumeObject* partition,
+        const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+        kvs::UnstructuredVolumeObject* owned );
+
+public:
+    GhostCulling(
+        const kvs::mpi::Communicator& comm,
+        const kvs::ObjectBase* partition,
+        const kvs::mpi::VolumePartitioner::OwnedRegion& region );
+
+    bool contains( const kvs::Vec3& coord ) const;
+    bool containsInterior( const kvs::Vec3& coord ) const;
+
+    void cull( kvs::PolygonObject* polygon, const bool interior = false ) const;
+    void cull( kvs::PointObject* point ) const;
+};
+
+} // end of namespace mpi
+
+} // end of namespace kvs
@@ -0,0 +1,65 @@
+/*****************************************************************************/
+/**
+ *  @file   MarchingCubes.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/MarchingCubes>
+#include <kvs/mpi/Communicator>
+#include <kvs/mpi/VolumePartitioner>
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Marching cubes class for the domain-decomposed volume.
+ *
+ *  The isosurfaces are extracted from the partition of the calling rank with
+ *  kvs::MarchingCubes. If the owned region of the partition is specified, the
+ *  triangles generated in the ghost region are culled so that each triangle
+ *  is owned by exactly one rank. If the gathering is enabled, the polygon
+ *  objects of all of the ranks are gathered and merged on the root rank.
+ */
+/*===========================================================================*/
+class MarchingCubes : public kvs::MarchingCubes
+{
+    kvsModule( kvs::mpi::MarchingCubes, Mapper );
+    kvsModuleBaseClass( kvs::MarchingCubes );
+    kvsModuleSuperClass( kvs::PolygonObject );
+
+private:
+    kvs::mpi::Communicator m_comm; ///< MPI communicator
+    bool m_has_owned_region; ///< true if the owned region is specified
+    kvs::mpi::VolumePartitioner::OwnedRegion m_owned_region; ///< owned region
+    bool m_gathering; ///< if true, the objects are gathered on the root rank
+
+public:
+    MarchingCubes( const kvs::mpi::Communicator& comm );
+    MarchingCubes(
+        const kvs::mpi::Communicator& comm,
+        const kvs::StructuredVolumeObject* volume,
+        const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+        const double isolevel,
+        const SuperClass::NormalType normal_type,
+        const bool duplication,
+        const kvs::TransferFunction& transfer_function );
+
+    const kvs::mpi::VolumePartitioner::OwnedRegion& ownedRegion() const { return m_owned_region; }
+    bool isEnabledGathering() const { return m_gathering; }
+
+    void setOwnedRegion( const kvs::mpi::VolumePartitioner::OwnedRegion& region );
+    void setEnabledGathering( const bool enable ) { m_gathering = enable; }
+    void enableGathering() { this->setEnabledGathering( true ); }
+    void disableGathering() { this->setEnabledGathering( false ); }
+
+    SuperClass* exec( const kvs::ObjectBase* object );
+};
+
+} // end of namespace mpi
+
+} // end of namespace kvs
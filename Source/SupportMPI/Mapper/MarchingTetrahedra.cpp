@@ -0,0 +1,121 @@
+/*****************************************************************************/
+/**
+ *  @file   MarchingTetrahedra.cpp
+ */
+/*****************************************************************************/
+#include "MarchingTetrahedra.h"
+#include "GhostCulling.h"
+#include "ObjectGatherer.h"
+#include <kvs/Message>
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new MarchingTetrahedra class.
+ *  @param  comm [in] MPI communicator
+ */
+/*===========================================================================*/
+MarchingTetrahedra::MarchingTetrahedra( const kvs::mpi::Communicator& comm ):
+    m_comm( comm ),
+    m_has_owned_region( false ),
+    m_gathering( false )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs and creates a polygon object.
+ *  @param  comm [in] MPI communicator
+ *  @param  volume [in] pointer to the partition of the volume object
+ *  @param  region [in] region owned by the rank
+ *  @param  isolevel [in] level of the isosurfaces
+ *  @param  normal_type [in] type of the normal vector
+ *  @param  duplication [in] duplication flag
+ *  @param  transfer_function [in] transfer function
+ */
+/*===========================================================================*/
+MarchingTetrahedra::MarchingTetrahedra(
+    const kvs::mpi::Communicator& comm,
+    const kvs::UnstructuredVolumeObject* volume,
+    const kvs::mpi::VolumePartitioner::OwnedRegion& region,
+    const double isolevel,
+    const SuperClass::NormalType normal_type,
+    const bool duplication,
+    const kvs::TransferFunction& transfer_function ):
+    m_comm( comm ),
+    m_has_owned_region( false ),
+    m_gathering( false )
+{
+    BaseClass::setTransferFunction( transfer_function );
+    BaseClass::setIsolevel( isolevel );
+    BaseClass::setDuplication( duplication );
+    SuperClass::setNormalType( normal_type );
+    this->setOwnedRegion( region );
+    this->exec( volume );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the region owned by the rank.
+ *  @param  region [in] owned region given by kvs::mpi::VolumePartitioner
+ */
+/*===========================================================================*/
+void MarchingTetrahedra::setOwnedRegion( const kvs::mpi::VolumePartitioner::OwnedRegion& region )
+{
+    m_owned_region = region;
+    m_has_owned_region = true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the mapper process.
+ *  @param  object [in] pointer to the partition of the volume object
+ *  @return pointer to the polygon object
+ *
+ *  This method is collective if the gathering is enabled.
+ */
+/*===========================================================================*/
+MarchingTetrahedra::SuperClass* MarchingTetrahedra::exec( const kvs::ObjectBase* object )
+{
+    // The collective processes are entered even if the extraction fails on
+    // the rank, so that the other ranks are not blocked. The failing rank
+    // contributes no polygons, and the error is reported after the gathering.
+    bool success = false;
+    const kvs::UnstructuredVolumeObject* volume = kvs::UnstructuredVolumeObject::DownCast( object );
+    if ( !volume || !m_has_owned_region )
+    {
+        success = BaseClass::exec( object ) != NULL;
+    }
+    else
+    {
+        kvs::UnstructuredVolumeObject owned;
+        kvs::mpi::GhostCulling::OwnedCells( volume, m_owned_region, &owned );
+        success = BaseClass::exec( &owned ) != NULL;
+        BaseClass::attachVolume( volume );
+    }
+    if ( !success ) { SuperClass::clear(); }
+
+    if ( m_gathering )
+    {
+        kvs::mpi::ObjectGatherer gatherer( m_comm );
+        gatherer.gather( this );
+    }
+
+    if ( !success )
+    {
+        kvsMessageError( "Cannot extract the isosurfaces on rank %d.", m_comm.rank() );
+        return NULL;
+    }
+
+    return this;
+}
+
+} // end of namespace mpi
+
+} // end of namespace kvs
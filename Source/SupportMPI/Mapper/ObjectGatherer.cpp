@@ -0,0 +1,409 @@
+/*****************************************************************************/
+/**
+ *  @file   ObjectGatherer.cpp
+ */
+/*****************************************************************************/
+#include "ObjectGatherer.h"
+#include <kvs/ValueArray>
+#include <kvs/Vector3>
+#include <kvs/Math>
+#include <map>
+#include <vector>
+#include <cmath>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the coordinates transformed into the external coordinate system.
+ *  @param  object [in] pointer to the object
+ *  @return transformed coordinate array
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::Real32> ExternalCoords( const kvs::GeometryObjectBase* object )
+{
+    const kvs::ValueArray<kvs::Real32>& coords = object->coords();
+    if ( !object->hasMinMaxObjectCoords() || !object->hasMinMaxExternalCoords() ) { return coords; }
+
+    const kvs::Vec3 min_obj = object->minObjectCoord();
+    const kvs::Vec3 max_obj = object->maxObjectCoord();
+    const kvs::Vec3 min_ext = object->minExternalCoord();
+    const kvs::Vec3 max_ext = object->maxExternalCoord();
+    kvs::Vec3 scale;
+    for ( int a = 0; a < 3; a++ )
+    {
+        const float diff = max_obj[a] - min_obj[a];
+        scale[a] = kvs::Math::IsZero( diff ) ? 1.0f : ( max_ext[a] - min_ext[a] ) / diff;
+    }
+
+    kvs::ValueArray<kvs::Real32> result( coords.size() );
+    for ( size_t i = 0; i < coords.size(); i++ )
+    {
+        const int a = static_cast<int>( i % 3 );
+        result[i] = min_ext[a] + ( coords[i] - min_obj[a] ) * scale[a];
+    }
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the array which has the attribute for every element.
+ *  @param  values [in] value array (single value or a value per element)
+ *  @param  ncomponents [in] number of components per element
+ *  @param  nelements [in] number of elements
+ *  @return expanded value array (empty if the size is mismatched)
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::ValueArray<T> Expand( const kvs::ValueArray<T>& values, const size_t ncomponents, const size_t nelements )
+{
+    if ( values.size() == ncomponents * nelements ) { return values; }
+    if ( values.size() != ncomponents ) { return kvs::ValueArray<T>(); }
+
+    kvs::ValueArray<T> result( ncomponents * nelements );
+    for ( size_t i = 0; i < nelements; i++ )
+    {
+        for ( size_t c = 0; c < ncomponents; c++ ) { result[ ncomponents * i + c ] = values[c]; }
+    }
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Index of the cell used as the key for merging vertices.
+ */
+/*===========================================================================*/
+struct VertexKey
+{
+    long long x, y, z;
+    bool operator < ( const VertexKey& other ) const
+    {
+        if ( x != other.x ) { return x < other.x; }
+        if ( y != other.y ) { return y < other.y; }
+        return z < other.z;
+    }
+};
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new ObjectGatherer class.
+ *  @param  comm [in] MPI communicator
+ */
+/*===========================================================================*/
+ObjectGatherer::ObjectGatherer( const kvs::mpi::Communicator& comm ):
+    m_comm( comm ),
+    m_vertex_merging( true ),
+    m_tolerance( 1.0e-5f )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Gathers the polygon objects on the root rank.
+ *  @param  polygon [in/out] pointer to the polygon object (merged object on the root rank)
+ *  @return true if the process is done successfully
+ *
+ *  This method is collective. The polygon object on the non-root ranks is not
+ *  modified.
+ */
+/*===========================================================================*/
+bool ObjectGatherer::gather( kvs::PolygonObject* polygon )
+{
+    // The types are not set on the ranks which extracted no polygons, so the
+    // types are taken from the other ranks (the unknown types are the largest).
+    int local_types[3] = { polygon->polygonType(), polygon->colorType(), polygon->normalType() };
+    int types[3] = { 0, 0, 0 };
+    m_comm.allReduce( local_types, types, 3, MPI_MIN );
+    if ( types[0] == kvs::PolygonObject::UnknownPolygonType ) { return true; }
+    polygon->setPolygonType( kvs::PolygonObject::PolygonType( types[0] ) );
+    polygon->setColorType( kvs::PolygonObject::ColorType( types[1] ) );
+    polygon->setNormalType( kvs::PolygonObject::NormalType( types[2] ) );
+
+    const size_t nvertices_per_polygon = static_cast<size_t>( polygon->polygonType() );
+    const size_t nvertices = polygon->numberOfVertices();
+
+    // The polygons are connected with the indices if any of the ranks has the
+    // connections.
+    int local_indexed = polygon->connections().size() > 0 ? 1 : 0;
+    int indexed = 0;
+    m_comm.allReduce( local_indexed, indexed, MPI_MAX );
+
+    kvs::ValueArray<kvs::UInt32> connections = polygon->connections();
+    if ( indexed && !local_indexed )
+    {
+        connections.allocate( nvertices );
+        for ( size_t i = 0; i < nvertices; i++ ) { connections[i] = static_cast<kvs::UInt32>( i ); }
+    }
+
+    const size_t npolygons = ( indexed ? connections.size() : nvertices ) / nvertices_per_polygon;
+    const bool vertex_color = polygon->colorType() == kvs::PolygonObject::VertexColor;
+    const bool vertex_normal = polygon->normalType() == kvs::PolygonObject::VertexNormal;
+    const size_t ncolors = vertex_color ? nvertices : npolygons;
+    const size_t nnormals = vertex_normal ? nvertices : npolygons;
+
+    const kvs::ValueArray<kvs::Real32> coords = ::ExternalCoords( polygon );
+    const kvs::ValueArray<kvs::UInt8> colors = ::Expand( polygon->colors(), 3, ncolors );
+    const kvs::ValueArray<kvs::UInt8> opacities = ::Expand( polygon->opacities(), 1, ncolors );
+    const kvs::ValueArray<kvs::Real32> normals = ::Expand( polygon->normals(), 3, nnormals );
+
+    kvs::ValueArray<int> coord_counts;
+    kvs::ValueArray<int> connection_counts;
+    kvs::ValueArray<int> color_counts;
+    kvs::ValueArray<int> opacity_counts;
+    kvs::ValueArray<int> normal_counts;
+    kvs::ValueArray<kvs::Real32> all_coords;
+    kvs::ValueArray<kvs::UInt32> all_connections;
+    kvs::ValueArray<kvs::UInt8> all_colors;
+    kvs::ValueArray<kvs::UInt8> all_opacities;
+    kvs::ValueArray<kvs::Real32> all_normals;
+    const int root = m_comm.root();
+    m_comm.gather( root, coords, all_coords, coord_counts );
+    m_comm.gather( root, connections, all_connections, connection_counts );
+    m_comm.gather( root, colors, all_colors, color_counts );
+    m_comm.gather( root, opacities, all_opacities, opacity_counts );
+    m_comm.gather( root, normals, all_normals, normal_counts );
+    if ( m_comm.rank() != root ) { return true; }
+
+    // Offset the connections by the number of vertices of the preceding ranks.
+    const size_t nranks = static_cast<size_t>( m_comm.size() );
+    kvs::UInt32 vertex_offset = 0;
+    size_t connection_offset = 0;
+    for ( size_t rank = 0; rank < nranks; rank++ )
+    {
+        const size_t n = static_cast<size_t>( connection_counts[rank] );
+        for ( size_t i = 0; i < n; i++ ) { all_connections[ connection_offset + i ] += vertex_offset; }
+        connection_offset += n;
+        vertex_offset += static_cast<kvs::UInt32>( coord_counts[rank] / 3 );
+    }
+
+    // The attributes are discarded if they are missing on some ranks.
+    const size_t total_vertices = all_coords.size() / 3;
+    const size_t total_polygons = ( indexed ? all_connections.size() : total_vertices ) / nvertices_per_polygon;
+    const size_t total_colors = vertex_color ? total_vertices : total_polygons;
+    const size_t total_normals = vertex_normal ? total_vertices : total_polygons;
+    if ( all_colors.size() != 3 * total_colors ) { all_colors = kvs::ValueArray<kvs::UInt8>(); }
+    if ( all_opacities.size() != total_colors ) { all_opacities = kvs::ValueArray<kvs::UInt8>(); }
+    if ( all_normals.size() != 3 * total_normals ) { all_normals = kvs::ValueArray<kvs::Real32>(); }
+
+    polygon->setCoords( all_coords );
+    polygon->setConnections( all_connections );
+    polygon->setColors( all_colors );
+    polygon->setOpacities( all_opacities );
+    polygon->setNormals( all_normals );
+    if ( all_colors.size() == 0 ) { polygon->setColor( kvs::RGBColor::White() ); }
+    if ( all_opacities.size() == 0 ) { polygon->setOpacity( 255 ); }
+
+    if ( m_vertex_merging ) { this->merge_vertices( polygon ); }
+
+    polygon->updateMinMaxCoords();
+    polygon->setMinMaxExternalCoords( polygon->minObjectCoord(), polygon->maxObjectCoord() );
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Gathers the point objects on the root rank.
+ *  @param  point [in/out] pointer to the point object (merged object on the root rank)
+ *  @return true if the process is done successfully
+ *
+ *  This method is collective. The point object on the non-root ranks is not
+ *  modified.
+ */
+/*===========================================================================*/
+bool ObjectGatherer::gather( kvs::PointObject* point )
+{
+    const size_t nvertices = point->numberOfVertices();
+    const kvs::ValueArray<kvs::Real32> coords = ::ExternalCoords( point );
+    const kvs::ValueArray<kvs::UInt8> colors = ::Expand( point->colors(), 3, nvertices );
+    const kvs::ValueArray<kvs::Real32> normals = ::Expand( point->normals(), 3, nvertices );
+    const kvs::ValueArray<kvs::Real32> sizes = ::Expand( point->sizes(), 1, nvertices );
+
+    kvs::ValueArray<int> counts;
+    kvs::ValueArray<kvs::Real32> all_coords;
+    kvs::ValueArray<kvs::UInt8> all_colors;
+    kvs::ValueArray<kvs::Real32> all_normals;
+    kvs::ValueArray<kvs::Real32> all_sizes;
+    const int root = m_comm.root();
+    m_comm.gather( root, coords, all_coords, counts );
+    m_comm.gather( root, colors, all_colors, counts );
+    m_comm.gather( root, normals, all_normals, counts );
+    m_comm.gather( root, sizes, all_sizes, counts );
+    if ( m_comm.rank() != root ) { return true; }
+
+    const size_t total_vertices = all_coords.size() / 3;
+    if ( all_colors.size() != 3 * total_vertices ) { all_colors = kvs::ValueArray<kvs::UInt8>(); }
+    if ( all_normals.size() != 3 * total_vertices ) { all_normals = kvs::ValueArray<kvs::Real32>(); }
+    if ( all_sizes.size() != total_vertices ) { all_sizes = kvs::ValueArray<kvs::Real32>(); }
+
+    point->setCoords( all_coords );
+    point->setColors( all_colors );
+    point->setNormals( all_normals );
+    point->setSizes( all_sizes );
+    if ( all_colors.size() == 0 ) { point->setColor( kvs::RGBColor::White() ); }
+    if ( all_sizes.size() == 0 ) { point->setSize( 1.0f ); }
+
+    point->updateMinMaxCoords();
+    point->setMinMaxExternalCoords( point->minObjectCoord(), point->maxObjectCoord() );
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Merges the vertices which are within the tolerance of each other.
+ *  @param  polygon [in/out] pointer to the polygon object
+ */
+/*===========================================================================*/
+void ObjectGatherer::merge_vertices( kvs::PolygonObject* polygon ) const
+{
+    const kvs::ValueArray<kvs::Real32>& coords = polygon->coords();
+    const size_t nvertices = coords.size() / 3;
+    if ( nvertices == 0 ) { return; }
+
+    kvs::Vec3 min_coord( coords.data() );
+    kvs::Vec3 max_coord( coords.data() );
+    for ( size_t i = 1; i < nvertices; i++ )
+    {
+        const kvs::Vec3 p( coords.data() + 3 * i );
+        for ( int a = 0; a < 3; a++ )
+        {
+            min_coord[a] = kvs::Math::Min( min_coord[a], p[a] );
+            max_coord[a] = kvs::Math::Max( max_coord[a], p[a] );
+        }
+    }
+
+    const kvs::Vec3 extent = max_coord - min_coord;
+    const float length = kvs::Math::Max( extent.x(), extent.y(), extent.z() );
+    const double tolerance = kvs::Math::IsZero( length ) ? 0.0 : static_cast<double>( m_tolerance * length );
+    const double step = kvs::Math::IsZero( tolerance ) ? 1.0 : tolerance;
+
+    // The vertices are hashed into the cells whose size is the tolerance, and
+    // compared with the representative vertices in the 27 neighbouring cells,
+    // since the vertices within the tolerance can be split by a cell boundary.
+    typedef std::map< ::VertexKey, std::vector<kvs::UInt32> > Table;
+    Table table;
+    std::vector<kvs::UInt32> vertex_map( nvertices );
+    std::vector<kvs::UInt32> representatives;
+    for ( size_t i = 0; i < nvertices; i++ )
+    {
+        const kvs::Real32* p = coords.data() + 3 * i;
+        const ::VertexKey key = {
+            static_cast<long long>( std::floor( ( p[0] - min_coord.x() ) / step ) ),
+            static_cast<long long>( std::floor( ( p[1] - min_coord.y() ) / step ) ),
+            static_cast<long long>( std::floor( ( p[2] - min_coord.z() ) / step ) ) };
+
+        bool found = false;
+        for ( long long dz = -1; dz <= 1 && !found; dz++ )
+        {
+            for ( long long dy = -1; dy <= 1 && !found; dy++ )
+            {
+                for ( long long dx = -1; dx <= 1 && !found; dx++ )
+                {
+                    const ::VertexKey neighbor = { key.x + dx, key.y + dy, key.z + dz };
+                    const Table::const_iterator cell = table.find( neighbor );
+                    if ( cell == table.end() ) { continue; }
+
+                    for ( size_t j = 0; j < cell->second.size(); j++ )
+                    {
+                        const kvs::UInt32 index = cell->second[j];
+                        const kvs::Real32* q = coords.data() + 3 * representatives[ index ];
+                        if ( std::fabs( static_cast<double>( p[0] - q[0] ) ) <= tolerance &&
+                             std::fabs( static_cast<double>( p[1] - q[1] ) ) <= tolerance &&
+                             std::fabs( static_cast<double>( p[2] - q[2] ) ) <= tolerance )
+                        {
+                            vertex_map[i] = index;
+                            found = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if ( !found )
+        {
+            const kvs::UInt32 index = static_cast<kvs::UInt32>( representatives.size() );
+            table[ key ].push_back( index );
+            representatives.push_back( static_cast<kvs::UInt32>( i ) );
+            vertex_map[i] = index;
+        }
+    }
+
+    const size_t nmerged = representatives.size();
+    if ( nmerged == nvertices && polygon->connections().size() > 0 ) { return; }
+
+    // Connections referring to the merged vertices.
+    kvs::ValueArray<kvs::UInt32> connections = polygon->connections();
+    if ( connections.size() == 0 )
+    {
+        connections.allocate( nvertices );
+        for ( size_t i = 0; i < nvertices; i++ ) { connections[i] = vertex_map[i]; }
+    }
+    else
+    {
+        connections = connections.clone();
+        for ( size_t i = 0; i < connections.size(); i++ ) { connections[i] = vertex_map[ connections[i] ]; }
+    }
+
+    // Per-vertex attributes of the representative vertices. The vertex normals
+    // are averaged over the merged vertices.
+    kvs::ValueArray<kvs::Real32> merged_coords( 3 * nmerged );
+    for ( size_t i = 0; i < nmerged; i++ )
+    {
+        for ( size_t c = 0; c < 3; c++ ) { merged_coords[ 3 * i + c ] = coords[ 3 * representatives[i] + c ]; }
+    }
+
+    const kvs::ValueArray<kvs::UInt8>& colors = polygon->colors();
+    if ( colors.size() == 3 * nvertices )
+    {
+        kvs::ValueArray<kvs::UInt8> merged_colors( 3 * nmerged );
+        for ( size_t i = 0; i < nmerged; i++ )
+        {
+            for ( size_t c = 0; c < 3; c++ ) { merged_colors[ 3 * i + c ] = colors[ 3 * representatives[i] + c ]; }
+        }
+        polygon->setColors( merged_colors );
+    }
+
+    const kvs::ValueArray<kvs::UInt8>& opacities = polygon->opacities();
+    if ( opacities.size() == nvertices && nvertices > 1 )
+    {
+        kvs::ValueArray<kvs::UInt8> merged_opacities( nmerged );
+        for ( size_t i = 0; i < nmerged; i++ ) { merged_opacities[i] = opacities[ representatives[i] ]; }
+        polygon->setOpacities( merged_opacities );
+    }
+
+    const kvs::ValueArray<kvs::Real32>& normals = polygon->normals();
+    if ( polygon->normalType() == kvs::PolygonObject::VertexNormal && normals.size() == 3 * nvertices )
+    {
+        std::vector<kvs::Vec3> sums( nmerged, kvs::Vec3::Zero() );
+        for ( size_t i = 0; i < nvertices; i++ ) { sums[ vertex_map[i] ] += kvs::Vec3( normals.data() + 3 * i ); }
+
+        kvs::ValueArray<kvs::Real32> merged_normals( 3 * nmerged );
+        for ( size_t i = 0; i < nmerged; i++ )
+        {
+            const double length = sums[i].length();
+            const kvs::Vec3 n = kvs::Math::IsZero( length ) ? sums[i] : sums[i] / static_cast<float>( length );
+            for ( int c = 0; c < 3; c++ ) { merged_normals[ 3 * i + c ] = n[c]; }
+        }
+        polygon->setNormals( merged_normals );
+    }
+
+    polygon->setCoords( merged_coords );
+    polygon->setConnections( connections );
+}
+
+} // end of namespace mpi
+
+} // end of namespace kvs
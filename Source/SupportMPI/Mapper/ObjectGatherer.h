@@ -0,0 +1,58 @@
+/*****************************************************************************/
+/**
+ *  @file   ObjectGatherer.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/mpi/Communicator>
+#include <kvs/PolygonObject>
+#include <kvs/PointObject>
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Gatherer of the geometry objects extracted on the ranks.
+ *
+ *  The polygon or point objects extracted from the partitions are gathered
+ *  on the root rank with kvs::mpi::Communicator::gather, and merged into a
+ *  single object. The coordinates of each object are transformed from its
+ *  object coordinate system into the external coordinate system which is
+ *  common to the partitions. For the polygon object, the duplicated vertices
+ *  on the seams of the partitions can be removed by merging the vertices
+ *  which are within the tolerance of each other.
+ */
+/*===========================================================================*/
+class ObjectGatherer
+{
+private:
+    kvs::mpi::Communicator m_comm; ///< MPI communicator
+    bool m_vertex_merging; ///< if true, the duplicated vertices are merged
+    float m_tolerance; ///< tolerance for merging vertices (relative to the bounding box)
+
+public:
+    ObjectGatherer( const kvs::mpi::Communicator& comm );
+
+    bool isEnabledVertexMerging() const { return m_vertex_merging; }
+    float tolerance() const { return m_tolerance; }
+
+    void setEnabledVertexMerging( const bool enable ) { m_vertex_merging = enable; }
+    void enableVertexMerging() { this->setEnabledVertexMerging( true ); }
+    void disableVertexMerging() { this->setEnabledVertexMerging( false ); }
+    void setTolerance( const float tolerance ) { m_tolerance = tolerance; }
+
+    bool gather( kvs::PolygonObject* polygon );
+    bool gather( kvs::PointObject* point );
+
+private:
+    void merge_vertices( kvs::PolygonObject* polygon ) const;
+};
+
+} // end of namespace mpi
+
+} // end of namespace kvs
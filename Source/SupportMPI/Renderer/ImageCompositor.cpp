@@ -20,7 +20,10 @@ ImageCompositor::ImageCompositor( const int rank, const int size, const MPI_Comm
     m_width( 0 ),
     m_height( 0 ),
     m_pixel_type( -1 ),
-    m_merge_type( -1 )
+    m_merge_type( -1 ),
+    m_sparse_composition( false ),
+    m_sparse_initialized( false ),
+    m_sparse_compositor( kvs::mpi::Communicator( comm ) )
 {
 }
 
@@ -31,7 +34,10 @@ ImageCompositor::ImageCompositor( const kvs::mpi::Communicator& comm ):
     m_width( 0 ),
     m_height( 0 ),
     m_pixel_type( -1 ),
-    m_merge_type( -1 )
+    m_merge_type( -1 ),
+    m_sparse_composition( false ),
+    m_sparse_initialized( false ),
+    m_sparse_compositor( comm )
 {
 }
 
@@ -42,12 +48,23 @@ ImageCompositor::~ImageCompositor()
 
 bool ImageCompositor::initialize( const size_t width, const size_t height, const bool enable_depth_testing )
 {
-    if ( m_width != width || m_height != height ) { this->destroy(); }
+    // The compositor set up previously is destroyed when the size or the
+    // backend (sparse-aware or 234) has been changed.
+    const bool changed =
+        m_width != width || m_height != height ||
+        m_sparse_initialized != m_sparse_composition;
+    if ( changed && !this->destroy() ) { return false; }
 
     m_width = width;
     m_height = height;
     m_pixel_type = enable_depth_testing ? ID_RGBAZ64 : ID_RGBA32;
     m_merge_type = enable_depth_testing ? DEPTH : ALPHA;
+    m_sparse_initialized = m_sparse_composition;
+    if ( m_sparse_initialized )
+    {
+        return m_sparse_compositor.initialize( m_width, m_height, enable_depth_testing );
+    }
+
     auto status = Init_234Composition( m_rank, m_size, m_width, m_height, m_pixel_type );
     if ( status == EXIT_FAILURE ) { return false; }
 
@@ -58,8 +75,13 @@ bool ImageCompositor::destroy()
 {
     if ( m_width == 0 && m_height == 0 ) { return true; }
 
-    auto status = Destroy_234Composition( m_pixel_type );
-    if ( status == EXIT_FAILURE ) { return false; }
+    // The backend recorded by initialize() is destroyed, even if the sparse
+    // composition has been enabled or disabled after that.
+    if ( !m_sparse_initialized )
+    {
+        auto status = Destroy_234Composition( m_pixel_type );
+        if ( status == EXIT_FAILURE ) { return false; }
+    }
 
     m_width = 0;
     m_height = 0;
@@ -74,6 +96,8 @@ bool ImageCompositor::run( kvs::ValueArray<kvs::UInt8>& color_buffer )
     KVS_ASSERT( m_pixel_type == ALPHA );
     KVS_ASSERT( color_buffer.size() == m_width * m_height * 4 );
 
+    if ( m_sparse_initialized ) { return m_sparse_compositor.run( color_buffer ); }
+
     auto status = Do_234Composition(
         m_rank, m_size,
         m_width, m_height,
@@ -96,6 +120,10 @@ bool ImageCompositor::run( kvs::ValueArray<kvs::UInt8>& color_buffer, const kvs:
     const bool ascending = btof; // ordering inverted???
     auto rank_list = depth_list.argsort( ascending );
 
+    // The sparse compositor blends the images in the sorted order directly,
+    // so the color buffers don't need to be exchanged in advance.
+    if ( m_sparse_initialized ) { return m_sparse_compositor.run( color_buffer, rank_list ); }
+
     // Iterator (i) to element, which includes my_rank, in rank_list
     const size_t my_rank = static_cast<size_t>( comm.rank() );
     auto i = std::find( rank_list.begin(), rank_list.end(), my_rank );
@@ -121,6 +149,8 @@ bool ImageCompositor::run( kvs::ValueArray<kvs::UInt8>& color_buffer, kvs::Value
     KVS_ASSERT( color_buffer.size() == m_width * m_height * 4 );
     KVS_ASSERT( depth_buffer.size() == m_width * m_height );
 
+    if ( m_sparse_initialized ) { return m_sparse_compositor.run( color_buffer, depth_buffer ); }
+
     auto status = Do_234ZComposition(
         m_rank, m_size,
         m_width, m_height,
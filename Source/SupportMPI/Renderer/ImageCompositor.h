@@ -2,6 +2,7 @@
 #include <kvs/mpi/Communicator>
 #include <kvs/ValueArray>
 #include <kvs/Type>
+#include "SparseImageCompositor.h"
 
 
 namespace kvs
@@ -20,12 +21,23 @@ private:
     size_t m_height; ///< image height
     unsigned int m_pixel_type; ///< pixel type (RGBA 32-bit or RGBA-Z 64-bit)
     unsigned int m_merge_type; ///< merge type (depth-testing or alpha-blending)
+    bool m_sparse_composition; ///< if true, the sparse-aware compositor is used
+    bool m_sparse_initialized; ///< true if initialize() set up the sparse-aware compositor instead of 234
+    kvs::mpi::SparseImageCompositor m_sparse_compositor; ///< sparse-aware compositor
 
 public:
     ImageCompositor( const int rank, const int size, const MPI_Comm comm = MPI_COMM_WORLD );
     ImageCompositor( const kvs::mpi::Communicator& comm );
     ~ImageCompositor();
 
+    bool isEnabledSparseComposition() const { return m_sparse_composition; }
+    const kvs::mpi::SparseImageCompositor::Stages& stages() const { return m_sparse_compositor.stages(); }
+
+    void setEnabledSparseComposition( const bool enable ) { m_sparse_composition = enable; }
+    void enableSparseComposition() { this->setEnabledSparseComposition( true ); }
+    void disableSparseComposition() { this->setEnabledSparseComposition( false ); }
+    void setNumberOfTiles( const size_t ntiles ) { m_sparse_compositor.setNumberOfTiles( ntiles ); }
+
     bool initialize( const size_t width, const size_t height, const bool enable_depth_testing = false );
     bool destroy();
     bool run( kvs::ValueArray<kvs::UInt8>& color_buffer );
@@ -0,0 +1,309 @@
+/*****************************************************************************/
+/**
+ *  @file   SortLastScreen.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/mpi/Communicator>
+#include <kvs/OffScreen>
+#include <kvs/ObjectBase>
+#include <kvs/RendererBase>
+#include <kvs/PointObject>
+#include <kvs/Bounds>
+#include <kvs/Scene>
+#include <kvs/Camera>
+#include <kvs/Background>
+#include <kvs/Coordinate>
+#include <kvs/ColorImage>
+#include <kvs/RGBColor>
+#include <kvs/ValueArray>
+#include <kvs/Math>
+#include <kvs/Value>
+#include <utility>
+#include <vector>
+#include "ImageCompositor.h"
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Sort-last distributed rendering screen.
+ *
+ *  Every rank registers its own partition of the data (see VolumePartitioner)
+ *  with any KVS renderer. When drawing, each rank renders the partition on
+ *  the off-screen buffer, reads back the color (and depth) buffer, and the
+ *  rendering images are composited with ImageCompositor. In the depth-testing
+ *  mode, the images are merged pixel-by-pixel with the depth buffers, which is
+ *  suitable for opaque geometries. Otherwise, the images are alpha-blended in
+ *  the visibility order given by the distance from the camera to the center of
+ *  each partition, which is suitable for volume rendering. The composited
+ *  frame is delivered on the root rank of the communicator.
+ *
+ *  The objects are placed in the world coordinate system consistently on all
+ *  of the ranks by registering a hidden object which has the bounding box of
+ *  all of the partitions, so registerObject() and draw() must be called
+ *  collectively.
+ */
+/*===========================================================================*/
+template <typename ScreenType = kvs::OffScreen>
+class SortLastScreen
+{
+public:
+    typedef ScreenType Screen;
+
+private:
+    kvs::mpi::Communicator m_comm; ///< MPI communicator
+    ScreenType m_screen; ///< off-screen for rendering the local partition
+    kvs::mpi::ImageCompositor m_compositor; ///< image compositor
+    bool m_depth_testing; ///< true if the images are composited with the depth test
+    bool m_initialized; ///< true if the compositor has been initialized
+    bool m_initialized_depth_testing; ///< depth testing mode at the initialization
+    size_t m_initialized_width; ///< image width at the initialization
+    size_t m_initialized_height; ///< image height at the initialization
+    kvs::RGBColor m_background_color; ///< background color of the composited frame
+    bool m_has_bounds; ///< true if the global bounding box has been registered
+    kvs::Vec3 m_min_coord; ///< min. external coord of the global bounding box
+    kvs::Vec3 m_max_coord; ///< max. external coord of the global bounding box
+    std::vector<kvs::ObjectBase*> m_objects; ///< registered local objects
+    kvs::ValueArray<kvs::UInt8> m_color_buffer; ///< composited RGBA buffer (root only)
+
+public:
+    SortLastScreen( const kvs::mpi::Communicator& comm = kvs::mpi::Communicator() ):
+        m_comm( comm ),
+        m_compositor( comm ),
+        m_depth_testing( true ),
+        m_initialized( false ),
+        m_initialized_depth_testing( true ),
+        m_initialized_width( 0 ),
+        m_initialized_height( 0 ),
+        m_background_color( kvs::RGBColor::White() ),
+        m_has_bounds( false ) {}
+
+    const kvs::mpi::Communicator& communicator() const { return m_comm; }
+    ScreenType& screen() { return m_screen; }
+    kvs::Scene* scene() { return m_screen.scene(); }
+    kvs::mpi::ImageCompositor& compositor() { return m_compositor; }
+    int width() const { return m_screen.width(); }
+    int height() const { return m_screen.height(); }
+    bool isRoot() const { return m_comm.rank() == m_comm.root(); }
+    bool isEnabledDepthTesting() const { return m_depth_testing; }
+    const kvs::RGBColor& backgroundColor() const { return m_background_color; }
+    const kvs::ValueArray<kvs::UInt8>& colorBuffer() const { return m_color_buffer; }
+
+    void setSize( const int width, const int height ) { m_screen.setSize( width, height ); }
+    void setBackgroundColor( const kvs::RGBColor& color ) { m_background_color = color; }
+    void setEnabledDepthTesting( const bool enable ) { m_depth_testing = enable; }
+    void enableDepthTesting() { this->setEnabledDepthTesting( true ); }
+    void disableDepthTesting() { this->setEnabledDepthTesting( false ); }
+    void setEnabledSparseComposition( const bool enable );
+    void enableSparseComposition() { this->setEnabledSparseComposition( true ); }
+    void disableSparseComposition() { this->setEnabledSparseComposition( false ); }
+
+    const std::pair<int,int> registerObject( kvs::ObjectBase* object, kvs::RendererBase* renderer = 0 );
+    bool draw();
+    kvs::ColorImage capture() const;
+
+private:
+    bool initialize_compositor();
+    kvs::Real32 visibility_depth();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the sparse-aware composition enabled or disabled.
+ *  @param  enable [in] if true, the sparse-aware compositor is used
+ */
+/*===========================================================================*/
+template <typename ScreenType>
+inline void SortLastScreen<ScreenType>::setEnabledSparseComposition( const bool enable )
+{
+    if ( m_compositor.isEnabledSparseComposition() == enable ) { return; }
+
+    // The compositor has to be re-initialized with the new implementation.
+    if ( m_initialized ) { m_compositor.destroy(); m_initialized = false; }
+    m_compositor.setEnabledSparseComposition( enable );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Registers the local object (partition) with the renderer.
+ *  @param  object [in] pointer to the object
+ *  @param  renderer [in] pointer to the renderer
+ *  @return pair of the object ID and the renderer ID
+ *
+ *  This method is collective. The bounding box of the objects given on all of
+ *  the ranks is registered before the object so that the normalization of the
+ *  object manager is identical among the ranks.
+ */
+/*===========================================================================*/
+template <typename ScreenType>
+inline const std::pair<int,int> SortLastScreen<ScreenType>::registerObject(
+    kvs::ObjectBase* object,
+    kvs::RendererBase* renderer )
+{
+    if ( !object->hasMinMaxObjectCoords() ) { object->updateMinMaxCoords(); }
+
+    kvs::Real32 local_min[3] = { object->minExternalCoord().x(), object->minExternalCoord().y(), object->minExternalCoord().z() };
+    kvs::Real32 local_max[3] = { object->maxExternalCoord().x(), object->maxExternalCoord().y(), object->maxExternalCoord().z() };
+    kvs::Real32 global_min[3] = { 0.0f, 0.0f, 0.0f };
+    kvs::Real32 global_max[3] = { 0.0f, 0.0f, 0.0f };
+    m_comm.allReduce( local_min, global_min, 3, MPI_MIN );
+    m_comm.allReduce( local_max, global_max, 3, MPI_MAX );
+
+    const kvs::Vec3 min_coord( global_min );
+    const kvs::Vec3 max_coord( global_max );
+    const bool inside = m_has_bounds &&
+        m_min_coord.x() <= min_coord.x() && max_coord.x() <= m_max_coord.x() &&
+        m_min_coord.y() <= min_coord.y() && max_coord.y() <= m_max_coord.y() &&
+        m_min_coord.z() <= min_coord.z() && max_coord.z() <= m_max_coord.z();
+    if ( !inside )
+    {
+        if ( m_has_bounds )
+        {
+            for ( int a = 0; a < 3; a++ )
+            {
+                m_min_coord[a] = kvs::Math::Min( m_min_coord[a], min_coord[a] );
+                m_max_coord[a] = kvs::Math::Max( m_max_coord[a], max_coord[a] );
+            }
+        }
+        else
+        {
+            m_min_coord = min_coord;
+            m_max_coord = max_coord;
+        }
+        m_has_bounds = true;
+
+        kvs::ValueArray<kvs::Real32> coords( 6 );
+        for ( int a = 0; a < 3; a++ ) { coords[a] = m_min_coord[a]; coords[a + 3] = m_max_coord[a]; }
+
+        kvs::PointObject* bounds = new kvs::PointObject();
+        bounds->setCoords( coords );
+        bounds->setMinMaxObjectCoords( m_min_coord, m_max_coord );
+        bounds->setMinMaxExternalCoords( m_min_coord, m_max_coord );
+        bounds->hide();
+        m_screen.registerObject( bounds, new kvs::Bounds() );
+    }
+
+    m_objects.push_back( object );
+    return m_screen.registerObject( object, renderer );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Renders the local objects and composites the rendering images.
+ *  @return true if the process is done successfully
+ *
+ *  This method is collective. The composited frame is available on the root
+ *  rank with colorBuffer() or capture().
+ */
+/*===========================================================================*/
+template <typename ScreenType>
+inline bool SortLastScreen<ScreenType>::draw()
+{
+    // Each partition is rendered on the transparent background, and then the
+    // composited frame is blended with the background color in capture().
+    m_screen.scene()->background()->setColor( kvs::RGBColor::Black() );
+    m_screen.scene()->background()->setOpacity( 0.0f );
+    m_screen.draw();
+
+    kvs::ValueArray<kvs::UInt8> color_buffer = m_screen.readbackColorBuffer();
+    if ( !this->initialize_compositor() ) { return false; }
+
+    bool success = false;
+    if ( m_depth_testing )
+    {
+        kvs::ValueArray<kvs::Real32> depth_buffer = m_screen.readbackDepthBuffer();
+        success = m_compositor.run( color_buffer, depth_buffer );
+    }
+    else
+    {
+        success = m_compositor.run( color_buffer, this->visibility_depth() );
+    }
+
+    m_color_buffer = this->isRoot() ? color_buffer : kvs::ValueArray<kvs::UInt8>();
+    return success;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the composited frame blended with the background color.
+ *  @return composited frame (empty image on the non-root ranks)
+ */
+/*===========================================================================*/
+template <typename ScreenType>
+inline kvs::ColorImage SortLastScreen<ScreenType>::capture() const
+{
+    if ( m_color_buffer.empty() ) { return kvs::ColorImage(); }
+
+    const size_t npixels = m_color_buffer.size() / 4;
+    kvs::ValueArray<kvs::UInt8> pixels( npixels * 3 );
+    const kvs::UInt8 bg[3] = { m_background_color.r(), m_background_color.g(), m_background_color.b() };
+    for ( size_t i = 0; i < npixels; i++ )
+    {
+        const kvs::UInt8* src = m_color_buffer.data() + 4 * i;
+        const float t = 1.0f - src[3] / 255.0f;
+        for ( int c = 0; c < 3; c++ )
+        {
+            const float v = src[c] + bg[c] * t;
+            pixels[ 3 * i + c ] = static_cast<kvs::UInt8>( kvs::Math::Min( v + 0.5f, 255.0f ) );
+        }
+    }
+
+    return kvs::ColorImage( m_screen.width(), m_screen.height(), pixels );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Initializes the image compositor for the current screen size.
+ *  @return true if the process is done successfully
+ */
+/*===========================================================================*/
+template <typename ScreenType>
+inline bool SortLastScreen<ScreenType>::initialize_compositor()
+{
+    const size_t width = static_cast<size_t>( m_screen.width() );
+    const size_t height = static_cast<size_t>( m_screen.height() );
+    if ( m_initialized &&
+         m_initialized_depth_testing == m_depth_testing &&
+         m_initialized_width == width &&
+         m_initialized_height == height ) { return true; }
+
+    if ( m_initialized ) { m_compositor.destroy(); }
+    m_initialized = m_compositor.initialize( width, height, m_depth_testing );
+    m_initialized_depth_testing = m_depth_testing;
+    m_initialized_width = width;
+    m_initialized_height = height;
+    return m_initialized;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the depth of the local partition for the visibility ordering.
+ *  @return distance from the camera to the nearest center of the local objects
+ */
+/*===========================================================================*/
+template <typename ScreenType>
+inline kvs::Real32 SortLastScreen<ScreenType>::visibility_depth()
+{
+    const kvs::Vec3 eye = m_screen.scene()->camera()->position();
+    kvs::Real32 depth = kvs::Value<kvs::Real32>::Max();
+    for ( size_t i = 0; i < m_objects.size(); i++ )
+    {
+        const kvs::ObjectBase* object = m_objects[i];
+        if ( !object->isShown() ) { continue; }
+
+        const kvs::Vec3 center = kvs::ObjectCoordinate( object->objectCenter(), object ).toWorldCoordinate().position();
+        depth = kvs::Math::Min( depth, static_cast<kvs::Real32>( ( center - eye ).length() ) );
+    }
+
+    return depth;
+}
+
+} // end of namespace mpi
+
+} // end of namespace kvs
@@ -0,0 +1,720 @@
+/*****************************************************************************/
+/**
+ *  @file   SparseImageCompositor.cpp
+ */
+/*****************************************************************************/
+#include "SparseImageCompositor.h"
+#include <kvs/Math>
+#include <kvs/Assert>
+#include <kvs/String>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+
+const int TagBase = 200; // 234Compositor uses the tags from 100 to 199
+const size_t PairSize = sizeof( kvs::UInt32 ) * 2; // (skip, run) pair of the encoded stream
+
+inline kvs::mpi::SparseImageCompositor::BBox EmptyBBox()
+{
+    kvs::mpi::SparseImageCompositor::BBox bbox = { 0, 0, 0, 0 };
+    return bbox;
+}
+
+inline bool IsEmpty( const kvs::mpi::SparseImageCompositor::BBox& bbox )
+{
+    return bbox.x0 >= bbox.x1 || bbox.y0 >= bbox.y1;
+}
+
+inline kvs::mpi::SparseImageCompositor::BBox Union(
+    const kvs::mpi::SparseImageCompositor::BBox& a,
+    const kvs::mpi::SparseImageCompositor::BBox& b )
+{
+    if ( IsEmpty( a ) ) { return b; }
+    if ( IsEmpty( b ) ) { return a; }
+
+    kvs::mpi::SparseImageCompositor::BBox bbox;
+    bbox.x0 = kvs::Math::Min( a.x0, b.x0 );
+    bbox.y0 = kvs::Math::Min( a.y0, b.y0 );
+    bbox.x1 = kvs::Math::Max( a.x1, b.x1 );
+    bbox.y1 = kvs::Math::Max( a.y1, b.y1 );
+    return bbox;
+}
+
+inline void WritePair( kvs::UInt8* buffer, const kvs::UInt32 skip, const kvs::UInt32 run )
+{
+    std::memcpy( buffer, &skip, sizeof( kvs::UInt32 ) );
+    std::memcpy( buffer + sizeof( kvs::UInt32 ), &run, sizeof( kvs::UInt32 ) );
+}
+
+inline void ReadPair( const kvs::UInt8* buffer, kvs::UInt32* skip, kvs::UInt32* run )
+{
+    std::memcpy( skip, buffer, sizeof( kvs::UInt32 ) );
+    std::memcpy( run, buffer + sizeof( kvs::UInt32 ), sizeof( kvs::UInt32 ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the pixel range of the specified tile.
+ *  @param  begin [in] begin of the partition
+ *  @param  end [in] end of the partition
+ *  @param  ntiles [in] number of tiles
+ *  @param  index [in] tile index
+ *  @return pixel range [first, second) of the tile
+ */
+/*===========================================================================*/
+inline std::pair<size_t,size_t> Tile( const size_t begin, const size_t end, const size_t ntiles, const size_t index )
+{
+    const size_t length = end - begin;
+    return std::make_pair( begin + length * index / ntiles, begin + length * ( index + 1 ) / ntiles );
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new SparseImageCompositor class.
+ *  @param  comm [in] MPI communicator
+ */
+/*===========================================================================*/
+SparseImageCompositor::SparseImageCompositor( const kvs::mpi::Communicator& comm ):
+    m_comm( comm ),
+    m_width( 0 ),
+    m_height( 0 ),
+    m_depth_testing( false ),
+    m_ntiles( 4 ),
+    m_color( NULL ),
+    m_depth( NULL )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Initializes the compositor.
+ *  @param  width [in] image width
+ *  @param  height [in] image height
+ *  @param  enable_depth_testing [in] if true, the depth testing is used for merging
+ *  @return true, if the initialization is done successfully
+ */
+/*===========================================================================*/
+bool SparseImageCompositor::initialize( const size_t width, const size_t height, const bool enable_depth_testing )
+{
+    m_width = width;
+    m_height = height;
+    m_depth_testing = enable_depth_testing;
+    m_stages.clear();
+    return width > 0 && height > 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Composites the color buffers with alpha blending in the rank order.
+ *  @param  color_buffer [in/out] color buffer (composited image on the root rank)
+ *  @return true, if the composition is done successfully
+ */
+/*===========================================================================*/
+bool SparseImageCompositor::run( kvs::ValueArray<kvs::UInt8>& color_buffer )
+{
+    std::vector<int> order( m_comm.size() );
+    for ( size_t i = 0; i < order.size(); i++ ) { order[i] = static_cast<int>( i ); }
+
+    m_color = color_buffer.data();
+    m_depth = NULL;
+    return this->composite( order );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Composites the color buffers with alpha blending in the specified order.
+ *  @param  color_buffer [in/out] color buffer (composited image on the root rank)
+ *  @param  order [in] list of ranks sorted in front-to-back order
+ *  @return true, if the composition is done successfully
+ */
+/*===========================================================================*/
+bool SparseImageCompositor::run(
+    kvs::ValueArray<kvs::UInt8>& color_buffer,
+    const kvs::ValueArray<size_t>& order )
+{
+    KVS_ASSERT( !m_depth_testing );
+    KVS_ASSERT( color_buffer.size() == m_width * m_height * 4 );
+    KVS_ASSERT( order.size() == static_cast<size_t>( m_comm.size() ) );
+
+    m_color = color_buffer.data();
+    m_depth = NULL;
+    return this->composite( std::vector<int>( order.begin(), order.end() ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Composites the color buffers with the depth testing.
+ *  @param  color_buffer [in/out] color buffer (composited image on the root rank)
+ *  @param  depth_buffer [in/out] depth buffer (composited depth on the root rank)
+ *  @return true, if the composition is done successfully
+ */
+/*===========================================================================*/
+bool SparseImageCompositor::run(
+    kvs::ValueArray<kvs::UInt8>& color_buffer,
+    kvs::ValueArray<kvs::Real32>& depth_buffer )
+{
+    KVS_ASSERT( m_depth_testing );
+    KVS_ASSERT( color_buffer.size() == m_width * m_height * 4 );
+    KVS_ASSERT( depth_buffer.size() == m_width * m_height );
+
+    std::vector<int> order( m_comm.size() );
+    for ( size_t i = 0; i < order.size(); i++ ) { order[i] = static_cast<int>( i ); }
+
+    m_color = color_buffer.data();
+    m_depth = depth_buffer.data();
+    return this->composite( order );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the fold, binary-swap and gather stages.
+ *  @param  order [in] list of ranks sorted in front-to-back order
+ *  @return true, if the composition is done successfully
+ */
+/*===========================================================================*/
+bool SparseImageCompositor::composite( const std::vector<int>& order )
+{
+    m_stages.clear();
+
+    const int rank = m_comm.rank();
+    const int size = m_comm.size();
+    const int root = m_comm.root();
+    const size_t npixels = m_width * m_height;
+
+    std::vector<int>::const_iterator it = std::find( order.begin(), order.end(), rank );
+    if ( it == order.end() ) { return false; }
+    const int v = static_cast<int>( std::distance( order.begin(), it ) );
+
+    // Active pixel bounding box.
+    Stage bbox_stage = { "bbox", MPI_Wtime(), 0, 0 };
+    BBox bbox = this->active_bbox();
+    bbox_stage.time = MPI_Wtime() - bbox_stage.time;
+    m_stages.push_back( bbox_stage );
+
+    // Largest power of two less than or equal to the number of ranks.
+    int p2 = 1;
+    while ( p2 * 2 <= size ) { p2 *= 2; }
+    const int r = size - p2;
+
+    // The first 2r ranks (in visibility order) are folded in pairs, so that
+    // the number of ranks joining the binary-swap becomes a power of two.
+    int tag = TagBase;
+    int vv = v; // index in the binary-swap stages (-1: folded)
+    if ( r > 0 )
+    {
+        if ( v < 2 * r )
+        {
+            if ( v % 2 == 1 )
+            {
+                m_stages.push_back( this->exchange( "fold", order[ v - 1 ], tag, 0, npixels, 0, 0, Under, bbox ) );
+                vv = -1;
+            }
+            else
+            {
+                m_stages.push_back( this->exchange( "fold", order[ v + 1 ], tag, 0, 0, 0, npixels, Under, bbox ) );
+                vv = v / 2;
+            }
+        }
+        else { vv = v - r; }
+        tag += static_cast<int>( m_ntiles ) + 1;
+    }
+
+    std::vector<int> owners( p2 );
+    for ( int u = 0; u < p2; u++ ) { owners[u] = order[ u < r ? 2 * u : u + r ]; }
+
+    // Binary-swap.
+    size_t begin = 0;
+    size_t end = npixels;
+    int level = 0;
+    for ( int mask = 1; mask < p2; mask <<= 1, level++ )
+    {
+        if ( vv >= 0 )
+        {
+            const int pv = vv ^ mask;
+            const size_t mid = begin + ( end - begin ) / 2;
+            const bool front = vv < pv;
+            const size_t keep_begin = front ? begin : mid;
+            const size_t keep_end = front ? mid : end;
+            const size_t send_begin = front ? mid : begin;
+            const size_t send_end = front ? end : mid;
+            const MergeMode mode = front ? Under : Over;
+            const std::string name = "swap" + kvs::String::ToString( level );
+            m_stages.push_back( this->exchange( name, owners[pv], tag, send_begin, send_end, keep_begin, keep_end, mode, bbox ) );
+            begin = keep_begin;
+            end = keep_end;
+        }
+        tag += static_cast<int>( m_ntiles ) + 1;
+    }
+
+    // Gather the composited partitions on the root rank.
+    Stage gather_stage = { "gather", MPI_Wtime(), 0, 0 };
+    {
+        const BBox send_bbox = vv >= 0 ? this->clip( bbox, begin, end ) : EmptyBBox();
+        kvs::ValueArray<kvs::Int32> send_values( 4 );
+        send_values[0] = send_bbox.x0;
+        send_values[1] = send_bbox.y0;
+        send_values[2] = send_bbox.x1;
+        send_values[3] = send_bbox.y1;
+        kvs::ValueArray<kvs::Int32> recv_values;
+        m_comm.gather( root, send_values, recv_values );
+
+        if ( rank == root )
+        {
+            if ( vv >= 0 ) { this->clear( 0, begin ); this->clear( end, npixels ); }
+            else { this->clear( 0, npixels ); }
+
+            std::vector<kvs::ValueArray<kvs::UInt8> > buffers;
+            std::vector<MPI_Request> requests;
+            std::vector<std::pair<size_t,size_t> > ranges;
+            std::vector<BBox> bboxes;
+            for ( int u = 0; u < p2; u++ )
+            {
+                const int owner = owners[u];
+                if ( owner == root ) { continue; }
+
+                size_t b = 0;
+                size_t e = npixels;
+                for ( int mask = 1; mask < p2; mask <<= 1 )
+                {
+                    const size_t mid = b + ( e - b ) / 2;
+                    if ( u < ( u ^ mask ) ) { e = mid; } else { b = mid; }
+                }
+
+                const BBox owner_bbox = {
+                    recv_values[ owner * 4 + 0 ],
+                    recv_values[ owner * 4 + 1 ],
+                    recv_values[ owner * 4 + 2 ],
+                    recv_values[ owner * 4 + 3 ] };
+                const size_t n = this->count( owner_bbox, b, e );
+                if ( n == 0 ) { continue; }
+
+                buffers.push_back( kvs::ValueArray<kvs::UInt8>( this->max_encoded_size( n ) ) );
+                requests.push_back( MPI_REQUEST_NULL );
+                ranges.push_back( std::make_pair( b, e ) );
+                bboxes.push_back( owner_bbox );
+                KVS_MPI_CALL( MPI_Irecv(
+                                  buffers.back().data(), static_cast<int>( buffers.back().size() ), MPI_BYTE,
+                                  owner, tag, m_comm.handler(), &requests.back() ) );
+            }
+
+            for ( size_t i = 0; i < requests.size(); i++ )
+            {
+                int index = 0;
+                int nbytes = 0;
+                MPI_Status status;
+                KVS_MPI_CALL( MPI_Waitany( static_cast<int>( requests.size() ), requests.data(), &index, &status ) );
+                KVS_MPI_CALL( MPI_Get_count( &status, MPI_BYTE, &nbytes ) );
+                gather_stage.recv_bytes += nbytes;
+                this->decode( bboxes[index], ranges[index].first, ranges[index].second, buffers[index].data(), Replace );
+            }
+        }
+        else if ( vv >= 0 )
+        {
+            const size_t n = this->count( send_bbox, begin, end );
+            if ( n > 0 )
+            {
+                kvs::ValueArray<kvs::UInt8> buffer( this->max_encoded_size( n ) );
+                const size_t nbytes = this->encode( send_bbox, begin, end, buffer.data() );
+                KVS_MPI_CALL( MPI_Send( buffer.data(), static_cast<int>( nbytes ), MPI_BYTE, root, tag, m_comm.handler() ) );
+                gather_stage.send_bytes += nbytes;
+            }
+        }
+    }
+    gather_stage.time = MPI_Wtime() - gather_stage.time;
+    m_stages.push_back( gather_stage );
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of bytes per pixel in the encoded stream.
+ */
+/*===========================================================================*/
+size_t SparseImageCompositor::pixel_size() const
+{
+    return m_depth ? 4 * sizeof( kvs::UInt8 ) + sizeof( kvs::Real32 ) : 4 * sizeof( kvs::UInt8 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the pixel contributes to the composited image.
+ *  @param  index [in] pixel index
+ */
+/*===========================================================================*/
+bool SparseImageCompositor::is_active( const size_t index ) const
+{
+    return m_depth ? m_depth[ index ] < 1.0f : m_color[ index * 4 + 3 ] != 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the bounding box of the active pixels in the local image.
+ */
+/*===========================================================================*/
+SparseImageCompositor::BBox SparseImageCompositor::active_bbox() const
+{
+    const kvs::Int32 width = static_cast<kvs::Int32>( m_width );
+    const kvs::Int32 height = static_cast<kvs::Int32>( m_height );
+
+    BBox bbox = { width, height, 0, 0 };
+    for ( kvs::Int32 y = 0; y < height; y++ )
+    {
+        const size_t offset = static_cast<size_t>( y ) * m_width;
+        kvs::Int32 x0 = 0;
+        while ( x0 < width && !this->is_active( offset + x0 ) ) { x0++; }
+        if ( x0 == width ) { continue; }
+
+        kvs::Int32 x1 = width;
+        while ( x1 > x0 && !this->is_active( offset + x1 - 1 ) ) { x1--; }
+
+        bbox.x0 = kvs::Math::Min( bbox.x0, x0 );
+        bbox.x1 = kvs::Math::Max( bbox.x1, x1 );
+        bbox.y0 = kvs::Math::Min( bbox.y0, y );
+        bbox.y1 = y + 1;
+    }
+
+    return IsEmpty( bbox ) ? EmptyBBox() : bbox;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Clips the bounding box by the rows covered with the pixel range.
+ *  @param  bbox [in] bounding box
+ *  @param  begin [in] begin of the pixel range
+ *  @param  end [in] end of the pixel range
+ *  @return clipped bounding box
+ */
+/*===========================================================================*/
+SparseImageCompositor::BBox SparseImageCompositor::clip(
+    const BBox& bbox,
+    const size_t begin,
+    const size_t end ) const
+{
+    if ( IsEmpty( bbox ) || begin >= end ) { return EmptyBBox(); }
+
+    BBox clipped = bbox;
+    clipped.y0 = kvs::Math::Max( bbox.y0, static_cast<kvs::Int32>( begin / m_width ) );
+    clipped.y1 = kvs::Math::Min( bbox.y1, static_cast<kvs::Int32>( ( end - 1 ) / m_width + 1 ) );
+    return IsEmpty( clipped ) ? EmptyBBox() : clipped;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of pixels in the intersection of the bounding box and the pixel range.
+ *  @param  bbox [in] bounding box
+ *  @param  begin [in] begin of the pixel range
+ *  @param  end [in] end of the pixel range
+ */
+/*===========================================================================*/
+size_t SparseImageCompositor::count( const BBox& bbox, const size_t begin, const size_t end ) const
+{
+    if ( IsEmpty( bbox ) || begin >= end ) { return 0; }
+
+    size_t n = 0;
+    for ( kvs::Int32 y = bbox.y0; y < bbox.y1; y++ )
+    {
+        const size_t offset = static_cast<size_t>( y ) * m_width;
+        const size_t lo = kvs::Math::Max( offset + bbox.x0, begin );
+        const size_t hi = kvs::Math::Min( offset + bbox.x1, end );
+        if ( lo < hi ) { n += hi - lo; }
+    }
+
+    return n;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the upper bound of the encoded size for the given number of pixels.
+ *  @param  npixels [in] number of pixels
+ */
+/*===========================================================================*/
+size_t SparseImageCompositor::max_encoded_size( const size_t npixels ) const
+{
+    // Every (skip, run) pair except the last one covers at least two pixels.
+    return ( npixels / 2 + 2 ) * PairSize + npixels * this->pixel_size();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Encodes the active pixels with the active-pixel run-length encoding.
+ *  @param  bbox [in] bounding box of the pixels to be encoded
+ *  @param  begin [in] begin of the pixel range
+ *  @param  end [in] end of the pixel range
+ *  @param  buffer [out] encoded stream
+ *  @return number of bytes of the encoded stream
+ */
+/*===========================================================================*/
+size_t SparseImageCompositor::encode(
+    const BBox& bbox,
+    const size_t begin,
+    const size_t end,
+    kvs::UInt8* buffer ) const
+{
+    kvs::UInt8* pair = buffer;
+    kvs::UInt8* p = buffer + PairSize;
+    kvs::UInt32 skip = 0;
+    kvs::UInt32 run = 0;
+    for ( kvs::Int32 y = bbox.y0; y < bbox.y1; y++ )
+    {
+        const size_t offset = static_cast<size_t>( y ) * m_width;
+        const size_t lo = kvs::Math::Max( offset + bbox.x0, begin );
+        const size_t hi = kvs::Math::Min( offset + bbox.x1, end );
+        for ( size_t index = lo; index < hi; index++ )
+        {
+            if ( this->is_active( index ) )
+            {
+                std::memcpy( p, m_color + index * 4, 4 ); p += 4;
+                if ( m_depth ) { std::memcpy( p, m_depth + index, sizeof( kvs::Real32 ) ); p += sizeof( kvs::Real32 ); }
+                run++;
+            }
+            else
+            {
+                if ( run > 0 )
+                {
+                    ::WritePair( pair, skip, run );
+                    pair = p;
+                    p += PairSize;
+                    skip = 0;
+                    run = 0;
+                }
+                skip++;
+            }
+        }
+    }
+    ::WritePair( pair, skip, run );
+
+    return static_cast<size_t>( p - buffer );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Decodes the encoded stream and merges the pixels into the local image.
+ *  @param  bbox [in] bounding box of the encoded pixels
+ *  @param  begin [in] begin of the pixel range
+ *  @param  end [in] end of the pixel range
+ *  @param  buffer [in] encoded stream
+ *  @param  mode [in] merge mode
+ */
+/*===========================================================================*/
+void SparseImageCompositor::decode(
+    const BBox& bbox,
+    const size_t begin,
+    const size_t end,
+    const kvs::UInt8* buffer,
+    const MergeMode mode )
+{
+    const size_t psize = this->pixel_size();
+    const kvs::UInt8* p = buffer;
+    kvs::UInt32 skip = 0;
+    kvs::UInt32 run = 0;
+    ::ReadPair( p, &skip, &run ); p += PairSize;
+    for ( kvs::Int32 y = bbox.y0; y < bbox.y1; y++ )
+    {
+        const size_t offset = static_cast<size_t>( y ) * m_width;
+        const size_t lo = kvs::Math::Max( offset + bbox.x0, begin );
+        const size_t hi = kvs::Math::Min( offset + bbox.x1, end );
+        for ( size_t index = lo; index < hi; index++ )
+        {
+            while ( skip == 0 && run == 0 ) { ::ReadPair( p, &skip, &run ); p += PairSize; }
+            if ( skip > 0 ) { skip--; continue; }
+
+            this->merge( index, p, mode );
+            p += psize;
+            run--;
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Merges the received pixel into the local pixel.
+ *  @param  index [in] pixel index
+ *  @param  pixel [in] received pixel (RGBA and optional depth)
+ *  @param  mode [in] merge mode
+ */
+/*===========================================================================*/
+void SparseImageCompositor::merge( const size_t index, const kvs::UInt8* pixel, const MergeMode mode )
+{
+    kvs::UInt8* local = m_color + index * 4;
+    switch ( mode )
+    {
+    case Replace:
+    {
+        std::memcpy( local, pixel, 4 );
+        if ( m_depth ) { std::memcpy( m_depth + index, pixel + 4, sizeof( kvs::Real32 ) ); }
+        break;
+    }
+    case Depth:
+    {
+        kvs::Real32 depth = 0.0f;
+        std::memcpy( &depth, pixel + 4, sizeof( kvs::Real32 ) );
+        if ( depth < m_depth[ index ] )
+        {
+            std::memcpy( local, pixel, 4 );
+            m_depth[ index ] = depth;
+        }
+        break;
+    }
+    case Over:
+    case Under:
+    {
+        // Premultiplied alpha blending: C = C_over + C_under * ( 1 - A_over )
+        kvs::UInt8 over[4];
+        kvs::UInt8 under[4];
+        std::memcpy( over, mode == Over ? pixel : local, 4 );
+        std::memcpy( under, mode == Over ? local : pixel, 4 );
+        const kvs::UInt32 one_minus_alpha = 255 - over[3];
+        for ( int i = 0; i < 4; i++ )
+        {
+            const kvs::UInt32 value = over[i] + under[i] * one_minus_alpha / 255;
+            local[i] = static_cast<kvs::UInt8>( kvs::Math::Min( value, kvs::UInt32( 255 ) ) );
+        }
+        break;
+    }
+    default: break;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Clears the pixels in the range.
+ *  @param  begin [in] begin of the pixel range
+ *  @param  end [in] end of the pixel range
+ */
+/*===========================================================================*/
+void SparseImageCompositor::clear( const size_t begin, const size_t end )
+{
+    if ( begin >= end ) { return; }
+
+    std::memset( m_color + begin * 4, 0, ( end - begin ) * 4 );
+    if ( m_depth ) { std::fill( m_depth + begin, m_depth + end, 1.0f ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Exchanges the partitions with the partner and merges the received one.
+ *  @param  name [in] stage name
+ *  @param  partner [in] rank of the partner
+ *  @param  tag [in] base tag of the messages
+ *  @param  send_begin [in] begin of the pixel range to be sent
+ *  @param  send_end [in] end of the pixel range to be sent
+ *  @param  recv_begin [in] begin of the pixel range to be received
+ *  @param  recv_end [in] end of the pixel range to be received
+ *  @param  mode [in] merge mode for the alpha blending
+ *  @param  bbox [in/out] bounding box of the active pixels
+ *  @return statistics of the stage
+ */
+/*===========================================================================*/
+SparseImageCompositor::Stage SparseImageCompositor::exchange(
+    const std::string& name,
+    const int partner,
+    const int tag,
+    const size_t send_begin,
+    const size_t send_end,
+    const size_t recv_begin,
+    const size_t recv_end,
+    const MergeMode mode,
+    BBox& bbox )
+{
+    Stage stage = { name, MPI_Wtime(), 0, 0 };
+
+    const bool sending = send_begin < send_end;
+    const bool receiving = recv_begin < recv_end;
+    const MergeMode merge_mode = m_depth ? Depth : mode;
+    const MPI_Comm comm = m_comm.handler();
+
+    // Exchange the bounding boxes so that the empty tiles are never sent.
+    BBox send_bbox = sending ? this->clip( bbox, send_begin, send_end ) : EmptyBBox();
+    BBox recv_bbox = EmptyBBox();
+    {
+        MPI_Request requests[2];
+        int nrequests = 0;
+        if ( receiving ) { KVS_MPI_CALL( MPI_Irecv( &recv_bbox, 4, MPI_INT, partner, tag, comm, &requests[ nrequests++ ] ) ); }
+        if ( sending ) { KVS_MPI_CALL( MPI_Isend( &send_bbox, 4, MPI_INT, partner, tag, comm, &requests[ nrequests++ ] ) ); }
+        KVS_MPI_CALL( MPI_Waitall( nrequests, requests, MPI_STATUSES_IGNORE ) );
+    }
+
+    // Post the receives for the non-empty tiles.
+    std::vector<kvs::ValueArray<kvs::UInt8> > recv_buffers;
+    std::vector<MPI_Request> recv_requests;
+    std::vector<size_t> recv_tiles;
+    if ( receiving )
+    {
+        for ( size_t i = 0; i < m_ntiles; i++ )
+        {
+            const std::pair<size_t,size_t> tile = ::Tile( recv_begin, recv_end, m_ntiles, i );
+            const size_t n = this->count( recv_bbox, tile.first, tile.second );
+            if ( n == 0 ) { continue; }
+
+            recv_buffers.push_back( kvs::ValueArray<kvs::UInt8>( this->max_encoded_size( n ) ) );
+            recv_requests.push_back( MPI_REQUEST_NULL );
+            recv_tiles.push_back( i );
+            KVS_MPI_CALL( MPI_Irecv(
+                              recv_buffers.back().data(), static_cast<int>( recv_buffers.back().size() ), MPI_BYTE,
+                              partner, tag + 1 + static_cast<int>( i ), comm, &recv_requests.back() ) );
+        }
+    }
+
+    // Encode and send the tiles one by one, so that the encoding of a tile
+    // overlaps the transfer of the previous ones.
+    std::vector<kvs::ValueArray<kvs::UInt8> > send_buffers;
+    std::vector<MPI_Request> send_requests;
+    if ( sending )
+    {
+        for ( size_t i = 0; i < m_ntiles; i++ )
+        {
+            const std::pair<size_t,size_t> tile = ::Tile( send_begin, send_end, m_ntiles, i );
+            const size_t n = this->count( send_bbox, tile.first, tile.second );
+            if ( n == 0 ) { continue; }
+
+            send_buffers.push_back( kvs::ValueArray<kvs::UInt8>( this->max_encoded_size( n ) ) );
+            send_requests.push_back( MPI_REQUEST_NULL );
+            const size_t nbytes = this->encode( send_bbox, tile.first, tile.second, send_buffers.back().data() );
+            KVS_MPI_CALL( MPI_Isend(
+                              send_buffers.back().data(), static_cast<int>( nbytes ), MPI_BYTE,
+                              partner, tag + 1 + static_cast<int>( i ), comm, &send_requests.back() ) );
+            stage.send_bytes += nbytes;
+        }
+    }
+
+    // Merge the tiles in the order of arrival.
+    for ( size_t i = 0; i < recv_requests.size(); i++ )
+    {
+        int index = 0;
+        int nbytes = 0;
+        MPI_Status status;
+        KVS_MPI_CALL( MPI_Waitany( static_cast<int>( recv_requests.size() ), recv_requests.data(), &index, &status ) );
+        KVS_MPI_CALL( MPI_Get_count( &status, MPI_BYTE, &nbytes ) );
+        stage.recv_bytes += nbytes;
+
+        const std::pair<size_t,size_t> tile = ::Tile( recv_begin, recv_end, m_ntiles, recv_tiles[ index ] );
+        this->decode( recv_bbox, tile.first, tile.second, recv_buffers[ index ].data(), merge_mode );
+    }
+
+    if ( !send_requests.empty() )
+    {
+        KVS_MPI_CALL( MPI_Waitall( static_cast<int>( send_requests.size() ), send_requests.data(), MPI_STATUSES_IGNORE ) );
+    }
+
+    if ( receiving ) { bbox = ::Union( this->clip( bbox, recv_begin, recv_end ), recv_bbox ); }
+
+    stage.time = MPI_Wtime() - stage.time;
+    return stage;
+}
+
+} // end of namespace mpi
+
+} // end of namespace kvs
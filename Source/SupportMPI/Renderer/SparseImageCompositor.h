@@ -0,0 +1,112 @@
+/*****************************************************************************/
+/**
+ *  @file   SparseImageCompositor.h
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/mpi/Communicator>
+#include <kvs/ValueArray>
+#include <kvs/Type>
+#include <string>
+#include <vector>
+
+
+namespace kvs
+{
+
+namespace mpi
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Sparse-aware binary-swap image compositor.
+ *
+ *  Each rank tracks the bounding box of its active (non-empty) pixels, and
+ *  only the part of a partition that intersects the bounding box is sent to
+ *  the partner. The sent pixels are packed with an active-pixel run-length
+ *  encoding, and every partition is split into sub-tiles which are sent and
+ *  received with non-blocking calls so that the blending of an arrived tile
+ *  overlaps the transfer of the remaining ones. The composited image is
+ *  gathered on the root rank of the communicator.
+ */
+/*===========================================================================*/
+class SparseImageCompositor
+{
+public:
+    struct Stage
+    {
+        std::string name; ///< stage name
+        double time; ///< elapsed time in seconds
+        size_t send_bytes; ///< number of bytes sent in the stage
+        size_t recv_bytes; ///< number of bytes received in the stage
+    };
+
+    typedef std::vector<Stage> Stages;
+
+    struct BBox
+    {
+        kvs::Int32 x0; ///< min. x (inclusive)
+        kvs::Int32 y0; ///< min. y (inclusive)
+        kvs::Int32 x1; ///< max. x (exclusive)
+        kvs::Int32 y1; ///< max. y (exclusive)
+    };
+
+private:
+    kvs::mpi::Communicator m_comm; ///< MPI communicator
+    size_t m_width; ///< image width
+    size_t m_height; ///< image height
+    bool m_depth_testing; ///< true if the depth testing is enabled
+    size_t m_ntiles; ///< number of sub-tiles per exchanged partition
+    Stages m_stages; ///< per-stage statistics of the last composition
+
+    kvs::UInt8* m_color; ///< color buffer (RGBA, 8-bit per channel)
+    kvs::Real32* m_depth; ///< depth buffer (NULL for alpha blending)
+
+public:
+    SparseImageCompositor( const kvs::mpi::Communicator& comm );
+
+    size_t numberOfTiles() const { return m_ntiles; }
+    const Stages& stages() const { return m_stages; }
+
+    void setNumberOfTiles( const size_t ntiles ) { m_ntiles = ntiles > 0 ? ntiles : 1; }
+
+    bool initialize( const size_t width, const size_t height, const bool enable_depth_testing = false );
+    bool run( kvs::ValueArray<kvs::UInt8>& color_buffer );
+    bool run( kvs::ValueArray<kvs::UInt8>& color_buffer, const kvs::ValueArray<size_t>& order );
+    bool run( kvs::ValueArray<kvs::UInt8>& color_buffer, kvs::ValueArray<kvs::Real32>& depth_buffer );
+
+private:
+    enum MergeMode
+    {
+        Over, ///< received pixels are in front of the local pixels
+        Under, ///< received pixels are behind the local pixels
+        Depth, ///< received pixels are merged with the depth test
+        Replace ///< received pixels overwrite the local pixels
+    };
+
+    bool composite( const std::vector<int>& order );
+    size_t pixel_size() const;
+    bool is_active( const size_t index ) const;
+    BBox active_bbox() const;
+    BBox clip( const BBox& bbox, const size_t begin, const size_t end ) const;
+    size_t count( const BBox& bbox, const size_t begin, const size_t end ) const;
+    size_t max_encoded_size( const size_t npixels ) const;
+    size_t encode( const BBox& bbox, const size_t begin, const size_t end, kvs::UInt8* buffer ) const;
+    void decode( const BBox& bbox, const size_t begin, const size_t end, const kvs::UInt8* buffer, const MergeMode mode );
+    void merge( const size_t index, const kvs::UInt8* pixel, const MergeMode mode );
+    void clear( const size_t begin, const size_t end );
+    Stage exchange(
+        const std::string& name,
+        const int partner,
+        const int tag,
+        const size_t send_begin,
+        const size_t send_end,
+        const size_t recv_begin,
+        const size_t recv_end,
+        const MergeMode mode,
+        BBox& bbox );
+};
+
+} // end of namespace mpi
+
+} // end of namespace kvs
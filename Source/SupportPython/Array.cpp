@@ -11,40 +11,162 @@
 namespace
 {
 
+const char* const CapsuleName = "kvs::python::Array";
+
 template <typename T> int Type() { return NPY_NOTYPE; }
 template <> int Type<kvs::Int32>() { return NPY_INT32; }
 template <> int Type<kvs::Int64>() { return NPY_INT64; }
 template <> int Type<kvs::Real32>() { return NPY_FLOAT32; }
 template <> int Type<kvs::Real64>() { return NPY_FLOAT64; }
 
-template <typename T>
-PyObject* Convert( const kvs::ValueArray<T>& array )
+int Type( const kvs::Type::TypeID id )
+{
+    switch ( id )
+    {
+    case kvs::Type::TypeInt8: return NPY_INT8;
+    case kvs::Type::TypeInt16: return NPY_INT16;
+    case kvs::Type::TypeInt32: return NPY_INT32;
+    case kvs::Type::TypeInt64: return NPY_INT64;
+    case kvs::Type::TypeUInt8: return NPY_UINT8;
+    case kvs::Type::TypeUInt16: return NPY_UINT16;
+    case kvs::Type::TypeUInt32: return NPY_UINT32;
+    case kvs::Type::TypeUInt64: return NPY_UINT64;
+    case kvs::Type::TypeReal32: return NPY_FLOAT32;
+    case kvs::Type::TypeReal64: return NPY_FLOAT64;
+    default: return NPY_NOTYPE;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the shared pointer held by the capsule.
+ *  @param  capsule [in] capsule set to the base object of the NumPy array
+ */
+/*===========================================================================*/
+void ReleaseCapsule( PyObject* capsule )
+{
+    delete static_cast<kvs::SharedPointer<void>*>( PyCapsule_GetPointer( capsule, ::CapsuleName ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Deleter of the ValueArray which adopts the buffer of the NumPy array.
+ */
+/*===========================================================================*/
+class Releaser
+{
+private:
+    PyObject* m_object; ///< NumPy array (owned reference)
+
+public:
+    Releaser( PyObject* object ): m_object( object ) {}
+
+    template <typename T>
+    void operator ()( T* ) const
+    {
+        // The ValueArray can be destroyed after the interpreter is finalized
+        // or in the thread which does not hold the GIL.
+        if ( !Py_IsInitialized() ) { return; }
+        PyGILState_STATE state = PyGILState_Ensure();
+        Py_DECREF( m_object );
+        PyGILState_Release( state );
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Wraps the memory as the read-only C-contiguous NumPy array without copying.
+ *  @param  values [in] shared pointer which owns the memory
+ *  @param  data [in] pointer to the head of the values
+ *  @param  type [in] NumPy type
+ *  @param  shape [in] shape of the array
+ *  @return new reference of the NumPy array
+ */
+/*===========================================================================*/
+PyObject* Wrap(
+    const kvs::SharedPointer<void>& values,
+    const void* data,
+    const int type,
+    const kvs::python::Array::Shape& shape )
 {
-    const int ndim = 1;
-    npy_intp dims[1] = { (npy_intp)(array.size()) };
+    if ( type == NPY_NOTYPE ) { throw ""; }
+
+    const int ndim = static_cast<int>( shape.size() );
+    std::vector<npy_intp> dims( shape.begin(), shape.end() );
+    npy_intp size = 1;
+    for ( int i = 0; i < ndim; i++ ) { size *= dims[i]; }
+
+    if ( size == 0 || !data )
+    {
+        return PyArray_SimpleNew( ndim, dims.data(), type );
+    }
+
+    // The array is not writeable since the memory is given as const.
+    void* pointer = const_cast<void*>( data );
+    PyObject* array = PyArray_New( &PyArray_Type, ndim, dims.data(), type, NULL, pointer, 0, NPY_ARRAY_CARRAY_RO, NULL );
+    if ( !array ) { return NULL; }
 
-    PyArrayObject* object = (PyArrayObject*)PyArray_SimpleNew( ndim, dims, Type<T>() );
-    for ( size_t i = 0; i < array.size(); i++ )
+    // The capsule holds a reference of the memory as long as the NumPy array
+    // (or any view of it) is alive.
+    kvs::SharedPointer<void>* holder = new kvs::SharedPointer<void>( values );
+    PyObject* capsule = PyCapsule_New( holder, ::CapsuleName, ::ReleaseCapsule );
+    if ( !capsule )
     {
-        *(T*)PyArray_GETPTR1( object, i ) = array[i];
+        delete holder;
+        Py_DECREF( array );
+        return NULL;
     }
 
-    Py_XINCREF( object );
-    return PyArray_Return( object );
+    PyArray_SetBaseObject( (PyArrayObject*)array, capsule );
+    return array;
+}
+
+template <typename T>
+PyObject* Convert( const kvs::ValueArray<T>& array )
+{
+    const kvs::python::Array::Shape shape( 1, array.size() );
+    return ::Wrap( array.sharedPointer(), array.data(), Type<T>(), shape );
+}
+
+PyObject* Convert( const kvs::AnyValueArray& array, const kvs::python::Array::Shape& shape )
+{
+    size_t size = 1;
+    for ( size_t i = 0; i < shape.size(); i++ ) { size *= shape[i]; }
+    if ( shape.empty() || size != array.size() ) { throw ""; }
+
+    return ::Wrap( array.sharedPointer(), array.data(), Type( array.typeID() ), shape );
+}
+
+kvs::python::Array::Shape Shape( const kvs::StructuredVolumeObject& volume )
+{
+    // The values are stored in the order of x, y and z with the components
+    // of the vector interleaved, so that the index is [z][y][x][component].
+    kvs::python::Array::Shape shape;
+    shape.push_back( volume.resolution().z() );
+    shape.push_back( volume.resolution().y() );
+    shape.push_back( volume.resolution().x() );
+    if ( volume.veclen() > 1 ) { shape.push_back( volume.veclen() ); }
+    return shape;
 }
 
 template <typename T>
 kvs::ValueArray<T> Convert( const PyArrayObject* object )
 {
-    const size_t size = PyArray_DIMS( (PyArrayObject*)object )[0];
+    // The buffer is adopted as it is if the array is aligned, C-contiguous,
+    // writeable and in native byte order; otherwise it is copied by NumPy.
+    PyObject* array = PyArray_FROM_OTF( (PyObject*)object, Type<T>(), NPY_ARRAY_CARRAY );
+    if ( !array ) { throw ""; }
 
-    kvs::ValueArray<T> array( size );
-    for ( size_t i = 0; i < size; i++ )
+    const size_t size = PyArray_SIZE( (PyArrayObject*)array );
+    if ( size == 0 )
     {
-        array[i] = *(T*)PyArray_GETPTR1( (PyArrayObject*)object, i );
+        Py_DECREF( array );
+        return kvs::ValueArray<T>();
     }
 
-    return array;
+    T* data = static_cast<T*>( PyArray_DATA( (PyArrayObject*)array ) );
+    kvs::SharedPointer<T> values( data, ::Releaser( array ) );
+    return kvs::ValueArray<T>( values, size );
 }
 
 }
@@ -82,18 +204,51 @@ Array::Array( const kvs::ValueArray<kvs::Real64>& array ):
 {
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a multi-dimensional view of the array.
+ *  @param  array [in] array
+ *  @param  shape [in] shape in C order (the last dimension varies fastest)
+ */
+/*===========================================================================*/
+Array::Array( const kvs::AnyValueArray& array, const Shape& shape ):
+    kvs::python::Object( ::Convert( array, shape ) )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a view of the node values of the structured volume.
+ *  @param  volume [in] structured volume object
+ *
+ *  The shape of the view is (nz, ny, nx) for the scalar volume and
+ *  (nz, ny, nx, veclen) for the vector volume.
+ */
+/*===========================================================================*/
+Array::Array( const kvs::StructuredVolumeObject& volume ):
+    kvs::python::Object( ::Convert( volume.values(), ::Shape( volume ) ) )
+{
+}
+
 Array::Array( const kvs::python::Object& value ):
     kvs::python::Object( value )
 {
 }
 
+Array::Shape Array::shape() const
+{
+    const int ndim = PyArray_NDIM( (const PyArrayObject*)get() );
+    const npy_intp* dims = PyArray_DIMS( (PyArrayObject*)get() );
+    return Shape( dims, dims + ndim );
+}
+
 Array::operator kvs::ValueArray<kvs::Int32>() const
 {
     const int type = PyArray_TYPE( (const PyArrayObject*)get() );
     if ( type != NPY_INT32 ) { throw ""; }
 
     const int ndim = PyArray_NDIM( (const PyArrayObject*)get() );
-    if ( ndim != 1 ) { throw ""; }
+    if ( ndim < 1 ) { throw ""; }
 
     return ::Convert<kvs::Int32>( (PyArrayObject*)( get() ) );
 }
@@ -104,7 +259,7 @@ Array::operator kvs::ValueArray<kvs::Int64>() const
     if ( type != NPY_INT64 ) { throw ""; }
 
     const int ndim = PyArray_NDIM( (const PyArrayObject*)get() );
-    if ( ndim != 1 ) { throw ""; }
+    if ( ndim < 1 ) { throw ""; }
 
     return ::Convert<kvs::Int64>( (PyArrayObject*)( get() ) );
 }
@@ -115,7 +270,7 @@ Array::operator kvs::ValueArray<kvs::Real32>() const
     if ( type != NPY_FLOAT32 ) { throw ""; }
 
     const int ndim = PyArray_NDIM( (const PyArrayObject*)get() );
-    if ( ndim != 1 ) { throw ""; }
+    if ( ndim < 1 ) { throw ""; }
 
     return ::Convert<kvs::Real32>( (PyArrayObject*)( get() ) );
 }
@@ -126,7 +281,7 @@ Array::operator kvs::ValueArray<kvs::Real64>() const
     if ( type != NPY_FLOAT64 ) { throw ""; }
 
     const int ndim = PyArray_NDIM( (const PyArrayObject*)get() );
-    if ( ndim != 1 ) { throw ""; }
+    if ( ndim < 1 ) { throw ""; }
 
     return ::Convert<kvs::Real64>( (PyArrayObject*)( get() ) );
 }
@@ -6,7 +6,10 @@
 /*****************************************************************************/
 #pragma once
 #include "Object.h"
+#include <vector>
 #include <kvs/ValueArray>
+#include <kvs/AnyValueArray>
+#include <kvs/StructuredVolumeObject>
 #include <kvs/Type>
 
 
@@ -16,8 +19,22 @@ namespace kvs
 namespace python
 {
 
+/*===========================================================================*/
+/**
+ *  @brief  NumPy array class.
+ *
+ *  The NumPy array shares the memory of the given ValueArray without copying
+ *  and keeps it alive while the NumPy array is referred. The shared NumPy
+ *  array is read-only, and should be copied to be modified. Conversely, the
+ *  ValueArray converted from the contiguous NumPy array adopts the buffer of
+ *  the NumPy array, which is copied only if it is not contiguous.
+ */
+/*===========================================================================*/
 class Array : public kvs::python::Object
 {
+public:
+    typedef std::vector<size_t> Shape;
+
 public:
     static bool Check( const kvs::python::Object& object );
 
@@ -26,8 +43,12 @@ public:
     Array( const kvs::ValueArray<kvs::Int64>& array );
     Array( const kvs::ValueArray<kvs::Real32>& array );
     Array( const kvs::ValueArray<kvs::Real64>& array );
+    Array( const kvs::AnyValueArray& array, const Shape& shape );
+    Array( const kvs::StructuredVolumeObject& volume );
     Array( const kvs::python::Object& array );
 
+    Shape shape() const;
+
     operator kvs::ValueArray<kvs::Int32>() const;
     operator kvs::ValueArray<kvs::Int64>() const;
     operator kvs::ValueArray<kvs::Real32>() const;
@@ -6,6 +6,7 @@
 /*****************************************************************************/
 #include "Table.h"
 #include "NumPy.h"
+#include <algorithm>
 
 
 namespace
@@ -17,44 +18,118 @@ template <> int Type<kvs::Int64>() { return NPY_INT64; }
 template <> int Type<kvs::Real32>() { return NPY_FLOAT32; }
 template <> int Type<kvs::Real64>() { return NPY_FLOAT64; }
 
+const char* const CapsuleName = "kvs::python::Table";
+
+void ReleaseCapsule( PyObject* capsule )
+{
+    delete static_cast<kvs::SharedPointer<void>*>( PyCapsule_GetPointer( capsule, ::CapsuleName ) );
+}
+
+class Releaser
+{
+private:
+    PyObject* m_object; ///< NumPy array (owned reference)
+
+public:
+    Releaser( PyObject* object ): m_object( object ) {}
+
+    template <typename T>
+    void operator ()( T* ) const
+    {
+        if ( !Py_IsInitialized() ) { return; }
+        PyGILState_STATE state = PyGILState_Ensure();
+        Py_DECREF( m_object );
+        PyGILState_Release( state );
+    }
+};
+
+template <typename T>
+bool IsContiguous( const kvs::ValueTable<T>& table )
+{
+    if ( table.columnSize() == 0 ) { return false; }
+
+    const size_t nrows = table.rowSize();
+    for ( size_t i = 0; i < table.columnSize(); i++ )
+    {
+        if ( table[i].size() != nrows ) { return false; }
+        if ( table[i].data() != table[0].data() + i * nrows ) { return false; }
+    }
+    return nrows > 0;
+}
+
 template <typename T>
 PyObject* Convert( const kvs::ValueTable<T>& table )
 {
     const int ndim = 2;
-    const int nrows = table.rowSize();
-    const int ncols = table.columnSize();
-    npy_intp dims[2] = { nrows, ncols };
+    const size_t ncols = table.columnSize();
+    const size_t nrows = ncols > 0 ? table.rowSize() : 0;
+    npy_intp dims[2] = { npy_intp( nrows ), npy_intp( ncols ) };
 
-    // array: row-major 2D array
+    // array: 2D array in Fortran (column-major) order
     // table: column-major table
-    PyArrayObject* array = (PyArrayObject*)PyArray_SimpleNew( ndim, dims, Type<T>() );
-    for ( int j = 0; j < nrows; ++j )
+    if ( ::IsContiguous( table ) )
     {
-        for ( int i = 0; i < ncols; ++i )
+        // The columns stored in a block (ex. the table converted from the
+        // NumPy array) are wrapped as the read-only array without copying.
+        void* data = const_cast<T*>( table[0].data() );
+        PyObject* array = PyArray_New( &PyArray_Type, ndim, dims, Type<T>(), NULL, data, 0, NPY_ARRAY_FARRAY_RO, NULL );
+        if ( !array ) { return NULL; }
+
+        kvs::SharedPointer<void>* holder = new kvs::SharedPointer<void>( table[0].sharedPointer() );
+        PyObject* capsule = PyCapsule_New( holder, ::CapsuleName, ::ReleaseCapsule );
+        if ( !capsule )
         {
-            *(T*)PyArray_GETPTR2( array, j, i ) = table[i][j];
+            delete holder;
+            Py_DECREF( array );
+            return NULL;
         }
+
+        PyArray_SetBaseObject( (PyArrayObject*)array, capsule );
+        return array;
     }
 
-    Py_XINCREF( array );
-    return PyArray_Return( array );
+    // Otherwise, the columns are copied to the continuous columns of the array.
+    PyObject* array = PyArray_New( &PyArray_Type, ndim, dims, Type<T>(), NULL, NULL, 0, NPY_ARRAY_F_CONTIGUOUS, NULL );
+    if ( !array ) { return NULL; }
+
+    T* data = static_cast<T*>( PyArray_DATA( (PyArrayObject*)array ) );
+    for ( size_t i = 0; i < ncols; i++ )
+    {
+        const size_t size = std::min( nrows, table[i].size() );
+        std::copy( table[i].begin(), table[i].begin() + size, data + i * nrows );
+        std::fill( data + i * nrows + size, data + ( i + 1 ) * nrows, T( 0 ) );
+    }
+
+    return array;
 }
 
 template <typename T>
-kvs::ValueTable<T> Convert( const PyArrayObject* array )
+kvs::ValueTable<T> Convert( const PyArrayObject* object )
 {
-    const int nrows = PyArray_DIMS( (PyArrayObject*)array )[0];
-    const int ncols = PyArray_DIMS( (PyArrayObject*)array )[1];
+    // The buffer is adopted as it is if the array is aligned, Fortran-
+    // contiguous, writeable and in native byte order; otherwise it is copied
+    // by NumPy (ex. the row-major array is transposed).
+    PyObject* array = PyArray_FROM_OTF( (PyObject*)object, Type<T>(), NPY_ARRAY_FARRAY );
+    if ( !array ) { throw ""; }
+
+    const size_t nrows = PyArray_DIMS( (PyArrayObject*)array )[0];
+    const size_t ncols = PyArray_DIMS( (PyArrayObject*)array )[1];
+    if ( nrows == 0 || ncols == 0 )
+    {
+        Py_DECREF( array );
+        return kvs::ValueTable<T>( nrows, ncols );
+    }
 
-    // array: row-major 2D array
+    // array: 2D array in Fortran (column-major) order
     // table: column-major table
-    kvs::ValueTable<T> table( nrows, ncols );
-    for ( int j = 0; j < nrows; ++j )
+    T* data = static_cast<T*>( PyArray_DATA( (PyArrayObject*)array ) );
+    kvs::SharedPointer<T> values( data, ::Releaser( array ) );
+
+    kvs::ValueTable<T> table( ncols );
+    for ( size_t i = 0; i < ncols; i++ )
     {
-        for ( int i = 0; i < ncols; i++ )
-        {
-            table[i][j] = *(T*)PyArray_GETPTR2( (PyArrayObject*)array, j, i );
-        }
+        const kvs::SharedPointer<T> column( values, data + i * nrows );
+        table[i] = kvs::ValueArray<T>( column, nrows );
     }
 
     return table;
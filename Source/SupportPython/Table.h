@@ -16,6 +16,16 @@ namespace kvs
 namespace python
 {
 
+/*===========================================================================*/
+/**
+ *  @brief  NumPy 2D array class for the value table.
+ *
+ *  The table is viewed as the (nrows, ncolumns) array in Fortran order. The
+ *  columns stored in a block are shared as the read-only array without
+ *  copying, and the table converted from the Fortran-contiguous array adopts
+ *  its buffer.
+ */
+/*===========================================================================*/
 class Table : public kvs::python::Object
 {
 public:
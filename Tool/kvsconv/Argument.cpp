@@ -10,6 +10,7 @@
 #include "UcdConv.h"
 #include "ImgConv.h"
 #include "TetConv.h"
+#include "KvsbConv.h"
 
 
 namespace kvsconv
@@ -35,6 +36,7 @@ Argument::Argument( int argc, char** argv ):
     addOption( kvsconv::UcdConv::CommandName, kvsconv::UcdConv::Description, 0 );
     addOption( kvsconv::TetConv::CommandName, kvsconv::TetConv::Description, 0 );
     addOption( kvsconv::ImgConv::CommandName, kvsconv::ImgConv::Description, 0 );
+    addOption( kvsconv::KvsbConv::CommandName, kvsconv::KvsbConv::Description, 0 );
 
     // Input value.
     addValue( "input data", false );
@@ -0,0 +1,203 @@
+/*****************************************************************************/
+/**
+ *  @file   KvsbConv.cpp
+ *  @brief  KVSB Data Converter
+ */
+/*****************************************************************************/
+#include "KvsbConv.h"
+#include <string>
+#include <kvs/File>
+#include <kvs/Message>
+#include <kvs/ObjectImporter>
+#include <kvs/PointObject>
+#include <kvs/LineObject>
+#include <kvs/PolygonObject>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/PointExporter>
+#include <kvs/LineExporter>
+#include <kvs/PolygonExporter>
+#include <kvs/StructuredVolumeExporter>
+#include <kvs/UnstructuredVolumeExporter>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the object to the KVSB file with the given exporter.
+ *  @param  object [in] pointer to the object
+ *  @param  arg [in] argument
+ *  @param  filename [in] output filename
+ *  @return true, if the object is written successfully
+ */
+/*===========================================================================*/
+template <typename Exporter, typename Object>
+bool Export( const Object* object, kvsconv::KvsbConv::Argument& arg, const std::string& filename )
+{
+    Exporter exporter( object );
+    exporter.setCompression( arg.compression() );
+    exporter.setChunkSize( arg.chunkSize() );
+    return exporter.write( filename );
+}
+
+} // end of namespace
+
+
+namespace kvsconv
+{
+
+namespace KvsbConv
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Argument class for a kvsb_conv.
+ *  @param  argc [in] argument count
+ *  @param  argv [in] argument values
+ */
+/*===========================================================================*/
+Argument::Argument( int argc, char** argv ):
+    kvsconv::Argument::Common( argc, argv, KvsbConv::CommandName )
+{
+    addOption( KvsbConv::CommandName, KvsbConv::Description, 0 );
+    addOption( "c", "Compress the arrays by the chunk. (optional)", 0, false );
+    addOption( "s", "Chunk size in bytes. (optional: <size>, default: 1048576)", 1, false );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a input filename.
+ *  @return input filename
+ */
+/*===========================================================================*/
+std::string Argument::inputFilename()
+{
+    return this->hasValues() ? this->value<std::string>() : "";
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a output filename.
+ *  @param  filename [in] input filename
+ *  @return output filename.
+ */
+/*===========================================================================*/
+std::string Argument::outputFilename( const std::string& filename )
+{
+    if ( this->hasOption("output") )
+    {
+        return this->optionValue<std::string>("output");
+    }
+    else
+    {
+        // Default output filename: <basename_of_filename>.kvsb
+        // e.g) data.kvsml -> data.kvsb
+        const std::string basename = kvs::File( filename ).baseName();
+        const std::string extension = "kvsb";
+        return basename + "." + extension;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a compression method.
+ *  @return compression method
+ */
+/*===========================================================================*/
+kvs::KVSBObject::Compression Argument::compression()
+{
+    return this->hasOption("c") ? kvs::KVSBObject::LZCompression : kvs::KVSBObject::NoCompression;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a chunk size.
+ *  @return chunk size in bytes
+ */
+/*===========================================================================*/
+size_t Argument::chunkSize()
+{
+    return this->hasOption("s") ? this->optionValue<size_t>("s") : size_t( 1 << 20 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes main process.
+ */
+/*===========================================================================*/
+bool Main::exec()
+{
+    // Parse specified arguments.
+    KvsbConv::Argument arg( m_argc, m_argv );
+    if( !arg.parse() ) { return false; }
+
+    // Set a input filename and a output filename.
+    m_input_name = arg.inputFilename();
+    m_output_name = arg.outputFilename( m_input_name );
+
+    // Check input data file.
+    if ( m_input_name.empty() )
+    {
+        kvsMessageError() << "Input file is not specified." << std::endl;
+        return false;
+    }
+
+    kvs::File file( m_input_name );
+    if ( !file.exists() )
+    {
+        kvsMessageError() << m_input_name << " is not found." << std::endl;
+        return false;
+    }
+
+    // Import the object from the data file.
+    kvs::ObjectImporter importer( m_input_name );
+    kvs::ObjectBase* object = importer.import();
+    if ( !object )
+    {
+        kvsMessageError() << "Cannot import " << m_input_name << "." << std::endl;
+        return false;
+    }
+
+    // Write the object to a file in KVSB format.
+    bool success = false;
+    if ( const auto* point = dynamic_cast<const kvs::PointObject*>( object ) )
+    {
+        success = ::Export<kvs::PointExporter<kvs::KVSBObject> >( point, arg, m_output_name );
+    }
+    else if ( const auto* line = dynamic_cast<const kvs::LineObject*>( object ) )
+    {
+        success = ::Export<kvs::LineExporter<kvs::KVSBObject> >( line, arg, m_output_name );
+    }
+    else if ( const auto* polygon = dynamic_cast<const kvs::PolygonObject*>( object ) )
+    {
+        success = ::Export<kvs::PolygonExporter<kvs::KVSBObject> >( polygon, arg, m_output_name );
+    }
+    else if ( const auto* volume = dynamic_cast<const kvs::StructuredVolumeObject*>( object ) )
+    {
+        success = ::Export<kvs::StructuredVolumeExporter<kvs::KVSBObject> >( volume, arg, m_output_name );
+    }
+    else if ( const auto* volume = dynamic_cast<const kvs::UnstructuredVolumeObject*>( object ) )
+    {
+        success = ::Export<kvs::UnstructuredVolumeExporter<kvs::KVSBObject> >( volume, arg, m_output_name );
+    }
+    else
+    {
+        // Image and table objects are written without compression.
+        success = object->write( m_output_name );
+    }
+    delete object;
+
+    if ( !success )
+    {
+        kvsMessageError() << "Cannot write " << m_output_name << "." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+} // end of namespace KvsbConv
+
+} // end of namespace kvsconv
@@ -0,0 +1,58 @@
+/*****************************************************************************/
+/**
+ *  @file   KvsbConv.h
+ *  @brief  KVSB Data Converter
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <kvs/CommandLine>
+#include <kvs/KVSBObject>
+#include "Argument.h"
+
+
+namespace kvsconv
+{
+
+namespace KvsbConv
+{
+
+const std::string CommandName( "kvsb_conv" );
+const std::string Description("KVSB Data Converter.");
+
+/*===========================================================================*/
+/**
+ *  Argument class for a kvsb_conv.
+ */
+/*===========================================================================*/
+class Argument : public kvsconv::Argument::Common
+{
+public:
+    Argument( int argc, char** argv );
+    std::string inputFilename();
+    std::string outputFilename( const std::string& filename );
+    kvs::KVSBObject::Compression compression();
+    size_t chunkSize();
+};
+
+/*===========================================================================*/
+/**
+ *  Main class for a kvsb_conv.
+ */
+/*===========================================================================*/
+class Main
+{
+private:
+    int m_argc; ///< argument count
+    char** m_argv; ///< argument values
+    std::string m_input_name; ///< input filename
+    std::string m_output_name; ///< output filename
+
+public:
+    Main( int argc, char** argv ): m_argc( argc ), m_argv( argv ) {}
+    bool exec();
+};
+
+} // end of namespace KvsbConv
+
+} // end of namespace kvsconv
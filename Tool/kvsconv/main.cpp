@@ -12,6 +12,7 @@
 #include "UcdConv.h"
 #include "TetConv.h"
 #include "ImgConv.h"
+#include "KvsbConv.h"
 
 KVS_MEMORY_DEBUGGER;
 
@@ -44,6 +45,7 @@ bool Main::exec()
         KVSCONV_HELP( UcdConv );
         KVSCONV_HELP( TetConv );
         KVSCONV_HELP( ImgConv );
+        KVSCONV_HELP( KvsbConv );
         kvsMessageError() << "Unknown converter '" << c << "'." << std::endl;;
         return false;
     }
@@ -53,6 +55,7 @@ bool Main::exec()
     KVSCONV_EXEC( UcdConv );
     KVSCONV_EXEC( TetConv );
     KVSCONV_EXEC( ImgConv );
+    KVSCONV_EXEC( KvsbConv );
     return false;
 }
 